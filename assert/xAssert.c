@@ -14,7 +14,7 @@
 ////////////////////////////////////////////////////////////
 /// xAssert
 ////////////////////////////////////////////////////////////
-void xAssert(const uint8_t* p_ptkcFile, uint32_t p_ulLine, const void* p_ptMsg)
+__attribute__((cold, noinline)) void xAssert(const uint8_t* p_ptkcFile, uint32_t p_ulLine, const void* p_ptMsg)
 {
 
     const char* filename = (p_ptkcFile != NULL) ? (const char*)p_ptkcFile : "Unknown file";
@@ -39,7 +39,7 @@ void xAssert(const uint8_t* p_ptkcFile, uint32_t p_ulLine, const void* p_ptMsg)
 ////////////////////////////////////////////////////////////
 /// xAssertReturn
 ////////////////////////////////////////////////////////////
-int xAssertReturn(const uint8_t* p_ptkcFile, uint32_t p_ulLine, const void* p_ptMsg, int p_iRet)
+__attribute__((cold, noinline)) int xAssertReturn(const uint8_t* p_ptkcFile, uint32_t p_ulLine, const void* p_ptMsg, int p_iRet)
 {
     // Utiliser une chaîne par défaut si le nom du fichier est NULL
     const char* filename = (p_ptkcFile != NULL) ? (const char*)p_ptkcFile : "Unknown file";
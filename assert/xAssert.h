@@ -19,17 +19,38 @@
 #define XOS_ASSERT_MODE_LOOP        0x00000002
 
 
-// Assert macros
-#define X_ASSERT(expr) \
-    ((expr) ? (void)0 : xAssert((uint8_t *)__FILE__, __LINE__, NULL))
+// Assert tiers
+// - X_ASSERT_ALWAYS, X_ASSERT_RETURN : safety checks, evaluated in every build
+// - X_ASSERT : invariant checks, evaluated without NDEBUG only. In Release the
+//   expression is not evaluated, or with XOS_ASSERT_ASSUME (cmake
+//   -DUSE_ASSERT_ASSUME=ON) it is handed to the optimizer as an assumption,
+//   so it must be cheap, free of side effects and true. Never use it on
+//   caller or peer input (sizes, modes, configuration): return an error code,
+//   or use X_ASSERT_ALWAYS
+// The failure branch is marked unlikely and the handlers cold, callers keep
+// the check as one predicted branch and the handler call out of line
+#define X_ASSERT_LIKELY(expr)       __builtin_expect(!!(expr), 1)
+
+#define X_ASSERT_ALWAYS(expr) \
+    (X_ASSERT_LIKELY(expr) ? (void)0 : xAssert((uint8_t *)__FILE__, __LINE__, NULL))
 
 #define X_ASSERT_RETURN(expr, ret) \
     do { \
-        if (!(expr)) { \
+        if (!X_ASSERT_LIKELY(expr)) { \
             return xAssertReturn((uint8_t *)__FILE__, __LINE__, NULL, ret); \
         } \
     } while(0)
 
+#if !defined(NDEBUG)
+#define X_ASSERT(expr)              X_ASSERT_ALWAYS(expr)
+#elif defined(XOS_ASSERT_ASSUME) && defined(__clang__)
+#define X_ASSERT(expr)              __builtin_assume(expr)
+#elif defined(XOS_ASSERT_ASSUME)
+#define X_ASSERT(expr)              (X_ASSERT_LIKELY(expr) ? (void)0 : __builtin_unreachable())
+#else
+#define X_ASSERT(expr)              ((void)sizeof(!(expr)))
+#endif
+
 //////////////////////////////////
 /// @brief Assert function
 /// @param p_ptkcFile : file name
@@ -37,7 +58,7 @@
 /// @param p_ptMsg : message
 /// @return none
 //////////////////////////////////
-void xAssert(const uint8_t* p_ptkcFile, uint32_t p_ulLine, const void* p_ptMsg);
+__attribute__((cold, noinline)) void xAssert(const uint8_t* p_ptkcFile, uint32_t p_ulLine, const void* p_ptMsg);
 
 //////////////////////////////////
 /// @brief Assert with return value
@@ -47,6 +68,6 @@ void xAssert(const uint8_t* p_ptkcFile, uint32_t p_ulLine, const void* p_ptMsg);
 /// @param p_iRet : return value
 /// @return return value
 //////////////////////////////////
-int xAssertReturn(const uint8_t* p_ptkcFile, uint32_t p_ulLine, const void* p_ptMsg, int p_iRet);
+__attribute__((cold, noinline)) int xAssertReturn(const uint8_t* p_ptkcFile, uint32_t p_ulLine, const void* p_ptMsg, int p_iRet);
 
 #endif // XOS_ASSERT_H_
@@ -0,0 +1,190 @@
+////////////////////////////////////////////////////////////
+//  benchHash.c
+//  Digest throughput benchmark for xHash
+//
+// Usage: benchHash [bytes hashed per measure]
+// Every algorithm and input size is hashed three ways: a context
+// allocated and the digest resolved at each call (the former
+// xHashCalculate), the xHashCalculate one-shot and a reused xHashCtx_t
+//
+// general discloser: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <openssl/evp.h>
+#include "xHash.h"
+
+#define BENCH_DEFAULT_BYTES (16UL * 1024 * 1024)
+#define BENCH_MIN_CALLS     64
+#define BENCH_MAX_CALLS     200000
+#define BENCH_MAX_INPUT     (1024 * 1024)
+
+static const size_t s_ulSizes[] = { 16, 64, 256, 1024, 4096, 65536, 1024 * 1024 };
+
+static const struct
+{
+    t_hashAlgorithm t_eType;
+    const char* t_pcName;
+} s_tAlgorithms[] = {
+    { XOS_HASH_TYPE_SHA256, "sha256" },
+    { XOS_HASH_TYPE_SHA384, "sha384" },
+    { XOS_HASH_TYPE_SHA512, "sha512" },
+    { XOS_HASH_TYPE_SHA3_256, "sha3-256" },
+    { XOS_HASH_TYPE_SHA3_384, "sha3-384" },
+    { XOS_HASH_TYPE_SHA3_512, "sha3-512" },
+    { XOS_HASH_TYPE_KECCAK_256, "keccak-256" },
+};
+
+static double benchNow(void)
+{
+    struct timespec l_tNow;
+    clock_gettime(CLOCK_MONOTONIC, &l_tNow);
+    return (double)l_tNow.tv_sec + (double)l_tNow.tv_nsec * 1e-9;
+}
+
+//
+// Digest as xHashCalculate did before the reusable contexts
+//
+static int benchHashAllocated(t_hashAlgorithm p_eType, const void* p_ptData, size_t p_ulSize, uint8_t* p_ptHash)
+{
+    const EVP_MD* l_ptMd = NULL;
+    switch (p_eType)
+    {
+    case XOS_HASH_TYPE_SHA256: l_ptMd = EVP_sha256(); break;
+    case XOS_HASH_TYPE_SHA384: l_ptMd = EVP_sha384(); break;
+    case XOS_HASH_TYPE_SHA512: l_ptMd = EVP_sha512(); break;
+    case XOS_HASH_TYPE_SHA3_256: l_ptMd = EVP_sha3_256(); break;
+    case XOS_HASH_TYPE_SHA3_384: l_ptMd = EVP_sha3_384(); break;
+    case XOS_HASH_TYPE_SHA3_512: l_ptMd = EVP_sha3_512(); break;
+    default: return -1;
+    }
+
+    EVP_MD_CTX* l_ptContext = EVP_MD_CTX_new();
+    unsigned int l_ulHashLen;
+    int l_iOk = l_ptContext != NULL &&
+                EVP_DigestInit_ex(l_ptContext, l_ptMd, NULL) &&
+                EVP_DigestUpdate(l_ptContext, p_ptData, p_ulSize) &&
+                EVP_DigestFinal_ex(l_ptContext, p_ptHash, &l_ulHashLen);
+    EVP_MD_CTX_free(l_ptContext);
+    return l_iOk ? 0 : -1;
+}
+
+//
+// Returns the nanoseconds per digest of one method, negative when unsupported
+//
+static double benchMeasure(int p_iMethod, t_hashAlgorithm p_eType, const uint8_t* p_pucData,
+                           size_t p_ulSize, unsigned long p_ulCalls, uint8_t* p_pucHash)
+{
+    xHashCtx_t l_tCtx;
+    size_t l_ulHashSize;
+
+    if (p_iMethod == 2 && xHashCtxCreate(&l_tCtx, p_eType) != (int)XOS_HASH_OK)
+    {
+        return -1.0;
+    }
+
+    double l_dStart = benchNow();
+    for (unsigned long i = 0; i < p_ulCalls; i++)
+    {
+        int l_iResult;
+        if (p_iMethod == 0)
+        {
+            l_iResult = benchHashAllocated(p_eType, p_pucData, p_ulSize, p_pucHash) == 0 ? (int)XOS_HASH_OK : -1;
+        }
+        else if (p_iMethod == 1)
+        {
+            l_iResult = xHashCalculate(p_eType, p_pucData, p_ulSize, p_pucHash, &l_ulHashSize);
+        }
+        else
+        {
+            l_iResult = xHashCtxReset(&l_tCtx);
+            if (l_iResult == (int)XOS_HASH_OK)
+            {
+                l_iResult = xHashCtxUpdate(&l_tCtx, p_pucData, p_ulSize);
+            }
+            if (l_iResult == (int)XOS_HASH_OK)
+            {
+                l_iResult = xHashCtxFinal(&l_tCtx, p_pucHash, &l_ulHashSize);
+            }
+        }
+
+        if (l_iResult != (int)XOS_HASH_OK)
+        {
+            if (p_iMethod == 2)
+            {
+                xHashCtxDestroy(&l_tCtx);
+            }
+            return -1.0;
+        }
+    }
+    double l_dElapsed = benchNow() - l_dStart;
+
+    if (p_iMethod == 2)
+    {
+        xHashCtxDestroy(&l_tCtx);
+    }
+    return l_dElapsed * 1e9 / (double)p_ulCalls;
+}
+
+int main(int argc, char** argv)
+{
+    unsigned long l_ulBytes = (argc > 1) ? strtoul(argv[1], NULL, 10) : BENCH_DEFAULT_BYTES;
+    uint8_t l_ucHash[EVP_MAX_MD_SIZE];
+
+    uint8_t* l_pucData = malloc(BENCH_MAX_INPUT);
+    if (l_pucData == NULL)
+    {
+        return 1;
+    }
+    for (size_t i = 0; i < BENCH_MAX_INPUT; i++)
+    {
+        l_pucData[i] = (uint8_t)(i * 131 + 7);
+    }
+
+    printf("xHash: about %lu bytes hashed per measure\n", l_ulBytes);
+    printf("%-11s %8s %14s %14s %14s %9s %10s\n", "algorithm", "size", "alloc ns", "one-shot ns",
+           "ctx ns", "speedup", "ctx MB/s");
+
+    for (size_t a = 0; a < sizeof(s_tAlgorithms) / sizeof(s_tAlgorithms[0]); a++)
+    {
+        for (size_t s = 0; s < sizeof(s_ulSizes) / sizeof(s_ulSizes[0]); s++)
+        {
+            size_t l_ulSize = s_ulSizes[s];
+            unsigned long l_ulCalls = l_ulBytes / l_ulSize;
+            l_ulCalls = (l_ulCalls < BENCH_MIN_CALLS) ? BENCH_MIN_CALLS :
+                        (l_ulCalls > BENCH_MAX_CALLS) ? BENCH_MAX_CALLS : l_ulCalls;
+
+            double l_dNs[3];
+            for (int m = 0; m < 3; m++)
+            {
+                l_dNs[m] = benchMeasure(m, s_tAlgorithms[a].t_eType, l_pucData, l_ulSize, l_ulCalls, l_ucHash);
+            }
+
+            if (l_dNs[1] < 0.0)
+            {
+                printf("%-11s %8zu %14s\n", s_tAlgorithms[a].t_pcName, l_ulSize, "unsupported");
+                break;
+            }
+
+            char l_cAlloc[32];
+            if (l_dNs[0] < 0.0)
+            {
+                snprintf(l_cAlloc, sizeof(l_cAlloc), "n/a");
+            }
+            else
+            {
+                snprintf(l_cAlloc, sizeof(l_cAlloc), "%.1f", l_dNs[0]);
+            }
+            printf("%-11s %8zu %14s %14.1f %14.1f %8.2fx %10.1f\n", s_tAlgorithms[a].t_pcName, l_ulSize,
+                   l_cAlloc, l_dNs[1], l_dNs[2], (l_dNs[0] > 0.0) ? l_dNs[0] / l_dNs[1] : 0.0,
+                   (double)l_ulSize * 1e3 / l_dNs[2]);
+        }
+    }
+
+    free(l_pucData);
+    return 0;
+}
@@ -0,0 +1,130 @@
+////////////////////////////////////////////////////////////
+//  benchMemory.c
+//  Multi-thread alloc/free stress benchmark for xMemory
+//
+// Usage: benchMemory [operations per thread] [integrity level 0-3] [max threads]
+// Each thread keeps a small working set of live blocks and replaces a
+// random one at every step, so allocations and frees interleave
+//
+// general discloser: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include "xMemory.h"
+
+#define BENCH_WORKING_SET   64
+#define BENCH_DEFAULT_OPS   200000
+#define BENCH_MAX_THREADS   64
+
+static pthread_barrier_t s_tStartBarrier;
+static unsigned long s_ulOpsPerThread = BENCH_DEFAULT_OPS;
+
+static double benchNow(void)
+{
+    struct timespec l_tNow;
+    clock_gettime(CLOCK_MONOTONIC, &l_tNow);
+    return (double)l_tNow.tv_sec + (double)l_tNow.tv_nsec * 1e-9;
+}
+
+static void* benchWorker(void* p_ptArg)
+{
+    void* l_ptBlocks[BENCH_WORKING_SET] = { 0 };
+    unsigned int l_uiSeed = (unsigned int)(uintptr_t)p_ptArg * 2654435761U + 1U;
+
+    pthread_barrier_wait(&s_tStartBarrier);
+
+    for (unsigned long i = 0; i < s_ulOpsPerThread; i++)
+    {
+        l_uiSeed = l_uiSeed * 1103515245U + 12345U;
+        unsigned int l_uiSlot = (l_uiSeed >> 16) % BENCH_WORKING_SET;
+        if (l_ptBlocks[l_uiSlot] != NULL)
+        {
+            X_FREE(l_ptBlocks[l_uiSlot]);
+        }
+        l_ptBlocks[l_uiSlot] = X_MALLOC(16 + (l_uiSeed & 1008));
+    }
+
+    for (int i = 0; i < BENCH_WORKING_SET; i++)
+    {
+        if (l_ptBlocks[i] != NULL)
+        {
+            X_FREE(l_ptBlocks[i]);
+        }
+    }
+
+    return NULL;
+}
+
+static double benchRun(int p_iThreads)
+{
+    pthread_t l_tThreads[BENCH_MAX_THREADS];
+
+    // The main thread joins the barrier to take the start time
+    pthread_barrier_init(&s_tStartBarrier, NULL, (unsigned int)p_iThreads + 1);
+    for (int i = 0; i < p_iThreads; i++)
+    {
+        pthread_create(&l_tThreads[i], NULL, benchWorker, (void*)(uintptr_t)(i + 1));
+    }
+
+    pthread_barrier_wait(&s_tStartBarrier);
+    double l_dStart = benchNow();
+    for (int i = 0; i < p_iThreads; i++)
+    {
+        pthread_join(l_tThreads[i], NULL);
+    }
+    double l_dElapsed = benchNow() - l_dStart;
+    pthread_barrier_destroy(&s_tStartBarrier);
+
+    return l_dElapsed;
+}
+
+int main(int argc, char** argv)
+{
+    int l_iLevel = XOS_MEM_DEFAULT_INTEGRITY;
+    if (argc > 1)
+    {
+        s_ulOpsPerThread = strtoul(argv[1], NULL, 10);
+    }
+    if (argc > 2)
+    {
+        l_iLevel = atoi(argv[2]);
+    }
+
+    if (xMemInitEx((xMemIntegrity_t)l_iLevel) != (int)XOS_MEM_OK)
+    {
+        fprintf(stderr, "invalid integrity level %d\n", l_iLevel);
+        return 1;
+    }
+
+    long l_lCpus = sysconf(_SC_NPROCESSORS_ONLN);
+    long l_lMaxThreads = (argc > 3) ? strtol(argv[3], NULL, 10) : l_lCpus;
+    int l_iMaxThreads = (l_lMaxThreads > BENCH_MAX_THREADS) ? BENCH_MAX_THREADS :
+                        (l_lMaxThreads < 1) ? 1 : (int)l_lMaxThreads;
+
+    printf("xMemory stress: %lu alloc+free per thread, integrity level %d, %ld cpus\n",
+           s_ulOpsPerThread, l_iLevel, l_lCpus);
+    printf("%8s %12s %14s %10s\n", "threads", "time (s)", "Mops/s", "speedup");
+
+    double l_dBase = 0.0;
+    for (int l_iThreads = 1; l_iThreads <= l_iMaxThreads; l_iThreads *= 2)
+    {
+        double l_dElapsed = benchRun(l_iThreads);
+        double l_dMops = (double)s_ulOpsPerThread * 2.0 * l_iThreads / l_dElapsed / 1e6;
+        if (l_iThreads == 1)
+        {
+            l_dBase = l_dMops;
+        }
+        printf("%8d %12.3f %14.2f %9.2fx\n", l_iThreads, l_dElapsed, l_dMops, l_dMops / l_dBase);
+    }
+
+    size_t l_ulTotal, l_ulPeak, l_ulCount;
+    xMemGetStats(&l_ulTotal, &l_ulPeak, &l_ulCount);
+    printf("leaked bytes: %zu, peak: %zu, allocations: %zu\n", l_ulTotal, l_ulPeak, l_ulCount);
+
+    return (l_ulTotal == 0) ? 0 : 1;
+}
@@ -0,0 +1,240 @@
+////////////////////////////////////////////////////////////
+//  benchMutex.c
+//  Lock contention benchmark for xOsMutex
+//
+// Usage: benchMutex [operations per thread] [max threads] [write percent]
+// Each thread runs a short critical section (a few counter updates)
+// in a loop. Exclusive locks: xOsMutexCtx, a default pthread mutex and
+// xOsFastMutex. Read-mostly: pthread_rwlock_t, xOsRwLock and
+// xOsFastMutex, with the given share of writers
+//
+// general discloser: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include "xOsMutex.h"
+
+#define BENCH_DEFAULT_OPS       1000000
+#define BENCH_MAX_THREADS       64
+#define BENCH_DEFAULT_WRITES    5
+#define BENCH_SHARED_WORDS      8
+
+typedef enum
+{
+    BENCH_LOCK_XOS = 0,
+    BENCH_LOCK_PTHREAD,
+    BENCH_LOCK_FAST,
+    BENCH_LOCK_PTHREAD_RW,
+    BENCH_LOCK_XOS_RW,
+    BENCH_LOCK_COUNT
+} benchLock_t;
+
+static const char* s_pcLockNames[BENCH_LOCK_COUNT] = {
+    "xOsMutexCtx", "pthread_mutex", "xOsFastMutex", "pthread_rwlock", "xOsRwLock"
+};
+
+static pthread_barrier_t s_tStartBarrier;
+static unsigned long s_ulOpsPerThread = BENCH_DEFAULT_OPS;
+static unsigned int s_uiWritePercent = BENCH_DEFAULT_WRITES;
+static benchLock_t s_eLock;
+static bool s_bReadMostly;
+
+static xOsMutexCtx s_tXosMutex;
+static pthread_mutex_t s_tPthreadMutex = PTHREAD_MUTEX_INITIALIZER;
+static xOsFastMutex s_tFastMutex = XOS_FAST_MUTEX_INITIALIZER;
+static pthread_rwlock_t s_tPthreadRwLock = PTHREAD_RWLOCK_INITIALIZER;
+static xOsRwLock s_tRwLock = XOS_RWLOCK_INITIALIZER;
+
+// Protected data, on its own cache lines
+static struct
+{
+    uint64_t t_ulWords[BENCH_SHARED_WORDS];
+} __attribute__((aligned(64))) s_tShared;
+
+static double benchNow(void)
+{
+    struct timespec l_tNow;
+    clock_gettime(CLOCK_MONOTONIC, &l_tNow);
+    return (double)l_tNow.tv_sec + (double)l_tNow.tv_nsec * 1e-9;
+}
+
+static void benchLock(bool p_bWrite)
+{
+    switch (s_eLock)
+    {
+    case BENCH_LOCK_XOS: mutexLock(&s_tXosMutex); break;
+    case BENCH_LOCK_PTHREAD: pthread_mutex_lock(&s_tPthreadMutex); break;
+    case BENCH_LOCK_FAST: mutexFastLock(&s_tFastMutex); break;
+    case BENCH_LOCK_PTHREAD_RW:
+        if (p_bWrite) pthread_rwlock_wrlock(&s_tPthreadRwLock); else pthread_rwlock_rdlock(&s_tPthreadRwLock);
+        break;
+    case BENCH_LOCK_XOS_RW:
+        if (p_bWrite) rwLockWrite(&s_tRwLock); else rwLockRead(&s_tRwLock);
+        break;
+    default: break;
+    }
+}
+
+static void benchUnlock(bool p_bWrite)
+{
+    switch (s_eLock)
+    {
+    case BENCH_LOCK_XOS: mutexUnlock(&s_tXosMutex); break;
+    case BENCH_LOCK_PTHREAD: pthread_mutex_unlock(&s_tPthreadMutex); break;
+    case BENCH_LOCK_FAST: mutexFastUnlock(&s_tFastMutex); break;
+    case BENCH_LOCK_PTHREAD_RW: pthread_rwlock_unlock(&s_tPthreadRwLock); break;
+    case BENCH_LOCK_XOS_RW:
+        if (p_bWrite) rwLockWriteUnlock(&s_tRwLock); else rwLockReadUnlock(&s_tRwLock);
+        break;
+    default: break;
+    }
+}
+
+static void* benchWorker(void* p_ptArg)
+{
+    unsigned int l_uiSeed = (unsigned int)(uintptr_t)p_ptArg * 2654435761U + 1U;
+    volatile uint64_t l_ulSink = 0;
+
+    pthread_barrier_wait(&s_tStartBarrier);
+
+    for (unsigned long i = 0; i < s_ulOpsPerThread; i++)
+    {
+        bool l_bWrite = true;
+        if (s_bReadMostly)
+        {
+            l_uiSeed = l_uiSeed * 1103515245U + 12345U;
+            l_bWrite = ((l_uiSeed >> 16) % 100) < s_uiWritePercent;
+        }
+
+        benchLock(l_bWrite);
+        if (l_bWrite)
+        {
+            for (int j = 0; j < BENCH_SHARED_WORDS; j++)
+            {
+                s_tShared.t_ulWords[j]++;
+            }
+        }
+        else
+        {
+            uint64_t l_ulSum = 0;
+            for (int j = 0; j < BENCH_SHARED_WORDS; j++)
+            {
+                l_ulSum += s_tShared.t_ulWords[j];
+            }
+            l_ulSink = l_ulSum;
+        }
+        benchUnlock(l_bWrite);
+    }
+
+    (void)l_ulSink;
+    return NULL;
+}
+
+static double benchRun(int p_iThreads)
+{
+    pthread_t l_tThreads[BENCH_MAX_THREADS];
+
+    // The main thread joins the barrier to take the start time
+    pthread_barrier_init(&s_tStartBarrier, NULL, (unsigned int)p_iThreads + 1);
+    for (int i = 0; i < p_iThreads; i++)
+    {
+        pthread_create(&l_tThreads[i], NULL, benchWorker, (void*)(uintptr_t)(i + 1));
+    }
+
+    pthread_barrier_wait(&s_tStartBarrier);
+    double l_dStart = benchNow();
+    for (int i = 0; i < p_iThreads; i++)
+    {
+        pthread_join(l_tThreads[i], NULL);
+    }
+    double l_dElapsed = benchNow() - l_dStart;
+    pthread_barrier_destroy(&s_tStartBarrier);
+
+    return l_dElapsed;
+}
+
+//
+// Runs one table, returns non zero when a lock lost an update
+//
+static int benchTable(const benchLock_t* p_ptLocks, int p_iCount, int p_iMaxThreads)
+{
+    int l_iLost = 0;
+
+    printf("%8s", "threads");
+    for (int i = 0; i < p_iCount; i++)
+    {
+        printf(" %16s", s_pcLockNames[p_ptLocks[i]]);
+    }
+    printf("   (Mops/s)\n");
+
+    for (int l_iThreads = 1; l_iThreads <= p_iMaxThreads; l_iThreads *= 2)
+    {
+        printf("%8d", l_iThreads);
+        for (int i = 0; i < p_iCount; i++)
+        {
+            s_eLock = p_ptLocks[i];
+            s_tShared.t_ulWords[0] = 0;
+            double l_dElapsed = benchRun(l_iThreads);
+            printf(" %16.2f", (double)s_ulOpsPerThread * l_iThreads / l_dElapsed / 1e6);
+
+            // Every write adds one, exclusive runs write on each operation
+            if (!s_bReadMostly && s_tShared.t_ulWords[0] != (uint64_t)s_ulOpsPerThread * l_iThreads)
+            {
+                l_iLost = 1;
+            }
+        }
+        printf("\n");
+    }
+
+    return l_iLost;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc > 1)
+    {
+        s_ulOpsPerThread = strtoul(argv[1], NULL, 10);
+    }
+    if (argc > 3)
+    {
+        s_uiWritePercent = (unsigned int)strtoul(argv[3], NULL, 10);
+    }
+
+    long l_lCpus = sysconf(_SC_NPROCESSORS_ONLN);
+    long l_lMaxThreads = (argc > 2) ? strtol(argv[2], NULL, 10) : l_lCpus * 2;
+    int l_iMaxThreads = (l_lMaxThreads > BENCH_MAX_THREADS) ? BENCH_MAX_THREADS :
+                        (l_lMaxThreads < 1) ? 1 : (int)l_lMaxThreads;
+
+    if ((unsigned int)mutexCreate(&s_tXosMutex) != MUTEX_OK)
+    {
+        fprintf(stderr, "mutexCreate failed\n");
+        return 1;
+    }
+
+    printf("lock contention: %lu operations per thread, %ld cpus\n", s_ulOpsPerThread, l_lCpus);
+
+    printf("\nexclusive, every operation writes\n");
+    static const benchLock_t s_tExclusive[] = { BENCH_LOCK_XOS, BENCH_LOCK_PTHREAD, BENCH_LOCK_FAST };
+    s_bReadMostly = false;
+    int l_iLost = benchTable(s_tExclusive, 3, l_iMaxThreads);
+
+    printf("\nread-mostly, %u%% writes\n", s_uiWritePercent);
+    static const benchLock_t s_tReadMostly[] = { BENCH_LOCK_PTHREAD_RW, BENCH_LOCK_XOS_RW, BENCH_LOCK_FAST };
+    s_bReadMostly = true;
+    benchTable(s_tReadMostly, 3, l_iMaxThreads);
+
+    mutexDestroy(&s_tXosMutex);
+
+    if (l_iLost)
+    {
+        printf("lost updates detected\n");
+    }
+    return l_iLost;
+}
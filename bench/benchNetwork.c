@@ -0,0 +1,187 @@
+////////////////////////////////////////////////////////////
+//  benchNetwork.c
+//  Loopback TCP throughput benchmark for xNetwork
+//
+// Usage: benchNetwork [messages] [message size] [port]
+// - stream : one thread sends, the main thread receives
+// - duplex : both ends send and receive at the same time, one sender
+//            and one receiver thread per socket (not run in shared mode,
+//            where a receiver blocked in recv() holds the socket mutex)
+// Each line is run for every lock mode that supports it
+//
+// general discloser: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <time.h>
+#include "xNetwork.h"
+
+#define BENCH_DEFAULT_MESSAGES  200000
+#define BENCH_DEFAULT_SIZE      64
+#define BENCH_DEFAULT_PORT      39200
+#define BENCH_MAX_SIZE          65536
+
+typedef struct
+{
+    NetworkSocket* t_ptSocket;
+    unsigned long t_ulMessages;
+    int t_iSize;
+} benchPeer;
+
+static double benchNow(void)
+{
+    struct timespec l_tNow;
+    clock_gettime(CLOCK_MONOTONIC, &l_tNow);
+    return (double)l_tNow.tv_sec + (double)l_tNow.tv_nsec * 1e-9;
+}
+
+static void* benchSender(void* p_ptArg)
+{
+    benchPeer* l_ptPeer = (benchPeer*)p_ptArg;
+    static char s_cBuffer[BENCH_MAX_SIZE];
+
+    for (unsigned long i = 0; i < l_ptPeer->t_ulMessages; i++)
+    {
+        int l_iOffset = 0;
+        while (l_iOffset < l_ptPeer->t_iSize)
+        {
+            int l_iSent = networkSend(l_ptPeer->t_ptSocket, s_cBuffer + l_iOffset,
+                                      (unsigned long)(l_ptPeer->t_iSize - l_iOffset));
+            if (l_iSent <= 0)
+            {
+                return NULL;
+            }
+            l_iOffset += l_iSent;
+        }
+    }
+
+    return NULL;
+}
+
+static void* benchReceiver(void* p_ptArg)
+{
+    benchPeer* l_ptPeer = (benchPeer*)p_ptArg;
+    char l_cBuffer[BENCH_MAX_SIZE];
+    unsigned long l_ulRemaining = l_ptPeer->t_ulMessages * (unsigned long)l_ptPeer->t_iSize;
+
+    while (l_ulRemaining > 0)
+    {
+        // One message per call, as a framed protocol would read
+        unsigned long l_ulWant = (l_ulRemaining < (unsigned long)l_ptPeer->t_iSize) ? l_ulRemaining : (unsigned long)l_ptPeer->t_iSize;
+        int l_iReceived = networkReceive(l_ptPeer->t_ptSocket, l_cBuffer, l_ulWant);
+        if (l_iReceived <= 0)
+        {
+            break;
+        }
+        l_ulRemaining -= (unsigned long)l_iReceived;
+    }
+
+    return NULL;
+}
+
+static bool benchConnect(unsigned short p_usPort, int p_iMode, NetworkSocket** p_pptClient, NetworkSocket** p_pptServer)
+{
+    NetworkAddress l_tAddress = networkMakeAddress("127.0.0.1", p_usPort);
+    NetworkSocket* l_ptListener = networkCreateSocket(NETWORK_SOCK_TCP);
+    if (!l_ptListener || networkBind(l_ptListener, &l_tAddress) != (int)NETWORK_OK ||
+        networkListen(l_ptListener, 1) != (int)NETWORK_OK)
+    {
+        return false;
+    }
+
+    *p_pptClient = networkCreateSocket(NETWORK_SOCK_TCP);
+    if (!*p_pptClient || networkConnect(*p_pptClient, &l_tAddress) != (int)NETWORK_OK)
+    {
+        networkCloseSocket(l_ptListener);
+        return false;
+    }
+
+    *p_pptServer = networkAccept(l_ptListener, NULL);
+    networkCloseSocket(l_ptListener);
+    if (!*p_pptServer)
+    {
+        return false;
+    }
+
+    networkSetLockMode(*p_pptClient, p_iMode);
+    networkSetLockMode(*p_pptServer, p_iMode);
+    return true;
+}
+
+static double benchRun(unsigned short p_usPort, int p_iMode, bool p_bDuplex, unsigned long p_ulMessages, int p_iSize)
+{
+    NetworkSocket* l_ptClient = NULL;
+    NetworkSocket* l_ptServer = NULL;
+    if (!benchConnect(p_usPort, p_iMode, &l_ptClient, &l_ptServer))
+    {
+        return -1.0;
+    }
+
+    benchPeer l_tClient = { l_ptClient, p_ulMessages, p_iSize };
+    benchPeer l_tServer = { l_ptServer, p_ulMessages, p_iSize };
+    pthread_t l_tThreads[3];
+    int l_iThreads = 0;
+
+    double l_dStart = benchNow();
+    pthread_create(&l_tThreads[l_iThreads++], NULL, benchSender, &l_tClient);
+    if (p_bDuplex)
+    {
+        pthread_create(&l_tThreads[l_iThreads++], NULL, benchSender, &l_tServer);
+        pthread_create(&l_tThreads[l_iThreads++], NULL, benchReceiver, &l_tClient);
+    }
+    benchReceiver(&l_tServer);
+    for (int i = 0; i < l_iThreads; i++)
+    {
+        pthread_join(l_tThreads[i], NULL);
+    }
+    double l_dElapsed = benchNow() - l_dStart;
+
+    networkCloseSocket(l_ptClient);
+    networkCloseSocket(l_ptServer);
+    return l_dElapsed;
+}
+
+int main(int argc, char** argv)
+{
+    static const char* s_pcModes[] = { "shared", "duplex", "none" };
+    unsigned long l_ulMessages = (argc > 1) ? strtoul(argv[1], NULL, 10) : BENCH_DEFAULT_MESSAGES;
+    int l_iSize = (argc > 2) ? atoi(argv[2]) : BENCH_DEFAULT_SIZE;
+    unsigned short l_usPort = (argc > 3) ? (unsigned short)atoi(argv[3]) : BENCH_DEFAULT_PORT;
+
+    if (l_iSize <= 0 || l_iSize > BENCH_MAX_SIZE)
+    {
+        fprintf(stderr, "message size must be 1..%d\n", BENCH_MAX_SIZE);
+        return 1;
+    }
+
+    printf("xNetwork loopback: %lu messages of %d bytes per direction\n", l_ulMessages, l_iSize);
+    printf("%8s %8s %12s %12s %12s\n", "pattern", "locking", "time (s)", "MB/s", "Mmsg/s");
+
+    for (int l_iDuplex = 0; l_iDuplex <= 1; l_iDuplex++)
+    {
+        for (int l_iMode = NETWORK_LOCK_SHARED; l_iMode <= NETWORK_LOCK_NONE; l_iMode++)
+        {
+            if (l_iDuplex && l_iMode == NETWORK_LOCK_SHARED)
+            {
+                continue;
+            }
+
+            // A fresh port per run, the previous one may still be in TIME_WAIT
+            double l_dElapsed = benchRun(l_usPort++, l_iMode, l_iDuplex != 0, l_ulMessages, l_iSize);
+            if (l_dElapsed < 0.0)
+            {
+                fprintf(stderr, "loopback connection failed\n");
+                return 1;
+            }
+
+            double l_dMessages = (double)l_ulMessages * (l_iDuplex ? 2.0 : 1.0);
+            printf("%8s %8s %12.3f %12.1f %12.2f\n", l_iDuplex ? "duplex" : "stream", s_pcModes[l_iMode], l_dElapsed,
+                   l_dMessages * l_iSize / l_dElapsed / 1e6, l_dMessages / l_dElapsed / 1e6);
+        }
+    }
+
+    return 0;
+}
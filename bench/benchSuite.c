@@ -0,0 +1,1116 @@
+////////////////////////////////////////////////////////////
+//  benchSuite.c
+//  Latency and throughput suite over the library hot paths
+//
+// Usage: benchSuite [options], see benchUsage
+// Every case is timed per sample: a sample runs a batch of operations
+// between two clock reads, so operations far below the clock cost are
+// still measured, and the per-operation latency of each sample feeds
+// the percentiles. All threads of a run are released together after a
+// warm-up and the wall time of the run gives the throughput. Cases
+// that scale with threads are swept over the requested thread counts.
+// Results are printed as a table, as CSV or as a JSON document keeping
+// the build information, to compare releases
+//
+// general discloser: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include "xMemory.h"
+#include "xLog.h"
+#include "xTrace.h"
+#include "xMetrics.h"
+#include "xOsMutex.h"
+#include "xOsSemaphore.h"
+#include "xTask.h"
+#include "xTimer.h"
+#include "xHash.h"
+#include "xNetworkOptions.h"
+
+#ifndef BENCH_VERSION
+#define BENCH_VERSION           "unknown"
+#endif
+
+#define BENCH_DEFAULT_SAMPLES   2000
+#define BENCH_WARMUP_DIVIDER    10          // Warm-up samples, as a share of the measured ones
+#define BENCH_MAX_THREADS       64
+#define BENCH_DEFAULT_PORT      19200
+#define BENCH_MESSAGE_SIZE      64
+#define BENCH_HASH_LARGE        4096
+#define BENCH_LOG_PATH          "/tmp/benchSuite.log"
+#define BENCH_TRACE_PATH        "/tmp/benchSuite.trace.json"
+#define BENCH_TRACE_EVENTS      65536       // Ring per thread, holds a run at the default samples
+
+typedef enum
+{
+    BENCH_FORMAT_TEXT = 0,
+    BENCH_FORMAT_CSV,
+    BENCH_FORMAT_JSON
+} benchFormat_t;
+
+typedef struct
+{
+    const char* t_pcName;
+    const char* t_pcDescription;
+    uint32_t t_ulBatch;                 // Operations per sample
+    int t_iMaxThreads;                  // 1 for cases with a fixed topology
+    bool (*t_pfSetup)(int p_iThreads);
+    bool (*t_pfRun)(int p_iIndex, uint32_t p_ulOps);
+    void (*t_pfTeardown)(int p_iThreads);
+} benchCase_t;
+
+typedef struct
+{
+    const benchCase_t* t_ptCase;
+    int t_iIndex;
+    uint32_t t_ulSamples;
+    double* t_pdSamples;                // Nanoseconds per operation, one per sample
+    double t_dStart;                    // Measured phase, for the wall time of the run
+    double t_dEnd;
+    bool t_bFailed;
+} benchWorker_t;
+
+typedef struct
+{
+    uint64_t t_ulOps;
+    double t_dWallSeconds;
+    double t_dMean;
+    double t_dP50;
+    double t_dP90;
+    double t_dP99;
+    double t_dP999;
+    double t_dMax;
+} benchResult_t;
+
+static pthread_barrier_t s_tStartBarrier;
+static uint32_t s_ulSamples = BENCH_DEFAULT_SAMPLES;
+static unsigned short s_usPort = BENCH_DEFAULT_PORT;
+static const char* s_pcLogPath = BENCH_LOG_PATH;
+#ifdef USE_TLS
+static const char* s_pcCertPath = NULL;
+static const char* s_pcKeyPath = NULL;
+static const char* s_pcCaPath = NULL;
+#endif
+
+static double benchNow(void)
+{
+    struct timespec l_tNow;
+    clock_gettime(CLOCK_MONOTONIC, &l_tNow);
+    return (double)l_tNow.tv_sec + (double)l_tNow.tv_nsec * 1e-9;
+}
+
+////////////////////////////////////////////////////////////
+/// Memory
+////////////////////////////////////////////////////////////
+
+static bool benchMemSmall(int p_iIndex, uint32_t p_ulOps)
+{
+    (void)p_iIndex;
+    for (uint32_t i = 0; i < p_ulOps; i++)
+    {
+        void* l_pvBlock = X_MALLOC(64);
+        if (!l_pvBlock)
+        {
+            return false;
+        }
+        X_FREE(l_pvBlock);
+    }
+    return true;
+}
+
+static bool benchMemLarge(int p_iIndex, uint32_t p_ulOps)
+{
+    (void)p_iIndex;
+    for (uint32_t i = 0; i < p_ulOps; i++)
+    {
+        void* l_pvBlock = X_MALLOC(4096);
+        if (!l_pvBlock)
+        {
+            return false;
+        }
+        X_FREE(l_pvBlock);
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////
+/// Logging
+////////////////////////////////////////////////////////////
+
+static bool benchLogOpen(bool p_bAsync)
+{
+    t_logCtx l_tConfig;
+    memset(&l_tConfig, 0, sizeof(l_tConfig));
+    l_tConfig.t_bLogToFile = true;
+    l_tConfig.t_bLogToConsole = false;
+    snprintf(l_tConfig.t_cLogPath, sizeof(l_tConfig.t_cLogPath), "%s", s_pcLogPath);
+    l_tConfig.t_bAsync = p_bAsync;
+    l_tConfig.t_eOverflowPolicy = XOS_LOG_OVERFLOW_BLOCK;
+    l_tConfig.t_eMinLevel = XOS_LOG_LEVEL_TRACE;
+    return xLogInit(&l_tConfig) == (int)XOS_LOG_OK;
+}
+
+static bool benchLogSetupSync(int p_iThreads)
+{
+    (void)p_iThreads;
+    return benchLogOpen(false);
+}
+
+static bool benchLogSetupAsync(int p_iThreads)
+{
+    (void)p_iThreads;
+    return benchLogOpen(true);
+}
+
+static void benchLogTeardown(int p_iThreads)
+{
+    (void)p_iThreads;
+    xLogClose();
+}
+
+static bool benchLogWrite(int p_iIndex, uint32_t p_ulOps)
+{
+    for (uint32_t i = 0; i < p_ulOps; i++)
+    {
+        if (xLogWrite(__FILE__, __LINE__, "bench thread %d message %u", p_iIndex, i) != (int)XOS_LOG_OK)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////
+/// Tracing, one event per operation, spans opened and closed in turn
+////////////////////////////////////////////////////////////
+
+static bool benchTraceSetup(int p_iThreads)
+{
+    (void)p_iThreads;
+    return xTraceStart(BENCH_TRACE_PATH, 0, BENCH_TRACE_EVENTS) == (int)XOS_TRACE_OK;
+}
+
+static void benchTraceTeardown(int p_iThreads)
+{
+    (void)p_iThreads;
+    uint64_t l_ulDropped = xTraceGetDroppedCount();
+    xTraceStop();
+    if (l_ulDropped > 0)
+    {
+        fprintf(stderr, "trace.event: %llu events dropped, the latencies include the drop path\n",
+                (unsigned long long)l_ulDropped);
+    }
+}
+
+static bool benchTraceRun(int p_iIndex, uint32_t p_ulOps)
+{
+    (void)p_iIndex;
+    for (uint32_t i = 0; i < p_ulOps; i++)
+    {
+        xTraceRecord((i & 1U) ? XOS_TRACE_EVENT_END : XOS_TRACE_EVENT_BEGIN, "bench.span", 0);
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////
+/// Metrics, every thread adds to the same sharded counter
+////////////////////////////////////////////////////////////
+
+static xMetric_t* s_ptBenchCounter = NULL;
+
+static bool benchMetricsSetup(int p_iThreads)
+{
+    (void)p_iThreads;
+    return xMetricsRegisterCounter("bench_counter_total", "benchSuite counter", &s_ptBenchCounter) == (int)XOS_METRICS_OK;
+}
+
+static bool benchMetricsRun(int p_iIndex, uint32_t p_ulOps)
+{
+    (void)p_iIndex;
+    for (uint32_t i = 0; i < p_ulOps; i++)
+    {
+        xMetricsInc(s_ptBenchCounter);
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////
+/// Mutexes, every thread takes the same lock
+////////////////////////////////////////////////////////////
+
+static xOsMutexCtx s_tMutex;
+static xOsFastMutex s_tFastMutex = XOS_FAST_MUTEX_INITIALIZER;
+static volatile uint64_t s_ulGuarded;
+
+static bool benchMutexSetup(int p_iThreads)
+{
+    (void)p_iThreads;
+    return mutexCreate(&s_tMutex) == (int)MUTEX_OK;
+}
+
+static void benchMutexTeardown(int p_iThreads)
+{
+    (void)p_iThreads;
+    mutexDestroy(&s_tMutex);
+}
+
+static bool benchMutexRun(int p_iIndex, uint32_t p_ulOps)
+{
+    (void)p_iIndex;
+    for (uint32_t i = 0; i < p_ulOps; i++)
+    {
+        if (mutexLock(&s_tMutex) != (int)MUTEX_OK)
+        {
+            return false;
+        }
+        s_ulGuarded = s_ulGuarded + 1;
+        mutexUnlock(&s_tMutex);
+    }
+    return true;
+}
+
+static bool benchFastMutexRun(int p_iIndex, uint32_t p_ulOps)
+{
+    (void)p_iIndex;
+    for (uint32_t i = 0; i < p_ulOps; i++)
+    {
+        if (mutexFastLock(&s_tFastMutex) != (int)MUTEX_OK)
+        {
+            return false;
+        }
+        s_ulGuarded = s_ulGuarded + 1;
+        mutexFastUnlock(&s_tFastMutex);
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////
+/// Semaphores, a post and a wait per operation on a per-thread
+/// semaphore, and a ping-pong through a second thread
+////////////////////////////////////////////////////////////
+
+static t_OSSemCtx s_tSems[BENCH_MAX_THREADS];
+static t_OSFastSemCtx s_tFastSems[BENCH_MAX_THREADS];
+static t_OSFastSemCtx s_tPing;
+static t_OSFastSemCtx s_tPong;
+static pthread_t s_tPongThread;
+static volatile bool s_bPongStop;
+
+static bool benchSemSetup(int p_iThreads)
+{
+    for (int i = 0; i < p_iThreads; i++)
+    {
+        if (osSemInit(&s_tSems[i], 0, NULL) != (int)OS_SEM_SUCCESS ||
+            osFastSemInit(&s_tFastSems[i], 0) != (int)OS_SEM_SUCCESS)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void benchSemTeardown(int p_iThreads)
+{
+    for (int i = 0; i < p_iThreads; i++)
+    {
+        osSemDestroy(&s_tSems[i]);
+        osFastSemDestroy(&s_tFastSems[i]);
+    }
+}
+
+static bool benchSemRun(int p_iIndex, uint32_t p_ulOps)
+{
+    for (uint32_t i = 0; i < p_ulOps; i++)
+    {
+        if (osSemPost(&s_tSems[p_iIndex]) != (int)OS_SEM_SUCCESS ||
+            osSemWait(&s_tSems[p_iIndex]) != (int)OS_SEM_SUCCESS)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool benchFastSemRun(int p_iIndex, uint32_t p_ulOps)
+{
+    for (uint32_t i = 0; i < p_ulOps; i++)
+    {
+        if (osFastSemPost(&s_tFastSems[p_iIndex]) != (int)OS_SEM_SUCCESS ||
+            osFastSemWait(&s_tFastSems[p_iIndex]) != (int)OS_SEM_SUCCESS)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void* benchPongThread(void* p_ptArg)
+{
+    (void)p_ptArg;
+    for (;;)
+    {
+        osFastSemWait(&s_tPing);
+        if (s_bPongStop)
+        {
+            break;
+        }
+        osFastSemPost(&s_tPong);
+    }
+    return NULL;
+}
+
+static bool benchPingSetup(int p_iThreads)
+{
+    (void)p_iThreads;
+    s_bPongStop = false;
+    if (osFastSemInit(&s_tPing, 0) != (int)OS_SEM_SUCCESS || osFastSemInit(&s_tPong, 0) != (int)OS_SEM_SUCCESS)
+    {
+        return false;
+    }
+    return pthread_create(&s_tPongThread, NULL, benchPongThread, NULL) == 0;
+}
+
+static void benchPingTeardown(int p_iThreads)
+{
+    (void)p_iThreads;
+    s_bPongStop = true;
+    osFastSemPost(&s_tPing);
+    pthread_join(s_tPongThread, NULL);
+    osFastSemDestroy(&s_tPing);
+    osFastSemDestroy(&s_tPong);
+}
+
+static bool benchPingRun(int p_iIndex, uint32_t p_ulOps)
+{
+    (void)p_iIndex;
+    for (uint32_t i = 0; i < p_ulOps; i++)
+    {
+        if (osFastSemPost(&s_tPing) != (int)OS_SEM_SUCCESS || osFastSemWait(&s_tPong) != (int)OS_SEM_SUCCESS)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////
+/// Timers, the check of a running timer that does not expire
+////////////////////////////////////////////////////////////
+
+static xOsTimerCtx s_tTimers[BENCH_MAX_THREADS];
+
+static bool benchTimerSetup(int p_iThreads)
+{
+    for (int i = 0; i < p_iThreads; i++)
+    {
+        if (xTimerCreate(&s_tTimers[i], 3600000, XOS_TIMER_MODE_PERIODIC) != (int)XOS_TIMER_OK ||
+            xTimerStart(&s_tTimers[i]) != (int)XOS_TIMER_OK)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void benchTimerTeardown(int p_iThreads)
+{
+    for (int i = 0; i < p_iThreads; i++)
+    {
+        xTimerStop(&s_tTimers[i]);
+    }
+}
+
+static bool benchTimerRun(int p_iIndex, uint32_t p_ulOps)
+{
+    for (uint32_t i = 0; i < p_ulOps; i++)
+    {
+        if (xTimerExpired(&s_tTimers[p_iIndex]) == (int)XOS_TIMER_OK)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////
+/// Hashing
+////////////////////////////////////////////////////////////
+
+static uint8_t s_ucHashInput[BENCH_HASH_LARGE];
+
+static bool benchHashRun(t_hashAlgorithm p_eType, size_t p_ulSize, uint32_t p_ulOps)
+{
+    uint8_t l_ucHash[XOS_HASH_MAX_SIZE];
+    for (uint32_t i = 0; i < p_ulOps; i++)
+    {
+        size_t l_ulHashSize = sizeof(l_ucHash);
+        if (xHashCalculate(p_eType, s_ucHashInput, p_ulSize, l_ucHash, &l_ulHashSize) != (int)XOS_HASH_OK)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool benchHashSetup(int p_iThreads)
+{
+    (void)p_iThreads;
+    for (size_t i = 0; i < sizeof(s_ucHashInput); i++)
+    {
+        s_ucHashInput[i] = (uint8_t)(i * 31U + 7U);
+    }
+    return true;
+}
+
+static bool benchSha256Small(int p_iIndex, uint32_t p_ulOps)
+{
+    (void)p_iIndex;
+    return benchHashRun(XOS_HASH_TYPE_SHA256, 64, p_ulOps);
+}
+
+static bool benchSha256Large(int p_iIndex, uint32_t p_ulOps)
+{
+    (void)p_iIndex;
+    return benchHashRun(XOS_HASH_TYPE_SHA256, BENCH_HASH_LARGE, p_ulOps);
+}
+
+static bool benchXxh3Large(int p_iIndex, uint32_t p_ulOps)
+{
+    (void)p_iIndex;
+    return benchHashRun(XOS_HASH_TYPE_XXH3_64, BENCH_HASH_LARGE, p_ulOps);
+}
+
+////////////////////////////////////////////////////////////
+/// Network, a request and its echo per operation, one loopback
+/// connection and one echo thread per measuring thread; the
+/// connections are TLS when the library is built with USE_TLS
+////////////////////////////////////////////////////////////
+
+static NetworkSocket* s_ptListener;
+static NetworkSocket* s_ptClients[BENCH_MAX_THREADS];
+static pthread_t s_tEchoThreads[BENCH_MAX_THREADS];
+static int s_iEchoThreads;
+
+static NetworkSocketOptions benchNetworkOptions(void)
+{
+    NetworkSocketOptions l_tOptions;
+    memset(&l_tOptions, 0, sizeof(l_tOptions));
+    // Without it each echo waits for the delayed acknowledgement
+    l_tOptions.t_bNoDelay = true;
+    return l_tOptions;
+}
+
+static NetworkSocket* benchNetworkSocket(bool p_bServer)
+{
+    NetworkSocketOptions l_tOptions = benchNetworkOptions();
+#ifdef USE_TLS
+    NetworkTlsConfig l_tConfig;
+    memset(&l_tConfig, 0, sizeof(l_tConfig));
+    l_tConfig.t_bVerifyPeer = !p_bServer && s_pcCaPath != NULL;
+    l_tConfig.t_cCaPath = s_pcCaPath;
+    l_tConfig.t_cCertPath = s_pcCertPath;
+    l_tConfig.t_cKeyPath = s_pcKeyPath;
+    l_tConfig.t_eVersion = TLS_VERSION_1_3;
+    l_tConfig.t_eCurve = TLS_ECC_SECP256R1;
+    l_tConfig.t_ptOptions = &l_tOptions;
+    return networkCreateSecureSocket(&l_tConfig);
+#else
+    (void)p_bServer;
+    return networkCreateSocketEx(NETWORK_SOCK_TCP, &l_tOptions);
+#endif
+}
+
+static void* benchEchoThread(void* p_ptArg)
+{
+    (void)p_ptArg;
+    char l_cBuffer[BENCH_MESSAGE_SIZE];
+    NetworkSocket* l_ptPeer = networkAccept(s_ptListener, NULL);
+    if (!l_ptPeer)
+    {
+        return NULL;
+    }
+
+    NetworkSocketOptions l_tOptions = benchNetworkOptions();
+    networkSetOptions(l_ptPeer, &l_tOptions);
+    for (;;)
+    {
+        int l_iReceived = networkReceive(l_ptPeer, l_cBuffer, sizeof(l_cBuffer));
+        if (l_iReceived <= 0 || networkSend(l_ptPeer, l_cBuffer, (unsigned long)l_iReceived) != l_iReceived)
+        {
+            break;
+        }
+    }
+
+    networkCloseSocket(l_ptPeer);
+    return NULL;
+}
+
+static void benchNetworkTeardown(int p_iThreads)
+{
+    // Closing the clients ends the echo threads
+    for (int i = 0; i < p_iThreads; i++)
+    {
+        if (s_ptClients[i])
+        {
+            networkCloseSocket(s_ptClients[i]);
+            s_ptClients[i] = NULL;
+        }
+    }
+    for (int i = 0; i < s_iEchoThreads; i++)
+    {
+        pthread_join(s_tEchoThreads[i], NULL);
+    }
+    s_iEchoThreads = 0;
+    if (s_ptListener)
+    {
+        networkCloseSocket(s_ptListener);
+        s_ptListener = NULL;
+    }
+}
+
+static bool benchNetworkSetup(int p_iThreads)
+{
+#ifdef USE_TLS
+    if (!s_pcCertPath || !s_pcKeyPath)
+    {
+        fprintf(stderr, "TLS cases need --cert and --key\n");
+        return false;
+    }
+#endif
+    // A fresh port per run, the previous one may still be in TIME_WAIT
+    NetworkAddress l_tAddress = networkMakeAddress("127.0.0.1", s_usPort++);
+    s_ptListener = benchNetworkSocket(true);
+    if (!s_ptListener || networkBind(s_ptListener, &l_tAddress) != (int)NETWORK_OK ||
+        networkListen(s_ptListener, p_iThreads) != (int)NETWORK_OK)
+    {
+        return false;
+    }
+
+    // Accepting on the echo threads lets a TLS connect run its handshake
+    for (int i = 0; i < p_iThreads; i++)
+    {
+        if (pthread_create(&s_tEchoThreads[i], NULL, benchEchoThread, NULL) != 0)
+        {
+            return false;
+        }
+        s_iEchoThreads++;
+    }
+    for (int i = 0; i < p_iThreads; i++)
+    {
+        s_ptClients[i] = benchNetworkSocket(false);
+        if (!s_ptClients[i] || networkConnect(s_ptClients[i], &l_tAddress) != (int)NETWORK_OK)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool benchNetworkRun(int p_iIndex, uint32_t p_ulOps)
+{
+    char l_cMessage[BENCH_MESSAGE_SIZE];
+    memset(l_cMessage, 'x', sizeof(l_cMessage));
+    for (uint32_t i = 0; i < p_ulOps; i++)
+    {
+        if (networkSend(s_ptClients[p_iIndex], l_cMessage, sizeof(l_cMessage)) != (int)sizeof(l_cMessage))
+        {
+            return false;
+        }
+        unsigned long l_ulReceived = 0;
+        while (l_ulReceived < sizeof(l_cMessage))
+        {
+            int l_iReceived = networkReceive(s_ptClients[p_iIndex], l_cMessage + l_ulReceived,
+                                             sizeof(l_cMessage) - l_ulReceived);
+            if (l_iReceived <= 0)
+            {
+                return false;
+            }
+            l_ulReceived += (unsigned long)l_iReceived;
+        }
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////
+/// Tasks, the creation and join of a task that returns at once
+////////////////////////////////////////////////////////////
+
+static void* benchTaskBody(void* p_ptArg)
+{
+    return p_ptArg;
+}
+
+static bool benchTaskRun(int p_iIndex, uint32_t p_ulOps)
+{
+    (void)p_iIndex;
+    for (uint32_t i = 0; i < p_ulOps; i++)
+    {
+        xOsTaskCtx l_tTask;
+        if (osTaskInit(&l_tTask) != OS_TASK_SUCCESS)
+        {
+            return false;
+        }
+        l_tTask.t_ptTask = benchTaskBody;
+        l_tTask.t_ptTaskArg = NULL;
+        l_tTask.t_pcName = "bench";
+        if (osTaskCreate(&l_tTask) != OS_TASK_SUCCESS || osTaskWait(&l_tTask, NULL) != OS_TASK_SUCCESS)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////
+/// Case table
+////////////////////////////////////////////////////////////
+
+static const benchCase_t s_tCases[] = {
+    { "mem.alloc_free_64",  "X_MALLOC + X_FREE of 64 bytes",            64, BENCH_MAX_THREADS, NULL, benchMemSmall, NULL },
+    { "mem.alloc_free_4k",  "X_MALLOC + X_FREE of 4 KiB",               64, BENCH_MAX_THREADS, NULL, benchMemLarge, NULL },
+    { "log.write_sync",     "xLogWrite to a file, synchronous",         16, BENCH_MAX_THREADS, benchLogSetupSync, benchLogWrite, benchLogTeardown },
+    { "log.write_async",    "xLogWrite to a file, writer task",         16, BENCH_MAX_THREADS, benchLogSetupAsync, benchLogWrite, benchLogTeardown },
+    { "trace.event",        "xTraceRecord into the thread ring",        16, BENCH_MAX_THREADS, benchTraceSetup, benchTraceRun, benchTraceTeardown },
+    { "metrics.counter_add", "xMetricsInc on a shared counter",         64, BENCH_MAX_THREADS, benchMetricsSetup, benchMetricsRun, NULL },
+    { "mutex.lock_unlock",  "mutexLock + mutexUnlock, one shared lock", 64, BENCH_MAX_THREADS, benchMutexSetup, benchMutexRun, benchMutexTeardown },
+    { "mutex.fast",         "mutexFastLock + mutexFastUnlock, shared",  64, BENCH_MAX_THREADS, NULL, benchFastMutexRun, NULL },
+    { "sem.post_wait",      "osSemPost + osSemWait, per thread",        64, BENCH_MAX_THREADS, benchSemSetup, benchSemRun, benchSemTeardown },
+    { "sem.fast_post_wait", "osFastSemPost + osFastSemWait, per thread", 64, BENCH_MAX_THREADS, benchSemSetup, benchFastSemRun, benchSemTeardown },
+    { "sem.fast_pingpong",  "osFastSem round trip through a thread",     1, 1, benchPingSetup, benchPingRun, benchPingTeardown },
+    { "timer.expired",      "xTimerExpired on a running timer",         64, BENCH_MAX_THREADS, benchTimerSetup, benchTimerRun, benchTimerTeardown },
+    { "hash.sha256_64",     "xHashCalculate SHA-256 of 64 bytes",       16, BENCH_MAX_THREADS, benchHashSetup, benchSha256Small, NULL },
+    { "hash.sha256_4k",     "xHashCalculate SHA-256 of 4 KiB",           1, BENCH_MAX_THREADS, benchHashSetup, benchSha256Large, NULL },
+    { "hash.xxh3_4k",       "xHashCalculate XXH3-64 of 4 KiB",           4, BENCH_MAX_THREADS, benchHashSetup, benchXxh3Large, NULL },
+#ifdef USE_TLS
+    { "net.tls_roundtrip",  "TLS loopback echo of 64 bytes",             1, BENCH_MAX_THREADS, benchNetworkSetup, benchNetworkRun, benchNetworkTeardown },
+#else
+    { "net.tcp_roundtrip",  "TCP loopback echo of 64 bytes",             1, BENCH_MAX_THREADS, benchNetworkSetup, benchNetworkRun, benchNetworkTeardown },
+#endif
+    { "task.create_join",   "osTaskCreate + osTaskWait",                 1, BENCH_MAX_THREADS, NULL, benchTaskRun, NULL },
+};
+
+#define BENCH_CASE_COUNT (sizeof(s_tCases) / sizeof(s_tCases[0]))
+
+////////////////////////////////////////////////////////////
+/// Runner
+////////////////////////////////////////////////////////////
+
+static void* benchWorker(void* p_ptArg)
+{
+    benchWorker_t* l_ptWorker = (benchWorker_t*)p_ptArg;
+    const benchCase_t* l_ptCase = l_ptWorker->t_ptCase;
+    uint32_t l_ulWarmup = l_ptWorker->t_ulSamples / BENCH_WARMUP_DIVIDER + 1;
+
+    for (uint32_t i = 0; i < l_ulWarmup && !l_ptWorker->t_bFailed; i++)
+    {
+        l_ptWorker->t_bFailed = !l_ptCase->t_pfRun(l_ptWorker->t_iIndex, l_ptCase->t_ulBatch);
+    }
+
+    // A failed worker still joins the barrier, the others would wait forever
+    pthread_barrier_wait(&s_tStartBarrier);
+
+    l_ptWorker->t_dStart = benchNow();
+    for (uint32_t i = 0; i < l_ptWorker->t_ulSamples && !l_ptWorker->t_bFailed; i++)
+    {
+        double l_dStart = benchNow();
+        l_ptWorker->t_bFailed = !l_ptCase->t_pfRun(l_ptWorker->t_iIndex, l_ptCase->t_ulBatch);
+        l_ptWorker->t_pdSamples[i] = (benchNow() - l_dStart) * 1e9 / (double)l_ptCase->t_ulBatch;
+    }
+    l_ptWorker->t_dEnd = benchNow();
+
+    return NULL;
+}
+
+static int benchCompare(const void* p_pvLeft, const void* p_pvRight)
+{
+    double l_dLeft = *(const double*)p_pvLeft;
+    double l_dRight = *(const double*)p_pvRight;
+    return (l_dLeft > l_dRight) - (l_dLeft < l_dRight);
+}
+
+static double benchPercentile(const double* p_pdSorted, size_t p_ulCount, double p_dRank)
+{
+    // Nearest rank
+    size_t l_ulIndex = (size_t)(p_dRank * (double)p_ulCount + 0.999999);
+    if (l_ulIndex > 0)
+    {
+        l_ulIndex--;
+    }
+    if (l_ulIndex >= p_ulCount)
+    {
+        l_ulIndex = p_ulCount - 1;
+    }
+    return p_pdSorted[l_ulIndex];
+}
+
+static bool benchRun(const benchCase_t* p_ptCase, int p_iThreads, benchResult_t* p_ptResult)
+{
+    benchWorker_t l_tWorkers[BENCH_MAX_THREADS];
+    pthread_t l_tThreads[BENCH_MAX_THREADS];
+    size_t l_ulTotal = (size_t)s_ulSamples * (size_t)p_iThreads;
+    double* l_pdSamples = malloc(l_ulTotal * sizeof(double));
+    if (!l_pdSamples)
+    {
+        return false;
+    }
+
+    if (p_ptCase->t_pfSetup && !p_ptCase->t_pfSetup(p_iThreads))
+    {
+        free(l_pdSamples);
+        return false;
+    }
+
+    pthread_barrier_init(&s_tStartBarrier, NULL, (unsigned)p_iThreads + 1U);
+    int l_iStarted = 0;
+    for (int i = 0; i < p_iThreads; i++)
+    {
+        l_tWorkers[i].t_ptCase = p_ptCase;
+        l_tWorkers[i].t_iIndex = i;
+        l_tWorkers[i].t_ulSamples = s_ulSamples;
+        l_tWorkers[i].t_pdSamples = l_pdSamples + (size_t)i * s_ulSamples;
+        l_tWorkers[i].t_bFailed = false;
+        if (pthread_create(&l_tThreads[i], NULL, benchWorker, &l_tWorkers[i]) != 0)
+        {
+            break;
+        }
+        l_iStarted++;
+    }
+    if (l_iStarted != p_iThreads)
+    {
+        // The started workers are stuck on the barrier, nothing sensible is left to do
+        fprintf(stderr, "%s: thread creation failed\n", p_ptCase->t_pcName);
+        exit(1);
+    }
+
+    // The workers time themselves, this thread may only run again once they are done
+    pthread_barrier_wait(&s_tStartBarrier);
+    for (int i = 0; i < p_iThreads; i++)
+    {
+        pthread_join(l_tThreads[i], NULL);
+    }
+    pthread_barrier_destroy(&s_tStartBarrier);
+
+    if (p_ptCase->t_pfTeardown)
+    {
+        p_ptCase->t_pfTeardown(p_iThreads);
+    }
+
+    bool l_bFailed = false;
+    double l_dFirst = l_tWorkers[0].t_dStart;
+    double l_dLast = l_tWorkers[0].t_dEnd;
+    for (int i = 0; i < p_iThreads; i++)
+    {
+        l_bFailed = l_bFailed || l_tWorkers[i].t_bFailed;
+        l_dFirst = (l_tWorkers[i].t_dStart < l_dFirst) ? l_tWorkers[i].t_dStart : l_dFirst;
+        l_dLast = (l_tWorkers[i].t_dEnd > l_dLast) ? l_tWorkers[i].t_dEnd : l_dLast;
+    }
+    if (l_bFailed)
+    {
+        free(l_pdSamples);
+        return false;
+    }
+
+    double l_dSum = 0.0;
+    for (size_t i = 0; i < l_ulTotal; i++)
+    {
+        l_dSum += l_pdSamples[i];
+    }
+    qsort(l_pdSamples, l_ulTotal, sizeof(double), benchCompare);
+
+    p_ptResult->t_ulOps = (uint64_t)l_ulTotal * p_ptCase->t_ulBatch;
+    p_ptResult->t_dWallSeconds = l_dLast - l_dFirst;
+    p_ptResult->t_dMean = l_dSum / (double)l_ulTotal;
+    p_ptResult->t_dP50 = benchPercentile(l_pdSamples, l_ulTotal, 0.50);
+    p_ptResult->t_dP90 = benchPercentile(l_pdSamples, l_ulTotal, 0.90);
+    p_ptResult->t_dP99 = benchPercentile(l_pdSamples, l_ulTotal, 0.99);
+    p_ptResult->t_dP999 = benchPercentile(l_pdSamples, l_ulTotal, 0.999);
+    p_ptResult->t_dMax = l_pdSamples[l_ulTotal - 1];
+    free(l_pdSamples);
+    return true;
+}
+
+////////////////////////////////////////////////////////////
+/// Output
+////////////////////////////////////////////////////////////
+
+static void benchPrintHeader(FILE* p_ptOut, benchFormat_t p_eFormat, long p_lCpus)
+{
+    char l_cDate[32];
+    time_t l_tNow = time(NULL);
+    struct tm l_tUtc;
+    gmtime_r(&l_tNow, &l_tUtc);
+    strftime(l_cDate, sizeof(l_cDate), "%Y-%m-%dT%H:%M:%SZ", &l_tUtc);
+
+    switch (p_eFormat)
+    {
+        case BENCH_FORMAT_TEXT:
+            fprintf(p_ptOut, "dynamicBric_PATO %s benchmark suite, %s, %ld cpus, %u samples\n",
+                    BENCH_VERSION, l_cDate, p_lCpus, s_ulSamples);
+            fprintf(p_ptOut, "latencies in ns per operation\n");
+            fprintf(p_ptOut, "%-20s %4s %10s %10s %10s %10s %10s %10s %10s\n",
+                    "case", "thr", "mean", "p50", "p90", "p99", "p99.9", "max", "Mops/s");
+            break;
+        case BENCH_FORMAT_CSV:
+            fprintf(p_ptOut, "case,threads,batch,ops,seconds,mean_ns,p50_ns,p90_ns,p99_ns,p999_ns,max_ns,mops\n");
+            break;
+        case BENCH_FORMAT_JSON:
+            fprintf(p_ptOut, "{\n  \"suite\": \"dynamicBric_PATO\",\n  \"version\": \"%s\",\n", BENCH_VERSION);
+            fprintf(p_ptOut, "  \"date\": \"%s\",\n  \"cpus\": %ld,\n  \"samples\": %u,\n", l_cDate, p_lCpus, s_ulSamples);
+            fprintf(p_ptOut, "  \"compiler\": \"%s\",\n", __VERSION__);
+#ifdef USE_TLS
+            fprintf(p_ptOut, "  \"tls\": true,\n");
+#else
+            fprintf(p_ptOut, "  \"tls\": false,\n");
+#endif
+            fprintf(p_ptOut, "  \"results\": [");
+            break;
+    }
+}
+
+static void benchPrintResult(FILE* p_ptOut, benchFormat_t p_eFormat, const benchCase_t* p_ptCase, int p_iThreads,
+                             const benchResult_t* p_ptResult, bool p_bFirst)
+{
+    double l_dMops = (double)p_ptResult->t_ulOps / p_ptResult->t_dWallSeconds / 1e6;
+
+    switch (p_eFormat)
+    {
+        case BENCH_FORMAT_TEXT:
+            fprintf(p_ptOut, "%-20s %4d %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f %10.3f\n", p_ptCase->t_pcName,
+                    p_iThreads, p_ptResult->t_dMean, p_ptResult->t_dP50, p_ptResult->t_dP90, p_ptResult->t_dP99,
+                    p_ptResult->t_dP999, p_ptResult->t_dMax, l_dMops);
+            break;
+        case BENCH_FORMAT_CSV:
+            fprintf(p_ptOut, "%s,%d,%u,%llu,%.6f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.4f\n", p_ptCase->t_pcName, p_iThreads,
+                    p_ptCase->t_ulBatch, (unsigned long long)p_ptResult->t_ulOps, p_ptResult->t_dWallSeconds,
+                    p_ptResult->t_dMean, p_ptResult->t_dP50, p_ptResult->t_dP90, p_ptResult->t_dP99,
+                    p_ptResult->t_dP999, p_ptResult->t_dMax, l_dMops);
+            break;
+        case BENCH_FORMAT_JSON:
+            fprintf(p_ptOut, "%s\n    {\"case\": \"%s\", \"threads\": %d, \"batch\": %u, \"ops\": %llu, "
+                    "\"seconds\": %.6f, \"mean_ns\": %.1f, \"p50_ns\": %.1f, \"p90_ns\": %.1f, \"p99_ns\": %.1f, "
+                    "\"p999_ns\": %.1f, \"max_ns\": %.1f, \"mops\": %.4f}", p_bFirst ? "" : ",",
+                    p_ptCase->t_pcName, p_iThreads, p_ptCase->t_ulBatch, (unsigned long long)p_ptResult->t_ulOps,
+                    p_ptResult->t_dWallSeconds, p_ptResult->t_dMean, p_ptResult->t_dP50, p_ptResult->t_dP90,
+                    p_ptResult->t_dP99, p_ptResult->t_dP999, p_ptResult->t_dMax, l_dMops);
+            break;
+    }
+    fflush(p_ptOut);
+}
+
+static void benchUsage(const char* p_pcProgram)
+{
+    fprintf(stderr,
+            "usage: %s [options]\n"
+            "  --filter TEXT     run the cases whose name contains TEXT\n"
+            "  --threads LIST    thread counts, e.g. 1,2,4 (default powers of two up to twice the cpus)\n"
+            "  --samples N       samples per thread (default %d)\n"
+            "  --format FORMAT   text, csv or json (default text)\n"
+            "  --output PATH     write the results to PATH instead of stdout\n"
+            "  --port N          first loopback port of the network cases (default %d)\n"
+            "  --log PATH        log file of the log cases (default %s)\n"
+#ifdef USE_TLS
+            "  --cert PATH       server certificate of the TLS cases\n"
+            "  --key PATH        server private key of the TLS cases\n"
+            "  --ca PATH         CA verifying the server, no verification when missing\n"
+#endif
+            "  --list            print the cases and exit\n",
+            p_pcProgram, BENCH_DEFAULT_SAMPLES, BENCH_DEFAULT_PORT, BENCH_LOG_PATH);
+}
+
+static int benchParseThreads(const char* p_pcList, int* p_piThreads)
+{
+    int l_iCount = 0;
+    const char* l_pcCursor = p_pcList;
+    while (*l_pcCursor && l_iCount < BENCH_MAX_THREADS)
+    {
+        char* l_pcEnd = NULL;
+        long l_lValue = strtol(l_pcCursor, &l_pcEnd, 10);
+        if (l_pcEnd == l_pcCursor || l_lValue < 1 || l_lValue > BENCH_MAX_THREADS)
+        {
+            return -1;
+        }
+        p_piThreads[l_iCount++] = (int)l_lValue;
+        l_pcCursor = (*l_pcEnd == ',') ? l_pcEnd + 1 : l_pcEnd;
+        if (*l_pcEnd != ',' && *l_pcEnd != '\0')
+        {
+            return -1;
+        }
+    }
+    return l_iCount;
+}
+
+int main(int argc, char** argv)
+{
+    const char* l_pcFilter = NULL;
+    const char* l_pcOutput = NULL;
+    benchFormat_t l_eFormat = BENCH_FORMAT_TEXT;
+    int l_iThreads[BENCH_MAX_THREADS];
+    int l_iThreadCount = 0;
+    long l_lCpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (l_lCpus < 1)
+    {
+        l_lCpus = 1;
+    }
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char* l_pcArg = argv[i];
+        const char* l_pcValue = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (strcmp(l_pcArg, "--list") == 0)
+        {
+            for (size_t c = 0; c < BENCH_CASE_COUNT; c++)
+            {
+                printf("%-20s %s\n", s_tCases[c].t_pcName, s_tCases[c].t_pcDescription);
+            }
+            return 0;
+        }
+        if (!l_pcValue)
+        {
+            benchUsage(argv[0]);
+            return 1;
+        }
+        i++;
+        if (strcmp(l_pcArg, "--filter") == 0)
+        {
+            l_pcFilter = l_pcValue;
+        }
+        else if (strcmp(l_pcArg, "--threads") == 0)
+        {
+            l_iThreadCount = benchParseThreads(l_pcValue, l_iThreads);
+            if (l_iThreadCount <= 0)
+            {
+                fprintf(stderr, "thread counts must be 1..%d\n", BENCH_MAX_THREADS);
+                return 1;
+            }
+        }
+        else if (strcmp(l_pcArg, "--samples") == 0)
+        {
+            s_ulSamples = (uint32_t)strtoul(l_pcValue, NULL, 10);
+            if (s_ulSamples == 0)
+            {
+                fprintf(stderr, "samples must be positive\n");
+                return 1;
+            }
+        }
+        else if (strcmp(l_pcArg, "--format") == 0)
+        {
+            if (strcmp(l_pcValue, "text") == 0)
+            {
+                l_eFormat = BENCH_FORMAT_TEXT;
+            }
+            else if (strcmp(l_pcValue, "csv") == 0)
+            {
+                l_eFormat = BENCH_FORMAT_CSV;
+            }
+            else if (strcmp(l_pcValue, "json") == 0)
+            {
+                l_eFormat = BENCH_FORMAT_JSON;
+            }
+            else
+            {
+                benchUsage(argv[0]);
+                return 1;
+            }
+        }
+        else if (strcmp(l_pcArg, "--output") == 0)
+        {
+            l_pcOutput = l_pcValue;
+        }
+        else if (strcmp(l_pcArg, "--port") == 0)
+        {
+            s_usPort = (unsigned short)atoi(l_pcValue);
+        }
+        else if (strcmp(l_pcArg, "--log") == 0)
+        {
+            s_pcLogPath = l_pcValue;
+        }
+#ifdef USE_TLS
+        else if (strcmp(l_pcArg, "--cert") == 0)
+        {
+            s_pcCertPath = l_pcValue;
+        }
+        else if (strcmp(l_pcArg, "--key") == 0)
+        {
+            s_pcKeyPath = l_pcValue;
+        }
+        else if (strcmp(l_pcArg, "--ca") == 0)
+        {
+            s_pcCaPath = l_pcValue;
+        }
+#endif
+        else
+        {
+            benchUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (l_iThreadCount == 0)
+    {
+        for (int l_iCount = 1; l_iCount <= 2 * l_lCpus && l_iCount <= BENCH_MAX_THREADS; l_iCount *= 2)
+        {
+            l_iThreads[l_iThreadCount++] = l_iCount;
+        }
+    }
+
+    FILE* l_ptOut = stdout;
+    if (l_pcOutput)
+    {
+        l_ptOut = fopen(l_pcOutput, "w");
+        if (!l_ptOut)
+        {
+            perror(l_pcOutput);
+            return 1;
+        }
+    }
+
+    xMemInit();
+    benchPrintHeader(l_ptOut, l_eFormat, l_lCpus);
+
+    int l_iStatus = 0;
+    bool l_bFirst = true;
+    for (size_t c = 0; c < BENCH_CASE_COUNT; c++)
+    {
+        const benchCase_t* l_ptCase = &s_tCases[c];
+        if (l_pcFilter && !strstr(l_ptCase->t_pcName, l_pcFilter))
+        {
+            continue;
+        }
+
+        for (int t = 0; t < l_iThreadCount; t++)
+        {
+            if (l_iThreads[t] > l_ptCase->t_iMaxThreads)
+            {
+                continue;
+            }
+
+            benchResult_t l_tResult;
+            if (!benchRun(l_ptCase, l_iThreads[t], &l_tResult))
+            {
+                fprintf(stderr, "%s: failed with %d threads\n", l_ptCase->t_pcName, l_iThreads[t]);
+                l_iStatus = 1;
+                break;
+            }
+            benchPrintResult(l_ptOut, l_eFormat, l_ptCase, l_iThreads[t], &l_tResult, l_bFirst);
+            l_bFirst = false;
+        }
+    }
+
+    if (l_eFormat == BENCH_FORMAT_JSON)
+    {
+        fprintf(l_ptOut, "\n  ]\n}\n");
+    }
+    if (l_ptOut != stdout)
+    {
+        fclose(l_ptOut);
+    }
+    return l_iStatus;
+}
@@ -8,9 +8,100 @@
 
 #include "xHash.h"
 #include "xAssert.h"
+#include "xMemory.h"
 #include <openssl/sha.h>
 #include <openssl/evp.h>
 #include <string.h>
+#include <pthread.h>
+#include <stdbool.h>
+
+#define XOS_HASH_TYPE_COUNT (XOS_HASH_TYPE_KECCAK_256 + 1)
+
+// Digest implementations, resolved once for the process
+static const EVP_MD* s_ptDigests[XOS_HASH_TYPE_COUNT];
+static pthread_once_t s_tDigestsOnce = PTHREAD_ONCE_INIT;
+
+// Digest context of xHashCalculate, one per thread
+static __thread EVP_MD_CTX* s_ptThreadCtx = NULL;
+static pthread_key_t s_tThreadCtxKey;
+static pthread_once_t s_tThreadCtxOnce = PTHREAD_ONCE_INIT;
+
+////////////////////////////////////////////////////////////
+/// hashDigestsInit
+////////////////////////////////////////////////////////////
+static void hashDigestsInit(void)
+{
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    // Explicit fetches skip the provider lookup EVP_sha*() costs at every init,
+    // KECCAK-256 only exists from OpenSSL 3.2 and stays NULL before
+    static const char* const s_pcNames[XOS_HASH_TYPE_COUNT] = {
+        "SHA2-256", "SHA2-384", "SHA2-512", "SHA3-256", "SHA3-384", "SHA3-512", "KECCAK-256"
+    };
+    for (int i = 0; i < XOS_HASH_TYPE_COUNT; i++)
+    {
+        s_ptDigests[i] = EVP_MD_fetch(NULL, s_pcNames[i], NULL);
+    }
+#else
+    s_ptDigests[XOS_HASH_TYPE_SHA256] = EVP_sha256();
+    s_ptDigests[XOS_HASH_TYPE_SHA384] = EVP_sha384();
+    s_ptDigests[XOS_HASH_TYPE_SHA512] = EVP_sha512();
+    s_ptDigests[XOS_HASH_TYPE_SHA3_256] = EVP_sha3_256();
+    s_ptDigests[XOS_HASH_TYPE_SHA3_384] = EVP_sha3_384();
+    s_ptDigests[XOS_HASH_TYPE_SHA3_512] = EVP_sha3_512();
+#endif
+}
+
+////////////////////////////////////////////////////////////
+/// hashGetDigest
+////////////////////////////////////////////////////////////
+static const EVP_MD* hashGetDigest(t_hashAlgorithm p_eType)
+{
+    if ((unsigned int)p_eType >= XOS_HASH_TYPE_COUNT)
+        return NULL;
+
+    pthread_once(&s_tDigestsOnce, hashDigestsInit);
+    return s_ptDigests[p_eType];
+}
+
+////////////////////////////////////////////////////////////
+/// hashIsFast
+////////////////////////////////////////////////////////////
+static bool hashIsFast(t_hashAlgorithm p_eType)
+{
+    return p_eType >= XOS_HASH_TYPE_XXH3_64 && p_eType <= XOS_HASH_TYPE_SIPHASH_1_3;
+}
+
+////////////////////////////////////////////////////////////
+/// hashThreadCtxFree
+////////////////////////////////////////////////////////////
+static void hashThreadCtxFree(void* p_ptContext)
+{
+    EVP_MD_CTX_free((EVP_MD_CTX*)p_ptContext);
+}
+
+////////////////////////////////////////////////////////////
+/// hashThreadCtxKeyInit
+////////////////////////////////////////////////////////////
+static void hashThreadCtxKeyInit(void)
+{
+    pthread_key_create(&s_tThreadCtxKey, hashThreadCtxFree);
+}
+
+////////////////////////////////////////////////////////////
+/// hashGetThreadCtx
+////////////////////////////////////////////////////////////
+static EVP_MD_CTX* hashGetThreadCtx(void)
+{
+    if (s_ptThreadCtx == NULL)
+    {
+        pthread_once(&s_tThreadCtxOnce, hashThreadCtxKeyInit);
+        s_ptThreadCtx = EVP_MD_CTX_new();
+        if (s_ptThreadCtx != NULL)
+            pthread_setspecific(s_tThreadCtxKey, s_ptThreadCtx);
+    }
+    return s_ptThreadCtx;
+}
+
 
 ////////////////////////////////////////////////////////////
 /// xHashCalculate
@@ -20,48 +111,25 @@ int xHashCalculate(t_hashAlgorithm p_eType, const void* p_ptData, size_t p_ulSiz
 {
     X_ASSERT_RETURN(p_ptData != NULL && p_ptHash != NULL && p_pulHashSize != NULL, XOS_HASH_INVALID);
 
-    EVP_MD_CTX* l_ptContext = EVP_MD_CTX_new();
-    X_ASSERT_RETURN(l_ptContext != NULL, XOS_HASH_ERROR);
-
-    const EVP_MD* l_ptMd = NULL;
-    unsigned int l_ulHashLen;
+    if (hashIsFast(p_eType))
+        return xHashFastCalculate(p_eType, NULL, 0, p_ptData, p_ulSize, p_ptHash, p_pulHashSize);
 
-    // Slectionner l'algorithme
-    switch (p_eType)
-    {
-    case XOS_HASH_TYPE_SHA256:
-        l_ptMd = EVP_sha256();
-        break;
-    case XOS_HASH_TYPE_SHA384:
-        l_ptMd = EVP_sha384();
-        break;
-    case XOS_HASH_TYPE_SHA512:
-        l_ptMd = EVP_sha512();
-        break;
-    case XOS_HASH_TYPE_SHA3_256:
-        l_ptMd = EVP_sha3_256();
-        break;
-    case XOS_HASH_TYPE_SHA3_384:
-        l_ptMd = EVP_sha3_384();
-        break;
-    case XOS_HASH_TYPE_SHA3_512:
-        l_ptMd = EVP_sha3_512();
-        break;
-    default:
-        EVP_MD_CTX_free(l_ptContext);
+    const EVP_MD* l_ptMd = hashGetDigest(p_eType);
+    if (l_ptMd == NULL)
         return XOS_HASH_INVALID;
-    }
 
+    EVP_MD_CTX* l_ptContext = hashGetThreadCtx();
+    X_ASSERT_RETURN(l_ptContext != NULL, XOS_HASH_ERROR);
+
+    unsigned int l_ulHashLen;
     if (!EVP_DigestInit_ex(l_ptContext, l_ptMd, NULL) ||
         !EVP_DigestUpdate(l_ptContext, p_ptData, p_ulSize) ||
         !EVP_DigestFinal_ex(l_ptContext, p_ptHash, &l_ulHashLen))
     {
-        EVP_MD_CTX_free(l_ptContext);
         return XOS_HASH_ERROR;
     }
 
     *p_pulHashSize = l_ulHashLen;
-    EVP_MD_CTX_free(l_ptContext);
     return XOS_HASH_OK;
 }
 
@@ -72,36 +140,31 @@ int xHashInit(t_hashAlgorithm p_eType, void* p_ptContext)
 {
     X_ASSERT_RETURN(p_ptContext != NULL, XOS_HASH_INVALID);
 
+    if (hashIsFast(p_eType))
+    {
+        xHashFastState_t* l_ptState = (xHashFastState_t*)X_MALLOC(sizeof(xHashFastState_t));
+        if (l_ptState == NULL)
+            return XOS_HASH_ERROR;
+
+        int l_iResult = xHashFastInit(l_ptState, p_eType, NULL, 0);
+        if (l_iResult != (int)XOS_HASH_OK)
+        {
+            X_FREE(l_ptState);
+            return l_iResult;
+        }
+
+        *(xHashFastState_t**)p_ptContext = l_ptState;
+        return XOS_HASH_OK;
+    }
+
+    const EVP_MD* l_ptMd = hashGetDigest(p_eType);
+    if (l_ptMd == NULL)
+        return XOS_HASH_INVALID;
+
     EVP_MD_CTX* l_ptContext = EVP_MD_CTX_new();
     if (l_ptContext == NULL)
         return XOS_HASH_ERROR;
 
-    const EVP_MD* l_ptMd = NULL;
-    switch (p_eType)
-    {
-    case XOS_HASH_TYPE_SHA256:
-        l_ptMd = EVP_sha256();
-        break;
-    case XOS_HASH_TYPE_SHA384:
-        l_ptMd = EVP_sha384();
-        break;
-    case XOS_HASH_TYPE_SHA512:
-        l_ptMd = EVP_sha512();
-        break;
-    case XOS_HASH_TYPE_SHA3_256:
-        l_ptMd = EVP_sha3_256();
-        break;
-    case XOS_HASH_TYPE_SHA3_384:
-        l_ptMd = EVP_sha3_384();
-        break;
-    case XOS_HASH_TYPE_SHA3_512:
-        l_ptMd = EVP_sha3_512();
-        break;
-    default:
-        EVP_MD_CTX_free(l_ptContext);
-        return XOS_HASH_INVALID;
-    }
-
     if (!EVP_DigestInit_ex(l_ptContext, l_ptMd, NULL))
     {
         EVP_MD_CTX_free(l_ptContext);
@@ -120,6 +183,9 @@ int xHashUpdate(t_hashAlgorithm p_eType, void* p_ptContext,
 {
     X_ASSERT_RETURN(p_ptContext != NULL && p_ptData != NULL, XOS_HASH_INVALID);
 
+    if (hashIsFast(p_eType))
+        return xHashFastUpdate(*(xHashFastState_t**)p_ptContext, p_ptData, p_ulSize);
+
     EVP_MD_CTX* l_ptContext = *(EVP_MD_CTX**)p_ptContext;
     if (!EVP_DigestUpdate(l_ptContext, p_ptData, p_ulSize))
         return XOS_HASH_ERROR;
@@ -138,6 +204,15 @@ int xHashFinalize(t_hashAlgorithm p_eType,
     X_ASSERT_RETURN(p_ptContext != NULL && p_ptHash != NULL && p_pulHashSize != NULL,
         XOS_HASH_INVALID);
 
+    if (hashIsFast(p_eType))
+    {
+        xHashFastState_t* l_ptState = *(xHashFastState_t**)p_ptContext;
+        int l_iResult = xHashFastFinalize(l_ptState, p_ptHash, p_pulHashSize);
+        X_FREE(l_ptState);
+        *(xHashFastState_t**)p_ptContext = NULL;
+        return l_iResult;
+    }
+
     EVP_MD_CTX* l_ptContext = *(EVP_MD_CTX**)p_ptContext;
     unsigned int l_ulHashLen;
 
@@ -153,3 +228,85 @@ int xHashFinalize(t_hashAlgorithm p_eType,
 
     return XOS_HASH_OK;
 }
+
+////////////////////////////////////////////////////////////
+/// xHashCtxCreate
+////////////////////////////////////////////////////////////
+int xHashCtxCreate(xHashCtx_t* p_ptCtx, t_hashAlgorithm p_eType)
+{
+    X_ASSERT_RETURN(p_ptCtx != NULL, XOS_HASH_INVALID);
+
+    p_ptCtx->t_ptMdCtx = NULL;
+    const EVP_MD* l_ptMd = hashGetDigest(p_eType);
+    if (l_ptMd == NULL)
+        return XOS_HASH_INVALID;
+
+    EVP_MD_CTX* l_ptContext = EVP_MD_CTX_new();
+    if (l_ptContext == NULL)
+        return XOS_HASH_ERROR;
+
+    if (!EVP_DigestInit_ex(l_ptContext, l_ptMd, NULL))
+    {
+        EVP_MD_CTX_free(l_ptContext);
+        return XOS_HASH_ERROR;
+    }
+
+    p_ptCtx->t_eType = p_eType;
+    p_ptCtx->t_ptMdCtx = l_ptContext;
+    return XOS_HASH_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xHashCtxReset
+////////////////////////////////////////////////////////////
+int xHashCtxReset(xHashCtx_t* p_ptCtx)
+{
+    X_ASSERT_RETURN(p_ptCtx != NULL && p_ptCtx->t_ptMdCtx != NULL, XOS_HASH_INVALID);
+
+    // Same digest as before, OpenSSL reinitializes the state in place
+    if (!EVP_DigestInit_ex((EVP_MD_CTX*)p_ptCtx->t_ptMdCtx, hashGetDigest(p_ptCtx->t_eType), NULL))
+        return XOS_HASH_ERROR;
+
+    return XOS_HASH_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xHashCtxUpdate
+////////////////////////////////////////////////////////////
+int xHashCtxUpdate(xHashCtx_t* p_ptCtx, const void* p_ptData, size_t p_ulSize)
+{
+    X_ASSERT_RETURN(p_ptCtx != NULL && p_ptCtx->t_ptMdCtx != NULL && p_ptData != NULL, XOS_HASH_INVALID);
+
+    if (!EVP_DigestUpdate((EVP_MD_CTX*)p_ptCtx->t_ptMdCtx, p_ptData, p_ulSize))
+        return XOS_HASH_ERROR;
+
+    return XOS_HASH_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xHashCtxFinal
+////////////////////////////////////////////////////////////
+int xHashCtxFinal(xHashCtx_t* p_ptCtx, uint8_t* p_ptHash, size_t* p_pulHashSize)
+{
+    X_ASSERT_RETURN(p_ptCtx != NULL && p_ptCtx->t_ptMdCtx != NULL && p_ptHash != NULL && p_pulHashSize != NULL,
+        XOS_HASH_INVALID);
+
+    unsigned int l_ulHashLen;
+    if (!EVP_DigestFinal_ex((EVP_MD_CTX*)p_ptCtx->t_ptMdCtx, p_ptHash, &l_ulHashLen))
+        return XOS_HASH_ERROR;
+
+    *p_pulHashSize = l_ulHashLen;
+    return XOS_HASH_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xHashCtxDestroy
+////////////////////////////////////////////////////////////
+int xHashCtxDestroy(xHashCtx_t* p_ptCtx)
+{
+    X_ASSERT_RETURN(p_ptCtx != NULL, XOS_HASH_INVALID);
+
+    EVP_MD_CTX_free((EVP_MD_CTX*)p_ptCtx->t_ptMdCtx);
+    p_ptCtx->t_ptMdCtx = NULL;
+    return XOS_HASH_OK;
+}
@@ -26,6 +26,23 @@
 #define XOS_HASH_SHA3_384_SIZE  48
 #define XOS_HASH_SHA3_512_SIZE  64
 #define XOS_HASH_KECCAK_256_SIZE 32
+#define XOS_HASH_XXH3_64_SIZE   8
+#define XOS_HASH_XXH3_128_SIZE  16
+#define XOS_HASH_CRC32C_SIZE    4
+#define XOS_HASH_SIPHASH_SIZE   8
+#define XOS_HASH_MAX_SIZE       64
+
+// Non-cryptographic hash parameters
+#define XOS_HASH_XXH3_SEED_SIZE      8                  // Optional seed, little-endian uint64
+#define XOS_HASH_SIPHASH_KEY_SIZE    16                 // Mandatory SipHash key
+#define XOS_HASH_XXH3_SECRET_SIZE    192
+#define XOS_HASH_XXH3_BUFFER_SIZE    256
+
+// Batch and tree hashing
+#define XOS_HASH_BATCH_MAX_THREADS   32                 // Workers of one batch, the caller included
+#define XOS_HASH_BATCH_PARALLEL_MIN  (256 * 1024)       // Smaller batches are hashed by the caller alone
+#define XOS_HASH_TREE_DEFAULT_LEAF   (1024 * 1024)      // Leaf size when 0 is given
+#define XOS_HASH_WORKER_STACK_SIZE   (256 * 1024)       // Worker thread stack
 
 // Hash types
 typedef enum {
@@ -35,9 +52,40 @@ typedef enum {
     XOS_HASH_TYPE_SHA3_256,
     XOS_HASH_TYPE_SHA3_384,
     XOS_HASH_TYPE_SHA3_512,
-    XOS_HASH_TYPE_KECCAK_256
+    XOS_HASH_TYPE_KECCAK_256,
+    // Non-cryptographic, not accepted by xHashCtx*, xHashCalculateBatch and xHashCalculateTree
+    XOS_HASH_TYPE_XXH3_64,
+    XOS_HASH_TYPE_XXH3_128,
+    XOS_HASH_TYPE_CRC32C,
+    XOS_HASH_TYPE_SIPHASH_1_3       // Keyed, only through xHashFast* and xHashSipHash13
 } t_hashAlgorithm;
 
+// Reusable hash context
+typedef struct {
+    t_hashAlgorithm t_eType;    // Algorithm the context was created for
+    void* t_ptMdCtx;            // OpenSSL digest context, kept across digests
+} xHashCtx_t;
+
+// Streaming state of the non-cryptographic hashes
+typedef struct {
+    t_hashAlgorithm t_eType;
+    uint64_t t_ulAcc[8];                                // XXH3 accumulators, SipHash v0-v3, CRC32C in [0]
+    uint64_t t_ulTotal;                                 // Bytes hashed
+    size_t t_ulBuffered;                                // Bytes waiting in t_ucBuffer
+    size_t t_ulStripes;                                 // XXH3 stripes of the current block
+    uint64_t t_ulSeed;                                  // XXH3 seed
+    uint8_t t_ucBuffer[XOS_HASH_XXH3_BUFFER_SIZE];      // Pending input
+    uint8_t t_ucSecret[XOS_HASH_XXH3_SECRET_SIZE];      // XXH3 secret derived from the seed
+} xHashFastState_t;
+
+// One input of xHashCalculateBatch
+typedef struct {
+    const void* t_ptData;       // Input data
+    size_t t_ulSize;            // Input size
+    uint8_t* t_ptHash;          // Output hash buffer
+    size_t t_ulHashSize;        // Filled with the hash size
+} xHashBatchItem_t;
+
 //////////////////////////////////
 /// @brief Calculate hash of data
 /// @param p_eType : hash type
@@ -46,6 +94,9 @@ typedef enum {
 /// @param p_ptHash : output hash buffer
 /// @param p_pulHashSize : size of hash buffer
 /// @return : success or error code
+/// @note uses a digest context kept per thread, there is no allocation
+///       per call once the thread hashed once; XXH3 and CRC32C are computed
+///       unseeded, SipHash needs xHashFastCalculate
 //////////////////////////////////
 int xHashCalculate(t_hashAlgorithm p_eType, 
                    const void* p_ptData, 
@@ -87,4 +138,164 @@ int xHashFinalize(t_hashAlgorithm p_eType,
                   uint8_t* p_ptHash, 
                   size_t* p_pulHashSize);
 
+//////////////////////////////////
+/// @brief Create a reusable hash context
+/// @param p_ptCtx : context to create
+/// @param p_eType : hash type
+/// @return : success or error code
+/// @note the context is ready for xHashCtxUpdate
+//////////////////////////////////
+int xHashCtxCreate(xHashCtx_t* p_ptCtx, t_hashAlgorithm p_eType);
+
+//////////////////////////////////
+/// @brief Restart a hash context for a new digest
+/// @param p_ptCtx : hash context
+/// @return : success or error code
+//////////////////////////////////
+int xHashCtxReset(xHashCtx_t* p_ptCtx);
+
+//////////////////////////////////
+/// @brief Update a hash context with data
+/// @param p_ptCtx : hash context
+/// @param p_ptData : input data
+/// @param p_ulSize : input size
+/// @return : success or error code
+//////////////////////////////////
+int xHashCtxUpdate(xHashCtx_t* p_ptCtx, const void* p_ptData, size_t p_ulSize);
+
+//////////////////////////////////
+/// @brief Finalize the digest of a hash context
+/// @param p_ptCtx : hash context
+/// @param p_ptHash : output hash buffer
+/// @param p_pulHashSize : size of hash buffer
+/// @return : success or error code
+/// @note the context is kept, xHashCtxReset starts the next digest
+//////////////////////////////////
+int xHashCtxFinal(xHashCtx_t* p_ptCtx, uint8_t* p_ptHash, size_t* p_pulHashSize);
+
+//////////////////////////////////
+/// @brief Destroy a hash context
+/// @param p_ptCtx : hash context
+/// @return : success or error code
+//////////////////////////////////
+int xHashCtxDestroy(xHashCtx_t* p_ptCtx);
+
+//////////////////////////////////
+/// @brief Hash independent inputs in parallel
+/// @param p_eType : hash type
+/// @param p_ptItems : inputs and their output buffers
+/// @param p_ulCount : number of inputs
+/// @param p_iThreads : workers, the caller included (0 for one per online CPU)
+/// @return : success or error code of the first input that failed
+/// @note workers take the next input as they finish one, so a few large inputs
+///       do not hold the small ones back; small batches stay on the caller.
+///       XXH3 and CRC32C run unseeded, keyed SipHash is refused (XOS_HASH_INVALID)
+//////////////////////////////////
+int xHashCalculateBatch(t_hashAlgorithm p_eType,
+                        xHashBatchItem_t* p_ptItems,
+                        size_t p_ulCount,
+                        int p_iThreads);
+
+//////////////////////////////////
+/// @brief Tree hash of a large buffer, leaves hashed in parallel
+/// @param p_eType : hash type
+/// @param p_ptData : input data
+/// @param p_ulSize : input size
+/// @param p_ulLeafSize : leaf size (0 for XOS_HASH_TREE_DEFAULT_LEAF)
+/// @param p_iThreads : workers, the caller included (0 for one per online CPU)
+/// @param p_ptHash : output hash buffer
+/// @param p_pulHashSize : size of hash buffer
+/// @return : success or error code
+/// @note leaf i is H(0x00 || data[i * leaf, (i + 1) * leaf)) and the result is
+///       H(0x01 || leaf 0 || leaf 1 ...); it depends on the leaf size but not
+///       on the number of workers, and differs from xHashCalculate.
+///       Same hash types as xHashCalculateBatch
+//////////////////////////////////
+int xHashCalculateTree(t_hashAlgorithm p_eType,
+                       const void* p_ptData,
+                       size_t p_ulSize,
+                       size_t p_ulLeafSize,
+                       int p_iThreads,
+                       uint8_t* p_ptHash,
+                       size_t* p_pulHashSize);
+
+//////////////////////////////////
+/// @brief Calculate a non-cryptographic hash of data
+/// @param p_eType : XXH3_64, XXH3_128, CRC32C or SIPHASH_1_3
+/// @param p_ptKey : XXH3 seed (NULL or XOS_HASH_XXH3_SEED_SIZE bytes), SipHash key
+///                  (XOS_HASH_SIPHASH_KEY_SIZE bytes), NULL for CRC32C
+/// @param p_ulKeySize : key size
+/// @param p_ptData : input data
+/// @param p_ulSize : input size
+/// @param p_ptHash : output hash buffer
+/// @param p_pulHashSize : size of hash buffer
+/// @return : success or error code
+/// @note XXH3 and CRC32C are written big-endian (canonical form), SipHash
+///       little-endian as in its reference; SIMD and CRC instructions are
+///       picked at runtime from the CPU features
+//////////////////////////////////
+int xHashFastCalculate(t_hashAlgorithm p_eType,
+                       const void* p_ptKey,
+                       size_t p_ulKeySize,
+                       const void* p_ptData,
+                       size_t p_ulSize,
+                       uint8_t* p_ptHash,
+                       size_t* p_pulHashSize);
+
+//////////////////////////////////
+/// @brief Initialize a non-cryptographic streaming hash
+/// @param p_ptState : state to initialize
+/// @param p_eType : XXH3_64, XXH3_128, CRC32C or SIPHASH_1_3
+/// @param p_ptKey : seed or key, as for xHashFastCalculate
+/// @param p_ulKeySize : key size
+/// @return : success or error code
+//////////////////////////////////
+int xHashFastInit(xHashFastState_t* p_ptState, t_hashAlgorithm p_eType, const void* p_ptKey, size_t p_ulKeySize);
+
+//////////////////////////////////
+/// @brief Update a non-cryptographic streaming hash with data
+/// @param p_ptState : hash state
+/// @param p_ptData : input data
+/// @param p_ulSize : input size
+/// @return : success or error code
+//////////////////////////////////
+int xHashFastUpdate(xHashFastState_t* p_ptState, const void* p_ptData, size_t p_ulSize);
+
+//////////////////////////////////
+/// @brief Finalize a non-cryptographic streaming hash
+/// @param p_ptState : hash state
+/// @param p_ptHash : output hash buffer
+/// @param p_pulHashSize : size of hash buffer
+/// @return : success or error code
+/// @note the state is left unchanged, more data may follow
+//////////////////////////////////
+int xHashFastFinalize(const xHashFastState_t* p_ptState, uint8_t* p_ptHash, size_t* p_pulHashSize);
+
+//////////////////////////////////
+/// @brief 64-bit XXH3 of data, for hash tables and dedup keys
+/// @param p_ptData : input data
+/// @param p_ulSize : input size
+/// @param p_ulSeed : seed
+/// @return : hash value
+//////////////////////////////////
+uint64_t xHashXxh3_64(const void* p_ptData, size_t p_ulSize, uint64_t p_ulSeed);
+
+//////////////////////////////////
+/// @brief CRC32C (Castagnoli) of data
+/// @param p_ulCrc : CRC of the previous data, 0 to start
+/// @param p_ptData : input data
+/// @param p_ulSize : input size
+/// @return : updated CRC
+//////////////////////////////////
+uint32_t xHashCrc32c(uint32_t p_ulCrc, const void* p_ptData, size_t p_ulSize);
+
+//////////////////////////////////
+/// @brief Keyed SipHash-1-3 of data, for tables exposed to untrusted keys
+/// @param p_pucKey : XOS_HASH_SIPHASH_KEY_SIZE bytes key
+/// @param p_ptData : input data
+/// @param p_ulSize : input size
+/// @return : hash value
+//////////////////////////////////
+uint64_t xHashSipHash13(const uint8_t* p_pucKey, const void* p_ptData, size_t p_ulSize);
+
 #endif // XOS_HASH_H_
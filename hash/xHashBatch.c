@@ -0,0 +1,327 @@
+////////////////////////////////////////////////////////////
+//  hash batch source file
+//  implements the parallel batch and tree hashing of xHash.h
+//
+// The caller and up to XOS_HASH_BATCH_MAX_THREADS - 1 workers pull
+// job indexes from one atomic counter, each with its own reusable
+// hash context, so no lock is taken per input. OpenSSL digests run on
+// an xHashCtx_t, the unkeyed fast hashes on an xHashFastState_t
+//
+// general discloser: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+
+#include "xHash.h"
+#include "xAssert.h"
+#include "xMemory.h"
+#include "xTask.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+
+typedef struct hash_job_t hashJob_t;
+
+// Worker hash context, OpenSSL digest or fast hash state
+typedef struct {
+    t_hashAlgorithm t_eType;
+    bool t_bFast;
+    xHashCtx_t t_tCtx;
+    xHashFastState_t t_tFast;
+} hashWorkerCtx_t;
+
+// Hashes job index p_ulIndex with the worker context
+typedef int (*hashJobFn)(hashJob_t* p_ptJob, hashWorkerCtx_t* p_ptCtx, size_t p_ulIndex);
+
+// Work shared by the caller and the workers
+struct hash_job_t {
+    t_hashAlgorithm t_eType;
+    hashJobFn t_pfWork;
+    size_t t_ulCount;               // Job indexes
+    atomic_size_t a_ulNext;         // Next index to take
+    atomic_int a_iResult;           // First error, XOS_HASH_OK while none
+    xHashBatchItem_t* t_ptItems;    // Batch mode
+    const uint8_t* t_pucData;       // Tree mode input
+    size_t t_ulSize;
+    size_t t_ulLeafSize;
+    uint8_t* t_pucLeaves;           // Tree mode leaf digests, XOS_HASH_MAX_SIZE apart
+};
+
+////////////////////////////////////////////////////////////
+/// hashDigestSize
+////////////////////////////////////////////////////////////
+static size_t hashDigestSize(t_hashAlgorithm p_eType)
+{
+    switch (p_eType)
+    {
+    case XOS_HASH_TYPE_XXH3_64:
+        return XOS_HASH_XXH3_64_SIZE;
+    case XOS_HASH_TYPE_XXH3_128:
+        return XOS_HASH_XXH3_128_SIZE;
+    case XOS_HASH_TYPE_CRC32C:
+        return XOS_HASH_CRC32C_SIZE;
+    case XOS_HASH_TYPE_SHA384:
+    case XOS_HASH_TYPE_SHA3_384:
+        return XOS_HASH_SHA384_SIZE;
+    case XOS_HASH_TYPE_SHA512:
+    case XOS_HASH_TYPE_SHA3_512:
+        return XOS_HASH_SHA512_SIZE;
+    default:
+        return XOS_HASH_SHA256_SIZE;
+    }
+}
+
+////////////////////////////////////////////////////////////
+/// hashCtxCreate
+////////////////////////////////////////////////////////////
+static int hashCtxCreate(hashWorkerCtx_t* p_ptCtx, t_hashAlgorithm p_eType)
+{
+    p_ptCtx->t_eType = p_eType;
+    switch (p_eType)
+    {
+    case XOS_HASH_TYPE_XXH3_64:
+    case XOS_HASH_TYPE_XXH3_128:
+    case XOS_HASH_TYPE_CRC32C:
+        p_ptCtx->t_bFast = true;
+        return xHashFastInit(&p_ptCtx->t_tFast, p_eType, NULL, 0);
+    case XOS_HASH_TYPE_SIPHASH_1_3:
+        // Keyed, there is no key to give it here
+        return XOS_HASH_INVALID;
+    default:
+        p_ptCtx->t_bFast = false;
+        return xHashCtxCreate(&p_ptCtx->t_tCtx, p_eType);
+    }
+}
+
+////////////////////////////////////////////////////////////
+/// hashCtxReset
+////////////////////////////////////////////////////////////
+static int hashCtxReset(hashWorkerCtx_t* p_ptCtx)
+{
+    return p_ptCtx->t_bFast ? xHashFastInit(&p_ptCtx->t_tFast, p_ptCtx->t_eType, NULL, 0)
+                            : xHashCtxReset(&p_ptCtx->t_tCtx);
+}
+
+////////////////////////////////////////////////////////////
+/// hashCtxUpdate
+////////////////////////////////////////////////////////////
+static int hashCtxUpdate(hashWorkerCtx_t* p_ptCtx, const void* p_ptData, size_t p_ulSize)
+{
+    return p_ptCtx->t_bFast ? xHashFastUpdate(&p_ptCtx->t_tFast, p_ptData, p_ulSize)
+                            : xHashCtxUpdate(&p_ptCtx->t_tCtx, p_ptData, p_ulSize);
+}
+
+////////////////////////////////////////////////////////////
+/// hashCtxFinal
+////////////////////////////////////////////////////////////
+static int hashCtxFinal(hashWorkerCtx_t* p_ptCtx, uint8_t* p_ptHash, size_t* p_pulHashSize)
+{
+    return p_ptCtx->t_bFast ? xHashFastFinalize(&p_ptCtx->t_tFast, p_ptHash, p_pulHashSize)
+                            : xHashCtxFinal(&p_ptCtx->t_tCtx, p_ptHash, p_pulHashSize);
+}
+
+////////////////////////////////////////////////////////////
+/// hashCtxDestroy
+////////////////////////////////////////////////////////////
+static void hashCtxDestroy(hashWorkerCtx_t* p_ptCtx)
+{
+    if (!p_ptCtx->t_bFast)
+        xHashCtxDestroy(&p_ptCtx->t_tCtx);
+}
+
+////////////////////////////////////////////////////////////
+/// hashJobFail
+////////////////////////////////////////////////////////////
+static void hashJobFail(hashJob_t* p_ptJob, int p_iResult)
+{
+    int l_iExpected = (int)XOS_HASH_OK;
+    atomic_compare_exchange_strong(&p_ptJob->a_iResult, &l_iExpected, p_iResult);
+}
+
+////////////////////////////////////////////////////////////
+/// hashJobRun
+////////////////////////////////////////////////////////////
+static void hashJobRun(hashJob_t* p_ptJob)
+{
+    hashWorkerCtx_t l_tCtx;
+    int l_iResult = hashCtxCreate(&l_tCtx, p_ptJob->t_eType);
+    if (l_iResult != (int)XOS_HASH_OK)
+    {
+        hashJobFail(p_ptJob, l_iResult);
+        return;
+    }
+
+    for (;;)
+    {
+        size_t l_ulIndex = atomic_fetch_add_explicit(&p_ptJob->a_ulNext, 1, memory_order_relaxed);
+        if (l_ulIndex >= p_ptJob->t_ulCount)
+            break;
+
+        l_iResult = p_ptJob->t_pfWork(p_ptJob, &l_tCtx, l_ulIndex);
+        if (l_iResult != (int)XOS_HASH_OK)
+            hashJobFail(p_ptJob, l_iResult);
+    }
+
+    hashCtxDestroy(&l_tCtx);
+}
+
+////////////////////////////////////////////////////////////
+/// hashJobTask
+////////////////////////////////////////////////////////////
+static void* hashJobTask(void* p_pvArg)
+{
+    hashJobRun((hashJob_t*)p_pvArg);
+    return NULL;
+}
+
+////////////////////////////////////////////////////////////
+/// hashJobExecute
+////////////////////////////////////////////////////////////
+static int hashJobExecute(hashJob_t* p_ptJob, int p_iThreads)
+{
+    atomic_init(&p_ptJob->a_ulNext, 0);
+    atomic_init(&p_ptJob->a_iResult, (int)XOS_HASH_OK);
+
+    int l_iThreads = p_iThreads;
+    if (l_iThreads <= 0)
+    {
+        long l_lCpus = sysconf(_SC_NPROCESSORS_ONLN);
+        l_iThreads = (l_lCpus > 0) ? (int)l_lCpus : 1;
+    }
+    if (l_iThreads > XOS_HASH_BATCH_MAX_THREADS)
+        l_iThreads = XOS_HASH_BATCH_MAX_THREADS;
+    if ((size_t)l_iThreads > p_ptJob->t_ulCount)
+        l_iThreads = (int)p_ptJob->t_ulCount;
+
+    // Workers that fail to start leave their share to the others
+    xOsTaskCtx l_tTasks[XOS_HASH_BATCH_MAX_THREADS];
+    int l_iStarted = 0;
+    for (int i = 1; i < l_iThreads; i++)
+    {
+        xOsTaskCtx* l_ptTask = &l_tTasks[l_iStarted];
+        osTaskInit(l_ptTask);
+        l_ptTask->t_ptTask = hashJobTask;
+        l_ptTask->t_ptTaskArg = p_ptJob;
+        l_ptTask->t_ulStackSize = XOS_HASH_WORKER_STACK_SIZE;
+        l_ptTask->t_iPriority = OS_TASK_DEFAULT_PRIORITY;
+        if (osTaskCreate(l_ptTask) != OS_TASK_SUCCESS)
+            break;
+        l_iStarted++;
+    }
+
+    hashJobRun(p_ptJob);
+    for (int i = 0; i < l_iStarted; i++)
+    {
+        osTaskWait(&l_tTasks[i], NULL);
+    }
+
+    return atomic_load(&p_ptJob->a_iResult);
+}
+
+////////////////////////////////////////////////////////////
+/// hashBatchItem
+////////////////////////////////////////////////////////////
+static int hashBatchItem(hashJob_t* p_ptJob, hashWorkerCtx_t* p_ptCtx, size_t p_ulIndex)
+{
+    xHashBatchItem_t* l_ptItem = &p_ptJob->t_ptItems[p_ulIndex];
+    int l_iResult = hashCtxReset(p_ptCtx);
+    if (l_iResult == (int)XOS_HASH_OK)
+        l_iResult = hashCtxUpdate(p_ptCtx, l_ptItem->t_ptData, l_ptItem->t_ulSize);
+    if (l_iResult == (int)XOS_HASH_OK)
+        l_iResult = hashCtxFinal(p_ptCtx, l_ptItem->t_ptHash, &l_ptItem->t_ulHashSize);
+    return l_iResult;
+}
+
+////////////////////////////////////////////////////////////
+/// hashTreeLeaf
+////////////////////////////////////////////////////////////
+static int hashTreeLeaf(hashJob_t* p_ptJob, hashWorkerCtx_t* p_ptCtx, size_t p_ulIndex)
+{
+    static const uint8_t s_ucLeafPrefix = 0x00;
+    size_t l_ulOffset = p_ulIndex * p_ptJob->t_ulLeafSize;
+    size_t l_ulSize = p_ptJob->t_ulSize - l_ulOffset;
+    if (l_ulSize > p_ptJob->t_ulLeafSize)
+        l_ulSize = p_ptJob->t_ulLeafSize;
+
+    size_t l_ulHashSize;
+    int l_iResult = hashCtxReset(p_ptCtx);
+    if (l_iResult == (int)XOS_HASH_OK)
+        l_iResult = hashCtxUpdate(p_ptCtx, &s_ucLeafPrefix, 1);
+    if (l_iResult == (int)XOS_HASH_OK && l_ulSize > 0)
+        l_iResult = hashCtxUpdate(p_ptCtx, p_ptJob->t_pucData + l_ulOffset, l_ulSize);
+    if (l_iResult == (int)XOS_HASH_OK)
+        l_iResult = hashCtxFinal(p_ptCtx, p_ptJob->t_pucLeaves + p_ulIndex * XOS_HASH_MAX_SIZE, &l_ulHashSize);
+    return l_iResult;
+}
+
+////////////////////////////////////////////////////////////
+/// xHashCalculateBatch
+////////////////////////////////////////////////////////////
+int xHashCalculateBatch(t_hashAlgorithm p_eType, xHashBatchItem_t* p_ptItems, size_t p_ulCount, int p_iThreads)
+{
+    X_ASSERT_RETURN(p_ptItems != NULL || p_ulCount == 0, XOS_HASH_INVALID);
+    if (p_ulCount == 0)
+        return XOS_HASH_OK;
+
+    size_t l_ulTotal = 0;
+    for (size_t i = 0; i < p_ulCount; i++)
+    {
+        X_ASSERT_RETURN(p_ptItems[i].t_ptData != NULL && p_ptItems[i].t_ptHash != NULL, XOS_HASH_INVALID);
+        l_ulTotal += p_ptItems[i].t_ulSize;
+    }
+
+    hashJob_t l_tJob;
+    memset(&l_tJob, 0, sizeof(l_tJob));
+    l_tJob.t_eType = p_eType;
+    l_tJob.t_pfWork = hashBatchItem;
+    l_tJob.t_ulCount = p_ulCount;
+    l_tJob.t_ptItems = p_ptItems;
+
+    // Thread start-up costs more than hashing a small batch
+    return hashJobExecute(&l_tJob, (l_ulTotal < XOS_HASH_BATCH_PARALLEL_MIN) ? 1 : p_iThreads);
+}
+
+////////////////////////////////////////////////////////////
+/// xHashCalculateTree
+////////////////////////////////////////////////////////////
+int xHashCalculateTree(t_hashAlgorithm p_eType, const void* p_ptData, size_t p_ulSize, size_t p_ulLeafSize,
+    int p_iThreads, uint8_t* p_ptHash, size_t* p_pulHashSize)
+{
+    X_ASSERT_RETURN(p_ptData != NULL && p_ptHash != NULL && p_pulHashSize != NULL, XOS_HASH_INVALID);
+
+    hashJob_t l_tJob;
+    memset(&l_tJob, 0, sizeof(l_tJob));
+    l_tJob.t_eType = p_eType;
+    l_tJob.t_pfWork = hashTreeLeaf;
+    l_tJob.t_pucData = (const uint8_t*)p_ptData;
+    l_tJob.t_ulSize = p_ulSize;
+    l_tJob.t_ulLeafSize = (p_ulLeafSize > 0) ? p_ulLeafSize : XOS_HASH_TREE_DEFAULT_LEAF;
+    l_tJob.t_ulCount = (p_ulSize > 0) ? (p_ulSize + l_tJob.t_ulLeafSize - 1) / l_tJob.t_ulLeafSize : 1;
+
+    l_tJob.t_pucLeaves = (uint8_t*)X_MALLOC(l_tJob.t_ulCount * XOS_HASH_MAX_SIZE);
+    if (l_tJob.t_pucLeaves == NULL)
+        return XOS_HASH_ERROR;
+
+    int l_iResult = hashJobExecute(&l_tJob, p_iThreads);
+
+    // Root over the leaf digests in order
+    hashWorkerCtx_t l_tCtx;
+    if (l_iResult == (int)XOS_HASH_OK)
+        l_iResult = hashCtxCreate(&l_tCtx, p_eType);
+    if (l_iResult == (int)XOS_HASH_OK)
+    {
+        static const uint8_t s_ucNodePrefix = 0x01;
+        size_t l_ulLeafHashSize = hashDigestSize(p_eType);
+        l_iResult = hashCtxUpdate(&l_tCtx, &s_ucNodePrefix, 1);
+        for (size_t i = 0; i < l_tJob.t_ulCount && l_iResult == (int)XOS_HASH_OK; i++)
+        {
+            l_iResult = hashCtxUpdate(&l_tCtx, l_tJob.t_pucLeaves + i * XOS_HASH_MAX_SIZE, l_ulLeafHashSize);
+        }
+        if (l_iResult == (int)XOS_HASH_OK)
+            l_iResult = hashCtxFinal(&l_tCtx, p_ptHash, p_pulHashSize);
+        hashCtxDestroy(&l_tCtx);
+    }
+
+    X_FREE(l_tJob.t_pucLeaves);
+    return l_iResult;
+}
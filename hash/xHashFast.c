@@ -0,0 +1,1089 @@
+////////////////////////////////////////////////////////////
+//  hash fast source file
+//  implements the non-cryptographic hashes of xHash.h
+//
+// XXH3 follows the xxHash 0.8 specification, its stripe loop has
+// scalar, SSE2 and AVX2 versions; CRC32C uses the SSE4.2 or ARMv8
+// CRC instructions when present and slicing-by-8 tables otherwise.
+// The implementation is picked once, from the CPU features
+//
+// general discloser: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+
+#include "xHash.h"
+#include "xAssert.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+#if defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+
+#define XXH_PRIME32_1 0x9E3779B1U
+#define XXH_PRIME32_2 0x85EBCA77U
+#define XXH_PRIME32_3 0xC2B2AE3DU
+#define XXH_PRIME64_1 0x9E3779B185EBCA87ULL
+#define XXH_PRIME64_2 0xC2B2AE3D27D4EB4FULL
+#define XXH_PRIME64_3 0x165667B19E3779F9ULL
+#define XXH_PRIME64_4 0x85EBCA77C2B2AE63ULL
+#define XXH_PRIME64_5 0x27D4EB2F165667C5ULL
+#define XXH_PRIME_MX1 0x165667919E3779F9ULL
+#define XXH_PRIME_MX2 0x9FB21C651E98DF25ULL
+
+#define XXH_STRIPE_LEN          64
+#define XXH_SECRET_CONSUME_RATE 8
+#define XXH_STRIPES_PER_BLOCK   ((XOS_HASH_XXH3_SECRET_SIZE - XXH_STRIPE_LEN) / XXH_SECRET_CONSUME_RATE)
+#define XXH_BLOCK_LEN           (XXH_STRIPE_LEN * XXH_STRIPES_PER_BLOCK)
+#define XXH_SECRET_SIZE_MIN     136
+#define XXH_MIDSIZE_MAX         240
+#define XXH_MIDSIZE_STARTOFFSET 3
+#define XXH_MIDSIZE_LASTOFFSET  17
+#define XXH_SECRET_LASTACC_START 7
+#define XXH_SECRET_MERGEACCS_START 11
+
+#define CRC32C_POLYNOMIAL 0x82F63B78U
+
+// Default XXH3 secret, from the specification
+static const uint8_t s_ucXxh3Secret[XOS_HASH_XXH3_SECRET_SIZE] = {
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+    0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+    0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+    0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+    0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+    0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+    0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+    0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+    0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+// XXH3 accumulators before the first stripe
+static const uint64_t s_ulXxh3AccInit[8] = {
+    XXH_PRIME32_3, XXH_PRIME64_1, XXH_PRIME64_2, XXH_PRIME64_3,
+    XXH_PRIME64_4, XXH_PRIME32_2, XXH_PRIME64_5, XXH_PRIME32_1
+};
+
+// Implementations picked from the CPU features
+typedef void (*hashXxh3AccumulateFn)(uint64_t* p_pulAcc, const uint8_t* p_pucInput, const uint8_t* p_pucSecret, size_t p_ulStripes);
+typedef void (*hashXxh3ScrambleFn)(uint64_t* p_pulAcc, const uint8_t* p_pucSecret);
+typedef uint32_t (*hashCrc32cFn)(uint32_t p_ulCrc, const uint8_t* p_pucInput, size_t p_ulSize);
+
+static hashXxh3AccumulateFn s_pfXxh3Accumulate;
+static hashXxh3ScrambleFn s_pfXxh3Scramble;
+static hashCrc32cFn s_pfCrc32c;
+static uint32_t s_ulCrc32cTable[8][256];
+static pthread_once_t s_tDispatchOnce = PTHREAD_ONCE_INIT;
+
+////////////////////////////////////////////////////////////
+/// Byte order helpers
+////////////////////////////////////////////////////////////
+static inline uint32_t hashRead32(const uint8_t* p_pucInput)
+{
+    uint32_t l_ulValue;
+    memcpy(&l_ulValue, p_pucInput, sizeof(l_ulValue));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    l_ulValue = __builtin_bswap32(l_ulValue);
+#endif
+    return l_ulValue;
+}
+
+static inline uint64_t hashRead64(const uint8_t* p_pucInput)
+{
+    uint64_t l_ulValue;
+    memcpy(&l_ulValue, p_pucInput, sizeof(l_ulValue));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    l_ulValue = __builtin_bswap64(l_ulValue);
+#endif
+    return l_ulValue;
+}
+
+static inline void hashWrite64(uint8_t* p_pucOutput, uint64_t p_ulValue)
+{
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    p_ulValue = __builtin_bswap64(p_ulValue);
+#endif
+    memcpy(p_pucOutput, &p_ulValue, sizeof(p_ulValue));
+}
+
+static inline void hashWriteBig64(uint8_t* p_pucOutput, uint64_t p_ulValue)
+{
+    for (int i = 7; i >= 0; i--)
+    {
+        p_pucOutput[i] = (uint8_t)p_ulValue;
+        p_ulValue >>= 8;
+    }
+}
+
+static inline uint64_t hashRotl64(uint64_t p_ulValue, int p_iBits)
+{
+    return (p_ulValue << p_iBits) | (p_ulValue >> (64 - p_iBits));
+}
+
+////////////////////////////////////////////////////////////
+/// hashMul128
+////////////////////////////////////////////////////////////
+static inline uint64_t hashMul128(uint64_t p_ulA, uint64_t p_ulB, uint64_t* p_pulHigh)
+{
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 l_tProduct = (unsigned __int128)p_ulA * p_ulB;
+    *p_pulHigh = (uint64_t)(l_tProduct >> 64);
+    return (uint64_t)l_tProduct;
+#else
+    // 32-bit targets, schoolbook product of the halves
+    uint64_t l_ulLoLo = (p_ulA & 0xFFFFFFFFULL) * (p_ulB & 0xFFFFFFFFULL);
+    uint64_t l_ulHiLo = (p_ulA >> 32) * (p_ulB & 0xFFFFFFFFULL);
+    uint64_t l_ulLoHi = (p_ulA & 0xFFFFFFFFULL) * (p_ulB >> 32);
+    uint64_t l_ulHiHi = (p_ulA >> 32) * (p_ulB >> 32);
+    uint64_t l_ulCross = (l_ulLoLo >> 32) + (l_ulHiLo & 0xFFFFFFFFULL) + l_ulLoHi;
+    *p_pulHigh = (l_ulHiLo >> 32) + (l_ulCross >> 32) + l_ulHiHi;
+    return (l_ulCross << 32) | (l_ulLoLo & 0xFFFFFFFFULL);
+#endif
+}
+
+static inline uint64_t hashMulFold64(uint64_t p_ulA, uint64_t p_ulB)
+{
+    uint64_t l_ulHigh;
+    uint64_t l_ulLow = hashMul128(p_ulA, p_ulB, &l_ulHigh);
+    return l_ulLow ^ l_ulHigh;
+}
+
+////////////////////////////////////////////////////////////
+/// XXH3 mixers
+////////////////////////////////////////////////////////////
+static inline uint64_t hashXxh64Avalanche(uint64_t p_ulHash)
+{
+    p_ulHash ^= p_ulHash >> 33;
+    p_ulHash *= XXH_PRIME64_2;
+    p_ulHash ^= p_ulHash >> 29;
+    p_ulHash *= XXH_PRIME64_3;
+    p_ulHash ^= p_ulHash >> 32;
+    return p_ulHash;
+}
+
+static inline uint64_t hashXxh3Avalanche(uint64_t p_ulHash)
+{
+    p_ulHash ^= p_ulHash >> 37;
+    p_ulHash *= XXH_PRIME_MX1;
+    p_ulHash ^= p_ulHash >> 32;
+    return p_ulHash;
+}
+
+static inline uint64_t hashXxh3Rrmxmx(uint64_t p_ulHash, uint64_t p_ulLength)
+{
+    p_ulHash ^= hashRotl64(p_ulHash, 49) ^ hashRotl64(p_ulHash, 24);
+    p_ulHash *= XXH_PRIME_MX2;
+    p_ulHash ^= (p_ulHash >> 35) + p_ulLength;
+    p_ulHash *= XXH_PRIME_MX2;
+    p_ulHash ^= p_ulHash >> 28;
+    return p_ulHash;
+}
+
+static inline uint64_t hashXxh3Mix16(const uint8_t* p_pucInput, const uint8_t* p_pucSecret, uint64_t p_ulSeed)
+{
+    return hashMulFold64(hashRead64(p_pucInput) ^ (hashRead64(p_pucSecret) + p_ulSeed),
+                         hashRead64(p_pucInput + 8) ^ (hashRead64(p_pucSecret + 8) - p_ulSeed));
+}
+
+static inline void hashXxh3Mix32(uint64_t* p_pulLow, uint64_t* p_pulHigh, const uint8_t* p_pucInput1,
+                                 const uint8_t* p_pucInput2, const uint8_t* p_pucSecret, uint64_t p_ulSeed)
+{
+    *p_pulLow += hashXxh3Mix16(p_pucInput1, p_pucSecret, p_ulSeed);
+    *p_pulLow ^= hashRead64(p_pucInput2) + hashRead64(p_pucInput2 + 8);
+    *p_pulHigh += hashXxh3Mix16(p_pucInput2, p_pucSecret + 16, p_ulSeed);
+    *p_pulHigh ^= hashRead64(p_pucInput1) + hashRead64(p_pucInput1 + 8);
+}
+
+////////////////////////////////////////////////////////////
+/// XXH3 stripe loop, scalar
+////////////////////////////////////////////////////////////
+static void hashXxh3AccumulateScalar(uint64_t* p_pulAcc, const uint8_t* p_pucInput, const uint8_t* p_pucSecret, size_t p_ulStripes)
+{
+    for (size_t n = 0; n < p_ulStripes; n++)
+    {
+        const uint8_t* l_pucInput = p_pucInput + n * XXH_STRIPE_LEN;
+        const uint8_t* l_pucSecret = p_pucSecret + n * XXH_SECRET_CONSUME_RATE;
+        for (int i = 0; i < 8; i++)
+        {
+            uint64_t l_ulData = hashRead64(l_pucInput + 8 * i);
+            uint64_t l_ulKey = l_ulData ^ hashRead64(l_pucSecret + 8 * i);
+            p_pulAcc[i ^ 1] += l_ulData;
+            p_pulAcc[i] += (l_ulKey & 0xFFFFFFFFULL) * (l_ulKey >> 32);
+        }
+    }
+}
+
+static void hashXxh3ScrambleScalar(uint64_t* p_pulAcc, const uint8_t* p_pucSecret)
+{
+    for (int i = 0; i < 8; i++)
+    {
+        uint64_t l_ulAcc = p_pulAcc[i];
+        l_ulAcc ^= l_ulAcc >> 47;
+        l_ulAcc ^= hashRead64(p_pucSecret + 8 * i);
+        p_pulAcc[i] = l_ulAcc * XXH_PRIME32_1;
+    }
+}
+
+#if defined(__x86_64__)
+////////////////////////////////////////////////////////////
+/// XXH3 stripe loop, SSE2 (always present on x86_64)
+////////////////////////////////////////////////////////////
+static void hashXxh3AccumulateSse2(uint64_t* p_pulAcc, const uint8_t* p_pucInput, const uint8_t* p_pucSecret, size_t p_ulStripes)
+{
+    __m128i l_tAcc[4];
+    for (int i = 0; i < 4; i++)
+    {
+        l_tAcc[i] = _mm_loadu_si128((const __m128i*)(p_pulAcc + 2 * i));
+    }
+
+    for (size_t n = 0; n < p_ulStripes; n++)
+    {
+        const uint8_t* l_pucInput = p_pucInput + n * XXH_STRIPE_LEN;
+        const uint8_t* l_pucSecret = p_pucSecret + n * XXH_SECRET_CONSUME_RATE;
+        for (int i = 0; i < 4; i++)
+        {
+            __m128i l_tData = _mm_loadu_si128((const __m128i*)(l_pucInput + 16 * i));
+            __m128i l_tKey = _mm_xor_si128(l_tData, _mm_loadu_si128((const __m128i*)(l_pucSecret + 16 * i)));
+            __m128i l_tProduct = _mm_mul_epu32(l_tKey, _mm_shuffle_epi32(l_tKey, _MM_SHUFFLE(0, 3, 0, 1)));
+            l_tAcc[i] = _mm_add_epi64(l_tAcc[i], _mm_shuffle_epi32(l_tData, _MM_SHUFFLE(1, 0, 3, 2)));
+            l_tAcc[i] = _mm_add_epi64(l_tAcc[i], l_tProduct);
+        }
+    }
+
+    for (int i = 0; i < 4; i++)
+    {
+        _mm_storeu_si128((__m128i*)(p_pulAcc + 2 * i), l_tAcc[i]);
+    }
+}
+
+static void hashXxh3ScrambleSse2(uint64_t* p_pulAcc, const uint8_t* p_pucSecret)
+{
+    const __m128i l_tPrime = _mm_set1_epi32((int)XXH_PRIME32_1);
+    for (int i = 0; i < 4; i++)
+    {
+        __m128i l_tAcc = _mm_loadu_si128((const __m128i*)(p_pulAcc + 2 * i));
+        l_tAcc = _mm_xor_si128(l_tAcc, _mm_srli_epi64(l_tAcc, 47));
+        l_tAcc = _mm_xor_si128(l_tAcc, _mm_loadu_si128((const __m128i*)(p_pucSecret + 16 * i)));
+        __m128i l_tLow = _mm_mul_epu32(l_tAcc, l_tPrime);
+        __m128i l_tHigh = _mm_mul_epu32(_mm_shuffle_epi32(l_tAcc, _MM_SHUFFLE(0, 3, 0, 1)), l_tPrime);
+        _mm_storeu_si128((__m128i*)(p_pulAcc + 2 * i), _mm_add_epi64(l_tLow, _mm_slli_epi64(l_tHigh, 32)));
+    }
+}
+
+////////////////////////////////////////////////////////////
+/// XXH3 stripe loop, AVX2
+////////////////////////////////////////////////////////////
+__attribute__((target("avx2")))
+static void hashXxh3AccumulateAvx2(uint64_t* p_pulAcc, const uint8_t* p_pucInput, const uint8_t* p_pucSecret, size_t p_ulStripes)
+{
+    __m256i l_tAcc0 = _mm256_loadu_si256((const __m256i*)p_pulAcc);
+    __m256i l_tAcc1 = _mm256_loadu_si256((const __m256i*)(p_pulAcc + 4));
+
+    for (size_t n = 0; n < p_ulStripes; n++)
+    {
+        const uint8_t* l_pucInput = p_pucInput + n * XXH_STRIPE_LEN;
+        const uint8_t* l_pucSecret = p_pucSecret + n * XXH_SECRET_CONSUME_RATE;
+
+        __m256i l_tData0 = _mm256_loadu_si256((const __m256i*)l_pucInput);
+        __m256i l_tData1 = _mm256_loadu_si256((const __m256i*)(l_pucInput + 32));
+        __m256i l_tKey0 = _mm256_xor_si256(l_tData0, _mm256_loadu_si256((const __m256i*)l_pucSecret));
+        __m256i l_tKey1 = _mm256_xor_si256(l_tData1, _mm256_loadu_si256((const __m256i*)(l_pucSecret + 32)));
+
+        l_tAcc0 = _mm256_add_epi64(l_tAcc0, _mm256_shuffle_epi32(l_tData0, _MM_SHUFFLE(1, 0, 3, 2)));
+        l_tAcc1 = _mm256_add_epi64(l_tAcc1, _mm256_shuffle_epi32(l_tData1, _MM_SHUFFLE(1, 0, 3, 2)));
+        l_tAcc0 = _mm256_add_epi64(l_tAcc0, _mm256_mul_epu32(l_tKey0, _mm256_shuffle_epi32(l_tKey0, _MM_SHUFFLE(0, 3, 0, 1))));
+        l_tAcc1 = _mm256_add_epi64(l_tAcc1, _mm256_mul_epu32(l_tKey1, _mm256_shuffle_epi32(l_tKey1, _MM_SHUFFLE(0, 3, 0, 1))));
+    }
+
+    _mm256_storeu_si256((__m256i*)p_pulAcc, l_tAcc0);
+    _mm256_storeu_si256((__m256i*)(p_pulAcc + 4), l_tAcc1);
+}
+
+__attribute__((target("avx2")))
+static void hashXxh3ScrambleAvx2(uint64_t* p_pulAcc, const uint8_t* p_pucSecret)
+{
+    const __m256i l_tPrime = _mm256_set1_epi32((int)XXH_PRIME32_1);
+    for (int i = 0; i < 2; i++)
+    {
+        __m256i l_tAcc = _mm256_loadu_si256((const __m256i*)(p_pulAcc + 4 * i));
+        l_tAcc = _mm256_xor_si256(l_tAcc, _mm256_srli_epi64(l_tAcc, 47));
+        l_tAcc = _mm256_xor_si256(l_tAcc, _mm256_loadu_si256((const __m256i*)(p_pucSecret + 32 * i)));
+        __m256i l_tLow = _mm256_mul_epu32(l_tAcc, l_tPrime);
+        __m256i l_tHigh = _mm256_mul_epu32(_mm256_shuffle_epi32(l_tAcc, _MM_SHUFFLE(0, 3, 0, 1)), l_tPrime);
+        _mm256_storeu_si256((__m256i*)(p_pulAcc + 4 * i), _mm256_add_epi64(l_tLow, _mm256_slli_epi64(l_tHigh, 32)));
+    }
+}
+
+////////////////////////////////////////////////////////////
+/// hashCrc32cSse42
+////////////////////////////////////////////////////////////
+__attribute__((target("sse4.2")))
+static uint32_t hashCrc32cSse42(uint32_t p_ulCrc, const uint8_t* p_pucInput, size_t p_ulSize)
+{
+    uint64_t l_ulCrc = p_ulCrc;
+    while (p_ulSize >= 8)
+    {
+        uint64_t l_ulValue;
+        memcpy(&l_ulValue, p_pucInput, sizeof(l_ulValue));
+        l_ulCrc = _mm_crc32_u64(l_ulCrc, l_ulValue);
+        p_pucInput += 8;
+        p_ulSize -= 8;
+    }
+
+    uint32_t l_ulCrc32 = (uint32_t)l_ulCrc;
+    while (p_ulSize-- > 0)
+    {
+        l_ulCrc32 = _mm_crc32_u8(l_ulCrc32, *p_pucInput++);
+    }
+    return l_ulCrc32;
+}
+#endif // __x86_64__
+
+#if defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+////////////////////////////////////////////////////////////
+/// hashCrc32cArm
+////////////////////////////////////////////////////////////
+static uint32_t hashCrc32cArm(uint32_t p_ulCrc, const uint8_t* p_pucInput, size_t p_ulSize)
+{
+    while (p_ulSize >= 8)
+    {
+        uint64_t l_ulValue;
+        memcpy(&l_ulValue, p_pucInput, sizeof(l_ulValue));
+        p_ulCrc = __crc32cd(p_ulCrc, l_ulValue);
+        p_pucInput += 8;
+        p_ulSize -= 8;
+    }
+    while (p_ulSize-- > 0)
+    {
+        p_ulCrc = __crc32cb(p_ulCrc, *p_pucInput++);
+    }
+    return p_ulCrc;
+}
+#endif
+
+////////////////////////////////////////////////////////////
+/// hashCrc32cTable
+////////////////////////////////////////////////////////////
+static uint32_t hashCrc32cTable(uint32_t p_ulCrc, const uint8_t* p_pucInput, size_t p_ulSize)
+{
+    // Slicing-by-8, one table lookup per input byte without a carried dependency
+    while (p_ulSize >= 8)
+    {
+        uint32_t l_ulLow = hashRead32(p_pucInput) ^ p_ulCrc;
+        uint32_t l_ulHigh = hashRead32(p_pucInput + 4);
+        p_ulCrc = s_ulCrc32cTable[7][l_ulLow & 0xFF] ^ s_ulCrc32cTable[6][(l_ulLow >> 8) & 0xFF] ^
+                  s_ulCrc32cTable[5][(l_ulLow >> 16) & 0xFF] ^ s_ulCrc32cTable[4][l_ulLow >> 24] ^
+                  s_ulCrc32cTable[3][l_ulHigh & 0xFF] ^ s_ulCrc32cTable[2][(l_ulHigh >> 8) & 0xFF] ^
+                  s_ulCrc32cTable[1][(l_ulHigh >> 16) & 0xFF] ^ s_ulCrc32cTable[0][l_ulHigh >> 24];
+        p_pucInput += 8;
+        p_ulSize -= 8;
+    }
+    while (p_ulSize-- > 0)
+    {
+        p_ulCrc = s_ulCrc32cTable[0][(p_ulCrc ^ *p_pucInput++) & 0xFF] ^ (p_ulCrc >> 8);
+    }
+    return p_ulCrc;
+}
+
+////////////////////////////////////////////////////////////
+/// hashDispatchInit
+////////////////////////////////////////////////////////////
+static void hashDispatchInit(void)
+{
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        uint32_t l_ulCrc = i;
+        for (int j = 0; j < 8; j++)
+        {
+            l_ulCrc = (l_ulCrc >> 1) ^ ((l_ulCrc & 1U) ? CRC32C_POLYNOMIAL : 0U);
+        }
+        s_ulCrc32cTable[0][i] = l_ulCrc;
+    }
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        for (int t = 1; t < 8; t++)
+        {
+            uint32_t l_ulPrev = s_ulCrc32cTable[t - 1][i];
+            s_ulCrc32cTable[t][i] = s_ulCrc32cTable[0][l_ulPrev & 0xFF] ^ (l_ulPrev >> 8);
+        }
+    }
+
+    s_pfXxh3Accumulate = hashXxh3AccumulateScalar;
+    s_pfXxh3Scramble = hashXxh3ScrambleScalar;
+    s_pfCrc32c = hashCrc32cTable;
+
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    s_pfXxh3Accumulate = hashXxh3AccumulateSse2;
+    s_pfXxh3Scramble = hashXxh3ScrambleSse2;
+    if (__builtin_cpu_supports("avx2"))
+    {
+        s_pfXxh3Accumulate = hashXxh3AccumulateAvx2;
+        s_pfXxh3Scramble = hashXxh3ScrambleAvx2;
+    }
+    if (__builtin_cpu_supports("sse4.2"))
+    {
+        s_pfCrc32c = hashCrc32cSse42;
+    }
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+    s_pfCrc32c = hashCrc32cArm;
+#endif
+}
+
+////////////////////////////////////////////////////////////
+/// hashXxh3Long
+////////////////////////////////////////////////////////////
+static void hashXxh3Long(uint64_t* p_pulAcc, const uint8_t* p_pucInput, size_t p_ulSize, const uint8_t* p_pucSecret)
+{
+    memcpy(p_pulAcc, s_ulXxh3AccInit, sizeof(s_ulXxh3AccInit));
+
+    size_t l_ulBlocks = (p_ulSize - 1) / XXH_BLOCK_LEN;
+    for (size_t n = 0; n < l_ulBlocks; n++)
+    {
+        s_pfXxh3Accumulate(p_pulAcc, p_pucInput + n * XXH_BLOCK_LEN, p_pucSecret, XXH_STRIPES_PER_BLOCK);
+        s_pfXxh3Scramble(p_pulAcc, p_pucSecret + XOS_HASH_XXH3_SECRET_SIZE - XXH_STRIPE_LEN);
+    }
+
+    size_t l_ulStripes = ((p_ulSize - 1) - XXH_BLOCK_LEN * l_ulBlocks) / XXH_STRIPE_LEN;
+    s_pfXxh3Accumulate(p_pulAcc, p_pucInput + l_ulBlocks * XXH_BLOCK_LEN, p_pucSecret, l_ulStripes);
+
+    // The last stripe always ends the input, it may overlap the previous one
+    s_pfXxh3Accumulate(p_pulAcc, p_pucInput + p_ulSize - XXH_STRIPE_LEN,
+                       p_pucSecret + XOS_HASH_XXH3_SECRET_SIZE - XXH_STRIPE_LEN - XXH_SECRET_LASTACC_START, 1);
+}
+
+////////////////////////////////////////////////////////////
+/// hashXxh3Merge
+////////////////////////////////////////////////////////////
+static uint64_t hashXxh3Merge(const uint64_t* p_pulAcc, const uint8_t* p_pucSecret, uint64_t p_ulStart)
+{
+    uint64_t l_ulResult = p_ulStart;
+    for (int i = 0; i < 4; i++)
+    {
+        l_ulResult += hashMulFold64(p_pulAcc[2 * i] ^ hashRead64(p_pucSecret + 16 * i),
+                                    p_pulAcc[2 * i + 1] ^ hashRead64(p_pucSecret + 16 * i + 8));
+    }
+    return hashXxh3Avalanche(l_ulResult);
+}
+
+////////////////////////////////////////////////////////////
+/// hashXxh3DeriveSecret
+////////////////////////////////////////////////////////////
+static void hashXxh3DeriveSecret(uint8_t* p_pucSecret, uint64_t p_ulSeed)
+{
+    for (int i = 0; i < XOS_HASH_XXH3_SECRET_SIZE / 16; i++)
+    {
+        hashWrite64(p_pucSecret + 16 * i, hashRead64(s_ucXxh3Secret + 16 * i) + p_ulSeed);
+        hashWrite64(p_pucSecret + 16 * i + 8, hashRead64(s_ucXxh3Secret + 16 * i + 8) - p_ulSeed);
+    }
+}
+
+////////////////////////////////////////////////////////////
+/// hashXxh3_64Short
+////////////////////////////////////////////////////////////
+static uint64_t hashXxh3_64Short(const uint8_t* p_pucInput, size_t p_ulSize, uint64_t p_ulSeed)
+{
+    const uint8_t* l_pucSecret = s_ucXxh3Secret;
+
+    if (p_ulSize == 0)
+        return hashXxh64Avalanche(p_ulSeed ^ (hashRead64(l_pucSecret + 56) ^ hashRead64(l_pucSecret + 64)));
+
+    if (p_ulSize <= 3)
+    {
+        uint32_t l_ulCombined = ((uint32_t)p_pucInput[0] << 16) | ((uint32_t)p_pucInput[p_ulSize >> 1] << 24) |
+                                (uint32_t)p_pucInput[p_ulSize - 1] | ((uint32_t)p_ulSize << 8);
+        uint64_t l_ulFlip = (hashRead32(l_pucSecret) ^ hashRead32(l_pucSecret + 4)) + p_ulSeed;
+        return hashXxh64Avalanche((uint64_t)l_ulCombined ^ l_ulFlip);
+    }
+
+    if (p_ulSize <= 8)
+    {
+        uint64_t l_ulSeed = p_ulSeed ^ ((uint64_t)__builtin_bswap32((uint32_t)p_ulSeed) << 32);
+        uint64_t l_ulFlip = (hashRead64(l_pucSecret + 8) ^ hashRead64(l_pucSecret + 16)) - l_ulSeed;
+        uint64_t l_ulInput = hashRead32(p_pucInput + p_ulSize - 4) + ((uint64_t)hashRead32(p_pucInput) << 32);
+        return hashXxh3Rrmxmx(l_ulInput ^ l_ulFlip, p_ulSize);
+    }
+
+    if (p_ulSize <= 16)
+    {
+        uint64_t l_ulFlip1 = (hashRead64(l_pucSecret + 24) ^ hashRead64(l_pucSecret + 32)) + p_ulSeed;
+        uint64_t l_ulFlip2 = (hashRead64(l_pucSecret + 40) ^ hashRead64(l_pucSecret + 48)) - p_ulSeed;
+        uint64_t l_ulLow = hashRead64(p_pucInput) ^ l_ulFlip1;
+        uint64_t l_ulHigh = hashRead64(p_pucInput + p_ulSize - 8) ^ l_ulFlip2;
+        uint64_t l_ulAcc = p_ulSize + __builtin_bswap64(l_ulLow) + l_ulHigh + hashMulFold64(l_ulLow, l_ulHigh);
+        return hashXxh3Avalanche(l_ulAcc);
+    }
+
+    uint64_t l_ulAcc = p_ulSize * XXH_PRIME64_1;
+    if (p_ulSize <= 128)
+    {
+        if (p_ulSize > 32)
+        {
+            if (p_ulSize > 64)
+            {
+                if (p_ulSize > 96)
+                {
+                    l_ulAcc += hashXxh3Mix16(p_pucInput + 48, l_pucSecret + 96, p_ulSeed);
+                    l_ulAcc += hashXxh3Mix16(p_pucInput + p_ulSize - 64, l_pucSecret + 112, p_ulSeed);
+                }
+                l_ulAcc += hashXxh3Mix16(p_pucInput + 32, l_pucSecret + 64, p_ulSeed);
+                l_ulAcc += hashXxh3Mix16(p_pucInput + p_ulSize - 48, l_pucSecret + 80, p_ulSeed);
+            }
+            l_ulAcc += hashXxh3Mix16(p_pucInput + 16, l_pucSecret + 32, p_ulSeed);
+            l_ulAcc += hashXxh3Mix16(p_pucInput + p_ulSize - 32, l_pucSecret + 48, p_ulSeed);
+        }
+        l_ulAcc += hashXxh3Mix16(p_pucInput, l_pucSecret, p_ulSeed);
+        l_ulAcc += hashXxh3Mix16(p_pucInput + p_ulSize - 16, l_pucSecret + 16, p_ulSeed);
+        return hashXxh3Avalanche(l_ulAcc);
+    }
+
+    // 129 to 240 bytes
+    size_t l_ulRounds = p_ulSize / 16;
+    for (size_t i = 0; i < 8; i++)
+    {
+        l_ulAcc += hashXxh3Mix16(p_pucInput + 16 * i, l_pucSecret + 16 * i, p_ulSeed);
+    }
+    uint64_t l_ulAccEnd = hashXxh3Mix16(p_pucInput + p_ulSize - 16,
+                                        l_pucSecret + XXH_SECRET_SIZE_MIN - XXH_MIDSIZE_LASTOFFSET, p_ulSeed);
+    l_ulAcc = hashXxh3Avalanche(l_ulAcc);
+    for (size_t i = 8; i < l_ulRounds; i++)
+    {
+        l_ulAccEnd += hashXxh3Mix16(p_pucInput + 16 * i, l_pucSecret + 16 * (i - 8) + XXH_MIDSIZE_STARTOFFSET, p_ulSeed);
+    }
+    return hashXxh3Avalanche(l_ulAcc + l_ulAccEnd);
+}
+
+////////////////////////////////////////////////////////////
+/// hashXxh3_128Short
+////////////////////////////////////////////////////////////
+static uint64_t hashXxh3_128Short(const uint8_t* p_pucInput, size_t p_ulSize, uint64_t p_ulSeed, uint64_t* p_pulHigh)
+{
+    const uint8_t* l_pucSecret = s_ucXxh3Secret;
+
+    if (p_ulSize == 0)
+    {
+        *p_pulHigh = hashXxh64Avalanche(p_ulSeed ^ hashRead64(l_pucSecret + 80) ^ hashRead64(l_pucSecret + 88));
+        return hashXxh64Avalanche(p_ulSeed ^ hashRead64(l_pucSecret + 64) ^ hashRead64(l_pucSecret + 72));
+    }
+
+    if (p_ulSize <= 3)
+    {
+        uint32_t l_ulCombinedLow = ((uint32_t)p_pucInput[0] << 16) | ((uint32_t)p_pucInput[p_ulSize >> 1] << 24) |
+                                   (uint32_t)p_pucInput[p_ulSize - 1] | ((uint32_t)p_ulSize << 8);
+        uint32_t l_ulSwapped = __builtin_bswap32(l_ulCombinedLow);
+        uint32_t l_ulCombinedHigh = (l_ulSwapped << 13) | (l_ulSwapped >> 19);
+        uint64_t l_ulFlipLow = (hashRead32(l_pucSecret) ^ hashRead32(l_pucSecret + 4)) + p_ulSeed;
+        uint64_t l_ulFlipHigh = (hashRead32(l_pucSecret + 8) ^ hashRead32(l_pucSecret + 12)) - p_ulSeed;
+        *p_pulHigh = hashXxh64Avalanche((uint64_t)l_ulCombinedHigh ^ l_ulFlipHigh);
+        return hashXxh64Avalanche((uint64_t)l_ulCombinedLow ^ l_ulFlipLow);
+    }
+
+    if (p_ulSize <= 8)
+    {
+        uint64_t l_ulSeed = p_ulSeed ^ ((uint64_t)__builtin_bswap32((uint32_t)p_ulSeed) << 32);
+        uint64_t l_ulInput = hashRead32(p_pucInput) + ((uint64_t)hashRead32(p_pucInput + p_ulSize - 4) << 32);
+        uint64_t l_ulFlip = (hashRead64(l_pucSecret + 16) ^ hashRead64(l_pucSecret + 24)) + l_ulSeed;
+        uint64_t l_ulHigh;
+        uint64_t l_ulLow = hashMul128(l_ulInput ^ l_ulFlip, XXH_PRIME64_1 + (p_ulSize << 2), &l_ulHigh);
+        l_ulHigh += l_ulLow << 1;
+        l_ulLow ^= l_ulHigh >> 3;
+        l_ulLow ^= l_ulLow >> 35;
+        l_ulLow *= XXH_PRIME_MX2;
+        l_ulLow ^= l_ulLow >> 28;
+        *p_pulHigh = hashXxh3Avalanche(l_ulHigh);
+        return l_ulLow;
+    }
+
+    if (p_ulSize <= 16)
+    {
+        uint64_t l_ulFlipLow = (hashRead64(l_pucSecret + 32) ^ hashRead64(l_pucSecret + 40)) - p_ulSeed;
+        uint64_t l_ulFlipHigh = (hashRead64(l_pucSecret + 48) ^ hashRead64(l_pucSecret + 56)) + p_ulSeed;
+        uint64_t l_ulInputLow = hashRead64(p_pucInput);
+        uint64_t l_ulInputHigh = hashRead64(p_pucInput + p_ulSize - 8);
+        uint64_t l_ulHigh;
+        uint64_t l_ulLow = hashMul128(l_ulInputLow ^ l_ulInputHigh ^ l_ulFlipLow, XXH_PRIME64_1, &l_ulHigh);
+        l_ulLow += (uint64_t)(p_ulSize - 1) << 54;
+        l_ulInputHigh ^= l_ulFlipHigh;
+        l_ulHigh += l_ulInputHigh + (uint64_t)(uint32_t)l_ulInputHigh * (XXH_PRIME32_2 - 1);
+        l_ulLow ^= __builtin_bswap64(l_ulHigh);
+
+        uint64_t l_ulResultHigh;
+        uint64_t l_ulResultLow = hashMul128(l_ulLow, XXH_PRIME64_2, &l_ulResultHigh);
+        l_ulResultHigh += l_ulHigh * XXH_PRIME64_2;
+        *p_pulHigh = hashXxh3Avalanche(l_ulResultHigh);
+        return hashXxh3Avalanche(l_ulResultLow);
+    }
+
+    uint64_t l_ulLow = p_ulSize * XXH_PRIME64_1;
+    uint64_t l_ulHigh = 0;
+    if (p_ulSize <= 128)
+    {
+        if (p_ulSize > 32)
+        {
+            if (p_ulSize > 64)
+            {
+                if (p_ulSize > 96)
+                    hashXxh3Mix32(&l_ulLow, &l_ulHigh, p_pucInput + 48, p_pucInput + p_ulSize - 64, l_pucSecret + 96, p_ulSeed);
+                hashXxh3Mix32(&l_ulLow, &l_ulHigh, p_pucInput + 32, p_pucInput + p_ulSize - 48, l_pucSecret + 64, p_ulSeed);
+            }
+            hashXxh3Mix32(&l_ulLow, &l_ulHigh, p_pucInput + 16, p_pucInput + p_ulSize - 32, l_pucSecret + 32, p_ulSeed);
+        }
+        hashXxh3Mix32(&l_ulLow, &l_ulHigh, p_pucInput, p_pucInput + p_ulSize - 16, l_pucSecret, p_ulSeed);
+    }
+    else
+    {
+        // 129 to 240 bytes
+        size_t l_ulRounds = p_ulSize / 32;
+        for (size_t i = 0; i < 4; i++)
+        {
+            hashXxh3Mix32(&l_ulLow, &l_ulHigh, p_pucInput + 32 * i, p_pucInput + 32 * i + 16, l_pucSecret + 32 * i, p_ulSeed);
+        }
+        l_ulLow = hashXxh3Avalanche(l_ulLow);
+        l_ulHigh = hashXxh3Avalanche(l_ulHigh);
+        for (size_t i = 4; i < l_ulRounds; i++)
+        {
+            hashXxh3Mix32(&l_ulLow, &l_ulHigh, p_pucInput + 32 * i, p_pucInput + 32 * i + 16,
+                          l_pucSecret + XXH_MIDSIZE_STARTOFFSET + 32 * (i - 4), p_ulSeed);
+        }
+        hashXxh3Mix32(&l_ulLow, &l_ulHigh, p_pucInput + p_ulSize - 16, p_pucInput + p_ulSize - 32,
+                      l_pucSecret + XXH_SECRET_SIZE_MIN - XXH_MIDSIZE_LASTOFFSET - 16, 0ULL - p_ulSeed);
+    }
+
+    uint64_t l_ulResultLow = l_ulLow + l_ulHigh;
+    uint64_t l_ulResultHigh = l_ulLow * XXH_PRIME64_1 + l_ulHigh * XXH_PRIME64_4 + (p_ulSize - p_ulSeed) * XXH_PRIME64_2;
+    *p_pulHigh = 0ULL - hashXxh3Avalanche(l_ulResultHigh);
+    return hashXxh3Avalanche(l_ulResultLow);
+}
+
+////////////////////////////////////////////////////////////
+/// hashXxh3Finish
+////////////////////////////////////////////////////////////
+static uint64_t hashXxh3Finish(const uint64_t* p_pulAcc, const uint8_t* p_pucSecret, uint64_t p_ulSize,
+                               bool p_bWide, uint64_t* p_pulHigh)
+{
+    if (p_bWide)
+    {
+        *p_pulHigh = hashXxh3Merge(p_pulAcc, p_pucSecret + XOS_HASH_XXH3_SECRET_SIZE - XXH_STRIPE_LEN - XXH_SECRET_MERGEACCS_START,
+                                   ~(p_ulSize * XXH_PRIME64_2));
+    }
+    return hashXxh3Merge(p_pulAcc, p_pucSecret + XXH_SECRET_MERGEACCS_START, p_ulSize * XXH_PRIME64_1);
+}
+
+////////////////////////////////////////////////////////////
+/// hashXxh3
+////////////////////////////////////////////////////////////
+static uint64_t hashXxh3(const uint8_t* p_pucInput, size_t p_ulSize, uint64_t p_ulSeed, bool p_bWide, uint64_t* p_pulHigh)
+{
+    if (p_ulSize <= XXH_MIDSIZE_MAX)
+    {
+        return p_bWide ? hashXxh3_128Short(p_pucInput, p_ulSize, p_ulSeed, p_pulHigh)
+                       : hashXxh3_64Short(p_pucInput, p_ulSize, p_ulSeed);
+    }
+
+    pthread_once(&s_tDispatchOnce, hashDispatchInit);
+
+    uint8_t l_ucSecret[XOS_HASH_XXH3_SECRET_SIZE];
+    const uint8_t* l_pucSecret = s_ucXxh3Secret;
+    if (p_ulSeed != 0)
+    {
+        hashXxh3DeriveSecret(l_ucSecret, p_ulSeed);
+        l_pucSecret = l_ucSecret;
+    }
+
+    uint64_t l_ulAcc[8];
+    hashXxh3Long(l_ulAcc, p_pucInput, p_ulSize, l_pucSecret);
+    return hashXxh3Finish(l_ulAcc, l_pucSecret, p_ulSize, p_bWide, p_pulHigh);
+}
+
+////////////////////////////////////////////////////////////
+/// hashXxh3Consume
+////////////////////////////////////////////////////////////
+static void hashXxh3Consume(uint64_t* p_pulAcc, size_t* p_pulStripes, const uint8_t* p_pucInput,
+                            size_t p_ulStripes, const uint8_t* p_pucSecret)
+{
+    // Scramble at every block end, as the one-shot loop does
+    while (p_ulStripes > 0)
+    {
+        size_t l_ulCount = XXH_STRIPES_PER_BLOCK - *p_pulStripes;
+        if (l_ulCount > p_ulStripes)
+            l_ulCount = p_ulStripes;
+
+        s_pfXxh3Accumulate(p_pulAcc, p_pucInput, p_pucSecret + *p_pulStripes * XXH_SECRET_CONSUME_RATE, l_ulCount);
+        p_pucInput += l_ulCount * XXH_STRIPE_LEN;
+        p_ulStripes -= l_ulCount;
+        *p_pulStripes += l_ulCount;
+
+        if (*p_pulStripes == XXH_STRIPES_PER_BLOCK)
+        {
+            s_pfXxh3Scramble(p_pulAcc, p_pucSecret + XOS_HASH_XXH3_SECRET_SIZE - XXH_STRIPE_LEN);
+            *p_pulStripes = 0;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////
+/// SipHash
+////////////////////////////////////////////////////////////
+static inline void hashSipRound(uint64_t* p_pulV)
+{
+    p_pulV[0] += p_pulV[1];
+    p_pulV[1] = hashRotl64(p_pulV[1], 13);
+    p_pulV[1] ^= p_pulV[0];
+    p_pulV[0] = hashRotl64(p_pulV[0], 32);
+    p_pulV[2] += p_pulV[3];
+    p_pulV[3] = hashRotl64(p_pulV[3], 16);
+    p_pulV[3] ^= p_pulV[2];
+    p_pulV[0] += p_pulV[3];
+    p_pulV[3] = hashRotl64(p_pulV[3], 21);
+    p_pulV[3] ^= p_pulV[0];
+    p_pulV[2] += p_pulV[1];
+    p_pulV[1] = hashRotl64(p_pulV[1], 17);
+    p_pulV[1] ^= p_pulV[2];
+    p_pulV[2] = hashRotl64(p_pulV[2], 32);
+}
+
+static void hashSipInit(uint64_t* p_pulV, const uint8_t* p_pucKey)
+{
+    uint64_t l_ulK0 = hashRead64(p_pucKey);
+    uint64_t l_ulK1 = hashRead64(p_pucKey + 8);
+    p_pulV[0] = l_ulK0 ^ 0x736f6d6570736575ULL;
+    p_pulV[1] = l_ulK1 ^ 0x646f72616e646f6dULL;
+    p_pulV[2] = l_ulK0 ^ 0x6c7967656e657261ULL;
+    p_pulV[3] = l_ulK1 ^ 0x7465646279746573ULL;
+}
+
+static void hashSipBlocks(uint64_t* p_pulV, const uint8_t* p_pucInput, size_t p_ulBlocks)
+{
+    for (size_t i = 0; i < p_ulBlocks; i++)
+    {
+        uint64_t l_ulBlock = hashRead64(p_pucInput + 8 * i);
+        p_pulV[3] ^= l_ulBlock;
+        hashSipRound(p_pulV);
+        p_pulV[0] ^= l_ulBlock;
+    }
+}
+
+static uint64_t hashSipFinish(uint64_t* p_pulV, const uint8_t* p_pucTail, size_t p_ulTail, uint64_t p_ulTotal)
+{
+    uint64_t l_ulBlock = p_ulTotal << 56;
+    for (size_t i = 0; i < p_ulTail; i++)
+    {
+        l_ulBlock |= (uint64_t)p_pucTail[i] << (8 * i);
+    }
+
+    p_pulV[3] ^= l_ulBlock;
+    hashSipRound(p_pulV);
+    p_pulV[0] ^= l_ulBlock;
+    p_pulV[2] ^= 0xFF;
+    hashSipRound(p_pulV);
+    hashSipRound(p_pulV);
+    hashSipRound(p_pulV);
+    return p_pulV[0] ^ p_pulV[1] ^ p_pulV[2] ^ p_pulV[3];
+}
+
+////////////////////////////////////////////////////////////
+/// hashFastOutput
+////////////////////////////////////////////////////////////
+static int hashFastOutput(t_hashAlgorithm p_eType, uint64_t p_ulLow, uint64_t p_ulHigh,
+                          uint8_t* p_ptHash, size_t* p_pulHashSize)
+{
+    switch (p_eType)
+    {
+    case XOS_HASH_TYPE_XXH3_64:
+        hashWriteBig64(p_ptHash, p_ulLow);
+        *p_pulHashSize = XOS_HASH_XXH3_64_SIZE;
+        break;
+    case XOS_HASH_TYPE_XXH3_128:
+        hashWriteBig64(p_ptHash, p_ulHigh);
+        hashWriteBig64(p_ptHash + 8, p_ulLow);
+        *p_pulHashSize = XOS_HASH_XXH3_128_SIZE;
+        break;
+    case XOS_HASH_TYPE_CRC32C:
+        p_ptHash[0] = (uint8_t)(p_ulLow >> 24);
+        p_ptHash[1] = (uint8_t)(p_ulLow >> 16);
+        p_ptHash[2] = (uint8_t)(p_ulLow >> 8);
+        p_ptHash[3] = (uint8_t)p_ulLow;
+        *p_pulHashSize = XOS_HASH_CRC32C_SIZE;
+        break;
+    case XOS_HASH_TYPE_SIPHASH_1_3:
+        hashWrite64(p_ptHash, p_ulLow);
+        *p_pulHashSize = XOS_HASH_SIPHASH_SIZE;
+        break;
+    default:
+        return XOS_HASH_INVALID;
+    }
+    return XOS_HASH_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// hashFastSeed
+////////////////////////////////////////////////////////////
+static int hashFastSeed(t_hashAlgorithm p_eType, const void* p_ptKey, size_t p_ulKeySize, uint64_t* p_pulSeed)
+{
+    *p_pulSeed = 0;
+    switch (p_eType)
+    {
+    case XOS_HASH_TYPE_XXH3_64:
+    case XOS_HASH_TYPE_XXH3_128:
+        if (p_ptKey == NULL)
+            return XOS_HASH_OK;
+        if (p_ulKeySize != XOS_HASH_XXH3_SEED_SIZE)
+            return XOS_HASH_INVALID;
+        *p_pulSeed = hashRead64((const uint8_t*)p_ptKey);
+        return XOS_HASH_OK;
+    case XOS_HASH_TYPE_CRC32C:
+        return (p_ptKey == NULL) ? (int)XOS_HASH_OK : (int)XOS_HASH_INVALID;
+    case XOS_HASH_TYPE_SIPHASH_1_3:
+        return (p_ptKey != NULL && p_ulKeySize == XOS_HASH_SIPHASH_KEY_SIZE) ? (int)XOS_HASH_OK : (int)XOS_HASH_INVALID;
+    default:
+        return XOS_HASH_INVALID;
+    }
+}
+
+////////////////////////////////////////////////////////////
+/// xHashXxh3_64
+////////////////////////////////////////////////////////////
+uint64_t xHashXxh3_64(const void* p_ptData, size_t p_ulSize, uint64_t p_ulSeed)
+{
+    return hashXxh3((const uint8_t*)p_ptData, p_ulSize, p_ulSeed, false, NULL);
+}
+
+////////////////////////////////////////////////////////////
+/// xHashCrc32c
+////////////////////////////////////////////////////////////
+uint32_t xHashCrc32c(uint32_t p_ulCrc, const void* p_ptData, size_t p_ulSize)
+{
+    pthread_once(&s_tDispatchOnce, hashDispatchInit);
+    return ~s_pfCrc32c(~p_ulCrc, (const uint8_t*)p_ptData, p_ulSize);
+}
+
+////////////////////////////////////////////////////////////
+/// xHashSipHash13
+////////////////////////////////////////////////////////////
+uint64_t xHashSipHash13(const uint8_t* p_pucKey, const void* p_ptData, size_t p_ulSize)
+{
+    uint64_t l_ulV[4];
+    hashSipInit(l_ulV, p_pucKey);
+    hashSipBlocks(l_ulV, (const uint8_t*)p_ptData, p_ulSize / 8);
+    return hashSipFinish(l_ulV, (const uint8_t*)p_ptData + (p_ulSize & ~(size_t)7), p_ulSize & 7, p_ulSize);
+}
+
+////////////////////////////////////////////////////////////
+/// xHashFastCalculate
+////////////////////////////////////////////////////////////
+int xHashFastCalculate(t_hashAlgorithm p_eType, const void* p_ptKey, size_t p_ulKeySize,
+    const void* p_ptData, size_t p_ulSize, uint8_t* p_ptHash, size_t* p_pulHashSize)
+{
+    X_ASSERT_RETURN((p_ptData != NULL || p_ulSize == 0) && p_ptHash != NULL && p_pulHashSize != NULL, XOS_HASH_INVALID);
+
+    uint64_t l_ulSeed;
+    int l_iResult = hashFastSeed(p_eType, p_ptKey, p_ulKeySize, &l_ulSeed);
+    if (l_iResult != (int)XOS_HASH_OK)
+        return l_iResult;
+
+    uint64_t l_ulLow = 0;
+    uint64_t l_ulHigh = 0;
+    switch (p_eType)
+    {
+    case XOS_HASH_TYPE_XXH3_64:
+    case XOS_HASH_TYPE_XXH3_128:
+        l_ulLow = hashXxh3((const uint8_t*)p_ptData, p_ulSize, l_ulSeed, p_eType == XOS_HASH_TYPE_XXH3_128, &l_ulHigh);
+        break;
+    case XOS_HASH_TYPE_CRC32C:
+        l_ulLow = xHashCrc32c(0, p_ptData, p_ulSize);
+        break;
+    default:
+        l_ulLow = xHashSipHash13((const uint8_t*)p_ptKey, p_ptData, p_ulSize);
+        break;
+    }
+
+    return hashFastOutput(p_eType, l_ulLow, l_ulHigh, p_ptHash, p_pulHashSize);
+}
+
+////////////////////////////////////////////////////////////
+/// xHashFastInit
+////////////////////////////////////////////////////////////
+int xHashFastInit(xHashFastState_t* p_ptState, t_hashAlgorithm p_eType, const void* p_ptKey, size_t p_ulKeySize)
+{
+    X_ASSERT_RETURN(p_ptState != NULL, XOS_HASH_INVALID);
+
+    uint64_t l_ulSeed;
+    int l_iResult = hashFastSeed(p_eType, p_ptKey, p_ulKeySize, &l_ulSeed);
+    if (l_iResult != (int)XOS_HASH_OK)
+        return l_iResult;
+
+    pthread_once(&s_tDispatchOnce, hashDispatchInit);
+    p_ptState->t_eType = p_eType;
+    p_ptState->t_ulTotal = 0;
+    p_ptState->t_ulBuffered = 0;
+    p_ptState->t_ulStripes = 0;
+    p_ptState->t_ulSeed = l_ulSeed;
+
+    switch (p_eType)
+    {
+    case XOS_HASH_TYPE_XXH3_64:
+    case XOS_HASH_TYPE_XXH3_128:
+        memcpy(p_ptState->t_ulAcc, s_ulXxh3AccInit, sizeof(s_ulXxh3AccInit));
+        if (l_ulSeed != 0)
+            hashXxh3DeriveSecret(p_ptState->t_ucSecret, l_ulSeed);
+        else
+            memcpy(p_ptState->t_ucSecret, s_ucXxh3Secret, sizeof(s_ucXxh3Secret));
+        break;
+    case XOS_HASH_TYPE_CRC32C:
+        p_ptState->t_ulAcc[0] = 0;
+        break;
+    default:
+        hashSipInit(p_ptState->t_ulAcc, (const uint8_t*)p_ptKey);
+        break;
+    }
+
+    return XOS_HASH_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xHashFastUpdate
+////////////////////////////////////////////////////////////
+int xHashFastUpdate(xHashFastState_t* p_ptState, const void* p_ptData, size_t p_ulSize)
+{
+    X_ASSERT_RETURN(p_ptState != NULL && (p_ptData != NULL || p_ulSize == 0), XOS_HASH_INVALID);
+
+    const uint8_t* l_pucInput = (const uint8_t*)p_ptData;
+    p_ptState->t_ulTotal += p_ulSize;
+
+    if (p_ptState->t_eType == XOS_HASH_TYPE_CRC32C)
+    {
+        p_ptState->t_ulAcc[0] = xHashCrc32c((uint32_t)p_ptState->t_ulAcc[0], l_pucInput, p_ulSize);
+        return XOS_HASH_OK;
+    }
+
+    if (p_ptState->t_eType == XOS_HASH_TYPE_SIPHASH_1_3)
+    {
+        // Complete the pending block first
+        if (p_ptState->t_ulBuffered > 0)
+        {
+            size_t l_ulFill = 8 - p_ptState->t_ulBuffered;
+            if (l_ulFill > p_ulSize)
+                l_ulFill = p_ulSize;
+            memcpy(p_ptState->t_ucBuffer + p_ptState->t_ulBuffered, l_pucInput, l_ulFill);
+            p_ptState->t_ulBuffered += l_ulFill;
+            l_pucInput += l_ulFill;
+            p_ulSize -= l_ulFill;
+            if (p_ptState->t_ulBuffered < 8)
+                return XOS_HASH_OK;
+            hashSipBlocks(p_ptState->t_ulAcc, p_ptState->t_ucBuffer, 1);
+            p_ptState->t_ulBuffered = 0;
+        }
+
+        hashSipBlocks(p_ptState->t_ulAcc, l_pucInput, p_ulSize / 8);
+        memcpy(p_ptState->t_ucBuffer, l_pucInput + (p_ulSize & ~(size_t)7), p_ulSize & 7);
+        p_ptState->t_ulBuffered = p_ulSize & 7;
+        return XOS_HASH_OK;
+    }
+
+    // XXH3, at least one byte stays buffered so the digest always has the last stripe
+    if (p_ptState->t_ulBuffered + p_ulSize <= XOS_HASH_XXH3_BUFFER_SIZE)
+    {
+        memcpy(p_ptState->t_ucBuffer + p_ptState->t_ulBuffered, l_pucInput, p_ulSize);
+        p_ptState->t_ulBuffered += p_ulSize;
+        return XOS_HASH_OK;
+    }
+
+    const size_t l_ulBufferStripes = XOS_HASH_XXH3_BUFFER_SIZE / XXH_STRIPE_LEN;
+    if (p_ptState->t_ulBuffered > 0)
+    {
+        size_t l_ulFill = XOS_HASH_XXH3_BUFFER_SIZE - p_ptState->t_ulBuffered;
+        memcpy(p_ptState->t_ucBuffer + p_ptState->t_ulBuffered, l_pucInput, l_ulFill);
+        l_pucInput += l_ulFill;
+        p_ulSize -= l_ulFill;
+        hashXxh3Consume(p_ptState->t_ulAcc, &p_ptState->t_ulStripes, p_ptState->t_ucBuffer, l_ulBufferStripes,
+                        p_ptState->t_ucSecret);
+        p_ptState->t_ulBuffered = 0;
+    }
+
+    if (p_ulSize > XOS_HASH_XXH3_BUFFER_SIZE)
+    {
+        while (p_ulSize > XOS_HASH_XXH3_BUFFER_SIZE)
+        {
+            hashXxh3Consume(p_ptState->t_ulAcc, &p_ptState->t_ulStripes, l_pucInput, l_ulBufferStripes,
+                            p_ptState->t_ucSecret);
+            l_pucInput += XOS_HASH_XXH3_BUFFER_SIZE;
+            p_ulSize -= XOS_HASH_XXH3_BUFFER_SIZE;
+        }
+
+        // Keep the last stripe consumed, the digest may need its tail
+        memcpy(p_ptState->t_ucBuffer + XOS_HASH_XXH3_BUFFER_SIZE - XXH_STRIPE_LEN, l_pucInput - XXH_STRIPE_LEN, XXH_STRIPE_LEN);
+    }
+
+    memcpy(p_ptState->t_ucBuffer, l_pucInput, p_ulSize);
+    p_ptState->t_ulBuffered = p_ulSize;
+    return XOS_HASH_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xHashFastFinalize
+////////////////////////////////////////////////////////////
+int xHashFastFinalize(const xHashFastState_t* p_ptState, uint8_t* p_ptHash, size_t* p_pulHashSize)
+{
+    X_ASSERT_RETURN(p_ptState != NULL && p_ptHash != NULL && p_pulHashSize != NULL, XOS_HASH_INVALID);
+
+    uint64_t l_ulLow = 0;
+    uint64_t l_ulHigh = 0;
+    bool l_bWide = (p_ptState->t_eType == XOS_HASH_TYPE_XXH3_128);
+
+    switch (p_ptState->t_eType)
+    {
+    case XOS_HASH_TYPE_CRC32C:
+        l_ulLow = p_ptState->t_ulAcc[0];
+        break;
+    case XOS_HASH_TYPE_SIPHASH_1_3:
+    {
+        uint64_t l_ulV[4];
+        memcpy(l_ulV, p_ptState->t_ulAcc, sizeof(l_ulV));
+        l_ulLow = hashSipFinish(l_ulV, p_ptState->t_ucBuffer, p_ptState->t_ulBuffered, p_ptState->t_ulTotal);
+        break;
+    }
+    case XOS_HASH_TYPE_XXH3_64:
+    case XOS_HASH_TYPE_XXH3_128:
+        if (p_ptState->t_ulTotal <= XXH_MIDSIZE_MAX)
+        {
+            // Everything is still in the buffer
+            l_ulLow = hashXxh3(p_ptState->t_ucBuffer, (size_t)p_ptState->t_ulTotal, p_ptState->t_ulSeed, l_bWide, &l_ulHigh);
+        }
+        else
+        {
+            uint64_t l_ulAcc[8];
+            size_t l_ulStripes = p_ptState->t_ulStripes;
+            const uint8_t* l_pucSecret = p_ptState->t_ucSecret;
+            const uint8_t* l_pucLastSecret = l_pucSecret + XOS_HASH_XXH3_SECRET_SIZE - XXH_STRIPE_LEN - XXH_SECRET_LASTACC_START;
+            memcpy(l_ulAcc, p_ptState->t_ulAcc, sizeof(l_ulAcc));
+
+            if (p_ptState->t_ulBuffered >= XXH_STRIPE_LEN)
+            {
+                hashXxh3Consume(l_ulAcc, &l_ulStripes, p_ptState->t_ucBuffer, (p_ptState->t_ulBuffered - 1) / XXH_STRIPE_LEN,
+                                l_pucSecret);
+                s_pfXxh3Accumulate(l_ulAcc, p_ptState->t_ucBuffer + p_ptState->t_ulBuffered - XXH_STRIPE_LEN, l_pucLastSecret, 1);
+            }
+            else
+            {
+                // The last stripe starts in the bytes already consumed
+                uint8_t l_ucLast[XXH_STRIPE_LEN];
+                size_t l_ulCatchUp = XXH_STRIPE_LEN - p_ptState->t_ulBuffered;
+                memcpy(l_ucLast, p_ptState->t_ucBuffer + XOS_HASH_XXH3_BUFFER_SIZE - l_ulCatchUp, l_ulCatchUp);
+                memcpy(l_ucLast + l_ulCatchUp, p_ptState->t_ucBuffer, p_ptState->t_ulBuffered);
+                s_pfXxh3Accumulate(l_ulAcc, l_ucLast, l_pucLastSecret, 1);
+            }
+            l_ulLow = hashXxh3Finish(l_ulAcc, l_pucSecret, p_ptState->t_ulTotal, l_bWide, &l_ulHigh);
+        }
+        break;
+    default:
+        return XOS_HASH_INVALID;
+    }
+
+    return hashFastOutput(p_ptState->t_eType, l_ulLow, l_ulHigh, p_ptHash, p_pulHashSize);
+}
@@ -0,0 +1,335 @@
+////////////////////////////////////////////////////////////
+//  xArena.c
+//  Implements bump allocators with bulk reset
+//
+// Notes:
+// - Chunks come from xMemAlloc and are only released by xArenaDestroy()
+// - A reset rewinds to the first chunk; following chunks are rewound
+//   lazily when the allocation cursor reaches them again
+// - With XOS_ARENA_FLAG_CANARY each allocation is framed by a header and
+//   a suffix guard so the whole arena can be walked and checked
+//
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+
+#include "xArena.h"
+#include "xAssert.h"
+#include <pthread.h>
+#include <string.h>
+
+// Chunk header, allocations follow it
+typedef struct xArenaChunk
+{
+    struct xArenaChunk* t_ptNext;   // Next chunk of the arena
+    size_t t_ulCapacity;            // Usable bytes after the header
+    size_t t_ulOffset;              // Bytes already handed out
+} xArenaChunk_t;
+
+// Guard header placed before each allocation in canary mode
+typedef struct
+{
+    uint32_t t_ulCanary;            // XOS_MEM_CANARY_PREFIX
+    uint32_t t_ulReserved;
+    size_t t_ulSize;                // Requested size
+} xArenaGuard_t;
+
+#define XOS_ARENA_ALIGN(x) (((x) + XOS_ARENA_ALIGNMENT - 1) & ~(size_t)(XOS_ARENA_ALIGNMENT - 1))
+#define XOS_ARENA_CHUNK_HEADER XOS_ARENA_ALIGN(sizeof(xArenaChunk_t))
+#define XOS_ARENA_GUARD_HEADER XOS_ARENA_ALIGN(sizeof(xArenaGuard_t))
+
+// Thread default arena
+static __thread xArena_t s_tThreadArena;
+static __thread bool s_bThreadArenaReady = false;
+static pthread_key_t s_tThreadArenaKey;
+static pthread_once_t s_tThreadArenaOnce = PTHREAD_ONCE_INIT;
+
+//
+// Returns the bytes consumed in a chunk by an allocation
+//
+static size_t arenaFootprint(const xArena_t* p_ptArena, size_t p_ulSize)
+{
+    if (p_ptArena->t_ulFlags & XOS_ARENA_FLAG_CANARY)
+    {
+        return XOS_ARENA_GUARD_HEADER + XOS_ARENA_ALIGN(p_ulSize + sizeof(uint32_t));
+    }
+    return XOS_ARENA_ALIGN(p_ulSize);
+}
+
+//
+// Allocates a chunk able to hold at least p_ulNeeded bytes and links it after the current one
+//
+static xArenaChunk_t* arenaGrow(xArena_t* p_ptArena, size_t p_ulNeeded)
+{
+    size_t l_ulCapacity = (p_ulNeeded > p_ptArena->t_ulChunkSize) ? p_ulNeeded : p_ptArena->t_ulChunkSize;
+    xArenaChunk_t* l_ptChunk = X_MALLOC(XOS_ARENA_CHUNK_HEADER + l_ulCapacity);
+    if (l_ptChunk == NULL)
+    {
+        return NULL;
+    }
+
+    l_ptChunk->t_ulCapacity = l_ulCapacity;
+    l_ptChunk->t_ulOffset = 0;
+
+    xArenaChunk_t* l_ptCurrent = (xArenaChunk_t*)p_ptArena->t_ptCurrent;
+    if (l_ptCurrent == NULL)
+    {
+        l_ptChunk->t_ptNext = (xArenaChunk_t*)p_ptArena->t_ptChunks;
+        p_ptArena->t_ptChunks = l_ptChunk;
+    }
+    else
+    {
+        l_ptChunk->t_ptNext = l_ptCurrent->t_ptNext;
+        l_ptCurrent->t_ptNext = l_ptChunk;
+    }
+
+    p_ptArena->t_ulChunkCount++;
+    return l_ptChunk;
+}
+
+//
+// Destructor of the thread default arena
+//
+static void arenaThreadExit(void* p_ptArena)
+{
+    if (p_ptArena != NULL)
+    {
+        xArenaDestroy((xArena_t*)p_ptArena);
+    }
+}
+
+//
+// Creates the key used to release thread default arenas
+//
+static void arenaThreadKeyInit(void)
+{
+    pthread_key_create(&s_tThreadArenaKey, arenaThreadExit);
+}
+
+////////////////////////////////////////////////////////////
+/// xArenaCreate
+////////////////////////////////////////////////////////////
+int xArenaCreate(xArena_t* p_ptArena, size_t p_ulChunkSize, uint32_t p_ulFlags)
+{
+    X_ASSERT_RETURN(p_ptArena != NULL, XOS_MEM_INVALID);
+    X_ASSERT_RETURN(p_ulChunkSize <= XOS_MEM_MAX_ALLOCATION, XOS_MEM_INVALID);
+
+    memset(p_ptArena, 0, sizeof(xArena_t));
+    p_ptArena->t_ulChunkSize = (p_ulChunkSize > 0) ? XOS_ARENA_ALIGN(p_ulChunkSize) : XOS_ARENA_DEFAULT_CHUNK_SIZE;
+    p_ptArena->t_ulFlags = p_ulFlags;
+
+    return XOS_MEM_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xArenaAlloc
+////////////////////////////////////////////////////////////
+void* xArenaAlloc(xArena_t* p_ptArena, size_t p_ulSize)
+{
+    X_ASSERT(p_ptArena != NULL);
+    if (p_ulSize == 0 || p_ulSize > XOS_MEM_MAX_ALLOCATION)
+    {
+        return NULL;
+    }
+
+    size_t l_ulFootprint = arenaFootprint(p_ptArena, p_ulSize);
+    xArenaChunk_t* l_ptChunk = (xArenaChunk_t*)p_ptArena->t_ptCurrent;
+
+    if (l_ptChunk == NULL || l_ptChunk->t_ulCapacity - l_ptChunk->t_ulOffset < l_ulFootprint)
+    {
+        // Try the next chunk kept from a previous cycle before allocating a new one
+        xArenaChunk_t* l_ptNext = (l_ptChunk != NULL) ? l_ptChunk->t_ptNext : (xArenaChunk_t*)p_ptArena->t_ptChunks;
+        if (l_ptNext != NULL && l_ptNext->t_ulCapacity >= l_ulFootprint)
+        {
+            l_ptNext->t_ulOffset = 0;
+            l_ptChunk = l_ptNext;
+        }
+        else
+        {
+            l_ptChunk = arenaGrow(p_ptArena, l_ulFootprint);
+            if (l_ptChunk == NULL)
+            {
+                return NULL;
+            }
+        }
+        p_ptArena->t_ptCurrent = l_ptChunk;
+    }
+
+    uint8_t* l_ptData = (uint8_t*)l_ptChunk + XOS_ARENA_CHUNK_HEADER + l_ptChunk->t_ulOffset;
+    l_ptChunk->t_ulOffset += l_ulFootprint;
+
+    if (p_ptArena->t_ulFlags & XOS_ARENA_FLAG_CANARY)
+    {
+        xArenaGuard_t* l_ptGuard = (xArenaGuard_t*)l_ptData;
+        l_ptGuard->t_ulCanary = (uint32_t)XOS_MEM_CANARY_PREFIX;
+        l_ptGuard->t_ulReserved = 0;
+        l_ptGuard->t_ulSize = p_ulSize;
+        l_ptData += XOS_ARENA_GUARD_HEADER;
+
+        uint32_t l_ulSuffix = (uint32_t)XOS_MEM_CANARY_SUFFIX;
+        memcpy(l_ptData + p_ulSize, &l_ulSuffix, sizeof(uint32_t));
+    }
+
+    p_ptArena->t_ulUsed += l_ulFootprint;
+    p_ptArena->t_ulAllocCount++;
+    if (p_ptArena->t_ulUsed > p_ptArena->t_ulPeak)
+    {
+        p_ptArena->t_ulPeak = p_ptArena->t_ulUsed;
+    }
+
+    return l_ptData;
+}
+
+////////////////////////////////////////////////////////////
+/// xArenaCheck
+////////////////////////////////////////////////////////////
+int xArenaCheck(const xArena_t* p_ptArena)
+{
+    X_ASSERT_RETURN(p_ptArena != NULL, XOS_MEM_INVALID);
+
+    if (!(p_ptArena->t_ulFlags & XOS_ARENA_FLAG_CANARY) || p_ptArena->t_ptCurrent == NULL)
+    {
+        return XOS_MEM_OK;
+    }
+
+    // Only chunks up to the current one hold live allocations
+    const xArenaChunk_t* l_ptChunk = (const xArenaChunk_t*)p_ptArena->t_ptChunks;
+    for (;;)
+    {
+        const uint8_t* l_ptBase = (const uint8_t*)l_ptChunk + XOS_ARENA_CHUNK_HEADER;
+        size_t l_ulPos = 0;
+        while (l_ulPos < l_ptChunk->t_ulOffset)
+        {
+            const xArenaGuard_t* l_ptGuard = (const xArenaGuard_t*)(l_ptBase + l_ulPos);
+            if (l_ptGuard->t_ulCanary != (uint32_t)XOS_MEM_CANARY_PREFIX ||
+                l_ptGuard->t_ulSize > l_ptChunk->t_ulOffset - l_ulPos)
+            {
+                return XOS_MEM_CORRUPTION;
+            }
+
+            uint32_t l_ulSuffix;
+            memcpy(&l_ulSuffix, l_ptBase + l_ulPos + XOS_ARENA_GUARD_HEADER + l_ptGuard->t_ulSize, sizeof(uint32_t));
+            if (l_ulSuffix != (uint32_t)XOS_MEM_CANARY_SUFFIX)
+            {
+                return XOS_MEM_CORRUPTION;
+            }
+
+            l_ulPos += arenaFootprint(p_ptArena, l_ptGuard->t_ulSize);
+        }
+
+        if (l_ptChunk == p_ptArena->t_ptCurrent)
+        {
+            break;
+        }
+        l_ptChunk = l_ptChunk->t_ptNext;
+    }
+
+    return XOS_MEM_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xArenaReset
+////////////////////////////////////////////////////////////
+int xArenaReset(xArena_t* p_ptArena)
+{
+    X_ASSERT_RETURN(p_ptArena != NULL, XOS_MEM_INVALID);
+
+    int l_iRet = xArenaCheck(p_ptArena);
+
+    xArenaChunk_t* l_ptFirst = (xArenaChunk_t*)p_ptArena->t_ptChunks;
+    if (l_ptFirst != NULL)
+    {
+        l_ptFirst->t_ulOffset = 0;
+    }
+    p_ptArena->t_ptCurrent = l_ptFirst;
+    p_ptArena->t_ulUsed = 0;
+    p_ptArena->t_ulAllocCount = 0;
+
+    return l_iRet;
+}
+
+////////////////////////////////////////////////////////////
+/// xArenaDestroy
+////////////////////////////////////////////////////////////
+int xArenaDestroy(xArena_t* p_ptArena)
+{
+    X_ASSERT_RETURN(p_ptArena != NULL, XOS_MEM_INVALID);
+
+    xArenaChunk_t* l_ptChunk = (xArenaChunk_t*)p_ptArena->t_ptChunks;
+    while (l_ptChunk != NULL)
+    {
+        xArenaChunk_t* l_ptNext = l_ptChunk->t_ptNext;
+        X_FREE(l_ptChunk);
+        l_ptChunk = l_ptNext;
+    }
+
+    p_ptArena->t_ptChunks = NULL;
+    p_ptArena->t_ptCurrent = NULL;
+    p_ptArena->t_ulChunkCount = 0;
+    p_ptArena->t_ulUsed = 0;
+    p_ptArena->t_ulAllocCount = 0;
+
+    return XOS_MEM_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xArenaGetStats
+////////////////////////////////////////////////////////////
+int xArenaGetStats(const xArena_t* p_ptArena, size_t* p_pulUsed, size_t* p_pulPeak, size_t* p_pulCapacity)
+{
+    X_ASSERT_RETURN(p_ptArena != NULL, XOS_MEM_INVALID);
+    X_ASSERT_RETURN(p_pulUsed != NULL && p_pulPeak != NULL && p_pulCapacity != NULL, XOS_MEM_INVALID);
+
+    size_t l_ulCapacity = 0;
+    for (const xArenaChunk_t* l_ptChunk = (const xArenaChunk_t*)p_ptArena->t_ptChunks;
+         l_ptChunk != NULL; l_ptChunk = l_ptChunk->t_ptNext)
+    {
+        l_ulCapacity += l_ptChunk->t_ulCapacity;
+    }
+
+    *p_pulUsed = p_ptArena->t_ulUsed;
+    *p_pulPeak = p_ptArena->t_ulPeak;
+    *p_pulCapacity = l_ulCapacity;
+
+    return XOS_MEM_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xArenaGetThreadDefault
+////////////////////////////////////////////////////////////
+xArena_t* xArenaGetThreadDefault(void)
+{
+    if (!s_bThreadArenaReady)
+    {
+        pthread_once(&s_tThreadArenaOnce, arenaThreadKeyInit);
+
+        if (xArenaCreate(&s_tThreadArena, 0, XOS_ARENA_FLAG_NONE) != (int)XOS_MEM_OK)
+        {
+            return NULL;
+        }
+
+        // Registering the arena makes the thread release it on exit
+        if (pthread_setspecific(s_tThreadArenaKey, &s_tThreadArena) != 0)
+        {
+            return NULL;
+        }
+        s_bThreadArenaReady = true;
+    }
+
+    return &s_tThreadArena;
+}
+
+////////////////////////////////////////////////////////////
+/// xArenaReleaseThreadDefault
+////////////////////////////////////////////////////////////
+int xArenaReleaseThreadDefault(void)
+{
+    if (!s_bThreadArenaReady)
+    {
+        return XOS_MEM_OK;
+    }
+
+    pthread_setspecific(s_tThreadArenaKey, NULL);
+    s_bThreadArenaReady = false;
+
+    return xArenaDestroy(&s_tThreadArena);
+}
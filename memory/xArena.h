@@ -0,0 +1,110 @@
+////////////////////////////////////////////////////////////
+//  arena header file
+//  defines the bump allocator types and functions
+//
+// general discloser: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+#pragma once
+
+#ifndef XOS_ARENA_H_
+#define XOS_ARENA_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "xMemory.h"
+
+// Arena configuration
+#define XOS_ARENA_DEFAULT_CHUNK_SIZE (64 * 1024) // Chunk size when 0 is requested
+#define XOS_ARENA_ALIGNMENT          16          // Allocation alignment in bytes
+
+// Arena flags
+#define XOS_ARENA_FLAG_NONE   0x00000000
+#define XOS_ARENA_FLAG_CANARY 0x00000001 // Guard each allocation, checked by xArenaCheck/xArenaReset
+
+//////////////////////////////////
+/// @brief bump allocator for short-lived allocations
+/// @note chunks are allocated with X_MALLOC, allocations inside a chunk
+///       have no registry entry nor metadata hash
+/// @note an arena is not thread safe, use one arena per thread
+//////////////////////////////////
+typedef struct xos_arena_t
+{
+    void* t_ptChunks;               // First chunk (reused first after a reset)
+    void* t_ptCurrent;              // Chunk allocations are taken from
+    size_t t_ulChunkSize;           // Default chunk size
+    size_t t_ulChunkCount;          // Number of allocated chunks
+    size_t t_ulUsed;                // Bytes handed out since the last reset
+    size_t t_ulPeak;                // Highest t_ulUsed value
+    size_t t_ulAllocCount;          // Allocations since the last reset
+    uint32_t t_ulFlags;             // Arena flags
+} xArena_t;
+
+//////////////////////////////////
+/// @brief Create an arena
+/// @param p_ptArena : arena structure pointer
+/// @param p_ulChunkSize : chunk size in bytes (0 for default)
+/// @param p_ulFlags : XOS_ARENA_FLAG_* combination
+/// @return success or error code
+/// @note no memory is allocated before the first xArenaAlloc
+//////////////////////////////////
+int xArenaCreate(xArena_t* p_ptArena, size_t p_ulChunkSize, uint32_t p_ulFlags);
+
+//////////////////////////////////
+/// @brief Allocate memory from the arena
+/// @param p_ptArena : arena structure pointer
+/// @param p_ulSize : size to allocate
+/// @return pointer aligned on XOS_ARENA_ALIGNMENT or NULL
+//////////////////////////////////
+void* xArenaAlloc(xArena_t* p_ptArena, size_t p_ulSize);
+
+//////////////////////////////////
+/// @brief Release every allocation of the arena at once
+/// @param p_ptArena : arena structure pointer
+/// @return success, or XOS_MEM_CORRUPTION if a guard was overwritten
+/// @note chunks are kept for the next cycle, the cost does not depend
+///       on the number of allocations unless XOS_ARENA_FLAG_CANARY is set
+//////////////////////////////////
+int xArenaReset(xArena_t* p_ptArena);
+
+//////////////////////////////////
+/// @brief Check the guards of every live allocation
+/// @param p_ptArena : arena structure pointer
+/// @return success or XOS_MEM_CORRUPTION
+/// @note always succeeds when XOS_ARENA_FLAG_CANARY is not set
+//////////////////////////////////
+int xArenaCheck(const xArena_t* p_ptArena);
+
+//////////////////////////////////
+/// @brief Destroy the arena and release its chunks
+/// @param p_ptArena : arena structure pointer
+/// @return success or error code
+//////////////////////////////////
+int xArenaDestroy(xArena_t* p_ptArena);
+
+//////////////////////////////////
+/// @brief Get arena statistics
+/// @param p_ptArena : arena structure pointer
+/// @param p_pulUsed : bytes handed out since the last reset
+/// @param p_pulPeak : highest used value
+/// @param p_pulCapacity : bytes held by the chunks
+/// @return success or error code
+//////////////////////////////////
+int xArenaGetStats(const xArena_t* p_ptArena, size_t* p_pulUsed, size_t* p_pulPeak, size_t* p_pulCapacity);
+
+//////////////////////////////////
+/// @brief Get the calling thread's default arena
+/// @return arena pointer or NULL
+/// @note created on first use with the default chunk size, destroyed
+///       when the thread exits or by xArenaReleaseThreadDefault
+//////////////////////////////////
+xArena_t* xArenaGetThreadDefault(void);
+
+//////////////////////////////////
+/// @brief Destroy the calling thread's default arena
+/// @return success or error code
+//////////////////////////////////
+int xArenaReleaseThreadDefault(void);
+
+#endif // XOS_ARENA_H_
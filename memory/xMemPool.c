@@ -0,0 +1,475 @@
+////////////////////////////////////////////////////////////
+//  xMemPool.c
+//  Implements fixed-size object pools
+//
+// Notes:
+// - Slabs come from xMemAlloc, objects are carved out of them and never
+//   given back to the system before xMemPoolDestroy()
+// - Free objects store the next free pointer in their first bytes
+// - Optional thread caches keep a short free list per thread so the
+//   pool mutex is only taken once per XOS_MEMPOOL_CACHE_BATCH objects,
+//   a thread-exit destructor hands them back to the pools still alive
+//   and entries of destroyed pools are swept before a new one is claimed
+//
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+
+#include "xMemPool.h"
+#include "xAssert.h"
+#include <string.h>
+
+// Slab header, objects follow it
+typedef struct xMemPoolSlab
+{
+    struct xMemPoolSlab* t_ptNext;  // Next slab of the pool
+} xMemPoolSlab_t;
+
+// Per-thread cache entry for one pool
+typedef struct
+{
+    xMemPool_t* t_ptPool;           // Cached pool (NULL = free entry)
+    uint32_t t_ulPoolId;            // Pool id when the entry was claimed
+    uint32_t t_ulCount;             // Number of cached objects
+    void* t_ptHead;                 // Cached free objects
+} xMemPoolCache_t;
+
+// Slab header size keeping objects aligned
+#define XOS_MEMPOOL_SLAB_HEADER \
+    ((sizeof(xMemPoolSlab_t) + XOS_MEMPOOL_ALIGNMENT - 1) & ~(size_t)(XOS_MEMPOOL_ALIGNMENT - 1))
+
+// Pool id generator, never returns 0
+static atomic_uint s_ulPoolIdCounter = ATOMIC_VAR_INIT(0);
+
+// Thread-local caches: each thread has its own entries
+static __thread xMemPoolCache_t s_tPoolCache[XOS_MEMPOOL_CACHE_SLOTS];
+
+// Pools with thread caches, a cache is only flushed into a pool found here
+static pthread_mutex_t s_tLiveMutex = PTHREAD_MUTEX_INITIALIZER;
+static xMemPool_t* s_ptLivePools = NULL;
+
+// Bumped by every xMemPoolDestroy, a thread sweeps its stale entries when it changes
+static atomic_uint s_ulPoolDestroyCount = ATOMIC_VAR_INIT(0);
+static __thread unsigned int s_ulCacheSweepCount = 0;
+
+// Runs the flush when a thread that used a cache exits
+static pthread_key_t s_tCacheKey;
+static pthread_once_t s_tCacheOnce = PTHREAD_ONCE_INIT;
+
+//
+// Hands the objects of an exiting thread back to their pools
+//
+static void poolCacheThreadExit(void* p_ptCaches)
+{
+    xMemPoolCache_t* l_ptCaches = (xMemPoolCache_t*)p_ptCaches;
+
+    // The live list lock keeps xMemPoolDestroy out while a pool is flushed
+    pthread_mutex_lock(&s_tLiveMutex);
+    for (int i = 0; i < XOS_MEMPOOL_CACHE_SLOTS; i++)
+    {
+        xMemPoolCache_t* l_ptCache = &l_ptCaches[i];
+        xMemPool_t* l_ptPool = s_ptLivePools;
+        while (l_ptPool != NULL && !(l_ptPool == l_ptCache->t_ptPool && l_ptPool->t_ulId == l_ptCache->t_ulPoolId))
+        {
+            l_ptPool = l_ptPool->t_ptNextLive;
+        }
+
+        if (l_ptPool != NULL && l_ptCache->t_ulCount > 0)
+        {
+            pthread_mutex_lock(&l_ptPool->t_tMutex);
+            while (l_ptCache->t_ptHead != NULL)
+            {
+                void** l_ptFlush = (void**)l_ptCache->t_ptHead;
+                l_ptCache->t_ptHead = *l_ptFlush;
+                *l_ptFlush = l_ptPool->t_ptFreeList;
+                l_ptPool->t_ptFreeList = l_ptFlush;
+            }
+            pthread_mutex_unlock(&l_ptPool->t_tMutex);
+        }
+        memset(l_ptCache, 0, sizeof(xMemPoolCache_t));
+    }
+    pthread_mutex_unlock(&s_tLiveMutex);
+}
+
+//
+// Creates the thread-exit key once
+//
+static void poolCacheKeyInit(void)
+{
+    pthread_key_create(&s_tCacheKey, poolCacheThreadExit);
+}
+
+//
+// Allocates a new slab and pushes its objects on the free list
+// Caller must hold the pool mutex
+//
+static int poolGrow(xMemPool_t* p_ptPool)
+{
+    size_t l_ulSlabSize = XOS_MEMPOOL_SLAB_HEADER + p_ptPool->t_ulObjectSize * p_ptPool->t_ulObjectsPerSlab;
+    xMemPoolSlab_t* l_ptSlab = X_MALLOC(l_ulSlabSize);
+    if (l_ptSlab == NULL)
+    {
+        return XOS_MEM_ERROR;
+    }
+
+    l_ptSlab->t_ptNext = p_ptPool->t_ptSlabs;
+    p_ptPool->t_ptSlabs = l_ptSlab;
+    p_ptPool->t_ulSlabCount++;
+
+    // Link objects backwards so the first object is handed out first
+    uint8_t* l_ptBase = (uint8_t*)l_ptSlab + XOS_MEMPOOL_SLAB_HEADER;
+    for (size_t i = p_ptPool->t_ulObjectsPerSlab; i > 0; i--)
+    {
+        void** l_ptObject = (void**)(l_ptBase + (i - 1) * p_ptPool->t_ulObjectSize);
+        *l_ptObject = p_ptPool->t_ptFreeList;
+        p_ptPool->t_ptFreeList = l_ptObject;
+    }
+
+    return XOS_MEM_OK;
+}
+
+//
+// Pops one object from the central free list
+// Caller must hold the pool mutex
+//
+static void* poolPop(xMemPool_t* p_ptPool)
+{
+    if (p_ptPool->t_ptFreeList == NULL && poolGrow(p_ptPool) != (int)XOS_MEM_OK)
+    {
+        return NULL;
+    }
+
+    void** l_ptObject = (void**)p_ptPool->t_ptFreeList;
+    p_ptPool->t_ptFreeList = *l_ptObject;
+    return l_ptObject;
+}
+
+//
+// Releases the calling thread's entries whose pool is no longer live
+// Their objects died with the slabs, the pools themselves may be freed
+// so the (pool, id) pair is only compared against the live list
+//
+static void poolCacheSweep(void)
+{
+    pthread_mutex_lock(&s_tLiveMutex);
+    for (int i = 0; i < XOS_MEMPOOL_CACHE_SLOTS; i++)
+    {
+        xMemPoolCache_t* l_ptCache = &s_tPoolCache[i];
+        if (l_ptCache->t_ptPool == NULL)
+        {
+            continue;
+        }
+
+        xMemPool_t* l_ptPool = s_ptLivePools;
+        while (l_ptPool != NULL && !(l_ptPool == l_ptCache->t_ptPool && l_ptPool->t_ulId == l_ptCache->t_ulPoolId))
+        {
+            l_ptPool = l_ptPool->t_ptNextLive;
+        }
+        if (l_ptPool == NULL)
+        {
+            memset(l_ptCache, 0, sizeof(xMemPoolCache_t));
+        }
+    }
+    pthread_mutex_unlock(&s_tLiveMutex);
+}
+
+//
+// Returns the calling thread's cache entry for a pool, NULL if none is available
+//
+static xMemPoolCache_t* poolGetCache(xMemPool_t* p_ptPool)
+{
+    xMemPoolCache_t* l_ptFree = NULL;
+
+    for (int i = 0; i < XOS_MEMPOOL_CACHE_SLOTS; i++)
+    {
+        xMemPoolCache_t* l_ptCache = &s_tPoolCache[i];
+        if (l_ptCache->t_ptPool == p_ptPool && l_ptCache->t_ulPoolId == p_ptPool->t_ulId)
+        {
+            return l_ptCache;
+        }
+    }
+
+    // Before claiming an entry, reclaim those of any pool destroyed since the last sweep
+    unsigned int l_ulDestroyCount = atomic_load(&s_ulPoolDestroyCount);
+    if (l_ulDestroyCount != s_ulCacheSweepCount)
+    {
+        s_ulCacheSweepCount = l_ulDestroyCount;
+        poolCacheSweep();
+    }
+
+    for (int i = 0; i < XOS_MEMPOOL_CACHE_SLOTS && l_ptFree == NULL; i++)
+    {
+        if (s_tPoolCache[i].t_ptPool == NULL)
+        {
+            l_ptFree = &s_tPoolCache[i];
+        }
+    }
+
+    if (l_ptFree != NULL)
+    {
+        // First entry of the thread, arm the flush at thread exit
+        if (pthread_getspecific(s_tCacheKey) == NULL)
+        {
+            pthread_setspecific(s_tCacheKey, s_tPoolCache);
+        }
+        l_ptFree->t_ptPool = p_ptPool;
+        l_ptFree->t_ulPoolId = p_ptPool->t_ulId;
+        l_ptFree->t_ulCount = 0;
+        l_ptFree->t_ptHead = NULL;
+    }
+
+    return l_ptFree;
+}
+
+#ifdef DEBUG
+//
+// Checks that an object belongs to one of the pool slabs
+// Caller must hold the pool mutex
+//
+static bool poolOwns(const xMemPool_t* p_ptPool, const void* p_ptObject)
+{
+    size_t l_ulSpan = p_ptPool->t_ulObjectSize * p_ptPool->t_ulObjectsPerSlab;
+    for (const xMemPoolSlab_t* l_ptSlab = p_ptPool->t_ptSlabs; l_ptSlab != NULL; l_ptSlab = l_ptSlab->t_ptNext)
+    {
+        const uint8_t* l_ptBase = (const uint8_t*)l_ptSlab + XOS_MEMPOOL_SLAB_HEADER;
+        if ((const uint8_t*)p_ptObject >= l_ptBase && (const uint8_t*)p_ptObject < l_ptBase + l_ulSpan)
+        {
+            return (((const uint8_t*)p_ptObject - l_ptBase) % p_ptPool->t_ulObjectSize) == 0;
+        }
+    }
+    return false;
+}
+#endif
+
+////////////////////////////////////////////////////////////
+/// xMemPoolCreate
+////////////////////////////////////////////////////////////
+int xMemPoolCreate(xMemPool_t* p_ptPool, size_t p_ulObjectSize, size_t p_ulObjectsPerSlab, uint32_t p_ulFlags)
+{
+    X_ASSERT_RETURN(p_ptPool != NULL, XOS_MEM_INVALID);
+    X_ASSERT_RETURN(p_ulObjectSize > 0 && p_ulObjectSize <= XOS_MEM_MAX_ALLOCATION, XOS_MEM_INVALID);
+
+    memset(p_ptPool, 0, sizeof(xMemPool_t));
+
+    // Objects must be able to hold the free list link
+    size_t l_ulSize = (p_ulObjectSize < sizeof(void*)) ? sizeof(void*) : p_ulObjectSize;
+    p_ptPool->t_ulObjectSize = (l_ulSize + XOS_MEMPOOL_ALIGNMENT - 1) & ~(size_t)(XOS_MEMPOOL_ALIGNMENT - 1);
+    p_ptPool->t_ulObjectsPerSlab = (p_ulObjectsPerSlab > 0) ? p_ulObjectsPerSlab : XOS_MEMPOOL_DEFAULT_OBJECTS;
+    p_ptPool->t_ulFlags = p_ulFlags;
+
+    if (p_ptPool->t_ulObjectsPerSlab > (XOS_MEM_MAX_ALLOCATION - XOS_MEMPOOL_SLAB_HEADER) / p_ptPool->t_ulObjectSize)
+    {
+        return XOS_MEM_OVERFLOW;
+    }
+
+    uint32_t l_ulId;
+    do
+    {
+        l_ulId = atomic_fetch_add(&s_ulPoolIdCounter, 1) + 1;
+    } while (l_ulId == 0);
+    p_ptPool->t_ulId = l_ulId;
+
+    atomic_init(&p_ptPool->a_ulAllocCount, 0);
+    atomic_init(&p_ptPool->a_ulFreeCount, 0);
+
+    if (pthread_mutex_init(&p_ptPool->t_tMutex, NULL) != 0)
+    {
+        return XOS_MEM_ERROR;
+    }
+
+    if (p_ulFlags & XOS_MEMPOOL_FLAG_THREAD_CACHE)
+    {
+        pthread_once(&s_tCacheOnce, poolCacheKeyInit);
+        pthread_mutex_lock(&s_tLiveMutex);
+        p_ptPool->t_ptNextLive = s_ptLivePools;
+        s_ptLivePools = p_ptPool;
+        pthread_mutex_unlock(&s_tLiveMutex);
+    }
+
+    return XOS_MEM_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xMemPoolAlloc
+////////////////////////////////////////////////////////////
+void* xMemPoolAlloc(xMemPool_t* p_ptPool)
+{
+    X_ASSERT(p_ptPool != NULL);
+
+    void** l_ptObject = NULL;
+    xMemPoolCache_t* l_ptCache = NULL;
+
+    if (p_ptPool->t_ulFlags & XOS_MEMPOOL_FLAG_THREAD_CACHE)
+    {
+        l_ptCache = poolGetCache(p_ptPool);
+    }
+
+    if (l_ptCache != NULL)
+    {
+        if (l_ptCache->t_ulCount == 0)
+        {
+            // Refill the cache with a batch from the pool
+            pthread_mutex_lock(&p_ptPool->t_tMutex);
+            for (int i = 0; i < XOS_MEMPOOL_CACHE_BATCH; i++)
+            {
+                void** l_ptRefill = poolPop(p_ptPool);
+                if (l_ptRefill == NULL)
+                {
+                    break;
+                }
+                *l_ptRefill = l_ptCache->t_ptHead;
+                l_ptCache->t_ptHead = l_ptRefill;
+                l_ptCache->t_ulCount++;
+            }
+            pthread_mutex_unlock(&p_ptPool->t_tMutex);
+        }
+
+        if (l_ptCache->t_ulCount > 0)
+        {
+            l_ptObject = (void**)l_ptCache->t_ptHead;
+            l_ptCache->t_ptHead = *l_ptObject;
+            l_ptCache->t_ulCount--;
+        }
+    }
+    else
+    {
+        pthread_mutex_lock(&p_ptPool->t_tMutex);
+        l_ptObject = poolPop(p_ptPool);
+        pthread_mutex_unlock(&p_ptPool->t_tMutex);
+    }
+
+    if (l_ptObject != NULL)
+    {
+        atomic_fetch_add_explicit(&p_ptPool->a_ulAllocCount, 1, memory_order_relaxed);
+    }
+
+    return l_ptObject;
+}
+
+////////////////////////////////////////////////////////////
+/// xMemPoolFree
+////////////////////////////////////////////////////////////
+int xMemPoolFree(xMemPool_t* p_ptPool, void* p_ptObject)
+{
+    X_ASSERT_RETURN(p_ptPool != NULL && p_ptObject != NULL, XOS_MEM_INVALID);
+
+#ifdef DEBUG
+    pthread_mutex_lock(&p_ptPool->t_tMutex);
+    bool l_bOwned = poolOwns(p_ptPool, p_ptObject);
+    pthread_mutex_unlock(&p_ptPool->t_tMutex);
+    X_ASSERT_RETURN(l_bOwned, XOS_MEM_INVALID);
+#endif
+
+    void** l_ptObject = (void**)p_ptObject;
+    xMemPoolCache_t* l_ptCache = NULL;
+
+    if (p_ptPool->t_ulFlags & XOS_MEMPOOL_FLAG_THREAD_CACHE)
+    {
+        l_ptCache = poolGetCache(p_ptPool);
+    }
+
+    if (l_ptCache != NULL)
+    {
+        *l_ptObject = l_ptCache->t_ptHead;
+        l_ptCache->t_ptHead = l_ptObject;
+        l_ptCache->t_ulCount++;
+
+        // Give a batch back once the cache holds two of them
+        if (l_ptCache->t_ulCount >= 2 * XOS_MEMPOOL_CACHE_BATCH)
+        {
+            pthread_mutex_lock(&p_ptPool->t_tMutex);
+            for (int i = 0; i < XOS_MEMPOOL_CACHE_BATCH; i++)
+            {
+                void** l_ptFlush = (void**)l_ptCache->t_ptHead;
+                l_ptCache->t_ptHead = *l_ptFlush;
+                *l_ptFlush = p_ptPool->t_ptFreeList;
+                p_ptPool->t_ptFreeList = l_ptFlush;
+            }
+            l_ptCache->t_ulCount -= XOS_MEMPOOL_CACHE_BATCH;
+            pthread_mutex_unlock(&p_ptPool->t_tMutex);
+        }
+    }
+    else
+    {
+        pthread_mutex_lock(&p_ptPool->t_tMutex);
+        *l_ptObject = p_ptPool->t_ptFreeList;
+        p_ptPool->t_ptFreeList = l_ptObject;
+        pthread_mutex_unlock(&p_ptPool->t_tMutex);
+    }
+
+    atomic_fetch_add_explicit(&p_ptPool->a_ulFreeCount, 1, memory_order_relaxed);
+    return XOS_MEM_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xMemPoolDestroy
+////////////////////////////////////////////////////////////
+int xMemPoolDestroy(xMemPool_t* p_ptPool)
+{
+    X_ASSERT_RETURN(p_ptPool != NULL, XOS_MEM_INVALID);
+
+    // Exiting threads no longer flush into the pool once it is unlinked
+    if (p_ptPool->t_ulFlags & XOS_MEMPOOL_FLAG_THREAD_CACHE)
+    {
+        pthread_mutex_lock(&s_tLiveMutex);
+        xMemPool_t** l_pptLink = &s_ptLivePools;
+        while (*l_pptLink != NULL && *l_pptLink != p_ptPool)
+        {
+            l_pptLink = &(*l_pptLink)->t_ptNextLive;
+        }
+        if (*l_pptLink != NULL)
+        {
+            *l_pptLink = p_ptPool->t_ptNextLive;
+        }
+        pthread_mutex_unlock(&s_tLiveMutex);
+    }
+
+    pthread_mutex_lock(&p_ptPool->t_tMutex);
+    xMemPoolSlab_t* l_ptSlab = p_ptPool->t_ptSlabs;
+    while (l_ptSlab != NULL)
+    {
+        xMemPoolSlab_t* l_ptNext = l_ptSlab->t_ptNext;
+        X_FREE(l_ptSlab);
+        l_ptSlab = l_ptNext;
+    }
+    p_ptPool->t_ptSlabs = NULL;
+    p_ptPool->t_ptFreeList = NULL;
+    p_ptPool->t_ulSlabCount = 0;
+
+    // Invalidate thread cache entries still pointing to this pool
+    p_ptPool->t_ulId = 0;
+    pthread_mutex_unlock(&p_ptPool->t_tMutex);
+    atomic_fetch_add(&s_ulPoolDestroyCount, 1);
+
+    // Entries of the calling thread can be released right away
+    for (int i = 0; i < XOS_MEMPOOL_CACHE_SLOTS; i++)
+    {
+        if (s_tPoolCache[i].t_ptPool == p_ptPool)
+        {
+            memset(&s_tPoolCache[i], 0, sizeof(xMemPoolCache_t));
+        }
+    }
+
+    pthread_mutex_destroy(&p_ptPool->t_tMutex);
+    return XOS_MEM_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xMemPoolGetStats
+////////////////////////////////////////////////////////////
+int xMemPoolGetStats(xMemPool_t* p_ptPool, size_t* p_pulInUse, size_t* p_pulCapacity, size_t* p_pulCount)
+{
+    X_ASSERT_RETURN(p_ptPool != NULL, XOS_MEM_INVALID);
+    X_ASSERT_RETURN(p_pulInUse != NULL && p_pulCapacity != NULL && p_pulCount != NULL, XOS_MEM_INVALID);
+
+    size_t l_ulAlloc = atomic_load_explicit(&p_ptPool->a_ulAllocCount, memory_order_relaxed);
+    size_t l_ulFree = atomic_load_explicit(&p_ptPool->a_ulFreeCount, memory_order_relaxed);
+
+    pthread_mutex_lock(&p_ptPool->t_tMutex);
+    *p_pulCapacity = p_ptPool->t_ulSlabCount * p_ptPool->t_ulObjectsPerSlab;
+    pthread_mutex_unlock(&p_ptPool->t_tMutex);
+
+    *p_pulInUse = (l_ulAlloc > l_ulFree) ? l_ulAlloc - l_ulFree : 0;
+    *p_pulCount = l_ulAlloc;
+
+    return XOS_MEM_OK;
+}
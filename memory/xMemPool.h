@@ -0,0 +1,95 @@
+////////////////////////////////////////////////////////////
+//  memory pool header file
+//  defines the fixed-size object pool types and functions
+//
+// general discloser: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+#pragma once
+
+#ifndef XOS_MEMPOOL_H_
+#define XOS_MEMPOOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "xMemory.h"
+
+// Pool configuration
+#define XOS_MEMPOOL_DEFAULT_OBJECTS 64  // Objects per slab when 0 is requested
+#define XOS_MEMPOOL_ALIGNMENT       16  // Object alignment in bytes
+#define XOS_MEMPOOL_CACHE_SLOTS     4   // Pools cached per thread
+#define XOS_MEMPOOL_CACHE_BATCH     16  // Objects moved between a thread cache and the pool
+
+// Pool flags
+#define XOS_MEMPOOL_FLAG_NONE         0x00000000
+#define XOS_MEMPOOL_FLAG_THREAD_CACHE 0x00000001 // Enable per-thread object caches
+
+//////////////////////////////////
+/// @brief fixed-size object pool
+/// @note objects are carved from slabs allocated with X_MALLOC, so slab
+///       memory is accounted in xMemGetStats
+/// @note free objects are linked through their own storage
+/// @note objects cached by a thread go back to the free list when the thread exits
+//////////////////////////////////
+typedef struct xos_mempool_t
+{
+    size_t t_ulObjectSize;          // Object size rounded to XOS_MEMPOOL_ALIGNMENT
+    size_t t_ulObjectsPerSlab;      // Number of objects carved from each slab
+    void* t_ptFreeList;             // Intrusive list of free objects
+    void* t_ptSlabs;                // List of allocated slabs
+    size_t t_ulSlabCount;           // Number of allocated slabs
+    uint32_t t_ulFlags;             // Pool flags
+    uint32_t t_ulId;                // Unique pool id (thread cache validation)
+    struct xos_mempool_t* t_ptNextLive; // Next pool with thread caches, flushed at thread exit
+    pthread_mutex_t t_tMutex;       // Protects free list and slab list
+    atomic_size_t a_ulAllocCount;   // Number of allocations
+    atomic_size_t a_ulFreeCount;    // Number of frees
+} xMemPool_t;
+
+//////////////////////////////////
+/// @brief Create an object pool
+/// @param p_ptPool : pool structure pointer
+/// @param p_ulObjectSize : size of one object
+/// @param p_ulObjectsPerSlab : objects per slab (0 for default)
+/// @param p_ulFlags : XOS_MEMPOOL_FLAG_* combination
+/// @return success or error code
+//////////////////////////////////
+int xMemPoolCreate(xMemPool_t* p_ptPool, size_t p_ulObjectSize, size_t p_ulObjectsPerSlab, uint32_t p_ulFlags);
+
+//////////////////////////////////
+/// @brief Allocate an object from the pool
+/// @param p_ptPool : pool structure pointer
+/// @return object pointer or NULL
+//////////////////////////////////
+void* xMemPoolAlloc(xMemPool_t* p_ptPool);
+
+//////////////////////////////////
+/// @brief Return an object to the pool
+/// @param p_ptPool : pool structure pointer
+/// @param p_ptObject : object pointer returned by xMemPoolAlloc
+/// @return success or error code
+//////////////////////////////////
+int xMemPoolFree(xMemPool_t* p_ptPool, void* p_ptObject);
+
+//////////////////////////////////
+/// @brief Destroy the pool and release all its slabs
+/// @param p_ptPool : pool structure pointer
+/// @return success or error code
+/// @note objects still in use become invalid
+//////////////////////////////////
+int xMemPoolDestroy(xMemPool_t* p_ptPool);
+
+//////////////////////////////////
+/// @brief Get pool statistics
+/// @param p_ptPool : pool structure pointer
+/// @param p_pulInUse : objects currently allocated
+/// @param p_pulCapacity : total objects available in slabs
+/// @param p_pulCount : number of allocations
+/// @return success or error code
+//////////////////////////////////
+int xMemPoolGetStats(xMemPool_t* p_ptPool, size_t* p_pulInUse, size_t* p_pulCapacity, size_t* p_pulCount);
+
+#endif // XOS_MEMPOOL_H_
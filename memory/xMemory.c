@@ -4,7 +4,14 @@
 //
 // Notes: 
 // - Added mutex protection (pthread) for multithreaded mode
+// - Blocks are indexed by address in open addressing hash tables, sharded
+//   by address hash so threads rarely contend on the same mutex
+// - Statistics are per-thread counters aggregated on read, the allocation
+//   limit is reserved from one shared total in per-thread batches so the
+//   shared cache line is only written once per XOS_MEM_RESERVE_BATCH bytes
+// - Optional per call site profile, sampled every Nth allocation
 // - Explicit hash calculation to avoid padding issues
+// - Metadata integrity level (none, canary, CRC32C, SHA256) chosen at init
 // - xMemCorrupt() function in DEBUG mode to simulate block corruption
 //
 // Written : 12/01/2025
@@ -13,104 +20,880 @@
 #include "xMemory.h"
 #include "xAssert.h"
 #include "hash/xHash.h"
+#include "xMetrics.h"
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <pthread.h>  // Added for synchronization
 
+#if defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+
 // Global memory manager
-static xMemoryManager_t s_tMemoryManager = { 0 };
+static xMemoryManager_t s_tMemoryManager =
+{
+    .t_tShards = { [0 ... XOS_MEM_SHARD_COUNT - 1] = { .t_tMutex = XOS_FAST_MUTEX_INITIALIZER } },
+    .t_tStatsMutex = PTHREAD_MUTEX_INITIALIZER,
+    .t_eIntegrity = XOS_MEM_DEFAULT_INTEGRITY
+};
+
+// Allocation site profile
+static xMemProfileSite_t s_tProfileSites[XOS_MEM_PROFILE_MAX_SITES];
+static atomic_uint s_ulProfileRate = 0;
+static pthread_mutex_t s_tProfileMutex = PTHREAD_MUTEX_INITIALIZER;
+static __thread uint32_t s_ulProfileCountdown = 0;
+
+// Statistics record of the calling thread
+static __thread xMemoryThreadStats_t* s_ptThreadStats = NULL;
+static pthread_key_t s_tThreadStatsKey;
+static pthread_once_t s_tThreadStatsOnce = PTHREAD_ONCE_INIT;
+
+// Marker for a registry slot whose block has been removed
+#define XOS_MEM_SLOT_DELETED ((xMemoryBlock_t*)(uintptr_t)1)
+
+//
+// Mixes a user address, low bits select the slot and bits 32+ the shard
+//
+static inline uint64_t addressMix(const void* p_ptAddress)
+{
+    // Low bits are always zero because of malloc alignment, mix them out
+    uint64_t l_ulKey = (uint64_t)(uintptr_t)p_ptAddress >> 4;
+    l_ulKey ^= l_ulKey >> 33;
+    l_ulKey *= 0xFF51AFD7ED558CCDULL;
+    l_ulKey ^= l_ulKey >> 33;
+    return l_ulKey;
+}
+
+//
+// Hashes a user address into a registry slot index
+//
+static inline size_t registryHash(const void* p_ptAddress, size_t p_ulMask)
+{
+    return (size_t)addressMix(p_ptAddress) & p_ulMask;
+}
+
+//
+// Returns the shard owning a user address
+//
+static inline xMemoryShard_t* shardOf(const void* p_ptAddress)
+{
+    return &s_tMemoryManager.t_tShards[(addressMix(p_ptAddress) >> 32) & (XOS_MEM_SHARD_COUNT - 1)];
+}
+
+//
+// Rebuilds the registry with a new capacity, dropping deleted slots
+// Caller must hold the shard mutex
+//
+static int registryResize(xMemoryRegistry_t* p_ptRegistry, size_t p_ulCapacity)
+{
+    xMemoryBlock_t** l_ptSlots = calloc(p_ulCapacity, sizeof(xMemoryBlock_t*));
+    if (l_ptSlots == NULL)
+    {
+        return XOS_MEM_ERROR;
+    }
+
+    size_t l_ulMask = p_ulCapacity - 1;
+    for (size_t i = 0; i < p_ptRegistry->t_ulCapacity; i++)
+    {
+        xMemoryBlock_t* l_ptBlock = p_ptRegistry->t_ptSlots[i];
+        if (l_ptBlock == NULL || l_ptBlock == XOS_MEM_SLOT_DELETED)
+        {
+            continue;
+        }
+
+        size_t l_ulIndex = registryHash(l_ptBlock->t_ptAddress, l_ulMask);
+        while (l_ptSlots[l_ulIndex] != NULL)
+        {
+            l_ulIndex = (l_ulIndex + 1) & l_ulMask;
+        }
+        l_ptSlots[l_ulIndex] = l_ptBlock;
+    }
+
+    free(p_ptRegistry->t_ptSlots);
+    p_ptRegistry->t_ptSlots = l_ptSlots;
+    p_ptRegistry->t_ulCapacity = p_ulCapacity;
+    p_ptRegistry->t_ulDeleted = 0;
+
+    return XOS_MEM_OK;
+}
+
+//
+// Inserts a block into the registry
+// Caller must hold the shard mutex
+//
+static int registryInsert(xMemoryRegistry_t* p_ptRegistry, xMemoryBlock_t* p_ptBlock)
+{
+    size_t l_ulUsed = p_ptRegistry->t_ulCount + p_ptRegistry->t_ulDeleted + 1;
+    if (l_ulUsed * 100 > p_ptRegistry->t_ulCapacity * XOS_MEM_REGISTRY_MAX_LOAD)
+    {
+        // Only grow if live blocks need it, otherwise just purge tombstones
+        size_t l_ulCapacity = p_ptRegistry->t_ulCapacity ? p_ptRegistry->t_ulCapacity : XOS_MEM_REGISTRY_INITIAL_SIZE;
+        while ((p_ptRegistry->t_ulCount + 1) * 200 > l_ulCapacity * XOS_MEM_REGISTRY_MAX_LOAD)
+        {
+            l_ulCapacity <<= 1;
+        }
+
+        if (registryResize(p_ptRegistry, l_ulCapacity) != (int)XOS_MEM_OK)
+        {
+            return XOS_MEM_ERROR;
+        }
+    }
+
+    size_t l_ulMask = p_ptRegistry->t_ulCapacity - 1;
+    size_t l_ulIndex = registryHash(p_ptBlock->t_ptAddress, l_ulMask);
+    while (p_ptRegistry->t_ptSlots[l_ulIndex] != NULL &&
+           p_ptRegistry->t_ptSlots[l_ulIndex] != XOS_MEM_SLOT_DELETED)
+    {
+        l_ulIndex = (l_ulIndex + 1) & l_ulMask;
+    }
+
+    if (p_ptRegistry->t_ptSlots[l_ulIndex] == XOS_MEM_SLOT_DELETED)
+    {
+        p_ptRegistry->t_ulDeleted--;
+    }
+    p_ptRegistry->t_ptSlots[l_ulIndex] = p_ptBlock;
+    p_ptRegistry->t_ulCount++;
+
+    return XOS_MEM_OK;
+}
+
+//
+// Finds the slot holding the block of a user address
+// Caller must hold the shard mutex
+// Returns the slot index or SIZE_MAX if the address is unknown
+//
+static size_t registryFind(const xMemoryRegistry_t* p_ptRegistry, const void* p_ptAddress)
+{
+    if (p_ptRegistry->t_ulCapacity == 0)
+    {
+        return SIZE_MAX;
+    }
+
+    size_t l_ulMask = p_ptRegistry->t_ulCapacity - 1;
+    size_t l_ulIndex = registryHash(p_ptAddress, l_ulMask);
+    xMemoryBlock_t* l_ptBlock;
+    while ((l_ptBlock = p_ptRegistry->t_ptSlots[l_ulIndex]) != NULL)
+    {
+        if (l_ptBlock != XOS_MEM_SLOT_DELETED && l_ptBlock->t_ptAddress == p_ptAddress)
+        {
+            return l_ulIndex;
+        }
+        l_ulIndex = (l_ulIndex + 1) & l_ulMask;
+    }
+
+    return SIZE_MAX;
+}
+
+//
+// Removes the block stored at a slot index
+// Caller must hold the shard mutex
+//
+static void registryRemoveAt(xMemoryRegistry_t* p_ptRegistry, size_t p_ulIndex)
+{
+    size_t l_ulMask = p_ptRegistry->t_ulCapacity - 1;
+
+    // A tombstone is only needed if the next slot is part of a probe chain
+    if (p_ptRegistry->t_ptSlots[(p_ulIndex + 1) & l_ulMask] == NULL)
+    {
+        p_ptRegistry->t_ptSlots[p_ulIndex] = NULL;
+    }
+    else
+    {
+        p_ptRegistry->t_ptSlots[p_ulIndex] = XOS_MEM_SLOT_DELETED;
+        p_ptRegistry->t_ulDeleted++;
+    }
+    p_ptRegistry->t_ulCount--;
+}
+
+//
+// Returns the live block stored at a slot index, NULL for empty or deleted slots
+//
+static inline xMemoryBlock_t* registryAt(const xMemoryRegistry_t* p_ptRegistry, size_t p_ulIndex)
+{
+    xMemoryBlock_t* l_ptBlock = p_ptRegistry->t_ptSlots[p_ulIndex];
+    return (l_ptBlock == XOS_MEM_SLOT_DELETED) ? NULL : l_ptBlock;
+}
+
+//
+// Hashes an allocation site into a profile slot index
+//
+static inline size_t profileHash(const char* p_ptkcFile, int p_iLine)
+{
+    uint64_t l_ulKey = ((uint64_t)(uintptr_t)p_ptkcFile) ^ ((uint64_t)(uint32_t)p_iLine * 0x9E3779B97F4A7C15ULL);
+    l_ulKey ^= l_ulKey >> 33;
+    l_ulKey *= 0xC4CEB9FE1A85EC53ULL;
+    l_ulKey ^= l_ulKey >> 33;
+    return (size_t)l_ulKey & (XOS_MEM_PROFILE_MAX_SITES - 1);
+}
+
+//
+// Returns the profile site of a file/line pair, creating it if needed
+// Lookups are lock free, only the creation of a site takes the profile mutex
+// Returns NULL when the site table is full
+//
+static xMemProfileSite_t* profileGetSite(const char* p_ptkcFile, int p_iLine)
+{
+    size_t l_ulIndex = profileHash(p_ptkcFile, p_iLine);
+
+    for (size_t i = 0; i < XOS_MEM_PROFILE_MAX_SITES; i++)
+    {
+        xMemProfileSite_t* l_ptSite = &s_tProfileSites[(l_ulIndex + i) & (XOS_MEM_PROFILE_MAX_SITES - 1)];
+        if (!atomic_load_explicit(&l_ptSite->a_bReady, memory_order_acquire))
+        {
+            // Empty slot: create the site under the mutex, another thread may have won the race
+            pthread_mutex_lock(&s_tProfileMutex);
+            if (!atomic_load_explicit(&l_ptSite->a_bReady, memory_order_relaxed))
+            {
+                atomic_store_explicit(&l_ptSite->a_ptkcFile, p_ptkcFile, memory_order_relaxed);
+                atomic_store_explicit(&l_ptSite->a_iLine, p_iLine, memory_order_relaxed);
+                atomic_store_explicit(&l_ptSite->a_bReady, true, memory_order_release);
+                pthread_mutex_unlock(&s_tProfileMutex);
+                return l_ptSite;
+            }
+            pthread_mutex_unlock(&s_tProfileMutex);
+        }
+
+        if (atomic_load_explicit(&l_ptSite->a_ptkcFile, memory_order_relaxed) == p_ptkcFile &&
+            atomic_load_explicit(&l_ptSite->a_iLine, memory_order_relaxed) == p_iLine)
+        {
+            return l_ptSite;
+        }
+    }
+
+    return NULL;
+}
+
+//
+// Decides if the current allocation of the calling thread is sampled
+//
+static inline bool profileShouldSample(void)
+{
+    uint32_t l_ulRate = atomic_load_explicit(&s_ulProfileRate, memory_order_relaxed);
+    if (l_ulRate == 0)
+    {
+        return false;
+    }
+
+    if (s_ulProfileCountdown == 0 || s_ulProfileCountdown > l_ulRate)
+    {
+        s_ulProfileCountdown = l_ulRate;
+    }
+    return --s_ulProfileCountdown == 0;
+}
+
+//
+// Accounts a block allocation to its site if sampled
+// The block must not be visible to other threads
+//
+static void profileOnAlloc(xMemoryBlock_t* p_ptBlock)
+{
+    p_ptBlock->t_ptSite = NULL;
+    if (!profileShouldSample())
+    {
+        return;
+    }
+
+    xMemProfileSite_t* l_ptSite = profileGetSite(p_ptBlock->t_ptkcFile, p_ptBlock->t_iLine);
+    if (l_ptSite == NULL)
+    {
+        return;
+    }
+
+    p_ptBlock->t_ptSite = l_ptSite;
+    atomic_fetch_add_explicit(&l_ptSite->a_ulAllocCount, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&l_ptSite->a_ulAllocBytes, p_ptBlock->t_ulSize, memory_order_relaxed);
+    atomic_fetch_add_explicit(&l_ptSite->a_ulLiveCount, 1, memory_order_relaxed);
+    size_t l_ulLive = atomic_fetch_add_explicit(&l_ptSite->a_ulLiveBytes, p_ptBlock->t_ulSize, memory_order_relaxed)
+                    + p_ptBlock->t_ulSize;
+
+    size_t l_ulPeak = atomic_load_explicit(&l_ptSite->a_ulPeakBytes, memory_order_relaxed);
+    while ((ptrdiff_t)l_ulLive > 0 && l_ulLive > l_ulPeak &&
+           !atomic_compare_exchange_weak_explicit(&l_ptSite->a_ulPeakBytes, &l_ulPeak, l_ulLive,
+                                                  memory_order_relaxed, memory_order_relaxed))
+    {
+    }
+}
+
+//
+// Accounts a block release to its site if it was sampled
+// The block must not be visible to other threads
+//
+static void profileOnFree(xMemoryBlock_t* p_ptBlock)
+{
+    xMemProfileSite_t* l_ptSite = (xMemProfileSite_t*)p_ptBlock->t_ptSite;
+    if (l_ptSite == NULL)
+    {
+        return;
+    }
+
+    atomic_fetch_add_explicit(&l_ptSite->a_ulFreeCount, 1, memory_order_relaxed);
+    atomic_fetch_sub_explicit(&l_ptSite->a_ulLiveCount, 1, memory_order_relaxed);
+    atomic_fetch_sub_explicit(&l_ptSite->a_ulLiveBytes, p_ptBlock->t_ulSize, memory_order_relaxed);
+    p_ptBlock->t_ptSite = NULL;
+}
+
+//
+// Zeroes the counters of every site, sites keep their key
+//
+static void profileClearCounters(void)
+{
+    for (size_t i = 0; i < XOS_MEM_PROFILE_MAX_SITES; i++)
+    {
+        xMemProfileSite_t* l_ptSite = &s_tProfileSites[i];
+        atomic_store_explicit(&l_ptSite->a_ulLiveBytes, 0, memory_order_relaxed);
+        atomic_store_explicit(&l_ptSite->a_ulLiveCount, 0, memory_order_relaxed);
+        atomic_store_explicit(&l_ptSite->a_ulPeakBytes, 0, memory_order_relaxed);
+        atomic_store_explicit(&l_ptSite->a_ulAllocCount, 0, memory_order_relaxed);
+        atomic_store_explicit(&l_ptSite->a_ulAllocBytes, 0, memory_order_relaxed);
+        atomic_store_explicit(&l_ptSite->a_ulFreeCount, 0, memory_order_relaxed);
+    }
+}
+
+//
+// Folds the counters of an exiting thread into the retired counters
+//
+static void statsThreadExit(void* p_ptStats)
+{
+    xMemoryThreadStats_t* l_ptStats = (xMemoryThreadStats_t*)p_ptStats;
+
+    pthread_mutex_lock(&s_tMemoryManager.t_tStatsMutex);
+    s_tMemoryManager.t_ulRetiredAllocCount += atomic_exchange_explicit(&l_ptStats->a_ulAllocCount, 0, memory_order_relaxed);
+    s_tMemoryManager.t_ulRetiredFreeCount += atomic_exchange_explicit(&l_ptStats->a_ulFreeCount, 0, memory_order_relaxed);
+    atomic_fetch_sub_explicit(&s_tMemoryManager.a_ulTotalAllocated,
+        atomic_exchange_explicit(&l_ptStats->a_ulCredit, 0, memory_order_relaxed), memory_order_relaxed);
+    l_ptStats->t_bInUse = false;
+    pthread_mutex_unlock(&s_tMemoryManager.t_tStatsMutex);
+
+    // A later destructor of this thread takes a record again
+    s_ptThreadStats = NULL;
+}
+
+//
+// Creates the key used to retire thread statistics
+//
+static void statsKeyInit(void)
+{
+    pthread_key_create(&s_tThreadStatsKey, statsThreadExit);
+}
+
+//
+// Returns the statistics record of the calling thread, reusing records of exited threads
+//
+static xMemoryThreadStats_t* statsGetThread(void)
+{
+    if (s_ptThreadStats != NULL)
+    {
+        return s_ptThreadStats;
+    }
+
+    pthread_once(&s_tThreadStatsOnce, statsKeyInit);
+
+    pthread_mutex_lock(&s_tMemoryManager.t_tStatsMutex);
+    xMemoryThreadStats_t* l_ptStats = s_tMemoryManager.t_ptThreadStats;
+    while (l_ptStats != NULL && l_ptStats->t_bInUse)
+    {
+        l_ptStats = l_ptStats->t_ptNext;
+    }
+
+    if (l_ptStats == NULL)
+    {
+        // Records are never released, a new thread takes over a retired one
+        l_ptStats = aligned_alloc(64, sizeof(xMemoryThreadStats_t));
+        if (l_ptStats == NULL)
+        {
+            pthread_mutex_unlock(&s_tMemoryManager.t_tStatsMutex);
+            return NULL;
+        }
+        memset(l_ptStats, 0, sizeof(xMemoryThreadStats_t));
+        l_ptStats->t_ptNext = s_tMemoryManager.t_ptThreadStats;
+        s_tMemoryManager.t_ptThreadStats = l_ptStats;
+    }
+
+    l_ptStats->t_bInUse = true;
+    pthread_mutex_unlock(&s_tMemoryManager.t_tStatsMutex);
+
+    pthread_setspecific(s_tThreadStatsKey, l_ptStats);
+    s_ptThreadStats = l_ptStats;
+    return l_ptStats;
+}
+
+//
+// Computes the bytes in use, reserved minus the thread credits, and sums
+// the thread allocation counters
+// Caller must hold the stats mutex
+//
+static void statsAggregate(size_t* p_pulTotal, size_t* p_pulAllocCount)
+{
+    size_t l_ulAllocCount = s_tMemoryManager.t_ulRetiredAllocCount;
+    size_t l_ulTotal = atomic_load_explicit(&s_tMemoryManager.a_ulTotalAllocated, memory_order_relaxed);
+
+    for (xMemoryThreadStats_t* l_ptStats = s_tMemoryManager.t_ptThreadStats; l_ptStats != NULL; l_ptStats = l_ptStats->t_ptNext)
+    {
+        l_ulAllocCount += atomic_load_explicit(&l_ptStats->a_ulAllocCount, memory_order_relaxed);
+        l_ulTotal -= atomic_load_explicit(&l_ptStats->a_ulCredit, memory_order_relaxed);
+    }
+
+    // A credit read after its refill was folded can make the difference transiently negative
+    if ((ptrdiff_t)l_ulTotal < 0)
+    {
+        l_ulTotal = 0;
+    }
+
+    if (p_pulTotal != NULL)
+    {
+        *p_pulTotal = l_ulTotal;
+    }
+    if (p_pulAllocCount != NULL)
+    {
+        *p_pulAllocCount = l_ulAllocCount;
+    }
+}
+
+//
+// Accounts an allocation of the calling thread
+//
+static void statsOnAlloc(void)
+{
+    xMemoryThreadStats_t* l_ptStats = statsGetThread();
+    if (l_ptStats == NULL)
+    {
+        return;
+    }
+
+    atomic_fetch_add_explicit(&l_ptStats->a_ulAllocCount, 1, memory_order_relaxed);
+}
+
+//
+// Accounts a free of the calling thread
+//
+static void statsOnFree(void)
+{
+    xMemoryThreadStats_t* l_ptStats = statsGetThread();
+    if (l_ptStats == NULL)
+    {
+        return;
+    }
+
+    atomic_fetch_add_explicit(&l_ptStats->a_ulFreeCount, 1, memory_order_relaxed);
+}
+
+//
+// Reserves bytes on the shared total, false when the limit would be passed
+//
+static bool statsReserveShared(size_t p_ulSize)
+{
+    if (p_ulSize > XOS_MEM_MAX_ALLOCATION)
+    {
+        return false;
+    }
+
+    // The limit is never passed, the bytes are given back on failure
+    size_t l_ulTotal = atomic_fetch_add_explicit(&s_tMemoryManager.a_ulTotalAllocated, p_ulSize, memory_order_relaxed) + p_ulSize;
+    if (l_ulTotal > XOS_MEM_MAX_ALLOCATION)
+    {
+        atomic_fetch_sub_explicit(&s_tMemoryManager.a_ulTotalAllocated, p_ulSize, memory_order_relaxed);
+        return false;
+    }
+
+    size_t l_ulPeak = atomic_load_explicit(&s_tMemoryManager.a_ulPeakUsage, memory_order_relaxed);
+    while (l_ulTotal > l_ulPeak &&
+           !atomic_compare_exchange_weak_explicit(&s_tMemoryManager.a_ulPeakUsage, &l_ulPeak, l_ulTotal,
+                                                  memory_order_relaxed, memory_order_relaxed))
+    {
+    }
+    return true;
+}
+
+//
+// Reserves bytes against XOS_MEM_MAX_ALLOCATION, false when the limit would be passed
+// Taken from the thread credit, which is refilled from the shared total one batch at a time
+//
+static bool statsReserve(size_t p_ulSize)
+{
+    if (p_ulSize > XOS_MEM_MAX_ALLOCATION)
+    {
+        return false;
+    }
+
+    xMemoryThreadStats_t* l_ptStats = statsGetThread();
+    if (l_ptStats == NULL)
+    {
+        return statsReserveShared(p_ulSize);
+    }
+
+    // Only the owner thread writes its credit
+    size_t l_ulCredit = atomic_load_explicit(&l_ptStats->a_ulCredit, memory_order_relaxed);
+    if (l_ulCredit >= p_ulSize)
+    {
+        atomic_store_explicit(&l_ptStats->a_ulCredit, l_ulCredit - p_ulSize, memory_order_relaxed);
+        return true;
+    }
+
+    // Close to the limit, fall back to the exact missing amount
+    size_t l_ulMissing = p_ulSize - l_ulCredit;
+    if (statsReserveShared(l_ulMissing + XOS_MEM_RESERVE_BATCH))
+    {
+        atomic_store_explicit(&l_ptStats->a_ulCredit, XOS_MEM_RESERVE_BATCH, memory_order_relaxed);
+        return true;
+    }
+    if (statsReserveShared(l_ulMissing))
+    {
+        atomic_store_explicit(&l_ptStats->a_ulCredit, 0, memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+//
+// Gives reserved bytes back to the thread credit, the excess over one batch
+// goes back to the shared total
+//
+static void statsRelease(size_t p_ulSize)
+{
+    xMemoryThreadStats_t* l_ptStats = statsGetThread();
+    if (l_ptStats == NULL)
+    {
+        atomic_fetch_sub_explicit(&s_tMemoryManager.a_ulTotalAllocated, p_ulSize, memory_order_relaxed);
+        return;
+    }
+
+    size_t l_ulCredit = atomic_load_explicit(&l_ptStats->a_ulCredit, memory_order_relaxed) + p_ulSize;
+    if (l_ulCredit > 2 * (size_t)XOS_MEM_RESERVE_BATCH)
+    {
+        atomic_fetch_sub_explicit(&s_tMemoryManager.a_ulTotalAllocated, l_ulCredit - XOS_MEM_RESERVE_BATCH, memory_order_relaxed);
+        l_ulCredit = XOS_MEM_RESERVE_BATCH;
+    }
+    atomic_store_explicit(&l_ptStats->a_ulCredit, l_ulCredit, memory_order_relaxed);
+}
+
+//
+// Locks every shard, always in the same order
+//
+static void shardsLockAll(void)
+{
+    for (int i = 0; i < XOS_MEM_SHARD_COUNT; i++)
+    {
+        mutexFastLock(&s_tMemoryManager.t_tShards[i].t_tMutex);
+    }
+}
+
+//
+// Unlocks every shard
+//
+static void shardsUnlockAll(void)
+{
+    for (int i = XOS_MEM_SHARD_COUNT - 1; i >= 0; i--)
+    {
+        mutexFastUnlock(&s_tMemoryManager.t_tShards[i].t_tMutex);
+    }
+}
+
+//
+// Releases every block and resets the counters
+// Caller must hold all shard mutexes and the stats mutex
+//
+static void managerReset(bool p_bFreeBlocks)
+{
+    for (int i = 0; i < XOS_MEM_SHARD_COUNT; i++)
+    {
+        xMemoryRegistry_t* l_ptRegistry = &s_tMemoryManager.t_tShards[i].t_tRegistry;
+        for (size_t j = 0; p_bFreeBlocks && j < l_ptRegistry->t_ulCapacity; j++)
+        {
+            xMemoryBlock_t* l_ptBlock = registryAt(l_ptRegistry, j);
+            if (l_ptBlock != NULL)
+            {
+                free(l_ptBlock->t_ptAddress);
+                free(l_ptBlock);
+            }
+        }
+        free(l_ptRegistry->t_ptSlots);
+        memset(l_ptRegistry, 0, sizeof(xMemoryRegistry_t));
+    }
+
+    for (xMemoryThreadStats_t* l_ptStats = s_tMemoryManager.t_ptThreadStats; l_ptStats != NULL; l_ptStats = l_ptStats->t_ptNext)
+    {
+        atomic_store_explicit(&l_ptStats->a_ulAllocCount, 0, memory_order_relaxed);
+        atomic_store_explicit(&l_ptStats->a_ulFreeCount, 0, memory_order_relaxed);
+        atomic_store_explicit(&l_ptStats->a_ulCredit, 0, memory_order_relaxed);
+    }
+    s_tMemoryManager.t_ulRetiredAllocCount = 0;
+    s_tMemoryManager.t_ulRetiredFreeCount = 0;
+    atomic_store_explicit(&s_tMemoryManager.a_ulTotalAllocated, 0, memory_order_relaxed);
+    atomic_store_explicit(&s_tMemoryManager.a_ulPeakUsage, 0, memory_order_relaxed);
+    profileClearCounters();
+}
 
-// Mutex to protect s_tMemoryManager
-static pthread_mutex_t s_memory_mutex = PTHREAD_MUTEX_INITIALIZER;
+// Size of the serialized metadata covered by the digest
+#define XOS_MEM_META_SIZE (sizeof(unsigned long) + sizeof(void*) + sizeof(size_t) + sizeof(const char*) + sizeof(int))
 
 //
-// Calculates SHA256 hash from explicit structure fields
+// Serializes the metadata fields explicitly to avoid padding issues
 //
-static void calculateMetaHash(xMemoryBlock_t* p_ptBlock)
+static size_t serializeMeta(const xMemoryBlock_t* p_ptBlock, uint8_t* p_ptucBuffer)
 {
-    X_ASSERT(p_ptBlock != NULL);
-    uint8_t l_ucBuffer[sizeof(p_ptBlock->t_ulCanaryPrefix)
-        + sizeof(p_ptBlock->t_ptAddress)
-        + sizeof(p_ptBlock->t_ulSize)
-        + sizeof(p_ptBlock->t_ptkcFile)
-        + sizeof(p_ptBlock->t_iLine)];
     size_t offset = 0;
 
-    memcpy(l_ucBuffer + offset, &p_ptBlock->t_ulCanaryPrefix, sizeof(p_ptBlock->t_ulCanaryPrefix));
+    memcpy(p_ptucBuffer + offset, &p_ptBlock->t_ulCanaryPrefix, sizeof(p_ptBlock->t_ulCanaryPrefix));
     offset += sizeof(p_ptBlock->t_ulCanaryPrefix);
 
-    memcpy(l_ucBuffer + offset, &p_ptBlock->t_ptAddress, sizeof(p_ptBlock->t_ptAddress));
+    memcpy(p_ptucBuffer + offset, &p_ptBlock->t_ptAddress, sizeof(p_ptBlock->t_ptAddress));
     offset += sizeof(p_ptBlock->t_ptAddress);
 
-    memcpy(l_ucBuffer + offset, &p_ptBlock->t_ulSize, sizeof(p_ptBlock->t_ulSize));
+    memcpy(p_ptucBuffer + offset, &p_ptBlock->t_ulSize, sizeof(p_ptBlock->t_ulSize));
     offset += sizeof(p_ptBlock->t_ulSize);
 
-    memcpy(l_ucBuffer + offset, &p_ptBlock->t_ptkcFile, sizeof(p_ptBlock->t_ptkcFile));
+    memcpy(p_ptucBuffer + offset, &p_ptBlock->t_ptkcFile, sizeof(p_ptBlock->t_ptkcFile));
     offset += sizeof(p_ptBlock->t_ptkcFile);
 
-    memcpy(l_ucBuffer + offset, &p_ptBlock->t_iLine, sizeof(p_ptBlock->t_iLine));
+    memcpy(p_ptucBuffer + offset, &p_ptBlock->t_iLine, sizeof(p_ptBlock->t_iLine));
     offset += sizeof(p_ptBlock->t_iLine);
 
-    size_t l_ulHashSize;
-    xHashCalculate(XOS_HASH_TYPE_SHA256, l_ucBuffer, offset,
-        p_ptBlock->t_ucMetaHash, &l_ulHashSize);
+    return offset;
+}
+
+// CRC32C (Castagnoli, reflected 0x82F63B78) nibble table for the portable path
+static const uint32_t s_kulCrc32cNibble[16] =
+{
+    0x00000000U, 0x105EC76FU, 0x20BD8EDEU, 0x30E349B1U,
+    0x417B1DBCU, 0x5125DAD3U, 0x61C69362U, 0x7198540DU,
+    0x82F63B78U, 0x92A8FC17U, 0xA24BB5A6U, 0xB21572C9U,
+    0xC38D26C4U, 0xD3D3E1ABU, 0xE330A81AU, 0xF36E6F75U
+};
+
+//
+// Portable CRC32C update, two table lookups per byte
+//
+static uint32_t crc32cSoft(uint32_t p_ulCrc, const uint8_t* p_ptucData, size_t p_ulSize)
+{
+    for (size_t i = 0; i < p_ulSize; i++)
+    {
+        p_ulCrc ^= p_ptucData[i];
+        p_ulCrc = (p_ulCrc >> 4) ^ s_kulCrc32cNibble[p_ulCrc & 0x0FU];
+        p_ulCrc = (p_ulCrc >> 4) ^ s_kulCrc32cNibble[p_ulCrc & 0x0FU];
+    }
+    return p_ulCrc;
+}
+
+#if defined(__x86_64__) && defined(__GNUC__)
+//
+// SSE4.2 CRC32C update, selected at runtime so generic builds use it too
+//
+__attribute__((target("sse4.2")))
+static uint32_t crc32cHw(uint32_t p_ulCrc, const uint8_t* p_ptucData, size_t p_ulSize)
+{
+    uint64_t l_ulCrc = p_ulCrc;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= p_ulSize; i += sizeof(uint64_t))
+    {
+        uint64_t l_ulWord;
+        memcpy(&l_ulWord, p_ptucData + i, sizeof(l_ulWord));
+        l_ulCrc = __builtin_ia32_crc32di(l_ulCrc, l_ulWord);
+    }
+    for (; i < p_ulSize; i++)
+    {
+        l_ulCrc = __builtin_ia32_crc32qi((uint32_t)l_ulCrc, p_ptucData[i]);
+    }
+    return (uint32_t)l_ulCrc;
+}
+#elif defined(__ARM_FEATURE_CRC32)
+//
+// ARMv8 CRC32C update
+//
+static uint32_t crc32cHw(uint32_t p_ulCrc, const uint8_t* p_ptucData, size_t p_ulSize)
+{
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= p_ulSize; i += sizeof(uint64_t))
+    {
+        uint64_t l_ulWord;
+        memcpy(&l_ulWord, p_ptucData + i, sizeof(l_ulWord));
+        p_ulCrc = __crc32cd(p_ulCrc, l_ulWord);
+    }
+    for (; i < p_ulSize; i++)
+    {
+        p_ulCrc = __crc32cb(p_ulCrc, p_ptucData[i]);
+    }
+    return p_ulCrc;
+}
+#endif
+
+//
+// Computes the CRC32C of a buffer, using the CPU instruction when available
+//
+static uint32_t crc32cMeta(const uint8_t* p_ptucData, size_t p_ulSize)
+{
+#if defined(__x86_64__) && defined(__GNUC__)
+    static int s_iHasSse42 = -1;
+    if (s_iHasSse42 < 0)
+    {
+        s_iHasSse42 = __builtin_cpu_supports("sse4.2") ? 1 : 0;
+    }
+    if (s_iHasSse42)
+    {
+        return ~crc32cHw(0xFFFFFFFFU, p_ptucData, p_ulSize);
+    }
+#elif defined(__ARM_FEATURE_CRC32)
+    return ~crc32cHw(0xFFFFFFFFU, p_ptucData, p_ulSize);
+#endif
+    return ~crc32cSoft(0xFFFFFFFFU, p_ptucData, p_ulSize);
+}
+
+//
+// Computes the metadata digest for the given integrity level
+// Returns the number of significant digest bytes
+//
+static size_t digestMeta(const xMemoryBlock_t* p_ptBlock, xMemIntegrity_t p_eIntegrity, uint8_t* p_ptucDigest)
+{
+    uint8_t l_ucBuffer[XOS_MEM_META_SIZE];
+    size_t l_ulLength = serializeMeta(p_ptBlock, l_ucBuffer);
+
+    if (p_eIntegrity == XOS_MEM_INTEGRITY_SHA256)
+    {
+        size_t l_ulHashSize;
+        xHashCalculate(XOS_HASH_TYPE_SHA256, l_ucBuffer, l_ulLength, p_ptucDigest, &l_ulHashSize);
+        return 32;
+    }
+
+    uint32_t l_ulCrc = crc32cMeta(l_ucBuffer, l_ulLength);
+    memcpy(p_ptucDigest, &l_ulCrc, sizeof(l_ulCrc));
+    return sizeof(l_ulCrc);
+}
+
+//
+// Stores the metadata digest of a block
+//
+static void calculateMetaHash(xMemoryBlock_t* p_ptBlock)
+{
+    X_ASSERT(p_ptBlock != NULL);
+    xMemIntegrity_t l_eIntegrity = s_tMemoryManager.t_eIntegrity;
+
+    if (l_eIntegrity >= XOS_MEM_INTEGRITY_CHECKSUM)
+    {
+        digestMeta(p_ptBlock, l_eIntegrity, p_ptBlock->t_ucMetaHash);
+    }
 }
 
 //
-// Checks memory block integrity using canary and hash
+// Checks memory block integrity according to the configured level
 //
 static int checkBlockIntegrity(xMemoryBlock_t* p_ptBlock)
 {
     X_ASSERT(p_ptBlock != NULL);
+    xMemIntegrity_t l_eIntegrity = s_tMemoryManager.t_eIntegrity;
+
+    if (l_eIntegrity == XOS_MEM_INTEGRITY_NONE)
+    {
+        return XOS_MEM_OK;
+    }
+
     X_ASSERT_RETURN(p_ptBlock->t_ulCanaryPrefix == XOS_MEM_CANARY_PREFIX &&
         p_ptBlock->t_ulCanarySuffix == XOS_MEM_CANARY_SUFFIX,
         XOS_MEM_CORRUPTION);
 
+    if (l_eIntegrity == XOS_MEM_INTEGRITY_CANARY)
+    {
+        return XOS_MEM_OK;
+    }
+
     uint8_t l_ucCurrentHash[32];
-    size_t l_ulHashSize;
-    uint8_t l_ucBuffer[sizeof(p_ptBlock->t_ulCanaryPrefix)
-        + sizeof(p_ptBlock->t_ptAddress)
-        + sizeof(p_ptBlock->t_ulSize)
-        + sizeof(p_ptBlock->t_ptkcFile)
-        + sizeof(p_ptBlock->t_iLine)];
-    size_t offset = 0;
+    size_t l_ulDigestSize = digestMeta(p_ptBlock, l_eIntegrity, l_ucCurrentHash);
 
-    memcpy(l_ucBuffer + offset, &p_ptBlock->t_ulCanaryPrefix, sizeof(p_ptBlock->t_ulCanaryPrefix));
-    offset += sizeof(p_ptBlock->t_ulCanaryPrefix);
+    if (memcmp(l_ucCurrentHash, p_ptBlock->t_ucMetaHash, l_ulDigestSize) != 0)
+    {
+        return XOS_MEM_CORRUPTION;
+    }
 
-    memcpy(l_ucBuffer + offset, &p_ptBlock->t_ptAddress, sizeof(p_ptBlock->t_ptAddress));
-    offset += sizeof(p_ptBlock->t_ptAddress);
+    return XOS_MEM_OK;
+}
 
-    memcpy(l_ucBuffer + offset, &p_ptBlock->t_ulSize, sizeof(p_ptBlock->t_ulSize));
-    offset += sizeof(p_ptBlock->t_ulSize);
+//
+// Counts the blocks allocated and not freed yet
+//
+static size_t statsLiveBlocks(void)
+{
+    pthread_mutex_lock(&s_tMemoryManager.t_tStatsMutex);
+    size_t l_ulAllocCount = s_tMemoryManager.t_ulRetiredAllocCount;
+    size_t l_ulFreeCount = s_tMemoryManager.t_ulRetiredFreeCount;
+    for (xMemoryThreadStats_t* l_ptStats = s_tMemoryManager.t_ptThreadStats; l_ptStats != NULL; l_ptStats = l_ptStats->t_ptNext)
+    {
+        l_ulAllocCount += atomic_load_explicit(&l_ptStats->a_ulAllocCount, memory_order_relaxed);
+        l_ulFreeCount += atomic_load_explicit(&l_ptStats->a_ulFreeCount, memory_order_relaxed);
+    }
+    pthread_mutex_unlock(&s_tMemoryManager.t_tStatsMutex);
 
-    memcpy(l_ucBuffer + offset, &p_ptBlock->t_ptkcFile, sizeof(p_ptBlock->t_ptkcFile));
-    offset += sizeof(p_ptBlock->t_ptkcFile);
+    // A free counted before its allocation is read as no live block
+    return (l_ulFreeCount < l_ulAllocCount) ? l_ulAllocCount - l_ulFreeCount : 0;
+}
 
-    memcpy(l_ucBuffer + offset, &p_ptBlock->t_iLine, sizeof(p_ptBlock->t_iLine));
-    offset += sizeof(p_ptBlock->t_iLine);
+//
+// Reads one of the statistics for the metrics registry
+//
+static int64_t memoryMetricRead(void* p_pvArg)
+{
+    uintptr_t l_ulWhich = (uintptr_t)p_pvArg;
+    if (l_ulWhich == 2)
+    {
+        return (int64_t)statsLiveBlocks();
+    }
+
+    size_t l_ulTotal = 0;
+    size_t l_ulPeak = 0;
+    size_t l_ulCount = 0;
+    xMemGetStats(&l_ulTotal, &l_ulPeak, &l_ulCount);
+
+    return (int64_t)((l_ulWhich == 0) ? l_ulTotal : l_ulPeak);
+}
+
+//
+// Initializes the global memory manager with the default integrity level
+//
+int xMemInit(void)
+{
+    return xMemInitEx(XOS_MEM_DEFAULT_INTEGRITY);
+}
 
-    xHashCalculate(XOS_HASH_TYPE_SHA256, l_ucBuffer, offset,
-        l_ucCurrentHash, &l_ulHashSize);
+//
+// Initializes the global memory manager
+//
+int xMemInitEx(xMemIntegrity_t p_eIntegrity)
+{
+    X_ASSERT_RETURN(p_eIntegrity >= XOS_MEM_INTEGRITY_NONE && p_eIntegrity <= XOS_MEM_INTEGRITY_SHA256,
+        XOS_MEM_INVALID);
 
-    if (memcmp(l_ucCurrentHash, p_ptBlock->t_ucMetaHash, sizeof(l_ucCurrentHash)) != 0)
+    shardsLockAll();
+    pthread_mutex_lock(&s_tMemoryManager.t_tStatsMutex);
+    // Live blocks would be orphaned by the reset, and blocks digested with
+    // another level could not be checked anymore
+    for (int i = 0; i < XOS_MEM_SHARD_COUNT; i++)
     {
-        return XOS_MEM_CORRUPTION;
+        if (s_tMemoryManager.t_tShards[i].t_tRegistry.t_ulCount != 0)
+        {
+            pthread_mutex_unlock(&s_tMemoryManager.t_tStatsMutex);
+            shardsUnlockAll();
+            return XOS_MEM_ALREADY_INIT;
+        }
     }
+    managerReset(false);
+    s_tMemoryManager.t_eIntegrity = p_eIntegrity;
+    pthread_mutex_unlock(&s_tMemoryManager.t_tStatsMutex);
+    shardsUnlockAll();
 
+    // Read when scraped, the allocation path is left untouched
+    xMetricsRegisterSampled("mem_allocated_bytes", "Bytes allocated through X_MALLOC", XOS_METRIC_GAUGE,
+        memoryMetricRead, (void*)(uintptr_t)0);
+    xMetricsRegisterSampled("mem_peak_bytes", "Peak of mem_allocated_bytes", XOS_METRIC_GAUGE,
+        memoryMetricRead, (void*)(uintptr_t)1);
+    xMetricsRegisterSampled("mem_live_blocks", "Blocks allocated and not freed", XOS_METRIC_GAUGE,
+        memoryMetricRead, (void*)(uintptr_t)2);
     return XOS_MEM_OK;
 }
 
 //
-// Initializes the global memory manager
+// Returns the current integrity level
 //
-int xMemInit(void)
+xMemIntegrity_t xMemGetIntegrity(void)
 {
-    pthread_mutex_lock(&s_memory_mutex);
-    X_ASSERT(s_tMemoryManager.t_ptBlocks == NULL);
-    memset(&s_tMemoryManager, 0, sizeof(xMemoryManager_t));
-    pthread_mutex_unlock(&s_memory_mutex);
-    return XOS_MEM_OK;
+    return s_tMemoryManager.t_eIntegrity;
 }
 
 //
@@ -118,30 +901,31 @@ int xMemInit(void)
 //
 void* xMemAlloc(size_t p_ulSize, const char* p_ptkcFile, int p_iLine)
 {
-    X_ASSERT(p_ulSize > 0);
     X_ASSERT(p_ptkcFile != NULL);
 
-    // Overflow check
-    if (p_ulSize > SIZE_MAX - sizeof(xMemoryBlock_t))
+    // Zero size and overflow check
+    if (p_ulSize == 0 || p_ulSize > SIZE_MAX - sizeof(xMemoryBlock_t))
     {
         return NULL;
     }
 
-    pthread_mutex_lock(&s_memory_mutex);
-    if (s_tMemoryManager.t_ulTotalAllocated + p_ulSize > XOS_MEM_MAX_ALLOCATION)
+    if (!statsReserve(p_ulSize))
     {
-        pthread_mutex_unlock(&s_memory_mutex);
         return NULL;
     }
-    pthread_mutex_unlock(&s_memory_mutex);
 
     void* l_ptPtr = malloc(p_ulSize);
-    if (l_ptPtr == NULL) return NULL;
+    if (l_ptPtr == NULL)
+    {
+        statsRelease(p_ulSize);
+        return NULL;
+    }
 
     xMemoryBlock_t* l_ptBlock = malloc(sizeof(xMemoryBlock_t));
     if (l_ptBlock == NULL)
     {
         free(l_ptPtr);
+        statsRelease(p_ulSize);
         return NULL;
     }
 
@@ -153,65 +937,136 @@ void* xMemAlloc(size_t p_ulSize, const char* p_ptkcFile, int p_iLine)
     l_ptBlock->t_ulCanarySuffix = XOS_MEM_CANARY_SUFFIX;
 
     calculateMetaHash(l_ptBlock);
+    profileOnAlloc(l_ptBlock);
 
-    pthread_mutex_lock(&s_memory_mutex);
-    l_ptBlock->t_ptNext = s_tMemoryManager.t_ptBlocks;
-    s_tMemoryManager.t_ptBlocks = l_ptBlock;
-
-    s_tMemoryManager.t_ulTotalAllocated += p_ulSize;
-    s_tMemoryManager.t_ulAllocCount++;
-    if (s_tMemoryManager.t_ulTotalAllocated > s_tMemoryManager.t_ulPeakUsage)
+    xMemoryShard_t* l_ptShard = shardOf(l_ptPtr);
+    mutexFastLock(&l_ptShard->t_tMutex);
+    if (registryInsert(&l_ptShard->t_tRegistry, l_ptBlock) != (int)XOS_MEM_OK)
     {
-        s_tMemoryManager.t_ulPeakUsage = s_tMemoryManager.t_ulTotalAllocated;
+        mutexFastUnlock(&l_ptShard->t_tMutex);
+        profileOnFree(l_ptBlock);
+        free(l_ptBlock);
+        free(l_ptPtr);
+        statsRelease(p_ulSize);
+        return NULL;
     }
-    pthread_mutex_unlock(&s_memory_mutex);
+    mutexFastUnlock(&l_ptShard->t_tMutex);
+
+    statsOnAlloc();
 
     return l_ptPtr;
 }
 
+//
+// Reallocates a memory block and updates its metadata
+//
+void* xMemRealloc(void* p_ptPtr, size_t p_ulSize, const char* p_ptkcFile, int p_iLine)
+{
+    if (p_ptPtr == NULL)
+    {
+        return xMemAlloc(p_ulSize, p_ptkcFile, p_iLine);
+    }
+
+    X_ASSERT(p_ptkcFile != NULL);
+    if (p_ulSize == 0)
+    {
+        return NULL;
+    }
+
+    xMemoryShard_t* l_ptShard = shardOf(p_ptPtr);
+    mutexFastLock(&l_ptShard->t_tMutex);
+    size_t l_ulIndex = registryFind(&l_ptShard->t_tRegistry, p_ptPtr);
+    if (l_ulIndex == SIZE_MAX)
+    {
+        mutexFastUnlock(&l_ptShard->t_tMutex);
+        return NULL;
+    }
+
+    xMemoryBlock_t* l_ptBlock = registryAt(&l_ptShard->t_tRegistry, l_ulIndex);
+    size_t l_ulOldSize = l_ptBlock->t_ulSize;
+    size_t l_ulGrowth = (p_ulSize > l_ulOldSize) ? p_ulSize - l_ulOldSize : 0;
+    if (checkBlockIntegrity(l_ptBlock) != (int)XOS_MEM_OK || (l_ulGrowth > 0 && !statsReserve(l_ulGrowth)))
+    {
+        mutexFastUnlock(&l_ptShard->t_tMutex);
+        return NULL;
+    }
+
+    // The address may change, so the block leaves the registry while realloc runs
+    registryRemoveAt(&l_ptShard->t_tRegistry, l_ulIndex);
+    mutexFastUnlock(&l_ptShard->t_tMutex);
+
+    void* l_ptNewPtr = realloc(p_ptPtr, p_ulSize);
+    if (l_ptNewPtr != NULL)
+    {
+        // Profiled as a release of the old site and an allocation at the realloc site
+        profileOnFree(l_ptBlock);
+        l_ptBlock->t_ptAddress = l_ptNewPtr;
+        l_ptBlock->t_ulSize = p_ulSize;
+        l_ptBlock->t_ptkcFile = p_ptkcFile;
+        l_ptBlock->t_iLine = p_iLine;
+        calculateMetaHash(l_ptBlock);
+        profileOnAlloc(l_ptBlock);
+        if (p_ulSize < l_ulOldSize)
+        {
+            statsRelease(l_ulOldSize - p_ulSize);
+        }
+    }
+    else
+    {
+        statsRelease(l_ulGrowth);
+    }
+
+    // On failure the original block is still valid and is registered again
+    l_ptShard = shardOf(l_ptBlock->t_ptAddress);
+    mutexFastLock(&l_ptShard->t_tMutex);
+    if (registryInsert(&l_ptShard->t_tRegistry, l_ptBlock) != (int)XOS_MEM_OK)
+    {
+        mutexFastUnlock(&l_ptShard->t_tMutex);
+        profileOnFree(l_ptBlock);
+        statsRelease(l_ptBlock->t_ulSize);
+        free(l_ptBlock->t_ptAddress);
+        free(l_ptBlock);
+        statsOnFree();
+        return NULL;
+    }
+    mutexFastUnlock(&l_ptShard->t_tMutex);
+
+    return l_ptNewPtr;
+}
+
 //
 // Frees a memory block and removes the associated metadata structure
 //
 int xMemFree(void* p_ptPtr)
 {
     X_ASSERT(p_ptPtr != NULL);
-    pthread_mutex_lock(&s_memory_mutex);
-    xMemoryBlock_t* l_ptCurrent = s_tMemoryManager.t_ptBlocks;
-    xMemoryBlock_t* l_ptPrev = NULL;
 
-    while (l_ptCurrent != NULL)
+    xMemoryShard_t* l_ptShard = shardOf(p_ptPtr);
+    mutexFastLock(&l_ptShard->t_tMutex);
+    size_t l_ulIndex = registryFind(&l_ptShard->t_tRegistry, p_ptPtr);
+    if (l_ulIndex == SIZE_MAX)
     {
-        if (l_ptCurrent->t_ptAddress == p_ptPtr)
-        {
-            if (checkBlockIntegrity(l_ptCurrent) != (int)XOS_MEM_OK)
-            {
-                pthread_mutex_unlock(&s_memory_mutex);
-                return XOS_MEM_CORRUPTION;
-            }
+        mutexFastUnlock(&l_ptShard->t_tMutex);
+        return XOS_MEM_INVALID;
+    }
 
-            if (l_ptPrev == NULL)
-            {
-                s_tMemoryManager.t_ptBlocks = l_ptCurrent->t_ptNext;
-            }
-            else
-            {
-                l_ptPrev->t_ptNext = l_ptCurrent->t_ptNext;
-            }
+    xMemoryBlock_t* l_ptBlock = registryAt(&l_ptShard->t_tRegistry, l_ulIndex);
+    if (checkBlockIntegrity(l_ptBlock) != (int)XOS_MEM_OK)
+    {
+        mutexFastUnlock(&l_ptShard->t_tMutex);
+        return XOS_MEM_CORRUPTION;
+    }
 
-            s_tMemoryManager.t_ulTotalAllocated -= l_ptCurrent->t_ulSize;
-            s_tMemoryManager.t_ulFreeCount++;
+    registryRemoveAt(&l_ptShard->t_tRegistry, l_ulIndex);
+    mutexFastUnlock(&l_ptShard->t_tMutex);
 
-            pthread_mutex_unlock(&s_memory_mutex);
-            free(p_ptPtr);
-            free(l_ptCurrent);
+    statsRelease(l_ptBlock->t_ulSize);
+    statsOnFree();
+    profileOnFree(l_ptBlock);
+    free(p_ptPtr);
+    free(l_ptBlock);
 
-            return XOS_MEM_OK;
-        }
-        l_ptPrev = l_ptCurrent;
-        l_ptCurrent = l_ptCurrent->t_ptNext;
-    }
-    pthread_mutex_unlock(&s_memory_mutex);
-    return XOS_MEM_INVALID;
+    return XOS_MEM_OK;
 }
 
 //
@@ -223,11 +1078,10 @@ int xMemGetStats(size_t* p_pulTotal, size_t* p_pulPeak, size_t* p_pulCount)
     X_ASSERT(p_pulPeak != NULL);
     X_ASSERT(p_pulCount != NULL);
 
-    pthread_mutex_lock(&s_memory_mutex);
-    *p_pulTotal = s_tMemoryManager.t_ulTotalAllocated;
-    *p_pulPeak = s_tMemoryManager.t_ulPeakUsage;
-    *p_pulCount = s_tMemoryManager.t_ulAllocCount;
-    pthread_mutex_unlock(&s_memory_mutex);
+    pthread_mutex_lock(&s_tMemoryManager.t_tStatsMutex);
+    statsAggregate(p_pulTotal, p_pulCount);
+    *p_pulPeak = atomic_load_explicit(&s_tMemoryManager.a_ulPeakUsage, memory_order_relaxed);
+    pthread_mutex_unlock(&s_tMemoryManager.t_tStatsMutex);
 
     return XOS_MEM_OK;
 }
@@ -237,18 +1091,21 @@ int xMemGetStats(size_t* p_pulTotal, size_t* p_pulPeak, size_t* p_pulCount)
 //
 int xMemCheck(void)
 {
-    pthread_mutex_lock(&s_memory_mutex);
-    xMemoryBlock_t* l_ptCurrent = s_tMemoryManager.t_ptBlocks;
-    while (l_ptCurrent != NULL)
+    for (int i = 0; i < XOS_MEM_SHARD_COUNT; i++)
     {
-        if (checkBlockIntegrity(l_ptCurrent) != (int)XOS_MEM_OK)
+        xMemoryShard_t* l_ptShard = &s_tMemoryManager.t_tShards[i];
+        mutexFastLock(&l_ptShard->t_tMutex);
+        for (size_t j = 0; j < l_ptShard->t_tRegistry.t_ulCapacity; j++)
         {
-            pthread_mutex_unlock(&s_memory_mutex);
-            return XOS_MEM_CORRUPTION;
+            xMemoryBlock_t* l_ptBlock = registryAt(&l_ptShard->t_tRegistry, j);
+            if (l_ptBlock != NULL && checkBlockIntegrity(l_ptBlock) != (int)XOS_MEM_OK)
+            {
+                mutexFastUnlock(&l_ptShard->t_tMutex);
+                return XOS_MEM_CORRUPTION;
+            }
         }
-        l_ptCurrent = l_ptCurrent->t_ptNext;
+        mutexFastUnlock(&l_ptShard->t_tMutex);
     }
-    pthread_mutex_unlock(&s_memory_mutex);
     return XOS_MEM_OK;
 }
 
@@ -257,20 +1114,193 @@ int xMemCheck(void)
 //
 int xMemCleanup(void)
 {
-    pthread_mutex_lock(&s_memory_mutex);
-    xMemoryBlock_t* l_ptCurrent = s_tMemoryManager.t_ptBlocks;
-    while (l_ptCurrent != NULL)
+    shardsLockAll();
+    pthread_mutex_lock(&s_tMemoryManager.t_tStatsMutex);
+    managerReset(true);
+    pthread_mutex_unlock(&s_tMemoryManager.t_tStatsMutex);
+    shardsUnlockAll();
+    return XOS_MEM_OK;
+}
+
+//
+// Enables allocation site sampling
+//
+int xMemProfileEnable(uint32_t p_ulSampleRate)
+{
+    atomic_store_explicit(&s_ulProfileRate, p_ulSampleRate, memory_order_relaxed);
+    return XOS_MEM_OK;
+}
+
+//
+// Resets the allocation site counters and forgets sampled blocks
+//
+int xMemProfileReset(void)
+{
+    shardsLockAll();
+    for (int i = 0; i < XOS_MEM_SHARD_COUNT; i++)
     {
-        xMemoryBlock_t* l_ptNext = l_ptCurrent->t_ptNext;
-        free(l_ptCurrent->t_ptAddress);
-        free(l_ptCurrent);
-        l_ptCurrent = l_ptNext;
+        xMemoryRegistry_t* l_ptRegistry = &s_tMemoryManager.t_tShards[i].t_tRegistry;
+        for (size_t j = 0; j < l_ptRegistry->t_ulCapacity; j++)
+        {
+            xMemoryBlock_t* l_ptBlock = registryAt(l_ptRegistry, j);
+            if (l_ptBlock != NULL)
+            {
+                l_ptBlock->t_ptSite = NULL;
+            }
+        }
     }
-    memset(&s_tMemoryManager, 0, sizeof(xMemoryManager_t));
-    pthread_mutex_unlock(&s_memory_mutex);
+    profileClearCounters();
+    shardsUnlockAll();
     return XOS_MEM_OK;
 }
 
+// Site snapshot used by xMemDumpProfile
+typedef struct
+{
+    const char* t_ptkcFile;
+    int t_iLine;
+    size_t t_ulLiveBytes;
+    size_t t_ulLiveCount;
+    size_t t_ulPeakBytes;
+    size_t t_ulAllocCount;
+    size_t t_ulAllocBytes;
+    size_t t_ulFreeCount;
+} xMemProfileEntry_t;
+
+//
+// Orders snapshot entries by file then line
+//
+static int profileCompare(const void* p_ptA, const void* p_ptB)
+{
+    const xMemProfileEntry_t* l_ptA = (const xMemProfileEntry_t*)p_ptA;
+    const xMemProfileEntry_t* l_ptB = (const xMemProfileEntry_t*)p_ptB;
+    int l_iCmp = strcmp(l_ptA->t_ptkcFile, l_ptB->t_ptkcFile);
+    if (l_iCmp != 0)
+    {
+        return l_iCmp;
+    }
+    return (l_ptA->t_iLine > l_ptB->t_iLine) - (l_ptA->t_iLine < l_ptB->t_iLine);
+}
+
+//
+// Returns a live counter clamped to zero and scaled by the sample rate
+//
+static inline size_t profileScale(size_t p_ulValue, uint32_t p_ulRate)
+{
+    return ((ptrdiff_t)p_ulValue < 0) ? 0 : p_ulValue * p_ulRate;
+}
+
+//
+// Writes a JSON string with the characters that need it escaped
+//
+static void profileWriteJsonString(FILE* p_ptFile, const char* p_ptkcString)
+{
+    fputc('"', p_ptFile);
+    for (const char* l_ptkcChar = p_ptkcString; *l_ptkcChar != '\0'; l_ptkcChar++)
+    {
+        if (*l_ptkcChar == '"' || *l_ptkcChar == '\\')
+        {
+            fputc('\\', p_ptFile);
+        }
+        fputc(*l_ptkcChar, p_ptFile);
+    }
+    fputc('"', p_ptFile);
+}
+
+//
+// Writes the per-site allocation profile
+//
+int xMemDumpProfile(const char* p_ptkcPath, xMemProfileFormat_t p_eFormat)
+{
+    X_ASSERT_RETURN(p_eFormat == XOS_MEM_PROFILE_CSV || p_eFormat == XOS_MEM_PROFILE_JSON, XOS_MEM_INVALID);
+
+    uint32_t l_ulRate = atomic_load_explicit(&s_ulProfileRate, memory_order_relaxed);
+    if (l_ulRate == 0)
+    {
+        l_ulRate = 1;
+    }
+
+    xMemProfileEntry_t* l_ptEntries = malloc(sizeof(xMemProfileEntry_t) * XOS_MEM_PROFILE_MAX_SITES);
+    if (l_ptEntries == NULL)
+    {
+        return XOS_MEM_ERROR;
+    }
+
+    size_t l_ulCount = 0;
+    for (size_t i = 0; i < XOS_MEM_PROFILE_MAX_SITES; i++)
+    {
+        xMemProfileSite_t* l_ptSite = &s_tProfileSites[i];
+        if (!atomic_load_explicit(&l_ptSite->a_bReady, memory_order_acquire))
+        {
+            continue;
+        }
+
+        xMemProfileEntry_t* l_ptEntry = &l_ptEntries[l_ulCount++];
+        l_ptEntry->t_ptkcFile = atomic_load_explicit(&l_ptSite->a_ptkcFile, memory_order_relaxed);
+        l_ptEntry->t_iLine = atomic_load_explicit(&l_ptSite->a_iLine, memory_order_relaxed);
+        l_ptEntry->t_ulLiveBytes = profileScale(atomic_load_explicit(&l_ptSite->a_ulLiveBytes, memory_order_relaxed), l_ulRate);
+        l_ptEntry->t_ulLiveCount = profileScale(atomic_load_explicit(&l_ptSite->a_ulLiveCount, memory_order_relaxed), l_ulRate);
+        l_ptEntry->t_ulPeakBytes = profileScale(atomic_load_explicit(&l_ptSite->a_ulPeakBytes, memory_order_relaxed), l_ulRate);
+        l_ptEntry->t_ulAllocCount = profileScale(atomic_load_explicit(&l_ptSite->a_ulAllocCount, memory_order_relaxed), l_ulRate);
+        l_ptEntry->t_ulAllocBytes = profileScale(atomic_load_explicit(&l_ptSite->a_ulAllocBytes, memory_order_relaxed), l_ulRate);
+        l_ptEntry->t_ulFreeCount = profileScale(atomic_load_explicit(&l_ptSite->a_ulFreeCount, memory_order_relaxed), l_ulRate);
+    }
+
+    qsort(l_ptEntries, l_ulCount, sizeof(xMemProfileEntry_t), profileCompare);
+
+    FILE* l_ptFile = (p_ptkcPath != NULL) ? fopen(p_ptkcPath, "w") : stdout;
+    if (l_ptFile == NULL)
+    {
+        free(l_ptEntries);
+        return XOS_MEM_ERROR;
+    }
+
+    if (p_eFormat == XOS_MEM_PROFILE_CSV)
+    {
+        fprintf(l_ptFile, "# sample_rate=%u\n", l_ulRate);
+        fprintf(l_ptFile, "file,line,live_bytes,live_count,peak_bytes,alloc_count,alloc_bytes,free_count\n");
+        for (size_t i = 0; i < l_ulCount; i++)
+        {
+            xMemProfileEntry_t* l_ptEntry = &l_ptEntries[i];
+            fprintf(l_ptFile, "%s,%d,%zu,%zu,%zu,%zu,%zu,%zu\n",
+                    l_ptEntry->t_ptkcFile, l_ptEntry->t_iLine,
+                    l_ptEntry->t_ulLiveBytes, l_ptEntry->t_ulLiveCount, l_ptEntry->t_ulPeakBytes,
+                    l_ptEntry->t_ulAllocCount, l_ptEntry->t_ulAllocBytes, l_ptEntry->t_ulFreeCount);
+        }
+    }
+    else
+    {
+        fprintf(l_ptFile, "{\n  \"sample_rate\": %u,\n  \"sites\": [", l_ulRate);
+        for (size_t i = 0; i < l_ulCount; i++)
+        {
+            xMemProfileEntry_t* l_ptEntry = &l_ptEntries[i];
+            fprintf(l_ptFile, "%s\n    {\"file\": ", (i == 0) ? "" : ",");
+            profileWriteJsonString(l_ptFile, l_ptEntry->t_ptkcFile);
+            fprintf(l_ptFile, ", \"line\": %d, \"live_bytes\": %zu, \"live_count\": %zu, \"peak_bytes\": %zu, "
+                    "\"alloc_count\": %zu, \"alloc_bytes\": %zu, \"free_count\": %zu}",
+                    l_ptEntry->t_iLine, l_ptEntry->t_ulLiveBytes, l_ptEntry->t_ulLiveCount, l_ptEntry->t_ulPeakBytes,
+                    l_ptEntry->t_ulAllocCount, l_ptEntry->t_ulAllocBytes, l_ptEntry->t_ulFreeCount);
+        }
+        fprintf(l_ptFile, "\n  ]\n}\n");
+    }
+
+    int l_iRet = XOS_MEM_OK;
+    if (p_ptkcPath != NULL)
+    {
+        if (fclose(l_ptFile) != 0)
+        {
+            l_iRet = XOS_MEM_ERROR;
+        }
+    }
+    else
+    {
+        fflush(l_ptFile);
+    }
+
+    free(l_ptEntries);
+    return l_iRet;
+}
+
 #ifdef DEBUG
 //
 // Function used to simulate memory corruption (for testing purposes)
@@ -278,11 +1308,21 @@ int xMemCleanup(void)
 //
 void xMemCorrupt(void)
 {
-    pthread_mutex_lock(&s_memory_mutex);
-    if (s_tMemoryManager.t_ptBlocks != NULL)
+    for (int i = 0; i < XOS_MEM_SHARD_COUNT; i++)
     {
-        s_tMemoryManager.t_ptBlocks->t_ulCanaryPrefix = 0;
+        xMemoryShard_t* l_ptShard = &s_tMemoryManager.t_tShards[i];
+        mutexFastLock(&l_ptShard->t_tMutex);
+        for (size_t j = 0; j < l_ptShard->t_tRegistry.t_ulCapacity; j++)
+        {
+            xMemoryBlock_t* l_ptBlock = registryAt(&l_ptShard->t_tRegistry, j);
+            if (l_ptBlock != NULL)
+            {
+                l_ptBlock->t_ulCanaryPrefix = 0;
+                mutexFastUnlock(&l_ptShard->t_tMutex);
+                return;
+            }
+        }
+        mutexFastUnlock(&l_ptShard->t_tMutex);
     }
-    pthread_mutex_unlock(&s_memory_mutex);
 }
 #endif
@@ -12,6 +12,10 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "xOsMutex.h"
 
 // Memory error codes
 #define XOS_MEM_OK            0xB4C73D10
@@ -27,7 +31,36 @@
 #define XOS_MEM_CANARY_SUFFIX 0xBEEFDEADUL
 
 // Memory limits
-#define XOS_MEM_MAX_ALLOCATION 1024 * 1024 * 1024 // 1 GB
+#define XOS_MEM_MAX_ALLOCATION (1024 * 1024 * 1024) // 1 GB
+#define XOS_MEM_RESERVE_BATCH  (64 * 1024)          // Bytes a thread reserves against the limit at once
+
+// Block registry sizing (open addressing, power of two capacity)
+#define XOS_MEM_REGISTRY_INITIAL_SIZE 256   // Initial number of slots per shard
+#define XOS_MEM_REGISTRY_MAX_LOAD     70    // Max load factor in percent (live + deleted slots)
+
+// Registry sharding, blocks are spread over shards by address hash
+#define XOS_MEM_SHARD_COUNT           16    // Number of shards (power of two)
+
+// Allocation site profiling
+#define XOS_MEM_PROFILE_MAX_SITES     1024  // Distinct call sites tracked (power of two)
+
+// Metadata integrity levels, selected with xMemInitEx()
+typedef enum
+{
+    XOS_MEM_INTEGRITY_NONE = 0,     // No check on free/realloc
+    XOS_MEM_INTEGRITY_CANARY,       // Canary values only
+    XOS_MEM_INTEGRITY_CHECKSUM,     // Canaries + CRC32C of the metadata
+    XOS_MEM_INTEGRITY_SHA256        // Canaries + SHA256 of the metadata (audits)
+} xMemIntegrity_t;
+
+// Level used by xMemInit(), release builds default to the checksum
+#ifndef XOS_MEM_DEFAULT_INTEGRITY
+#ifdef DEBUG
+#define XOS_MEM_DEFAULT_INTEGRITY XOS_MEM_INTEGRITY_SHA256
+#else
+#define XOS_MEM_DEFAULT_INTEGRITY XOS_MEM_INTEGRITY_CHECKSUM
+#endif
+#endif
 
 // Memory block structure
 typedef struct __attribute__((packed)) xMemoryBlock
@@ -37,27 +70,92 @@ typedef struct __attribute__((packed)) xMemoryBlock
     size_t t_ulSize;                // Block size
     const char* t_ptkcFile;         // Source file
     int t_iLine;                    // Line number
-    unsigned char t_ucMetaHash[32]; // SHA256 hash of metadata for integrity
+    void* t_ptSite;                 // Profiling site if the allocation was sampled, NULL otherwise
+    unsigned char t_ucMetaHash[32]; // Metadata digest (CRC32C or SHA256 depending on level)
     unsigned long t_ulCanarySuffix; // Canary suffix for overflow detection
-    struct xMemoryBlock* t_ptNext;  // Next block in list
 } xMemoryBlock_t;
 
+// Block registry structure (hash table keyed by user address)
+typedef struct
+{
+    xMemoryBlock_t** t_ptSlots;     // Slot array (NULL = empty)
+    size_t t_ulCapacity;            // Number of slots (power of two)
+    size_t t_ulCount;               // Number of live blocks
+    size_t t_ulDeleted;             // Number of deleted slots (tombstones)
+} xMemoryRegistry_t;
+
+// Allocation site counters, written with relaxed atomics
+// Live counters wrap around like the thread stats and are clamped when dumped
+typedef struct
+{
+    _Atomic(const char*) a_ptkcFile;  // Source file (NULL = free slot)
+    atomic_int a_iLine;               // Line number
+    atomic_bool a_bReady;             // Key fields are published
+    atomic_size_t a_ulLiveBytes;      // Bytes currently allocated from this site
+    atomic_size_t a_ulLiveCount;      // Blocks currently allocated from this site
+    atomic_size_t a_ulPeakBytes;      // Highest live bytes value
+    atomic_size_t a_ulAllocCount;     // Number of allocations
+    atomic_size_t a_ulAllocBytes;     // Cumulated allocated bytes
+    atomic_size_t a_ulFreeCount;      // Number of frees
+} xMemProfileSite_t;
+
+// Profile output formats
+typedef enum
+{
+    XOS_MEM_PROFILE_CSV = 0,
+    XOS_MEM_PROFILE_JSON
+} xMemProfileFormat_t;
+
+// Registry shard, padded to its own cache lines
+typedef struct
+{
+    xOsFastMutex t_tMutex;          // Protects the shard registry, held for a few probes only
+    xMemoryRegistry_t t_tRegistry;  // Blocks whose address hashes to this shard
+} __attribute__((aligned(64))) xMemoryShard_t;
+
+// Per-thread statistics, only written by their owner thread
+typedef struct xMemoryThreadStats
+{
+    atomic_size_t a_ulAllocCount;           // Number of allocations
+    atomic_size_t a_ulFreeCount;            // Number of frees
+    atomic_size_t a_ulCredit;               // Bytes reserved on the shared total and not used yet
+    bool t_bInUse;                          // Owned by a live thread
+    struct xMemoryThreadStats* t_ptNext;    // Next record of the manager list
+} __attribute__((aligned(64))) xMemoryThreadStats_t;
+
 // Memory manager structure
 typedef struct
 {
-    xMemoryBlock_t* t_ptBlocks;     // List of allocated blocks
-    size_t t_ulTotalAllocated;      // Total allocated memory
-    size_t t_ulPeakUsage;           // Peak memory usage
-    size_t t_ulAllocCount;          // Number of allocations
-    size_t t_ulFreeCount;           // Number of frees
+    xMemoryShard_t t_tShards[XOS_MEM_SHARD_COUNT]; // Sharded registry of allocated blocks
+    pthread_mutex_t t_tStatsMutex;          // Protects the thread stats list and retired counters
+    xMemoryThreadStats_t* t_ptThreadStats;  // Stats records of all threads
+    size_t t_ulRetiredAllocCount;           // Counters folded from exited threads
+    size_t t_ulRetiredFreeCount;
+    atomic_size_t a_ulTotalAllocated;       // Bytes reserved against the limit, in use plus the thread credits
+    atomic_size_t a_ulPeakUsage;            // Highest a_ulTotalAllocated reached
+    xMemIntegrity_t t_eIntegrity;           // Metadata integrity level
 } xMemoryManager_t;
 
 //////////////////////////////////
 /// @brief Initialize memory manager
 /// @return success or error code
+/// @note uses XOS_MEM_DEFAULT_INTEGRITY
 //////////////////////////////////
 int xMemInit(void);
 
+//////////////////////////////////
+/// @brief Initialize memory manager with an integrity level
+/// @param p_eIntegrity : metadata integrity level
+/// @return success, XOS_MEM_ALREADY_INIT while blocks are still allocated, or error code
+//////////////////////////////////
+int xMemInitEx(xMemIntegrity_t p_eIntegrity);
+
+//////////////////////////////////
+/// @brief Get the current integrity level
+/// @return integrity level
+//////////////////////////////////
+xMemIntegrity_t xMemGetIntegrity(void);
+
 //////////////////////////////////
 /// @brief Allocate memory block
 /// @param p_ulSize : block size
@@ -100,6 +198,9 @@ int xMemFree(void* p_ptPtr);
 /// @param p_pulPeak : peak memory usage
 /// @param p_pulCount : number of allocations
 /// @return success or error code
+/// @note the total and the allocation count are aggregated from per-thread
+///       records. The peak and the limit apply to reserved bytes, which
+///       include up to 2 * XOS_MEM_RESERVE_BATCH of unused credit per thread
 //////////////////////////////////
 int xMemGetStats(size_t* p_pulTotal, size_t* p_pulPeak, size_t* p_pulCount);
 
@@ -115,6 +216,31 @@ int xMemCheck(void);
 //////////////////////////////////
 int xMemCleanup(void);
 
+//////////////////////////////////
+/// @brief Enable or disable allocation site profiling
+/// @param p_ulSampleRate : 0 to disable, N to sample every Nth allocation of each thread
+/// @return success or error code
+/// @note sampled counters are scaled by the rate when dumped
+//////////////////////////////////
+int xMemProfileEnable(uint32_t p_ulSampleRate);
+
+//////////////////////////////////
+/// @brief Reset all allocation site counters
+/// @return success or error code
+/// @note blocks sampled before the reset are no longer accounted
+//////////////////////////////////
+int xMemProfileReset(void);
+
+//////////////////////////////////
+/// @brief Write the per-site allocation profile
+/// @param p_ptkcPath : output file path, NULL for stdout
+/// @param p_eFormat : XOS_MEM_PROFILE_CSV or XOS_MEM_PROFILE_JSON
+/// @return success or error code
+/// @note sites are sorted by file then line so dumps of two builds can be diffed,
+///       sites with live bytes at exit are leaks
+//////////////////////////////////
+int xMemDumpProfile(const char* p_ptkcPath, xMemProfileFormat_t p_eFormat);
+
 // Macro helpers for source tracking
 #define X_MALLOC(size)           xMemAlloc(size, __FILE__, __LINE__)
 #define X_CALLOC(count, size)    xMemCalloc(count, size, __FILE__, __LINE__)
@@ -0,0 +1,339 @@
+////////////////////////////////////////////////////////////
+//  metrics source file
+//  implements the runtime metrics registry
+//
+// general discloser: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+
+#include "xMetrics.h"
+#include "xOsMutex.h"
+#include "xAssert.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+
+xMetricsShard_t g_tMetricsShards[XOS_METRICS_SHARDS];
+__thread int g_iMetricsShard = 0;
+
+// Latencies in ns when no bounds are given
+static const uint64_t s_ulDefaultBounds[] = {
+    1000ULL, 5000ULL, 10000ULL, 50000ULL, 100000ULL, 500000ULL,
+    1000000ULL, 5000000ULL, 10000000ULL, 50000000ULL, 100000000ULL, 500000000ULL, 1000000000ULL
+};
+
+//////////////////////////////////
+/// @brief registry
+//////////////////////////////////
+typedef struct xos_metrics_registry_t
+{
+    xMetric_t t_tMetrics[XOS_METRICS_MAX_METRICS];
+    atomic_uint a_ulCount;              // Published entries, written last
+    uint32_t t_ulSlots;                 // Shard slots given out
+    atomic_uint a_ulNextShard;
+    xOsFastMutex t_tMutex;              // Registrations only
+} xMetricsRegistry_t;
+
+static xMetricsRegistry_t s_tRegistry = { .t_tMutex = XOS_FAST_MUTEX_INITIALIZER };
+
+////////////////////////////////////////////////////////////
+/// xMetricsAssignShard
+////////////////////////////////////////////////////////////
+int xMetricsAssignShard(void)
+{
+    // Threads take the shards in turn, more threads than shards share them
+    unsigned int l_ulShard = atomic_fetch_add_explicit(&s_tRegistry.a_ulNextShard, 1, memory_order_relaxed);
+    g_iMetricsShard = (int)(l_ulShard & (XOS_METRICS_SHARDS - 1)) + 1;
+    return g_iMetricsShard;
+}
+
+////////////////////////////////////////////////////////////
+/// metricsValidName
+////////////////////////////////////////////////////////////
+static bool metricsValidName(const char* p_pcName)
+{
+    size_t l_ulLength = strlen(p_pcName);
+    if (l_ulLength == 0 || l_ulLength >= XOS_METRICS_NAME_SIZE)
+        return false;
+
+    for (size_t i = 0; i < l_ulLength; i++)
+    {
+        char l_cChar = p_pcName[i];
+        bool l_bAlpha = (l_cChar >= 'a' && l_cChar <= 'z') || (l_cChar >= 'A' && l_cChar <= 'Z') ||
+                        l_cChar == '_' || l_cChar == ':';
+        if (!l_bAlpha && (i == 0 || l_cChar < '0' || l_cChar > '9'))
+            return false;
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////
+/// metricsLookup
+////////////////////////////////////////////////////////////
+static xMetric_t* metricsLookup(const char* p_pcName)
+{
+    unsigned int l_ulCount = atomic_load_explicit(&s_tRegistry.a_ulCount, memory_order_acquire);
+    for (unsigned int i = 0; i < l_ulCount; i++)
+    {
+        if (strcmp(s_tRegistry.t_tMetrics[i].t_cName, p_pcName) == 0)
+            return &s_tRegistry.t_tMetrics[i];
+    }
+    return NULL;
+}
+
+////////////////////////////////////////////////////////////
+/// metricsRegister
+////////////////////////////////////////////////////////////
+static int metricsRegister(const char* p_pcName, const char* p_pcHelp, xMetricType_t p_eType,
+                           const uint64_t* p_pulBounds, uint32_t p_ulBuckets,
+                           xMetricReadFn_t p_pfRead, void* p_pvArg, xMetric_t** p_pptMetric)
+{
+    X_ASSERT_RETURN(p_pcName != NULL, XOS_METRICS_INVALID);
+    if (!metricsValidName(p_pcName))
+        return XOS_METRICS_INVALID;
+
+    mutexFastLock(&s_tRegistry.t_tMutex);
+
+    xMetric_t* l_ptMetric = metricsLookup(p_pcName);
+    if (l_ptMetric != NULL)
+    {
+        mutexFastUnlock(&s_tRegistry.t_tMutex);
+        if (l_ptMetric->t_eType != p_eType || (l_ptMetric->t_pfRead != NULL) != (p_pfRead != NULL))
+            return XOS_METRICS_TYPE_MISMATCH;
+        // Rendering calls the callback unlocked, the pair is never replaced
+        if (l_ptMetric->t_pfRead != p_pfRead || l_ptMetric->t_pvReadArg != p_pvArg)
+            return XOS_METRICS_ALREADY_EXISTS;
+        if (p_pptMetric)
+            *p_pptMetric = l_ptMetric;
+        return XOS_METRICS_OK;
+    }
+
+    // Gauges and sampled metrics keep their value outside the shards
+    uint32_t l_ulSlots = 0;
+    if (p_pfRead == NULL && p_eType == XOS_METRIC_COUNTER)
+        l_ulSlots = 1;
+    else if (p_eType == XOS_METRIC_HISTOGRAM)
+        l_ulSlots = p_ulBuckets + 2;
+
+    unsigned int l_ulCount = atomic_load_explicit(&s_tRegistry.a_ulCount, memory_order_relaxed);
+    if (l_ulCount >= XOS_METRICS_MAX_METRICS || s_tRegistry.t_ulSlots + l_ulSlots > XOS_METRICS_MAX_SLOTS)
+    {
+        mutexFastUnlock(&s_tRegistry.t_tMutex);
+        return XOS_METRICS_FULL;
+    }
+
+    l_ptMetric = &s_tRegistry.t_tMetrics[l_ulCount];
+    memset(l_ptMetric, 0, sizeof(*l_ptMetric));
+    snprintf(l_ptMetric->t_cName, sizeof(l_ptMetric->t_cName), "%s", p_pcName);
+    l_ptMetric->t_pcHelp = p_pcHelp;
+    l_ptMetric->t_eType = p_eType;
+    l_ptMetric->t_ulSlot = s_tRegistry.t_ulSlots;
+    l_ptMetric->t_ulBuckets = p_ulBuckets;
+    for (uint32_t i = 0; i < p_ulBuckets; i++)
+        l_ptMetric->t_ulBounds[i] = p_pulBounds[i];
+    l_ptMetric->t_pfRead = p_pfRead;
+    l_ptMetric->t_pvReadArg = p_pvArg;
+    s_tRegistry.t_ulSlots += l_ulSlots;
+    atomic_store_explicit(&s_tRegistry.a_ulCount, l_ulCount + 1, memory_order_release);
+
+    mutexFastUnlock(&s_tRegistry.t_tMutex);
+
+    if (p_pptMetric)
+        *p_pptMetric = l_ptMetric;
+    return XOS_METRICS_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xMetricsRegisterCounter
+////////////////////////////////////////////////////////////
+int xMetricsRegisterCounter(const char* p_pcName, const char* p_pcHelp, xMetric_t** p_pptMetric)
+{
+    X_ASSERT_RETURN(p_pptMetric != NULL, XOS_METRICS_INVALID);
+    return metricsRegister(p_pcName, p_pcHelp, XOS_METRIC_COUNTER, NULL, 0, NULL, NULL, p_pptMetric);
+}
+
+////////////////////////////////////////////////////////////
+/// xMetricsRegisterGauge
+////////////////////////////////////////////////////////////
+int xMetricsRegisterGauge(const char* p_pcName, const char* p_pcHelp, xMetric_t** p_pptMetric)
+{
+    X_ASSERT_RETURN(p_pptMetric != NULL, XOS_METRICS_INVALID);
+    return metricsRegister(p_pcName, p_pcHelp, XOS_METRIC_GAUGE, NULL, 0, NULL, NULL, p_pptMetric);
+}
+
+////////////////////////////////////////////////////////////
+/// xMetricsRegisterHistogram
+////////////////////////////////////////////////////////////
+int xMetricsRegisterHistogram(const char* p_pcName, const char* p_pcHelp, const uint64_t* p_pulBounds,
+                              uint32_t p_ulCount, xMetric_t** p_pptMetric)
+{
+    X_ASSERT_RETURN(p_pptMetric != NULL, XOS_METRICS_INVALID);
+
+    if (p_pulBounds == NULL)
+    {
+        p_pulBounds = s_ulDefaultBounds;
+        p_ulCount = (uint32_t)(sizeof(s_ulDefaultBounds) / sizeof(s_ulDefaultBounds[0]));
+    }
+    if (p_ulCount == 0 || p_ulCount > XOS_METRICS_MAX_BUCKETS)
+        return XOS_METRICS_INVALID;
+    for (uint32_t i = 1; i < p_ulCount; i++)
+    {
+        if (p_pulBounds[i] <= p_pulBounds[i - 1])
+            return XOS_METRICS_INVALID;
+    }
+
+    return metricsRegister(p_pcName, p_pcHelp, XOS_METRIC_HISTOGRAM, p_pulBounds, p_ulCount, NULL, NULL, p_pptMetric);
+}
+
+////////////////////////////////////////////////////////////
+/// xMetricsRegisterSampled
+////////////////////////////////////////////////////////////
+int xMetricsRegisterSampled(const char* p_pcName, const char* p_pcHelp, xMetricType_t p_eType,
+                            xMetricReadFn_t p_pfRead, void* p_pvArg)
+{
+    X_ASSERT_RETURN(p_pfRead != NULL, XOS_METRICS_INVALID);
+    if (p_eType != XOS_METRIC_COUNTER && p_eType != XOS_METRIC_GAUGE)
+        return XOS_METRICS_INVALID;
+
+    return metricsRegister(p_pcName, p_pcHelp, p_eType, NULL, 0, p_pfRead, p_pvArg, NULL);
+}
+
+////////////////////////////////////////////////////////////
+/// xMetricsFind
+////////////////////////////////////////////////////////////
+xMetric_t* xMetricsFind(const char* p_pcName)
+{
+    if (p_pcName == NULL)
+        return NULL;
+    return metricsLookup(p_pcName);
+}
+
+////////////////////////////////////////////////////////////
+/// metricsSumSlot
+////////////////////////////////////////////////////////////
+static uint64_t metricsSumSlot(uint32_t p_ulSlot)
+{
+    uint64_t l_ulSum = 0;
+    for (int i = 0; i < XOS_METRICS_SHARDS; i++)
+        l_ulSum += atomic_load_explicit(&g_tMetricsShards[i].a_ulSlots[p_ulSlot], memory_order_relaxed);
+    return l_ulSum;
+}
+
+////////////////////////////////////////////////////////////
+/// xMetricsGetValue
+////////////////////////////////////////////////////////////
+int xMetricsGetValue(const xMetric_t* p_ptMetric, int64_t* p_plValue)
+{
+    X_ASSERT_RETURN(p_ptMetric != NULL, XOS_METRICS_INVALID);
+    X_ASSERT_RETURN(p_plValue != NULL, XOS_METRICS_INVALID);
+
+    if (p_ptMetric->t_pfRead != NULL)
+    {
+        *p_plValue = p_ptMetric->t_pfRead(p_ptMetric->t_pvReadArg);
+    }
+    else if (p_ptMetric->t_eType == XOS_METRIC_GAUGE)
+    {
+        *p_plValue = atomic_load_explicit(&((xMetric_t*)p_ptMetric)->a_lGauge, memory_order_relaxed);
+    }
+    else if (p_ptMetric->t_eType == XOS_METRIC_COUNTER)
+    {
+        *p_plValue = (int64_t)metricsSumSlot(p_ptMetric->t_ulSlot);
+    }
+    else
+    {
+        uint64_t l_ulCount = 0;
+        for (uint32_t i = 0; i <= p_ptMetric->t_ulBuckets; i++)
+            l_ulCount += metricsSumSlot(p_ptMetric->t_ulSlot + i);
+        *p_plValue = (int64_t)l_ulCount;
+    }
+
+    return XOS_METRICS_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// metricsAppend
+////////////////////////////////////////////////////////////
+static bool metricsAppend(char* p_pcBuffer, size_t p_ulSize, size_t* p_pulLength, const char* p_pcFormat, ...)
+{
+    if (*p_pulLength >= p_ulSize)
+        return false;
+
+    va_list l_tArgs;
+    va_start(l_tArgs, p_pcFormat);
+    int l_iWritten = vsnprintf(p_pcBuffer + *p_pulLength, p_ulSize - *p_pulLength, p_pcFormat, l_tArgs);
+    va_end(l_tArgs);
+
+    if (l_iWritten < 0 || (size_t)l_iWritten >= p_ulSize - *p_pulLength)
+    {
+        *p_pulLength = p_ulSize;
+        return false;
+    }
+    *p_pulLength += (size_t)l_iWritten;
+    return true;
+}
+
+////////////////////////////////////////////////////////////
+/// metricsRenderHistogram
+////////////////////////////////////////////////////////////
+static bool metricsRenderHistogram(const xMetric_t* p_ptMetric, char* p_pcBuffer, size_t p_ulSize, size_t* p_pulLength)
+{
+    // Buckets are cumulative in the exposition format
+    uint64_t l_ulCumulative = 0;
+    for (uint32_t i = 0; i < p_ptMetric->t_ulBuckets; i++)
+    {
+        l_ulCumulative += metricsSumSlot(p_ptMetric->t_ulSlot + i);
+        if (!metricsAppend(p_pcBuffer, p_ulSize, p_pulLength, "%s_bucket{le=\"%llu\"} %llu\n", p_ptMetric->t_cName,
+                           (unsigned long long)p_ptMetric->t_ulBounds[i], (unsigned long long)l_ulCumulative))
+            return false;
+    }
+    l_ulCumulative += metricsSumSlot(p_ptMetric->t_ulSlot + p_ptMetric->t_ulBuckets);
+    uint64_t l_ulSum = metricsSumSlot(p_ptMetric->t_ulSlot + p_ptMetric->t_ulBuckets + 1);
+
+    return metricsAppend(p_pcBuffer, p_ulSize, p_pulLength, "%s_bucket{le=\"+Inf\"} %llu\n%s_sum %llu\n%s_count %llu\n",
+                         p_ptMetric->t_cName, (unsigned long long)l_ulCumulative, p_ptMetric->t_cName,
+                         (unsigned long long)l_ulSum, p_ptMetric->t_cName, (unsigned long long)l_ulCumulative);
+}
+
+////////////////////////////////////////////////////////////
+/// xMetricsRender
+////////////////////////////////////////////////////////////
+int xMetricsRender(char* p_pcBuffer, size_t p_ulSize, size_t* p_pulLength)
+{
+    static const char* s_pcTypes[] = { "counter", "gauge", "histogram" };
+    X_ASSERT_RETURN(p_pcBuffer != NULL && p_ulSize > 0, XOS_METRICS_INVALID);
+    X_ASSERT_RETURN(p_pulLength != NULL, XOS_METRICS_INVALID);
+
+    size_t l_ulLength = 0;
+    p_pcBuffer[0] = '\0';
+
+    unsigned int l_ulCount = atomic_load_explicit(&s_tRegistry.a_ulCount, memory_order_acquire);
+    for (unsigned int i = 0; i < l_ulCount; i++)
+    {
+        const xMetric_t* l_ptMetric = &s_tRegistry.t_tMetrics[i];
+        bool l_bFits = metricsAppend(p_pcBuffer, p_ulSize, &l_ulLength, "# HELP %s %s\n# TYPE %s %s\n",
+                                     l_ptMetric->t_cName, l_ptMetric->t_pcHelp ? l_ptMetric->t_pcHelp : "",
+                                     l_ptMetric->t_cName, s_pcTypes[l_ptMetric->t_eType]);
+        if (l_bFits && l_ptMetric->t_eType == XOS_METRIC_HISTOGRAM)
+        {
+            l_bFits = metricsRenderHistogram(l_ptMetric, p_pcBuffer, p_ulSize, &l_ulLength);
+        }
+        else if (l_bFits)
+        {
+            int64_t l_lValue = 0;
+            xMetricsGetValue(l_ptMetric, &l_lValue);
+            l_bFits = metricsAppend(p_pcBuffer, p_ulSize, &l_ulLength, "%s %lld\n", l_ptMetric->t_cName,
+                                    (long long)l_lValue);
+        }
+
+        if (!l_bFits)
+        {
+            // Nothing half written is handed out
+            *p_pulLength = 0;
+            p_pcBuffer[0] = '\0';
+            return XOS_METRICS_FULL;
+        }
+    }
+
+    *p_pulLength = l_ulLength;
+    return XOS_METRICS_OK;
+}
@@ -0,0 +1,249 @@
+////////////////////////////////////////////////////////////
+//  metrics header file
+//  defines the runtime metrics registry
+//
+// Modules register named counters, gauges and fixed-bucket histograms
+// once and keep the returned handle. Counters and histograms live in
+// XOS_METRICS_SHARDS shards of slots, each thread adds to the shard it
+// was given on its first update with a relaxed atomic add, so threads
+// do not share cache lines on the hot path; a read sums the shards.
+// Gauges are a single value set by their owner. Sampled metrics are
+// read through a callback when the registry is rendered, for values a
+// module already keeps (memory usage, log drops). xMetricsRender
+// writes the Prometheus text exposition format, served by
+// xMetricsServer.h
+//
+// general discloser: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+#pragma once
+
+#ifndef XOS_METRICS_H_
+#define XOS_METRICS_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+// Metrics error codes
+#define XOS_METRICS_OK              0xC9E35B10
+#define XOS_METRICS_ERROR           0xC9E35B11
+#define XOS_METRICS_INVALID         0xC9E35B12
+#define XOS_METRICS_FULL            0xC9E35B13      // Registry or output buffer full
+#define XOS_METRICS_TYPE_MISMATCH   0xC9E35B14      // Name already registered with another type
+#define XOS_METRICS_ALREADY_EXISTS  0xC9E35B15      // Sampled name already registered with another callback
+
+// Configuration constants
+#define XOS_METRICS_MAX_METRICS     128
+#define XOS_METRICS_MAX_SLOTS       1024            // Slots per shard, a counter takes 1, a histogram buckets + 2
+#define XOS_METRICS_SHARDS          16              // Power of two
+#define XOS_METRICS_MAX_BUCKETS     16
+#define XOS_METRICS_NAME_SIZE       64
+#define XOS_METRICS_CACHE_LINE      64
+
+//////////////////////////////////
+/// @brief metric types
+//////////////////////////////////
+typedef enum
+{
+    XOS_METRIC_COUNTER = 0,         // Monotonic, sharded
+    XOS_METRIC_GAUGE,               // Set or moved by its owner
+    XOS_METRIC_HISTOGRAM            // Observations per bucket, sharded
+} xMetricType_t;
+
+//////////////////////////////////
+/// @brief callback of a sampled metric
+/// @param p_pvArg : argument given at registration
+/// @return current value
+//////////////////////////////////
+typedef int64_t (*xMetricReadFn_t)(void* p_pvArg);
+
+//////////////////////////////////
+/// @brief registered metric
+//////////////////////////////////
+typedef struct xos_metric_t
+{
+    char t_cName[XOS_METRICS_NAME_SIZE];
+    const char* t_pcHelp;                       // Outlives the registry (a literal)
+    xMetricType_t t_eType;
+    uint32_t t_ulSlot;                          // First shard slot (counter, histogram)
+    uint32_t t_ulBuckets;                       // Histogram bounds, +Inf excluded
+    uint64_t t_ulBounds[XOS_METRICS_MAX_BUCKETS]; // Inclusive upper bounds, ascending
+    atomic_llong a_lGauge;                      // Gauge value
+    xMetricReadFn_t t_pfRead;                   // Sampled metric callback, NULL otherwise
+    void* t_pvReadArg;
+} xMetric_t;
+
+//////////////////////////////////
+/// @brief slots of one shard, on its own cache lines
+//////////////////////////////////
+typedef struct xos_metrics_shard_t
+{
+    atomic_ullong a_ulSlots[XOS_METRICS_MAX_SLOTS];
+} __attribute__((aligned(XOS_METRICS_CACHE_LINE))) xMetricsShard_t;
+
+// Shards, indexed by g_iMetricsShard - 1
+extern xMetricsShard_t g_tMetricsShards[XOS_METRICS_SHARDS];
+
+// Shard of the calling thread plus one, 0 until its first update
+extern __thread int g_iMetricsShard;
+
+//////////////////////////////////
+/// @brief Give the calling thread a shard
+/// @return shard plus one
+/// @note slow path of the update functions, run once per thread
+//////////////////////////////////
+int xMetricsAssignShard(void);
+
+//////////////////////////////////
+/// @brief Get a slot of the calling thread shard
+/// @param p_ulSlot : slot index
+/// @return slot
+//////////////////////////////////
+static inline atomic_ullong* xMetricsSlot(uint32_t p_ulSlot)
+{
+    int l_iShard = g_iMetricsShard;
+    if (__builtin_expect(l_iShard == 0, 0))
+        l_iShard = xMetricsAssignShard();
+    return &g_tMetricsShards[l_iShard - 1].a_ulSlots[p_ulSlot];
+}
+
+//////////////////////////////////
+/// @brief Add to a counter
+/// @param p_ptMetric : counter (NULL is ignored)
+/// @param p_ulValue : increment
+/// @return none
+//////////////////////////////////
+static inline void xMetricsAdd(xMetric_t* p_ptMetric, uint64_t p_ulValue)
+{
+    if (p_ptMetric != NULL)
+        atomic_fetch_add_explicit(xMetricsSlot(p_ptMetric->t_ulSlot), p_ulValue, memory_order_relaxed);
+}
+
+//////////////////////////////////
+/// @brief Add one to a counter
+/// @param p_ptMetric : counter (NULL is ignored)
+/// @return none
+//////////////////////////////////
+static inline void xMetricsInc(xMetric_t* p_ptMetric)
+{
+    xMetricsAdd(p_ptMetric, 1);
+}
+
+//////////////////////////////////
+/// @brief Set a gauge
+/// @param p_ptMetric : gauge (NULL is ignored)
+/// @param p_lValue : value
+/// @return none
+//////////////////////////////////
+static inline void xMetricsGaugeSet(xMetric_t* p_ptMetric, int64_t p_lValue)
+{
+    if (p_ptMetric != NULL)
+        atomic_store_explicit(&p_ptMetric->a_lGauge, p_lValue, memory_order_relaxed);
+}
+
+//////////////////////////////////
+/// @brief Move a gauge
+/// @param p_ptMetric : gauge (NULL is ignored)
+/// @param p_lDelta : change, negative to decrease
+/// @return none
+//////////////////////////////////
+static inline void xMetricsGaugeAdd(xMetric_t* p_ptMetric, int64_t p_lDelta)
+{
+    if (p_ptMetric != NULL)
+        atomic_fetch_add_explicit(&p_ptMetric->a_lGauge, p_lDelta, memory_order_relaxed);
+}
+
+//////////////////////////////////
+/// @brief Record an observation in a histogram
+/// @param p_ptMetric : histogram (NULL is ignored)
+/// @param p_ulValue : observed value, in the unit of the bounds
+/// @return none
+//////////////////////////////////
+static inline void xMetricsObserve(xMetric_t* p_ptMetric, uint64_t p_ulValue)
+{
+    if (p_ptMetric == NULL)
+        return;
+
+    // Bucket slots, then the +Inf bucket, then the sum
+    uint32_t l_ulBucket = 0;
+    while (l_ulBucket < p_ptMetric->t_ulBuckets && p_ulValue > p_ptMetric->t_ulBounds[l_ulBucket])
+        l_ulBucket++;
+
+    atomic_ullong* l_ptSlots = xMetricsSlot(p_ptMetric->t_ulSlot);
+    atomic_fetch_add_explicit(&l_ptSlots[l_ulBucket], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&l_ptSlots[p_ptMetric->t_ulBuckets + 1], p_ulValue, memory_order_relaxed);
+}
+
+//////////////////////////////////
+/// @brief Register a counter
+/// @param p_pcName : metric name, [a-zA-Z_:][a-zA-Z0-9_:]*
+/// @param p_pcHelp : description, a literal
+/// @param p_pptMetric : filled with the handle
+/// @return : success or error code
+/// @note a name registered again returns the same handle
+//////////////////////////////////
+int xMetricsRegisterCounter(const char* p_pcName, const char* p_pcHelp, xMetric_t** p_pptMetric);
+
+//////////////////////////////////
+/// @brief Register a gauge
+/// @param p_pcName : metric name
+/// @param p_pcHelp : description, a literal
+/// @param p_pptMetric : filled with the handle
+/// @return : success or error code
+//////////////////////////////////
+int xMetricsRegisterGauge(const char* p_pcName, const char* p_pcHelp, xMetric_t** p_pptMetric);
+
+//////////////////////////////////
+/// @brief Register a histogram
+/// @param p_pcName : metric name
+/// @param p_pcHelp : description, a literal
+/// @param p_pulBounds : inclusive upper bounds, ascending (NULL for latencies in ns, 1 us to 1 s)
+/// @param p_ulCount : number of bounds, at most XOS_METRICS_MAX_BUCKETS
+/// @param p_pptMetric : filled with the handle
+/// @return : success or error code
+//////////////////////////////////
+int xMetricsRegisterHistogram(const char* p_pcName, const char* p_pcHelp, const uint64_t* p_pulBounds,
+                              uint32_t p_ulCount, xMetric_t** p_pptMetric);
+
+//////////////////////////////////
+/// @brief Register a metric read from a callback when rendered
+/// @param p_pcName : metric name
+/// @param p_pcHelp : description, a literal
+/// @param p_eType : XOS_METRIC_COUNTER or XOS_METRIC_GAUGE
+/// @param p_pfRead : callback, called from the rendering thread
+/// @param p_pvArg : callback argument
+/// @return : success or error code
+/// @note a name registered again with the same callback and argument succeeds,
+///       with another pair it returns XOS_METRICS_ALREADY_EXISTS and the first
+///       callback stays in use, there is no unregistration
+//////////////////////////////////
+int xMetricsRegisterSampled(const char* p_pcName, const char* p_pcHelp, xMetricType_t p_eType,
+                            xMetricReadFn_t p_pfRead, void* p_pvArg);
+
+//////////////////////////////////
+/// @brief Find a metric by name
+/// @param p_pcName : metric name
+/// @return : handle, NULL when not registered
+//////////////////////////////////
+xMetric_t* xMetricsFind(const char* p_pcName);
+
+//////////////////////////////////
+/// @brief Read a counter or a gauge
+/// @param p_ptMetric : metric
+/// @param p_plValue : filled with the value, the observation count for a histogram
+/// @return : success or error code
+//////////////////////////////////
+int xMetricsGetValue(const xMetric_t* p_ptMetric, int64_t* p_plValue);
+
+//////////////////////////////////
+/// @brief Write every metric in the Prometheus text format
+/// @param p_pcBuffer : output buffer
+/// @param p_ulSize : buffer size
+/// @param p_pulLength : filled with the bytes written, without the terminating 0
+/// @return : success, XOS_METRICS_FULL when the buffer is too small, or error code
+//////////////////////////////////
+int xMetricsRender(char* p_pcBuffer, size_t p_ulSize, size_t* p_pulLength);
+
+#endif // XOS_METRICS_H_
@@ -0,0 +1,284 @@
+////////////////////////////////////////////////////////////
+//  metrics server source file
+//  implements the scrape endpoint of the metrics registry
+//
+// general discloser: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+
+#include "xMetricsServer.h"
+#include "xAssert.h"
+#include "xLog.h"
+#include "xMemory.h"
+#include "xTimer.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+static xMetricsServer_t s_tServer;
+
+////////////////////////////////////////////////////////////
+/// metricsServerRelease
+////////////////////////////////////////////////////////////
+static void metricsServerRelease(xMetricsServer_t* p_ptServer)
+{
+    if (p_ptServer->t_ptListener)
+        networkCloseSocket(p_ptServer->t_ptListener);
+    if (p_ptServer->t_pcBuffer)
+        X_FREE(p_ptServer->t_pcBuffer);
+    for (int i = 0; i < 2; i++)
+    {
+        if (p_ptServer->t_iWakeFd[i] >= 0)
+            close(p_ptServer->t_iWakeFd[i]);
+        p_ptServer->t_iWakeFd[i] = -1;
+    }
+    p_ptServer->t_ptListener = NULL;
+    p_ptServer->t_pcBuffer = NULL;
+}
+
+////////////////////////////////////////////////////////////
+/// metricsServerWait
+////////////////////////////////////////////////////////////
+static bool metricsServerWait(xMetricsServer_t* p_ptServer, int p_iFd, short p_sEvents, int p_iTimeoutMs)
+{
+    // The wake pipe is never drained, once stopped every wait fails at once
+    struct pollfd l_tFds[2] = {
+        { .fd = p_ptServer->t_iWakeFd[0], .events = POLLIN, .revents = 0 },
+        { .fd = p_iFd, .events = p_sEvents, .revents = 0 },
+    };
+
+    int l_iRet;
+    do
+    {
+        l_iRet = poll(l_tFds, 2, p_iTimeoutMs);
+    } while (l_iRet < 0 && errno == EINTR);
+
+    return l_iRet > 0 && l_tFds[0].revents == 0 && l_tFds[1].revents != 0;
+}
+
+#ifdef USE_TLS
+////////////////////////////////////////////////////////////
+/// metricsServerHandshake
+////////////////////////////////////////////////////////////
+static bool metricsServerHandshake(xMetricsServer_t* p_ptServer, NetworkSocket* p_ptClient)
+{
+    // A client that stalls the handshake is dropped at the deadline
+    uint64_t l_ulDeadline = xTimerGetCurrentMs() + XOS_METRICS_SERVER_TIMEOUT_MS;
+    for (;;)
+    {
+        int l_iRet = networkHandshake(p_ptClient);
+        if (l_iRet == (int)NETWORK_OK)
+            return true;
+        if (l_iRet != (int)NETWORK_WANT_READ && l_iRet != (int)NETWORK_WANT_WRITE)
+            return false;
+
+        uint64_t l_ulNow = xTimerGetCurrentMs();
+        if (l_ulNow >= l_ulDeadline ||
+            !metricsServerWait(p_ptServer, p_ptClient->t_iSocketFd,
+                               (l_iRet == (int)NETWORK_WANT_READ) ? POLLIN : POLLOUT,
+                               (int)(l_ulDeadline - l_ulNow)))
+            return false;
+    }
+}
+#endif
+
+////////////////////////////////////////////////////////////
+/// metricsServerSendAll
+////////////////////////////////////////////////////////////
+static bool metricsServerSendAll(NetworkSocket* p_ptClient, const char* p_pcData, size_t p_ulSize)
+{
+    while (p_ulSize > 0)
+    {
+        int l_iSent = networkSend(p_ptClient, p_pcData, p_ulSize);
+        if (l_iSent <= 0)
+            return false;
+        p_pcData += l_iSent;
+        p_ulSize -= (size_t)l_iSent;
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////
+/// metricsServerRender
+////////////////////////////////////////////////////////////
+static int metricsServerRender(xMetricsServer_t* p_ptServer, size_t* p_pulLength)
+{
+    for (;;)
+    {
+        int l_iRet = xMetricsRender(p_ptServer->t_pcBuffer, p_ptServer->t_ulBufferSize, p_pulLength);
+        if (l_iRet != (int)XOS_METRICS_FULL || p_ptServer->t_ulBufferSize >= XOS_METRICS_SERVER_MAX_BUFFER)
+            return l_iRet;
+
+        // The buffer is kept, following scrapes render at once
+        char* l_pcBuffer = (char*)X_MALLOC(p_ptServer->t_ulBufferSize * 2);
+        if (l_pcBuffer == NULL)
+            return XOS_METRICS_ERROR;
+        X_FREE(p_ptServer->t_pcBuffer);
+        p_ptServer->t_pcBuffer = l_pcBuffer;
+        p_ptServer->t_ulBufferSize *= 2;
+    }
+}
+
+////////////////////////////////////////////////////////////
+/// metricsServerHandle
+////////////////////////////////////////////////////////////
+static void metricsServerHandle(xMetricsServer_t* p_ptServer, NetworkSocket* p_ptClient)
+{
+    char l_cRequest[XOS_METRICS_SERVER_REQUEST_SIZE];
+    size_t l_ulReceived = 0;
+
+    networkSetTimeout(p_ptClient, XOS_METRICS_SERVER_TIMEOUT_MS, false);
+    networkSetTimeout(p_ptClient, XOS_METRICS_SERVER_TIMEOUT_MS, true);
+
+    // Any path is answered, only the end of the request head is awaited
+    while (l_ulReceived < sizeof(l_cRequest) - 1)
+    {
+        int l_iRead = networkReceive(p_ptClient, l_cRequest + l_ulReceived, sizeof(l_cRequest) - 1 - l_ulReceived);
+        if (l_iRead <= 0)
+            return;
+        l_ulReceived += (size_t)l_iRead;
+        l_cRequest[l_ulReceived] = '\0';
+        if (strstr(l_cRequest, "\r\n\r\n") != NULL || strstr(l_cRequest, "\n\n") != NULL)
+            break;
+    }
+
+    char l_cHeader[160];
+    size_t l_ulLength = 0;
+    int l_iHeader;
+    if (metricsServerRender(p_ptServer, &l_ulLength) != (int)XOS_METRICS_OK)
+    {
+        l_iHeader = snprintf(l_cHeader, sizeof(l_cHeader),
+                             "HTTP/1.0 500 Internal Server Error\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+        metricsServerSendAll(p_ptClient, l_cHeader, (size_t)l_iHeader);
+        return;
+    }
+
+    l_iHeader = snprintf(l_cHeader, sizeof(l_cHeader),
+                         "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\n"
+                         "Content-Length: %zu\r\nConnection: close\r\n\r\n", l_ulLength);
+    if (metricsServerSendAll(p_ptClient, l_cHeader, (size_t)l_iHeader) &&
+        metricsServerSendAll(p_ptClient, p_ptServer->t_pcBuffer, l_ulLength))
+        atomic_fetch_add_explicit(&p_ptServer->a_ulScrapes, 1, memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////
+/// metricsServerTask
+////////////////////////////////////////////////////////////
+static void* metricsServerTask(void* p_pvArg)
+{
+    xMetricsServer_t* l_ptServer = (xMetricsServer_t*)p_pvArg;
+
+    while (atomic_load(&l_ptServer->t_tTask.a_iStopFlag) != OS_TASK_STOP_REQUEST)
+    {
+        // xMetricsServerStop writes the wake pipe, the listener is not closed under the wait
+        if (!metricsServerWait(l_ptServer, l_ptServer->t_ptListener->t_iSocketFd, POLLIN, -1))
+            continue;
+
+        // Non-blocking listener, a client gone before the accept does not stall the task
+        NetworkSocket* l_ptClient = networkAccept(l_ptServer->t_ptListener, NULL);
+        if (l_ptClient == NULL)
+            continue;
+
+#ifdef USE_TLS
+        bool l_bReady = metricsServerHandshake(l_ptServer, l_ptClient);
+#else
+        bool l_bReady = true;
+#endif
+        // The request is served in blocking mode under the socket timeouts
+        if (l_bReady && networkSetNonBlocking(l_ptClient, false) == (int)NETWORK_OK)
+            metricsServerHandle(l_ptServer, l_ptClient);
+        networkCloseSocket(l_ptClient);
+    }
+
+    return NULL;
+}
+
+////////////////////////////////////////////////////////////
+/// xMetricsServerStart
+////////////////////////////////////////////////////////////
+int xMetricsServerStart(const xMetricsServerConfig_t* p_ptConfig)
+{
+    X_ASSERT_RETURN(p_ptConfig != NULL, XOS_METRICS_SERVER_INVALID);
+    xMetricsServer_t* l_ptServer = &s_tServer;
+
+    bool l_bExpected = false;
+    if (!atomic_compare_exchange_strong(&l_ptServer->a_bRunning, &l_bExpected, true))
+        return XOS_METRICS_SERVER_ALREADY_RUNNING;
+
+#ifdef USE_TLS
+    if (p_ptConfig->t_ptTls == NULL)
+    {
+        atomic_store(&l_ptServer->a_bRunning, false);
+        return XOS_METRICS_SERVER_INVALID;
+    }
+    l_ptServer->t_ptListener = networkCreateSecureSocket(p_ptConfig->t_ptTls);
+#else
+    l_ptServer->t_ptListener = networkCreateSocket(NETWORK_SOCK_TCP);
+#endif
+    l_ptServer->t_iWakeFd[0] = l_ptServer->t_iWakeFd[1] = -1;
+    l_ptServer->t_ulBufferSize = XOS_METRICS_SERVER_BUFFER_SIZE;
+    l_ptServer->t_pcBuffer = (char*)X_MALLOC(l_ptServer->t_ulBufferSize);
+    atomic_store(&l_ptServer->a_ulScrapes, 0);
+
+    NetworkAddress l_tAddress = networkMakeAddress(p_ptConfig->t_pcAddress ? p_ptConfig->t_pcAddress : "0.0.0.0",
+                                                   p_ptConfig->t_usPort ? p_ptConfig->t_usPort : XOS_METRICS_SERVER_DEFAULT_PORT);
+    if (l_ptServer->t_ptListener == NULL || l_ptServer->t_pcBuffer == NULL ||
+        networkBind(l_ptServer->t_ptListener, &l_tAddress) != (int)NETWORK_OK ||
+        networkListen(l_ptServer->t_ptListener, NETWORK_MAX_PENDING) != (int)NETWORK_OK ||
+        networkSetNonBlocking(l_ptServer->t_ptListener, true) != (int)NETWORK_OK ||
+        pipe2(l_ptServer->t_iWakeFd, O_NONBLOCK | O_CLOEXEC) != 0)
+    {
+        X_LOG_TRACE("xMetricsServerStart: cannot listen on %s:%u", l_tAddress.t_cAddress, l_tAddress.t_usPort);
+        metricsServerRelease(l_ptServer);
+        atomic_store(&l_ptServer->a_bRunning, false);
+        return XOS_METRICS_SERVER_ERROR;
+    }
+
+    osTaskInit(&l_ptServer->t_tTask);
+    l_ptServer->t_tTask.t_ptTask = metricsServerTask;
+    l_ptServer->t_tTask.t_ptTaskArg = l_ptServer;
+    l_ptServer->t_tTask.t_ulStackSize = XOS_METRICS_SERVER_STACK_SIZE;
+    l_ptServer->t_tTask.t_iPriority = p_ptConfig->t_iPriority;
+    l_ptServer->t_tTask.t_pcName = "metrics";
+    if (osTaskCreate(&l_ptServer->t_tTask) != OS_TASK_SUCCESS)
+    {
+        X_LOG_TRACE("xMetricsServerStart: server task creation failed");
+        metricsServerRelease(l_ptServer);
+        atomic_store(&l_ptServer->a_bRunning, false);
+        return XOS_METRICS_SERVER_ERROR;
+    }
+
+    return XOS_METRICS_SERVER_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xMetricsServerStop
+////////////////////////////////////////////////////////////
+int xMetricsServerStop(void)
+{
+    xMetricsServer_t* l_ptServer = &s_tServer;
+
+    bool l_bExpected = true;
+    if (!atomic_compare_exchange_strong(&l_ptServer->a_bRunning, &l_bExpected, false))
+        return XOS_METRICS_SERVER_NOT_RUNNING;
+
+    atomic_store(&l_ptServer->t_tTask.a_iStopFlag, OS_TASK_STOP_REQUEST);
+    char l_cByte = 1;
+    ssize_t l_lRet = write(l_ptServer->t_iWakeFd[1], &l_cByte, 1);
+    (void)l_lRet;
+    int l_iRet = osTaskWait(&l_ptServer->t_tTask, NULL);
+    metricsServerRelease(l_ptServer);
+
+    return (l_iRet == OS_TASK_SUCCESS) ? XOS_METRICS_SERVER_OK : XOS_METRICS_SERVER_ERROR;
+}
+
+////////////////////////////////////////////////////////////
+/// xMetricsServerGetScrapeCount
+////////////////////////////////////////////////////////////
+uint64_t xMetricsServerGetScrapeCount(void)
+{
+    return atomic_load_explicit(&s_tServer.a_ulScrapes, memory_order_relaxed);
+}
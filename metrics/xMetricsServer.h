@@ -0,0 +1,93 @@
+////////////////////////////////////////////////////////////
+//  metrics server header file
+//  defines the scrape endpoint of the metrics registry
+//
+// A low priority task answers every HTTP request on its port with the
+// registry rendered in the Prometheus text format, then closes the
+// connection. Requests are served one at a time, a scraper polls every
+// few seconds and never needs more. With USE_TLS the endpoint is
+// served over TLS
+//
+// general discloser: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+#pragma once
+
+#ifndef XOS_METRICS_SERVER_H_
+#define XOS_METRICS_SERVER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "xMetrics.h"
+#include "xTask.h"
+#ifdef USE_TLS
+#include "xNetworkTls.h"
+#else
+#include "xNetwork.h"
+#endif
+
+// Metrics server error codes
+#define XOS_METRICS_SERVER_OK               0xC9E35B20
+#define XOS_METRICS_SERVER_ERROR            0xC9E35B21
+#define XOS_METRICS_SERVER_INVALID          0xC9E35B22
+#define XOS_METRICS_SERVER_ALREADY_RUNNING  0xC9E35B23
+#define XOS_METRICS_SERVER_NOT_RUNNING      0xC9E35B24
+
+// Configuration constants
+#define XOS_METRICS_SERVER_DEFAULT_PORT     9464        // Prometheus exporter default
+#define XOS_METRICS_SERVER_TIMEOUT_MS       2000        // TLS handshake deadline, request read and response write timeout
+#define XOS_METRICS_SERVER_REQUEST_SIZE     1024        // Request head read at most, the rest is ignored
+#define XOS_METRICS_SERVER_BUFFER_SIZE      (16 * 1024) // First render buffer, doubled while too small
+#define XOS_METRICS_SERVER_MAX_BUFFER       (1024 * 1024)
+#define XOS_METRICS_SERVER_STACK_SIZE       (64 * 1024)
+
+//////////////////////////////////
+/// @brief server configuration
+//////////////////////////////////
+typedef struct xos_metrics_server_config_t
+{
+    const char* t_pcAddress;                // Listening IPv4 address (NULL for 0.0.0.0)
+    unsigned short t_usPort;                // Listening port (0 for XOS_METRICS_SERVER_DEFAULT_PORT)
+    int t_iPriority;                        // Task priority, OS_TASK_LOWEST_PRIORITY is advised
+#ifdef USE_TLS
+    const NetworkTlsConfig* t_ptTls;        // Server TLS configuration
+#endif
+} xMetricsServerConfig_t;
+
+//////////////////////////////////
+/// @brief server state
+//////////////////////////////////
+typedef struct xos_metrics_server_t
+{
+    NetworkSocket* t_ptListener;
+    char* t_pcBuffer;                       // Render buffer, kept between scrapes
+    size_t t_ulBufferSize;
+    xOsTaskCtx t_tTask;
+    int t_iWakeFd[2];                       // Pipe written by xMetricsServerStop
+    atomic_bool a_bRunning;
+    atomic_ulong a_ulScrapes;               // Requests answered
+} xMetricsServer_t;
+
+//////////////////////////////////
+/// @brief Open the endpoint and start its task
+/// @param p_ptConfig : configuration
+/// @return : success or error code
+//////////////////////////////////
+int xMetricsServerStart(const xMetricsServerConfig_t* p_ptConfig);
+
+//////////////////////////////////
+/// @brief Stop the task and close the endpoint
+/// @return : success or error code
+/// @note an idle task or a pending TLS handshake is woken at once, a
+///       request being served finishes within XOS_METRICS_SERVER_TIMEOUT_MS
+//////////////////////////////////
+int xMetricsServerStop(void);
+
+//////////////////////////////////
+/// @brief Get the number of scrapes answered since xMetricsServerStart
+/// @return scrapes
+//////////////////////////////////
+uint64_t xMetricsServerGetScrapeCount(void);
+
+#endif // XOS_METRICS_SERVER_H_
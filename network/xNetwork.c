@@ -9,6 +9,213 @@
 ////////////////////////////////////////////////////////////
 
 #include "xNetwork.h"
+#include "xNetworkFrame.h"
+#include "xMemPool.h"
+#include "xTrace.h"
+#include "xMetrics.h"
+#include "xTask.h"
+#include <pthread.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/sendfile.h>
+#include <linux/errqueue.h>
+
+#ifndef SO_ZEROCOPY
+#define SO_ZEROCOPY 60
+#endif
+#ifndef MSG_ZEROCOPY
+#define MSG_ZEROCOPY 0x4000000
+#endif
+
+// Largest transfer of one blocking networkSendFile call, keeps the result in an int
+#define NETWORK_SENDFILE_MAX (1UL << 30)
+
+// Pool of socket structures, created on first use
+static xMemPool_t s_tSocketPool;
+static pthread_once_t s_tSocketPoolOnce = PTHREAD_ONCE_INIT;
+static int s_iSocketPoolStatus = NETWORK_ERROR;
+
+// Registry handles, registered with the pool (NULL handles are ignored)
+static struct
+{
+    xMetric_t *t_ptTxBytes;
+    xMetric_t *t_ptRxBytes;
+    xMetric_t *t_ptTxCalls;
+    xMetric_t *t_ptRxCalls;
+    xMetric_t *t_ptAccepted;
+    xMetric_t *t_ptConnectNs;
+} s_tNetworkMetrics;
+
+//////////////////////////////////
+/// networkSocketPoolInit
+//////////////////////////////////
+static void networkSocketPoolInit(void)
+{
+    // Every socket comes from the pool, so the handles exist before any transfer
+    xMetricsRegisterCounter("net_tx_bytes_total", "Bytes sent", &s_tNetworkMetrics.t_ptTxBytes);
+    xMetricsRegisterCounter("net_rx_bytes_total", "Bytes received", &s_tNetworkMetrics.t_ptRxBytes);
+    xMetricsRegisterCounter("net_tx_syscalls_total", "Send system calls", &s_tNetworkMetrics.t_ptTxCalls);
+    xMetricsRegisterCounter("net_rx_syscalls_total", "Receive system calls", &s_tNetworkMetrics.t_ptRxCalls);
+    xMetricsRegisterCounter("net_accepted_total", "Connections accepted", &s_tNetworkMetrics.t_ptAccepted);
+    xMetricsRegisterHistogram("net_connect_duration_ns", "Blocking connect duration", NULL, 0,
+                              &s_tNetworkMetrics.t_ptConnectNs);
+
+    if (xMemPoolCreate(&s_tSocketPool, sizeof(NetworkSocket), NETWORK_MAX_SOCKETS,
+                       XOS_MEMPOOL_FLAG_THREAD_CACHE) == (int)XOS_MEM_OK)
+    {
+        s_iSocketPoolStatus = NETWORK_OK;
+    }
+}
+
+//////////////////////////////////
+/// networkCountIo
+//////////////////////////////////
+static inline void networkCountIo(xMetric_t *p_ptCalls, xMetric_t *p_ptBytes, long p_lResult)
+{
+    xMetricsInc(p_ptCalls);
+    if (p_lResult > 0)
+        xMetricsAdd(p_ptBytes, (uint64_t)p_lResult);
+}
+
+//////////////////////////////////
+/// networkAllocSocket
+//////////////////////////////////
+static NetworkSocket *networkAllocSocket(void)
+{
+    pthread_once(&s_tSocketPoolOnce, networkSocketPoolInit);
+    if (s_iSocketPoolStatus != (int)NETWORK_OK)
+    {
+        return NULL;
+    }
+
+    return (NetworkSocket *)xMemPoolAlloc(&s_tSocketPool);
+}
+
+//////////////////////////////////
+/// networkFreeSocket
+//////////////////////////////////
+static void networkFreeSocket(NetworkSocket *p_ptSocket)
+{
+    xMemPoolFree(&s_tSocketPool, p_ptSocket);
+}
+
+//////////////////////////////////
+/// networkErrnoStatus
+//////////////////////////////////
+static int networkErrnoStatus(const NetworkSocket *p_ptSocket, int p_iErrno)
+{
+    // EAGAIN means "not ready" on a non-blocking socket, "timeout expired" otherwise
+    if (p_iErrno == EAGAIN || p_iErrno == EWOULDBLOCK)
+        return p_ptSocket->t_bNonBlocking ? NETWORK_WOULD_BLOCK : NETWORK_TIMEOUT;
+
+    return NETWORK_ERROR;
+}
+
+//////////////////////////////////
+/// networkSendLock
+//////////////////////////////////
+static inline xOsMutexCtx *networkSendLock(NetworkSocket *p_ptSocket)
+{
+    if (p_ptSocket->t_iLockMode == NETWORK_LOCK_NONE)
+        return NULL;
+
+    return (p_ptSocket->t_iLockMode == NETWORK_LOCK_DUPLEX) ? &p_ptSocket->t_SendMutex : &p_ptSocket->t_Mutex;
+}
+
+//////////////////////////////////
+/// networkReceiveLock
+//////////////////////////////////
+static inline xOsMutexCtx *networkReceiveLock(NetworkSocket *p_ptSocket)
+{
+    return (p_ptSocket->t_iLockMode == NETWORK_LOCK_NONE) ? NULL : &p_ptSocket->t_Mutex;
+}
+
+//////////////////////////////////
+/// networkToSockaddr
+//////////////////////////////////
+static bool networkToSockaddr(const NetworkAddress *p_pAddress, struct sockaddr_in *p_ptAddr)
+{
+    memset(p_ptAddr, 0, sizeof(*p_ptAddr));
+    p_ptAddr->sin_family = AF_INET;
+    p_ptAddr->sin_port = HOST_TO_NET_SHORT(p_pAddress->t_usPort);
+    return inet_pton(AF_INET, p_pAddress->t_cAddress, &p_ptAddr->sin_addr) > 0;
+}
+
+//////////////////////////////////
+/// networkFromSockaddr
+//////////////////////////////////
+static void networkFromSockaddr(const struct sockaddr_in *p_ptAddr, NetworkAddress *p_pAddress)
+{
+    inet_ntop(AF_INET, &p_ptAddr->sin_addr, p_pAddress->t_cAddress, INET_ADDRSTRLEN);
+    p_pAddress->t_usPort = NET_TO_HOST_SHORT(p_ptAddr->sin_port);
+}
+
+//////////////////////////////////
+/// networkAcceptOne
+//////////////////////////////////
+static NetworkSocket *networkAcceptOne(NetworkSocket *p_ptSocket, NetworkAddress *p_pClientAddress, int *p_piStatus)
+{
+    struct sockaddr_in l_tClientAddr;
+    socklen_t l_iAddrLen = sizeof(l_tClientAddr);
+
+    // The accepted socket inherits the listener mode without an extra fcntl()
+    int l_iFlags = SOCK_CLOEXEC | (p_ptSocket->t_bNonBlocking ? SOCK_NONBLOCK : 0);
+    int l_iClientFd = accept4(p_ptSocket->t_iSocketFd, (struct sockaddr *)&l_tClientAddr, &l_iAddrLen, l_iFlags);
+    if (l_iClientFd < 0)
+    {
+        // Status decided before logging, the trace may overwrite errno
+        int l_iErrno = errno;
+        *p_piStatus = (l_iErrno == EAGAIN || l_iErrno == EWOULDBLOCK || l_iErrno == ECONNABORTED)
+                    ? NETWORK_WOULD_BLOCK : NETWORK_ERROR;
+        if (l_iErrno != EAGAIN && l_iErrno != EWOULDBLOCK)
+        {
+            X_LOG_TRACE("networkAccept: accept() failed with error %d", l_iErrno);
+        }
+        errno = l_iErrno;
+        return NULL;
+    }
+
+    xMetricsInc(s_tNetworkMetrics.t_ptAccepted);
+
+    // Store client address if requested
+    if (p_pClientAddress)
+        networkFromSockaddr(&l_tClientAddr, p_pClientAddress);
+
+    X_LOG_TRACE("networkAccept: Connection accepted from %s:%d",
+                p_pClientAddress ? p_pClientAddress->t_cAddress : "unknown",
+                p_pClientAddress ? p_pClientAddress->t_usPort : 0);
+
+    // Allocate socket for the new connection
+    NetworkSocket *l_pClientSocket = networkAllocSocket();
+    if (!l_pClientSocket)
+    {
+        X_LOG_TRACE("networkAccept: Failed to allocate memory for client socket");
+        close(l_iClientFd);
+        *p_piStatus = NETWORK_ERROR;
+        errno = ENOMEM;
+        return NULL;
+    }
+
+    // Configure client socket
+    l_pClientSocket->t_iSocketFd = l_iClientFd;
+    l_pClientSocket->t_iType = NETWORK_SOCK_TCP;
+    l_pClientSocket->t_bConnected = true;
+    l_pClientSocket->t_bNonBlocking = p_ptSocket->t_bNonBlocking;
+    l_pClientSocket->t_bConnecting = false;
+    l_pClientSocket->t_iLockMode = p_ptSocket->t_iLockMode;
+    l_pClientSocket->t_bZeroCopy = false;
+    l_pClientSocket->t_bZeroCopyCopied = false;
+    l_pClientSocket->t_ulZeroCopyNext = 0;
+    l_pClientSocket->t_ulZeroCopyDone = 0;
+    l_pClientSocket->t_ptFrameBuffer = NULL;
+
+    // Initialize the mutexes for thread safety
+    mutexCreate(&l_pClientSocket->t_Mutex);
+    mutexCreate(&l_pClientSocket->t_SendMutex);
+
+    *p_piStatus = NETWORK_OK;
+    return l_pClientSocket;
+}
 
 //////////////////////////////////
 /// Core API Implementation
@@ -20,7 +227,7 @@
 NetworkSocket *networkCreateSocket(int p_iType)
 {
     // Allocate a new socket structure
-    NetworkSocket *l_pSocket = (NetworkSocket *)malloc(sizeof(NetworkSocket));
+    NetworkSocket *l_pSocket = networkAllocSocket();
     if (!l_pSocket)
     {
         X_LOG_TRACE("networkCreateSocket: Memory allocation failed");
@@ -32,7 +239,7 @@ NetworkSocket *networkCreateSocket(int p_iType)
     if (l_pSocket->t_iSocketFd < 0)
     {
         X_LOG_TRACE("networkCreateSocket: Socket creation failed with errno %d", errno);
-        free(l_pSocket);
+        networkFreeSocket(l_pSocket);
         return NULL;
     }
 
@@ -43,9 +250,18 @@ NetworkSocket *networkCreateSocket(int p_iType)
     // Set socket properties
     l_pSocket->t_iType = p_iType;
     l_pSocket->t_bConnected = false;
+    l_pSocket->t_bNonBlocking = false;
+    l_pSocket->t_bConnecting = false;
+    l_pSocket->t_iLockMode = NETWORK_LOCK_SHARED;
+    l_pSocket->t_bZeroCopy = false;
+    l_pSocket->t_bZeroCopyCopied = false;
+    l_pSocket->t_ulZeroCopyNext = 0;
+    l_pSocket->t_ulZeroCopyDone = 0;
+    l_pSocket->t_ptFrameBuffer = NULL;
 
     // Initialize the mutex for thread safety
     mutexCreate(&l_pSocket->t_Mutex);
+    mutexCreate(&l_pSocket->t_SendMutex);
 
     X_LOG_TRACE("networkCreateSocket: Socket created successfully");
     return l_pSocket;
@@ -145,46 +361,45 @@ NetworkSocket *networkAccept(NetworkSocket *p_ptSocket, NetworkAddress *p_pClien
 
     X_LOG_TRACE("networkAccept: Accepting new connection on socket %d", p_ptSocket->t_iSocketFd);
 
-    struct sockaddr_in l_tClientAddr;
-    socklen_t l_iAddrLen = sizeof(l_tClientAddr);
-
-    int l_iClientFd = accept(p_ptSocket->t_iSocketFd, (struct sockaddr *)&l_tClientAddr, &l_iAddrLen);
-    if (l_iClientFd < 0)
+    int l_iStatus;
+    NetworkSocket *l_pClientSocket = networkAcceptOne(p_ptSocket, p_pClientAddress, &l_iStatus);
+    if (l_pClientSocket)
     {
-        X_LOG_TRACE("networkAccept: accept() failed with error %d", errno);
-        return NULL;
+        X_LOG_TRACE("networkAccept: Connection successful");
     }
 
-    // Store client address if requested
-    if (p_pClientAddress)
-    {
-        inet_ntop(AF_INET, &l_tClientAddr.sin_addr, p_pClientAddress->t_cAddress, INET_ADDRSTRLEN);
-        p_pClientAddress->t_usPort = NET_TO_HOST_SHORT(l_tClientAddr.sin_port);
-    }
+    return l_pClientSocket;
+}
 
-    X_LOG_TRACE("networkAccept: Connection accepted from %s:%d",
-                p_pClientAddress ? p_pClientAddress->t_cAddress : "unknown",
-                p_pClientAddress ? p_pClientAddress->t_usPort : 0);
+//////////////////////////////////
+/// networkAcceptBatch
+//////////////////////////////////
+int networkAcceptBatch(NetworkSocket *p_ptSocket, NetworkSocket **p_ptClients, NetworkAddress *p_pClientAddresses, int p_iMax)
+{
+    if (!p_ptSocket || p_ptSocket->t_iSocketFd < 0 || !p_ptClients || p_iMax <= 0)
+        return NETWORK_INVALID_PARAM;
 
-    // Allocate socket for the new connection
-    NetworkSocket *l_pClientSocket = (NetworkSocket *)malloc(sizeof(NetworkSocket));
-    if (!l_pClientSocket)
+    // A blocking listener would wait for the next client after the backlog is empty
+    if (!p_ptSocket->t_bNonBlocking)
+        return NETWORK_INVALID_PARAM;
+
+    int l_iCount = 0;
+    while (l_iCount < p_iMax)
     {
-        X_LOG_TRACE("networkAccept: Failed to allocate memory for client socket");
-        close(l_iClientFd);
-        return NULL;
+        int l_iStatus;
+        NetworkSocket *l_pClient = networkAcceptOne(p_ptSocket, p_pClientAddresses ? &p_pClientAddresses[l_iCount] : NULL, &l_iStatus);
+        if (!l_pClient)
+        {
+            // Backlog empty, or an error reported once nothing was accepted
+            if (l_iCount == 0 && l_iStatus != (int)NETWORK_WOULD_BLOCK)
+                return NETWORK_ERROR;
+            break;
+        }
+        p_ptClients[l_iCount++] = l_pClient;
     }
 
-    // Configure client socket
-    l_pClientSocket->t_iSocketFd = l_iClientFd;
-    l_pClientSocket->t_iType = NETWORK_SOCK_TCP;
-    l_pClientSocket->t_bConnected = true;
-
-    // Initialize the mutex for thread safety
-    mutexCreate(&l_pClientSocket->t_Mutex);
-
-    X_LOG_TRACE("networkAccept: Connection successful");
-    return l_pClientSocket;
+    X_LOG_TRACE("networkAcceptBatch: %d connections accepted on socket %d", l_iCount, p_ptSocket->t_iSocketFd);
+    return l_iCount;
 }
 
 //////////////////////////////////
@@ -207,18 +422,90 @@ int networkConnect(NetworkSocket *p_ptSocket, const NetworkAddress *p_pAddress)
         return NETWORK_INVALID_PARAM;
 
     X_LOG_TRACE("networkConnect: Connecting to %s:%d", p_pAddress->t_cAddress, p_pAddress->t_usPort);
+    uint64_t l_ulStart = osTaskNowNs();
     if (connect(p_ptSocket->t_iSocketFd, (struct sockaddr *)&l_tAddr, sizeof(l_tAddr)) < 0)
     {
-        X_LOG_TRACE("networkConnect: TCP connection failed with error %d", errno);
         p_ptSocket->t_bConnected = false;
+
+        // Non-blocking: the socket becomes writable when the handshake ends
+        if (errno == EINPROGRESS && p_ptSocket->t_bNonBlocking)
+        {
+            p_ptSocket->t_bConnecting = true;
+            X_LOG_TRACE("networkConnect: Connection in progress");
+            return NETWORK_IN_PROGRESS;
+        }
+
+        X_LOG_TRACE("networkConnect: TCP connection failed with error %d", errno);
         return NETWORK_ERROR;
     }
 
+    xMetricsObserve(s_tNetworkMetrics.t_ptConnectNs, osTaskNowNs() - l_ulStart);
     p_ptSocket->t_bConnected = true;
+    p_ptSocket->t_bConnecting = false;
     X_LOG_TRACE("networkConnect: Connection successful");
     return NETWORK_OK;
 }
 
+//////////////////////////////////
+/// networkConnectComplete
+//////////////////////////////////
+int networkConnectComplete(NetworkSocket *p_ptSocket)
+{
+    if (!p_ptSocket || p_ptSocket->t_iSocketFd < 0)
+        return NETWORK_INVALID_PARAM;
+
+    if (!p_ptSocket->t_bConnecting)
+        return p_ptSocket->t_bConnected ? NETWORK_OK : NETWORK_ERROR;
+
+    int l_iError = 0;
+    socklen_t l_iLen = sizeof(l_iError);
+    if (getsockopt(p_ptSocket->t_iSocketFd, SOL_SOCKET, SO_ERROR, &l_iError, &l_iLen) < 0)
+        l_iError = errno;
+
+    if (l_iError == EINPROGRESS || l_iError == EALREADY)
+        return NETWORK_IN_PROGRESS;
+
+    // SO_ERROR is 0 both when connected and when still connecting on some stacks
+    if (l_iError == 0)
+    {
+        struct sockaddr_in l_tPeer;
+        socklen_t l_iPeerLen = sizeof(l_tPeer);
+        if (getpeername(p_ptSocket->t_iSocketFd, (struct sockaddr *)&l_tPeer, &l_iPeerLen) < 0)
+            return (errno == ENOTCONN) ? NETWORK_IN_PROGRESS : NETWORK_ERROR;
+    }
+
+    p_ptSocket->t_bConnecting = false;
+    if (l_iError != 0)
+    {
+        X_LOG_TRACE("networkConnectComplete: TCP connection failed with error %d", l_iError);
+        return NETWORK_ERROR;
+    }
+
+    p_ptSocket->t_bConnected = true;
+    X_LOG_TRACE("networkConnectComplete: Connection successful");
+    return NETWORK_OK;
+}
+
+//////////////////////////////////
+/// networkSetNonBlocking
+//////////////////////////////////
+int networkSetNonBlocking(NetworkSocket *p_ptSocket, bool p_bNonBlocking)
+{
+    if (!p_ptSocket || p_ptSocket->t_iSocketFd < 0)
+        return NETWORK_INVALID_PARAM;
+
+    int l_iFlags = fcntl(p_ptSocket->t_iSocketFd, F_GETFL, 0);
+    if (l_iFlags < 0)
+        return NETWORK_ERROR;
+
+    l_iFlags = p_bNonBlocking ? (l_iFlags | O_NONBLOCK) : (l_iFlags & ~O_NONBLOCK);
+    if (fcntl(p_ptSocket->t_iSocketFd, F_SETFL, l_iFlags) < 0)
+        return NETWORK_ERROR;
+
+    p_ptSocket->t_bNonBlocking = p_bNonBlocking;
+    return NETWORK_OK;
+}
+
 //////////////////////////////////
 /// networkSend
 //////////////////////////////////
@@ -234,24 +521,24 @@ int networkSend(NetworkSocket *p_ptSocket, const void *p_pBuffer, unsigned long
     if (p_ulSize == 0)
         return 0;
 
-    // Lock mutex before accessing socket
-    mutexLock(&p_ptSocket->t_Mutex);
+    // Lock according to the socket mode before accessing it
+    xOsMutexCtx *l_ptLock = networkSendLock(p_ptSocket);
+    if (l_ptLock)
+        mutexLock(l_ptLock);
 
-    X_LOG_TRACE("networkSend: Sending on socket %d, %lu bytes",
-                p_ptSocket->t_iSocketFd, p_ulSize);
-    result = send(p_ptSocket->t_iSocketFd, p_pBuffer, p_ulSize, 0);
+    // A peer reset must surface as an error, not as SIGPIPE
+    X_TRACE_BEGIN("net.send");
+    result = send(p_ptSocket->t_iSocketFd, p_pBuffer, p_ulSize, MSG_NOSIGNAL);
+    X_TRACE_END("net.send");
+    networkCountIo(s_tNetworkMetrics.t_ptTxCalls, s_tNetworkMetrics.t_ptTxBytes, result);
     if (result < 0)
     {
-        X_LOG_TRACE("networkSend: Send failed with error code %d", errno);
-        result = NETWORK_ERROR;
-    }
-    else
-    {
-        X_LOG_TRACE("networkSend: Send successful, sent %d bytes", result);
+        X_LOG_TRACE("networkSend: Send on socket %d failed with error code %d", p_ptSocket->t_iSocketFd, errno);
+        result = networkErrnoStatus(p_ptSocket, errno);
     }
 
-    // Unlock mutex after socket operation
-    mutexUnlock(&p_ptSocket->t_Mutex);
+    if (l_ptLock)
+        mutexUnlock(l_ptLock);
 
     return result;
 }
@@ -271,32 +558,415 @@ int networkReceive(NetworkSocket *p_ptSocket, void *p_pBuffer, unsigned long p_u
     if (p_ulSize == 0)
         return 0;
 
-    // Lock mutex before accessing socket
-    mutexLock(&p_ptSocket->t_Mutex);
+    // Lock according to the socket mode before accessing it
+    xOsMutexCtx *l_ptLock = networkReceiveLock(p_ptSocket);
+    if (l_ptLock)
+        mutexLock(l_ptLock);
 
-    X_LOG_TRACE("networkReceive: Receiving on socket %d, buffer size %lu",
-                p_ptSocket->t_iSocketFd, p_ulSize);
+    X_TRACE_BEGIN("net.receive");
     result = recv(p_ptSocket->t_iSocketFd, p_pBuffer, p_ulSize, 0);
+    X_TRACE_END("net.receive");
+    networkCountIo(s_tNetworkMetrics.t_ptRxCalls, s_tNetworkMetrics.t_ptRxBytes, result);
     if (result < 0)
     {
-        X_LOG_TRACE("networkReceive: Receive failed with error code %d", errno);
-        result = NETWORK_ERROR;
+        X_LOG_TRACE("networkReceive: Receive on socket %d failed with error code %d", p_ptSocket->t_iSocketFd, errno);
+        result = networkErrnoStatus(p_ptSocket, errno);
     }
     else if (result == 0)
     {
-        X_LOG_TRACE("networkReceive: Receive returned 0 bytes (connection closed)");
+        X_LOG_TRACE("networkReceive: Socket %d closed by the peer", p_ptSocket->t_iSocketFd);
     }
-    else
+
+    if (l_ptLock)
+        mutexUnlock(l_ptLock);
+
+    return result;
+}
+
+//////////////////////////////////
+/// networkSendV
+//////////////////////////////////
+int networkSendV(NetworkSocket *p_ptSocket, const struct iovec *p_ptBuffers, int p_iCount)
+{
+    if (!p_ptSocket || !p_ptBuffers || p_iCount < 0 || p_iCount > IOV_MAX)
+        return NETWORK_INVALID_PARAM;
+
+    if (p_iCount == 0)
+        return 0;
+
+    // sendmsg rather than writev so a reset peer does not raise SIGPIPE
+    struct msghdr l_tMsg;
+    memset(&l_tMsg, 0, sizeof(l_tMsg));
+    l_tMsg.msg_iov = (struct iovec *)p_ptBuffers;
+    l_tMsg.msg_iovlen = (size_t)p_iCount;
+
+    xOsMutexCtx *l_ptLock = networkSendLock(p_ptSocket);
+    if (l_ptLock)
+        mutexLock(l_ptLock);
+    int result = (int)sendmsg(p_ptSocket->t_iSocketFd, &l_tMsg, MSG_NOSIGNAL);
+    networkCountIo(s_tNetworkMetrics.t_ptTxCalls, s_tNetworkMetrics.t_ptTxBytes, result);
+    if (result < 0)
+    {
+        X_LOG_TRACE("networkSendV: Send failed with error code %d", errno);
+        result = networkErrnoStatus(p_ptSocket, errno);
+    }
+    if (l_ptLock)
+        mutexUnlock(l_ptLock);
+
+    return result;
+}
+
+//////////////////////////////////
+/// networkReceiveV
+//////////////////////////////////
+int networkReceiveV(NetworkSocket *p_ptSocket, const struct iovec *p_ptBuffers, int p_iCount)
+{
+    if (!p_ptSocket || !p_ptBuffers || p_iCount < 0 || p_iCount > IOV_MAX)
+        return NETWORK_INVALID_PARAM;
+
+    if (p_iCount == 0)
+        return 0;
+
+    xOsMutexCtx *l_ptLock = networkReceiveLock(p_ptSocket);
+    if (l_ptLock)
+        mutexLock(l_ptLock);
+    int result = (int)readv(p_ptSocket->t_iSocketFd, p_ptBuffers, p_iCount);
+    networkCountIo(s_tNetworkMetrics.t_ptRxCalls, s_tNetworkMetrics.t_ptRxBytes, result);
+    if (result < 0)
+    {
+        X_LOG_TRACE("networkReceiveV: Receive failed with error code %d", errno);
+        result = networkErrnoStatus(p_ptSocket, errno);
+    }
+    if (l_ptLock)
+        mutexUnlock(l_ptLock);
+
+    return result;
+}
+
+//////////////////////////////////
+/// networkSendBatch
+//////////////////////////////////
+int networkSendBatch(NetworkSocket *p_ptSocket, NetworkMessage *p_ptMessages, int p_iCount)
+{
+    if (!p_ptSocket || p_ptSocket->t_iSocketFd < 0 || !p_ptMessages || p_iCount < 0)
+        return NETWORK_INVALID_PARAM;
+
+    if (p_ptSocket->t_iType != NETWORK_SOCK_UDP)
+        return NETWORK_INVALID_PARAM;
+
+    struct mmsghdr l_tHeaders[NETWORK_MSG_BATCH];
+    struct sockaddr_in l_tAddrs[NETWORK_MSG_BATCH];
+    int l_iSent = 0;
+    int l_iStatus = NETWORK_OK;
+
+    xOsMutexCtx *l_ptLock = networkSendLock(p_ptSocket);
+    if (l_ptLock)
+        mutexLock(l_ptLock);
+    while (l_iSent < p_iCount && l_iStatus == (int)NETWORK_OK)
+    {
+        // Build one chunk of headers, an invalid destination ends the chunk
+        int l_iChunk = 0;
+        while (l_iChunk < NETWORK_MSG_BATCH && l_iSent + l_iChunk < p_iCount)
+        {
+            NetworkMessage *l_ptMessage = &p_ptMessages[l_iSent + l_iChunk];
+            struct msghdr *l_ptHdr = &l_tHeaders[l_iChunk].msg_hdr;
+            memset(&l_tHeaders[l_iChunk], 0, sizeof(l_tHeaders[l_iChunk]));
+
+            if (l_ptMessage->t_pAddress)
+            {
+                if (!networkToSockaddr(l_ptMessage->t_pAddress, &l_tAddrs[l_iChunk]))
+                {
+                    l_iStatus = NETWORK_INVALID_PARAM;
+                    break;
+                }
+                l_ptHdr->msg_name = &l_tAddrs[l_iChunk];
+                l_ptHdr->msg_namelen = sizeof(l_tAddrs[l_iChunk]);
+            }
+            l_ptHdr->msg_iov = l_ptMessage->t_ptBuffers;
+            l_ptHdr->msg_iovlen = (size_t)l_ptMessage->t_iBufferCount;
+            l_iChunk++;
+        }
+
+        if (l_iChunk == 0)
+            break;
+
+        int l_iDone = sendmmsg(p_ptSocket->t_iSocketFd, l_tHeaders, (unsigned int)l_iChunk, MSG_NOSIGNAL);
+        xMetricsInc(s_tNetworkMetrics.t_ptTxCalls);
+        if (l_iDone < 0)
+        {
+            X_LOG_TRACE("networkSendBatch: sendmmsg failed with error code %d", errno);
+            l_iStatus = networkErrnoStatus(p_ptSocket, errno);
+            break;
+        }
+
+        for (int i = 0; i < l_iDone; i++)
+        {
+            p_ptMessages[l_iSent + i].t_iResult = (int)l_tHeaders[i].msg_len;
+            xMetricsAdd(s_tNetworkMetrics.t_ptTxBytes, l_tHeaders[i].msg_len);
+        }
+        l_iSent += l_iDone;
+
+        // A short count is followed by an errno on the next call, which reports it
+    }
+    if (l_ptLock)
+        mutexUnlock(l_ptLock);
+
+    for (int i = l_iSent; i < p_iCount; i++)
+    {
+        p_ptMessages[i].t_iResult = l_iStatus;
+    }
+
+    return (l_iSent > 0 || p_iCount == 0) ? l_iSent : l_iStatus;
+}
+
+//////////////////////////////////
+/// networkReceiveBatch
+//////////////////////////////////
+int networkReceiveBatch(NetworkSocket *p_ptSocket, NetworkMessage *p_ptMessages, int p_iCount)
+{
+    if (!p_ptSocket || p_ptSocket->t_iSocketFd < 0 || !p_ptMessages || p_iCount < 0)
+        return NETWORK_INVALID_PARAM;
+
+    if (p_ptSocket->t_iType != NETWORK_SOCK_UDP)
+        return NETWORK_INVALID_PARAM;
+
+    if (p_iCount == 0)
+        return 0;
+
+    struct mmsghdr l_tHeaders[NETWORK_MSG_BATCH];
+    struct sockaddr_in l_tAddrs[NETWORK_MSG_BATCH];
+    int l_iChunk = (p_iCount < NETWORK_MSG_BATCH) ? p_iCount : NETWORK_MSG_BATCH;
+
+    memset(l_tHeaders, 0, sizeof(struct mmsghdr) * (size_t)l_iChunk);
+    for (int i = 0; i < l_iChunk; i++)
+    {
+        l_tHeaders[i].msg_hdr.msg_name = &l_tAddrs[i];
+        l_tHeaders[i].msg_hdr.msg_namelen = sizeof(l_tAddrs[i]);
+        l_tHeaders[i].msg_hdr.msg_iov = p_ptMessages[i].t_ptBuffers;
+        l_tHeaders[i].msg_hdr.msg_iovlen = (size_t)p_ptMessages[i].t_iBufferCount;
+    }
+
+    // MSG_WAITFORONE: block for the first datagram only, then drain the queue
+    xOsMutexCtx *l_ptLock = networkReceiveLock(p_ptSocket);
+    if (l_ptLock)
+        mutexLock(l_ptLock);
+    int l_iReceived = recvmmsg(p_ptSocket->t_iSocketFd, l_tHeaders, (unsigned int)l_iChunk, MSG_WAITFORONE, NULL);
+    int l_iErrno = errno;
+    if (l_ptLock)
+        mutexUnlock(l_ptLock);
+    xMetricsInc(s_tNetworkMetrics.t_ptRxCalls);
+
+    if (l_iReceived < 0)
+    {
+        X_LOG_TRACE("networkReceiveBatch: recvmmsg failed with error code %d", l_iErrno);
+        return networkErrnoStatus(p_ptSocket, l_iErrno);
+    }
+
+    for (int i = 0; i < p_iCount; i++)
+    {
+        NetworkMessage *l_ptMessage = &p_ptMessages[i];
+        if (i >= l_iReceived)
+        {
+            l_ptMessage->t_iResult = 0;
+            l_ptMessage->t_bTruncated = false;
+            continue;
+        }
+
+        l_ptMessage->t_iResult = (int)l_tHeaders[i].msg_len;
+        xMetricsAdd(s_tNetworkMetrics.t_ptRxBytes, l_tHeaders[i].msg_len);
+        l_ptMessage->t_bTruncated = (l_tHeaders[i].msg_hdr.msg_flags & MSG_TRUNC) != 0;
+        if (l_ptMessage->t_pAddress)
+            networkFromSockaddr(&l_tAddrs[i], l_ptMessage->t_pAddress);
+    }
+
+    return l_iReceived;
+}
+
+//////////////////////////////////
+/// networkSendFile
+//////////////////////////////////
+int networkSendFile(NetworkSocket *p_ptSocket, int p_iFileFd, off_t *p_plOffset, unsigned long p_ulSize)
+{
+    if (!p_ptSocket || p_ptSocket->t_iSocketFd < 0 || p_iFileFd < 0)
+        return NETWORK_INVALID_PARAM;
+
+    if (p_ptSocket->t_iType != NETWORK_SOCK_TCP)
+        return NETWORK_INVALID_PARAM;
+
+    unsigned long l_ulWant = (p_ulSize > NETWORK_SENDFILE_MAX) ? NETWORK_SENDFILE_MAX : p_ulSize;
+    unsigned long l_ulSent = 0;
+    int l_iStatus = NETWORK_OK;
+    bool l_bSplice = false;
+
+    xOsMutexCtx *l_ptLock = networkSendLock(p_ptSocket);
+    if (l_ptLock)
+        mutexLock(l_ptLock);
+
+    while (l_ulSent < l_ulWant)
     {
-        X_LOG_TRACE("networkReceive: Receive successful, received %d bytes", result);
+        ssize_t l_lDone;
+        if (!l_bSplice)
+        {
+            l_lDone = sendfile(p_ptSocket->t_iSocketFd, p_iFileFd, p_plOffset, l_ulWant - l_ulSent);
+
+            // sendfile needs a mappable source, pipes go through splice
+            if (l_lDone < 0 && errno == EINVAL && !p_plOffset && l_ulSent == 0)
+            {
+                l_bSplice = true;
+                continue;
+            }
+        }
+        else
+        {
+            l_lDone = splice(p_iFileFd, NULL, p_ptSocket->t_iSocketFd, NULL, l_ulWant - l_ulSent, SPLICE_F_MORE);
+        }
+        networkCountIo(s_tNetworkMetrics.t_ptTxCalls, s_tNetworkMetrics.t_ptTxBytes, (long)l_lDone);
+
+        if (l_lDone < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            X_LOG_TRACE("networkSendFile: Send on socket %d failed with error code %d", p_ptSocket->t_iSocketFd, errno);
+            l_iStatus = networkErrnoStatus(p_ptSocket, errno);
+            break;
+        }
+        if (l_lDone == 0)
+            break; // End of file
+
+        l_ulSent += (unsigned long)l_lDone;
+
+        // Non-blocking: hand control back once the socket buffer is full
+        if (p_ptSocket->t_bNonBlocking)
+            break;
     }
 
-    // Unlock mutex after socket operation
-    mutexUnlock(&p_ptSocket->t_Mutex);
+    if (l_ptLock)
+        mutexUnlock(l_ptLock);
+
+    return (l_ulSent > 0 || l_iStatus == (int)NETWORK_OK) ? (int)l_ulSent : l_iStatus;
+}
+
+//////////////////////////////////
+/// networkSetZeroCopy
+//////////////////////////////////
+int networkSetZeroCopy(NetworkSocket *p_ptSocket, bool p_bEnable)
+{
+    if (!p_ptSocket || p_ptSocket->t_iSocketFd < 0)
+        return NETWORK_INVALID_PARAM;
+
+    if (p_ptSocket->t_iType != NETWORK_SOCK_TCP)
+        return NETWORK_INVALID_PARAM;
+
+    int l_iOption = p_bEnable ? 1 : 0;
+    if (setsockopt(p_ptSocket->t_iSocketFd, SOL_SOCKET, SO_ZEROCOPY, &l_iOption, sizeof(l_iOption)) < 0)
+    {
+        X_LOG_TRACE("networkSetZeroCopy: SO_ZEROCOPY failed with error code %d", errno);
+        return NETWORK_ERROR;
+    }
+
+    p_ptSocket->t_bZeroCopy = p_bEnable;
+    return NETWORK_OK;
+}
+
+//////////////////////////////////
+/// networkSendZeroCopy
+//////////////////////////////////
+int networkSendZeroCopy(NetworkSocket *p_ptSocket, const void *p_pBuffer, unsigned long p_ulSize, uint32_t *p_pulId)
+{
+    if (!p_ptSocket || !p_pBuffer || !p_pulId)
+        return NETWORK_INVALID_PARAM;
+
+    // Copied sends carry an id that is already complete
+    *p_pulId = p_ptSocket->t_ulZeroCopyDone - 1;
+    if (!p_ptSocket->t_bZeroCopy || p_ulSize < NETWORK_ZEROCOPY_MIN_SIZE)
+        return networkSend(p_ptSocket, p_pBuffer, p_ulSize);
+
+    xOsMutexCtx *l_ptLock = networkSendLock(p_ptSocket);
+    if (l_ptLock)
+        mutexLock(l_ptLock);
+
+    int result = (int)send(p_ptSocket->t_iSocketFd, p_pBuffer, p_ulSize, MSG_NOSIGNAL | MSG_ZEROCOPY);
+    if (result >= 0)
+    {
+        // The kernel numbers every successful MSG_ZEROCOPY call, partial ones included
+        *p_pulId = p_ptSocket->t_ulZeroCopyNext++;
+    }
+    else if (errno == ENOBUFS)
+    {
+        // Out of pinned-page budget (optmem), fall back to a copy
+        result = (int)send(p_ptSocket->t_iSocketFd, p_pBuffer, p_ulSize, MSG_NOSIGNAL);
+    }
+    networkCountIo(s_tNetworkMetrics.t_ptTxCalls, s_tNetworkMetrics.t_ptTxBytes, result);
+
+    if (result < 0)
+    {
+        X_LOG_TRACE("networkSendZeroCopy: Send on socket %d failed with error code %d", p_ptSocket->t_iSocketFd, errno);
+        result = networkErrnoStatus(p_ptSocket, errno);
+    }
+
+    if (l_ptLock)
+        mutexUnlock(l_ptLock);
 
     return result;
 }
 
+//////////////////////////////////
+/// networkZeroCopyReap
+//////////////////////////////////
+int networkZeroCopyReap(NetworkSocket *p_ptSocket)
+{
+    if (!p_ptSocket || p_ptSocket->t_iSocketFd < 0)
+        return NETWORK_INVALID_PARAM;
+
+    int l_iCount = 0;
+    for (;;)
+    {
+        char l_cControl[CMSG_SPACE(sizeof(struct sock_extended_err))];
+        struct msghdr l_tMsg;
+        memset(&l_tMsg, 0, sizeof(l_tMsg));
+        l_tMsg.msg_control = l_cControl;
+        l_tMsg.msg_controllen = sizeof(l_cControl);
+
+        if (recvmsg(p_ptSocket->t_iSocketFd, &l_tMsg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0)
+        {
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                break;
+            return NETWORK_ERROR;
+        }
+
+        for (struct cmsghdr *l_ptCmsg = CMSG_FIRSTHDR(&l_tMsg); l_ptCmsg; l_ptCmsg = CMSG_NXTHDR(&l_tMsg, l_ptCmsg))
+        {
+            if (!((l_ptCmsg->cmsg_level == SOL_IP && l_ptCmsg->cmsg_type == IP_RECVERR) ||
+                  (l_ptCmsg->cmsg_level == SOL_IPV6 && l_ptCmsg->cmsg_type == IPV6_RECVERR)))
+                continue;
+
+            const struct sock_extended_err *l_ptErr = (const struct sock_extended_err *)CMSG_DATA(l_ptCmsg);
+            if (l_ptErr->ee_errno != 0 || l_ptErr->ee_origin != SO_EE_ORIGIN_ZEROCOPY)
+                continue;
+
+            // [ee_info, ee_data] is the range of completed ids, reported in order on TCP
+            if ((int32_t)(l_ptErr->ee_data + 1 - p_ptSocket->t_ulZeroCopyDone) > 0)
+                p_ptSocket->t_ulZeroCopyDone = l_ptErr->ee_data + 1;
+            if (l_ptErr->ee_code & SO_EE_CODE_ZEROCOPY_COPIED)
+                p_ptSocket->t_bZeroCopyCopied = true;
+            l_iCount++;
+        }
+    }
+
+    return l_iCount;
+}
+
+//////////////////////////////////
+/// networkZeroCopyIsDone
+//////////////////////////////////
+bool networkZeroCopyIsDone(const NetworkSocket *p_ptSocket, uint32_t p_ulId)
+{
+    if (!p_ptSocket)
+        return false;
+
+    return (int32_t)(p_ptSocket->t_ulZeroCopyDone - p_ulId) > 0;
+}
+
 //////////////////////////////////
 /// networkCloseSocket
 //////////////////////////////////
@@ -313,13 +983,30 @@ int networkCloseSocket(NetworkSocket *p_ptSocket)
     }
 
     p_ptSocket->t_bConnected = false;
+    networkFrameRelease(p_ptSocket);
 
     // Destroy mutex before freeing socket
     mutexDestroy(&p_ptSocket->t_Mutex);
+    mutexDestroy(&p_ptSocket->t_SendMutex);
 
-    // Free the socket structure
-    free(p_ptSocket);
+    // Return the socket structure to the pool
+    networkFreeSocket(p_ptSocket);
+
+    return NETWORK_OK;
+}
+
+//////////////////////////////////
+/// networkSetLockMode
+//////////////////////////////////
+int networkSetLockMode(NetworkSocket *p_ptSocket, int p_iMode)
+{
+    if (!p_ptSocket)
+        return NETWORK_INVALID_PARAM;
+
+    if (p_iMode != NETWORK_LOCK_SHARED && p_iMode != NETWORK_LOCK_DUPLEX && p_iMode != NETWORK_LOCK_NONE)
+        return NETWORK_INVALID_PARAM;
 
+    p_ptSocket->t_iLockMode = p_iMode;
     return NETWORK_OK;
 }
 
@@ -396,6 +1083,12 @@ const char *networkGetErrorString(int p_iError)
         return "Operation timed out";
     case NETWORK_INVALID_PARAM:
         return "Invalid parameter";
+    case NETWORK_WOULD_BLOCK:
+        return "Operation would block";
+    case NETWORK_IN_PROGRESS:
+        return "Connection in progress";
+    case NETWORK_CLOSED:
+        return "Connection closed by peer";
     default:
         return "Unknown error";
     }
@@ -24,6 +24,8 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <sys/uio.h>
 
 #include "xAssert.h"
 #include "xOsMutex.h"
@@ -34,12 +36,23 @@
 #define NETWORK_BUFFER_SIZE 512       // Default buffer size for operations
 #define NETWORK_MAX_PENDING 5         // Default pending connections queue
 #define NETWORK_DEFAULT_TIMEOUT 30000 // Default timeout in milliseconds (30 seconds)
+#define NETWORK_ACCEPT_BATCH 32       // Connections accepted by one networkAcceptBatch call at most
+#define NETWORK_MSG_BATCH 64          // Datagrams handed to one sendmmsg/recvmmsg call
+#define NETWORK_ZEROCOPY_MIN_SIZE (16 * 1024) // Below this size MSG_ZEROCOPY costs more than the copy
 
 // Network error codes
 #define NETWORK_OK 0xD17A2B40
 #define NETWORK_ERROR 0xD17A2B41
 #define NETWORK_TIMEOUT 0xD17A2B42
 #define NETWORK_INVALID_PARAM 0xD17A2B43
+#define NETWORK_WOULD_BLOCK 0xD17A2B44   // Non-blocking socket not ready, retry when the loop reports it
+#define NETWORK_IN_PROGRESS 0xD17A2B45   // Non-blocking connect started, completes when writable
+#define NETWORK_CLOSED 0xD17A2B46        // Peer closed the connection (framed messages)
+
+// Socket locking modes, see networkSetLockMode
+#define NETWORK_LOCK_SHARED 0 // One mutex serializes every operation (default)
+#define NETWORK_LOCK_DUPLEX 1 // Separate send and receive mutexes, one sender and one receiver run together
+#define NETWORK_LOCK_NONE   2 // Single owner, no locking on the data path
 
 // Byte order conversion macros
 #define HOST_TO_NET_LONG(p_uiValue) htonl(p_uiValue)
@@ -47,13 +60,25 @@
 #define NET_TO_HOST_LONG(p_uiValue) ntohl(p_uiValue)
 #define NET_TO_HOST_SHORT(p_usValue) ntohs(p_usValue)
 
+// Framed message receive buffer, see xNetworkFrame.h
+struct xos_network_frame_buffer_t;
+
 // Socket type definition
 typedef struct
 {
     int t_iSocketFd;     // Socket file descriptor
     int t_iType;         // Socket type (TCP/UDP)
     bool t_bConnected;   // Connection state
-    xOsMutexCtx t_Mutex; // Mutex for thread safety
+    bool t_bNonBlocking; // Non-blocking mode, operations return NETWORK_WOULD_BLOCK
+    bool t_bConnecting;  // Non-blocking connect in progress
+    int t_iLockMode;     // NETWORK_LOCK_* mode of the data path
+    bool t_bZeroCopy;    // SO_ZEROCOPY enabled, see networkSendZeroCopy
+    bool t_bZeroCopyCopied; // The kernel reported a copied (not zero-copy) completion
+    uint32_t t_ulZeroCopyNext; // Id of the next MSG_ZEROCOPY send
+    uint32_t t_ulZeroCopyDone; // Sends with an id below this value are complete
+    struct xos_network_frame_buffer_t *t_ptFrameBuffer; // Framed receive buffer, allocated on first use
+    xOsMutexCtx t_Mutex; // Mutex for thread safety (receive side in duplex mode)
+    xOsMutexCtx t_SendMutex; // Send side mutex in duplex mode
 } NetworkSocket;
 
 // Network address structure (IPv4 only)
@@ -63,6 +88,16 @@ typedef struct
     unsigned short t_usPort;
 } NetworkAddress;
 
+// Datagram of a batch, with its buffers and per-message result
+typedef struct
+{
+    struct iovec *t_ptBuffers;  // Scatter/gather buffers of the datagram
+    int t_iBufferCount;         // Number of buffers
+    NetworkAddress *t_pAddress; // Send: destination (NULL on a connected socket), receive: source (may be NULL)
+    int t_iResult;              // Filled by the call: bytes transferred or error code
+    bool t_bTruncated;          // Receive: datagram larger than the buffers, the end was dropped
+} NetworkMessage;
+
 // Available socket types
 #define NETWORK_SOCK_TCP SOCK_STREAM
 #define NETWORK_SOCK_UDP SOCK_DGRAM
@@ -107,23 +142,55 @@ int networkListen(NetworkSocket *p_ptSocket, int p_iBacklog);
 /// @param p_ptSocket Listening socket
 /// @param p_pClientAddress Address to store client info (can be NULL)
 /// @return NetworkSocket* New socket handle or NULL on error
+/// @note on a non-blocking listener, returns NULL with errno EAGAIN when no
+///       connection is pending and the new socket is non-blocking too
 //////////////////////////////////
 NetworkSocket *networkAccept(NetworkSocket *p_ptSocket, NetworkAddress *p_pClientAddress);
 
+//////////////////////////////////
+/// @brief Accept every pending connection, up to a maximum
+/// @param p_ptSocket Non-blocking listening socket
+/// @param p_ptClients Array receiving the new socket handles
+/// @param p_pClientAddresses Array receiving the client addresses (can be NULL)
+/// @param p_iMax Array size
+/// @return int Number of accepted connections or error code
+/// @note meant for the read callback of a listener registered on xNetworkLoop,
+///       call it again while it returns p_iMax
+//////////////////////////////////
+int networkAcceptBatch(NetworkSocket *p_ptSocket, NetworkSocket **p_ptClients, NetworkAddress *p_pClientAddresses, int p_iMax);
+
 //////////////////////////////////
 /// @brief Connect to remote server
 /// @param p_ptSocket Socket handle
 /// @param p_pAddress Remote address
-/// @return int Error code
+/// @return int Error code, NETWORK_IN_PROGRESS for a non-blocking socket
+///         still connecting (see networkConnectComplete)
 //////////////////////////////////
 int networkConnect(NetworkSocket *p_ptSocket, const NetworkAddress *p_pAddress);
 
+//////////////////////////////////
+/// @brief Get the result of a non-blocking connect
+/// @param p_ptSocket Socket handle
+/// @return int NETWORK_OK once connected, NETWORK_IN_PROGRESS or error code
+/// @note call it when the socket becomes writable
+//////////////////////////////////
+int networkConnectComplete(NetworkSocket *p_ptSocket);
+
+//////////////////////////////////
+/// @brief Switch the socket between blocking and non-blocking mode
+/// @param p_ptSocket Socket handle
+/// @param p_bNonBlocking True for non-blocking mode
+/// @return int Error code
+//////////////////////////////////
+int networkSetNonBlocking(NetworkSocket *p_ptSocket, bool p_bNonBlocking);
+
 //////////////////////////////////
 /// @brief Send data
 /// @param p_ptSocket Socket handle
 /// @param p_pBuffer Data buffer
 /// @param p_ulSize Data size
-/// @return int Bytes sent or error code
+/// @return int Bytes sent or error code (NETWORK_WOULD_BLOCK in non-blocking mode,
+///         NETWORK_TIMEOUT when the send timeout expires)
 //////////////////////////////////
 int networkSend(NetworkSocket *p_ptSocket, const void *p_pBuffer, unsigned long p_ulSize);
 
@@ -132,10 +199,100 @@ int networkSend(NetworkSocket *p_ptSocket, const void *p_pBuffer, unsigned long
 /// @param p_ptSocket Socket handle
 /// @param p_pBuffer Data buffer
 /// @param p_ulSize Buffer size
-/// @return int Bytes received or error code
+/// @return int Bytes received, 0 when the peer closed, or error code
+///         (NETWORK_WOULD_BLOCK in non-blocking mode, NETWORK_TIMEOUT when
+///         the receive timeout expires)
 //////////////////////////////////
 int networkReceive(NetworkSocket *p_ptSocket, void *p_pBuffer, unsigned long p_ulSize);
 
+//////////////////////////////////
+/// @brief Send data gathered from several buffers in one call
+/// @param p_ptSocket Connected socket handle
+/// @param p_ptBuffers Buffers, sent in order
+/// @param p_iCount Number of buffers (at most IOV_MAX)
+/// @return int Bytes sent or error code, as networkSend
+//////////////////////////////////
+int networkSendV(NetworkSocket *p_ptSocket, const struct iovec *p_ptBuffers, int p_iCount);
+
+//////////////////////////////////
+/// @brief Receive data scattered into several buffers in one call
+/// @param p_ptSocket Connected socket handle
+/// @param p_ptBuffers Buffers, filled in order
+/// @param p_iCount Number of buffers (at most IOV_MAX)
+/// @return int Bytes received, 0 when the peer closed, or error code, as networkReceive
+//////////////////////////////////
+int networkReceiveV(NetworkSocket *p_ptSocket, const struct iovec *p_ptBuffers, int p_iCount);
+
+//////////////////////////////////
+/// @brief Send several datagrams with as few system calls as possible
+/// @param p_ptSocket UDP socket handle
+/// @param p_ptMessages Datagrams, t_iResult is set for each of them
+/// @param p_iCount Number of datagrams
+/// @return int Number of datagrams sent or error code when none was sent
+/// @note sending stops at the first failure, the failed datagram and the
+///       following ones get the error code in t_iResult
+//////////////////////////////////
+int networkSendBatch(NetworkSocket *p_ptSocket, NetworkMessage *p_ptMessages, int p_iCount);
+
+//////////////////////////////////
+/// @brief Receive several datagrams with one system call
+/// @param p_ptSocket UDP socket handle
+/// @param p_ptMessages Datagram slots, t_iResult is set for each of them
+/// @param p_iCount Number of slots (at most NETWORK_MSG_BATCH are filled)
+/// @return int Number of datagrams received or error code
+/// @note waits (blocking mode) for the first datagram only, then takes what
+///       is already queued; unfilled slots get t_iResult 0
+//////////////////////////////////
+int networkReceiveBatch(NetworkSocket *p_ptSocket, NetworkMessage *p_ptMessages, int p_iCount);
+
+//////////////////////////////////
+/// @brief Send a file region without copying it through user space
+/// @param p_ptSocket Connected TCP socket handle
+/// @param p_iFileFd Source descriptor (regular file, or pipe with a NULL offset)
+/// @param p_plOffset File offset, advanced by the bytes sent (NULL to use and move the file position)
+/// @param p_ulSize Bytes to send
+/// @return int Bytes sent or error code, as networkSend
+/// @note sendfile for files, splice for pipes; a blocking socket sends up to
+///       1 GiB per call, a non-blocking one what the socket buffer accepts
+//////////////////////////////////
+int networkSendFile(NetworkSocket *p_ptSocket, int p_iFileFd, off_t *p_plOffset, unsigned long p_ulSize);
+
+//////////////////////////////////
+/// @brief Enable or disable MSG_ZEROCOPY sends on a TCP socket
+/// @param p_ptSocket Socket handle
+/// @param p_bEnable true to enable
+/// @return int Error code (NETWORK_ERROR when the kernel has no SO_ZEROCOPY)
+//////////////////////////////////
+int networkSetZeroCopy(NetworkSocket *p_ptSocket, bool p_bEnable);
+
+//////////////////////////////////
+/// @brief Send a large buffer with MSG_ZEROCOPY
+/// @param p_ptSocket Socket with zero-copy enabled
+/// @param p_pBuffer Data buffer, must stay unchanged until the send is complete
+/// @param p_ulSize Data size
+/// @param p_pulId Filled with the send id, to pass to networkZeroCopyIsDone
+/// @return int Bytes sent or error code, as networkSend
+/// @note buffers below NETWORK_ZEROCOPY_MIN_SIZE, or refused for lack of
+///       socket memory, are copied and complete at once
+//////////////////////////////////
+int networkSendZeroCopy(NetworkSocket *p_ptSocket, const void *p_pBuffer, unsigned long p_ulSize, uint32_t *p_pulId);
+
+//////////////////////////////////
+/// @brief Read the zero-copy completions queued on the socket error queue
+/// @param p_ptSocket Socket with zero-copy enabled
+/// @return int Number of notifications read or error code
+/// @note never blocks; POLLERR signals pending notifications
+//////////////////////////////////
+int networkZeroCopyReap(NetworkSocket *p_ptSocket);
+
+//////////////////////////////////
+/// @brief Tell whether a zero-copy send is complete and its buffer reusable
+/// @param p_ptSocket Socket with zero-copy enabled
+/// @param p_ulId Send id from networkSendZeroCopy
+/// @return bool true when complete (as of the last networkZeroCopyReap)
+//////////////////////////////////
+bool networkZeroCopyIsDone(const NetworkSocket *p_ptSocket, uint32_t p_ulId);
+
 //////////////////////////////////
 /// @brief Close socket
 /// @param p_ptSocket Socket handle
@@ -143,6 +300,15 @@ int networkReceive(NetworkSocket *p_ptSocket, void *p_pBuffer, unsigned long p_u
 //////////////////////////////////
 int networkCloseSocket(NetworkSocket *p_ptSocket);
 
+//////////////////////////////////
+/// @brief Select how the data path functions lock the socket
+/// @param p_ptSocket Socket handle
+/// @param p_iMode NETWORK_LOCK_SHARED, NETWORK_LOCK_DUPLEX or NETWORK_LOCK_NONE
+/// @return int Error code
+/// @note must be called before the socket is used by several threads
+//////////////////////////////////
+int networkSetLockMode(NetworkSocket *p_ptSocket, int p_iMode);
+
 //////////////////////////////////
 /// @brief Set socket timeout for send or receive operations
 /// @param p_ptSocket Socket handle
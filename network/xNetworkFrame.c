@@ -0,0 +1,258 @@
+////////////////////////////////////////////////////////////
+//  Network framing implementation file
+//  Implements the framed messages defined in xNetworkFrame.h
+//
+// The receive buffer holds [t_ulRead, t_ulWrite) unread bytes. Frames
+// are handed out in place, so a partial frame at the end is moved to
+// the front only when the space after it runs out, and the buffer is
+// doubled only for a frame larger than it
+//
+// general disclosure: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+
+#include "xNetworkFrame.h"
+#include "xMemory.h"
+#include <poll.h>
+
+// Receive buffer of one socket
+typedef struct xos_network_frame_buffer_t
+{
+    uint8_t *t_pucData;         // Buffer
+    size_t t_ulCapacity;        // Buffer size
+    size_t t_ulRead;            // First unread byte
+    size_t t_ulWrite;           // End of the received bytes
+    size_t t_ulConsume;         // Bytes of the frame handed out by the last call
+} xNetworkFrameBuffer_t;
+
+//////////////////////////////////
+/// networkFrameDecodeHeader
+//////////////////////////////////
+static int networkFrameDecodeHeader(const uint8_t *p_pucData, size_t p_ulAvailable, uint32_t *p_pulSize)
+{
+    uint32_t l_ulValue = 0;
+    for (size_t i = 0; i < NETWORK_FRAME_HEADER_MAX; i++)
+    {
+        if (i == p_ulAvailable)
+            return 0; // Incomplete header
+
+        // The last byte carries bits 28 to 31 only and ends the varint
+        if (i == NETWORK_FRAME_HEADER_MAX - 1 && (p_pucData[i] & 0xF0) != 0)
+            return -1;
+
+        l_ulValue |= (uint32_t)(p_pucData[i] & 0x7F) << (7 * i);
+        if ((p_pucData[i] & 0x80) == 0)
+        {
+            if (l_ulValue > NETWORK_FRAME_MAX_SIZE)
+                return -1;
+            *p_pulSize = l_ulValue;
+            return (int)i + 1;
+        }
+    }
+
+    return -1; // Not reached, the last byte is checked above
+}
+
+//////////////////////////////////
+/// networkFrameWaitWritable
+//////////////////////////////////
+static void networkFrameWaitWritable(const NetworkSocket *p_ptSocket)
+{
+    struct pollfd l_tPoll = {.fd = p_ptSocket->t_iSocketFd, .events = POLLOUT, .revents = 0};
+    poll(&l_tPoll, 1, -1);
+}
+
+//////////////////////////////////
+/// networkFrameSendAll
+//////////////////////////////////
+static int networkFrameSendAll(NetworkSocket *p_ptSocket, struct iovec *p_ptBuffers, int p_iCount)
+{
+    int l_iFirst = 0;
+    while (l_iFirst < p_iCount)
+    {
+#ifdef USE_TLS
+        // The TLS engine has no gather write, the cork set by networkSendMessage joins the buffers
+        int l_iSent = networkSend(p_ptSocket, p_ptBuffers[l_iFirst].iov_base, (unsigned long)p_ptBuffers[l_iFirst].iov_len);
+#else
+        int l_iSent = networkSendV(p_ptSocket, &p_ptBuffers[l_iFirst], p_iCount - l_iFirst);
+#endif
+        if (l_iSent == (int)NETWORK_WOULD_BLOCK)
+        {
+            networkFrameWaitWritable(p_ptSocket);
+            continue;
+        }
+        if (l_iSent < 0)
+            return l_iSent;
+
+        // Skip what was sent, a partial write resumes inside a buffer
+        size_t l_ulLeft = (size_t)l_iSent;
+        while (l_iFirst < p_iCount && l_ulLeft >= p_ptBuffers[l_iFirst].iov_len)
+        {
+            l_ulLeft -= p_ptBuffers[l_iFirst].iov_len;
+            l_iFirst++;
+        }
+        if (l_iFirst < p_iCount)
+        {
+            p_ptBuffers[l_iFirst].iov_base = (uint8_t *)p_ptBuffers[l_iFirst].iov_base + l_ulLeft;
+            p_ptBuffers[l_iFirst].iov_len -= l_ulLeft;
+        }
+    }
+
+    return NETWORK_OK;
+}
+
+//////////////////////////////////
+/// networkSendMessage
+//////////////////////////////////
+int networkSendMessage(NetworkSocket *p_ptSocket, const void *p_pData, uint32_t p_ulSize)
+{
+    if (!p_ptSocket || p_ptSocket->t_iSocketFd < 0 || (!p_pData && p_ulSize > 0))
+        return NETWORK_INVALID_PARAM;
+
+    if (p_ulSize > NETWORK_FRAME_MAX_SIZE)
+        return NETWORK_INVALID_PARAM;
+
+    uint8_t l_ucHeader[NETWORK_FRAME_HEADER_MAX];
+    size_t l_ulHeaderSize = 0;
+    uint32_t l_ulValue = p_ulSize;
+    do
+    {
+        uint8_t l_ucByte = (uint8_t)(l_ulValue & 0x7F);
+        l_ulValue >>= 7;
+        l_ucHeader[l_ulHeaderSize++] = l_ucByte | (l_ulValue ? 0x80 : 0);
+    } while (l_ulValue);
+
+    // Header and payload leave in one call, the payload is not copied
+    struct iovec l_tBuffers[2] = {
+        {.iov_base = l_ucHeader, .iov_len = l_ulHeaderSize},
+        {.iov_base = (void *)p_pData, .iov_len = p_ulSize},
+    };
+
+#ifdef USE_TLS
+    // Header and payload share a record, unless the caller corks already
+    bool l_bCork = !((TLS_Engine *)p_ptSocket->t_pTlsEngine)->t_bCorked;
+    if (l_bCork && networkSetCork(p_ptSocket, true) != (int)NETWORK_OK)
+        return NETWORK_TLS_ERROR;
+
+    int l_iResult = networkFrameSendAll(p_ptSocket, l_tBuffers, p_ulSize > 0 ? 2 : 1);
+    if (l_bCork && networkSetCork(p_ptSocket, false) != (int)NETWORK_OK && l_iResult == (int)NETWORK_OK)
+        l_iResult = NETWORK_TLS_ERROR;
+    return l_iResult;
+#else
+    return networkFrameSendAll(p_ptSocket, l_tBuffers, p_ulSize > 0 ? 2 : 1);
+#endif
+}
+
+//////////////////////////////////
+/// networkFrameReserve
+//////////////////////////////////
+static int networkFrameReserve(xNetworkFrameBuffer_t *p_ptBuffer, size_t p_ulNeeded)
+{
+    // Room after the unread bytes is enough
+    if (p_ptBuffer->t_ulCapacity - p_ptBuffer->t_ulRead >= p_ulNeeded && p_ptBuffer->t_ulWrite < p_ptBuffer->t_ulCapacity)
+        return NETWORK_OK;
+
+    // Move the partial frame to the front
+    size_t l_ulUnread = p_ptBuffer->t_ulWrite - p_ptBuffer->t_ulRead;
+    if (p_ptBuffer->t_ulRead > 0)
+    {
+        memmove(p_ptBuffer->t_pucData, p_ptBuffer->t_pucData + p_ptBuffer->t_ulRead, l_ulUnread);
+        p_ptBuffer->t_ulRead = 0;
+        p_ptBuffer->t_ulWrite = l_ulUnread;
+    }
+
+    if (p_ptBuffer->t_ulCapacity >= p_ulNeeded && p_ptBuffer->t_ulWrite < p_ptBuffer->t_ulCapacity)
+        return NETWORK_OK;
+
+    size_t l_ulCapacity = p_ptBuffer->t_ulCapacity ? p_ptBuffer->t_ulCapacity : NETWORK_FRAME_INITIAL_BUFFER;
+    while (l_ulCapacity < p_ulNeeded)
+        l_ulCapacity *= 2;
+
+    uint8_t *l_pucData = (uint8_t *)X_REALLOC(p_ptBuffer->t_pucData, l_ulCapacity);
+    if (!l_pucData)
+        return NETWORK_ERROR;
+
+    p_ptBuffer->t_pucData = l_pucData;
+    p_ptBuffer->t_ulCapacity = l_ulCapacity;
+    return NETWORK_OK;
+}
+
+//////////////////////////////////
+/// networkReceiveMessage
+//////////////////////////////////
+int networkReceiveMessage(NetworkSocket *p_ptSocket, NetworkFrameView *p_ptView)
+{
+    if (!p_ptSocket || p_ptSocket->t_iSocketFd < 0 || !p_ptView)
+        return NETWORK_INVALID_PARAM;
+
+    xNetworkFrameBuffer_t *l_ptBuffer = p_ptSocket->t_ptFrameBuffer;
+    if (!l_ptBuffer)
+    {
+        l_ptBuffer = (xNetworkFrameBuffer_t *)X_MALLOC(sizeof(xNetworkFrameBuffer_t));
+        if (!l_ptBuffer)
+            return NETWORK_ERROR;
+        memset(l_ptBuffer, 0, sizeof(xNetworkFrameBuffer_t));
+        p_ptSocket->t_ptFrameBuffer = l_ptBuffer;
+    }
+
+    // The previous view is released by this call
+    l_ptBuffer->t_ulRead += l_ptBuffer->t_ulConsume;
+    l_ptBuffer->t_ulConsume = 0;
+    if (l_ptBuffer->t_ulRead == l_ptBuffer->t_ulWrite)
+    {
+        l_ptBuffer->t_ulRead = 0;
+        l_ptBuffer->t_ulWrite = 0;
+    }
+
+    for (;;)
+    {
+        size_t l_ulUnread = l_ptBuffer->t_ulWrite - l_ptBuffer->t_ulRead;
+        uint32_t l_ulSize = 0;
+        int l_iHeader = networkFrameDecodeHeader(l_ptBuffer->t_pucData + l_ptBuffer->t_ulRead, l_ulUnread, &l_ulSize);
+        if (l_iHeader < 0)
+        {
+            X_LOG_TRACE("networkReceiveMessage: Invalid frame header on socket %d", p_ptSocket->t_iSocketFd);
+            return NETWORK_ERROR;
+        }
+
+        size_t l_ulNeeded = NETWORK_FRAME_HEADER_MAX;
+        if (l_iHeader > 0)
+        {
+            l_ulNeeded = (size_t)l_iHeader + l_ulSize;
+            if (l_ulUnread >= l_ulNeeded)
+            {
+                p_ptView->t_pucData = l_ptBuffer->t_pucData + l_ptBuffer->t_ulRead + l_iHeader;
+                p_ptView->t_ulSize = l_ulSize;
+                l_ptBuffer->t_ulConsume = l_ulNeeded;
+                return (int)l_ulSize;
+            }
+        }
+
+        if (networkFrameReserve(l_ptBuffer, l_ulNeeded) != (int)NETWORK_OK)
+            return NETWORK_ERROR;
+
+        // Read as much as the buffer takes, following frames come for free
+        int l_iReceived = networkReceive(p_ptSocket, l_ptBuffer->t_pucData + l_ptBuffer->t_ulWrite,
+                                         (unsigned long)(l_ptBuffer->t_ulCapacity - l_ptBuffer->t_ulWrite));
+        if (l_iReceived == 0)
+            return NETWORK_CLOSED;
+        if (l_iReceived < 0)
+            return l_iReceived;
+
+        l_ptBuffer->t_ulWrite += (size_t)l_iReceived;
+    }
+}
+
+//////////////////////////////////
+/// networkFrameRelease
+//////////////////////////////////
+void networkFrameRelease(NetworkSocket *p_ptSocket)
+{
+    if (!p_ptSocket || !p_ptSocket->t_ptFrameBuffer)
+        return;
+
+    if (p_ptSocket->t_ptFrameBuffer->t_pucData)
+        X_FREE(p_ptSocket->t_ptFrameBuffer->t_pucData);
+    X_FREE(p_ptSocket->t_ptFrameBuffer);
+    p_ptSocket->t_ptFrameBuffer = NULL;
+}
@@ -0,0 +1,68 @@
+////////////////////////////////////////////////////////////
+//  Network framing header file
+//  Defines length-prefixed messages on top of NetworkSocket
+//
+// A frame is an unsigned LEB128 varint payload length (1 to 4 bytes
+// for NETWORK_FRAME_MAX_SIZE) followed by the payload. Received bytes
+// are kept in a per-socket buffer and complete frames are returned as
+// views into it, without copying
+//
+// general disclosure: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+
+#ifndef NETWORK_FRAME_H_
+#define NETWORK_FRAME_H_
+
+#include <stdint.h>
+
+#ifdef USE_TLS
+#include "xNetworkTls.h"
+#else
+#include "xNetwork.h"
+#endif
+
+// Configuration constants
+#define NETWORK_FRAME_MAX_SIZE       (16 * 1024 * 1024) // Largest payload accepted, larger announces are a protocol error
+#define NETWORK_FRAME_HEADER_MAX     5                  // Bytes of the longest uint32 varint
+#define NETWORK_FRAME_INITIAL_BUFFER 4096               // First receive buffer size, doubled on demand
+
+// View on a received frame payload
+typedef struct
+{
+    const uint8_t *t_pucData;   // Payload, inside the socket receive buffer
+    uint32_t t_ulSize;          // Payload size
+} NetworkFrameView;
+
+//////////////////////////////////
+/// @brief Send one framed message
+/// @param p_ptSocket Connected TCP socket handle
+/// @param p_pData Payload (may be NULL when p_ulSize is 0)
+/// @param p_ulSize Payload size (at most NETWORK_FRAME_MAX_SIZE)
+/// @return int Error code
+/// @note the whole frame is sent, waiting for writability on a non-blocking
+///       socket; one thread at a time may send messages on a socket
+//////////////////////////////////
+int networkSendMessage(NetworkSocket *p_ptSocket, const void *p_pData, uint32_t p_ulSize);
+
+//////////////////////////////////
+/// @brief Receive one framed message
+/// @param p_ptSocket Connected TCP socket handle
+/// @param p_ptView Filled with the payload view
+/// @return int Payload size, NETWORK_CLOSED when the peer closed, or error code
+///         (NETWORK_WOULD_BLOCK when no complete frame is buffered yet on a
+///         non-blocking socket)
+/// @note the view stays valid until the next networkReceiveMessage or
+///       networkCloseSocket call on the socket; one receive call may read
+///       several frames, the following calls return them without a syscall
+//////////////////////////////////
+int networkReceiveMessage(NetworkSocket *p_ptSocket, NetworkFrameView *p_ptView);
+
+//////////////////////////////////
+/// @brief Free the receive buffer of a socket
+/// @param p_ptSocket Socket handle
+/// @note called by networkCloseSocket
+//////////////////////////////////
+void networkFrameRelease(NetworkSocket *p_ptSocket);
+
+#endif // NETWORK_FRAME_H_
@@ -0,0 +1,746 @@
+////////////////////////////////////////////////////////////
+//  Network event loop implementation file
+//  Implements the reactor defined in xNetworkLoop.h
+//
+// general disclosure: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+
+#include "xNetworkLoop.h"
+#include "xMemory.h"
+#include <fcntl.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#define NETWORK_LOOP_HAVE_EPOLL 1
+#include <sys/epoll.h>
+#endif
+
+#ifndef POLLRDHUP
+#define POLLRDHUP 0
+#endif
+
+// Registration record of one socket
+typedef struct networkLoopHandler_t
+{
+    NetworkSocket *t_ptSocket;                  // Registered socket
+    int t_iFd;                                  // Descriptor at registration time
+    uint32_t t_ulEvents;                        // NETWORK_LOOP_EVENT_* combination
+    bool t_bRemoved;                            // Unregistered, waiting to be freed
+    size_t t_ulPollIndex;                       // poll backend: index in t_ptPollFds
+    xNetworkLoopCallbacks_t t_tCallbacks;       // User callbacks
+    void *t_pvArg;                              // Callback argument
+    xNetworkLoopConnectCallback t_pfOnConnect;  // xNetworkLoopConnect completion
+    void *t_pvConnectArg;                       // Completion callback argument
+    struct networkLoopHandler_t *t_ptNextDeferred; // Deferred free list
+} networkLoopHandler;
+
+// Events reported to networkLoopDispatch
+#define NETWORK_LOOP_READY_CLOSE 0x100
+
+//////////////////////////////////
+/// networkLoopPollEvents
+//////////////////////////////////
+static short networkLoopPollEvents(uint32_t p_ulEvents)
+{
+    short l_sEvents = 0;
+    if (p_ulEvents & NETWORK_LOOP_EVENT_READ)
+        l_sEvents |= POLLIN;
+    if (p_ulEvents & NETWORK_LOOP_EVENT_WRITE)
+        l_sEvents |= POLLOUT;
+    return l_sEvents;
+}
+
+#ifdef NETWORK_LOOP_HAVE_EPOLL
+//////////////////////////////////
+/// networkLoopEpollEvents
+//////////////////////////////////
+static uint32_t networkLoopEpollEvents(uint32_t p_ulEvents)
+{
+    uint32_t l_ulEvents = 0;
+    if (p_ulEvents & NETWORK_LOOP_EVENT_READ)
+        l_ulEvents |= EPOLLIN;
+    if (p_ulEvents & NETWORK_LOOP_EVENT_WRITE)
+        l_ulEvents |= EPOLLOUT;
+    if (p_ulEvents & NETWORK_LOOP_EVENT_EDGE)
+        l_ulEvents |= EPOLLET;
+    return l_ulEvents;
+}
+#endif
+
+//////////////////////////////////
+/// networkLoopGrow
+//////////////////////////////////
+static int networkLoopGrow(void **p_ppvArray, size_t *p_pulCapacity, size_t p_ulNeeded, size_t p_ulElemSize)
+{
+    if (p_ulNeeded <= *p_pulCapacity)
+        return NETWORK_OK;
+
+    size_t l_ulCapacity = (*p_pulCapacity != 0) ? *p_pulCapacity : 64;
+    while (l_ulCapacity < p_ulNeeded)
+        l_ulCapacity *= 2;
+
+    void *l_pvArray = X_REALLOC(*p_ppvArray, l_ulCapacity * p_ulElemSize);
+    if (l_pvArray == NULL)
+        return NETWORK_ERROR;
+
+    memset((char *)l_pvArray + *p_pulCapacity * p_ulElemSize, 0, (l_ulCapacity - *p_pulCapacity) * p_ulElemSize);
+    *p_ppvArray = l_pvArray;
+    *p_pulCapacity = l_ulCapacity;
+    return NETWORK_OK;
+}
+
+//////////////////////////////////
+/// networkLoopFind
+//////////////////////////////////
+static networkLoopHandler *networkLoopFind(xNetworkLoop_t *p_ptLoop, NetworkSocket *p_ptSocket)
+{
+    if (!p_ptSocket || p_ptSocket->t_iSocketFd < 0 || (size_t)p_ptSocket->t_iSocketFd >= p_ptLoop->t_ulHandlerCapacity)
+        return NULL;
+
+    networkLoopHandler *l_ptHandler = (networkLoopHandler *)p_ptLoop->t_ptHandlers[p_ptSocket->t_iSocketFd];
+    return (l_ptHandler && l_ptHandler->t_ptSocket == p_ptSocket) ? l_ptHandler : NULL;
+}
+
+//////////////////////////////////
+/// networkLoopCompact
+//////////////////////////////////
+static void networkLoopCompact(xNetworkLoop_t *p_ptLoop)
+{
+    // Drop the poll entries of removed handlers
+    if (p_ptLoop->t_bUsePoll)
+    {
+        size_t l_ulOut = 1;
+        for (size_t i = 1; i < p_ptLoop->t_ulPollCount; i++)
+        {
+            networkLoopHandler *l_ptHandler = (networkLoopHandler *)p_ptLoop->t_ptPollHandlers[i];
+            if (l_ptHandler->t_bRemoved)
+                continue;
+            p_ptLoop->t_ptPollFds[l_ulOut] = p_ptLoop->t_ptPollFds[i];
+            p_ptLoop->t_ptPollHandlers[l_ulOut] = l_ptHandler;
+            l_ptHandler->t_ulPollIndex = l_ulOut++;
+        }
+        p_ptLoop->t_ulPollCount = l_ulOut;
+    }
+
+    // Release deferred handlers
+    networkLoopHandler *l_ptHandler = (networkLoopHandler *)p_ptLoop->t_ptDeferred;
+    while (l_ptHandler)
+    {
+        networkLoopHandler *l_ptNext = l_ptHandler->t_ptNextDeferred;
+        xMemPoolFree(&p_ptLoop->t_tHandlerPool, l_ptHandler);
+        l_ptHandler = l_ptNext;
+    }
+    p_ptLoop->t_ptDeferred = NULL;
+
+    // Drop removed timers
+    size_t l_ulOut = 0;
+    for (size_t i = 0; i < p_ptLoop->t_ulTimerCount; i++)
+    {
+        if (p_ptLoop->t_tTimers[i].t_ptTimer != NULL)
+            p_ptLoop->t_tTimers[l_ulOut++] = p_ptLoop->t_tTimers[i];
+    }
+    p_ptLoop->t_ulTimerCount = l_ulOut;
+}
+
+//////////////////////////////////
+/// networkLoopUnregister
+//////////////////////////////////
+static void networkLoopUnregister(xNetworkLoop_t *p_ptLoop, networkLoopHandler *p_ptHandler)
+{
+#ifdef NETWORK_LOOP_HAVE_EPOLL
+    if (!p_ptLoop->t_bUsePoll)
+        epoll_ctl(p_ptLoop->t_iEpollFd, EPOLL_CTL_DEL, p_ptHandler->t_iFd, NULL);
+#endif
+    if (p_ptLoop->t_bUsePoll)
+        p_ptLoop->t_ptPollFds[p_ptHandler->t_ulPollIndex].fd = -1;
+
+    p_ptLoop->t_ptHandlers[p_ptHandler->t_iFd] = NULL;
+    p_ptLoop->t_ulHandlerCount--;
+
+    // Events of this batch may still point to the handler
+    p_ptHandler->t_bRemoved = true;
+    p_ptHandler->t_ptNextDeferred = (networkLoopHandler *)p_ptLoop->t_ptDeferred;
+    p_ptLoop->t_ptDeferred = p_ptHandler;
+    if (!p_ptLoop->t_bDispatching)
+        networkLoopCompact(p_ptLoop);
+}
+
+//////////////////////////////////
+/// networkLoopDispatch
+//////////////////////////////////
+static void networkLoopDispatch(xNetworkLoop_t *p_ptLoop, networkLoopHandler *p_ptHandler, uint32_t p_ulReady)
+{
+    if ((p_ulReady & NETWORK_LOOP_EVENT_READ) && p_ptHandler->t_tCallbacks.t_pfOnRead)
+    {
+        p_ptHandler->t_tCallbacks.t_pfOnRead(p_ptLoop, p_ptHandler->t_ptSocket, p_ptHandler->t_pvArg);
+        if (p_ptHandler->t_bRemoved)
+            return;
+    }
+
+    if ((p_ulReady & NETWORK_LOOP_EVENT_WRITE) && p_ptHandler->t_tCallbacks.t_pfOnWrite)
+    {
+        p_ptHandler->t_tCallbacks.t_pfOnWrite(p_ptLoop, p_ptHandler->t_ptSocket, p_ptHandler->t_pvArg);
+        if (p_ptHandler->t_bRemoved)
+            return;
+    }
+
+    // Hang-up: unregister first so the callback may close the socket
+    if (p_ulReady & NETWORK_LOOP_READY_CLOSE)
+    {
+        networkLoopUnregister(p_ptLoop, p_ptHandler);
+        if (p_ptHandler->t_tCallbacks.t_pfOnClose)
+            p_ptHandler->t_tCallbacks.t_pfOnClose(p_ptLoop, p_ptHandler->t_ptSocket, p_ptHandler->t_pvArg);
+    }
+}
+
+//////////////////////////////////
+/// networkLoopReapErrors
+//////////////////////////////////
+static bool networkLoopReapErrors(networkLoopHandler *p_ptHandler)
+{
+#ifndef USE_TLS
+    // Zero-copy completions are queued on the error queue and raise POLLERR
+    if (p_ptHandler->t_ptSocket->t_bZeroCopy)
+        return networkZeroCopyReap(p_ptHandler->t_ptSocket) > 0;
+#else
+    (void)p_ptHandler;
+#endif
+    return false;
+}
+
+//////////////////////////////////
+/// networkLoopTimeout
+//////////////////////////////////
+static int networkLoopTimeout(xNetworkLoop_t *p_ptLoop, int p_iTimeoutMs)
+{
+    int l_iTimeout = p_iTimeoutMs;
+    struct timespec l_tNow;
+    clock_gettime(CLOCK_MONOTONIC, &l_tNow);
+    int64_t l_lNowNs = (int64_t)l_tNow.tv_sec * 1000000000LL + l_tNow.tv_nsec;
+
+    for (size_t i = 0; i < p_ptLoop->t_ulTimerCount; i++)
+    {
+        xOsTimerCtx *l_ptTimer = p_ptLoop->t_tTimers[i].t_ptTimer;
+        if (l_ptTimer == NULL || mutexLock(&l_ptTimer->t_tMutex) != (int)MUTEX_OK)
+            continue;
+
+        bool l_bActive = l_ptTimer->t_ucActive != 0;
+        int64_t l_lNextNs = (int64_t)l_ptTimer->t_tNext.tv_sec * 1000000000LL + l_ptTimer->t_tNext.tv_nsec;
+        mutexUnlock(&l_ptTimer->t_tMutex);
+        if (!l_bActive)
+            continue;
+
+        // Round up so the timer has expired when the wait returns
+        int64_t l_lWaitMs = (l_lNextNs > l_lNowNs) ? (l_lNextNs - l_lNowNs + 999999) / 1000000 : 0;
+        if (l_lWaitMs > INT32_MAX)
+            l_lWaitMs = INT32_MAX;
+        if (l_iTimeout < 0 || l_lWaitMs < l_iTimeout)
+            l_iTimeout = (int)l_lWaitMs;
+    }
+
+    return l_iTimeout;
+}
+
+//////////////////////////////////
+/// networkLoopDrainWake
+//////////////////////////////////
+static void networkLoopDrainWake(xNetworkLoop_t *p_ptLoop)
+{
+    char l_cBuffer[64];
+    while (read(p_ptLoop->t_iWakeFd[0], l_cBuffer, sizeof(l_cBuffer)) > 0)
+    {
+    }
+}
+
+//////////////////////////////////
+/// xNetworkLoopCreate
+//////////////////////////////////
+int xNetworkLoopCreate(xNetworkLoop_t *p_ptLoop, uint32_t p_ulFlags)
+{
+    if (!p_ptLoop)
+        return NETWORK_INVALID_PARAM;
+
+    memset(p_ptLoop, 0, sizeof(xNetworkLoop_t));
+    p_ptLoop->t_iEpollFd = -1;
+    p_ptLoop->t_iWakeFd[0] = p_ptLoop->t_iWakeFd[1] = -1;
+    atomic_init(&p_ptLoop->a_bStop, false);
+
+#ifdef NETWORK_LOOP_HAVE_EPOLL
+    p_ptLoop->t_bUsePoll = (p_ulFlags & NETWORK_LOOP_FLAG_POLL) != 0;
+#else
+    p_ptLoop->t_bUsePoll = true;
+#endif
+
+    if (xMemPoolCreate(&p_ptLoop->t_tHandlerPool, sizeof(networkLoopHandler), 0, XOS_MEMPOOL_FLAG_NONE) != (int)XOS_MEM_OK)
+        return NETWORK_ERROR;
+
+    if (pipe2(p_ptLoop->t_iWakeFd, O_NONBLOCK | O_CLOEXEC) != 0)
+    {
+        X_LOG_TRACE("xNetworkLoopCreate: pipe failed with errno %d", errno);
+        xMemPoolDestroy(&p_ptLoop->t_tHandlerPool);
+        return NETWORK_ERROR;
+    }
+
+#ifdef NETWORK_LOOP_HAVE_EPOLL
+    if (!p_ptLoop->t_bUsePoll)
+    {
+        p_ptLoop->t_iEpollFd = epoll_create1(EPOLL_CLOEXEC);
+        struct epoll_event l_tEvent = {.events = EPOLLIN, .data.ptr = NULL};
+        if (p_ptLoop->t_iEpollFd < 0 ||
+            epoll_ctl(p_ptLoop->t_iEpollFd, EPOLL_CTL_ADD, p_ptLoop->t_iWakeFd[0], &l_tEvent) != 0)
+        {
+            X_LOG_TRACE("xNetworkLoopCreate: epoll setup failed with errno %d", errno);
+            xNetworkLoopDestroy(p_ptLoop);
+            return NETWORK_ERROR;
+        }
+    }
+#endif
+
+    if (p_ptLoop->t_bUsePoll)
+    {
+        if (networkLoopGrow((void **)&p_ptLoop->t_ptPollFds, &p_ptLoop->t_ulPollCapacity, 1, sizeof(struct pollfd)) != (int)NETWORK_OK)
+        {
+            xNetworkLoopDestroy(p_ptLoop);
+            return NETWORK_ERROR;
+        }
+        size_t l_ulCapacity = 0;
+        if (networkLoopGrow((void **)&p_ptLoop->t_ptPollHandlers, &l_ulCapacity, p_ptLoop->t_ulPollCapacity, sizeof(void *)) != (int)NETWORK_OK)
+        {
+            xNetworkLoopDestroy(p_ptLoop);
+            return NETWORK_ERROR;
+        }
+        p_ptLoop->t_ptPollFds[0].fd = p_ptLoop->t_iWakeFd[0];
+        p_ptLoop->t_ptPollFds[0].events = POLLIN;
+        p_ptLoop->t_ulPollCount = 1;
+    }
+
+    X_LOG_TRACE("xNetworkLoopCreate: %s backend", p_ptLoop->t_bUsePoll ? "poll" : "epoll");
+    return NETWORK_OK;
+}
+
+//////////////////////////////////
+/// xNetworkLoopAdd
+//////////////////////////////////
+int xNetworkLoopAdd(xNetworkLoop_t *p_ptLoop, NetworkSocket *p_ptSocket, uint32_t p_ulEvents,
+                    const xNetworkLoopCallbacks_t *p_ptCallbacks, void *p_pvArg)
+{
+    if (!p_ptLoop || !p_ptSocket || p_ptSocket->t_iSocketFd < 0 || !p_ptCallbacks)
+        return NETWORK_INVALID_PARAM;
+
+    int l_iFd = p_ptSocket->t_iSocketFd;
+    if (networkLoopGrow((void **)&p_ptLoop->t_ptHandlers, &p_ptLoop->t_ulHandlerCapacity, (size_t)l_iFd + 1, sizeof(void *)) != (int)NETWORK_OK)
+        return NETWORK_ERROR;
+    if (p_ptLoop->t_ptHandlers[l_iFd] != NULL)
+        return NETWORK_INVALID_PARAM;
+
+    // Edge-triggered callbacks read until EAGAIN, which needs a non-blocking socket
+    if ((p_ulEvents & NETWORK_LOOP_EVENT_EDGE) && !p_ptSocket->t_bNonBlocking)
+    {
+        if (networkSetNonBlocking(p_ptSocket, true) != (int)NETWORK_OK)
+            return NETWORK_ERROR;
+    }
+
+    networkLoopHandler *l_ptHandler = (networkLoopHandler *)xMemPoolAlloc(&p_ptLoop->t_tHandlerPool);
+    if (!l_ptHandler)
+        return NETWORK_ERROR;
+
+    memset(l_ptHandler, 0, sizeof(networkLoopHandler));
+    l_ptHandler->t_ptSocket = p_ptSocket;
+    l_ptHandler->t_iFd = l_iFd;
+    l_ptHandler->t_ulEvents = p_ulEvents;
+    l_ptHandler->t_tCallbacks = *p_ptCallbacks;
+    l_ptHandler->t_pvArg = p_pvArg;
+
+#ifdef NETWORK_LOOP_HAVE_EPOLL
+    if (!p_ptLoop->t_bUsePoll)
+    {
+        struct epoll_event l_tEvent = {.events = networkLoopEpollEvents(p_ulEvents), .data.ptr = l_ptHandler};
+        if (epoll_ctl(p_ptLoop->t_iEpollFd, EPOLL_CTL_ADD, l_iFd, &l_tEvent) != 0)
+        {
+            X_LOG_TRACE("xNetworkLoopAdd: epoll_ctl failed with errno %d", errno);
+            xMemPoolFree(&p_ptLoop->t_tHandlerPool, l_ptHandler);
+            return NETWORK_ERROR;
+        }
+    }
+#endif
+
+    if (p_ptLoop->t_bUsePoll)
+    {
+        size_t l_ulNeeded = p_ptLoop->t_ulPollCount + 1;
+        size_t l_ulHandlersCapacity = p_ptLoop->t_ulPollCapacity;
+        if (networkLoopGrow((void **)&p_ptLoop->t_ptPollHandlers, &l_ulHandlersCapacity, l_ulNeeded, sizeof(void *)) != (int)NETWORK_OK ||
+            networkLoopGrow((void **)&p_ptLoop->t_ptPollFds, &p_ptLoop->t_ulPollCapacity, l_ulNeeded, sizeof(struct pollfd)) != (int)NETWORK_OK)
+        {
+            xMemPoolFree(&p_ptLoop->t_tHandlerPool, l_ptHandler);
+            return NETWORK_ERROR;
+        }
+
+        l_ptHandler->t_ulPollIndex = p_ptLoop->t_ulPollCount++;
+        p_ptLoop->t_ptPollFds[l_ptHandler->t_ulPollIndex].fd = l_iFd;
+        p_ptLoop->t_ptPollFds[l_ptHandler->t_ulPollIndex].events = networkLoopPollEvents(p_ulEvents);
+        p_ptLoop->t_ptPollFds[l_ptHandler->t_ulPollIndex].revents = 0;
+        p_ptLoop->t_ptPollHandlers[l_ptHandler->t_ulPollIndex] = l_ptHandler;
+    }
+
+    p_ptLoop->t_ptHandlers[l_iFd] = l_ptHandler;
+    p_ptLoop->t_ulHandlerCount++;
+    return NETWORK_OK;
+}
+
+//////////////////////////////////
+/// xNetworkLoopModify
+//////////////////////////////////
+int xNetworkLoopModify(xNetworkLoop_t *p_ptLoop, NetworkSocket *p_ptSocket, uint32_t p_ulEvents)
+{
+    if (!p_ptLoop)
+        return NETWORK_INVALID_PARAM;
+
+    networkLoopHandler *l_ptHandler = networkLoopFind(p_ptLoop, p_ptSocket);
+    if (!l_ptHandler)
+        return NETWORK_INVALID_PARAM;
+
+#ifdef NETWORK_LOOP_HAVE_EPOLL
+    if (!p_ptLoop->t_bUsePoll)
+    {
+        struct epoll_event l_tEvent = {.events = networkLoopEpollEvents(p_ulEvents), .data.ptr = l_ptHandler};
+        if (epoll_ctl(p_ptLoop->t_iEpollFd, EPOLL_CTL_MOD, l_ptHandler->t_iFd, &l_tEvent) != 0)
+            return NETWORK_ERROR;
+    }
+#endif
+
+    if (p_ptLoop->t_bUsePoll)
+        p_ptLoop->t_ptPollFds[l_ptHandler->t_ulPollIndex].events = networkLoopPollEvents(p_ulEvents);
+
+    l_ptHandler->t_ulEvents = p_ulEvents;
+    return NETWORK_OK;
+}
+
+//////////////////////////////////
+/// xNetworkLoopRemove
+//////////////////////////////////
+int xNetworkLoopRemove(xNetworkLoop_t *p_ptLoop, NetworkSocket *p_ptSocket)
+{
+    if (!p_ptLoop)
+        return NETWORK_INVALID_PARAM;
+
+    networkLoopHandler *l_ptHandler = networkLoopFind(p_ptLoop, p_ptSocket);
+    if (!l_ptHandler)
+        return NETWORK_INVALID_PARAM;
+
+    networkLoopUnregister(p_ptLoop, l_ptHandler);
+    return NETWORK_OK;
+}
+
+//////////////////////////////////
+/// networkLoopConnectEvent
+//////////////////////////////////
+static void networkLoopConnectEvent(xNetworkLoop_t *p_ptLoop, NetworkSocket *p_ptSocket, void *p_pvArg)
+{
+    networkLoopHandler *l_ptHandler = (networkLoopHandler *)p_pvArg;
+
+    int l_iStatus = networkConnectComplete(p_ptSocket);
+    if (l_iStatus == (int)NETWORK_IN_PROGRESS && !l_ptHandler->t_bRemoved)
+        return;
+#ifdef USE_TLS
+    // The TLS handshake follows the TCP connect, waiting for what it asks
+    if ((l_iStatus == (int)NETWORK_WANT_READ || l_iStatus == (int)NETWORK_WANT_WRITE) && !l_ptHandler->t_bRemoved)
+    {
+        xNetworkLoopModify(p_ptLoop, p_ptSocket, (l_iStatus == (int)NETWORK_WANT_READ) ? NETWORK_LOOP_EVENT_READ
+                                                                                       : NETWORK_LOOP_EVENT_WRITE);
+        return;
+    }
+    if (l_iStatus == (int)NETWORK_WANT_READ || l_iStatus == (int)NETWORK_WANT_WRITE)
+        l_iStatus = NETWORK_ERROR;
+#endif
+    if (l_iStatus == (int)NETWORK_IN_PROGRESS)
+        l_iStatus = NETWORK_ERROR;
+
+    // Hand the socket back unregistered, the callback re-adds it with its own callbacks
+    if (!l_ptHandler->t_bRemoved)
+        networkLoopUnregister(p_ptLoop, l_ptHandler);
+
+    l_ptHandler->t_pfOnConnect(p_ptLoop, p_ptSocket, l_iStatus, l_ptHandler->t_pvConnectArg);
+}
+
+//////////////////////////////////
+/// networkLoopWatchCompletion
+//////////////////////////////////
+static int networkLoopWatchCompletion(xNetworkLoop_t *p_ptLoop, NetworkSocket *p_ptSocket, uint32_t p_ulEvents,
+                                      xNetworkLoopConnectCallback p_pfOnDone, void *p_pvArg)
+{
+    xNetworkLoopCallbacks_t l_tCallbacks = {networkLoopConnectEvent, networkLoopConnectEvent, networkLoopConnectEvent};
+    int l_iResult = xNetworkLoopAdd(p_ptLoop, p_ptSocket, p_ulEvents, &l_tCallbacks, NULL);
+    if (l_iResult != (int)NETWORK_OK)
+        return l_iResult;
+
+    networkLoopHandler *l_ptHandler = (networkLoopHandler *)p_ptLoop->t_ptHandlers[p_ptSocket->t_iSocketFd];
+    l_ptHandler->t_pvArg = l_ptHandler;
+    l_ptHandler->t_pfOnConnect = p_pfOnDone;
+    l_ptHandler->t_pvConnectArg = p_pvArg;
+    return NETWORK_OK;
+}
+
+//////////////////////////////////
+/// xNetworkLoopConnect
+//////////////////////////////////
+int xNetworkLoopConnect(xNetworkLoop_t *p_ptLoop, NetworkSocket *p_ptSocket, const NetworkAddress *p_pAddress,
+                        xNetworkLoopConnectCallback p_pfOnConnect, void *p_pvArg)
+{
+    if (!p_ptLoop || !p_ptSocket || !p_pAddress || !p_pfOnConnect)
+        return NETWORK_INVALID_PARAM;
+
+    if (!p_ptSocket->t_bNonBlocking && networkSetNonBlocking(p_ptSocket, true) != (int)NETWORK_OK)
+        return NETWORK_ERROR;
+
+    // An immediate success (loopback) is still reported from the loop
+    int l_iResult = networkConnect(p_ptSocket, p_pAddress);
+    uint32_t l_ulEvents = NETWORK_LOOP_EVENT_WRITE;
+#ifdef USE_TLS
+    // TCP may complete at once, the handshake then waits for what it asks
+    if (l_iResult == (int)NETWORK_WANT_READ || l_iResult == (int)NETWORK_WANT_WRITE)
+    {
+        l_ulEvents = (l_iResult == (int)NETWORK_WANT_READ) ? NETWORK_LOOP_EVENT_READ : NETWORK_LOOP_EVENT_WRITE;
+        l_iResult = NETWORK_IN_PROGRESS;
+    }
+#endif
+    if (l_iResult != (int)NETWORK_OK && l_iResult != (int)NETWORK_IN_PROGRESS)
+        return l_iResult;
+
+    return networkLoopWatchCompletion(p_ptLoop, p_ptSocket, l_ulEvents, p_pfOnConnect, p_pvArg);
+}
+
+#ifdef USE_TLS
+//////////////////////////////////
+/// xNetworkLoopHandshake
+//////////////////////////////////
+int xNetworkLoopHandshake(xNetworkLoop_t *p_ptLoop, NetworkSocket *p_ptSocket,
+                          xNetworkLoopConnectCallback p_pfOnHandshake, void *p_pvArg)
+{
+    if (!p_ptLoop || !p_ptSocket || !p_pfOnHandshake)
+        return NETWORK_INVALID_PARAM;
+
+    if (!p_ptSocket->t_bNonBlocking && networkSetNonBlocking(p_ptSocket, true) != (int)NETWORK_OK)
+        return NETWORK_ERROR;
+
+    // A handshake finished at once is still reported from the loop
+    int l_iResult = networkHandshake(p_ptSocket);
+    if (l_iResult != (int)NETWORK_OK && l_iResult != (int)NETWORK_WANT_READ && l_iResult != (int)NETWORK_WANT_WRITE)
+        return l_iResult;
+
+    uint32_t l_ulEvents = (l_iResult == (int)NETWORK_WANT_READ) ? NETWORK_LOOP_EVENT_READ : NETWORK_LOOP_EVENT_WRITE;
+    return networkLoopWatchCompletion(p_ptLoop, p_ptSocket, l_ulEvents, p_pfOnHandshake, p_pvArg);
+}
+#endif
+
+//////////////////////////////////
+/// xNetworkLoopAddTimer
+//////////////////////////////////
+int xNetworkLoopAddTimer(xNetworkLoop_t *p_ptLoop, xOsTimerCtx *p_ptTimer, void (*p_pfCallback)(void *), void *p_pvArg)
+{
+    if (!p_ptLoop || !p_ptTimer || !p_pfCallback)
+        return NETWORK_INVALID_PARAM;
+
+    if (p_ptLoop->t_ulTimerCount >= NETWORK_LOOP_MAX_TIMERS)
+        return NETWORK_ERROR;
+
+    xNetworkLoopTimer_t *l_ptEntry = &p_ptLoop->t_tTimers[p_ptLoop->t_ulTimerCount++];
+    l_ptEntry->t_ptTimer = p_ptTimer;
+    l_ptEntry->t_pfCallback = p_pfCallback;
+    l_ptEntry->t_pvArg = p_pvArg;
+    return NETWORK_OK;
+}
+
+//////////////////////////////////
+/// xNetworkLoopRemoveTimer
+//////////////////////////////////
+int xNetworkLoopRemoveTimer(xNetworkLoop_t *p_ptLoop, xOsTimerCtx *p_ptTimer)
+{
+    if (!p_ptLoop || !p_ptTimer)
+        return NETWORK_INVALID_PARAM;
+
+    for (size_t i = 0; i < p_ptLoop->t_ulTimerCount; i++)
+    {
+        if (p_ptLoop->t_tTimers[i].t_ptTimer == p_ptTimer)
+        {
+            p_ptLoop->t_tTimers[i].t_ptTimer = NULL;
+            if (!p_ptLoop->t_bDispatching)
+                networkLoopCompact(p_ptLoop);
+            return NETWORK_OK;
+        }
+    }
+
+    return NETWORK_INVALID_PARAM;
+}
+
+//////////////////////////////////
+/// xNetworkLoopRunOnce
+//////////////////////////////////
+int xNetworkLoopRunOnce(xNetworkLoop_t *p_ptLoop, int p_iTimeoutMs)
+{
+    if (!p_ptLoop || p_ptLoop->t_bDispatching)
+        return NETWORK_INVALID_PARAM;
+
+    int l_iTimeout = networkLoopTimeout(p_ptLoop, p_iTimeoutMs);
+    int l_iDispatched = 0;
+
+    p_ptLoop->t_bDispatching = true;
+
+#ifdef NETWORK_LOOP_HAVE_EPOLL
+    if (!p_ptLoop->t_bUsePoll)
+    {
+        struct epoll_event l_tEvents[NETWORK_LOOP_MAX_EVENTS];
+        int l_iCount = epoll_wait(p_ptLoop->t_iEpollFd, l_tEvents, NETWORK_LOOP_MAX_EVENTS, l_iTimeout);
+        if (l_iCount < 0 && errno != EINTR)
+        {
+            p_ptLoop->t_bDispatching = false;
+            return NETWORK_ERROR;
+        }
+
+        for (int i = 0; i < l_iCount; i++)
+        {
+            networkLoopHandler *l_ptHandler = (networkLoopHandler *)l_tEvents[i].data.ptr;
+            if (l_ptHandler == NULL)
+            {
+                networkLoopDrainWake(p_ptLoop);
+                continue;
+            }
+            if (l_ptHandler->t_bRemoved)
+                continue;
+
+            uint32_t l_ulReady = 0;
+            // A peer half-close is a read, the handler drains the socket and sees the end itself
+            if (l_tEvents[i].events & (EPOLLIN | EPOLLPRI | EPOLLRDHUP))
+                l_ulReady |= NETWORK_LOOP_EVENT_READ;
+            if (l_tEvents[i].events & EPOLLOUT)
+                l_ulReady |= NETWORK_LOOP_EVENT_WRITE;
+            if (l_tEvents[i].events & EPOLLHUP)
+                l_ulReady |= NETWORK_LOOP_READY_CLOSE;
+            else if ((l_tEvents[i].events & EPOLLERR) && !networkLoopReapErrors(l_ptHandler))
+                l_ulReady |= NETWORK_LOOP_READY_CLOSE;
+
+            networkLoopDispatch(p_ptLoop, l_ptHandler, l_ulReady & (l_ptHandler->t_ulEvents | NETWORK_LOOP_READY_CLOSE));
+            l_iDispatched++;
+        }
+    }
+#endif
+
+    if (p_ptLoop->t_bUsePoll)
+    {
+        // Sockets added by callbacks are polled from the next call
+        size_t l_ulCount = p_ptLoop->t_ulPollCount;
+        int l_iCount = poll(p_ptLoop->t_ptPollFds, (nfds_t)l_ulCount, l_iTimeout);
+        if (l_iCount < 0 && errno != EINTR)
+        {
+            p_ptLoop->t_bDispatching = false;
+            return NETWORK_ERROR;
+        }
+
+        if (l_iCount > 0 && (p_ptLoop->t_ptPollFds[0].revents & POLLIN))
+        {
+            networkLoopDrainWake(p_ptLoop);
+        }
+
+        for (size_t i = 1; i < l_ulCount && l_iCount > 0; i++)
+        {
+            short l_sRevents = p_ptLoop->t_ptPollFds[i].revents;
+            networkLoopHandler *l_ptHandler = (networkLoopHandler *)p_ptLoop->t_ptPollHandlers[i];
+            if (l_sRevents == 0 || l_ptHandler->t_bRemoved)
+                continue;
+
+            uint32_t l_ulReady = 0;
+            if (l_sRevents & (POLLIN | POLLPRI | POLLRDHUP))
+                l_ulReady |= NETWORK_LOOP_EVENT_READ;
+            if (l_sRevents & POLLOUT)
+                l_ulReady |= NETWORK_LOOP_EVENT_WRITE;
+            if (l_sRevents & (POLLHUP | POLLNVAL))
+                l_ulReady |= NETWORK_LOOP_READY_CLOSE;
+            else if ((l_sRevents & POLLERR) && !networkLoopReapErrors(l_ptHandler))
+                l_ulReady |= NETWORK_LOOP_READY_CLOSE;
+
+            networkLoopDispatch(p_ptLoop, l_ptHandler, l_ulReady & (l_ptHandler->t_ulEvents | NETWORK_LOOP_READY_CLOSE));
+            l_iDispatched++;
+        }
+    }
+
+    // Timers, xTimer counts the elapsed periods
+    size_t l_ulTimerCount = p_ptLoop->t_ulTimerCount;
+    for (size_t i = 0; i < l_ulTimerCount; i++)
+    {
+        xNetworkLoopTimer_t *l_ptEntry = &p_ptLoop->t_tTimers[i];
+        if (l_ptEntry->t_ptTimer != NULL)
+            xTimerProcessElapsedPeriods(l_ptEntry->t_ptTimer, l_ptEntry->t_pfCallback, l_ptEntry->t_pvArg);
+    }
+
+    p_ptLoop->t_bDispatching = false;
+    networkLoopCompact(p_ptLoop);
+    return l_iDispatched;
+}
+
+//////////////////////////////////
+/// xNetworkLoopRun
+//////////////////////////////////
+int xNetworkLoopRun(xNetworkLoop_t *p_ptLoop)
+{
+    if (!p_ptLoop)
+        return NETWORK_INVALID_PARAM;
+
+    while (!atomic_load(&p_ptLoop->a_bStop))
+    {
+        int l_iRet = xNetworkLoopRunOnce(p_ptLoop, -1);
+        if (l_iRet < 0)
+            return l_iRet;
+    }
+
+    // Ready for another run
+    atomic_store(&p_ptLoop->a_bStop, false);
+    return NETWORK_OK;
+}
+
+//////////////////////////////////
+/// xNetworkLoopStop
+//////////////////////////////////
+int xNetworkLoopStop(xNetworkLoop_t *p_ptLoop)
+{
+    if (!p_ptLoop || p_ptLoop->t_iWakeFd[1] < 0)
+        return NETWORK_INVALID_PARAM;
+
+    atomic_store(&p_ptLoop->a_bStop, true);
+
+    // A full pipe already wakes the loop
+    char l_cByte = 1;
+    ssize_t l_lRet = write(p_ptLoop->t_iWakeFd[1], &l_cByte, 1);
+    (void)l_lRet;
+    return NETWORK_OK;
+}
+
+//////////////////////////////////
+/// xNetworkLoopDestroy
+//////////////////////////////////
+int xNetworkLoopDestroy(xNetworkLoop_t *p_ptLoop)
+{
+    if (!p_ptLoop)
+        return NETWORK_INVALID_PARAM;
+
+    if (p_ptLoop->t_iEpollFd >= 0)
+        close(p_ptLoop->t_iEpollFd);
+    for (int i = 0; i < 2; i++)
+    {
+        if (p_ptLoop->t_iWakeFd[i] >= 0)
+            close(p_ptLoop->t_iWakeFd[i]);
+    }
+
+    // Handlers live in the pool, released with it
+    xMemPoolDestroy(&p_ptLoop->t_tHandlerPool);
+    if (p_ptLoop->t_ptHandlers)
+        X_FREE(p_ptLoop->t_ptHandlers);
+    if (p_ptLoop->t_ptPollFds)
+        X_FREE(p_ptLoop->t_ptPollFds);
+    if (p_ptLoop->t_ptPollHandlers)
+        X_FREE(p_ptLoop->t_ptPollHandlers);
+
+    memset(p_ptLoop, 0, sizeof(xNetworkLoop_t));
+    p_ptLoop->t_iEpollFd = -1;
+    p_ptLoop->t_iWakeFd[0] = p_ptLoop->t_iWakeFd[1] = -1;
+    return NETWORK_OK;
+}
@@ -0,0 +1,209 @@
+////////////////////////////////////////////////////////////
+//  Network event loop header file
+//  Defines the reactor multiplexing NetworkSocket events
+//  epoll based on Linux, poll() fallback elsewhere or on request
+//
+// general disclosure: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+
+#ifndef NETWORK_LOOP_H_
+#define NETWORK_LOOP_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <poll.h>
+
+#ifdef USE_TLS
+#include "xNetworkTls.h"
+#else
+#include "xNetwork.h"
+#endif
+#include "xMemPool.h"
+#include "xTimer.h"
+
+// Configuration constants
+#define NETWORK_LOOP_MAX_EVENTS 64  // Events collected by one wait
+#define NETWORK_LOOP_MAX_TIMERS 32  // Timers registered on one loop
+
+// Events a socket is watched for
+#define NETWORK_LOOP_EVENT_READ  0x01 // Readable (or incoming connection)
+#define NETWORK_LOOP_EVENT_WRITE 0x02 // Writable (or connect completed)
+#define NETWORK_LOOP_EVENT_EDGE  0x04 // Edge-triggered, callbacks must read/write until EAGAIN
+
+// Loop creation flags
+#define NETWORK_LOOP_FLAG_NONE 0x00000000
+#define NETWORK_LOOP_FLAG_POLL 0x00000001 // Use the poll() backend even when epoll is available
+
+typedef struct xos_network_loop_t xNetworkLoop_t;
+
+// Socket callback, called from the loop thread
+typedef void (*xNetworkLoopCallback)(xNetworkLoop_t *p_ptLoop, NetworkSocket *p_ptSocket, void *p_pvArg);
+
+// Connect completion, p_iStatus is NETWORK_OK or an error code
+typedef void (*xNetworkLoopConnectCallback)(xNetworkLoop_t *p_ptLoop, NetworkSocket *p_ptSocket, int p_iStatus, void *p_pvArg);
+
+// Socket callbacks, unused entries may be NULL
+typedef struct
+{
+    xNetworkLoopCallback t_pfOnRead;  // Socket readable
+    xNetworkLoopCallback t_pfOnWrite; // Socket writable
+    xNetworkLoopCallback t_pfOnClose; // Hang-up or error, the socket is already removed from the loop.
+                                      // A peer half-close is reported to t_pfOnRead, receive then returns 0
+} xNetworkLoopCallbacks_t;
+
+// Timer registered on a loop
+typedef struct
+{
+    xOsTimerCtx *t_ptTimer;         // Timer, started by the caller
+    void (*t_pfCallback)(void *);   // Called for each elapsed period
+    void *t_pvArg;                  // Callback argument
+} xNetworkLoopTimer_t;
+
+//////////////////////////////////
+/// @brief reactor state
+/// @note the loop is driven by one thread, every function except
+///       xNetworkLoopStop must be called from that thread (callbacks included)
+//////////////////////////////////
+struct xos_network_loop_t
+{
+    bool t_bUsePoll;                // poll() backend in use
+    int t_iEpollFd;                 // epoll instance (-1 with poll)
+    int t_iWakeFd[2];               // Pipe used by xNetworkLoopStop
+    atomic_bool a_bStop;            // Stop requested
+    bool t_bDispatching;            // Callbacks are running, removals are deferred
+    xMemPool_t t_tHandlerPool;      // Per-socket registration records
+    void *t_ptDeferred;             // Removed handlers, freed after the dispatch
+    void **t_ptHandlers;            // Handler of each descriptor, indexed by fd
+    size_t t_ulHandlerCapacity;     // Entries of t_ptHandlers
+    size_t t_ulHandlerCount;        // Registered sockets
+    struct pollfd *t_ptPollFds;     // poll backend: descriptor array (index 0 is the wake pipe)
+    void **t_ptPollHandlers;        // poll backend: handler of each descriptor
+    size_t t_ulPollCount;           // poll backend: used entries
+    size_t t_ulPollCapacity;        // poll backend: allocated entries
+    xNetworkLoopTimer_t t_tTimers[NETWORK_LOOP_MAX_TIMERS]; // Registered timers
+    size_t t_ulTimerCount;          // Number of registered timers
+};
+
+//////////////////////////////////
+/// @brief Create an event loop
+/// @param p_ptLoop Loop structure pointer
+/// @param p_ulFlags NETWORK_LOOP_FLAG_* combination
+/// @return int Error code
+//////////////////////////////////
+int xNetworkLoopCreate(xNetworkLoop_t *p_ptLoop, uint32_t p_ulFlags);
+
+//////////////////////////////////
+/// @brief Register a socket
+/// @param p_ptLoop Loop structure pointer
+/// @param p_ptSocket Socket handle
+/// @param p_ulEvents NETWORK_LOOP_EVENT_* combination
+/// @param p_ptCallbacks Callbacks (copied)
+/// @param p_pvArg Callback argument
+/// @return int Error code
+/// @note an edge-triggered socket is switched to non-blocking mode
+//////////////////////////////////
+int xNetworkLoopAdd(xNetworkLoop_t *p_ptLoop, NetworkSocket *p_ptSocket, uint32_t p_ulEvents,
+                    const xNetworkLoopCallbacks_t *p_ptCallbacks, void *p_pvArg);
+
+//////////////////////////////////
+/// @brief Change the events a socket is watched for
+/// @param p_ptLoop Loop structure pointer
+/// @param p_ptSocket Registered socket
+/// @param p_ulEvents NETWORK_LOOP_EVENT_* combination
+/// @return int Error code
+//////////////////////////////////
+int xNetworkLoopModify(xNetworkLoop_t *p_ptLoop, NetworkSocket *p_ptSocket, uint32_t p_ulEvents);
+
+//////////////////////////////////
+/// @brief Unregister a socket
+/// @param p_ptLoop Loop structure pointer
+/// @param p_ptSocket Registered socket
+/// @return int Error code
+/// @note must be called before networkCloseSocket, safe from a callback
+//////////////////////////////////
+int xNetworkLoopRemove(xNetworkLoop_t *p_ptLoop, NetworkSocket *p_ptSocket);
+
+//////////////////////////////////
+/// @brief Start a non-blocking connect and report its completion
+/// @param p_ptLoop Loop structure pointer
+/// @param p_ptSocket Unregistered TCP socket, switched to non-blocking mode
+/// @param p_pAddress Server address
+/// @param p_pfOnConnect Called once from the loop with the connect result
+/// @param p_pvArg Callback argument
+/// @return int Error code
+/// @note the socket is unregistered before p_pfOnConnect, which registers it
+///       again with its own callbacks (or closes it on failure); with TLS the
+///       result also covers the handshake
+//////////////////////////////////
+int xNetworkLoopConnect(xNetworkLoop_t *p_ptLoop, NetworkSocket *p_ptSocket, const NetworkAddress *p_pAddress,
+                        xNetworkLoopConnectCallback p_pfOnConnect, void *p_pvArg);
+
+#ifdef USE_TLS
+//////////////////////////////////
+/// @brief Drive the TLS handshake of an accepted socket and report its completion
+/// @param p_ptLoop Loop structure pointer
+/// @param p_ptSocket Unregistered socket from networkAccept, switched to non-blocking mode
+/// @param p_pfOnHandshake Called once from the loop with the handshake result
+/// @param p_pvArg Callback argument
+/// @return int Error code
+/// @note handshakes wait on readiness instead of a thread, one loop drives
+///       as many as it has sockets; the socket is unregistered before
+///       p_pfOnHandshake as with xNetworkLoopConnect
+//////////////////////////////////
+int xNetworkLoopHandshake(xNetworkLoop_t *p_ptLoop, NetworkSocket *p_ptSocket,
+                          xNetworkLoopConnectCallback p_pfOnHandshake, void *p_pvArg);
+#endif
+
+//////////////////////////////////
+/// @brief Register a timer
+/// @param p_ptLoop Loop structure pointer
+/// @param p_ptTimer Timer created and started with xTimer
+/// @param p_pfCallback Called for each elapsed period (xTimerProcessElapsedPeriods)
+/// @param p_pvArg Callback argument
+/// @return int Error code
+/// @note the wait timeout follows the next expiry, a stopped timer is skipped
+//////////////////////////////////
+int xNetworkLoopAddTimer(xNetworkLoop_t *p_ptLoop, xOsTimerCtx *p_ptTimer, void (*p_pfCallback)(void *), void *p_pvArg);
+
+//////////////////////////////////
+/// @brief Unregister a timer
+/// @param p_ptLoop Loop structure pointer
+/// @param p_ptTimer Registered timer
+/// @return int Error code
+//////////////////////////////////
+int xNetworkLoopRemoveTimer(xNetworkLoop_t *p_ptLoop, xOsTimerCtx *p_ptTimer);
+
+//////////////////////////////////
+/// @brief Wait for events once and dispatch them
+/// @param p_ptLoop Loop structure pointer
+/// @param p_iTimeoutMs Maximum wait in milliseconds (-1 for infinite, shortened by timers)
+/// @return int Number of socket events dispatched or error code
+//////////////////////////////////
+int xNetworkLoopRunOnce(xNetworkLoop_t *p_ptLoop, int p_iTimeoutMs);
+
+//////////////////////////////////
+/// @brief Dispatch events until xNetworkLoopStop
+/// @param p_ptLoop Loop structure pointer
+/// @return int Error code
+//////////////////////////////////
+int xNetworkLoopRun(xNetworkLoop_t *p_ptLoop);
+
+//////////////////////////////////
+/// @brief Ask xNetworkLoopRun to return
+/// @param p_ptLoop Loop structure pointer
+/// @return int Error code
+/// @note may be called from any thread or from a signal handler
+//////////////////////////////////
+int xNetworkLoopStop(xNetworkLoop_t *p_ptLoop);
+
+//////////////////////////////////
+/// @brief Destroy the loop
+/// @param p_ptLoop Loop structure pointer
+/// @return int Error code
+/// @note registered sockets are not closed
+//////////////////////////////////
+int xNetworkLoopDestroy(xNetworkLoop_t *p_ptLoop);
+
+#endif // NETWORK_LOOP_H_
@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////////////
+//  Network socket options implementation file
+//  Implements the tuning options defined in xNetworkOptions.h
+//  Works on the descriptor only, shared by xNetwork.c and xNetworkTls.c
+//
+// general disclosure: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+
+#include "xNetworkOptions.h"
+#include <netinet/tcp.h>
+
+//////////////////////////////////
+/// networkSetIntOption
+//////////////////////////////////
+static bool networkSetIntOption(int p_iFd, int p_iLevel, int p_iName, int p_iValue, const char *p_pcName)
+{
+    if (setsockopt(p_iFd, p_iLevel, p_iName, &p_iValue, sizeof(p_iValue)) == 0)
+        return true;
+
+    X_LOG_TRACE("networkSetOptions: %s=%d refused with error %d", p_pcName, p_iValue, errno);
+    return false;
+}
+
+//////////////////////////////////
+/// networkGetIntOption
+//////////////////////////////////
+static int networkGetIntOption(int p_iFd, int p_iLevel, int p_iName)
+{
+    int l_iValue = 0;
+    socklen_t l_iLen = sizeof(l_iValue);
+    if (getsockopt(p_iFd, p_iLevel, p_iName, &l_iValue, &l_iLen) < 0)
+        return 0;
+
+    return l_iValue;
+}
+
+//////////////////////////////////
+/// networkSetOptions
+//////////////////////////////////
+int networkSetOptions(NetworkSocket *p_ptSocket, const NetworkSocketOptions *p_ptOptions)
+{
+    if (!p_ptSocket || p_ptSocket->t_iSocketFd < 0 || !p_ptOptions)
+        return NETWORK_INVALID_PARAM;
+
+    int l_iFd = p_ptSocket->t_iSocketFd;
+    bool l_bOk = true;
+
+    l_bOk &= networkSetIntOption(l_iFd, SOL_SOCKET, SO_REUSEPORT, p_ptOptions->t_bReusePort ? 1 : 0, "SO_REUSEPORT");
+    if (p_ptOptions->t_iSendBufferSize > 0)
+        l_bOk &= networkSetIntOption(l_iFd, SOL_SOCKET, SO_SNDBUF, p_ptOptions->t_iSendBufferSize, "SO_SNDBUF");
+    if (p_ptOptions->t_iReceiveBufferSize > 0)
+        l_bOk &= networkSetIntOption(l_iFd, SOL_SOCKET, SO_RCVBUF, p_ptOptions->t_iReceiveBufferSize, "SO_RCVBUF");
+#ifdef SO_BUSY_POLL
+    if (p_ptOptions->t_iBusyPollUs > 0)
+        l_bOk &= networkSetIntOption(l_iFd, SOL_SOCKET, SO_BUSY_POLL, p_ptOptions->t_iBusyPollUs, "SO_BUSY_POLL");
+#endif
+
+    if (p_ptSocket->t_iType == NETWORK_SOCK_TCP)
+    {
+        l_bOk &= networkSetIntOption(l_iFd, IPPROTO_TCP, TCP_NODELAY, p_ptOptions->t_bNoDelay ? 1 : 0, "TCP_NODELAY");
+        l_bOk &= networkSetIntOption(l_iFd, IPPROTO_TCP, TCP_QUICKACK, p_ptOptions->t_bQuickAck ? 1 : 0, "TCP_QUICKACK");
+        l_bOk &= networkSetIntOption(l_iFd, SOL_SOCKET, SO_KEEPALIVE, p_ptOptions->t_bKeepAlive ? 1 : 0, "SO_KEEPALIVE");
+        if (p_ptOptions->t_iKeepIdleSec > 0)
+            l_bOk &= networkSetIntOption(l_iFd, IPPROTO_TCP, TCP_KEEPIDLE, p_ptOptions->t_iKeepIdleSec, "TCP_KEEPIDLE");
+        if (p_ptOptions->t_iKeepIntervalSec > 0)
+            l_bOk &= networkSetIntOption(l_iFd, IPPROTO_TCP, TCP_KEEPINTVL, p_ptOptions->t_iKeepIntervalSec, "TCP_KEEPINTVL");
+        if (p_ptOptions->t_iKeepCount > 0)
+            l_bOk &= networkSetIntOption(l_iFd, IPPROTO_TCP, TCP_KEEPCNT, p_ptOptions->t_iKeepCount, "TCP_KEEPCNT");
+    }
+
+    return l_bOk ? NETWORK_OK : NETWORK_ERROR;
+}
+
+//////////////////////////////////
+/// networkGetOptions
+//////////////////////////////////
+int networkGetOptions(NetworkSocket *p_ptSocket, NetworkSocketOptions *p_ptOptions)
+{
+    if (!p_ptSocket || p_ptSocket->t_iSocketFd < 0 || !p_ptOptions)
+        return NETWORK_INVALID_PARAM;
+
+    int l_iFd = p_ptSocket->t_iSocketFd;
+    memset(p_ptOptions, 0, sizeof(*p_ptOptions));
+
+    p_ptOptions->t_bReusePort = networkGetIntOption(l_iFd, SOL_SOCKET, SO_REUSEPORT) != 0;
+    p_ptOptions->t_iSendBufferSize = networkGetIntOption(l_iFd, SOL_SOCKET, SO_SNDBUF);
+    p_ptOptions->t_iReceiveBufferSize = networkGetIntOption(l_iFd, SOL_SOCKET, SO_RCVBUF);
+#ifdef SO_BUSY_POLL
+    p_ptOptions->t_iBusyPollUs = networkGetIntOption(l_iFd, SOL_SOCKET, SO_BUSY_POLL);
+#endif
+
+    if (p_ptSocket->t_iType == NETWORK_SOCK_TCP)
+    {
+        p_ptOptions->t_bNoDelay = networkGetIntOption(l_iFd, IPPROTO_TCP, TCP_NODELAY) != 0;
+        p_ptOptions->t_bQuickAck = networkGetIntOption(l_iFd, IPPROTO_TCP, TCP_QUICKACK) != 0;
+        p_ptOptions->t_bKeepAlive = networkGetIntOption(l_iFd, SOL_SOCKET, SO_KEEPALIVE) != 0;
+        p_ptOptions->t_iKeepIdleSec = networkGetIntOption(l_iFd, IPPROTO_TCP, TCP_KEEPIDLE);
+        p_ptOptions->t_iKeepIntervalSec = networkGetIntOption(l_iFd, IPPROTO_TCP, TCP_KEEPINTVL);
+        p_ptOptions->t_iKeepCount = networkGetIntOption(l_iFd, IPPROTO_TCP, TCP_KEEPCNT);
+    }
+
+    return NETWORK_OK;
+}
+
+#ifndef USE_TLS
+//////////////////////////////////
+/// networkCreateSocketEx
+//////////////////////////////////
+NetworkSocket *networkCreateSocketEx(int p_iType, const NetworkSocketOptions *p_ptOptions)
+{
+    NetworkSocket *l_pSocket = networkCreateSocket(p_iType);
+    if (!l_pSocket || !p_ptOptions)
+        return l_pSocket;
+
+    if (networkSetOptions(l_pSocket, p_ptOptions) != (int)NETWORK_OK)
+    {
+        networkCloseSocket(l_pSocket);
+        return NULL;
+    }
+
+    return l_pSocket;
+}
+#endif
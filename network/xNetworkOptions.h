@@ -0,0 +1,66 @@
+////////////////////////////////////////////////////////////
+//  Network socket options header file
+//  Defines the socket tuning options shared by the plain and TLS
+//  network implementations
+//
+// general disclosure: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+
+#ifndef NETWORK_OPTIONS_H_
+#define NETWORK_OPTIONS_H_
+
+#include <stdbool.h>
+
+#ifdef USE_TLS
+#include "xNetworkTls.h"
+#else
+#include "xNetwork.h"
+#endif
+
+// Socket tuning, boolean fields are always applied, integer fields at 0
+// keep the current value; TCP-only fields are ignored on UDP sockets
+typedef struct NetworkSocketOptions_t
+{
+    bool t_bNoDelay;            // TCP_NODELAY, send small segments at once
+    bool t_bQuickAck;           // TCP_QUICKACK, the kernel clears it again, reapply after receives
+    bool t_bReusePort;          // SO_REUSEPORT, apply before networkBind
+    bool t_bKeepAlive;          // SO_KEEPALIVE
+    int t_iKeepIdleSec;         // TCP_KEEPIDLE, idle time before the first probe
+    int t_iKeepIntervalSec;     // TCP_KEEPINTVL, time between probes
+    int t_iKeepCount;           // TCP_KEEPCNT, unanswered probes before the reset
+    int t_iSendBufferSize;      // SO_SNDBUF in bytes, capped by net.core.wmem_max
+    int t_iReceiveBufferSize;   // SO_RCVBUF in bytes, capped by net.core.rmem_max
+    int t_iBusyPollUs;          // SO_BUSY_POLL in microseconds, raising it needs CAP_NET_ADMIN
+} NetworkSocketOptions;
+
+//////////////////////////////////
+/// @brief Apply tuning options to a socket
+/// @param p_ptSocket Socket handle
+/// @param p_ptOptions Options to apply
+/// @return int Error code
+/// @note every option is attempted, the result is NETWORK_ERROR if one was refused
+//////////////////////////////////
+int networkSetOptions(NetworkSocket *p_ptSocket, const NetworkSocketOptions *p_ptOptions);
+
+//////////////////////////////////
+/// @brief Read the options granted by the kernel
+/// @param p_ptSocket Socket handle
+/// @param p_ptOptions Filled with the current values
+/// @return int Error code
+/// @note buffer sizes are the kernel values, which include its bookkeeping
+///       overhead (twice the requested size on Linux)
+//////////////////////////////////
+int networkGetOptions(NetworkSocket *p_ptSocket, NetworkSocketOptions *p_ptOptions);
+
+#ifndef USE_TLS
+//////////////////////////////////
+/// @brief Create a socket and apply tuning options
+/// @param p_iType Socket type (NETWORK_SOCK_TCP/UDP)
+/// @param p_ptOptions Options to apply (NULL for kernel defaults)
+/// @return NetworkSocket* Socket handle or NULL on error
+//////////////////////////////////
+NetworkSocket *networkCreateSocketEx(int p_iType, const NetworkSocketOptions *p_ptOptions);
+#endif
+
+#endif // NETWORK_OPTIONS_H_
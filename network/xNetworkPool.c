@@ -0,0 +1,354 @@
+////////////////////////////////////////////////////////////
+//  Network connection pool implementation file
+//  Implements the connection pool defined in xNetworkPool.h
+//
+// Sockets are connected, health-checked and closed outside the pool
+// mutex, a slot is reserved in t_iOpen first so the cap holds meanwhile
+//
+// general disclosure: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+
+#include "xNetworkPool.h"
+#include "xOsFutex.h"
+#include "xMemory.h"
+#include "xOsHorodateur.h"
+#include <poll.h>
+#include <time.h>
+
+// Expired sockets taken off an endpoint per pass, closed once the mutex is released
+#define NETWORK_POOL_EXPIRE_BATCH 16
+
+#ifndef USE_TLS
+//////////////////////////////////
+/// networkPoolConnectTcp
+//////////////////////////////////
+static NetworkSocket *networkPoolConnectTcp(const NetworkAddress *p_ptAddress, void *p_pvArg)
+{
+    (void)p_pvArg;
+
+    NetworkSocket *l_ptSocket = networkCreateSocket(NETWORK_SOCK_TCP);
+    if (!l_ptSocket)
+        return NULL;
+
+    if (networkConnect(l_ptSocket, p_ptAddress) != (int)NETWORK_OK)
+    {
+        networkCloseSocket(l_ptSocket);
+        return NULL;
+    }
+
+    return l_ptSocket;
+}
+#endif
+
+//////////////////////////////////
+/// networkPoolIsHealthy
+//////////////////////////////////
+static bool networkPoolIsHealthy(NetworkSocket *p_ptSocket)
+{
+    if (!networkIsConnected(p_ptSocket))
+        return false;
+
+    // An idle connection has nothing to read: readable means EOF, reset or stray data
+    struct pollfd l_tPoll = {.fd = p_ptSocket->t_iSocketFd, .events = POLLIN, .revents = 0};
+    return poll(&l_tPoll, 1, 0) == 0;
+}
+
+//////////////////////////////////
+/// networkPoolFind
+//////////////////////////////////
+static xNetworkPoolEndpoint_t *networkPoolFind(xNetworkPool_t *p_ptPool, const NetworkAddress *p_ptAddress, bool p_bCreate)
+{
+    for (int i = 0; i < p_ptPool->t_iEndpointCount; i++)
+    {
+        xNetworkPoolEndpoint_t *l_ptEndpoint = &p_ptPool->t_tEndpoints[i];
+        if (l_ptEndpoint->t_tAddress.t_usPort == p_ptAddress->t_usPort &&
+            strcmp(l_ptEndpoint->t_tAddress.t_cAddress, p_ptAddress->t_cAddress) == 0)
+            return l_ptEndpoint;
+    }
+
+    if (!p_bCreate || p_ptPool->t_iEndpointCount == NETWORK_POOL_MAX_ENDPOINTS)
+        return NULL;
+
+    xNetworkPoolIdle_t *l_ptIdle = (xNetworkPoolIdle_t *)X_MALLOC(sizeof(xNetworkPoolIdle_t) * (size_t)p_ptPool->t_tConfig.t_iMaxPerEndpoint);
+    if (!l_ptIdle)
+        return NULL;
+
+    xNetworkPoolEndpoint_t *l_ptEndpoint = &p_ptPool->t_tEndpoints[p_ptPool->t_iEndpointCount++];
+    l_ptEndpoint->t_tAddress = *p_ptAddress;
+    l_ptEndpoint->t_iOpen = 0;
+    l_ptEndpoint->t_iIdleCount = 0;
+    l_ptEndpoint->t_ptIdle = l_ptIdle;
+    return l_ptEndpoint;
+}
+
+//////////////////////////////////
+/// networkPoolExpire
+/// Unlinks up to NETWORK_POOL_EXPIRE_BATCH expired sockets into p_ptExpired,
+/// the caller closes them after releasing the pool mutex
+//////////////////////////////////
+static int networkPoolExpire(xNetworkPool_t *p_ptPool, xNetworkPoolEndpoint_t *p_ptEndpoint, uint64_t p_ulNowNs,
+                             NetworkSocket **p_ptExpired)
+{
+    uint64_t l_ulTimeoutNs = (uint64_t)p_ptPool->t_tConfig.t_iIdleTimeoutMs * 1000000ULL;
+
+    // Oldest entries first, the list is ordered by release time
+    int l_iExpired = 0;
+    while (l_iExpired < NETWORK_POOL_EXPIRE_BATCH && l_iExpired < p_ptEndpoint->t_iIdleCount &&
+           p_ulNowNs - p_ptEndpoint->t_ptIdle[l_iExpired].t_ulIdleSinceNs > l_ulTimeoutNs)
+    {
+        p_ptExpired[l_iExpired] = p_ptEndpoint->t_ptIdle[l_iExpired].t_ptSocket;
+        l_iExpired++;
+    }
+
+    if (l_iExpired > 0)
+    {
+        p_ptEndpoint->t_iIdleCount -= l_iExpired;
+        p_ptEndpoint->t_iOpen -= l_iExpired;
+        memmove(p_ptEndpoint->t_ptIdle, p_ptEndpoint->t_ptIdle + l_iExpired,
+                sizeof(xNetworkPoolIdle_t) * (size_t)p_ptEndpoint->t_iIdleCount);
+        pthread_cond_broadcast(&p_ptPool->t_tReleased);
+    }
+
+    return l_iExpired;
+}
+
+//////////////////////////////////
+/// networkPoolExpireAll
+/// Called and returns with the pool mutex held, released while sockets are closed
+//////////////////////////////////
+static int networkPoolExpireAll(xNetworkPool_t *p_ptPool, xNetworkPoolEndpoint_t *p_ptEndpoint, uint64_t p_ulNowNs)
+{
+    NetworkSocket *l_ptExpired[NETWORK_POOL_EXPIRE_BATCH];
+    int l_iTotal = 0;
+    int l_iCount;
+
+    do
+    {
+        l_iCount = networkPoolExpire(p_ptPool, p_ptEndpoint, p_ulNowNs, l_ptExpired);
+        if (l_iCount == 0)
+            break;
+
+        // A close may run a TLS shutdown, never under the pool mutex
+        pthread_mutex_unlock(&p_ptPool->t_tMutex);
+        for (int i = 0; i < l_iCount; i++)
+            networkCloseSocket(l_ptExpired[i]);
+        pthread_mutex_lock(&p_ptPool->t_tMutex);
+        l_iTotal += l_iCount;
+    } while (l_iCount == NETWORK_POOL_EXPIRE_BATCH);
+
+    return l_iTotal;
+}
+
+//////////////////////////////////
+/// xNetworkPoolCreate
+//////////////////////////////////
+int xNetworkPoolCreate(xNetworkPool_t *p_ptPool, const xNetworkPoolConfig_t *p_ptConfig)
+{
+    if (!p_ptPool)
+        return NETWORK_INVALID_PARAM;
+
+    memset(p_ptPool, 0, sizeof(*p_ptPool));
+    if (p_ptConfig)
+        p_ptPool->t_tConfig = *p_ptConfig;
+
+    if (p_ptPool->t_tConfig.t_iMaxPerEndpoint <= 0)
+        p_ptPool->t_tConfig.t_iMaxPerEndpoint = NETWORK_POOL_DEFAULT_MAX_PER_ENDPOINT;
+    if (p_ptPool->t_tConfig.t_iIdleTimeoutMs <= 0)
+        p_ptPool->t_tConfig.t_iIdleTimeoutMs = NETWORK_POOL_DEFAULT_IDLE_TIMEOUT;
+#ifdef USE_TLS
+    if (!p_ptPool->t_tConfig.t_pfConnect)
+        return NETWORK_INVALID_PARAM; // TLS sockets need their configuration
+#else
+    if (!p_ptPool->t_tConfig.t_pfConnect)
+        p_ptPool->t_tConfig.t_pfConnect = networkPoolConnectTcp;
+#endif
+
+    // Deadlines are taken on the monotonic clock
+    pthread_condattr_t l_tAttr;
+    pthread_condattr_init(&l_tAttr);
+    pthread_condattr_setclock(&l_tAttr, CLOCK_MONOTONIC);
+    int l_iResult = pthread_cond_init(&p_ptPool->t_tReleased, &l_tAttr);
+    pthread_condattr_destroy(&l_tAttr);
+    if (l_iResult != 0)
+        return NETWORK_ERROR;
+
+    if (pthread_mutex_init(&p_ptPool->t_tMutex, NULL) != 0)
+    {
+        pthread_cond_destroy(&p_ptPool->t_tReleased);
+        return NETWORK_ERROR;
+    }
+
+    return NETWORK_OK;
+}
+
+//////////////////////////////////
+/// xNetworkPoolAcquire
+//////////////////////////////////
+int xNetworkPoolAcquire(xNetworkPool_t *p_ptPool, const NetworkAddress *p_ptAddress, NetworkSocket **p_pptSocket)
+{
+    if (!p_ptPool || !p_ptAddress || !p_pptSocket)
+        return NETWORK_INVALID_PARAM;
+
+    *p_pptSocket = NULL;
+    int l_iWaitMs = p_ptPool->t_tConfig.t_iAcquireTimeoutMs;
+    struct timespec l_tDeadline;
+    osDeadlineAfter(&l_tDeadline, (l_iWaitMs > 0) ? (unsigned long)l_iWaitMs : 0);
+
+    pthread_mutex_lock(&p_ptPool->t_tMutex);
+    xNetworkPoolEndpoint_t *l_ptEndpoint = networkPoolFind(p_ptPool, p_ptAddress, true);
+    if (!l_ptEndpoint)
+    {
+        pthread_mutex_unlock(&p_ptPool->t_tMutex);
+        return NETWORK_ERROR;
+    }
+
+    for (;;)
+    {
+        networkPoolExpireAll(p_ptPool, l_ptEndpoint, xHorodateurGetNs());
+
+        if (l_ptEndpoint->t_iIdleCount > 0)
+        {
+            // Most recent first, it is the least likely to have been dropped by the peer
+            NetworkSocket *l_ptSocket = l_ptEndpoint->t_ptIdle[--l_ptEndpoint->t_iIdleCount].t_ptSocket;
+            pthread_mutex_unlock(&p_ptPool->t_tMutex);
+
+            bool l_bHealthy = networkPoolIsHealthy(l_ptSocket);
+            if (!l_bHealthy)
+                networkCloseSocket(l_ptSocket);
+
+            pthread_mutex_lock(&p_ptPool->t_tMutex);
+            if (l_bHealthy)
+            {
+                p_ptPool->t_ulReused++;
+                pthread_mutex_unlock(&p_ptPool->t_tMutex);
+                *p_pptSocket = l_ptSocket;
+                return NETWORK_OK;
+            }
+
+            l_ptEndpoint->t_iOpen--;
+            continue;
+        }
+
+        if (l_ptEndpoint->t_iOpen < p_ptPool->t_tConfig.t_iMaxPerEndpoint)
+        {
+            l_ptEndpoint->t_iOpen++;
+            pthread_mutex_unlock(&p_ptPool->t_tMutex);
+
+            NetworkSocket *l_ptSocket = p_ptPool->t_tConfig.t_pfConnect(p_ptAddress, p_ptPool->t_tConfig.t_pvConnectArg);
+
+            pthread_mutex_lock(&p_ptPool->t_tMutex);
+            if (!l_ptSocket)
+            {
+                l_ptEndpoint->t_iOpen--;
+                pthread_cond_broadcast(&p_ptPool->t_tReleased);
+                pthread_mutex_unlock(&p_ptPool->t_tMutex);
+                X_LOG_TRACE("xNetworkPoolAcquire: Connection to %s:%u failed", p_ptAddress->t_cAddress, p_ptAddress->t_usPort);
+                return NETWORK_ERROR;
+            }
+
+            p_ptPool->t_ulConnected++;
+            pthread_mutex_unlock(&p_ptPool->t_tMutex);
+            *p_pptSocket = l_ptSocket;
+            return NETWORK_OK;
+        }
+
+        // At the cap: wait for a release
+        int l_iWait = 0;
+        if (l_iWaitMs == 0)
+            l_iWait = ETIMEDOUT;
+        else if (l_iWaitMs < 0)
+            l_iWait = pthread_cond_wait(&p_ptPool->t_tReleased, &p_ptPool->t_tMutex);
+        else
+            l_iWait = pthread_cond_timedwait(&p_ptPool->t_tReleased, &p_ptPool->t_tMutex, &l_tDeadline);
+
+        if (l_iWait == ETIMEDOUT)
+        {
+            pthread_mutex_unlock(&p_ptPool->t_tMutex);
+            return NETWORK_TIMEOUT;
+        }
+    }
+}
+
+//////////////////////////////////
+/// xNetworkPoolRelease
+//////////////////////////////////
+int xNetworkPoolRelease(xNetworkPool_t *p_ptPool, const NetworkAddress *p_ptAddress, NetworkSocket *p_ptSocket, bool p_bReusable)
+{
+    if (!p_ptPool || !p_ptAddress || !p_ptSocket)
+        return NETWORK_INVALID_PARAM;
+
+    pthread_mutex_lock(&p_ptPool->t_tMutex);
+    xNetworkPoolEndpoint_t *l_ptEndpoint = networkPoolFind(p_ptPool, p_ptAddress, false);
+    if (!l_ptEndpoint)
+    {
+        pthread_mutex_unlock(&p_ptPool->t_tMutex);
+        return NETWORK_INVALID_PARAM;
+    }
+
+    bool l_bKeep = p_bReusable && networkIsConnected(p_ptSocket) &&
+                   l_ptEndpoint->t_iIdleCount < p_ptPool->t_tConfig.t_iMaxPerEndpoint;
+    if (l_bKeep)
+    {
+        xNetworkPoolIdle_t *l_ptIdle = &l_ptEndpoint->t_ptIdle[l_ptEndpoint->t_iIdleCount++];
+        l_ptIdle->t_ptSocket = p_ptSocket;
+        l_ptIdle->t_ulIdleSinceNs = xHorodateurGetNs();
+    }
+    else
+    {
+        l_ptEndpoint->t_iOpen--;
+    }
+    // Waiters of every endpoint share the condition, wake them all so the
+    // one waiting on this endpoint is among them
+    pthread_cond_broadcast(&p_ptPool->t_tReleased);
+    pthread_mutex_unlock(&p_ptPool->t_tMutex);
+
+    if (!l_bKeep)
+        networkCloseSocket(p_ptSocket);
+
+    return NETWORK_OK;
+}
+
+//////////////////////////////////
+/// xNetworkPoolPrune
+//////////////////////////////////
+int xNetworkPoolPrune(xNetworkPool_t *p_ptPool)
+{
+    if (!p_ptPool)
+        return NETWORK_INVALID_PARAM;
+
+    int l_iClosed = 0;
+    pthread_mutex_lock(&p_ptPool->t_tMutex);
+    uint64_t l_ulNowNs = xHorodateurGetNs();
+    for (int i = 0; i < p_ptPool->t_iEndpointCount; i++)
+    {
+        l_iClosed += networkPoolExpireAll(p_ptPool, &p_ptPool->t_tEndpoints[i], l_ulNowNs);
+    }
+    pthread_mutex_unlock(&p_ptPool->t_tMutex);
+
+    return l_iClosed;
+}
+
+//////////////////////////////////
+/// xNetworkPoolDestroy
+//////////////////////////////////
+int xNetworkPoolDestroy(xNetworkPool_t *p_ptPool)
+{
+    if (!p_ptPool)
+        return NETWORK_INVALID_PARAM;
+
+    for (int i = 0; i < p_ptPool->t_iEndpointCount; i++)
+    {
+        xNetworkPoolEndpoint_t *l_ptEndpoint = &p_ptPool->t_tEndpoints[i];
+        for (int j = 0; j < l_ptEndpoint->t_iIdleCount; j++)
+        {
+            networkCloseSocket(l_ptEndpoint->t_ptIdle[j].t_ptSocket);
+        }
+        X_FREE(l_ptEndpoint->t_ptIdle);
+    }
+
+    pthread_cond_destroy(&p_ptPool->t_tReleased);
+    pthread_mutex_destroy(&p_ptPool->t_tMutex);
+    memset(p_ptPool, 0, sizeof(*p_ptPool));
+    return NETWORK_OK;
+}
@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////
+//  Network connection pool header file
+//  Defines a pool of outbound connections kept open per endpoint
+//  and shared by several threads
+//
+// general disclosure: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+
+#ifndef NETWORK_POOL_H_
+#define NETWORK_POOL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#ifdef USE_TLS
+#include "xNetworkTls.h"
+#else
+#include "xNetwork.h"
+#endif
+
+// Configuration constants
+#define NETWORK_POOL_MAX_ENDPOINTS          16      // Distinct endpoints of one pool
+#define NETWORK_POOL_DEFAULT_MAX_PER_ENDPOINT 8     // Open connections per endpoint when 0 is configured
+#define NETWORK_POOL_DEFAULT_IDLE_TIMEOUT   30000   // Idle lifetime in milliseconds when 0 is configured
+
+// Opens a connected socket to an endpoint, NULL on failure
+typedef NetworkSocket *(*xNetworkPoolConnectFn)(const NetworkAddress *p_ptAddress, void *p_pvArg);
+
+// Pool configuration
+typedef struct
+{
+    int t_iMaxPerEndpoint;          // Open connections (idle and in use) per endpoint
+    int t_iIdleTimeoutMs;           // Idle connections older than this are closed
+    int t_iAcquireTimeoutMs;        // Wait for a connection when the cap is reached (-1 infinite, 0 none)
+    xNetworkPoolConnectFn t_pfConnect; // Connection factory (NULL for plain TCP, required with TLS)
+    void *t_pvConnectArg;           // Factory argument
+} xNetworkPoolConfig_t;
+
+// Idle connection
+typedef struct
+{
+    NetworkSocket *t_ptSocket;      // Connected socket
+    uint64_t t_ulIdleSinceNs;       // Release time (monotonic)
+} xNetworkPoolIdle_t;
+
+// Connections of one endpoint
+typedef struct
+{
+    NetworkAddress t_tAddress;      // Endpoint
+    int t_iOpen;                    // Idle, in use and being connected
+    int t_iIdleCount;               // Entries of t_ptIdle, the most recent last
+    xNetworkPoolIdle_t *t_ptIdle;   // Idle connections, t_iMaxPerEndpoint entries
+} xNetworkPoolEndpoint_t;
+
+//////////////////////////////////
+/// @brief pool state
+//////////////////////////////////
+typedef struct
+{
+    xNetworkPoolConfig_t t_tConfig;     // Configuration, defaults applied
+    pthread_mutex_t t_tMutex;           // Protects the endpoints
+    pthread_cond_t t_tReleased;         // Signalled when a connection slot frees up
+    int t_iEndpointCount;               // Endpoints in use
+    xNetworkPoolEndpoint_t t_tEndpoints[NETWORK_POOL_MAX_ENDPOINTS];
+    uint64_t t_ulReused;                // Acquires served by an idle connection
+    uint64_t t_ulConnected;             // Acquires that opened a connection
+} xNetworkPool_t;
+
+//////////////////////////////////
+/// @brief Create a connection pool
+/// @param p_ptPool Pool structure pointer
+/// @param p_ptConfig Configuration (copied, NULL for defaults)
+/// @return int Error code
+//////////////////////////////////
+int xNetworkPoolCreate(xNetworkPool_t *p_ptPool, const xNetworkPoolConfig_t *p_ptConfig);
+
+//////////////////////////////////
+/// @brief Get a connected socket to an endpoint
+/// @param p_ptPool Pool structure pointer
+/// @param p_ptAddress Endpoint
+/// @param p_pptSocket Filled with the socket
+/// @return int Error code, NETWORK_TIMEOUT when the endpoint stays at its cap
+/// @note the most recently used healthy idle connection is returned first,
+///       a new one is opened below the cap
+//////////////////////////////////
+int xNetworkPoolAcquire(xNetworkPool_t *p_ptPool, const NetworkAddress *p_ptAddress, NetworkSocket **p_pptSocket);
+
+//////////////////////////////////
+/// @brief Give a socket back to the pool
+/// @param p_ptPool Pool structure pointer
+/// @param p_ptAddress Endpoint the socket was acquired for
+/// @param p_ptSocket Socket from xNetworkPoolAcquire
+/// @param p_bReusable false after an I/O error or an unfinished exchange, the socket is closed
+/// @return int Error code
+//////////////////////////////////
+int xNetworkPoolRelease(xNetworkPool_t *p_ptPool, const NetworkAddress *p_ptAddress, NetworkSocket *p_ptSocket, bool p_bReusable);
+
+//////////////////////////////////
+/// @brief Close the idle connections past the idle timeout
+/// @param p_ptPool Pool structure pointer
+/// @return int Number of connections closed or error code
+//////////////////////////////////
+int xNetworkPoolPrune(xNetworkPool_t *p_ptPool);
+
+//////////////////////////////////
+/// @brief Close every idle connection and destroy the pool
+/// @param p_ptPool Pool structure pointer
+/// @return int Error code
+/// @note sockets still acquired must be released before
+//////////////////////////////////
+int xNetworkPoolDestroy(xNetworkPool_t *p_ptPool);
+
+#endif // NETWORK_POOL_H_
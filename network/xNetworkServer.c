@@ -0,0 +1,241 @@
+////////////////////////////////////////////////////////////
+//  Network server implementation file
+//  Implements the multi-listener server defined in xNetworkServer.h
+//
+// The kernel spreads incoming connections over the SO_REUSEPORT
+// listeners bound to the same address, each listener drains its own
+// queue from its own thread, so accepts do not serialize on one socket
+//
+// general disclosure: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+
+#ifndef USE_TLS
+
+#include "xNetworkServer.h"
+#include "xMemory.h"
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+//////////////////////////////////
+/// networkServerOnAccept
+//////////////////////////////////
+static void networkServerOnAccept(xNetworkLoop_t *p_ptLoop, NetworkSocket *p_ptSocket, void *p_pvArg)
+{
+    xNetworkServerListener_t *l_ptListener = (xNetworkServerListener_t *)p_pvArg;
+    const xNetworkServerConfig_t *l_ptConfig = &l_ptListener->t_ptServer->t_tConfig;
+    NetworkSocket *l_ptClients[NETWORK_ACCEPT_BATCH];
+    NetworkAddress l_tPeers[NETWORK_ACCEPT_BATCH];
+
+    // Drain the accept queue, a full batch means more may be pending
+    int l_iCount;
+    do
+    {
+        l_iCount = networkAcceptBatch(p_ptSocket, l_ptClients, l_tPeers, NETWORK_ACCEPT_BATCH);
+        if (l_iCount <= 0)
+            break;
+
+        atomic_fetch_add_explicit(&l_ptListener->a_ulAccepted, (unsigned long)l_iCount, memory_order_relaxed);
+        for (int i = 0; i < l_iCount; i++)
+        {
+            if (l_ptConfig->t_pfOnAccept)
+                l_ptConfig->t_pfOnAccept(p_ptLoop, l_ptClients[i], &l_tPeers[i], l_ptConfig->t_pvArg);
+            else
+                networkCloseSocket(l_ptClients[i]);
+        }
+    } while (l_iCount == NETWORK_ACCEPT_BATCH);
+}
+
+//////////////////////////////////
+/// networkServerTask
+//////////////////////////////////
+static void *networkServerTask(void *p_pvArg)
+{
+    xNetworkServerListener_t *l_ptListener = (xNetworkServerListener_t *)p_pvArg;
+    xNetworkLoopRun(&l_ptListener->t_tLoop);
+    return NULL;
+}
+
+//////////////////////////////////
+/// networkServerOpenListener
+//////////////////////////////////
+static int networkServerOpenListener(xNetworkServerListener_t *p_ptListener, const xNetworkServerConfig_t *p_ptConfig)
+{
+    NetworkSocketOptions l_tOptions;
+    if (p_ptConfig->t_ptOptions)
+        l_tOptions = *p_ptConfig->t_ptOptions;
+    else
+        memset(&l_tOptions, 0, sizeof(l_tOptions));
+    l_tOptions.t_bReusePort = true;
+
+    p_ptListener->t_ptListener = networkCreateSocketEx(NETWORK_SOCK_TCP, &l_tOptions);
+    if (!p_ptListener->t_ptListener)
+        return NETWORK_ERROR;
+
+    int l_iBacklog = (p_ptConfig->t_iBacklog > 0) ? p_ptConfig->t_iBacklog : NETWORK_SERVER_DEFAULT_BACKLOG;
+    if (networkBind(p_ptListener->t_ptListener, &p_ptConfig->t_tAddress) != (int)NETWORK_OK ||
+        networkListen(p_ptListener->t_ptListener, l_iBacklog) != (int)NETWORK_OK ||
+        networkSetNonBlocking(p_ptListener->t_ptListener, true) != (int)NETWORK_OK)
+    {
+        networkCloseSocket(p_ptListener->t_ptListener);
+        p_ptListener->t_ptListener = NULL;
+        return NETWORK_ERROR;
+    }
+
+    if (xNetworkLoopCreate(&p_ptListener->t_tLoop, p_ptConfig->t_ulLoopFlags) != (int)NETWORK_OK)
+    {
+        networkCloseSocket(p_ptListener->t_ptListener);
+        p_ptListener->t_ptListener = NULL;
+        return NETWORK_ERROR;
+    }
+
+    xNetworkLoopCallbacks_t l_tCallbacks = {networkServerOnAccept, NULL, NULL};
+    if (xNetworkLoopAdd(&p_ptListener->t_tLoop, p_ptListener->t_ptListener, NETWORK_LOOP_EVENT_READ,
+                        &l_tCallbacks, p_ptListener) != (int)NETWORK_OK)
+    {
+        xNetworkLoopDestroy(&p_ptListener->t_tLoop);
+        networkCloseSocket(p_ptListener->t_ptListener);
+        p_ptListener->t_ptListener = NULL;
+        return NETWORK_ERROR;
+    }
+
+    return NETWORK_OK;
+}
+
+//////////////////////////////////
+/// networkServerCloseListeners
+//////////////////////////////////
+static void networkServerCloseListeners(xNetworkServer_t *p_ptServer, int p_iCount)
+{
+    for (int i = 0; i < p_iCount; i++)
+    {
+        xNetworkServerListener_t *l_ptListener = &p_ptServer->t_ptListeners[i];
+        xNetworkLoopRemove(&l_ptListener->t_tLoop, l_ptListener->t_ptListener);
+        xNetworkLoopDestroy(&l_ptListener->t_tLoop);
+        networkCloseSocket(l_ptListener->t_ptListener);
+        l_ptListener->t_ptListener = NULL;
+    }
+}
+
+//////////////////////////////////
+/// xNetworkServerStart
+//////////////////////////////////
+int xNetworkServerStart(xNetworkServer_t *p_ptServer, const xNetworkServerConfig_t *p_ptConfig)
+{
+    if (!p_ptServer || !p_ptConfig)
+        return NETWORK_INVALID_PARAM;
+
+    long l_lCpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (l_lCpus < 1)
+        l_lCpus = 1;
+
+    int l_iCount = (p_ptConfig->t_iListeners > 0) ? p_ptConfig->t_iListeners : (int)l_lCpus;
+    if (l_iCount > NETWORK_SERVER_MAX_LISTENERS)
+        return NETWORK_INVALID_PARAM;
+
+    memset(p_ptServer, 0, sizeof(*p_ptServer));
+    p_ptServer->t_tConfig = *p_ptConfig;
+    p_ptServer->t_ptListeners = (xNetworkServerListener_t *)X_MALLOC(sizeof(xNetworkServerListener_t) * (size_t)l_iCount);
+    if (!p_ptServer->t_ptListeners)
+        return NETWORK_ERROR;
+    memset(p_ptServer->t_ptListeners, 0, sizeof(xNetworkServerListener_t) * (size_t)l_iCount);
+
+    // Open every listener before starting threads, a bind failure leaves nothing running
+    for (int i = 0; i < l_iCount; i++)
+    {
+        xNetworkServerListener_t *l_ptListener = &p_ptServer->t_ptListeners[i];
+        l_ptListener->t_ptServer = p_ptServer;
+        l_ptListener->t_iCpu = p_ptConfig->t_bPinThreads ? (int)(i % l_lCpus) : -1;
+        atomic_init(&l_ptListener->a_ulAccepted, 0);
+
+        if (networkServerOpenListener(l_ptListener, &p_ptServer->t_tConfig) != (int)NETWORK_OK)
+        {
+            X_LOG_TRACE("xNetworkServerStart: Listener %d on %s:%u failed", i,
+                        p_ptConfig->t_tAddress.t_cAddress, p_ptConfig->t_tAddress.t_usPort);
+            networkServerCloseListeners(p_ptServer, i);
+            X_FREE(p_ptServer->t_ptListeners);
+            p_ptServer->t_ptListeners = NULL;
+            return NETWORK_ERROR;
+        }
+    }
+    p_ptServer->t_iListenerCount = l_iCount;
+
+    for (int i = 0; i < l_iCount; i++)
+    {
+        xNetworkServerListener_t *l_ptListener = &p_ptServer->t_ptListeners[i];
+        osTaskInit(&l_ptListener->t_tTask);
+        l_ptListener->t_tTask.t_ptTask = networkServerTask;
+        l_ptListener->t_tTask.t_ptTaskArg = l_ptListener;
+        l_ptListener->t_tTask.t_ulStackSize = NETWORK_SERVER_STACK_SIZE;
+        l_ptListener->t_tTask.t_iPriority = OS_TASK_DEFAULT_PRIORITY;
+
+        if (osTaskCreate(&l_ptListener->t_tTask) != OS_TASK_SUCCESS)
+        {
+            // Stop the threads already running, then release everything
+            for (int j = 0; j < i; j++)
+            {
+                xNetworkLoopStop(&p_ptServer->t_ptListeners[j].t_tLoop);
+                osTaskWait(&p_ptServer->t_ptListeners[j].t_tTask, NULL);
+            }
+            networkServerCloseListeners(p_ptServer, l_iCount);
+            X_FREE(p_ptServer->t_ptListeners);
+            p_ptServer->t_ptListeners = NULL;
+            p_ptServer->t_iListenerCount = 0;
+            return NETWORK_ERROR;
+        }
+
+        // Pinning is best effort, the listener still serves from any CPU
+        if (l_ptListener->t_iCpu >= 0 && osTaskPinToCpu(&l_ptListener->t_tTask, l_ptListener->t_iCpu) != OS_TASK_SUCCESS)
+            X_LOG_TRACE("xNetworkServerStart: Pinning listener %d to CPU %d failed", i, l_ptListener->t_iCpu);
+    }
+
+    p_ptServer->t_bRunning = true;
+    X_LOG_TRACE("xNetworkServerStart: %d listeners on %s:%u", l_iCount,
+                p_ptConfig->t_tAddress.t_cAddress, p_ptConfig->t_tAddress.t_usPort);
+    return NETWORK_OK;
+}
+
+//////////////////////////////////
+/// xNetworkServerStop
+//////////////////////////////////
+int xNetworkServerStop(xNetworkServer_t *p_ptServer)
+{
+    if (!p_ptServer || !p_ptServer->t_bRunning)
+        return NETWORK_INVALID_PARAM;
+
+    for (int i = 0; i < p_ptServer->t_iListenerCount; i++)
+    {
+        xNetworkLoopStop(&p_ptServer->t_ptListeners[i].t_tLoop);
+    }
+    for (int i = 0; i < p_ptServer->t_iListenerCount; i++)
+    {
+        osTaskWait(&p_ptServer->t_ptListeners[i].t_tTask, NULL);
+    }
+
+    networkServerCloseListeners(p_ptServer, p_ptServer->t_iListenerCount);
+    X_FREE(p_ptServer->t_ptListeners);
+    p_ptServer->t_ptListeners = NULL;
+    p_ptServer->t_iListenerCount = 0;
+    p_ptServer->t_bRunning = false;
+    return NETWORK_OK;
+}
+
+//////////////////////////////////
+/// xNetworkServerGetAcceptedCount
+//////////////////////////////////
+uint64_t xNetworkServerGetAcceptedCount(const xNetworkServer_t *p_ptServer)
+{
+    if (!p_ptServer || !p_ptServer->t_ptListeners)
+        return 0;
+
+    uint64_t l_ulTotal = 0;
+    for (int i = 0; i < p_ptServer->t_iListenerCount; i++)
+    {
+        l_ulTotal += atomic_load_explicit(&p_ptServer->t_ptListeners[i].a_ulAccepted, memory_order_relaxed);
+    }
+
+    return l_ulTotal;
+}
+
+#endif // USE_TLS
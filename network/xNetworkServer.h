@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////
+//  Network server header file
+//  Defines a TCP server accepting on several SO_REUSEPORT
+//  listeners, each one with its own thread and reactor
+//
+// general disclosure: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+
+#ifndef NETWORK_SERVER_H_
+#define NETWORK_SERVER_H_
+
+#ifndef USE_TLS
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#include "xNetwork.h"
+#include "xNetworkLoop.h"
+#include "xNetworkOptions.h"
+#include "xTask.h"
+
+// Configuration constants
+#define NETWORK_SERVER_MAX_LISTENERS    64          // Listeners of one server
+#define NETWORK_SERVER_DEFAULT_BACKLOG  1024        // Pending connections per listener (capped by net.core.somaxconn)
+#define NETWORK_SERVER_STACK_SIZE       (256 * 1024) // Listener thread stack
+
+// New connection, called on the listener thread that accepted it
+// The client is non-blocking and may be added to p_ptLoop (same thread)
+typedef void (*xNetworkServerAcceptCallback)(xNetworkLoop_t *p_ptLoop, NetworkSocket *p_ptClient,
+                                             const NetworkAddress *p_ptPeer, void *p_pvArg);
+
+// Server configuration
+typedef struct
+{
+    NetworkAddress t_tAddress;                  // Listening address
+    int t_iListeners;                           // Listener threads (0 for one per online CPU)
+    int t_iBacklog;                             // listen() backlog (0 for NETWORK_SERVER_DEFAULT_BACKLOG)
+    bool t_bPinThreads;                         // Pin listener i to online CPU i modulo the CPU count
+    uint32_t t_ulLoopFlags;                     // NETWORK_LOOP_FLAG_* of each reactor
+    const NetworkSocketOptions *t_ptOptions;    // Listener options (SO_REUSEPORT is forced), may be NULL
+    xNetworkServerAcceptCallback t_pfOnAccept;  // New connection callback
+    void *t_pvArg;                              // Callback argument
+} xNetworkServerConfig_t;
+
+typedef struct xos_network_server_t xNetworkServer_t;
+
+// One listener with its reactor and thread
+typedef struct
+{
+    xNetworkServer_t *t_ptServer;               // Owning server
+    int t_iCpu;                                 // Pinned CPU (-1 when not pinned)
+    NetworkSocket *t_ptListener;                // SO_REUSEPORT listening socket
+    xNetworkLoop_t t_tLoop;                     // Reactor of the listener thread
+    xOsTaskCtx t_tTask;                         // Listener thread
+    atomic_ulong a_ulAccepted;                  // Connections accepted
+} xNetworkServerListener_t;
+
+//////////////////////////////////
+/// @brief server state
+//////////////////////////////////
+struct xos_network_server_t
+{
+    xNetworkServerConfig_t t_tConfig;           // Copy of the configuration
+    int t_iListenerCount;                       // Number of listeners
+    xNetworkServerListener_t *t_ptListeners;    // Listeners
+    bool t_bRunning;                            // Threads started
+};
+
+//////////////////////////////////
+/// @brief Create the listeners and start their threads
+/// @param p_ptServer Server structure pointer
+/// @param p_ptConfig Configuration (copied)
+/// @return int Error code
+//////////////////////////////////
+int xNetworkServerStart(xNetworkServer_t *p_ptServer, const xNetworkServerConfig_t *p_ptConfig);
+
+//////////////////////////////////
+/// @brief Stop the listener threads and close the listeners
+/// @param p_ptServer Server structure pointer
+/// @return int Error code
+/// @note sockets added to the listener loops by t_pfOnAccept are not closed
+//////////////////////////////////
+int xNetworkServerStop(xNetworkServer_t *p_ptServer);
+
+//////////////////////////////////
+/// @brief Get the number of connections accepted by every listener
+/// @param p_ptServer Server structure pointer
+/// @return uint64_t Accepted connections
+//////////////////////////////////
+uint64_t xNetworkServerGetAcceptedCount(const xNetworkServer_t *p_ptServer);
+
+#endif // USE_TLS
+
+#endif // NETWORK_SERVER_H_
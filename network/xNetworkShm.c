@@ -0,0 +1,470 @@
+////////////////////////////////////////////////////////////
+//  Network shared memory implementation file
+//  Implements the channels defined in xNetworkShm.h
+//
+// A ring position grows without bound, its offset is the position
+// masked by the ring size. A record is a header (payload size) and the
+// 8-byte aligned payload, always contiguous: a record that would cross
+// the end is preceded by a wrap marker filling the rest of the ring.
+// Each side sleeps on a futex word of the shared segment (not process
+// private), bumped by the other side only when its waiter count is set
+//
+// general disclosure: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+
+#include "xNetworkShm.h"
+#include "xOsFutex.h"
+#include "xMemory.h"
+#include <stdatomic.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define NETWORK_SHM_MAGIC       0x53484D31U     // Segment initialised ("SHM1")
+#define NETWORK_SHM_WRAP        0xFFFFFFFFU     // Record header: skip to the ring start
+#define NETWORK_SHM_CACHE_LINE  64
+
+// One direction, producer and consumer words on their own cache lines
+typedef struct xos_network_shm_ring_t
+{
+    _Atomic uint64_t a_ulTail;          // Next byte written
+    atomic_uint a_uiDataSeq;            // Futex word the consumer sleeps on
+    atomic_uint a_uiDataWaiters;        // Consumer asleep or about to be
+    char t_cPadTail[NETWORK_SHM_CACHE_LINE - 16];
+    _Atomic uint64_t a_ulHead;          // Next byte read
+    atomic_uint a_uiRoomSeq;            // Futex word the producer sleeps on
+    atomic_uint a_uiRoomWaiters;        // Producer asleep or about to be
+    char t_cPadHead[NETWORK_SHM_CACHE_LINE - 16];
+} NetworkShmRing;
+
+// Start of the segment, the data of both rings follow it
+typedef struct xos_network_shm_header_t
+{
+    atomic_uint a_uiMagic;              // NETWORK_SHM_MAGIC once initialised
+    uint32_t t_ulRingSize;              // Bytes per ring
+    atomic_uint a_uiPeer;               // 1 once a peer opened the channel
+    atomic_uint a_uiClosed[2];          // Side closed its endpoint
+    char t_cPad[NETWORK_SHM_CACHE_LINE - 20];
+    NetworkShmRing t_tRings[2];         // Ring 0 from the creator, ring 1 from the peer
+} __attribute__((aligned(NETWORK_SHM_CACHE_LINE))) NetworkShmHeader;
+
+//////////////////////////////////
+/// networkShmRecordSize
+//////////////////////////////////
+static inline uint64_t networkShmRecordSize(uint32_t p_ulSize)
+{
+    return NETWORK_SHM_RECORD_HEADER + (((uint64_t)p_ulSize + 7U) & ~(uint64_t)7U);
+}
+
+//////////////////////////////////
+/// networkShmMakeName
+//////////////////////////////////
+static int networkShmMakeName(const char *p_pcName, char *p_pcOut)
+{
+    if (!p_pcName || !p_pcName[0])
+        return NETWORK_INVALID_PARAM;
+
+    int l_iLen = snprintf(p_pcOut, NETWORK_SHM_NAME_MAX, "%s%s", p_pcName[0] == '/' ? "" : "/", p_pcName);
+    if (l_iLen <= 1 || l_iLen >= NETWORK_SHM_NAME_MAX || strchr(p_pcOut + 1, '/'))
+        return NETWORK_INVALID_PARAM;
+
+    return NETWORK_OK;
+}
+
+//////////////////////////////////
+/// networkShmDeadline
+//////////////////////////////////
+static const struct timespec *networkShmDeadline(int p_iTimeoutMs, struct timespec *p_ptDeadline)
+{
+    if (p_iTimeoutMs <= 0)
+        return NULL;
+
+    osDeadlineAfter(p_ptDeadline, (unsigned long)p_iTimeoutMs);
+    return p_ptDeadline;
+}
+
+//////////////////////////////////
+/// networkShmWake
+//////////////////////////////////
+static void networkShmWake(atomic_uint *p_puiSeq, atomic_uint *p_puiWaiters)
+{
+    // Pairs with the waiter registration in networkShmWait
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(p_puiWaiters, memory_order_relaxed) == 0)
+        return;
+
+    atomic_fetch_add_explicit(p_puiSeq, 1, memory_order_release);
+    osFutexWake(p_puiSeq, INT_MAX, true);
+}
+
+//////////////////////////////////
+/// networkShmWait
+//////////////////////////////////
+static int networkShmWait(atomic_uint *p_puiSeq, atomic_uint *p_puiWaiters, _Atomic uint64_t *p_pulWatched,
+                          uint64_t p_ulSeen, atomic_uint *p_puiClosed, const struct timespec *p_ptDeadline)
+{
+    int l_iResult = NETWORK_OK;
+
+    atomic_fetch_add_explicit(p_puiWaiters, 1, memory_order_seq_cst);
+    unsigned int l_uiSeq = atomic_load_explicit(p_puiSeq, memory_order_acquire);
+    if (atomic_load_explicit(p_pulWatched, memory_order_seq_cst) == p_ulSeen &&
+        !atomic_load_explicit(p_puiClosed, memory_order_acquire))
+    {
+        // Shared futex: the words live in a mapping of several processes
+        if (!osFutexWait(p_puiSeq, l_uiSeq, p_ptDeadline, true))
+            l_iResult = NETWORK_TIMEOUT;
+    }
+    atomic_fetch_sub_explicit(p_puiWaiters, 1, memory_order_relaxed);
+
+    return l_iResult;
+}
+
+//////////////////////////////////
+/// networkShmAttach
+//////////////////////////////////
+static NetworkShmChannel *networkShmAttach(NetworkShmHeader *p_ptHeader, size_t p_ulMapSize, uint32_t p_ulRingSize,
+                                           int p_iSide, const char *p_pcName)
+{
+    NetworkShmChannel *l_ptChannel = (NetworkShmChannel *)X_MALLOC(sizeof(NetworkShmChannel));
+    if (!l_ptChannel)
+        return NULL;
+
+    memset(l_ptChannel, 0, sizeof(NetworkShmChannel));
+    uint8_t *l_pucData = (uint8_t *)p_ptHeader + sizeof(NetworkShmHeader);
+    l_ptChannel->t_ptHeader = p_ptHeader;
+    l_ptChannel->t_ulMapSize = p_ulMapSize;
+    l_ptChannel->t_ulRingSize = p_ulRingSize;
+    l_ptChannel->t_iSide = p_iSide;
+    l_ptChannel->t_ptTxRing = &p_ptHeader->t_tRings[p_iSide];
+    l_ptChannel->t_ptRxRing = &p_ptHeader->t_tRings[1 - p_iSide];
+    l_ptChannel->t_pucTx = l_pucData + (size_t)p_iSide * p_ulRingSize;
+    l_ptChannel->t_pucRx = l_pucData + (size_t)(1 - p_iSide) * p_ulRingSize;
+    strncpy(l_ptChannel->t_cName, p_pcName, NETWORK_SHM_NAME_MAX - 1);
+
+    return l_ptChannel;
+}
+
+//////////////////////////////////
+/// networkShmCreate
+//////////////////////////////////
+NetworkShmChannel *networkShmCreate(const char *p_pcName, uint32_t p_ulRingSize)
+{
+    char l_cName[NETWORK_SHM_NAME_MAX];
+    if (networkShmMakeName(p_pcName, l_cName) != (int)NETWORK_OK)
+        return NULL;
+
+    uint32_t l_ulRingSize = NETWORK_SHM_MIN_RING;
+    uint32_t l_ulWanted = p_ulRingSize ? p_ulRingSize : NETWORK_SHM_DEFAULT_RING;
+    if (l_ulWanted > NETWORK_SHM_MAX_RING)
+        return NULL;
+    while (l_ulRingSize < l_ulWanted)
+        l_ulRingSize <<= 1;
+
+    // A segment left by a previous run is replaced, never shared
+    shm_unlink(l_cName);
+    int l_iFd = shm_open(l_cName, O_CREAT | O_EXCL | O_RDWR | O_CLOEXEC, 0600);
+    if (l_iFd < 0)
+    {
+        X_LOG_TRACE("networkShmCreate: shm_open %s failed, errno %d", l_cName, errno);
+        return NULL;
+    }
+
+    size_t l_ulMapSize = sizeof(NetworkShmHeader) + 2 * (size_t)l_ulRingSize;
+    if (ftruncate(l_iFd, (off_t)l_ulMapSize) != 0)
+    {
+        close(l_iFd);
+        shm_unlink(l_cName);
+        return NULL;
+    }
+
+    void *l_pMap = mmap(NULL, l_ulMapSize, PROT_READ | PROT_WRITE, MAP_SHARED, l_iFd, 0);
+    close(l_iFd);
+    if (l_pMap == MAP_FAILED)
+    {
+        shm_unlink(l_cName);
+        return NULL;
+    }
+
+    // The new segment reads as zeros, the magic publishes the rest
+    NetworkShmHeader *l_ptHeader = (NetworkShmHeader *)l_pMap;
+    l_ptHeader->t_ulRingSize = l_ulRingSize;
+    atomic_store_explicit(&l_ptHeader->a_uiMagic, NETWORK_SHM_MAGIC, memory_order_release);
+
+    NetworkShmChannel *l_ptChannel = networkShmAttach(l_ptHeader, l_ulMapSize, l_ulRingSize, 0, l_cName);
+    if (!l_ptChannel)
+    {
+        munmap(l_pMap, l_ulMapSize);
+        shm_unlink(l_cName);
+    }
+    return l_ptChannel;
+}
+
+//////////////////////////////////
+/// networkShmOpen
+//////////////////////////////////
+NetworkShmChannel *networkShmOpen(const char *p_pcName)
+{
+    char l_cName[NETWORK_SHM_NAME_MAX];
+    if (networkShmMakeName(p_pcName, l_cName) != (int)NETWORK_OK)
+        return NULL;
+
+    int l_iFd = shm_open(l_cName, O_RDWR | O_CLOEXEC, 0);
+    if (l_iFd < 0)
+        return NULL;
+
+    struct stat l_tStat;
+    if (fstat(l_iFd, &l_tStat) != 0 || (size_t)l_tStat.st_size < sizeof(NetworkShmHeader))
+    {
+        close(l_iFd);
+        return NULL;
+    }
+
+    size_t l_ulMapSize = (size_t)l_tStat.st_size;
+    void *l_pMap = mmap(NULL, l_ulMapSize, PROT_READ | PROT_WRITE, MAP_SHARED, l_iFd, 0);
+    close(l_iFd);
+    if (l_pMap == MAP_FAILED)
+        return NULL;
+
+    // The ring size comes from the peer, read once and held to the bounds networkShmCreate uses
+    NetworkShmHeader *l_ptHeader = (NetworkShmHeader *)l_pMap;
+    bool l_bMagic = atomic_load_explicit(&l_ptHeader->a_uiMagic, memory_order_acquire) == NETWORK_SHM_MAGIC;
+    uint32_t l_ulRingSize = l_ptHeader->t_ulRingSize;
+    unsigned int l_uiFree = 0;
+    if (!l_bMagic ||
+        l_ulRingSize < NETWORK_SHM_MIN_RING || l_ulRingSize > NETWORK_SHM_MAX_RING ||
+        (l_ulRingSize & (l_ulRingSize - 1)) != 0 ||
+        sizeof(NetworkShmHeader) + 2 * (size_t)l_ulRingSize != l_ulMapSize ||
+        atomic_load(&l_ptHeader->a_uiClosed[0]) ||
+        !atomic_compare_exchange_strong(&l_ptHeader->a_uiPeer, &l_uiFree, 1U))
+    {
+        X_LOG_TRACE("networkShmOpen: %s is not a free channel", l_cName);
+        munmap(l_pMap, l_ulMapSize);
+        return NULL;
+    }
+
+    NetworkShmChannel *l_ptChannel = networkShmAttach(l_ptHeader, l_ulMapSize, l_ulRingSize, 1, l_cName);
+    if (!l_ptChannel)
+        munmap(l_pMap, l_ulMapSize);
+    return l_ptChannel;
+}
+
+//////////////////////////////////
+/// networkShmClose
+//////////////////////////////////
+int networkShmClose(NetworkShmChannel *p_ptChannel)
+{
+    if (!p_ptChannel || !p_ptChannel->t_ptHeader)
+        return NETWORK_INVALID_PARAM;
+
+    // The peer may sleep for data from us or for room towards us, both are woken
+    NetworkShmHeader *l_ptHeader = p_ptChannel->t_ptHeader;
+    atomic_store_explicit(&l_ptHeader->a_uiClosed[p_ptChannel->t_iSide], 1U, memory_order_seq_cst);
+    atomic_fetch_add(&p_ptChannel->t_ptTxRing->a_uiDataSeq, 1);
+    osFutexWake(&p_ptChannel->t_ptTxRing->a_uiDataSeq, INT_MAX, true);
+    atomic_fetch_add(&p_ptChannel->t_ptRxRing->a_uiRoomSeq, 1);
+    osFutexWake(&p_ptChannel->t_ptRxRing->a_uiRoomSeq, INT_MAX, true);
+
+    munmap(l_ptHeader, p_ptChannel->t_ulMapSize);
+    if (p_ptChannel->t_iSide == 0)
+        shm_unlink(p_ptChannel->t_cName);
+
+    p_ptChannel->t_ptHeader = NULL;
+    X_FREE(p_ptChannel);
+    return NETWORK_OK;
+}
+
+//////////////////////////////////
+/// networkShmSetNonBlocking
+//////////////////////////////////
+int networkShmSetNonBlocking(NetworkShmChannel *p_ptChannel, bool p_bNonBlocking)
+{
+    if (!p_ptChannel)
+        return NETWORK_INVALID_PARAM;
+
+    p_ptChannel->t_bNonBlocking = p_bNonBlocking;
+    return NETWORK_OK;
+}
+
+//////////////////////////////////
+/// networkShmSetTimeout
+//////////////////////////////////
+int networkShmSetTimeout(NetworkShmChannel *p_ptChannel, int p_iTimeoutMs, bool p_bSendTimeout)
+{
+    if (!p_ptChannel || p_iTimeoutMs < 0)
+        return NETWORK_INVALID_PARAM;
+
+    if (p_bSendTimeout)
+        p_ptChannel->t_iSendTimeoutMs = p_iTimeoutMs;
+    else
+        p_ptChannel->t_iReceiveTimeoutMs = p_iTimeoutMs;
+    return NETWORK_OK;
+}
+
+//////////////////////////////////
+/// networkShmMaxMessage
+//////////////////////////////////
+uint32_t networkShmMaxMessage(const NetworkShmChannel *p_ptChannel)
+{
+    // A record and the wrap marker before it fit in the ring
+    return p_ptChannel ? p_ptChannel->t_ulRingSize / 2 - NETWORK_SHM_RECORD_HEADER : 0;
+}
+
+//////////////////////////////////
+/// networkShmReserve
+//////////////////////////////////
+int networkShmReserve(NetworkShmChannel *p_ptChannel, uint32_t p_ulSize, void **p_ppBuffer)
+{
+    if (!p_ptChannel || !p_ptChannel->t_ptHeader || !p_ppBuffer || p_ulSize > networkShmMaxMessage(p_ptChannel))
+        return NETWORK_INVALID_PARAM;
+
+    NetworkShmRing *l_ptRing = p_ptChannel->t_ptTxRing;
+    atomic_uint *l_puiPeerClosed = &p_ptChannel->t_ptHeader->a_uiClosed[1 - p_ptChannel->t_iSide];
+    uint64_t l_ulRing = p_ptChannel->t_ulRingSize;
+    uint64_t l_ulRecord = networkShmRecordSize(p_ulSize);
+    uint64_t l_ulTail = atomic_load_explicit(&l_ptRing->a_ulTail, memory_order_relaxed);
+    uint64_t l_ulOffset = l_ulTail & (l_ulRing - 1);
+    uint64_t l_ulToEnd = l_ulRing - l_ulOffset;
+    uint64_t l_ulNeeded = (l_ulToEnd < l_ulRecord) ? l_ulToEnd + l_ulRecord : l_ulRecord;
+
+    struct timespec l_tDeadline;
+    const struct timespec *l_ptDeadline = networkShmDeadline(p_ptChannel->t_iSendTimeoutMs, &l_tDeadline);
+    bool l_bExpired = false;
+    for (;;)
+    {
+        // Nobody would read what is sent now
+        if (atomic_load_explicit(l_puiPeerClosed, memory_order_acquire))
+            return NETWORK_CLOSED;
+
+        uint64_t l_ulHead = atomic_load_explicit(&l_ptRing->a_ulHead, memory_order_acquire);
+        if (l_ulRing - (l_ulTail - l_ulHead) >= l_ulNeeded)
+            break;
+        if (p_ptChannel->t_bNonBlocking)
+            return NETWORK_WOULD_BLOCK;
+        if (l_bExpired)
+            return NETWORK_TIMEOUT;
+
+        l_bExpired = networkShmWait(&l_ptRing->a_uiRoomSeq, &l_ptRing->a_uiRoomWaiters, &l_ptRing->a_ulHead,
+                                    l_ulHead, l_puiPeerClosed, l_ptDeadline) == (int)NETWORK_TIMEOUT;
+    }
+
+    // The marker is published at once, the consumer skips it on its own
+    if (l_ulToEnd < l_ulRecord)
+    {
+        *(uint32_t *)(p_ptChannel->t_pucTx + l_ulOffset) = NETWORK_SHM_WRAP;
+        l_ulTail += l_ulToEnd;
+        l_ulOffset = 0;
+        atomic_store_explicit(&l_ptRing->a_ulTail, l_ulTail, memory_order_release);
+    }
+
+    p_ptChannel->t_ulReserved = p_ulSize;
+    *p_ppBuffer = p_ptChannel->t_pucTx + l_ulOffset + NETWORK_SHM_RECORD_HEADER;
+    return NETWORK_OK;
+}
+
+//////////////////////////////////
+/// networkShmCommit
+//////////////////////////////////
+int networkShmCommit(NetworkShmChannel *p_ptChannel, uint32_t p_ulSize)
+{
+    if (!p_ptChannel || !p_ptChannel->t_ptHeader || p_ulSize > p_ptChannel->t_ulReserved)
+        return NETWORK_INVALID_PARAM;
+
+    NetworkShmRing *l_ptRing = p_ptChannel->t_ptTxRing;
+    uint64_t l_ulTail = atomic_load_explicit(&l_ptRing->a_ulTail, memory_order_relaxed);
+    *(uint32_t *)(p_ptChannel->t_pucTx + (l_ulTail & (p_ptChannel->t_ulRingSize - 1))) = p_ulSize;
+    atomic_store_explicit(&l_ptRing->a_ulTail, l_ulTail + networkShmRecordSize(p_ulSize), memory_order_release);
+    p_ptChannel->t_ulReserved = 0;
+
+    networkShmWake(&l_ptRing->a_uiDataSeq, &l_ptRing->a_uiDataWaiters);
+    return NETWORK_OK;
+}
+
+//////////////////////////////////
+/// networkShmSendMessage
+//////////////////////////////////
+int networkShmSendMessage(NetworkShmChannel *p_ptChannel, const void *p_pData, uint32_t p_ulSize)
+{
+    if (!p_pData && p_ulSize > 0)
+        return NETWORK_INVALID_PARAM;
+
+    void *l_pBuffer = NULL;
+    int l_iResult = networkShmReserve(p_ptChannel, p_ulSize, &l_pBuffer);
+    if (l_iResult != (int)NETWORK_OK)
+        return l_iResult;
+
+    if (p_ulSize > 0)
+        memcpy(l_pBuffer, p_pData, p_ulSize);
+    return networkShmCommit(p_ptChannel, p_ulSize);
+}
+
+//////////////////////////////////
+/// networkShmReceiveMessage
+//////////////////////////////////
+int networkShmReceiveMessage(NetworkShmChannel *p_ptChannel, NetworkFrameView *p_ptView)
+{
+    if (!p_ptChannel || !p_ptChannel->t_ptHeader || !p_ptView)
+        return NETWORK_INVALID_PARAM;
+
+    NetworkShmRing *l_ptRing = p_ptChannel->t_ptRxRing;
+    atomic_uint *l_puiPeerClosed = &p_ptChannel->t_ptHeader->a_uiClosed[1 - p_ptChannel->t_iSide];
+    uint64_t l_ulRing = p_ptChannel->t_ulRingSize;
+    uint64_t l_ulHead = atomic_load_explicit(&l_ptRing->a_ulHead, memory_order_relaxed);
+
+    // The previous view is released by this call
+    if (p_ptChannel->t_ulConsume)
+    {
+        l_ulHead += p_ptChannel->t_ulConsume;
+        p_ptChannel->t_ulConsume = 0;
+        atomic_store_explicit(&l_ptRing->a_ulHead, l_ulHead, memory_order_release);
+        networkShmWake(&l_ptRing->a_uiRoomSeq, &l_ptRing->a_uiRoomWaiters);
+    }
+
+    struct timespec l_tDeadline;
+    const struct timespec *l_ptDeadline = networkShmDeadline(p_ptChannel->t_iReceiveTimeoutMs, &l_tDeadline);
+    bool l_bExpired = false;
+    for (;;)
+    {
+        // Closed is read first, a message committed before the close is still handed out
+        bool l_bClosed = atomic_load_explicit(l_puiPeerClosed, memory_order_acquire) != 0;
+        uint64_t l_ulTail = atomic_load_explicit(&l_ptRing->a_ulTail, memory_order_acquire);
+        if (l_ulTail != l_ulHead)
+        {
+            uint64_t l_ulOffset = l_ulHead & (l_ulRing - 1);
+            uint64_t l_ulAvailable = l_ulTail - l_ulHead;
+            uint32_t l_ulSize = *(const uint32_t *)(p_ptChannel->t_pucRx + l_ulOffset);
+            if (l_ulSize == NETWORK_SHM_WRAP)
+            {
+                if (l_ulRing - l_ulOffset > l_ulAvailable)
+                    return NETWORK_ERROR;
+                l_ulHead += l_ulRing - l_ulOffset;
+                atomic_store_explicit(&l_ptRing->a_ulHead, l_ulHead, memory_order_release);
+                networkShmWake(&l_ptRing->a_uiRoomSeq, &l_ptRing->a_uiRoomWaiters);
+                continue;
+            }
+
+            // The prefix is written by the peer, a record must stay inside the ring and the committed bytes
+            uint64_t l_ulRecord = networkShmRecordSize(l_ulSize);
+            if (l_ulSize > networkShmMaxMessage(p_ptChannel) || l_ulOffset + l_ulRecord > l_ulRing ||
+                l_ulRecord > l_ulAvailable)
+                return NETWORK_ERROR;
+
+            p_ptView->t_pucData = p_ptChannel->t_pucRx + l_ulOffset + NETWORK_SHM_RECORD_HEADER;
+            p_ptView->t_ulSize = l_ulSize;
+            p_ptChannel->t_ulConsume = l_ulRecord;
+            return (int)l_ulSize;
+        }
+
+        if (l_bClosed)
+            return NETWORK_CLOSED;
+        if (p_ptChannel->t_bNonBlocking)
+            return NETWORK_WOULD_BLOCK;
+        if (l_bExpired)
+            return NETWORK_TIMEOUT;
+
+        l_bExpired = networkShmWait(&l_ptRing->a_uiDataSeq, &l_ptRing->a_uiDataWaiters, &l_ptRing->a_ulTail,
+                                    l_ulHead, l_puiPeerClosed, l_ptDeadline) == (int)NETWORK_TIMEOUT;
+    }
+}
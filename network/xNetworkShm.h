@@ -0,0 +1,148 @@
+////////////////////////////////////////////////////////////
+//  Network shared memory header file
+//  Defines framed messages between processes of one host
+//
+// A channel is a named POSIX shared memory segment holding two single
+// producer single consumer rings, one per direction. The creator sends
+// on the first ring and the peer that opens the channel on the second.
+// A message is written once into the ring and received as a view into
+// it, and the futex words of the rings are only woken when the other
+// side sleeps, so a busy channel exchanges messages without syscalls.
+// The calls mirror networkSendMessage / networkReceiveMessage
+//
+// general disclosure: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+
+#ifndef NETWORK_SHM_H_
+#define NETWORK_SHM_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "xNetworkFrame.h"
+
+// Configuration constants
+#define NETWORK_SHM_NAME_MAX        64                  // Segment name, with the leading '/'
+#define NETWORK_SHM_DEFAULT_RING    (256 * 1024)        // Ring size when 0 is configured
+#define NETWORK_SHM_MIN_RING        4096
+#define NETWORK_SHM_MAX_RING        (64 * 1024 * 1024)
+#define NETWORK_SHM_RECORD_HEADER   8                   // Bytes before each payload, payloads are 8-byte aligned
+
+struct xos_network_shm_header_t;
+struct xos_network_shm_ring_t;
+
+// Local endpoint of a channel
+typedef struct
+{
+    struct xos_network_shm_header_t *t_ptHeader;    // Mapped segment
+    size_t t_ulMapSize;                             // Mapped bytes
+    struct xos_network_shm_ring_t *t_ptTxRing;      // Ring this endpoint produces
+    struct xos_network_shm_ring_t *t_ptRxRing;      // Ring this endpoint consumes
+    uint8_t *t_pucTx;                               // Data of the produced ring
+    uint8_t *t_pucRx;                               // Data of the consumed ring
+    uint32_t t_ulRingSize;                          // Bytes per ring, power of two
+    int t_iSide;                                    // 0 for the creator, 1 for the peer
+    bool t_bNonBlocking;                            // Operations return NETWORK_WOULD_BLOCK
+    int t_iSendTimeoutMs;                           // 0 for no timeout
+    int t_iReceiveTimeoutMs;                        // 0 for no timeout
+    uint64_t t_ulConsume;                           // Ring bytes of the view handed out by the last receive
+    uint32_t t_ulReserved;                          // Payload bytes reserved by networkShmReserve
+    char t_cName[NETWORK_SHM_NAME_MAX];
+} NetworkShmChannel;
+
+//////////////////////////////////
+/// @brief Create a channel
+/// @param p_pcName Channel name, a '/' is prepended when missing
+/// @param p_ulRingSize Bytes per direction, rounded up to a power of two (0 for NETWORK_SHM_DEFAULT_RING)
+/// @return NetworkShmChannel* Channel handle or NULL on error
+/// @note an existing segment of the same name is replaced
+//////////////////////////////////
+NetworkShmChannel *networkShmCreate(const char *p_pcName, uint32_t p_ulRingSize);
+
+//////////////////////////////////
+/// @brief Open the channel created by another process
+/// @param p_pcName Channel name given to networkShmCreate
+/// @return NetworkShmChannel* Channel handle or NULL on error
+/// @note a channel has one peer, a second open fails until the creator makes a new channel
+//////////////////////////////////
+NetworkShmChannel *networkShmOpen(const char *p_pcName);
+
+//////////////////////////////////
+/// @brief Close a channel endpoint
+/// @param p_ptChannel Channel handle
+/// @return int Error code
+/// @note the other side gets NETWORK_CLOSED once it has read what was sent,
+///       the creator also removes the segment name
+//////////////////////////////////
+int networkShmClose(NetworkShmChannel *p_ptChannel);
+
+//////////////////////////////////
+/// @brief Switch the non-blocking mode
+/// @param p_ptChannel Channel handle
+/// @param p_bNonBlocking True to return NETWORK_WOULD_BLOCK instead of waiting
+/// @return int Error code
+//////////////////////////////////
+int networkShmSetNonBlocking(NetworkShmChannel *p_ptChannel, bool p_bNonBlocking);
+
+//////////////////////////////////
+/// @brief Set the timeout of send or receive operations
+/// @param p_ptChannel Channel handle
+/// @param p_iTimeoutMs Timeout in milliseconds (0 to disable timeout)
+/// @param p_bSendTimeout True for send timeout, false for receive timeout
+/// @return int Error code
+//////////////////////////////////
+int networkShmSetTimeout(NetworkShmChannel *p_ptChannel, int p_iTimeoutMs, bool p_bSendTimeout);
+
+//////////////////////////////////
+/// @brief Send one message
+/// @param p_ptChannel Channel handle
+/// @param p_pData Payload (may be NULL when p_ulSize is 0)
+/// @param p_ulSize Payload size (at most networkShmMaxMessage)
+/// @return int Error code (NETWORK_CLOSED when the peer closed, NETWORK_TIMEOUT
+///         when the send timeout expires while the ring is full)
+/// @note one thread at a time may send on a channel endpoint
+//////////////////////////////////
+int networkShmSendMessage(NetworkShmChannel *p_ptChannel, const void *p_pData, uint32_t p_ulSize);
+
+//////////////////////////////////
+/// @brief Reserve room for a message written in place
+/// @param p_ptChannel Channel handle
+/// @param p_ulSize Largest payload size that will be committed
+/// @param p_ppBuffer Filled with the payload address in the ring
+/// @return int Error code, as networkShmSendMessage
+/// @note the message is sent by networkShmCommit, nothing is copied
+//////////////////////////////////
+int networkShmReserve(NetworkShmChannel *p_ptChannel, uint32_t p_ulSize, void **p_ppBuffer);
+
+//////////////////////////////////
+/// @brief Send the message written in the reserved room
+/// @param p_ptChannel Channel handle
+/// @param p_ulSize Payload size, at most the reserved size
+/// @return int Error code
+//////////////////////////////////
+int networkShmCommit(NetworkShmChannel *p_ptChannel, uint32_t p_ulSize);
+
+//////////////////////////////////
+/// @brief Receive one message
+/// @param p_ptChannel Channel handle
+/// @param p_ptView Filled with the payload view
+/// @return int Payload size, NETWORK_CLOSED when the peer closed, or error code
+///         (NETWORK_WOULD_BLOCK in non-blocking mode, NETWORK_TIMEOUT when the
+///         receive timeout expires, NETWORK_ERROR when the next record size is
+///         corrupt, the record is then left in the ring)
+/// @note the view points into the ring and stays valid until the next
+///       networkShmReceiveMessage or networkShmClose call on the channel;
+///       one thread at a time may receive on a channel endpoint
+//////////////////////////////////
+int networkShmReceiveMessage(NetworkShmChannel *p_ptChannel, NetworkFrameView *p_ptView);
+
+//////////////////////////////////
+/// @brief Get the largest message a channel carries
+/// @param p_ptChannel Channel handle
+/// @return uint32_t Payload bytes
+//////////////////////////////////
+uint32_t networkShmMaxMessage(const NetworkShmChannel *p_ptChannel);
+
+#endif // NETWORK_SHM_H_
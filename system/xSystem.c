@@ -0,0 +1,690 @@
+////////////////////////////////////////////////////////////
+//  system source file
+//  implements the subsystem bootstrap
+//
+// general discloser: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+
+#include "xSystem.h"
+#include "xOsFutex.h"
+#include "xAssert.h"
+#include "watchdog.h"
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+//////////////////////////////////
+/// @brief step with its progress
+//////////////////////////////////
+typedef struct xos_system_step_state_t
+{
+    xSystemStep_t t_tStep;
+    uint32_t t_ulDependents;            // Steps waiting for this one
+    atomic_int a_iRemaining;            // Dependencies not settled yet
+    atomic_bool a_bBlocked;             // A dependency failed, the step is skipped
+    atomic_int a_iState;                // XOS_SYSTEM_STATE_*
+    int t_iStatus;
+    uint64_t t_ulStartNs;
+    uint64_t t_ulEndNs;
+    int t_iTid;
+} xSystemStepState_t;
+
+//////////////////////////////////
+/// @brief bootstrap state
+//////////////////////////////////
+typedef struct xos_system_t
+{
+    xSystemConfig_t t_tConfig;
+    xSystemStepState_t t_tSteps[XOS_SYSTEM_MAX_STEPS];
+    int t_iStepCount;                   // Highest configured id + 1
+    uint64_t t_ulOriginNs;              // xSystemInit call
+    xOsThreadPool_t t_tPool;
+    bool t_bPool;
+    xOsWaitGroup_t t_tCritical;
+    xOsWaitGroup_t t_tDeferred;
+    atomic_int a_iDeferredLeft;         // Deferred steps not settled, the last one logs the report
+    pthread_mutex_t t_tMutex;
+    pthread_cond_t t_tSettled;          // Broadcast each time a step settles
+    atomic_bool a_bRunning;
+#ifdef USE_TLS
+    _Atomic(TLS_Context*) a_ptTlsContext;
+    NetworkTlsConfig t_tMetricsTls;     // Shared context handed to the metrics endpoint
+#endif
+    xMetricsServerConfig_t t_tMetrics;
+} xSystem_t;
+
+static xSystem_t s_tSystem;
+
+static const char* s_pcStates[] = { "absent", "pending", "running", "done", "failed", "skipped" };
+
+////////////////////////////////////////////////////////////
+/// Built-in steps
+////////////////////////////////////////////////////////////
+
+static int systemMemoryInit(void* p_pvArg)
+{
+    (void)p_pvArg;
+    int l_iRet = xMemInitEx(s_tSystem.t_tConfig.t_eMemIntegrity);
+    return (l_iRet == (int)XOS_MEM_OK) ? 0 : l_iRet;
+}
+
+static int systemLogInit(void* p_pvArg)
+{
+    (void)p_pvArg;
+    int l_iRet = xLogInit(s_tSystem.t_tConfig.t_ptLog);
+    return (l_iRet == (int)XOS_LOG_OK) ? 0 : l_iRet;
+}
+
+static void systemLogStop(void* p_pvArg)
+{
+    (void)p_pvArg;
+    xLogClose();
+}
+
+static int systemWatchdogInit(void* p_pvArg)
+{
+    (void)p_pvArg;
+    const xSystemConfig_t* l_ptConfig = &s_tSystem.t_tConfig;
+    return watchdog_supervisor_start(l_ptConfig->t_ulWatchdogCheckMs, l_ptConfig->t_pcWatchdogDevice,
+                                     l_ptConfig->t_ulWatchdogHwTimeoutS);
+}
+
+static void systemWatchdogStop(void* p_pvArg)
+{
+    (void)p_pvArg;
+    watchdog_supervisor_stop();
+}
+
+#ifdef XOS_MRPIZ
+static int systemRobotInit(void* p_pvArg)
+{
+    (void)p_pvArg;
+    return s_tSystem.t_tConfig.t_pfRobotInit();
+}
+
+static void systemRobotStop(void* p_pvArg)
+{
+    (void)p_pvArg;
+    if (s_tSystem.t_tConfig.t_pfRobotClose)
+        s_tSystem.t_tConfig.t_pfRobotClose();
+}
+
+static int systemMotorsInit(void* p_pvArg)
+{
+    (void)p_pvArg;
+    const xSystemConfig_t* l_ptConfig = &s_tSystem.t_tConfig;
+    int l_iRet = xMotorsStart(l_ptConfig->t_ulMotorsPeriodUs, l_ptConfig->t_ptMotorsLimits, l_ptConfig->t_iMotorsPriority);
+    return (l_iRet == (int)XMOTORS_OK) ? 0 : l_iRet;
+}
+
+static void systemMotorsStop(void* p_pvArg)
+{
+    (void)p_pvArg;
+    xMotorsStop();
+}
+
+static int systemSensorsInit(void* p_pvArg)
+{
+    (void)p_pvArg;
+    const xSystemConfig_t* l_ptConfig = &s_tSystem.t_tConfig;
+    int l_iRet = xSensorsStart(l_ptConfig->t_ulSensorsPeriodMs, l_ptConfig->t_ulSensorsBatteryDivider,
+                               l_ptConfig->t_iSensorsPriority);
+    return (l_iRet == (int)XSENSORS_OK) ? 0 : l_iRet;
+}
+
+static void systemSensorsStop(void* p_pvArg)
+{
+    (void)p_pvArg;
+    xSensorsStop();
+}
+#endif
+
+#ifdef USE_TLS
+static int systemTlsInit(void* p_pvArg)
+{
+    (void)p_pvArg;
+    // Certificates are read and parsed here, off the critical path
+    TLS_Context* l_ptContext = networkCreateTlsContext(s_tSystem.t_tConfig.t_ptTls);
+    if (l_ptContext == NULL)
+        return NETWORK_TLS_ERROR;
+    atomic_store(&s_tSystem.a_ptTlsContext, l_ptContext);
+    return 0;
+}
+
+static void systemTlsStop(void* p_pvArg)
+{
+    (void)p_pvArg;
+    TLS_Context* l_ptContext = atomic_exchange(&s_tSystem.a_ptTlsContext, NULL);
+    if (l_ptContext)
+        networkReleaseTlsContext(l_ptContext);
+}
+#endif
+
+static int systemMetricsInit(void* p_pvArg)
+{
+    (void)p_pvArg;
+    xMetricsServerConfig_t* l_ptConfig = &s_tSystem.t_tMetrics;
+#ifdef USE_TLS
+    // Without its own TLS configuration the endpoint serves with the shared context
+    TLS_Context* l_ptContext = atomic_load(&s_tSystem.a_ptTlsContext);
+    if (l_ptConfig->t_ptTls == NULL && l_ptContext != NULL)
+    {
+        memset(&s_tSystem.t_tMetricsTls, 0, sizeof(s_tSystem.t_tMetricsTls));
+        s_tSystem.t_tMetricsTls.t_ptContext = l_ptContext;
+        l_ptConfig->t_ptTls = &s_tSystem.t_tMetricsTls;
+    }
+#endif
+    int l_iRet = xMetricsServerStart(l_ptConfig);
+    return (l_iRet == (int)XOS_METRICS_SERVER_OK) ? 0 : l_iRet;
+}
+
+static void systemMetricsStop(void* p_pvArg)
+{
+    (void)p_pvArg;
+    xMetricsServerStop();
+}
+
+////////////////////////////////////////////////////////////
+/// systemDeclare
+////////////////////////////////////////////////////////////
+static void systemDeclare(int p_iId, const char* p_pcName, int (*p_pfInit)(void*), void (*p_pfStop)(void*),
+                          uint32_t p_ulDepends, uint32_t p_ulFlags)
+{
+    xSystemStep_t* l_ptStep = &s_tSystem.t_tSteps[p_iId].t_tStep;
+    l_ptStep->t_pcName = p_pcName;
+    l_ptStep->t_pfInit = p_pfInit;
+    l_ptStep->t_pfStop = p_pfStop;
+    l_ptStep->t_pvArg = NULL;
+    l_ptStep->t_ulDepends = p_ulDepends;
+    l_ptStep->t_ulFlags = p_ulFlags;
+}
+
+////////////////////////////////////////////////////////////
+/// systemBuild
+////////////////////////////////////////////////////////////
+static int systemBuild(const xSystemConfig_t* p_ptConfig)
+{
+    const uint32_t l_ulMemory = XOS_SYSTEM_DEP(XOS_SYSTEM_STEP_MEMORY);
+    if (p_ptConfig->t_iStepCount < 0 || p_ptConfig->t_iStepCount > XOS_SYSTEM_MAX_STEPS - XOS_SYSTEM_STEP_USER)
+        return XOS_SYSTEM_INVALID;
+    if (p_ptConfig->t_iStepCount > 0 && p_ptConfig->t_ptSteps == NULL)
+        return XOS_SYSTEM_INVALID;
+
+    // The robot comes straight after memory, the log file never delays the motors
+    systemDeclare(XOS_SYSTEM_STEP_MEMORY, "memory", systemMemoryInit, NULL, 0, 0);
+#ifdef XOS_MRPIZ
+    if (p_ptConfig->t_pfRobotInit)
+    {
+        systemDeclare(XOS_SYSTEM_STEP_ROBOT, "robot", systemRobotInit, systemRobotStop, l_ulMemory, 0);
+        if (p_ptConfig->t_bMotors)
+            systemDeclare(XOS_SYSTEM_STEP_MOTORS, "motors", systemMotorsInit, systemMotorsStop,
+                          XOS_SYSTEM_DEP(XOS_SYSTEM_STEP_ROBOT), 0);
+        if (p_ptConfig->t_bSensors)
+            systemDeclare(XOS_SYSTEM_STEP_SENSORS, "sensors", systemSensorsInit, systemSensorsStop,
+                          XOS_SYSTEM_DEP(XOS_SYSTEM_STEP_ROBOT), 0);
+    }
+#endif
+    if (p_ptConfig->t_bWatchdog)
+        systemDeclare(XOS_SYSTEM_STEP_WATCHDOG, "watchdog", systemWatchdogInit, systemWatchdogStop, l_ulMemory, 0);
+    if (p_ptConfig->t_ptLog)
+        systemDeclare(XOS_SYSTEM_STEP_LOG, "log", systemLogInit, systemLogStop, l_ulMemory, 0);
+#ifdef USE_TLS
+    if (p_ptConfig->t_ptTls)
+        systemDeclare(XOS_SYSTEM_STEP_TLS, "tls", systemTlsInit, systemTlsStop,
+                      l_ulMemory | XOS_SYSTEM_DEP(XOS_SYSTEM_STEP_LOG), XOS_SYSTEM_STEP_DEFERRED);
+#endif
+    if (p_ptConfig->t_ptMetrics)
+    {
+        s_tSystem.t_tMetrics = *p_ptConfig->t_ptMetrics;
+        systemDeclare(XOS_SYSTEM_STEP_METRICS, "metrics", systemMetricsInit, systemMetricsStop,
+                      l_ulMemory | XOS_SYSTEM_DEP(XOS_SYSTEM_STEP_LOG) | XOS_SYSTEM_DEP(XOS_SYSTEM_STEP_TLS),
+                      XOS_SYSTEM_STEP_DEFERRED);
+    }
+
+    for (int i = 0; i < p_ptConfig->t_iStepCount; i++)
+    {
+        if (p_ptConfig->t_ptSteps[i].t_pfInit == NULL)
+            return XOS_SYSTEM_INVALID;
+        s_tSystem.t_tSteps[XOS_SYSTEM_STEP_USER + i].t_tStep = p_ptConfig->t_ptSteps[i];
+    }
+    s_tSystem.t_iStepCount = XOS_SYSTEM_STEP_USER + p_ptConfig->t_iStepCount;
+
+    // Keep the dependencies on configured steps, the others count as done
+    uint32_t l_ulPresent = 0;
+    for (int i = 0; i < s_tSystem.t_iStepCount; i++)
+    {
+        if (s_tSystem.t_tSteps[i].t_tStep.t_pfInit)
+            l_ulPresent |= XOS_SYSTEM_DEP(i);
+    }
+
+    for (int i = 0; i < s_tSystem.t_iStepCount; i++)
+    {
+        xSystemStepState_t* l_ptState = &s_tSystem.t_tSteps[i];
+        if (!(l_ulPresent & XOS_SYSTEM_DEP(i)))
+            continue;
+
+        uint32_t l_ulDepends = l_ptState->t_tStep.t_ulDepends & l_ulPresent & ~XOS_SYSTEM_DEP(i);
+        l_ptState->t_tStep.t_ulDepends = l_ulDepends;
+        atomic_store(&l_ptState->a_iRemaining, __builtin_popcount(l_ulDepends));
+        atomic_store(&l_ptState->a_iState, XOS_SYSTEM_STATE_PENDING);
+
+        for (int j = 0; j < s_tSystem.t_iStepCount; j++)
+        {
+            if (!(l_ulDepends & XOS_SYSTEM_DEP(j)))
+                continue;
+            // xSystemInit would never return if a critical step waited for a deferred one
+            if ((s_tSystem.t_tSteps[j].t_tStep.t_ulFlags & XOS_SYSTEM_STEP_DEFERRED) &&
+                !(l_ptState->t_tStep.t_ulFlags & XOS_SYSTEM_STEP_DEFERRED))
+                return XOS_SYSTEM_INVALID;
+            s_tSystem.t_tSteps[j].t_ulDependents |= XOS_SYSTEM_DEP(i);
+        }
+    }
+
+    // Memory runs first, then everything must be reachable, a cycle would hang
+    uint32_t l_ulSettled = XOS_SYSTEM_DEP(XOS_SYSTEM_STEP_MEMORY);
+    for (bool l_bProgress = true; l_bProgress;)
+    {
+        l_bProgress = false;
+        for (int i = 0; i < s_tSystem.t_iStepCount; i++)
+        {
+            uint32_t l_ulBit = XOS_SYSTEM_DEP(i);
+            if ((l_ulPresent & l_ulBit) && !(l_ulSettled & l_ulBit) &&
+                (s_tSystem.t_tSteps[i].t_tStep.t_ulDepends & ~l_ulSettled) == 0)
+            {
+                l_ulSettled |= l_ulBit;
+                l_bProgress = true;
+            }
+        }
+    }
+    if (l_ulSettled != l_ulPresent)
+        return XOS_SYSTEM_INVALID;
+
+    return XOS_SYSTEM_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// systemLogStep
+////////////////////////////////////////////////////////////
+static void systemLogStep(const xSystemStepState_t* p_ptState)
+{
+    int l_iState = atomic_load(&p_ptState->a_iState);
+    if (l_iState == XOS_SYSTEM_STATE_SKIPPED)
+    {
+        X_LOG_INFO("xSystem: %-10s skipped, a dependency failed", p_ptState->t_tStep.t_pcName);
+        return;
+    }
+
+    X_LOG_INFO("xSystem: %-10s %-7s start %8.3f ms  took %8.3f ms  tid %d%s (0x%x)",
+               p_ptState->t_tStep.t_pcName, s_pcStates[l_iState],
+               (double)(p_ptState->t_ulStartNs - s_tSystem.t_ulOriginNs) / 1e6,
+               (double)(p_ptState->t_ulEndNs - p_ptState->t_ulStartNs) / 1e6, p_ptState->t_iTid,
+               (p_ptState->t_tStep.t_ulFlags & XOS_SYSTEM_STEP_DEFERRED) ? ", deferred" : "",
+               (unsigned int)p_ptState->t_iStatus);
+}
+
+////////////////////////////////////////////////////////////
+/// systemLogReport
+////////////////////////////////////////////////////////////
+static void systemLogReport(bool p_bDeferred)
+{
+    uint64_t l_ulEnd = s_tSystem.t_ulOriginNs;
+    for (int i = 0; i < s_tSystem.t_iStepCount; i++)
+    {
+        const xSystemStepState_t* l_ptState = &s_tSystem.t_tSteps[i];
+        bool l_bDeferred = (l_ptState->t_tStep.t_ulFlags & XOS_SYSTEM_STEP_DEFERRED) != 0;
+        if (l_ptState->t_tStep.t_pfInit == NULL || l_bDeferred != p_bDeferred)
+            continue;
+        systemLogStep(l_ptState);
+        if (l_ptState->t_ulEndNs > l_ulEnd)
+            l_ulEnd = l_ptState->t_ulEndNs;
+    }
+
+    X_LOG_INFO("xSystem: %s steps settled %.3f ms after xSystemInit", p_bDeferred ? "deferred" : "critical",
+               (double)(l_ulEnd - s_tSystem.t_ulOriginNs) / 1e6);
+}
+
+////////////////////////////////////////////////////////////
+/// systemExecute
+////////////////////////////////////////////////////////////
+static void systemExecute(xSystemStepState_t* p_ptState)
+{
+    p_ptState->t_ulStartNs = osTaskNowNs();
+    p_ptState->t_iTid = (int)syscall(SYS_gettid);
+
+    if (atomic_load(&p_ptState->a_bBlocked))
+    {
+        p_ptState->t_ulEndNs = p_ptState->t_ulStartNs;
+        atomic_store(&p_ptState->a_iState, XOS_SYSTEM_STATE_SKIPPED);
+        return;
+    }
+
+    atomic_store(&p_ptState->a_iState, XOS_SYSTEM_STATE_RUNNING);
+    p_ptState->t_iStatus = p_ptState->t_tStep.t_pfInit(p_ptState->t_tStep.t_pvArg);
+    p_ptState->t_ulEndNs = osTaskNowNs();
+    atomic_store(&p_ptState->a_iState, (p_ptState->t_iStatus == 0) ? XOS_SYSTEM_STATE_DONE : XOS_SYSTEM_STATE_FAILED);
+}
+
+static void* systemStepJob(void* p_pvArg);
+
+////////////////////////////////////////////////////////////
+/// systemComplete
+////////////////////////////////////////////////////////////
+static void systemComplete(xSystemStepState_t* p_ptState)
+{
+    bool l_bFailed = atomic_load(&p_ptState->a_iState) != XOS_SYSTEM_STATE_DONE;
+
+    // The last dependency to settle queues the dependent
+    for (int i = 0; i < s_tSystem.t_iStepCount; i++)
+    {
+        if (!(p_ptState->t_ulDependents & XOS_SYSTEM_DEP(i)))
+            continue;
+
+        xSystemStepState_t* l_ptDependent = &s_tSystem.t_tSteps[i];
+        if (l_bFailed)
+            atomic_store(&l_ptDependent->a_bBlocked, true);
+        if (atomic_fetch_sub(&l_ptDependent->a_iRemaining, 1) == 1 &&
+            xOsThreadPoolSubmit(&s_tSystem.t_tPool, systemStepJob, l_ptDependent, NULL) != (int)XOS_POOL_OK)
+            systemStepJob(l_ptDependent);
+    }
+
+    pthread_mutex_lock(&s_tSystem.t_tMutex);
+    pthread_cond_broadcast(&s_tSystem.t_tSettled);
+    pthread_mutex_unlock(&s_tSystem.t_tMutex);
+
+    if (p_ptState->t_tStep.t_ulFlags & XOS_SYSTEM_STEP_DEFERRED)
+    {
+        if (atomic_fetch_sub(&s_tSystem.a_iDeferredLeft, 1) == 1)
+            systemLogReport(true);
+        xOsWaitGroupDone(&s_tSystem.t_tDeferred);
+    }
+    else
+    {
+        xOsWaitGroupDone(&s_tSystem.t_tCritical);
+    }
+}
+
+////////////////////////////////////////////////////////////
+/// systemStepJob
+////////////////////////////////////////////////////////////
+static void* systemStepJob(void* p_pvArg)
+{
+    xSystemStepState_t* l_ptState = (xSystemStepState_t*)p_pvArg;
+    systemExecute(l_ptState);
+    systemComplete(l_ptState);
+    return NULL;
+}
+
+////////////////////////////////////////////////////////////
+/// systemRelease
+////////////////////////////////////////////////////////////
+static void systemRelease(void)
+{
+    if (s_tSystem.t_bPool)
+        xOsThreadPoolDestroy(&s_tSystem.t_tPool);
+    s_tSystem.t_bPool = false;
+    xOsWaitGroupDestroy(&s_tSystem.t_tCritical);
+    xOsWaitGroupDestroy(&s_tSystem.t_tDeferred);
+    pthread_cond_destroy(&s_tSystem.t_tSettled);
+    pthread_mutex_destroy(&s_tSystem.t_tMutex);
+}
+
+////////////////////////////////////////////////////////////
+/// xSystemConfigInit
+////////////////////////////////////////////////////////////
+int xSystemConfigInit(xSystemConfig_t* p_ptConfig)
+{
+    X_ASSERT_RETURN(p_ptConfig != NULL, XOS_SYSTEM_INVALID);
+
+    memset(p_ptConfig, 0, sizeof(*p_ptConfig));
+    p_ptConfig->t_eMemIntegrity = XOS_MEM_DEFAULT_INTEGRITY;
+#ifdef XOS_MRPIZ
+    p_ptConfig->t_iMotorsPriority = XMOTORS_DEFAULT_PRIORITY;
+    p_ptConfig->t_iSensorsPriority = OS_TASK_DEFAULT_PRIORITY;
+#endif
+    return XOS_SYSTEM_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xSystemInit
+////////////////////////////////////////////////////////////
+int xSystemInit(const xSystemConfig_t* p_ptConfig)
+{
+    bool l_bExpected = false;
+    if (!atomic_compare_exchange_strong(&s_tSystem.a_bRunning, &l_bExpected, true))
+        return XOS_SYSTEM_ALREADY_RUNNING;
+
+    uint64_t l_ulOrigin = osTaskNowNs();
+    xSystemConfig_t l_tDefaults;
+    if (p_ptConfig == NULL)
+    {
+        xSystemConfigInit(&l_tDefaults);
+        p_ptConfig = &l_tDefaults;
+    }
+
+    // Nothing from a previous run survives, xSystemShutdown left the structure idle
+    memset(s_tSystem.t_tSteps, 0, sizeof(s_tSystem.t_tSteps));
+    s_tSystem.t_tConfig = *p_ptConfig;
+    s_tSystem.t_ulOriginNs = l_ulOrigin;
+#ifdef USE_TLS
+    atomic_store(&s_tSystem.a_ptTlsContext, NULL);
+#endif
+
+    int l_iRet = systemBuild(p_ptConfig);
+    if (l_iRet != (int)XOS_SYSTEM_OK)
+    {
+        atomic_store(&s_tSystem.a_bRunning, false);
+        return l_iRet;
+    }
+
+    pthread_condattr_t l_tAttr;
+    pthread_condattr_init(&l_tAttr);
+    pthread_condattr_setclock(&l_tAttr, CLOCK_MONOTONIC);
+    pthread_mutex_init(&s_tSystem.t_tMutex, NULL);
+    pthread_cond_init(&s_tSystem.t_tSettled, &l_tAttr);
+    pthread_condattr_destroy(&l_tAttr);
+    xOsWaitGroupInit(&s_tSystem.t_tCritical);
+    xOsWaitGroupInit(&s_tSystem.t_tDeferred);
+
+    int l_iCritical = 0;
+    int l_iDeferred = 0;
+    for (int i = 0; i < s_tSystem.t_iStepCount; i++)
+    {
+        const xSystemStep_t* l_ptStep = &s_tSystem.t_tSteps[i].t_tStep;
+        if (l_ptStep->t_pfInit == NULL)
+            continue;
+        if (l_ptStep->t_ulFlags & XOS_SYSTEM_STEP_DEFERRED)
+            l_iDeferred++;
+        else
+            l_iCritical++;
+    }
+    xOsWaitGroupAdd(&s_tSystem.t_tCritical, l_iCritical);
+    xOsWaitGroupAdd(&s_tSystem.t_tDeferred, l_iDeferred);
+    atomic_store(&s_tSystem.a_iDeferredLeft, l_iDeferred);
+
+    // The pool allocates through X_MALLOC, the memory manager comes first
+    xSystemStepState_t* l_ptMemory = &s_tSystem.t_tSteps[XOS_SYSTEM_STEP_MEMORY];
+    systemExecute(l_ptMemory);
+
+    long l_lCpus = sysconf(_SC_NPROCESSORS_ONLN);
+    xOsThreadPoolConfig_t l_tPoolConfig;
+    memset(&l_tPoolConfig, 0, sizeof(l_tPoolConfig));
+    l_tPoolConfig.t_iWorkers = (p_ptConfig->t_iWorkers > 0) ? p_ptConfig->t_iWorkers : (int)l_lCpus;
+    if (l_tPoolConfig.t_iWorkers < XOS_SYSTEM_MIN_WORKERS)
+        l_tPoolConfig.t_iWorkers = XOS_SYSTEM_MIN_WORKERS;
+    if (l_tPoolConfig.t_iWorkers > XOS_SYSTEM_MAX_WORKERS)
+        l_tPoolConfig.t_iWorkers = XOS_SYSTEM_MAX_WORKERS;
+    l_tPoolConfig.t_iPriority = OS_TASK_DEFAULT_PRIORITY;
+
+    s_tSystem.t_bPool = (xOsThreadPoolCreate(&s_tSystem.t_tPool, &l_tPoolConfig) == (int)XOS_POOL_OK);
+    if (!s_tSystem.t_bPool)
+    {
+        // Nothing else was started, leave the system idle
+        systemRelease();
+        atomic_store(&s_tSystem.a_bRunning, false);
+        return XOS_SYSTEM_ERROR;
+    }
+
+    for (int i = 0; i < s_tSystem.t_iStepCount; i++)
+    {
+        xSystemStepState_t* l_ptState = &s_tSystem.t_tSteps[i];
+        if (i == XOS_SYSTEM_STEP_MEMORY || l_ptState->t_tStep.t_pfInit == NULL ||
+            atomic_load(&l_ptState->a_iRemaining) != 0)
+            continue;
+        if (xOsThreadPoolSubmit(&s_tSystem.t_tPool, systemStepJob, l_ptState, NULL) != (int)XOS_POOL_OK)
+            systemStepJob(l_ptState);
+    }
+    systemComplete(l_ptMemory);
+
+    // The calling thread runs steps too while it waits
+    xOsThreadPoolWait(&s_tSystem.t_tPool, &s_tSystem.t_tCritical);
+    systemLogReport(false);
+
+    for (int i = 0; i < s_tSystem.t_iStepCount; i++)
+    {
+        const xSystemStepState_t* l_ptState = &s_tSystem.t_tSteps[i];
+        if (l_ptState->t_tStep.t_pfInit == NULL ||
+            (l_ptState->t_tStep.t_ulFlags & (XOS_SYSTEM_STEP_DEFERRED | XOS_SYSTEM_STEP_OPTIONAL)))
+            continue;
+        if (atomic_load(&l_ptState->a_iState) != XOS_SYSTEM_STATE_DONE)
+            return XOS_SYSTEM_ERROR;
+    }
+    return XOS_SYSTEM_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xSystemWaitDeferred
+////////////////////////////////////////////////////////////
+int xSystemWaitDeferred(int p_iTimeoutMs)
+{
+    if (!atomic_load(&s_tSystem.a_bRunning) || !s_tSystem.t_bPool)
+        return XOS_SYSTEM_NOT_RUNNING;
+
+    int l_iRet = xOsWaitGroupWait(&s_tSystem.t_tDeferred, p_iTimeoutMs);
+    if (l_iRet == (int)XOS_POOL_TIMEOUT)
+        return XOS_SYSTEM_TIMEOUT;
+    return (l_iRet == (int)XOS_POOL_OK) ? XOS_SYSTEM_OK : XOS_SYSTEM_ERROR;
+}
+
+////////////////////////////////////////////////////////////
+/// xSystemWaitStep
+////////////////////////////////////////////////////////////
+int xSystemWaitStep(int p_iStep, int p_iTimeoutMs)
+{
+    X_ASSERT_RETURN(p_iStep >= 0 && p_iStep < XOS_SYSTEM_MAX_STEPS, XOS_SYSTEM_INVALID);
+    if (!atomic_load(&s_tSystem.a_bRunning) || !s_tSystem.t_bPool)
+        return XOS_SYSTEM_NOT_RUNNING;
+
+    xSystemStepState_t* l_ptState = &s_tSystem.t_tSteps[p_iStep];
+    if (l_ptState->t_tStep.t_pfInit == NULL)
+        return XOS_SYSTEM_INVALID;
+
+    struct timespec l_tDeadline;
+    osDeadlineAfter(&l_tDeadline, (p_iTimeoutMs > 0) ? (unsigned long)p_iTimeoutMs : 0);
+
+    int l_iRet = XOS_SYSTEM_OK;
+    pthread_mutex_lock(&s_tSystem.t_tMutex);
+    for (;;)
+    {
+        int l_iState = atomic_load(&l_ptState->a_iState);
+        if (l_iState >= XOS_SYSTEM_STATE_DONE)
+        {
+            l_iRet = (l_iState == XOS_SYSTEM_STATE_DONE) ? XOS_SYSTEM_OK : XOS_SYSTEM_ERROR;
+            break;
+        }
+        if (p_iTimeoutMs < 0)
+            pthread_cond_wait(&s_tSystem.t_tSettled, &s_tSystem.t_tMutex);
+        else if (p_iTimeoutMs == 0 ||
+                 pthread_cond_timedwait(&s_tSystem.t_tSettled, &s_tSystem.t_tMutex, &l_tDeadline) == ETIMEDOUT)
+        {
+            l_iRet = XOS_SYSTEM_TIMEOUT;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&s_tSystem.t_tMutex);
+
+    return l_iRet;
+}
+
+////////////////////////////////////////////////////////////
+/// xSystemGetReport
+////////////////////////////////////////////////////////////
+int xSystemGetReport(xSystemReport_t* p_ptReport, int p_iMax, int* p_piCount)
+{
+    X_ASSERT_RETURN(p_ptReport != NULL && p_iMax >= 0, XOS_SYSTEM_INVALID);
+    X_ASSERT_RETURN(p_piCount != NULL, XOS_SYSTEM_INVALID);
+    if (!atomic_load(&s_tSystem.a_bRunning))
+        return XOS_SYSTEM_NOT_RUNNING;
+
+    int l_iCount = 0;
+    for (int i = 0; i < s_tSystem.t_iStepCount && l_iCount < p_iMax; i++)
+    {
+        const xSystemStepState_t* l_ptState = &s_tSystem.t_tSteps[i];
+        if (l_ptState->t_tStep.t_pfInit == NULL)
+            continue;
+
+        xSystemReport_t* l_ptEntry = &p_ptReport[l_iCount++];
+        l_ptEntry->t_pcName = l_ptState->t_tStep.t_pcName;
+        l_ptEntry->t_iState = atomic_load(&l_ptState->a_iState);
+        bool l_bSettled = l_ptEntry->t_iState >= XOS_SYSTEM_STATE_DONE;
+        l_ptEntry->t_iStatus = l_bSettled ? l_ptState->t_iStatus : 0;
+        l_ptEntry->t_bDeferred = (l_ptState->t_tStep.t_ulFlags & XOS_SYSTEM_STEP_DEFERRED) != 0;
+        l_ptEntry->t_ulStartNs = l_bSettled ? l_ptState->t_ulStartNs - s_tSystem.t_ulOriginNs : 0;
+        l_ptEntry->t_ulDurationNs = l_bSettled ? l_ptState->t_ulEndNs - l_ptState->t_ulStartNs : 0;
+        l_ptEntry->t_iTid = l_bSettled ? l_ptState->t_iTid : 0;
+    }
+
+    *p_piCount = l_iCount;
+    return XOS_SYSTEM_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xSystemGetPool
+////////////////////////////////////////////////////////////
+xOsThreadPool_t* xSystemGetPool(void)
+{
+    return (atomic_load(&s_tSystem.a_bRunning) && s_tSystem.t_bPool) ? &s_tSystem.t_tPool : NULL;
+}
+
+#ifdef USE_TLS
+////////////////////////////////////////////////////////////
+/// xSystemGetTlsContext
+////////////////////////////////////////////////////////////
+TLS_Context* xSystemGetTlsContext(void)
+{
+    return atomic_load(&s_tSystem.a_ptTlsContext);
+}
+#endif
+
+////////////////////////////////////////////////////////////
+/// xSystemShutdown
+////////////////////////////////////////////////////////////
+int xSystemShutdown(void)
+{
+    if (!atomic_load(&s_tSystem.a_bRunning) || !s_tSystem.t_bPool)
+        return XOS_SYSTEM_NOT_RUNNING;
+
+    // Deferred steps may still be starting what is about to be stopped
+    xOsWaitGroupWait(&s_tSystem.t_tDeferred, -1);
+    xOsThreadPoolDestroy(&s_tSystem.t_tPool);
+    s_tSystem.t_bPool = false;
+
+    // Reverse order, the logger last so every stop can still report
+    for (int i = s_tSystem.t_iStepCount - 1; i >= 0; i--)
+    {
+        xSystemStepState_t* l_ptState = &s_tSystem.t_tSteps[i];
+        if (i == XOS_SYSTEM_STEP_LOG || l_ptState->t_tStep.t_pfStop == NULL ||
+            atomic_load(&l_ptState->a_iState) != XOS_SYSTEM_STATE_DONE)
+            continue;
+        l_ptState->t_tStep.t_pfStop(l_ptState->t_tStep.t_pvArg);
+    }
+
+    xSystemStepState_t* l_ptLog = &s_tSystem.t_tSteps[XOS_SYSTEM_STEP_LOG];
+    if (l_ptLog->t_tStep.t_pfStop && atomic_load(&l_ptLog->a_iState) == XOS_SYSTEM_STATE_DONE)
+        l_ptLog->t_tStep.t_pfStop(l_ptLog->t_tStep.t_pvArg);
+
+    systemRelease();
+    atomic_store(&s_tSystem.a_bRunning, false);
+    return XOS_SYSTEM_OK;
+}
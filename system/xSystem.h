@@ -0,0 +1,200 @@
+////////////////////////////////////////////////////////////
+//  system header file
+//  defines the subsystem bootstrap
+//
+// xSystemInit brings the library up from one configuration. Each
+// subsystem is a step that names the steps it depends on; memory runs
+// first on the calling thread, then every step whose dependencies are
+// done is queued on a thread pool, so independent steps (logger,
+// watchdog, robot link) overlap. The robot and motor steps depend on
+// nothing but memory: after a watchdog reboot the first motor command
+// does not wait for the log file or the certificates. Deferred steps
+// (TLS context loading, metrics endpoint) keep running on the pool
+// after xSystemInit returns. Every step is timed and the breakdown is
+// logged once the critical steps are done, and again with the deferred
+// ones
+//
+// general discloser: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+#pragma once
+
+#ifndef XOS_SYSTEM_H_
+#define XOS_SYSTEM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "xMemory.h"
+#include "xLog.h"
+#include "xOsThreadPool.h"
+#include "xMetricsServer.h"
+#ifdef XOS_MRPIZ
+#include "xMotors.h"
+#include "xSensors.h"
+#endif
+
+// System error codes
+#define XOS_SYSTEM_OK               0xCE27D410
+#define XOS_SYSTEM_ERROR            0xCE27D411      // A critical step failed, see the report
+#define XOS_SYSTEM_INVALID          0xCE27D412
+#define XOS_SYSTEM_ALREADY_RUNNING  0xCE27D413
+#define XOS_SYSTEM_NOT_RUNNING      0xCE27D414
+#define XOS_SYSTEM_TIMEOUT          0xCE27D415
+
+// Configuration constants
+#define XOS_SYSTEM_MAX_STEPS        32              // Built-in and application steps, one dependency bit each
+#define XOS_SYSTEM_MIN_WORKERS      2               // Init steps mostly wait on devices and files, overlap them even on one CPU
+#define XOS_SYSTEM_MAX_WORKERS      8
+
+// Built-in step ids, a step absent from the build or the configuration counts as done.
+// Ready steps are queued in id order, the motor path first
+#define XOS_SYSTEM_STEP_MEMORY      0               // xMemInitEx, on the calling thread
+#define XOS_SYSTEM_STEP_ROBOT       1               // robot link (mrpiz_init), XOS_MRPIZ builds
+#define XOS_SYSTEM_STEP_MOTORS      2               // xMotorsStart, after the robot
+#define XOS_SYSTEM_STEP_WATCHDOG    3               // watchdog_supervisor_start
+#define XOS_SYSTEM_STEP_SENSORS     4               // xSensorsStart, after the robot
+#define XOS_SYSTEM_STEP_LOG         5               // xLogInit
+#define XOS_SYSTEM_STEP_TLS         6               // networkCreateTlsContext, USE_TLS builds, deferred
+#define XOS_SYSTEM_STEP_METRICS     7               // xMetricsServerStart, deferred
+#define XOS_SYSTEM_STEP_USER        8               // First application step id
+
+#define XOS_SYSTEM_DEP(id)          (1U << (id))
+
+// Step flags
+#define XOS_SYSTEM_STEP_DEFERRED    0x00000001      // Not awaited by xSystemInit, only deferred steps may depend on it
+#define XOS_SYSTEM_STEP_OPTIONAL    0x00000002      // A failure is reported but does not fail xSystemInit
+
+// Step states
+#define XOS_SYSTEM_STATE_ABSENT     0               // Not configured
+#define XOS_SYSTEM_STATE_PENDING    1               // Waiting for its dependencies
+#define XOS_SYSTEM_STATE_RUNNING    2
+#define XOS_SYSTEM_STATE_DONE       3
+#define XOS_SYSTEM_STATE_FAILED     4
+#define XOS_SYSTEM_STATE_SKIPPED    5               // A dependency failed, not run
+
+//////////////////////////////////
+/// @brief application step
+//////////////////////////////////
+typedef struct xos_system_step_t
+{
+    const char* t_pcName;                   // Name in the report, a literal
+    int (*t_pfInit)(void* p_pvArg);         // Returns 0 on success, else an error code kept in the report
+    void (*t_pfStop)(void* p_pvArg);        // Run by xSystemShutdown, in reverse id order (may be NULL)
+    void* t_pvArg;
+    uint32_t t_ulDepends;                   // XOS_SYSTEM_DEP() of the steps to run first
+    uint32_t t_ulFlags;                     // XOS_SYSTEM_STEP_*
+} xSystemStep_t;
+
+//////////////////////////////////
+/// @brief bootstrap configuration, see xSystemConfigInit
+//////////////////////////////////
+typedef struct xos_system_config_t
+{
+    int t_iWorkers;                         // Pool workers (0 for the online CPUs, within XOS_SYSTEM_MIN/MAX_WORKERS)
+    xMemIntegrity_t t_eMemIntegrity;        // Memory step, as xMemInitEx
+    t_logCtx* t_ptLog;                      // Log step configuration (NULL when the application opens the logger)
+
+    bool t_bWatchdog;                       // Start the watchdog supervisor
+    uint32_t t_ulWatchdogCheckMs;           // As watchdog_supervisor_start
+    const char* t_pcWatchdogDevice;         // Hardware watchdog fed by the supervisor (NULL for none)
+    uint32_t t_ulWatchdogHwTimeoutS;
+
+#ifdef XOS_MRPIZ
+    int (*t_pfRobotInit)(void);             // mrpiz_init or its intox variant (NULL when the application does it)
+    void (*t_pfRobotClose)(void);           // mrpiz_close (may be NULL)
+    bool t_bMotors;                         // Start the motor pipeline after the robot
+    uint32_t t_ulMotorsPeriodUs;
+    const xMotorsLimits_t* t_ptMotorsLimits;
+    int t_iMotorsPriority;
+    bool t_bSensors;                        // Start the sensor service after the robot
+    uint32_t t_ulSensorsPeriodMs;
+    uint32_t t_ulSensorsBatteryDivider;
+    int t_iSensorsPriority;
+#endif
+
+#ifdef USE_TLS
+    const NetworkTlsConfig* t_ptTls;        // Shared TLS context loaded in the background (NULL for none)
+#endif
+    const xMetricsServerConfig_t* t_ptMetrics; // Metrics endpoint started in the background (NULL for none)
+
+    const xSystemStep_t* t_ptSteps;         // Application steps, ids XOS_SYSTEM_STEP_USER onwards (copied)
+    int t_iStepCount;
+} xSystemConfig_t;
+
+//////////////////////////////////
+/// @brief timing of one step, in ns from the xSystemInit call
+//////////////////////////////////
+typedef struct xos_system_report_t
+{
+    const char* t_pcName;
+    int t_iState;                           // XOS_SYSTEM_STATE_*
+    int t_iStatus;                          // Step return value
+    bool t_bDeferred;
+    uint64_t t_ulStartNs;                   // Began to run
+    uint64_t t_ulDurationNs;
+    int t_iTid;                             // Thread that ran it
+} xSystemReport_t;
+
+//////////////////////////////////
+/// @brief Fill a configuration with the defaults, every optional subsystem off
+/// @param p_ptConfig : configuration
+/// @return : success or error code
+//////////////////////////////////
+int xSystemConfigInit(xSystemConfig_t* p_ptConfig);
+
+//////////////////////////////////
+/// @brief Bring the configured subsystems up
+/// @param p_ptConfig : configuration (NULL for xSystemConfigInit defaults)
+/// @return : success once every critical step is done, XOS_SYSTEM_ERROR when one failed, or error code
+/// @note deferred steps may still be running, see xSystemWaitDeferred. After an
+///       error xSystemShutdown still stops what was started
+//////////////////////////////////
+int xSystemInit(const xSystemConfig_t* p_ptConfig);
+
+//////////////////////////////////
+/// @brief Wait for the deferred steps
+/// @param p_iTimeoutMs : timeout in milliseconds (-1 for infinite)
+/// @return : success, XOS_SYSTEM_TIMEOUT, or error code
+//////////////////////////////////
+int xSystemWaitDeferred(int p_iTimeoutMs);
+
+//////////////////////////////////
+/// @brief Wait for one step
+/// @param p_iStep : step id
+/// @param p_iTimeoutMs : timeout in milliseconds (-1 for infinite)
+/// @return : success when done, XOS_SYSTEM_ERROR when failed or skipped, XOS_SYSTEM_TIMEOUT, or error code
+//////////////////////////////////
+int xSystemWaitStep(int p_iStep, int p_iTimeoutMs);
+
+//////////////////////////////////
+/// @brief Copy the step timings
+/// @param p_ptReport : filled with one entry per configured step, in id order
+/// @param p_iMax : entries available
+/// @param p_piCount : filled with the entries written
+/// @return : success or error code
+//////////////////////////////////
+int xSystemGetReport(xSystemReport_t* p_ptReport, int p_iMax, int* p_piCount);
+
+//////////////////////////////////
+/// @brief Get the bootstrap pool, kept for the application until xSystemShutdown
+/// @return pool, NULL when the system is not running
+//////////////////////////////////
+xOsThreadPool_t* xSystemGetPool(void);
+
+#ifdef USE_TLS
+//////////////////////////////////
+/// @brief Get the shared TLS context loaded by the TLS step
+/// @return context, NULL until the step is done or when not configured
+/// @note xSystemWaitStep(XOS_SYSTEM_STEP_TLS, ...) waits for it
+//////////////////////////////////
+TLS_Context* xSystemGetTlsContext(void);
+#endif
+
+//////////////////////////////////
+/// @brief Wait for the deferred steps, then stop every step in reverse order
+/// @return : success or error code
+/// @note the logger is closed last
+//////////////////////////////////
+int xSystemShutdown(void);
+
+#endif // XOS_SYSTEM_H_
@@ -105,27 +105,31 @@ echo "Generator:  $CMAKE_GENERATOR"
 echo "Build type: $BUILD_TYPE"
 echo "TLS:        $ENABLE_TLS"
 
-# Run CMake with the specified options
+# Run CMake with the specified options, the tests are a subdirectory of the library build
 cmake -G "$CMAKE_GENERATOR" \
       -DCMAKE_BUILD_TYPE="$BUILD_TYPE" \
       -DUSE_TLS="$ENABLE_TLS" \
-      "$PROJECT_PATH/test"
+      -DBUILD_TESTS=ON \
+      "$PROJECT_PATH"
 
 # Compile
 print_section "Compiling tests"
-ninja
+cmake --build .
 
-# Run tests
+# Run tests, without set -e so that the failure is reported below
 print_section "Running tests"
+set +e
 if [ -n "$TEST_FILTER" ]; then
     echo "Running tests matching: $TEST_FILTER"
-    ./dynamicBric_PATO_test --gtest_filter="*${TEST_FILTER}*"
+    ctest --output-on-failure -R "$TEST_FILTER"
 else
-    ./dynamicBric_PATO_test
+    ctest --output-on-failure
 fi
+TEST_STATUS=$?
+set -e
 
 # Check test status
-if [ $? -eq 0 ]; then
+if [ $TEST_STATUS -eq 0 ]; then
     echo
     echo -e "${GREEN}✓ All tests passed${NC}"
 else
@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////
+//  testMemory.c
+//  Unit tests of the xMemory manager
+//
+// Re-initialising the manager while blocks are allocated is refused
+// with XOS_MEM_ALREADY_INIT in every build type, the blocks, the
+// counters and the integrity level are left as they were, and the
+// manager can be initialised again once everything is freed. The
+// bytes in use stay exact while threads reserve the limit in batches
+//
+// general discloser: copy or share the file is forbidden
+// Written : 15/10/2026
+////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include <pthread.h>
+#include "xMemory.h"
+#include "xTest.h"
+
+//
+// Live blocks keep the manager from being reset
+//
+static void testInitWithLiveBlocks(void)
+{
+    X_TEST_CHECK(xMemInitEx(XOS_MEM_INTEGRITY_CHECKSUM) == (int)XOS_MEM_OK);
+
+    char* l_pcBlock = X_MALLOC(64);
+    X_TEST_CHECK(l_pcBlock != NULL);
+    if (l_pcBlock == NULL)
+    {
+        return;
+    }
+    memset(l_pcBlock, 0x5A, 64);
+
+    X_TEST_CHECK(xMemInitEx(XOS_MEM_INTEGRITY_SHA256) == (int)XOS_MEM_ALREADY_INIT);
+    X_TEST_CHECK(xMemInit() == (int)XOS_MEM_ALREADY_INIT);
+    X_TEST_CHECK(xMemGetIntegrity() == XOS_MEM_INTEGRITY_CHECKSUM);
+
+    size_t l_ulTotal = 0;
+    size_t l_ulPeak = 0;
+    size_t l_ulCount = 0;
+    X_TEST_CHECK(xMemGetStats(&l_ulTotal, &l_ulPeak, &l_ulCount) == (int)XOS_MEM_OK);
+    X_TEST_CHECK(l_ulTotal == 64 && l_ulCount == 1);
+
+    // The block is still registered and intact
+    X_TEST_CHECK(xMemCheck() == (int)XOS_MEM_OK);
+    X_TEST_CHECK(X_FREE(l_pcBlock) == (int)XOS_MEM_OK);
+
+    X_TEST_CHECK(xMemInitEx(XOS_MEM_INTEGRITY_SHA256) == (int)XOS_MEM_OK);
+    X_TEST_CHECK(xMemGetIntegrity() == XOS_MEM_INTEGRITY_SHA256);
+}
+
+#define TEST_MEM_THREADS 4
+#define TEST_MEM_BLOCKS  64
+
+static void* testAllocThread(void* p_pvArg)
+{
+    size_t l_ulSize = (size_t)(uintptr_t)p_pvArg;
+    void* l_ptBlocks[TEST_MEM_BLOCKS];
+    for (int l_iRound = 0; l_iRound < 100; l_iRound++)
+    {
+        for (int i = 0; i < TEST_MEM_BLOCKS; i++)
+        {
+            l_ptBlocks[i] = X_MALLOC(l_ulSize);
+            X_TEST_CHECK(l_ptBlocks[i] != NULL);
+        }
+        for (int i = 0; i < TEST_MEM_BLOCKS; i++)
+        {
+            X_TEST_CHECK(X_FREE(l_ptBlocks[i]) == (int)XOS_MEM_OK);
+        }
+    }
+    return NULL;
+}
+
+//
+// Thread credits are not counted as bytes in use
+//
+static void testThreadReservations(void)
+{
+    X_TEST_CHECK(xMemInit() == (int)XOS_MEM_OK);
+
+    // Larger than a batch, reserved past the thread credit
+    void* l_ptLarge = X_MALLOC(XOS_MEM_RESERVE_BATCH * 3);
+    void* l_ptSmall = X_MALLOC(100);
+    X_TEST_CHECK(l_ptLarge != NULL && l_ptSmall != NULL);
+
+    size_t l_ulTotal = 0;
+    size_t l_ulPeak = 0;
+    size_t l_ulCount = 0;
+    xMemGetStats(&l_ulTotal, &l_ulPeak, &l_ulCount);
+    X_TEST_CHECK(l_ulTotal == XOS_MEM_RESERVE_BATCH * 3 + 100);
+    X_TEST_CHECK(l_ulPeak >= l_ulTotal);
+
+    pthread_t l_tThreads[TEST_MEM_THREADS];
+    for (int i = 0; i < TEST_MEM_THREADS; i++)
+    {
+        pthread_create(&l_tThreads[i], NULL, testAllocThread, (void*)(uintptr_t)(64 + 1000 * i));
+    }
+    for (int i = 0; i < TEST_MEM_THREADS; i++)
+    {
+        pthread_join(l_tThreads[i], NULL);
+    }
+
+    xMemGetStats(&l_ulTotal, &l_ulPeak, &l_ulCount);
+    X_TEST_CHECK(l_ulTotal == XOS_MEM_RESERVE_BATCH * 3 + 100);
+
+    X_TEST_CHECK(X_FREE(l_ptLarge) == (int)XOS_MEM_OK);
+    X_TEST_CHECK(X_FREE(l_ptSmall) == (int)XOS_MEM_OK);
+    xMemGetStats(&l_ulTotal, &l_ulPeak, &l_ulCount);
+    X_TEST_CHECK(l_ulTotal == 0);
+}
+
+int main(void)
+{
+    X_TEST_RUN(testInitWithLiveBlocks);
+    X_TEST_RUN(testThreadReservations);
+    return X_TEST_RESULT();
+}
@@ -0,0 +1,184 @@
+////////////////////////////////////////////////////////////
+//  testMutex.c
+//  Unit tests of the fast mutex and the reader-writer lock
+//
+// Contended threads never lose an update. A timed lock on a held mutex
+// gives up with MUTEX_TIMEOUT once its deadline has passed, not before.
+// Readers never see a half written record, and an unbalanced read
+// unlock is refused without touching the lock state
+//
+// general discloser: copy or share the file is forbidden
+// Written : 15/10/2026
+////////////////////////////////////////////////////////////
+
+#include <pthread.h>
+#include "xOsMutex.h"
+#include "xTest.h"
+
+#define TEST_MUTEX_THREADS 4
+#define TEST_MUTEX_ROUNDS  100000
+
+static xOsFastMutex s_tFastMutex;
+static unsigned long s_ulCounter;
+
+static void* testFastMutexThread(void* p_pvArg)
+{
+    (void)p_pvArg;
+    for (int i = 0; i < TEST_MUTEX_ROUNDS; i++)
+    {
+        mutexFastLock(&s_tFastMutex);
+        s_ulCounter++;
+        mutexFastUnlock(&s_tFastMutex);
+    }
+    return NULL;
+}
+
+//
+// Contended fast mutex, every increment is kept
+//
+static void testFastMutexContention(void)
+{
+    X_TEST_CHECK(mutexFastInit(&s_tFastMutex) == (int)MUTEX_OK);
+    s_ulCounter = 0;
+
+    pthread_t l_tThreads[TEST_MUTEX_THREADS];
+    for (int i = 0; i < TEST_MUTEX_THREADS; i++)
+    {
+        pthread_create(&l_tThreads[i], NULL, testFastMutexThread, NULL);
+    }
+    for (int i = 0; i < TEST_MUTEX_THREADS; i++)
+    {
+        pthread_join(l_tThreads[i], NULL);
+    }
+
+    X_TEST_CHECK(s_ulCounter == (unsigned long)TEST_MUTEX_THREADS * TEST_MUTEX_ROUNDS);
+    X_TEST_CHECK(atomic_load(&s_tFastMutex.a_iState) == 0);
+}
+
+static void* testFastMutexTimeoutThread(void* p_pvArg)
+{
+    int* l_piResult = (int*)p_pvArg;
+    uint64_t l_ulStart = xTestNowMs();
+    *l_piResult = mutexFastLockTimeout(&s_tFastMutex, 100);
+    X_TEST_CHECK(xTestNowMs() - l_ulStart >= 100);
+    return NULL;
+}
+
+//
+// Timed locks on a held mutex expire, a released one is taken
+//
+static void testFastMutexTimeout(void)
+{
+    X_TEST_CHECK(mutexFastInit(&s_tFastMutex) == (int)MUTEX_OK);
+    X_TEST_CHECK(mutexFastLock(&s_tFastMutex) == (int)MUTEX_OK);
+    X_TEST_CHECK(mutexFastTryLock(&s_tFastMutex) == (int)MUTEX_TIMEOUT);
+
+    // Past the spin, the waiter sleeps on the futex until its deadline
+    int l_iResult = 0;
+    pthread_t l_tThread;
+    pthread_create(&l_tThread, NULL, testFastMutexTimeoutThread, &l_iResult);
+    pthread_join(l_tThread, NULL);
+    X_TEST_CHECK(l_iResult == (int)MUTEX_TIMEOUT);
+
+    X_TEST_CHECK(mutexFastUnlock(&s_tFastMutex) == (int)MUTEX_OK);
+    X_TEST_CHECK(mutexFastLockTimeout(&s_tFastMutex, 100) == (int)MUTEX_OK);
+    X_TEST_CHECK(mutexFastUnlock(&s_tFastMutex) == (int)MUTEX_OK);
+
+    // The timed out waiter left the state at 2, the unlock above cleared it
+    X_TEST_CHECK(atomic_load(&s_tFastMutex.a_iState) == 0);
+}
+
+static xOsRwLock s_tRwLock;
+static unsigned long s_ulRecord[2];         // Both halves always equal under the lock
+static atomic_bool s_bWritersDone;
+
+static void* testRwLockReader(void* p_pvArg)
+{
+    (void)p_pvArg;
+    while (!atomic_load(&s_bWritersDone))
+    {
+        rwLockRead(&s_tRwLock);
+        X_TEST_CHECK(s_ulRecord[0] == s_ulRecord[1]);
+        X_TEST_CHECK(rwLockReadUnlock(&s_tRwLock) == (int)MUTEX_OK);
+    }
+    return NULL;
+}
+
+static void* testRwLockWriter(void* p_pvArg)
+{
+    (void)p_pvArg;
+    for (int i = 0; i < TEST_MUTEX_ROUNDS / 10; i++)
+    {
+        rwLockWrite(&s_tRwLock);
+        s_ulRecord[0]++;
+        s_ulRecord[1]++;
+        X_TEST_CHECK(rwLockWriteUnlock(&s_tRwLock) == (int)MUTEX_OK);
+    }
+    return NULL;
+}
+
+//
+// Readers and writers on one record, readers see whole updates only
+//
+static void testRwLockContention(void)
+{
+    X_TEST_CHECK(rwLockInit(&s_tRwLock) == (int)MUTEX_OK);
+    s_ulRecord[0] = s_ulRecord[1] = 0;
+    atomic_store(&s_bWritersDone, false);
+
+    pthread_t l_tReaders[TEST_MUTEX_THREADS];
+    pthread_t l_tWriters[2];
+    for (int i = 0; i < TEST_MUTEX_THREADS; i++)
+    {
+        pthread_create(&l_tReaders[i], NULL, testRwLockReader, NULL);
+    }
+    for (int i = 0; i < 2; i++)
+    {
+        pthread_create(&l_tWriters[i], NULL, testRwLockWriter, NULL);
+    }
+    for (int i = 0; i < 2; i++)
+    {
+        pthread_join(l_tWriters[i], NULL);
+    }
+    atomic_store(&s_bWritersDone, true);
+    for (int i = 0; i < TEST_MUTEX_THREADS; i++)
+    {
+        pthread_join(l_tReaders[i], NULL);
+    }
+
+    X_TEST_CHECK(s_ulRecord[0] == 2UL * (TEST_MUTEX_ROUNDS / 10));
+    X_TEST_CHECK(atomic_load(&s_tRwLock.a_uiState) == 0);
+    X_TEST_CHECK(atomic_load(&s_tRwLock.a_uiWriters) == 0);
+}
+
+//
+// Unbalanced read unlocks are refused and leave the state as it was
+//
+static void testRwLockUnbalanced(void)
+{
+    X_TEST_CHECK(rwLockInit(&s_tRwLock) == (int)MUTEX_OK);
+    X_TEST_CHECK(rwLockReadUnlock(&s_tRwLock) == (int)MUTEX_ERROR);
+    X_TEST_CHECK(atomic_load(&s_tRwLock.a_uiState) == 0);
+
+    // A writer holds the lock, readers are kept out and cannot release it
+    X_TEST_CHECK(rwLockWrite(&s_tRwLock) == (int)MUTEX_OK);
+    X_TEST_CHECK(rwLockTryRead(&s_tRwLock) == (int)MUTEX_TIMEOUT);
+    X_TEST_CHECK(rwLockReadUnlock(&s_tRwLock) == (int)MUTEX_ERROR);
+    X_TEST_CHECK(rwLockWriteUnlock(&s_tRwLock) == (int)MUTEX_OK);
+
+    X_TEST_CHECK(rwLockTryRead(&s_tRwLock) == (int)MUTEX_OK);
+    X_TEST_CHECK(rwLockTryRead(&s_tRwLock) == (int)MUTEX_OK);
+    X_TEST_CHECK(rwLockReadUnlock(&s_tRwLock) == (int)MUTEX_OK);
+    X_TEST_CHECK(rwLockReadUnlock(&s_tRwLock) == (int)MUTEX_OK);
+    X_TEST_CHECK(rwLockReadUnlock(&s_tRwLock) == (int)MUTEX_ERROR);
+    X_TEST_CHECK(atomic_load(&s_tRwLock.a_uiState) == 0);
+}
+
+int main(void)
+{
+    X_TEST_RUN(testFastMutexContention);
+    X_TEST_RUN(testFastMutexTimeout);
+    X_TEST_RUN(testRwLockContention);
+    X_TEST_RUN(testRwLockUnbalanced);
+    return X_TEST_RESULT();
+}
@@ -0,0 +1,174 @@
+////////////////////////////////////////////////////////////
+//  testNetworkFrame.c
+//  Unit tests of the length-prefixed message framing
+//
+// Messages around every varint length boundary go through a loopback
+// TCP pair and come back intact, several frames sent at once are all
+// returned, and malformed headers written on the raw descriptor (a
+// 5-byte prefix overflowing 32 bits, a length above the limit) are
+// reported as NETWORK_ERROR instead of being decoded
+//
+// general discloser: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include "xNetworkFrame.h"
+#include "xTest.h"
+#include "xTestNetwork.h"
+
+static void testFill(uint8_t* p_pucData, uint32_t p_ulSize, uint32_t p_ulSeed)
+{
+    for (uint32_t i = 0; i < p_ulSize; i++)
+    {
+        p_pucData[i] = (uint8_t)(i * 31U + p_ulSeed);
+    }
+}
+
+typedef struct
+{
+    NetworkSocket* t_ptSocket;
+    const uint32_t* t_pulSizes;
+    size_t t_ulCount;
+} testSender;
+
+// Large payloads fill the socket buffers, they are sent from another thread
+static void* testSend(void* p_pvArg)
+{
+    testSender* l_ptSender = (testSender*)p_pvArg;
+    for (size_t i = 0; i < l_ptSender->t_ulCount; i++)
+    {
+        uint32_t l_ulSize = l_ptSender->t_pulSizes[i];
+        uint8_t* l_pucData = malloc(l_ulSize + 1);
+        testFill(l_pucData, l_ulSize, (uint32_t)i);
+        X_TEST_CHECK(networkSendMessage(l_ptSender->t_ptSocket, l_pucData, l_ulSize) == (int)NETWORK_OK);
+        free(l_pucData);
+    }
+    return NULL;
+}
+
+//
+// Sizes on both sides of each varint length (1 to 4 header bytes)
+//
+static void testRoundTrip(void)
+{
+    static const uint32_t s_ulSizes[] = {
+        0, 1, 127, 128, 300, 16383, 16384, 65536, 2097151, 2097152, NETWORK_FRAME_MAX_SIZE
+    };
+    const size_t l_ulCount = sizeof(s_ulSizes) / sizeof(s_ulSizes[0]);
+    NetworkSocket* l_ptClient = NULL;
+    NetworkSocket* l_ptServer = NULL;
+    X_TEST_CHECK(xTestConnect(&l_ptClient, &l_ptServer));
+
+    testSender l_tSender = { l_ptClient, s_ulSizes, l_ulCount };
+    pthread_t l_tThread;
+    pthread_create(&l_tThread, NULL, testSend, &l_tSender);
+
+    uint8_t* l_pucExpected = malloc(NETWORK_FRAME_MAX_SIZE);
+    for (size_t i = 0; i < l_ulCount; i++)
+    {
+        NetworkFrameView l_tView;
+        int l_iSize = networkReceiveMessage(l_ptServer, &l_tView);
+        X_TEST_CHECK(l_iSize == (int)s_ulSizes[i]);
+        if (l_iSize != (int)s_ulSizes[i])
+        {
+            break;
+        }
+        testFill(l_pucExpected, s_ulSizes[i], (uint32_t)i);
+        X_TEST_CHECK(l_tView.t_ulSize == s_ulSizes[i]);
+        X_TEST_CHECK(s_ulSizes[i] == 0 || memcmp(l_tView.t_pucData, l_pucExpected, s_ulSizes[i]) == 0);
+    }
+    pthread_join(l_tThread, NULL);
+    free(l_pucExpected);
+
+    // Above the limit nothing is sent
+    X_TEST_CHECK(networkSendMessage(l_ptClient, "x", NETWORK_FRAME_MAX_SIZE + 1) == (int)NETWORK_INVALID_PARAM);
+
+    // Closing the peer ends the stream
+    networkCloseSocket(l_ptClient);
+    NetworkFrameView l_tView;
+    X_TEST_CHECK(networkReceiveMessage(l_ptServer, &l_tView) == (int)NETWORK_CLOSED);
+    networkCloseSocket(l_ptServer);
+}
+
+//
+// Frames sent in one write are returned one by one
+//
+static void testCoalescedFrames(void)
+{
+    NetworkSocket* l_ptClient = NULL;
+    NetworkSocket* l_ptServer = NULL;
+    X_TEST_CHECK(xTestConnect(&l_ptClient, &l_ptServer));
+
+    // Headers 0x03 and 0x80 0x01 (128 bytes), then an empty frame
+    uint8_t l_ucStream[3 + 1 + 2 + 128 + 1];
+    size_t l_ulLength = 0;
+    l_ucStream[l_ulLength++] = 3;
+    memcpy(l_ucStream + l_ulLength, "abc", 3);
+    l_ulLength += 3;
+    l_ucStream[l_ulLength++] = 0x80;
+    l_ucStream[l_ulLength++] = 0x01;
+    memset(l_ucStream + l_ulLength, 'x', 128);
+    l_ulLength += 128;
+    l_ucStream[l_ulLength++] = 0;
+    X_TEST_CHECK(send(l_ptClient->t_iSocketFd, l_ucStream, l_ulLength, 0) == (ssize_t)l_ulLength);
+
+    NetworkFrameView l_tView;
+    X_TEST_CHECK(networkReceiveMessage(l_ptServer, &l_tView) == 3);
+    X_TEST_CHECK(memcmp(l_tView.t_pucData, "abc", 3) == 0);
+    X_TEST_CHECK(networkReceiveMessage(l_ptServer, &l_tView) == 128);
+    X_TEST_CHECK(l_tView.t_pucData[0] == 'x' && l_tView.t_pucData[127] == 'x');
+    X_TEST_CHECK(networkReceiveMessage(l_ptServer, &l_tView) == 0);
+
+    networkCloseSocket(l_ptClient);
+    networkCloseSocket(l_ptServer);
+}
+
+static int testReceiveRaw(const uint8_t* p_pucHeader, size_t p_ulLength)
+{
+    NetworkSocket* l_ptClient = NULL;
+    NetworkSocket* l_ptServer = NULL;
+    if (!xTestConnect(&l_ptClient, &l_ptServer))
+    {
+        return NETWORK_ERROR - 1;
+    }
+
+    send(l_ptClient->t_iSocketFd, p_pucHeader, p_ulLength, 0);
+    NetworkFrameView l_tView;
+    int l_iResult = networkReceiveMessage(l_ptServer, &l_tView);
+    networkCloseSocket(l_ptClient);
+    networkCloseSocket(l_ptServer);
+    return l_iResult;
+}
+
+//
+// Headers that do not decode to a valid length are a protocol error
+//
+static void testMalformedHeader(void)
+{
+    // Continuation bit on the 5th byte
+    static const uint8_t s_ucTooLong[] = { 0xFF, 0xFF, 0xFF, 0xFF, 0x8F, 0x00 };
+    // 5th byte carrying bits above bit 31
+    static const uint8_t s_ucOverflow[] = { 0x80, 0x80, 0x80, 0x80, 0x10 };
+    // Complete 4-byte header of about 256 MB, above NETWORK_FRAME_MAX_SIZE
+    static const uint8_t s_ucTooLarge[] = { 0xFF, 0xFE, 0xFD, 0x7F };
+    // Largest 5-byte value, 0xFFFFFFFF
+    static const uint8_t s_ucMaxValue[] = { 0xFF, 0xFF, 0xFF, 0xFF, 0x0F };
+
+    X_TEST_CHECK(testReceiveRaw(s_ucTooLong, sizeof(s_ucTooLong)) == (int)NETWORK_ERROR);
+    X_TEST_CHECK(testReceiveRaw(s_ucOverflow, sizeof(s_ucOverflow)) == (int)NETWORK_ERROR);
+    X_TEST_CHECK(testReceiveRaw(s_ucTooLarge, sizeof(s_ucTooLarge)) == (int)NETWORK_ERROR);
+    X_TEST_CHECK(testReceiveRaw(s_ucMaxValue, sizeof(s_ucMaxValue)) == (int)NETWORK_ERROR);
+}
+
+int main(void)
+{
+    X_TEST_RUN(testRoundTrip);
+    X_TEST_RUN(testCoalescedFrames);
+    X_TEST_RUN(testMalformedHeader);
+    return X_TEST_RESULT();
+}
@@ -0,0 +1,188 @@
+////////////////////////////////////////////////////////////
+//  testNetworkLoop.c
+//  Unit tests of the xNetworkLoop reactor
+//
+// Every test runs on the epoll and poll backends over loopback TCP
+// pairs: a peer half-close reaches the read callback only, a reset
+// unregisters the socket before the close callback, and handlers
+// removed by a callback of the same batch are never dispatched and
+// are freed once the batch is over
+//
+// general discloser: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include "xNetworkLoop.h"
+#include "xTest.h"
+#include "xTestNetwork.h"
+
+#define TEST_LOOP_WAIT_MS 1000
+
+typedef struct
+{
+    int t_iReads;                   // Read callbacks
+    int t_iCloses;                  // Close callbacks
+    int t_iLastReceive;             // Result of the last receive in the read callback
+    NetworkSocket* t_ptRemove[2];   // Sockets the read callback unregisters
+} testLoopState;
+
+static const uint32_t s_ulBackends[] = { NETWORK_LOOP_FLAG_NONE, NETWORK_LOOP_FLAG_POLL };
+
+static void testOnRead(xNetworkLoop_t* p_ptLoop, NetworkSocket* p_ptSocket, void* p_pvArg)
+{
+    testLoopState* l_ptState = (testLoopState*)p_pvArg;
+    char l_cBuffer[64];
+
+    l_ptState->t_iReads++;
+    l_ptState->t_iLastReceive = networkReceive(p_ptSocket, l_cBuffer, sizeof(l_cBuffer));
+
+    for (int i = 0; i < 2; i++)
+    {
+        if (l_ptState->t_ptRemove[i] != NULL)
+        {
+            X_TEST_CHECK(xNetworkLoopRemove(p_ptLoop, l_ptState->t_ptRemove[i]) == (int)NETWORK_OK);
+            l_ptState->t_ptRemove[i] = NULL;
+        }
+    }
+}
+
+static void testOnClose(xNetworkLoop_t* p_ptLoop, NetworkSocket* p_ptSocket, void* p_pvArg)
+{
+    testLoopState* l_ptState = (testLoopState*)p_pvArg;
+    l_ptState->t_iCloses++;
+
+    // Already unregistered, the socket may be closed here
+    X_TEST_CHECK(xNetworkLoopRemove(p_ptLoop, p_ptSocket) != (int)NETWORK_OK);
+    networkCloseSocket(p_ptSocket);
+}
+
+static const xNetworkLoopCallbacks_t s_tCallbacks = { testOnRead, NULL, testOnClose };
+
+//
+// A peer shutting down its write side is a read returning 0, not a close
+//
+static void testHalfCloseIsRead(void)
+{
+    for (size_t b = 0; b < sizeof(s_ulBackends) / sizeof(s_ulBackends[0]); b++)
+    {
+        xNetworkLoop_t l_tLoop;
+        NetworkSocket* l_ptClient = NULL;
+        NetworkSocket* l_ptServer = NULL;
+        testLoopState l_tState = { 0 };
+
+        X_TEST_CHECK(xNetworkLoopCreate(&l_tLoop, s_ulBackends[b]) == (int)NETWORK_OK);
+        X_TEST_CHECK(xTestConnect(&l_ptClient, &l_ptServer));
+        X_TEST_CHECK(xNetworkLoopAdd(&l_tLoop, l_ptServer, NETWORK_LOOP_EVENT_READ, &s_tCallbacks, &l_tState) == (int)NETWORK_OK);
+
+        shutdown(l_ptClient->t_iSocketFd, SHUT_WR);
+        X_TEST_CHECK(xNetworkLoopRunOnce(&l_tLoop, TEST_LOOP_WAIT_MS) == 1);
+        X_TEST_CHECK(l_tState.t_iReads == 1);
+        X_TEST_CHECK(l_tState.t_iLastReceive == 0);
+        X_TEST_CHECK(l_tState.t_iCloses == 0);
+        X_TEST_CHECK(l_tLoop.t_ulHandlerCount == 1);
+
+        // The server may still answer the half-closed peer
+        X_TEST_CHECK(networkSend(l_ptServer, "bye", 3) == 3);
+        char l_cBuffer[4];
+        X_TEST_CHECK(networkReceive(l_ptClient, l_cBuffer, sizeof(l_cBuffer)) == 3);
+
+        X_TEST_CHECK(xNetworkLoopRemove(&l_tLoop, l_ptServer) == (int)NETWORK_OK);
+        X_TEST_CHECK(l_tLoop.t_ulHandlerCount == 0);
+        networkCloseSocket(l_ptServer);
+        networkCloseSocket(l_ptClient);
+        X_TEST_CHECK(xNetworkLoopDestroy(&l_tLoop) == (int)NETWORK_OK);
+    }
+}
+
+//
+// A reset connection is unregistered and handed to the close callback once
+//
+static void testResetIsClose(void)
+{
+    for (size_t b = 0; b < sizeof(s_ulBackends) / sizeof(s_ulBackends[0]); b++)
+    {
+        xNetworkLoop_t l_tLoop;
+        NetworkSocket* l_ptClient = NULL;
+        NetworkSocket* l_ptServer = NULL;
+        testLoopState l_tState = { 0 };
+
+        X_TEST_CHECK(xNetworkLoopCreate(&l_tLoop, s_ulBackends[b]) == (int)NETWORK_OK);
+        X_TEST_CHECK(xTestConnect(&l_ptClient, &l_ptServer));
+        X_TEST_CHECK(xNetworkLoopAdd(&l_tLoop, l_ptServer, NETWORK_LOOP_EVENT_READ, &s_tCallbacks, &l_tState) == (int)NETWORK_OK);
+
+        // A zero linger close sends a RST
+        struct linger l_tLinger = { 1, 0 };
+        setsockopt(l_ptClient->t_iSocketFd, SOL_SOCKET, SO_LINGER, &l_tLinger, sizeof(l_tLinger));
+        networkCloseSocket(l_ptClient);
+
+        X_TEST_CHECK(xNetworkLoopRunOnce(&l_tLoop, TEST_LOOP_WAIT_MS) == 1);
+        X_TEST_CHECK(l_tState.t_iCloses == 1);
+        X_TEST_CHECK(l_tLoop.t_ulHandlerCount == 0);
+
+        // Nothing is left registered on the closed descriptor
+        X_TEST_CHECK(xNetworkLoopRunOnce(&l_tLoop, 50) == 0);
+        X_TEST_CHECK(l_tState.t_iCloses == 1);
+        X_TEST_CHECK(xNetworkLoopDestroy(&l_tLoop) == (int)NETWORK_OK);
+    }
+}
+
+//
+// Two ready sockets, the first callback of the batch removes both: the
+// second event must be skipped and both handlers be reusable afterwards
+//
+static void testRemoveDuringDispatch(void)
+{
+    for (size_t b = 0; b < sizeof(s_ulBackends) / sizeof(s_ulBackends[0]); b++)
+    {
+        xNetworkLoop_t l_tLoop;
+        NetworkSocket* l_ptClients[2] = { NULL, NULL };
+        NetworkSocket* l_ptServers[2] = { NULL, NULL };
+        testLoopState l_tState = { 0 };
+
+        X_TEST_CHECK(xNetworkLoopCreate(&l_tLoop, s_ulBackends[b]) == (int)NETWORK_OK);
+        for (int i = 0; i < 2; i++)
+        {
+            X_TEST_CHECK(xTestConnect(&l_ptClients[i], &l_ptServers[i]));
+            X_TEST_CHECK(xNetworkLoopAdd(&l_tLoop, l_ptServers[i], NETWORK_LOOP_EVENT_READ, &s_tCallbacks, &l_tState) == (int)NETWORK_OK);
+            X_TEST_CHECK(networkSend(l_ptClients[i], "ping", 4) == 4);
+            l_tState.t_ptRemove[i] = l_ptServers[i];
+        }
+
+        // Both sockets are readable before the wait
+        usleep(10000);
+        X_TEST_CHECK(xNetworkLoopRunOnce(&l_tLoop, TEST_LOOP_WAIT_MS) == 1);
+        X_TEST_CHECK(l_tState.t_iReads == 1);
+        X_TEST_CHECK(l_tLoop.t_ulHandlerCount == 0);
+        X_TEST_CHECK(l_tLoop.t_ptDeferred == NULL);
+
+        // The unread socket is still readable once registered again
+        l_tState.t_iReads = 0;
+        for (int i = 0; i < 2; i++)
+        {
+            X_TEST_CHECK(xNetworkLoopAdd(&l_tLoop, l_ptServers[i], NETWORK_LOOP_EVENT_READ, &s_tCallbacks, &l_tState) == (int)NETWORK_OK);
+        }
+        X_TEST_CHECK(xNetworkLoopRunOnce(&l_tLoop, TEST_LOOP_WAIT_MS) == 1);
+        X_TEST_CHECK(l_tState.t_iReads == 1);
+        X_TEST_CHECK(l_tState.t_iLastReceive == 4);
+
+        for (int i = 0; i < 2; i++)
+        {
+            X_TEST_CHECK(xNetworkLoopRemove(&l_tLoop, l_ptServers[i]) == (int)NETWORK_OK);
+            networkCloseSocket(l_ptServers[i]);
+            networkCloseSocket(l_ptClients[i]);
+        }
+        X_TEST_CHECK(xNetworkLoopDestroy(&l_tLoop) == (int)NETWORK_OK);
+    }
+}
+
+int main(void)
+{
+    X_TEST_RUN(testHalfCloseIsRead);
+    X_TEST_RUN(testResetIsClose);
+    X_TEST_RUN(testRemoveDuringDispatch);
+    return X_TEST_RESULT();
+}
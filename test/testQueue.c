@@ -0,0 +1,188 @@
+////////////////////////////////////////////////////////////
+//  testQueue.c
+//  Unit tests of the SPSC and MPMC queues
+//
+// Waits on an empty or full queue give up with XOS_QUEUE_TIMEOUT once
+// their deadline has passed, and a parked consumer is woken by the
+// next push. Under contention every item is delivered exactly once,
+// in order on an SPSC queue
+//
+// general discloser: copy or share the file is forbidden
+// Written : 15/10/2026
+////////////////////////////////////////////////////////////
+
+#include <pthread.h>
+#include <string.h>
+#include <unistd.h>
+#include "xOsQueue.h"
+#include "xTest.h"
+
+#define TEST_QUEUE_THREADS 4
+#define TEST_QUEUE_ITEMS   50000
+
+//
+// Empty and full queues time out, not before the deadline
+//
+static void testQueueTimeouts(void)
+{
+    xOsQueue_t l_tQueue;
+    X_TEST_CHECK(xOsQueueCreate(&l_tQueue, XOS_QUEUE_SPSC, 4, sizeof(int)) == (int)XOS_QUEUE_OK);
+    X_TEST_CHECK(xOsQueueCapacity(&l_tQueue) == 4);
+
+    int l_iItem = 0;
+    uint64_t l_ulStart = xTestNowMs();
+    X_TEST_CHECK(xOsQueuePopWait(&l_tQueue, &l_iItem, 50) == (int)XOS_QUEUE_TIMEOUT);
+    X_TEST_CHECK(xTestNowMs() - l_ulStart >= 50);
+
+    for (int i = 0; i < 4; i++)
+    {
+        X_TEST_CHECK(xOsQueuePush(&l_tQueue, &i) == (int)XOS_QUEUE_OK);
+    }
+    X_TEST_CHECK(xOsQueuePush(&l_tQueue, &l_iItem) == (int)XOS_QUEUE_FULL);
+
+    l_ulStart = xTestNowMs();
+    X_TEST_CHECK(xOsQueuePushWait(&l_tQueue, &l_iItem, 50) == (int)XOS_QUEUE_TIMEOUT);
+    X_TEST_CHECK(xTestNowMs() - l_ulStart >= 50);
+
+    // A zero timeout only tries once
+    X_TEST_CHECK(xOsQueuePushWait(&l_tQueue, &l_iItem, 0) == (int)XOS_QUEUE_TIMEOUT);
+    X_TEST_CHECK(xOsQueueCount(&l_tQueue) == 4);
+
+    X_TEST_CHECK(xOsQueueDestroy(&l_tQueue) == (int)XOS_QUEUE_OK);
+}
+
+static void* testQueueLatePush(void* p_pvArg)
+{
+    xOsQueue_t* l_ptQueue = (xOsQueue_t*)p_pvArg;
+    int l_iItem = 42;
+    usleep(50000);
+    X_TEST_CHECK(xOsQueuePush(l_ptQueue, &l_iItem) == (int)XOS_QUEUE_OK);
+    return NULL;
+}
+
+//
+// A parked consumer is woken by the push, long before its deadline
+//
+static void testQueueWake(void)
+{
+    xOsQueue_t l_tQueue;
+    X_TEST_CHECK(xOsQueueCreate(&l_tQueue, XOS_QUEUE_MPMC, 4, sizeof(int)) == (int)XOS_QUEUE_OK);
+
+    pthread_t l_tThread;
+    pthread_create(&l_tThread, NULL, testQueueLatePush, &l_tQueue);
+
+    int l_iItem = 0;
+    uint64_t l_ulStart = xTestNowMs();
+    X_TEST_CHECK(xOsQueuePopWait(&l_tQueue, &l_iItem, 10000) == (int)XOS_QUEUE_OK);
+    X_TEST_CHECK(l_iItem == 42);
+    X_TEST_CHECK(xTestNowMs() - l_ulStart < 5000);
+
+    pthread_join(l_tThread, NULL);
+    X_TEST_CHECK(xOsQueueDestroy(&l_tQueue) == (int)XOS_QUEUE_OK);
+}
+
+static void* testSpscProducer(void* p_pvArg)
+{
+    xOsQueue_t* l_ptQueue = (xOsQueue_t*)p_pvArg;
+    for (uint32_t i = 0; i < TEST_QUEUE_ITEMS; i++)
+    {
+        X_TEST_CHECK(xOsQueuePushWait(l_ptQueue, &i, -1) == (int)XOS_QUEUE_OK);
+    }
+    return NULL;
+}
+
+//
+// A small SPSC queue parks both sides in turn, items stay in order
+//
+static void testSpscOrder(void)
+{
+    xOsQueue_t l_tQueue;
+    X_TEST_CHECK(xOsQueueCreate(&l_tQueue, XOS_QUEUE_SPSC, 8, sizeof(uint32_t)) == (int)XOS_QUEUE_OK);
+
+    pthread_t l_tThread;
+    pthread_create(&l_tThread, NULL, testSpscProducer, &l_tQueue);
+
+    bool l_bOrdered = true;
+    for (uint32_t i = 0; i < TEST_QUEUE_ITEMS; i++)
+    {
+        uint32_t l_ulItem = 0;
+        X_TEST_CHECK(xOsQueuePopWait(&l_tQueue, &l_ulItem, -1) == (int)XOS_QUEUE_OK);
+        l_bOrdered = l_bOrdered && (l_ulItem == i);
+    }
+    X_TEST_CHECK(l_bOrdered);
+
+    pthread_join(l_tThread, NULL);
+    X_TEST_CHECK(xOsQueueCount(&l_tQueue) == 0);
+    X_TEST_CHECK(xOsQueueDestroy(&l_tQueue) == (int)XOS_QUEUE_OK);
+}
+
+static xOsQueue_t s_tMpmcQueue;
+static atomic_uchar s_ucSeen[TEST_QUEUE_THREADS * TEST_QUEUE_ITEMS];
+static atomic_int s_iPopped;
+
+static void* testMpmcProducer(void* p_pvArg)
+{
+    uint32_t l_ulBase = (uint32_t)(uintptr_t)p_pvArg * TEST_QUEUE_ITEMS;
+    for (uint32_t i = 0; i < TEST_QUEUE_ITEMS; i++)
+    {
+        uint32_t l_ulItem = l_ulBase + i;
+        X_TEST_CHECK(xOsQueuePushWait(&s_tMpmcQueue, &l_ulItem, -1) == (int)XOS_QUEUE_OK);
+    }
+    return NULL;
+}
+
+static void* testMpmcConsumer(void* p_pvArg)
+{
+    (void)p_pvArg;
+    while (atomic_load(&s_iPopped) < TEST_QUEUE_THREADS * TEST_QUEUE_ITEMS)
+    {
+        // Bounded wait, the last items may be taken by another consumer
+        uint32_t l_ulItem = 0;
+        if (xOsQueuePopWait(&s_tMpmcQueue, &l_ulItem, 10) != (int)XOS_QUEUE_OK)
+            continue;
+        X_TEST_CHECK(l_ulItem < TEST_QUEUE_THREADS * TEST_QUEUE_ITEMS);
+        atomic_fetch_add(&s_ucSeen[l_ulItem], 1);
+        atomic_fetch_add(&s_iPopped, 1);
+    }
+    return NULL;
+}
+
+//
+// Producers and consumers on one MPMC queue, each item popped once
+//
+static void testMpmcContention(void)
+{
+    X_TEST_CHECK(xOsQueueCreate(&s_tMpmcQueue, XOS_QUEUE_MPMC, 64, sizeof(uint32_t)) == (int)XOS_QUEUE_OK);
+    memset(s_ucSeen, 0, sizeof(s_ucSeen));
+    atomic_store(&s_iPopped, 0);
+
+    pthread_t l_tProducers[TEST_QUEUE_THREADS];
+    pthread_t l_tConsumers[TEST_QUEUE_THREADS];
+    for (int i = 0; i < TEST_QUEUE_THREADS; i++)
+    {
+        pthread_create(&l_tConsumers[i], NULL, testMpmcConsumer, NULL);
+        pthread_create(&l_tProducers[i], NULL, testMpmcProducer, (void*)(uintptr_t)i);
+    }
+    for (int i = 0; i < TEST_QUEUE_THREADS; i++)
+    {
+        pthread_join(l_tProducers[i], NULL);
+        pthread_join(l_tConsumers[i], NULL);
+    }
+
+    int l_iOnce = 0;
+    for (int i = 0; i < TEST_QUEUE_THREADS * TEST_QUEUE_ITEMS; i++)
+    {
+        l_iOnce += (atomic_load(&s_ucSeen[i]) == 1);
+    }
+    X_TEST_CHECK(l_iOnce == TEST_QUEUE_THREADS * TEST_QUEUE_ITEMS);
+    X_TEST_CHECK(xOsQueueDestroy(&s_tMpmcQueue) == (int)XOS_QUEUE_OK);
+}
+
+int main(void)
+{
+    X_TEST_RUN(testQueueTimeouts);
+    X_TEST_RUN(testQueueWake);
+    X_TEST_RUN(testSpscOrder);
+    X_TEST_RUN(testMpmcContention);
+    return X_TEST_RESULT();
+}
@@ -0,0 +1,190 @@
+////////////////////////////////////////////////////////////
+//  testSemaphore.c
+//  Unit tests of the lightweight semaphore and of the event
+//
+// Timed waits give up with OS_SEM_TIMEOUT once their deadline has
+// passed. Posts are never lost between contended waiters, an
+// auto-reset event releases one waiter per signal and a manual-reset
+// event releases every waiter until it is cleared
+//
+// general discloser: copy or share the file is forbidden
+// Written : 15/10/2026
+////////////////////////////////////////////////////////////
+
+#include <pthread.h>
+#include <unistd.h>
+#include "xOsSemaphore.h"
+#include "xTest.h"
+
+#define TEST_SEM_THREADS 4
+#define TEST_SEM_ROUNDS  20000
+
+//
+// A semaphore at zero times out, a posted one is taken at once
+//
+static void testFastSemTimeout(void)
+{
+    t_OSFastSemCtx l_tSem;
+    X_TEST_CHECK(osFastSemInit(&l_tSem, 0) == (int)OS_SEM_SUCCESS);
+    X_TEST_CHECK(osFastSemTryWait(&l_tSem) == (int)OS_SEM_NOT_AVAILABLE);
+
+    uint64_t l_ulStart = xTestNowMs();
+    X_TEST_CHECK(osFastSemWaitTimeout(&l_tSem, 50) == (int)OS_SEM_TIMEOUT);
+    X_TEST_CHECK(xTestNowMs() - l_ulStart >= 50);
+
+    X_TEST_CHECK(osFastSemPost(&l_tSem) == (int)OS_SEM_SUCCESS);
+    X_TEST_CHECK(osFastSemWaitTimeout(&l_tSem, 50) == (int)OS_SEM_SUCCESS);
+
+    int l_iValue = -1;
+    X_TEST_CHECK(osFastSemGetValue(&l_tSem, &l_iValue) == (int)OS_SEM_SUCCESS);
+    X_TEST_CHECK(l_iValue == 0);
+    X_TEST_CHECK(osFastSemDestroy(&l_tSem) == (int)OS_SEM_SUCCESS);
+}
+
+static t_OSFastSemCtx s_tItems;
+static t_OSFastSemCtx s_tRoom;
+
+static void* testFastSemProducer(void* p_pvArg)
+{
+    (void)p_pvArg;
+    for (int i = 0; i < TEST_SEM_ROUNDS; i++)
+    {
+        X_TEST_CHECK(osFastSemWait(&s_tRoom) == (int)OS_SEM_SUCCESS);
+        X_TEST_CHECK(osFastSemPost(&s_tItems) == (int)OS_SEM_SUCCESS);
+    }
+    return NULL;
+}
+
+static void* testFastSemConsumer(void* p_pvArg)
+{
+    (void)p_pvArg;
+    for (int i = 0; i < TEST_SEM_ROUNDS; i++)
+    {
+        X_TEST_CHECK(osFastSemWait(&s_tItems) == (int)OS_SEM_SUCCESS);
+        X_TEST_CHECK(osFastSemPost(&s_tRoom) == (int)OS_SEM_SUCCESS);
+    }
+    return NULL;
+}
+
+//
+// Bounded buffer handshake, every post wakes or feeds one waiter
+//
+static void testFastSemContention(void)
+{
+    X_TEST_CHECK(osFastSemInit(&s_tItems, 0) == (int)OS_SEM_SUCCESS);
+    X_TEST_CHECK(osFastSemInit(&s_tRoom, 2) == (int)OS_SEM_SUCCESS);
+
+    pthread_t l_tProducers[TEST_SEM_THREADS];
+    pthread_t l_tConsumers[TEST_SEM_THREADS];
+    for (int i = 0; i < TEST_SEM_THREADS; i++)
+    {
+        pthread_create(&l_tProducers[i], NULL, testFastSemProducer, NULL);
+        pthread_create(&l_tConsumers[i], NULL, testFastSemConsumer, NULL);
+    }
+    for (int i = 0; i < TEST_SEM_THREADS; i++)
+    {
+        pthread_join(l_tProducers[i], NULL);
+        pthread_join(l_tConsumers[i], NULL);
+    }
+
+    int l_iItems = -1;
+    int l_iRoom = -1;
+    osFastSemGetValue(&s_tItems, &l_iItems);
+    osFastSemGetValue(&s_tRoom, &l_iRoom);
+    X_TEST_CHECK(l_iItems == 0 && l_iRoom == 2);
+    X_TEST_CHECK(atomic_load(&s_tItems.a_iWaiters) == 0 && atomic_load(&s_tRoom.a_iWaiters) == 0);
+
+    osFastSemDestroy(&s_tItems);
+    osFastSemDestroy(&s_tRoom);
+}
+
+static t_OSEventCtx s_tEvent;
+static atomic_int s_iReleased;
+
+static void* testEventWaiter(void* p_pvArg)
+{
+    (void)p_pvArg;
+    if (osEventWaitTimeout(&s_tEvent, 2000) == (int)OS_SEM_SUCCESS)
+    {
+        atomic_fetch_add(&s_iReleased, 1);
+    }
+    return NULL;
+}
+
+//
+// An unsignaled event times out, a signaled one is taken at once
+//
+static void testEventTimeout(void)
+{
+    X_TEST_CHECK(osEventInit(&s_tEvent, OS_EVENT_AUTO_RESET, false) == (int)OS_SEM_SUCCESS);
+
+    uint64_t l_ulStart = xTestNowMs();
+    X_TEST_CHECK(osEventWaitTimeout(&s_tEvent, 50) == (int)OS_SEM_TIMEOUT);
+    X_TEST_CHECK(xTestNowMs() - l_ulStart >= 50);
+
+    // The auto-reset event is cleared by the wait it releases
+    X_TEST_CHECK(osEventSet(&s_tEvent) == (int)OS_SEM_SUCCESS);
+    X_TEST_CHECK(osEventWaitTimeout(&s_tEvent, 50) == (int)OS_SEM_SUCCESS);
+    X_TEST_CHECK(osEventWaitTimeout(&s_tEvent, 10) == (int)OS_SEM_TIMEOUT);
+
+    X_TEST_CHECK(osEventDestroy(&s_tEvent) == (int)OS_SEM_SUCCESS);
+}
+
+//
+// Auto-reset releases one waiter per signal, manual-reset all of them
+//
+static void testEventRelease(void)
+{
+    pthread_t l_tThreads[TEST_SEM_THREADS];
+
+    X_TEST_CHECK(osEventInit(&s_tEvent, OS_EVENT_AUTO_RESET, false) == (int)OS_SEM_SUCCESS);
+    atomic_store(&s_iReleased, 0);
+    for (int i = 0; i < TEST_SEM_THREADS; i++)
+    {
+        pthread_create(&l_tThreads[i], NULL, testEventWaiter, NULL);
+    }
+    usleep(50000);
+    X_TEST_CHECK(osEventSet(&s_tEvent) == (int)OS_SEM_SUCCESS);
+    usleep(50000);
+    X_TEST_CHECK(atomic_load(&s_iReleased) == 1);
+    for (int i = 1; i < TEST_SEM_THREADS; i++)
+    {
+        osEventSet(&s_tEvent);
+        usleep(10000);
+    }
+    for (int i = 0; i < TEST_SEM_THREADS; i++)
+    {
+        pthread_join(l_tThreads[i], NULL);
+    }
+    X_TEST_CHECK(atomic_load(&s_iReleased) == TEST_SEM_THREADS);
+    osEventDestroy(&s_tEvent);
+
+    X_TEST_CHECK(osEventInit(&s_tEvent, OS_EVENT_MANUAL_RESET, false) == (int)OS_SEM_SUCCESS);
+    atomic_store(&s_iReleased, 0);
+    for (int i = 0; i < TEST_SEM_THREADS; i++)
+    {
+        pthread_create(&l_tThreads[i], NULL, testEventWaiter, NULL);
+    }
+    usleep(50000);
+    X_TEST_CHECK(osEventSet(&s_tEvent) == (int)OS_SEM_SUCCESS);
+    for (int i = 0; i < TEST_SEM_THREADS; i++)
+    {
+        pthread_join(l_tThreads[i], NULL);
+    }
+    X_TEST_CHECK(atomic_load(&s_iReleased) == TEST_SEM_THREADS);
+
+    // Still signaled until cleared
+    X_TEST_CHECK(osEventWaitTimeout(&s_tEvent, 0) == (int)OS_SEM_SUCCESS);
+    X_TEST_CHECK(osEventReset(&s_tEvent) == (int)OS_SEM_SUCCESS);
+    X_TEST_CHECK(osEventWaitTimeout(&s_tEvent, 10) == (int)OS_SEM_TIMEOUT);
+    osEventDestroy(&s_tEvent);
+}
+
+int main(void)
+{
+    X_TEST_RUN(testFastSemTimeout);
+    X_TEST_RUN(testFastSemContention);
+    X_TEST_RUN(testEventTimeout);
+    X_TEST_RUN(testEventRelease);
+    return X_TEST_RESULT();
+}
@@ -0,0 +1,200 @@
+////////////////////////////////////////////////////////////
+//  testThreadPool.c
+//  Unit tests of the thread pool, wait groups and futures
+//
+// Every submitted job runs once, also when jobs submit and wait for
+// their own children. Wait groups and futures time out while the work
+// is pending, and a future can be destroyed as soon as it reports its
+// result, while the worker may still be signalling
+//
+// general discloser: copy or share the file is forbidden
+// Written : 15/10/2026
+////////////////////////////////////////////////////////////
+
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include "xOsThreadPool.h"
+#include "xTest.h"
+
+#define TEST_POOL_WORKERS 4
+#define TEST_POOL_JOBS    2000
+#define TEST_POOL_FUTURES 1000
+
+static xOsThreadPool_t s_tPool;
+static atomic_int s_iRuns;
+
+static void testPoolSubmit(xOsPoolJobFn p_pfJob, void* p_pvArg, xOsWaitGroup_t* p_ptGroup)
+{
+    // A full queue is retried once the workers have taken some jobs
+    int l_iRet;
+    while ((l_iRet = xOsThreadPoolSubmit(&s_tPool, p_pfJob, p_pvArg, p_ptGroup)) == (int)XOS_POOL_FULL)
+    {
+        sched_yield();
+    }
+    X_TEST_CHECK(l_iRet == (int)XOS_POOL_OK);
+}
+
+static void* testPoolCount(void* p_pvArg)
+{
+    (void)p_pvArg;
+    atomic_fetch_add(&s_iRuns, 1);
+    return NULL;
+}
+
+//
+// Jobs queued from outside the pool all run once
+//
+static void testPoolWaitGroup(void)
+{
+    xOsWaitGroup_t l_tGroup;
+    X_TEST_CHECK(xOsWaitGroupInit(&l_tGroup) == (int)XOS_POOL_OK);
+    atomic_store(&s_iRuns, 0);
+
+    uint64_t l_ulExecutedBefore = 0;
+    xOsThreadPoolGetStats(&s_tPool, &l_ulExecutedBefore, NULL);
+
+    for (int i = 0; i < TEST_POOL_JOBS; i++)
+    {
+        testPoolSubmit(testPoolCount, NULL, &l_tGroup);
+    }
+    X_TEST_CHECK(xOsWaitGroupWait(&l_tGroup, -1) == (int)XOS_POOL_OK);
+    X_TEST_CHECK(atomic_load(&s_iRuns) == TEST_POOL_JOBS);
+
+    uint64_t l_ulExecuted = 0;
+    X_TEST_CHECK(xOsThreadPoolGetStats(&s_tPool, &l_ulExecuted, NULL) == (int)XOS_POOL_OK);
+    X_TEST_CHECK(l_ulExecuted - l_ulExecutedBefore == TEST_POOL_JOBS);
+    X_TEST_CHECK(xOsWaitGroupDestroy(&l_tGroup) == (int)XOS_POOL_OK);
+}
+
+static void* testPoolSplit(void* p_pvArg)
+{
+    int l_iDepth = (int)(intptr_t)p_pvArg;
+    atomic_fetch_add(&s_iRuns, 1);
+    if (l_iDepth == 0)
+    {
+        return NULL;
+    }
+
+    // Waiting from a job runs queued jobs instead of blocking the worker
+    xOsWaitGroup_t l_tGroup;
+    xOsWaitGroupInit(&l_tGroup);
+    testPoolSubmit(testPoolSplit, (void*)(intptr_t)(l_iDepth - 1), &l_tGroup);
+    testPoolSubmit(testPoolSplit, (void*)(intptr_t)(l_iDepth - 1), &l_tGroup);
+    X_TEST_CHECK(xOsThreadPoolWait(&s_tPool, &l_tGroup) == (int)XOS_POOL_OK);
+    xOsWaitGroupDestroy(&l_tGroup);
+    return NULL;
+}
+
+//
+// Jobs that split into children and wait for them, deeper than the worker count
+//
+static void testPoolNestedWait(void)
+{
+    xOsWaitGroup_t l_tGroup;
+    xOsWaitGroupInit(&l_tGroup);
+    atomic_store(&s_iRuns, 0);
+
+    testPoolSubmit(testPoolSplit, (void*)(intptr_t)10, &l_tGroup);
+    X_TEST_CHECK(xOsThreadPoolWait(&s_tPool, &l_tGroup) == (int)XOS_POOL_OK);
+
+    // A full binary tree of depth 10
+    X_TEST_CHECK(atomic_load(&s_iRuns) == (1 << 11) - 1);
+    xOsWaitGroupDestroy(&l_tGroup);
+}
+
+//
+// A wait group with pending work times out, not before the deadline
+//
+static void testWaitGroupTimeout(void)
+{
+    xOsWaitGroup_t l_tGroup;
+    xOsWaitGroupInit(&l_tGroup);
+    X_TEST_CHECK(xOsWaitGroupAdd(&l_tGroup, 1) == (int)XOS_POOL_OK);
+
+    uint64_t l_ulStart = xTestNowMs();
+    X_TEST_CHECK(xOsWaitGroupWait(&l_tGroup, 50) == (int)XOS_POOL_TIMEOUT);
+    X_TEST_CHECK(xTestNowMs() - l_ulStart >= 50);
+
+    X_TEST_CHECK(xOsWaitGroupDone(&l_tGroup) == (int)XOS_POOL_OK);
+    X_TEST_CHECK(xOsWaitGroupWait(&l_tGroup, 0) == (int)XOS_POOL_OK);
+    xOsWaitGroupDestroy(&l_tGroup);
+}
+
+static void* testPoolDouble(void* p_pvArg)
+{
+    return (void*)((intptr_t)p_pvArg * 2);
+}
+
+static void* testPoolSlow(void* p_pvArg)
+{
+    usleep(200000);
+    return p_pvArg;
+}
+
+//
+// Futures deliver the job result, a timed get expires while the job runs
+//
+static void testFutureResult(void)
+{
+    xOsFuture_t l_tFuture;
+    X_TEST_CHECK(xOsThreadPoolSubmitFuture(&s_tPool, testPoolSlow, (void*)(intptr_t)7, &l_tFuture) == (int)XOS_POOL_OK);
+
+    void* l_pvResult = NULL;
+    X_TEST_CHECK(xOsFutureGet(&l_tFuture, &l_pvResult, 20) == (int)XOS_POOL_TIMEOUT);
+    X_TEST_CHECK(!xOsFutureIsReady(&l_tFuture));
+    X_TEST_CHECK(xOsFutureGet(&l_tFuture, &l_pvResult, -1) == (int)XOS_POOL_OK);
+    X_TEST_CHECK((intptr_t)l_pvResult == 7);
+    X_TEST_CHECK(xOsFutureIsReady(&l_tFuture));
+    X_TEST_CHECK(xOsFutureDestroy(&l_tFuture) == (int)XOS_POOL_OK);
+
+    xOsFuture_t l_tFutures[64];
+    for (int i = 0; i < 64; i++)
+    {
+        X_TEST_CHECK(xOsThreadPoolSubmitFuture(&s_tPool, testPoolDouble, (void*)(intptr_t)i, &l_tFutures[i]) == (int)XOS_POOL_OK);
+    }
+    for (int i = 0; i < 64; i++)
+    {
+        X_TEST_CHECK(xOsFutureGet(&l_tFutures[i], &l_pvResult, -1) == (int)XOS_POOL_OK);
+        X_TEST_CHECK((intptr_t)l_pvResult == 2 * i);
+        xOsFutureDestroy(&l_tFutures[i]);
+    }
+}
+
+//
+// A future polled ready is destroyed at once, the signalling worker is waited for
+//
+static void testFutureDestroyWhenReady(void)
+{
+    for (int i = 0; i < TEST_POOL_FUTURES; i++)
+    {
+        xOsFuture_t l_tFuture;
+        X_TEST_CHECK(xOsThreadPoolSubmitFuture(&s_tPool, testPoolDouble, (void*)(intptr_t)i, &l_tFuture) == (int)XOS_POOL_OK);
+        while (!xOsFutureIsReady(&l_tFuture))
+        {
+            sched_yield();
+        }
+        X_TEST_CHECK(xOsFutureDestroy(&l_tFuture) == (int)XOS_POOL_OK);
+    }
+}
+
+int main(void)
+{
+    xOsThreadPoolConfig_t l_tConfig = { 0 };
+    l_tConfig.t_iWorkers = TEST_POOL_WORKERS;
+    l_tConfig.t_ulCapacity = 256;
+    if (xOsThreadPoolCreate(&s_tPool, &l_tConfig) != (int)XOS_POOL_OK)
+    {
+        fprintf(stderr, "thread pool creation failed\n");
+        return 1;
+    }
+
+    X_TEST_RUN(testPoolWaitGroup);
+    X_TEST_RUN(testPoolNestedWait);
+    X_TEST_RUN(testWaitGroupTimeout);
+    X_TEST_RUN(testFutureResult);
+    X_TEST_RUN(testFutureDestroyWhenReady);
+
+    X_TEST_CHECK(xOsThreadPoolDestroy(&s_tPool) == (int)XOS_POOL_OK);
+    return X_TEST_RESULT();
+}
@@ -0,0 +1,176 @@
+////////////////////////////////////////////////////////////
+//  testTimerService.c
+//  Unit tests of the timing wheel timer service
+//
+// Timers parked on the upper levels cascade down and fire once, never
+// before their delay. A timer stopped while its callback runs, from
+// another thread or from the callback itself, does not fire again. A
+// restart pushes the expiry back and a one-shot re-armed from its own
+// callback fires once per arming
+//
+// general discloser: copy or share the file is forbidden
+// Written : 15/10/2026
+////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include <unistd.h>
+#include "xTimerService.h"
+#include "xTest.h"
+
+// Tick of the level test, level 1 starts at 256 ticks and level 2 at 65536
+#define TEST_TIMER_FINE_TICK_US 10
+
+typedef struct
+{
+    xOsTimerEntry_t t_tEntry;
+    uint64_t t_ulStartMs;
+    atomic_ulong a_ulFiredMs;               // Time of the last expiry
+    atomic_int a_iCount;
+    int t_iStopAt;                          // Expiry that stops the timer from its callback (0 never)
+    int t_iRearms;                          // One-shot re-arms left
+    int t_iSleepMs;                         // Time spent in the callback
+    atomic_bool a_bInCallback;
+} testTimer_t;
+
+static void testTimerCallback(void* p_pvArg)
+{
+    testTimer_t* l_ptTimer = (testTimer_t*)p_pvArg;
+    atomic_store(&l_ptTimer->a_bInCallback, true);
+    atomic_store(&l_ptTimer->a_ulFiredMs, xTestNowMs());
+    int l_iCount = atomic_fetch_add(&l_ptTimer->a_iCount, 1) + 1;
+
+    if (l_ptTimer->t_iSleepMs > 0)
+        usleep((useconds_t)l_ptTimer->t_iSleepMs * 1000);
+    if (l_iCount == l_ptTimer->t_iStopAt)
+        X_TEST_CHECK(xTimerEntryStop(&l_ptTimer->t_tEntry) == (int)XOS_TIMER_OK);
+    if (l_ptTimer->t_iRearms > 0)
+    {
+        l_ptTimer->t_iRearms--;
+        X_TEST_CHECK(xTimerEntryStart(&l_ptTimer->t_tEntry, 2000, 0) == (int)XOS_TIMER_OK);
+    }
+    atomic_store(&l_ptTimer->a_bInCallback, false);
+}
+
+static void testTimerInit(testTimer_t* p_ptTimer, xOsTimerService_t* p_ptService)
+{
+    memset(p_ptTimer, 0, sizeof(*p_ptTimer));
+    xTimerEntryInit(&p_ptTimer->t_tEntry, p_ptService, testTimerCallback, p_ptTimer);
+}
+
+static void testTimerWaitCount(testTimer_t* p_ptTimer, int p_iCount, int p_iTimeoutMs)
+{
+    uint64_t l_ulEnd = xTestNowMs() + (uint64_t)p_iTimeoutMs;
+    while (atomic_load(&p_ptTimer->a_iCount) < p_iCount && xTestNowMs() < l_ulEnd)
+    {
+        usleep(1000);
+    }
+}
+
+//
+// Level 0, level 1 and level 2 timers each fire once, not early
+//
+static void testTimerLevelBoundary(void)
+{
+    xOsTimerService_t l_tService;
+    X_TEST_CHECK(xTimerServiceCreate(&l_tService, TEST_TIMER_FINE_TICK_US) == (int)XOS_TIMER_OK);
+
+    // 100, 500 and 70000 ticks
+    static const uint64_t l_ulDelaysUs[3] = { 1000, 5000, 700000 };
+    testTimer_t l_tTimers[3];
+    for (int i = 0; i < 3; i++)
+    {
+        testTimerInit(&l_tTimers[i], &l_tService);
+        l_tTimers[i].t_ulStartMs = xTestNowMs();
+        X_TEST_CHECK(xTimerEntryStart(&l_tTimers[i].t_tEntry, l_ulDelaysUs[i], 0) == (int)XOS_TIMER_OK);
+    }
+
+    testTimerWaitCount(&l_tTimers[2], 1, 5000);
+    usleep(20000);
+    for (int i = 0; i < 3; i++)
+    {
+        X_TEST_CHECK(atomic_load(&l_tTimers[i].a_iCount) == 1);
+        X_TEST_CHECK(atomic_load(&l_tTimers[i].a_ulFiredMs) - l_tTimers[i].t_ulStartMs >= l_ulDelaysUs[i] / 1000);
+        X_TEST_CHECK(!xTimerEntryIsArmed(&l_tTimers[i].t_tEntry));
+    }
+
+    X_TEST_CHECK(xTimerServiceDestroy(&l_tService) == (int)XOS_TIMER_OK);
+}
+
+//
+// A periodic timer stopped while its callback runs does not fire again
+//
+static void testTimerCancelWhileFiring(void)
+{
+    xOsTimerService_t l_tService;
+    X_TEST_CHECK(xTimerServiceCreate(&l_tService, 0) == (int)XOS_TIMER_OK);
+
+    // Stopped from another thread in the middle of the callback
+    testTimer_t l_tTimer;
+    testTimerInit(&l_tTimer, &l_tService);
+    l_tTimer.t_iSleepMs = 50;
+    X_TEST_CHECK(xTimerEntryStart(&l_tTimer.t_tEntry, 10000, 10000) == (int)XOS_TIMER_OK);
+    while (!atomic_load(&l_tTimer.a_bInCallback))
+    {
+        usleep(1000);
+    }
+    X_TEST_CHECK(xTimerEntryStop(&l_tTimer.t_tEntry) == (int)XOS_TIMER_OK);
+    X_TEST_CHECK(!xTimerEntryIsArmed(&l_tTimer.t_tEntry));
+    usleep(150000);
+    X_TEST_CHECK(atomic_load(&l_tTimer.a_iCount) == 1);
+
+    // Stopped by its own callback on the third expiry
+    testTimerInit(&l_tTimer, &l_tService);
+    l_tTimer.t_iStopAt = 3;
+    X_TEST_CHECK(xTimerEntryStart(&l_tTimer.t_tEntry, 5000, 5000) == (int)XOS_TIMER_OK);
+    testTimerWaitCount(&l_tTimer, 3, 2000);
+    usleep(50000);
+    X_TEST_CHECK(atomic_load(&l_tTimer.a_iCount) == 3);
+    X_TEST_CHECK(!xTimerEntryIsArmed(&l_tTimer.t_tEntry));
+
+    X_TEST_CHECK(xTimerServiceDestroy(&l_tService) == (int)XOS_TIMER_OK);
+}
+
+//
+// Restart pushes the expiry back, a callback re-arms its own one-shot
+//
+static void testTimerRearm(void)
+{
+    xOsTimerService_t l_tService;
+    X_TEST_CHECK(xTimerServiceCreate(&l_tService, 0) == (int)XOS_TIMER_OK);
+
+    testTimer_t l_tTimer;
+    testTimerInit(&l_tTimer, &l_tService);
+    uint64_t l_ulStart = xTestNowMs();
+    X_TEST_CHECK(xTimerEntryStart(&l_tTimer.t_tEntry, 100000, 0) == (int)XOS_TIMER_OK);
+    usleep(50000);
+    X_TEST_CHECK(xTimerEntryRestart(&l_tTimer.t_tEntry) == (int)XOS_TIMER_OK);
+    uint64_t l_ulRestart = xTestNowMs();
+    testTimerWaitCount(&l_tTimer, 1, 2000);
+    X_TEST_CHECK(atomic_load(&l_tTimer.a_iCount) == 1);
+    X_TEST_CHECK(atomic_load(&l_tTimer.a_ulFiredMs) - l_ulRestart >= 100);
+    X_TEST_CHECK(atomic_load(&l_tTimer.a_ulFiredMs) - l_ulStart >= 150);
+
+    // The restart keeps the delay of the last start
+    X_TEST_CHECK(xTimerEntryRestart(&l_tTimer.t_tEntry) == (int)XOS_TIMER_OK);
+    X_TEST_CHECK(xTimerEntryIsArmed(&l_tTimer.t_tEntry));
+    testTimerWaitCount(&l_tTimer, 2, 2000);
+    X_TEST_CHECK(atomic_load(&l_tTimer.a_iCount) == 2);
+
+    testTimerInit(&l_tTimer, &l_tService);
+    l_tTimer.t_iRearms = 4;
+    X_TEST_CHECK(xTimerEntryStart(&l_tTimer.t_tEntry, 2000, 0) == (int)XOS_TIMER_OK);
+    testTimerWaitCount(&l_tTimer, 5, 2000);
+    usleep(20000);
+    X_TEST_CHECK(atomic_load(&l_tTimer.a_iCount) == 5);
+    X_TEST_CHECK(!xTimerEntryIsArmed(&l_tTimer.t_tEntry));
+
+    X_TEST_CHECK(xTimerServiceDestroy(&l_tService) == (int)XOS_TIMER_OK);
+}
+
+int main(void)
+{
+    X_TEST_RUN(testTimerLevelBoundary);
+    X_TEST_RUN(testTimerCancelWhileFiring);
+    X_TEST_RUN(testTimerRearm);
+    return X_TEST_RESULT();
+}
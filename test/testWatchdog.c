@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////
+//  testWatchdog.c
+//  Unit tests of the watchdog supervisor
+//
+// A client that keeps pinging never expires. A silent client expires
+// once per silence, recovers with its next ping and can expire again.
+// An expiry handler cannot stop the supervisor, the call is refused
+// instead of joining the supervisor thread from itself
+//
+// general discloser: copy or share the file is forbidden
+// Written : 15/10/2026
+////////////////////////////////////////////////////////////
+
+#include <unistd.h>
+#include "watchdog.h"
+#include "xTest.h"
+
+#define TEST_WATCHDOG_CHECK_MS   10
+#define TEST_WATCHDOG_TIMEOUT_MS 100
+
+static atomic_int s_iExpiries;
+static atomic_int s_iStopResult;
+
+static void testWatchdogHandler(watchdog_client_t* p_ptClient, void* p_pvArg)
+{
+    (void)p_ptClient;
+    (void)p_pvArg;
+    atomic_fetch_add(&s_iExpiries, 1);
+}
+
+static void testWatchdogStopHandler(watchdog_client_t* p_ptClient, void* p_pvArg)
+{
+    (void)p_pvArg;
+    atomic_store(&s_iStopResult, watchdog_supervisor_stop());
+    watchdog_unregister(p_ptClient);
+    atomic_fetch_add(&s_iExpiries, 1);
+}
+
+static void testWatchdogWaitExpiries(int p_iCount)
+{
+    uint64_t l_ulEnd = xTestNowMs() + 2000;
+    while (atomic_load(&s_iExpiries) < p_iCount && xTestNowMs() < l_ulEnd)
+    {
+        usleep(1000);
+    }
+}
+
+//
+// Expiry once per silence, recovery on the next ping, then a new expiry
+//
+static void testWatchdogExpiryAndRearm(void)
+{
+    X_TEST_CHECK(watchdog_supervisor_start(TEST_WATCHDOG_CHECK_MS, NULL, 0) == 0);
+    atomic_store(&s_iExpiries, 0);
+
+    watchdog_client_t* l_ptClient = watchdog_register("test", TEST_WATCHDOG_TIMEOUT_MS, testWatchdogHandler, NULL);
+    X_TEST_CHECK(l_ptClient != NULL);
+    if (l_ptClient == NULL)
+    {
+        watchdog_supervisor_stop();
+        return;
+    }
+
+    // Pinged well within the timeout
+    for (int i = 0; i < 20; i++)
+    {
+        watchdog_client_ping(l_ptClient);
+        usleep(10000);
+    }
+    X_TEST_CHECK(atomic_load(&s_iExpiries) == 0);
+    X_TEST_CHECK(!watchdog_client_has_expired(l_ptClient));
+
+    // Silent: one expiry, however long the silence
+    testWatchdogWaitExpiries(1);
+    usleep(4 * TEST_WATCHDOG_TIMEOUT_MS * 1000);
+    X_TEST_CHECK(atomic_load(&s_iExpiries) == 1);
+    X_TEST_CHECK(watchdog_client_has_expired(l_ptClient));
+    X_TEST_CHECK(atomic_load(&l_ptClient->expirations) == 1);
+
+    // The next ping re-arms the client
+    watchdog_client_ping(l_ptClient);
+    usleep(3 * TEST_WATCHDOG_CHECK_MS * 1000);
+    X_TEST_CHECK(!watchdog_client_has_expired(l_ptClient));
+    testWatchdogWaitExpiries(2);
+    X_TEST_CHECK(atomic_load(&s_iExpiries) == 2);
+    X_TEST_CHECK(watchdog_client_has_expired(l_ptClient));
+
+    watchdog_unregister(l_ptClient);
+    X_TEST_CHECK(watchdog_supervisor_stop() == 0);
+}
+
+//
+// A handler stopping the supervisor is refused, the supervisor keeps running
+//
+static void testWatchdogStopFromHandler(void)
+{
+    X_TEST_CHECK(watchdog_supervisor_start(TEST_WATCHDOG_CHECK_MS, NULL, 0) == 0);
+    atomic_store(&s_iExpiries, 0);
+    atomic_store(&s_iStopResult, 0);
+
+    watchdog_client_t* l_ptClient = watchdog_register("stopper", TEST_WATCHDOG_TIMEOUT_MS, testWatchdogStopHandler, NULL);
+    X_TEST_CHECK(l_ptClient != NULL);
+    testWatchdogWaitExpiries(1);
+    X_TEST_CHECK(atomic_load(&s_iExpiries) == 1);
+    X_TEST_CHECK(atomic_load(&s_iStopResult) == -1);
+
+    // Still supervising
+    watchdog_client_t* l_ptOther = watchdog_register("other", TEST_WATCHDOG_TIMEOUT_MS, testWatchdogHandler, NULL);
+    X_TEST_CHECK(l_ptOther != NULL);
+    testWatchdogWaitExpiries(2);
+    X_TEST_CHECK(atomic_load(&s_iExpiries) == 2);
+
+    X_TEST_CHECK(watchdog_supervisor_stop() == 0);
+    X_TEST_CHECK(watchdog_register("late", TEST_WATCHDOG_TIMEOUT_MS, NULL, NULL) == NULL);
+}
+
+int main(void)
+{
+    X_TEST_RUN(testWatchdogExpiryAndRearm);
+    X_TEST_RUN(testWatchdogStopFromHandler);
+    return X_TEST_RESULT();
+}
@@ -0,0 +1,55 @@
+////////////////////////////////////////////////////////////
+//  xTest.h
+//  Checks shared by the C unit tests
+//
+// A test program is a set of test functions run by X_TEST_RUN from
+// main. A failed X_TEST_CHECK prints its location and marks the run
+// failed, it may be used from any thread. main returns X_TEST_RESULT()
+// so that ctest reports the program as failed. xTestNowMs reads the
+// monotonic clock the library deadlines are taken on
+//
+// general discloser: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+#pragma once
+
+#ifndef XOS_TEST_H_
+#define XOS_TEST_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <time.h>
+
+// Failed checks of the program
+static atomic_int s_iTestFailures = 0;
+
+#define X_TEST_CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            atomic_fetch_add(&s_iTestFailures, 1); \
+        } \
+    } while (0)
+
+#define X_TEST_RUN(test) \
+    do { \
+        int l_iFailuresBefore = atomic_load(&s_iTestFailures); \
+        test(); \
+        printf("%s %s\n", (atomic_load(&s_iTestFailures) == l_iFailuresBefore) ? "[  OK  ]" : "[ FAIL ]", #test); \
+    } while (0)
+
+#define X_TEST_RESULT() ((atomic_load(&s_iTestFailures) == 0) ? 0 : 1)
+
+//////////////////////////////////
+/// @brief Get the monotonic time
+/// @return milliseconds
+//////////////////////////////////
+static inline uint64_t xTestNowMs(void)
+{
+    struct timespec l_tNow;
+    clock_gettime(CLOCK_MONOTONIC, &l_tNow);
+    return (uint64_t)l_tNow.tv_sec * 1000ULL + (uint64_t)l_tNow.tv_nsec / 1000000ULL;
+}
+
+#endif // XOS_TEST_H_
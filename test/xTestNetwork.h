@@ -0,0 +1,60 @@
+////////////////////////////////////////////////////////////
+//  xTestNetwork.h
+//  Network fixtures shared by the C unit tests
+//
+// xTestConnect opens a connected loopback TCP pair through the
+// library calls, on a port picked by the kernel so tests can run
+// side by side
+//
+// general discloser: copy or share the file is forbidden
+// Written : 15/10/2026
+////////////////////////////////////////////////////////////
+#pragma once
+
+#ifndef XOS_TEST_NETWORK_H_
+#define XOS_TEST_NETWORK_H_
+
+#include <stdbool.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include "xNetwork.h"
+
+//////////////////////////////////
+/// @brief Open a connected loopback TCP pair
+/// @param p_pptClient : filled with the connecting socket
+/// @param p_pptServer : filled with the accepted socket
+/// @return true when both sockets are connected
+//////////////////////////////////
+static inline bool xTestConnect(NetworkSocket** p_pptClient, NetworkSocket** p_pptServer)
+{
+    NetworkAddress l_tAddress = networkMakeAddress("127.0.0.1", 0);
+    NetworkSocket* l_ptListener = networkCreateSocket(NETWORK_SOCK_TCP);
+    if (!l_ptListener || networkBind(l_ptListener, &l_tAddress) != (int)NETWORK_OK ||
+        networkListen(l_ptListener, 1) != (int)NETWORK_OK)
+    {
+        if (l_ptListener)
+        {
+            networkCloseSocket(l_ptListener);
+        }
+        return false;
+    }
+
+    // Port picked by the kernel
+    struct sockaddr_in l_tBound;
+    socklen_t l_iLength = sizeof(l_tBound);
+    getsockname(l_ptListener->t_iSocketFd, (struct sockaddr*)&l_tBound, &l_iLength);
+    l_tAddress = networkMakeAddress("127.0.0.1", ntohs(l_tBound.sin_port));
+
+    *p_pptClient = networkCreateSocket(NETWORK_SOCK_TCP);
+    if (!*p_pptClient || networkConnect(*p_pptClient, &l_tAddress) != (int)NETWORK_OK)
+    {
+        networkCloseSocket(l_ptListener);
+        return false;
+    }
+
+    *p_pptServer = networkAccept(l_ptListener, NULL);
+    networkCloseSocket(l_ptListener);
+    return *p_pptServer != NULL;
+}
+
+#endif // XOS_TEST_NETWORK_H_
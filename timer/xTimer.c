@@ -19,8 +19,12 @@
 int xTimerCreate(xOsTimerCtx *p_ptTimer, uint32_t p_ulPeriod, uint8_t p_ucMode)
 {
     X_ASSERT(p_ptTimer != NULL);
-    X_ASSERT(p_ulPeriod > 0);
-    X_ASSERT(p_ucMode <= XOS_TIMER_MODE_PERIODIC);
+
+    // Period and mode come from the caller configuration, checked in every build
+    if (p_ulPeriod == 0 || p_ucMode > XOS_TIMER_MODE_PERIODIC)
+    {
+        return XOS_TIMER_INVALID;
+    }
 
     // Clear the structure
     memset(p_ptTimer, 0, sizeof(xOsTimerCtx));
@@ -31,8 +35,8 @@ int xTimerCreate(xOsTimerCtx *p_ptTimer, uint32_t p_ulPeriod, uint8_t p_ucMode)
     p_ptTimer->t_ucActive = 0;
 
     // Initialize mutex for thread safety
-    unsigned long l_ulResult = mutexCreate(&p_ptTimer->t_tMutex);
-    if (l_ulResult != MUTEX_OK)
+    int l_iResult = mutexCreate(&p_ptTimer->t_tMutex);
+    if (l_iResult != (int)MUTEX_OK)
     {
         return XOS_TIMER_MUTEX_ERROR;
     }
@@ -47,11 +51,11 @@ int xTimerStart(xOsTimerCtx *p_ptTimer)
 {
     X_ASSERT(p_ptTimer != NULL);
 
-    unsigned long l_ulResult;
+    int l_iResult;
 
     // Lock mutex for thread safety
-    l_ulResult = mutexLock(&p_ptTimer->t_tMutex);
-    if (l_ulResult != MUTEX_OK)
+    l_iResult = mutexLock(&p_ptTimer->t_tMutex);
+    if (l_iResult != (int)MUTEX_OK)
     {
         return XOS_TIMER_MUTEX_ERROR;
     }
@@ -72,8 +76,8 @@ int xTimerStart(xOsTimerCtx *p_ptTimer)
     p_ptTimer->t_ucActive = 1;
 
     // Unlock mutex
-    l_ulResult = mutexUnlock(&p_ptTimer->t_tMutex);
-    if (l_ulResult != MUTEX_OK)
+    l_iResult = mutexUnlock(&p_ptTimer->t_tMutex);
+    if (l_iResult != (int)MUTEX_OK)
     {
         return XOS_TIMER_MUTEX_ERROR;
     }
@@ -88,11 +92,11 @@ int xTimerStop(xOsTimerCtx *p_ptTimer)
 {
     X_ASSERT(p_ptTimer != NULL);
 
-    unsigned long l_ulResult;
+    int l_iResult;
 
     // Lock mutex for thread safety
-    l_ulResult = mutexLock(&p_ptTimer->t_tMutex);
-    if (l_ulResult != MUTEX_OK)
+    l_iResult = mutexLock(&p_ptTimer->t_tMutex);
+    if (l_iResult != (int)MUTEX_OK)
     {
         return XOS_TIMER_MUTEX_ERROR;
     }
@@ -100,8 +104,8 @@ int xTimerStop(xOsTimerCtx *p_ptTimer)
     p_ptTimer->t_ucActive = 0;
 
     // Unlock mutex
-    l_ulResult = mutexUnlock(&p_ptTimer->t_tMutex);
-    if (l_ulResult != MUTEX_OK)
+    l_iResult = mutexUnlock(&p_ptTimer->t_tMutex);
+    if (l_iResult != (int)MUTEX_OK)
     {
         return XOS_TIMER_MUTEX_ERROR;
     }
@@ -116,12 +120,12 @@ int xTimerExpired(xOsTimerCtx *p_ptTimer)
 {
     X_ASSERT(p_ptTimer != NULL);
 
-    unsigned long l_ulResult;
+    int l_iResult;
     unsigned long l_ulReturn;
 
     // Lock mutex for thread safety
-    l_ulResult = mutexLock(&p_ptTimer->t_tMutex);
-    if (l_ulResult != MUTEX_OK)
+    l_iResult = mutexLock(&p_ptTimer->t_tMutex);
+    if (l_iResult != (int)MUTEX_OK)
     {
         return XOS_TIMER_MUTEX_ERROR;
     }
@@ -167,8 +171,8 @@ int xTimerExpired(xOsTimerCtx *p_ptTimer)
     }
 
     // Unlock mutex
-    l_ulResult = mutexUnlock(&p_ptTimer->t_tMutex);
-    if (l_ulResult != MUTEX_OK)
+    l_iResult = mutexUnlock(&p_ptTimer->t_tMutex);
+    if (l_iResult != (int)MUTEX_OK)
     {
         return XOS_TIMER_MUTEX_ERROR;
     }
@@ -221,12 +225,12 @@ int xTimerProcessElapsedPeriods(xOsTimerCtx *p_ptTimer, void (*p_pfCallback)(voi
     X_ASSERT(p_ptTimer != NULL);
     X_ASSERT(p_pfCallback != NULL);
 
-    unsigned long l_ulResult;
+    int l_iResult;
     int l_iPeriodCount = 0;
 
     // Lock mutex for thread safety
-    l_ulResult = mutexLock(&p_ptTimer->t_tMutex);
-    if (l_ulResult != MUTEX_OK)
+    l_iResult = mutexLock(&p_ptTimer->t_tMutex);
+    if (l_iResult != (int)MUTEX_OK)
     {
         return XOS_TIMER_MUTEX_ERROR;
     }
@@ -262,8 +266,8 @@ int xTimerProcessElapsedPeriods(xOsTimerCtx *p_ptTimer, void (*p_pfCallback)(voi
         for (int i = 0; i < l_iPeriodCount; i++)
         {
             // Temporarily unlock mutex during callback to avoid deadlocks
-            l_ulResult = mutexUnlock(&p_ptTimer->t_tMutex);
-            if (l_ulResult != MUTEX_OK)
+            l_iResult = mutexUnlock(&p_ptTimer->t_tMutex);
+            if (l_iResult != (int)MUTEX_OK)
             {
                 return XOS_TIMER_MUTEX_ERROR;
             }
@@ -272,8 +276,8 @@ int xTimerProcessElapsedPeriods(xOsTimerCtx *p_ptTimer, void (*p_pfCallback)(voi
             p_pfCallback(p_pvData);
 
             // Re-lock mutex
-            l_ulResult = mutexLock(&p_ptTimer->t_tMutex);
-            if (l_ulResult != MUTEX_OK)
+            l_iResult = mutexLock(&p_ptTimer->t_tMutex);
+            if (l_iResult != (int)MUTEX_OK)
             {
                 return XOS_TIMER_MUTEX_ERROR;
             }
@@ -281,7 +285,7 @@ int xTimerProcessElapsedPeriods(xOsTimerCtx *p_ptTimer, void (*p_pfCallback)(voi
             // Check if timer was stopped during callback
             if (!p_ptTimer->t_ucActive)
             {
-                l_ulResult = mutexUnlock(&p_ptTimer->t_tMutex);
+                l_iResult = mutexUnlock(&p_ptTimer->t_tMutex);
                 return l_iPeriodCount;
             }
         }
@@ -300,8 +304,8 @@ int xTimerProcessElapsedPeriods(xOsTimerCtx *p_ptTimer, void (*p_pfCallback)(voi
     }
 
     // Unlock mutex
-    l_ulResult = mutexUnlock(&p_ptTimer->t_tMutex);
-    if (l_ulResult != MUTEX_OK)
+    l_iResult = mutexUnlock(&p_ptTimer->t_tMutex);
+    if (l_iResult != (int)MUTEX_OK)
     {
         return XOS_TIMER_MUTEX_ERROR;
     }
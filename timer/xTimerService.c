@@ -0,0 +1,395 @@
+////////////////////////////////////////////////////////////
+//  timer service source file
+//  implements the timing wheel of xTimerService.h
+//
+// An entry sits at the lowest level whose span covers its remaining
+// delay. When the low bits of the current tick wrap, the matching slot
+// of the level above is cascaded: its entries move down, until level 0
+// where a slot holds exactly the entries of one tick
+//
+// general discloser: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+
+#include "xTimerService.h"
+#include "xAssert.h"
+#include "xLog.h"
+#include <errno.h>
+#include <string.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+////////////////////////////////////////////////////////////
+/// timerServiceNowNs
+////////////////////////////////////////////////////////////
+static uint64_t timerServiceNowNs(const xOsTimerService_t* p_ptService)
+{
+    struct timespec l_tNow;
+    clock_gettime(CLOCK_MONOTONIC, &l_tNow);
+    return (uint64_t)l_tNow.tv_sec * 1000000000ULL + (uint64_t)l_tNow.tv_nsec - p_ptService->t_ulOriginNs;
+}
+
+////////////////////////////////////////////////////////////
+/// timerServiceNowTick
+////////////////////////////////////////////////////////////
+static uint64_t timerServiceNowTick(const xOsTimerService_t* p_ptService)
+{
+    return timerServiceNowNs(p_ptService) / p_ptService->t_ulTickNs;
+}
+
+////////////////////////////////////////////////////////////
+/// timerServiceArmFd
+////////////////////////////////////////////////////////////
+static void timerServiceArmFd(xOsTimerService_t* p_ptService, bool p_bTicking)
+{
+    // Ticking fires on every tick boundary after the current one, idle disarms
+    struct itimerspec l_tSpec;
+    memset(&l_tSpec, 0, sizeof(l_tSpec));
+    if (p_bTicking)
+    {
+        uint64_t l_ulFirstNs = p_ptService->t_ulOriginNs + (p_ptService->t_ulCurrentTick + 1) * p_ptService->t_ulTickNs;
+        l_tSpec.it_value.tv_sec = (time_t)(l_ulFirstNs / 1000000000ULL);
+        l_tSpec.it_value.tv_nsec = (long)(l_ulFirstNs % 1000000000ULL);
+        l_tSpec.it_interval.tv_sec = (time_t)(p_ptService->t_ulTickNs / 1000000000ULL);
+        l_tSpec.it_interval.tv_nsec = (long)(p_ptService->t_ulTickNs % 1000000000ULL);
+    }
+
+    if (timerfd_settime(p_ptService->t_iTimerFd, TFD_TIMER_ABSTIME, &l_tSpec, NULL) != 0)
+        X_LOG_TRACE("timerServiceArmFd: timerfd_settime failed, errno %d", errno);
+}
+
+////////////////////////////////////////////////////////////
+/// timerServiceLink
+////////////////////////////////////////////////////////////
+static void timerServiceLink(xOsTimerService_t* p_ptService, xOsTimerEntry_t* p_ptEntry)
+{
+    uint64_t l_ulCurrent = p_ptService->t_ulCurrentTick;
+    if (p_ptEntry->t_ulExpiry < l_ulCurrent)
+        p_ptEntry->t_ulExpiry = l_ulCurrent;
+
+    // Lowest level spanning the delay, beyond the top level the entry waits
+    // in the farthest top slot and is placed again when it cascades
+    uint64_t l_ulDelta = p_ptEntry->t_ulExpiry - l_ulCurrent;
+    uint64_t l_ulTarget = p_ptEntry->t_ulExpiry;
+    int l_iLevel = 0;
+    while (l_iLevel < XOS_TIMER_WHEEL_LEVELS - 1 && l_ulDelta >= (1ULL << (XOS_TIMER_WHEEL_BITS * (l_iLevel + 1))))
+    {
+        l_iLevel++;
+    }
+    uint64_t l_ulSpan = 1ULL << (XOS_TIMER_WHEEL_BITS * XOS_TIMER_WHEEL_LEVELS);
+    if (l_ulDelta >= l_ulSpan)
+        l_ulTarget = l_ulCurrent + l_ulSpan - 1;
+
+    size_t l_ulSlot = (size_t)((l_ulTarget >> (XOS_TIMER_WHEEL_BITS * l_iLevel)) & (XOS_TIMER_WHEEL_SLOTS - 1));
+    xOsTimerEntry_t** l_pptSlot = &p_ptService->t_ptWheel[l_iLevel][l_ulSlot];
+
+    p_ptEntry->t_ptPrev = NULL;
+    p_ptEntry->t_ptNext = *l_pptSlot;
+    if (*l_pptSlot != NULL)
+        (*l_pptSlot)->t_ptPrev = p_ptEntry;
+    *l_pptSlot = p_ptEntry;
+    p_ptEntry->t_pptSlot = l_pptSlot;
+}
+
+////////////////////////////////////////////////////////////
+/// timerServiceUnlink
+////////////////////////////////////////////////////////////
+static void timerServiceUnlink(xOsTimerEntry_t* p_ptEntry)
+{
+    if (p_ptEntry->t_ptPrev != NULL)
+        p_ptEntry->t_ptPrev->t_ptNext = p_ptEntry->t_ptNext;
+    else
+        *p_ptEntry->t_pptSlot = p_ptEntry->t_ptNext;
+    if (p_ptEntry->t_ptNext != NULL)
+        p_ptEntry->t_ptNext->t_ptPrev = p_ptEntry->t_ptPrev;
+
+    p_ptEntry->t_ptNext = NULL;
+    p_ptEntry->t_ptPrev = NULL;
+    p_ptEntry->t_pptSlot = NULL;
+}
+
+////////////////////////////////////////////////////////////
+/// timerServiceTick
+////////////////////////////////////////////////////////////
+static void timerServiceTick(xOsTimerService_t* p_ptService, uint64_t p_ulTick)
+{
+    p_ptService->t_ulCurrentTick = p_ulTick;
+
+    // Highest level first, so entries it moves into a lower slot due now cascade again
+    for (int l_iLevel = XOS_TIMER_WHEEL_LEVELS - 1; l_iLevel > 0; l_iLevel--)
+    {
+        uint64_t l_ulMask = (1ULL << (XOS_TIMER_WHEEL_BITS * l_iLevel)) - 1;
+        if ((p_ulTick & l_ulMask) != 0)
+            continue;
+
+        size_t l_ulSlot = (size_t)((p_ulTick >> (XOS_TIMER_WHEEL_BITS * l_iLevel)) & (XOS_TIMER_WHEEL_SLOTS - 1));
+        xOsTimerEntry_t* l_ptEntry = p_ptService->t_ptWheel[l_iLevel][l_ulSlot];
+        p_ptService->t_ptWheel[l_iLevel][l_ulSlot] = NULL;
+        while (l_ptEntry != NULL)
+        {
+            xOsTimerEntry_t* l_ptNext = l_ptEntry->t_ptNext;
+            timerServiceLink(p_ptService, l_ptEntry);
+            l_ptEntry = l_ptNext;
+        }
+    }
+
+    // Entries of this tick, callbacks run unlocked and may start or stop any timer
+    xOsTimerEntry_t** l_pptDue = &p_ptService->t_ptWheel[0][p_ulTick & (XOS_TIMER_WHEEL_SLOTS - 1)];
+    while (*l_pptDue != NULL)
+    {
+        xOsTimerEntry_t* l_ptEntry = *l_pptDue;
+        timerServiceUnlink(l_ptEntry);
+        if (l_ptEntry->t_ulPeriodTicks > 0)
+        {
+            l_ptEntry->t_ulExpiry += l_ptEntry->t_ulPeriodTicks;
+            timerServiceLink(p_ptService, l_ptEntry);
+        }
+        else
+            p_ptService->t_ulArmed--;
+
+        xTimerCallback l_pfCallback = l_ptEntry->t_pfCallback;
+        void* l_pvArg = l_ptEntry->t_pvArg;
+        mutexUnlock(&p_ptService->t_tMutex);
+        l_pfCallback(l_pvArg);
+        atomic_fetch_add_explicit(&p_ptService->a_ulFired, 1, memory_order_relaxed);
+        mutexLock(&p_ptService->t_tMutex);
+
+        // A start on an idle wheel moved the current tick, this slot is no longer due
+        if (p_ptService->t_ulCurrentTick != p_ulTick)
+            break;
+    }
+}
+
+////////////////////////////////////////////////////////////
+/// timerServiceTask
+////////////////////////////////////////////////////////////
+static void* timerServiceTask(void* p_pvArg)
+{
+    xOsTimerService_t* l_ptService = (xOsTimerService_t*)p_pvArg;
+
+    while (!atomic_load(&l_ptService->a_bStop))
+    {
+        // Blocks while disarmed, the expiration count is recomputed from the clock
+        uint64_t l_ulExpirations;
+        if (read(l_ptService->t_iTimerFd, &l_ulExpirations, sizeof(l_ulExpirations)) < 0 && errno != EINTR)
+        {
+            X_LOG_TRACE("timerServiceTask: timerfd read failed, errno %d", errno);
+            break;
+        }
+
+        mutexLock(&l_ptService->t_tMutex);
+        uint64_t l_ulNow = timerServiceNowTick(l_ptService);
+        while (l_ptService->t_ulCurrentTick < l_ulNow && l_ptService->t_ulArmed > 0 && !atomic_load(&l_ptService->a_bStop))
+        {
+            timerServiceTick(l_ptService, l_ptService->t_ulCurrentTick + 1);
+        }
+        if (l_ptService->t_ulArmed == 0)
+        {
+            l_ptService->t_ulCurrentTick = l_ulNow;
+            timerServiceArmFd(l_ptService, false);
+        }
+        mutexUnlock(&l_ptService->t_tMutex);
+    }
+
+    return NULL;
+}
+
+////////////////////////////////////////////////////////////
+/// xTimerServiceCreate
+////////////////////////////////////////////////////////////
+int xTimerServiceCreate(xOsTimerService_t* p_ptService, uint32_t p_ulTickUs)
+{
+    X_ASSERT(p_ptService != NULL);
+
+    memset(p_ptService, 0, sizeof(*p_ptService));
+    p_ptService->t_ulTickNs = (uint64_t)(p_ulTickUs ? p_ulTickUs : XOS_TIMER_SERVICE_DEFAULT_TICK_US) * 1000ULL;
+    atomic_init(&p_ptService->a_bStop, false);
+    atomic_init(&p_ptService->a_ulFired, 0);
+
+    struct timespec l_tNow;
+    clock_gettime(CLOCK_MONOTONIC, &l_tNow);
+    p_ptService->t_ulOriginNs = (uint64_t)l_tNow.tv_sec * 1000000000ULL + (uint64_t)l_tNow.tv_nsec;
+
+    if (mutexCreate(&p_ptService->t_tMutex) != (int)MUTEX_OK)
+        return XOS_TIMER_MUTEX_ERROR;
+
+    p_ptService->t_iTimerFd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    if (p_ptService->t_iTimerFd < 0)
+    {
+        X_LOG_TRACE("xTimerServiceCreate: timerfd_create failed, errno %d", errno);
+        mutexDestroy(&p_ptService->t_tMutex);
+        return XOS_TIMER_ERROR;
+    }
+
+    osTaskInit(&p_ptService->t_tTask);
+    p_ptService->t_tTask.t_ptTask = timerServiceTask;
+    p_ptService->t_tTask.t_ptTaskArg = p_ptService;
+    p_ptService->t_tTask.t_ulStackSize = XOS_TIMER_SERVICE_STACK_SIZE;
+    p_ptService->t_tTask.t_iPriority = OS_TASK_DEFAULT_PRIORITY;
+    p_ptService->t_tTask.t_pcName = "timer";
+    if (osTaskCreate(&p_ptService->t_tTask) != OS_TASK_SUCCESS)
+    {
+        close(p_ptService->t_iTimerFd);
+        mutexDestroy(&p_ptService->t_tMutex);
+        return XOS_TIMER_ERROR;
+    }
+
+    return XOS_TIMER_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xTimerServiceDestroy
+////////////////////////////////////////////////////////////
+int xTimerServiceDestroy(xOsTimerService_t* p_ptService)
+{
+    X_ASSERT(p_ptService != NULL);
+
+    // An expiry already due wakes the thread so it sees the stop flag
+    mutexLock(&p_ptService->t_tMutex);
+    atomic_store(&p_ptService->a_bStop, true);
+    struct itimerspec l_tSpec;
+    memset(&l_tSpec, 0, sizeof(l_tSpec));
+    l_tSpec.it_value.tv_nsec = 1;
+    timerfd_settime(p_ptService->t_iTimerFd, 0, &l_tSpec, NULL);
+    mutexUnlock(&p_ptService->t_tMutex);
+
+    osTaskWait(&p_ptService->t_tTask, NULL);
+    close(p_ptService->t_iTimerFd);
+    p_ptService->t_iTimerFd = -1;
+
+    // Left armed entries are detached so their handles read as stopped
+    for (int l_iLevel = 0; l_iLevel < XOS_TIMER_WHEEL_LEVELS; l_iLevel++)
+    {
+        for (int i = 0; i < XOS_TIMER_WHEEL_SLOTS; i++)
+        {
+            while (p_ptService->t_ptWheel[l_iLevel][i] != NULL)
+            {
+                timerServiceUnlink(p_ptService->t_ptWheel[l_iLevel][i]);
+            }
+        }
+    }
+    p_ptService->t_ulArmed = 0;
+
+    if (mutexDestroy(&p_ptService->t_tMutex) != (int)MUTEX_OK)
+        return XOS_TIMER_MUTEX_ERROR;
+    return XOS_TIMER_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xTimerEntryInit
+////////////////////////////////////////////////////////////
+int xTimerEntryInit(xOsTimerEntry_t* p_ptEntry, xOsTimerService_t* p_ptService, xTimerCallback p_pfCallback, void* p_pvArg)
+{
+    X_ASSERT(p_ptEntry != NULL);
+    X_ASSERT(p_ptService != NULL);
+    X_ASSERT(p_pfCallback != NULL);
+
+    memset(p_ptEntry, 0, sizeof(*p_ptEntry));
+    p_ptEntry->t_pfCallback = p_pfCallback;
+    p_ptEntry->t_pvArg = p_pvArg;
+    p_ptEntry->t_ptService = p_ptService;
+    return XOS_TIMER_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// timerEntryArm
+////////////////////////////////////////////////////////////
+static void timerEntryArm(xOsTimerService_t* p_ptService, xOsTimerEntry_t* p_ptEntry)
+{
+    if (p_ptEntry->t_pptSlot != NULL)
+        timerServiceUnlink(p_ptEntry);
+    else if (p_ptService->t_ulArmed++ == 0)
+    {
+        // The wheel sat idle, nothing is due between its last tick and now
+        p_ptService->t_ulCurrentTick = timerServiceNowTick(p_ptService);
+        timerServiceArmFd(p_ptService, true);
+    }
+
+    // First tick boundary at or after now + delay, a timer never fires early
+    uint64_t l_ulDueNs = timerServiceNowNs(p_ptService) + p_ptEntry->t_ulDelayNs;
+    p_ptEntry->t_ulExpiry = (l_ulDueNs + p_ptService->t_ulTickNs - 1) / p_ptService->t_ulTickNs;
+    timerServiceLink(p_ptService, p_ptEntry);
+}
+
+////////////////////////////////////////////////////////////
+/// xTimerEntryStart
+////////////////////////////////////////////////////////////
+int xTimerEntryStart(xOsTimerEntry_t* p_ptEntry, uint64_t p_ulDelayUs, uint64_t p_ulPeriodUs)
+{
+    X_ASSERT(p_ptEntry != NULL);
+    X_ASSERT(p_ptEntry->t_ptService != NULL);
+
+    xOsTimerService_t* l_ptService = p_ptEntry->t_ptService;
+    if (atomic_load(&l_ptService->a_bStop))
+        return XOS_TIMER_NOT_INIT;
+
+    // The period is rounded up to whole ticks
+    uint64_t l_ulPeriodNs = p_ulPeriodUs * 1000ULL;
+    uint64_t l_ulPeriodTicks = (l_ulPeriodNs + l_ptService->t_ulTickNs - 1) / l_ptService->t_ulTickNs;
+
+    if (mutexLock(&l_ptService->t_tMutex) != (int)MUTEX_OK)
+        return XOS_TIMER_MUTEX_ERROR;
+    p_ptEntry->t_ulDelayNs = (p_ulDelayUs > 0) ? p_ulDelayUs * 1000ULL : 1;
+    p_ptEntry->t_ulPeriodTicks = l_ulPeriodTicks;
+    timerEntryArm(l_ptService, p_ptEntry);
+    mutexUnlock(&l_ptService->t_tMutex);
+
+    return XOS_TIMER_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xTimerEntryStop
+////////////////////////////////////////////////////////////
+int xTimerEntryStop(xOsTimerEntry_t* p_ptEntry)
+{
+    X_ASSERT(p_ptEntry != NULL);
+    X_ASSERT(p_ptEntry->t_ptService != NULL);
+
+    xOsTimerService_t* l_ptService = p_ptEntry->t_ptService;
+    if (mutexLock(&l_ptService->t_tMutex) != (int)MUTEX_OK)
+        return XOS_TIMER_MUTEX_ERROR;
+    if (p_ptEntry->t_pptSlot != NULL)
+    {
+        timerServiceUnlink(p_ptEntry);
+        l_ptService->t_ulArmed--;
+    }
+    mutexUnlock(&l_ptService->t_tMutex);
+
+    return XOS_TIMER_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xTimerEntryRestart
+////////////////////////////////////////////////////////////
+int xTimerEntryRestart(xOsTimerEntry_t* p_ptEntry)
+{
+    X_ASSERT(p_ptEntry != NULL);
+    X_ASSERT(p_ptEntry->t_ptService != NULL);
+
+    xOsTimerService_t* l_ptService = p_ptEntry->t_ptService;
+    if (p_ptEntry->t_ulDelayNs == 0)
+        return XOS_TIMER_NOT_INIT;
+    if (atomic_load(&l_ptService->a_bStop))
+        return XOS_TIMER_NOT_INIT;
+
+    if (mutexLock(&l_ptService->t_tMutex) != (int)MUTEX_OK)
+        return XOS_TIMER_MUTEX_ERROR;
+    timerEntryArm(l_ptService, p_ptEntry);
+    mutexUnlock(&l_ptService->t_tMutex);
+
+    return XOS_TIMER_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xTimerEntryIsArmed
+////////////////////////////////////////////////////////////
+bool xTimerEntryIsArmed(xOsTimerEntry_t* p_ptEntry)
+{
+    X_ASSERT(p_ptEntry != NULL);
+    X_ASSERT(p_ptEntry->t_ptService != NULL);
+
+    mutexLock(&p_ptEntry->t_ptService->t_tMutex);
+    bool l_bArmed = (p_ptEntry->t_pptSlot != NULL);
+    mutexUnlock(&p_ptEntry->t_ptService->t_tMutex);
+    return l_bArmed;
+}
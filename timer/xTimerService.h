@@ -0,0 +1,129 @@
+////////////////////////////////////////////////////////////
+//  timer service header file
+//  defines a shared timer service dispatching expiry callbacks
+//
+// All the timers of a service live in one hierarchical timing wheel
+// (4 levels of 256 slots) driven by a single timerfd and thread, so a
+// start, stop or restart is a list insertion under one lock and nobody
+// polls. An xOsTimerEntry_t is the handle of one timer
+//
+// general discloser: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+#pragma once
+
+#ifndef XOS_TIMER_SERVICE_H_
+#define XOS_TIMER_SERVICE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include "xOsMutex.h"
+#include "xTask.h"
+#include "xTimer.h"
+
+// Wheel geometry, a level covers 256 times the span of the level below
+#define XOS_TIMER_WHEEL_LEVELS      4
+#define XOS_TIMER_WHEEL_BITS        8
+#define XOS_TIMER_WHEEL_SLOTS       (1 << XOS_TIMER_WHEEL_BITS)
+
+#define XOS_TIMER_SERVICE_DEFAULT_TICK_US   1000            // Resolution when 0 is configured
+#define XOS_TIMER_SERVICE_STACK_SIZE        (64 * 1024)
+
+// Expiry callback, runs on the service thread
+typedef void (*xTimerCallback)(void* p_pvArg);
+
+struct xos_timer_service_t;
+
+//////////////////////////////////
+/// @brief timer handle
+//////////////////////////////////
+typedef struct xos_timer_entry_t
+{
+    struct xos_timer_entry_t* t_ptNext;     // Slot list links
+    struct xos_timer_entry_t* t_ptPrev;
+    struct xos_timer_entry_t** t_pptSlot;   // Slot holding the entry, NULL when not armed
+    uint64_t t_ulExpiry;                    // Expiry tick
+    uint64_t t_ulDelayNs;                   // First delay, reused by xTimerEntryRestart
+    uint64_t t_ulPeriodTicks;               // Reload after expiry (0 for one-shot)
+    xTimerCallback t_pfCallback;
+    void* t_pvArg;
+    struct xos_timer_service_t* t_ptService;
+} xOsTimerEntry_t;
+
+//////////////////////////////////
+/// @brief timer service
+//////////////////////////////////
+typedef struct xos_timer_service_t
+{
+    xOsTimerEntry_t* t_ptWheel[XOS_TIMER_WHEEL_LEVELS][XOS_TIMER_WHEEL_SLOTS];
+    xOsMutexCtx t_tMutex;                   // Protects the wheel and the entries
+    uint64_t t_ulTickNs;                    // Resolution
+    uint64_t t_ulOriginNs;                  // CLOCK_MONOTONIC time of tick 0
+    uint64_t t_ulCurrentTick;               // Last tick processed
+    uint32_t t_ulArmed;                     // Armed entries, the timerfd is idle at 0
+    int t_iTimerFd;
+    atomic_bool a_bStop;
+    atomic_ulong a_ulFired;                 // Callbacks run
+    xOsTaskCtx t_tTask;                     // Dispatch thread
+} xOsTimerService_t;
+
+//////////////////////////////////
+/// @brief Create a timer service and start its thread
+/// @param p_ptService : service structure pointer
+/// @param p_ulTickUs : resolution in microseconds (0 for XOS_TIMER_SERVICE_DEFAULT_TICK_US)
+/// @return success or error code
+//////////////////////////////////
+int xTimerServiceCreate(xOsTimerService_t* p_ptService, uint32_t p_ulTickUs);
+
+//////////////////////////////////
+/// @brief Stop the service thread and release the service
+/// @param p_ptService : service structure pointer
+/// @return success or error code
+/// @note armed entries are dropped without running their callback
+//////////////////////////////////
+int xTimerServiceDestroy(xOsTimerService_t* p_ptService);
+
+//////////////////////////////////
+/// @brief Bind a timer handle to a service
+/// @param p_ptEntry : timer handle
+/// @param p_ptService : service running the timer
+/// @param p_pfCallback : expiry callback
+/// @param p_pvArg : callback argument
+/// @return success or error code
+//////////////////////////////////
+int xTimerEntryInit(xOsTimerEntry_t* p_ptEntry, xOsTimerService_t* p_ptService, xTimerCallback p_pfCallback, void* p_pvArg);
+
+//////////////////////////////////
+/// @brief Arm a timer, re-arming it if already armed
+/// @param p_ptEntry : timer handle
+/// @param p_ulDelayUs : delay before the first expiry in microseconds
+/// @param p_ulPeriodUs : period of the next expiries in microseconds (0 for one-shot)
+/// @return success or error code
+/// @note expiries fall on the next tick boundary, at most one resolution after the delay
+//////////////////////////////////
+int xTimerEntryStart(xOsTimerEntry_t* p_ptEntry, uint64_t p_ulDelayUs, uint64_t p_ulPeriodUs);
+
+//////////////////////////////////
+/// @brief Disarm a timer
+/// @param p_ptEntry : timer handle
+/// @return success or error code
+/// @note a callback already running on the service thread is not waited for
+//////////////////////////////////
+int xTimerEntryStop(xOsTimerEntry_t* p_ptEntry);
+
+//////////////////////////////////
+/// @brief Re-arm a timer with the delay of its last start, e.g. to push back a timeout
+/// @param p_ptEntry : timer handle
+/// @return success or error code
+//////////////////////////////////
+int xTimerEntryRestart(xOsTimerEntry_t* p_ptEntry);
+
+//////////////////////////////////
+/// @brief Check whether a timer is armed
+/// @param p_ptEntry : timer handle
+/// @return true when armed
+//////////////////////////////////
+bool xTimerEntryIsArmed(xOsTimerEntry_t* p_ptEntry);
+
+#endif // XOS_TIMER_SERVICE_H_
@@ -9,17 +9,125 @@
 #include "tlsEngine.h"
 #include "xLog.h"
 #include "xAssert.h"
+#include "xMemory.h"
+#include "xTrace.h"
+#include "xMetrics.h"
 #include <stdio.h>
 #include <string.h>
 #include <errno.h>
 #include <unistd.h>
 #include <sys/socket.h>
+#include <pthread.h>
 
+static pthread_once_t s_tLibTlsOnce = PTHREAD_ONCE_INIT;
 static bool s_bLibTlsInitialised = false;
 
+// Registry handles, the net_* ones count the ciphertext the socket carries
+static xMetric_t* s_ptMetricTxBytes = NULL;
+static xMetric_t* s_ptMetricRxBytes = NULL;
+static xMetric_t* s_ptMetricTxCalls = NULL;
+static xMetric_t* s_ptMetricRxCalls = NULL;
+static xMetric_t* s_ptMetricHandshakes = NULL;
+static xMetric_t* s_ptMetricResumed = NULL;
+static xMetric_t* s_ptMetricFailures = NULL;
+
+// Client session kept for the next connection to a server
+typedef struct
+{
+    struct sockaddr_in t_tPeer;     // Server address
+    WOLFSSL_SESSION* t_ptSession;   // Session and ticket, owned by the cache
+} TLS_SessionEntry;
+
+static TLS_SessionEntry s_tSessionCache[TLS_SESSION_CACHE_SIZE];
+static unsigned int s_uiSessionNext = 0; // Next slot replaced when the cache is full
+static pthread_mutex_t s_tSessionMutex = PTHREAD_MUTEX_INITIALIZER;
+
+////////////////////////////////////////////////////////////
+/// tlsEngineSessionFind
+////////////////////////////////////////////////////////////
+static TLS_SessionEntry* tlsEngineSessionFind(const struct sockaddr_in* p_ptPeer)
+{
+    for (int i = 0; i < TLS_SESSION_CACHE_SIZE; i++)
+    {
+        TLS_SessionEntry* l_ptEntry = &s_tSessionCache[i];
+        if (l_ptEntry->t_ptSession &&
+            l_ptEntry->t_tPeer.sin_addr.s_addr == p_ptPeer->sin_addr.s_addr &&
+            l_ptEntry->t_tPeer.sin_port == p_ptPeer->sin_port)
+        {
+            return l_ptEntry;
+        }
+    }
+
+    return NULL;
+}
+
+////////////////////////////////////////////////////////////
+/// tlsEngineSessionOffer
+////////////////////////////////////////////////////////////
+static void tlsEngineSessionOffer(TLS_Engine* p_pttEngine)
+{
+    pthread_mutex_lock(&s_tSessionMutex);
+    TLS_SessionEntry* l_ptEntry = tlsEngineSessionFind(&p_pttEngine->t_tPeer);
+    if (l_ptEntry)
+    {
+        // The session is copied, an expired one falls back to a full handshake
+        if (wolfSSL_set_session(p_pttEngine->t_SslSession, l_ptEntry->t_ptSession) != WOLFSSL_SUCCESS)
+        {
+            X_LOG_TRACE("Cached TLS session rejected, full handshake");
+        }
+    }
+    pthread_mutex_unlock(&s_tSessionMutex);
+}
+
+////////////////////////////////////////////////////////////
+/// tlsEngineSessionKeep
+////////////////////////////////////////////////////////////
+static void tlsEngineSessionKeep(TLS_Engine* p_pttEngine)
+{
+    WOLFSSL_SESSION* l_ptSession = wolfSSL_get1_session(p_pttEngine->t_SslSession);
+    if (!l_ptSession)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&s_tSessionMutex);
+    TLS_SessionEntry* l_ptEntry = tlsEngineSessionFind(&p_pttEngine->t_tPeer);
+    if (!l_ptEntry)
+    {
+        l_ptEntry = &s_tSessionCache[s_uiSessionNext];
+        s_uiSessionNext = (s_uiSessionNext + 1) % TLS_SESSION_CACHE_SIZE;
+    }
+
+    if (l_ptEntry->t_ptSession)
+    {
+        wolfSSL_SESSION_free(l_ptEntry->t_ptSession);
+    }
+    l_ptEntry->t_tPeer = p_pttEngine->t_tPeer;
+    l_ptEntry->t_ptSession = l_ptSession;
+    pthread_mutex_unlock(&s_tSessionMutex);
+}
+
+
+////////////////////////////////////////////////////////////
+/// tlsEngineIOError
+////////////////////////////////////////////////////////////
+static int tlsEngineIOError(int p_iResult, bool p_bRead)
+{
+    if (p_iResult == 0)
+    {
+        return WOLFSSL_CBIO_ERR_CONN_CLOSE;
+    }
+    if (errno == EAGAIN || errno == EWOULDBLOCK)
+    {
+        return p_bRead ? WOLFSSL_CBIO_ERR_WANT_READ : WOLFSSL_CBIO_ERR_WANT_WRITE;
+    }
+    return WOLFSSL_CBIO_ERR_GENERAL;
+}
 
 ////////////////////////////////////////////////////////////
 /// tlsEngineIORecv
+/// @note wolfSSL asks for a record header then its body, one recv
+///       into the read-ahead buffer serves both and the following records
 ////////////////////////////////////////////////////////////
 static int tlsEngineIORecv(WOLFSSL* t_SslSession, char* buf, int sz, void* t_CipherCtx) 
 {
@@ -27,17 +135,46 @@ static int tlsEngineIORecv(WOLFSSL* t_SslSession, char* buf, int sz, void* t_Cip
     X_ASSERT(buf != NULL);
     X_ASSERT(sz > 0);
     X_ASSERT(t_SslSession != NULL);
-    int t_iSocketFd = *(int*)t_CipherCtx;
-    if (t_iSocketFd < 0) {
+    TLS_Engine* l_pttEngine = (TLS_Engine*)t_CipherCtx;
+    if (l_pttEngine->t_iSocketFd < 0) {
         return WOLFSSL_CBIO_ERR_GENERAL;
     }
-    
-    int recvd = recv(t_iSocketFd, buf, sz, 0);
-    if (recvd < 0) 
+
+    if (l_pttEngine->t_uiReadStart == l_pttEngine->t_uiReadEnd)
     {
-        return WOLFSSL_CBIO_ERR_GENERAL;
+        // Large reads go straight to the caller buffer
+        if ((unsigned int)sz >= sizeof(l_pttEngine->t_ucReadAhead))
+        {
+            int recvd = recv(l_pttEngine->t_iSocketFd, buf, sz, 0);
+            xMetricsInc(s_ptMetricRxCalls);
+            if (recvd > 0)
+            {
+                xMetricsAdd(s_ptMetricRxBytes, (uint64_t)recvd);
+            }
+            return (recvd > 0) ? recvd : tlsEngineIOError(recvd, true);
+        }
+
+        X_TRACE_BEGIN("tls.recv");
+        int recvd = recv(l_pttEngine->t_iSocketFd, l_pttEngine->t_ucReadAhead, sizeof(l_pttEngine->t_ucReadAhead), 0);
+        X_TRACE_END("tls.recv");
+        xMetricsInc(s_ptMetricRxCalls);
+        if (recvd <= 0) 
+        {
+            return tlsEngineIOError(recvd, true);
+        }
+        xMetricsAdd(s_ptMetricRxBytes, (uint64_t)recvd);
+        l_pttEngine->t_uiReadStart = 0;
+        l_pttEngine->t_uiReadEnd = (unsigned int)recvd;
+    }
+
+    unsigned int l_uiCopy = l_pttEngine->t_uiReadEnd - l_pttEngine->t_uiReadStart;
+    if (l_uiCopy > (unsigned int)sz)
+    {
+        l_uiCopy = (unsigned int)sz;
     }
-    return recvd;
+    memcpy(buf, l_pttEngine->t_ucReadAhead + l_pttEngine->t_uiReadStart, l_uiCopy);
+    l_pttEngine->t_uiReadStart += l_uiCopy;
+    return (int)l_uiCopy;
 }
 
 ////////////////////////////////////////////////////////////
@@ -50,52 +187,58 @@ static int tlsEngineIOSend(WOLFSSL* t_SslSession, char* buf, int sz, void* t_Cip
     X_ASSERT(sz > 0);
     X_ASSERT(t_SslSession != NULL);
 
-    int t_iSocketFd = *(int*)t_CipherCtx;
+    int t_iSocketFd = ((TLS_Engine*)t_CipherCtx)->t_iSocketFd;
     if (t_iSocketFd < 0) {
         return WOLFSSL_CBIO_ERR_GENERAL;
     }
     
+    X_TRACE_BEGIN("tls.send");
     int sent = send(t_iSocketFd, buf, sz, 0);
+    X_TRACE_END("tls.send");
+    xMetricsInc(s_ptMetricTxCalls);
     if (sent < 0) 
     {
-        return WOLFSSL_CBIO_ERR_GENERAL;
+        return tlsEngineIOError(sent, false);
     }
+    xMetricsAdd(s_ptMetricTxBytes, (uint64_t)sent);
     return sent;
 }
 
 ////////////////////////////////////////////////////////////
-/// tlsEngineInit
+/// tlsEngineLibInit
 ////////////////////////////////////////////////////////////
-unsigned long tlsEngineInit(TLS_Engine* p_pttEngine, int p_iSocketFd, const TLS_Config* p_kpttConfig) 
+static void tlsEngineLibInit(void)
 {
-    X_ASSERT(p_pttEngine != NULL);
-    X_ASSERT(p_kpttConfig != NULL);
-    X_ASSERT(p_iSocketFd >= 0);
-
-    X_LOG_TRACE("Initializing TLS engine for socket %d", p_iSocketFd);
-
-    if (!p_pttEngine || !p_kpttConfig || p_iSocketFd < 0) 
+    if (wolfSSL_Init() != WOLFSSL_SUCCESS) 
     {
-        X_LOG_TRACE("Invalid parameters for TLS engine initialization");
-        return TLS_INVALID_PARAM;
+        X_LOG_TRACE("Failed to initialize wolfSSL library");
+        return;
     }
+    s_bLibTlsInitialised = true;
+    X_LOG_TRACE("wolfSSL library initialized successfully");
 
-    // Initialize engine structure
-    memset(p_pttEngine, 0, sizeof(TLS_Engine));
-    p_pttEngine->t_iSocketFd = p_iSocketFd;
-    p_pttEngine->t_eTlsVersion = p_kpttConfig->t_eTlsVersion;
-    p_pttEngine->t_eEccCurve = p_kpttConfig->t_eEccCurve;
-    
-    // Initialize wolfSSL library if not already done
+    // Same names as the plain build, the registry hands back the same counters
+    xMetricsRegisterCounter("net_tx_bytes_total", "Bytes sent", &s_ptMetricTxBytes);
+    xMetricsRegisterCounter("net_rx_bytes_total", "Bytes received", &s_ptMetricRxBytes);
+    xMetricsRegisterCounter("net_tx_syscalls_total", "Send system calls", &s_ptMetricTxCalls);
+    xMetricsRegisterCounter("net_rx_syscalls_total", "Receive system calls", &s_ptMetricRxCalls);
+    xMetricsRegisterCounter("tls_handshakes_total", "TLS handshakes completed", &s_ptMetricHandshakes);
+    xMetricsRegisterCounter("tls_handshake_resumed_total", "TLS handshakes completed with a resumed session",
+                            &s_ptMetricResumed);
+    xMetricsRegisterCounter("tls_handshake_failures_total", "TLS handshakes failed", &s_ptMetricFailures);
+}
+
+////////////////////////////////////////////////////////////
+/// tlsEngineCreateCtx
+/// @note loads the certificate files, parsed once per context
+////////////////////////////////////////////////////////////
+static unsigned long tlsEngineCreateCtx(const TLS_Config* p_kpttConfig, WOLFSSL_CTX** p_pptCtx)
+{
+    // Initialize wolfSSL library once, whichever thread comes first
+    pthread_once(&s_tLibTlsOnce, tlsEngineLibInit);
     if (!s_bLibTlsInitialised) 
     {
-        if (wolfSSL_Init() != WOLFSSL_SUCCESS) 
-        {
-            X_LOG_TRACE("Failed to initialize wolfSSL library");
-            return TLS_ERROR;
-        }
-        s_bLibTlsInitialised = true;
-        X_LOG_TRACE("wolfSSL library initialized successfully");
+        return TLS_ERROR;
     }
     
     // Create wolfSSL context based on TLS t_eTlsVersion
@@ -130,7 +273,7 @@ unsigned long tlsEngineInit(TLS_Engine* p_pttEngine, int p_iSocketFd, const TLS_
     else 
     {
         X_LOG_TRACE("Invalid TLS t_eTlsVersion specified");
-        X_ASSERT(false);
+        return TLS_INVALID_PARAM;
     }
     
     if (!l_pttMethod) 
@@ -140,8 +283,8 @@ unsigned long tlsEngineInit(TLS_Engine* p_pttEngine, int p_iSocketFd, const TLS_
     }
     
     // Create the context
-    p_pttEngine->t_CipherCtx = wolfSSL_CTX_new(l_pttMethod);
-    if (!p_pttEngine->t_CipherCtx) 
+    WOLFSSL_CTX* l_ptCtx = wolfSSL_CTX_new(l_pttMethod);
+    if (!l_ptCtx) 
     {
         X_LOG_TRACE("Failed to create SSL context");
         return TLS_ERROR;
@@ -152,11 +295,10 @@ unsigned long tlsEngineInit(TLS_Engine* p_pttEngine, int p_iSocketFd, const TLS_
     if (p_kpttConfig->t_cCaPath) 
     {
         X_LOG_TRACE("Loading CA certificate from %s", p_kpttConfig->t_cCaPath);
-        if (wolfSSL_CTX_load_verify_locations(p_pttEngine->t_CipherCtx, p_kpttConfig->t_cCaPath, NULL) != WOLFSSL_SUCCESS)
+        if (wolfSSL_CTX_load_verify_locations(l_ptCtx, p_kpttConfig->t_cCaPath, NULL) != WOLFSSL_SUCCESS)
         {
             X_LOG_TRACE("Failed to load CA certificate");
-            wolfSSL_CTX_free(p_pttEngine->t_CipherCtx);
-            p_pttEngine->t_CipherCtx = NULL;
+            wolfSSL_CTX_free(l_ptCtx);
             return TLS_CERT_ERROR;
         }
         X_LOG_TRACE("CA certificate loaded successfully");
@@ -167,19 +309,17 @@ unsigned long tlsEngineInit(TLS_Engine* p_pttEngine, int p_iSocketFd, const TLS_
         X_LOG_TRACE("Loading server certificate from %s", p_kpttConfig->t_cCertPath);
         X_LOG_TRACE("Loading server key from %s", p_kpttConfig->t_cKeyPath);
         
-        if (wolfSSL_CTX_use_certificate_file(p_pttEngine->t_CipherCtx, p_kpttConfig->t_cCertPath, WOLFSSL_FILETYPE_PEM) != WOLFSSL_SUCCESS) 
+        if (wolfSSL_CTX_use_certificate_file(l_ptCtx, p_kpttConfig->t_cCertPath, WOLFSSL_FILETYPE_PEM) != WOLFSSL_SUCCESS) 
         {
             X_LOG_TRACE("Failed to load server certificate");
-            wolfSSL_CTX_free(p_pttEngine->t_CipherCtx);
-            p_pttEngine->t_CipherCtx = NULL;
+            wolfSSL_CTX_free(l_ptCtx);
             return TLS_CERT_ERROR;
         }
         
-        if (wolfSSL_CTX_use_PrivateKey_file(p_pttEngine->t_CipherCtx, p_kpttConfig->t_cKeyPath, WOLFSSL_FILETYPE_PEM) != WOLFSSL_SUCCESS) 
+        if (wolfSSL_CTX_use_PrivateKey_file(l_ptCtx, p_kpttConfig->t_cKeyPath, WOLFSSL_FILETYPE_PEM) != WOLFSSL_SUCCESS) 
         {
             X_LOG_TRACE("Failed to load server key");
-            wolfSSL_CTX_free(p_pttEngine->t_CipherCtx);
-            p_pttEngine->t_CipherCtx = NULL;
+            wolfSSL_CTX_free(l_ptCtx);
             return TLS_CERT_ERROR;
         }
         
@@ -189,23 +329,43 @@ unsigned long tlsEngineInit(TLS_Engine* p_pttEngine, int p_iSocketFd, const TLS_
     // Set verification mode
     if (p_kpttConfig->t_bVerifyPeer) 
     {
-        wolfSSL_CTX_set_verify(p_pttEngine->t_CipherCtx, WOLFSSL_VERIFY_PEER, NULL); 
+        wolfSSL_CTX_set_verify(l_ptCtx, WOLFSSL_VERIFY_PEER, NULL); 
         X_LOG_TRACE("Peer verification enabled");
     } 
     else 
     {
-        wolfSSL_CTX_set_verify(p_pttEngine->t_CipherCtx, WOLFSSL_VERIFY_NONE, NULL);
+        wolfSSL_CTX_set_verify(l_ptCtx, WOLFSSL_VERIFY_NONE, NULL);
         X_LOG_TRACE("Peer verification disabled");
     }
 
+    // Session resumption: the server keeps sessions and issues tickets (TLS 1.3 PSK),
+    // the client offers the session it kept in tlsEngineConnect
+    if (p_kpttConfig->t_bSessionResumption && p_kpttConfig->t_bIsServer)
+    {
+        unsigned int l_uiLifetime = p_kpttConfig->t_uiSessionLifetimeSec ? p_kpttConfig->t_uiSessionLifetimeSec : TLS_SESSION_DEFAULT_LIFETIME;
+        wolfSSL_CTX_set_timeout(l_ptCtx, l_uiLifetime);
+#ifdef HAVE_SESSION_TICKET
+        wolfSSL_CTX_set_TicketHint(l_ptCtx, (int)l_uiLifetime);
+#endif
+        X_LOG_TRACE("Session cache and tickets enabled, lifetime %u s", l_uiLifetime);
+    }
+#ifdef HAVE_SESSION_TICKET
+    else if (p_kpttConfig->t_bSessionResumption && p_kpttConfig->t_eTlsVersion == TLS_VERSION_1_2)
+    {
+        // TLS 1.2 tickets need the extension, TLS 1.3 receives them after the handshake
+        wolfSSL_CTX_UseSessionTicket(l_ptCtx);
+    }
+#endif
+
     //check if ECDSA is enabled and cipher list is ECDSA
     if (p_kpttConfig->t_bLoadEcdsaCipher)
     {
         X_LOG_TRACE("Loading ECDSA cipher");
-        if (strcmp(p_kpttConfig->cipherList, s_kptcTlsCipherList [3]) != 0) //ECDSA ID
+        if (p_kpttConfig->cipherList == NULL || strcmp(p_kpttConfig->cipherList, s_kptcTlsCipherList [3]) != 0) //ECDSA ID
         {
             X_LOG_TRACE("Cipher list is not ECDSA");
-            X_ASSERT(false);
+            wolfSSL_CTX_free(l_ptCtx);
+            return TLS_INVALID_PARAM;
         }
     }
     
@@ -213,22 +373,20 @@ unsigned long tlsEngineInit(TLS_Engine* p_pttEngine, int p_iSocketFd, const TLS_
     if (p_kpttConfig->cipherList) 
     {
         X_LOG_TRACE("Setting cipher list: %s", p_kpttConfig->cipherList);
-        if (wolfSSL_CTX_set_cipher_list(p_pttEngine->t_CipherCtx, p_kpttConfig->cipherList) != WOLFSSL_SUCCESS) 
+        if (wolfSSL_CTX_set_cipher_list(l_ptCtx, p_kpttConfig->cipherList) != WOLFSSL_SUCCESS) 
         {
             X_LOG_TRACE("Failed to set cipher list");
-            wolfSSL_CTX_free(p_pttEngine->t_CipherCtx);
-            p_pttEngine->t_CipherCtx = NULL;
+            wolfSSL_CTX_free(l_ptCtx);
             return TLS_ERROR;
         }
     }
     else 
     {
         X_LOG_TRACE("No cipher list provided, using default : %s", s_kptcDefaultTlsCipher);
-        if (wolfSSL_CTX_set_cipher_list(p_pttEngine->t_CipherCtx, (char*)s_kptcDefaultTlsCipher) != WOLFSSL_SUCCESS) 
+        if (wolfSSL_CTX_set_cipher_list(l_ptCtx, (char*)s_kptcDefaultTlsCipher) != WOLFSSL_SUCCESS) 
         {
             X_LOG_TRACE("Failed to set default cipher list");
-            wolfSSL_CTX_free(p_pttEngine->t_CipherCtx);
-            p_pttEngine->t_CipherCtx = NULL;
+            wolfSSL_CTX_free(l_ptCtx);
             return TLS_ERROR;
         }
     }
@@ -257,7 +415,8 @@ unsigned long tlsEngineInit(TLS_Engine* p_pttEngine, int p_iSocketFd, const TLS_
             break;
         default:
             X_LOG_TRACE("ECC curve not supported");
-            X_ASSERT(false);
+            wolfSSL_CTX_free(l_ptCtx);
+            return TLS_INVALID_PARAM;
     }
     
     // Set TLS 1.3 groups (curves)
@@ -266,19 +425,51 @@ unsigned long tlsEngineInit(TLS_Engine* p_pttEngine, int p_iSocketFd, const TLS_
         int groups_array[1] = { l_iEcc };
         X_LOG_TRACE("Setting TLS 1.3 groups");
         
-        if (wolfSSL_CTX_set_groups(p_pttEngine->t_CipherCtx, groups_array, 1) != WOLFSSL_SUCCESS) 
+        if (wolfSSL_CTX_set_groups(l_ptCtx, groups_array, 1) != WOLFSSL_SUCCESS) 
         {
             X_LOG_TRACE("Failed to set TLS 1.3 groups");
-            wolfSSL_CTX_free(p_pttEngine->t_CipherCtx);
-            p_pttEngine->t_CipherCtx = NULL;
+            wolfSSL_CTX_free(l_ptCtx);
             return TLS_ERROR;
         }
     }
     
     // Set IO callbacks
     X_LOG_TRACE("Setting IO callbacks");
-    wolfSSL_SetIORecv(p_pttEngine->t_CipherCtx, tlsEngineIORecv);
-    wolfSSL_SetIOSend(p_pttEngine->t_CipherCtx, tlsEngineIOSend);
+    wolfSSL_SetIORecv(l_ptCtx, tlsEngineIORecv);
+    wolfSSL_SetIOSend(l_ptCtx, tlsEngineIOSend);
+    
+    *p_pptCtx = l_ptCtx;
+    return TLS_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// tlsEngineInit
+////////////////////////////////////////////////////////////
+unsigned long tlsEngineInit(TLS_Engine* p_pttEngine, int p_iSocketFd, const TLS_Config* p_kpttConfig) 
+{
+    X_ASSERT(p_pttEngine != NULL);
+    X_ASSERT(p_kpttConfig != NULL);
+
+    X_LOG_TRACE("Initializing TLS engine for socket %d", p_iSocketFd);
+
+    if (!p_pttEngine || !p_kpttConfig || p_iSocketFd < 0) 
+    {
+        X_LOG_TRACE("Invalid parameters for TLS engine initialization");
+        return TLS_INVALID_PARAM;
+    }
+
+    // Initialize engine structure
+    memset(p_pttEngine, 0, sizeof(TLS_Engine));
+    p_pttEngine->t_iSocketFd = p_iSocketFd;
+    p_pttEngine->t_eTlsVersion = p_kpttConfig->t_eTlsVersion;
+    p_pttEngine->t_eEccCurve = p_kpttConfig->t_eEccCurve;
+    p_pttEngine->t_bSessionResumption = p_kpttConfig->t_bSessionResumption;
+    
+    unsigned long l_ulReturn = tlsEngineCreateCtx(p_kpttConfig, &p_pttEngine->t_CipherCtx);
+    if (l_ulReturn != TLS_OK)
+    {
+        return l_ulReturn;
+    }
     
     p_pttEngine->t_bInitialised = true;
     X_LOG_TRACE("TLS engine initialized successfully");
@@ -287,9 +478,95 @@ unsigned long tlsEngineInit(TLS_Engine* p_pttEngine, int p_iSocketFd, const TLS_
 }
 
 ////////////////////////////////////////////////////////////
-/// tlsEngineConnect
+/// tlsContextCreate
 ////////////////////////////////////////////////////////////
-unsigned long tlsEngineConnect(TLS_Engine* p_pttEngine) 
+unsigned long tlsContextCreate(TLS_Context** p_pptContext, const TLS_Config* p_kpttConfig)
+{
+    if (!p_pptContext || !p_kpttConfig) 
+    {
+        return TLS_INVALID_PARAM;
+    }
+
+    TLS_Context* l_ptContext = (TLS_Context*)X_MALLOC(sizeof(TLS_Context));
+    if (!l_ptContext) 
+    {
+        return TLS_ERROR;
+    }
+    memset(l_ptContext, 0, sizeof(TLS_Context));
+
+    unsigned long l_ulReturn = tlsEngineCreateCtx(p_kpttConfig, &l_ptContext->t_CipherCtx);
+    if (l_ulReturn != TLS_OK)
+    {
+        X_FREE(l_ptContext);
+        return l_ulReturn;
+    }
+
+    atomic_init(&l_ptContext->a_iRefCount, 1);
+    l_ptContext->t_eTlsVersion = p_kpttConfig->t_eTlsVersion;
+    l_ptContext->t_eEccCurve = p_kpttConfig->t_eEccCurve;
+    l_ptContext->t_bIsServer = p_kpttConfig->t_bIsServer;
+    l_ptContext->t_bSessionResumption = p_kpttConfig->t_bSessionResumption;
+    X_LOG_TRACE("Shared TLS context created (%s)", l_ptContext->t_bIsServer ? "server" : "client");
+
+    *p_pptContext = l_ptContext;
+    return TLS_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// tlsContextRetain
+////////////////////////////////////////////////////////////
+void tlsContextRetain(TLS_Context* p_ptContext)
+{
+    X_ASSERT(p_ptContext != NULL);
+    atomic_fetch_add_explicit(&p_ptContext->a_iRefCount, 1, memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////
+/// tlsContextRelease
+////////////////////////////////////////////////////////////
+void tlsContextRelease(TLS_Context* p_ptContext)
+{
+    if (!p_ptContext) 
+    {
+        return;
+    }
+
+    if (atomic_fetch_sub_explicit(&p_ptContext->a_iRefCount, 1, memory_order_acq_rel) == 1)
+    {
+        wolfSSL_CTX_free(p_ptContext->t_CipherCtx);
+        X_FREE(p_ptContext);
+    }
+}
+
+////////////////////////////////////////////////////////////
+/// tlsEngineInitShared
+////////////////////////////////////////////////////////////
+unsigned long tlsEngineInitShared(TLS_Engine* p_pttEngine, int p_iSocketFd, TLS_Context* p_ptContext)
+{
+    if (!p_pttEngine || !p_ptContext || p_iSocketFd < 0) 
+    {
+        X_LOG_TRACE("Invalid parameters for TLS engine initialization");
+        return TLS_INVALID_PARAM;
+    }
+
+    memset(p_pttEngine, 0, sizeof(TLS_Engine));
+    p_pttEngine->t_iSocketFd = p_iSocketFd;
+    p_pttEngine->t_eTlsVersion = p_ptContext->t_eTlsVersion;
+    p_pttEngine->t_eEccCurve = p_ptContext->t_eEccCurve;
+    p_pttEngine->t_bSessionResumption = p_ptContext->t_bSessionResumption;
+
+    tlsContextRetain(p_ptContext);
+    p_pttEngine->t_ptContext = p_ptContext;
+    p_pttEngine->t_CipherCtx = p_ptContext->t_CipherCtx;
+    p_pttEngine->t_bInitialised = true;
+
+    return TLS_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// tlsEngineStartConnect
+////////////////////////////////////////////////////////////
+unsigned long tlsEngineStartConnect(TLS_Engine* p_pttEngine) 
 {
     if (!p_pttEngine || !p_pttEngine->t_bInitialised || !p_pttEngine->t_CipherCtx || p_pttEngine->t_iSocketFd < 0) 
     {
@@ -307,32 +584,29 @@ unsigned long tlsEngineConnect(TLS_Engine* p_pttEngine)
     }
     
     // Set socket as IO context
-    wolfSSL_SetIOReadCtx(p_pttEngine->t_SslSession, &p_pttEngine->t_iSocketFd);
-    wolfSSL_SetIOWriteCtx(p_pttEngine->t_SslSession, &p_pttEngine->t_iSocketFd);
-    
-    // Perform TLS handshake
-    int ret = wolfSSL_connect(p_pttEngine->t_SslSession);
-    if (ret != WOLFSSL_SUCCESS) 
+    wolfSSL_SetIOReadCtx(p_pttEngine->t_SslSession, p_pttEngine);
+    wolfSSL_SetIOWriteCtx(p_pttEngine->t_SslSession, p_pttEngine);
+
+    // Offer the session kept from the last connection to this server
+    p_pttEngine->t_bIsClient = true;
+    socklen_t l_iPeerLen = sizeof(p_pttEngine->t_tPeer);
+    if (p_pttEngine->t_bSessionResumption &&
+        getpeername(p_pttEngine->t_iSocketFd, (struct sockaddr*)&p_pttEngine->t_tPeer, &l_iPeerLen) == 0)
     {
-        int err = wolfSSL_get_error(p_pttEngine->t_SslSession, ret);
-        char errorBuffer[80];
-        wolfSSL_ERR_error_string(err, errorBuffer);
-        X_LOG_TRACE("TLS client handshake failed with error code %d, message: %s", err, errorBuffer);
-        wolfSSL_free(p_pttEngine->t_SslSession);
-        p_pttEngine->t_SslSession = NULL;
-        return TLS_CONNECT_ERROR;
+        tlsEngineSessionOffer(p_pttEngine);
+    }
+    else
+    {
+        p_pttEngine->t_bSessionResumption = false;
     }
-    
-    X_LOG_TRACE("TLS client handshake completed successfully");
-    p_pttEngine->t_bIsConnected = true;
     
     return TLS_OK;
 }
 
 ////////////////////////////////////////////////////////////
-/// tlsEngineAccept
+/// tlsEngineStartAccept
 ////////////////////////////////////////////////////////////
-unsigned long tlsEngineAccept(TLS_Engine* p_pttEngine, int p_iSocketFd, const TLS_Engine* p_pListenEngine) 
+unsigned long tlsEngineStartAccept(TLS_Engine* p_pttEngine, int p_iSocketFd, const TLS_Engine* p_pListenEngine) 
 {
     if (!p_pttEngine || !p_pListenEngine || !p_pListenEngine->t_bInitialised || 
         !p_pListenEngine->t_CipherCtx || p_iSocketFd < 0) 
@@ -348,6 +622,7 @@ unsigned long tlsEngineAccept(TLS_Engine* p_pttEngine, int p_iSocketFd, const TL
     p_pttEngine->t_iSocketFd = p_iSocketFd;
     p_pttEngine->t_eTlsVersion = p_pListenEngine->t_eTlsVersion;
     p_pttEngine->t_eEccCurve = p_pListenEngine->t_eEccCurve;
+    p_pttEngine->t_bSessionResumption = p_pListenEngine->t_bSessionResumption;
     
     // We'll use the listening engine's context to create a new SSL session,
     // but won't store a reference to it to avoid potential double-free issues.
@@ -373,36 +648,103 @@ unsigned long tlsEngineAccept(TLS_Engine* p_pttEngine, int p_iSocketFd, const TL
     
     // Set socket as IO context
     X_LOG_TRACE("Setting IO context for socket %d", p_iSocketFd);
-    wolfSSL_SetIOReadCtx(p_pttEngine->t_SslSession, &p_pttEngine->t_iSocketFd);
-    wolfSSL_SetIOWriteCtx(p_pttEngine->t_SslSession, &p_pttEngine->t_iSocketFd);
+    wolfSSL_SetIOReadCtx(p_pttEngine->t_SslSession, p_pttEngine);
+    wolfSSL_SetIOWriteCtx(p_pttEngine->t_SslSession, p_pttEngine);
     
-    // Debug: Display additional information about SSL context
-    X_LOG_TRACE("Debug info: p_pttEngine socket: %d, listening socket: %d", 
-               p_pttEngine->t_iSocketFd, p_pListenEngine->t_iSocketFd);
-    
-    // Perform TLS handshake
-    X_LOG_TRACE("Performing TLS accept handshake");
-    int ret = wolfSSL_accept(p_pttEngine->t_SslSession);
+    return TLS_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// tlsEngineHandshake
+////////////////////////////////////////////////////////////
+unsigned long tlsEngineHandshake(TLS_Engine* p_pttEngine) 
+{
+    if (!p_pttEngine || !p_pttEngine->t_bInitialised || !p_pttEngine->t_SslSession) 
+    {
+        return TLS_INVALID_PARAM;
+    }
+
+    if (p_pttEngine->t_bIsConnected) 
+    {
+        return TLS_OK;
+    }
     
-    // Get and log more error information in case of failure
+    // Each call runs the handshake as far as the socket allows, its flights show as tls.recv / tls.send
+    X_TRACE_BEGIN("tls.handshake");
+    int ret = p_pttEngine->t_bIsClient ? wolfSSL_connect(p_pttEngine->t_SslSession)
+                                       : wolfSSL_accept(p_pttEngine->t_SslSession);
+    X_TRACE_END("tls.handshake");
     if (ret != WOLFSSL_SUCCESS) 
     {
         int err = wolfSSL_get_error(p_pttEngine->t_SslSession, ret);
+        if (err == WOLFSSL_ERROR_WANT_READ) 
+        {
+            X_TRACE_INSTANT("tls.handshake.want_read");
+            return TLS_WANT_READ;
+        }
+        if (err == WOLFSSL_ERROR_WANT_WRITE) 
+        {
+            X_TRACE_INSTANT("tls.handshake.want_write");
+            return TLS_WANT_WRITE;
+        }
+
         char errorBuffer[80];
         wolfSSL_ERR_error_string(err, errorBuffer);
-        X_LOG_TRACE("TLS accept failed with error code: %d, message: %s", err, errorBuffer);
+        X_LOG_TRACE("TLS %s handshake failed with error code %d, message: %s",
+                    p_pttEngine->t_bIsClient ? "client" : "accept", err, errorBuffer);
+        xMetricsInc(s_ptMetricFailures);
         wolfSSL_free(p_pttEngine->t_SslSession);
         p_pttEngine->t_SslSession = NULL;
-        p_pttEngine->t_bInitialised = false;
         return TLS_CONNECT_ERROR;
     }
     
-    X_LOG_TRACE("TLS handshake completed successfully");
+    X_LOG_TRACE("TLS %s handshake completed successfully (%s)", p_pttEngine->t_bIsClient ? "client" : "accept",
+                wolfSSL_session_reused(p_pttEngine->t_SslSession) ? "resumed" : "full");
+    X_TRACE_INSTANT("tls.handshake.done");
+    xMetricsInc(s_ptMetricHandshakes);
+    if (wolfSSL_session_reused(p_pttEngine->t_SslSession))
+    {
+        xMetricsInc(s_ptMetricResumed);
+    }
     p_pttEngine->t_bIsConnected = true;
     
     return TLS_OK;
 }
 
+////////////////////////////////////////////////////////////
+/// tlsEngineConnect
+////////////////////////////////////////////////////////////
+unsigned long tlsEngineConnect(TLS_Engine* p_pttEngine) 
+{
+    unsigned long l_ulReturn = tlsEngineStartConnect(p_pttEngine);
+    if (l_ulReturn != TLS_OK) 
+    {
+        return l_ulReturn;
+    }
+
+    return tlsEngineHandshake(p_pttEngine);
+}
+
+////////////////////////////////////////////////////////////
+/// tlsEngineAccept
+////////////////////////////////////////////////////////////
+unsigned long tlsEngineAccept(TLS_Engine* p_pttEngine, int p_iSocketFd, const TLS_Engine* p_pListenEngine) 
+{
+    unsigned long l_ulReturn = tlsEngineStartAccept(p_pttEngine, p_iSocketFd, p_pListenEngine);
+    if (l_ulReturn != TLS_OK) 
+    {
+        return l_ulReturn;
+    }
+
+    l_ulReturn = tlsEngineHandshake(p_pttEngine);
+    if (l_ulReturn != TLS_OK && l_ulReturn != TLS_WANT_READ && l_ulReturn != TLS_WANT_WRITE) 
+    {
+        p_pttEngine->t_bInitialised = false;
+    }
+
+    return l_ulReturn;
+}
+
 ////////////////////////////////////////////////////////////
 /// tlsEngineSend
 ////////////////////////////////////////////////////////////
@@ -414,14 +756,52 @@ unsigned long tlsEngineSend(TLS_Engine* p_pttEngine, const void* p_pBuffer, unsi
         return TLS_INVALID_PARAM;
     }
     
-    int sent = wolfSSL_write(p_pttEngine->t_SslSession, p_pBuffer, p_ulSize);
-    
-    if (sent < 0) 
+    if (!p_pttEngine->t_bCorked)
     {
-        return TLS_ERROR;
+        int sent = wolfSSL_write(p_pttEngine->t_SslSession, p_pBuffer, p_ulSize);
+        if (sent < 0) 
+        {
+            return TLS_ERROR;
+        }
+        return (unsigned long)sent;
+    }
+
+    // Corked: fill the current record, a full one leaves at once
+    const unsigned char* l_pucData = (const unsigned char*)p_pBuffer;
+    unsigned long l_ulDone = 0;
+    while (l_ulDone < p_ulSize)
+    {
+        unsigned long l_ulLeft = p_ulSize - l_ulDone;
+        if (p_pttEngine->t_uiWriteSize == 0 && l_ulLeft >= TLS_RECORD_PLAINTEXT_MAX)
+        {
+            // Whole records need no copy
+            int sent = wolfSSL_write(p_pttEngine->t_SslSession, l_pucData + l_ulDone, (int)l_ulLeft);
+            if (sent <= 0) 
+            {
+                // Report what was already accepted, the caller resends the rest
+                return l_ulDone > 0 ? l_ulDone : TLS_ERROR;
+            }
+            l_ulDone += (unsigned long)sent;
+            continue;
+        }
+
+        unsigned long l_ulCopy = TLS_RECORD_PLAINTEXT_MAX - p_pttEngine->t_uiWriteSize;
+        if (l_ulCopy > l_ulLeft)
+        {
+            l_ulCopy = l_ulLeft;
+        }
+        memcpy(p_pttEngine->t_ucWriteBuffer + p_pttEngine->t_uiWriteSize, l_pucData + l_ulDone, l_ulCopy);
+        p_pttEngine->t_uiWriteSize += (unsigned int)l_ulCopy;
+        l_ulDone += l_ulCopy;
+
+        if (p_pttEngine->t_uiWriteSize == TLS_RECORD_PLAINTEXT_MAX && tlsEngineFlush(p_pttEngine) != TLS_OK)
+        {
+            // The copied bytes stay in the record and leave on the next flush
+            return l_ulDone > 0 ? l_ulDone : TLS_ERROR;
+        }
     }
     
-    return (unsigned long)sent;
+    return l_ulDone;
 }
 
 ////////////////////////////////////////////////////////////
@@ -435,6 +815,12 @@ unsigned long tlsEngineReceive(TLS_Engine* p_pttEngine, void* p_pBuffer, unsigne
         return TLS_INVALID_PARAM;
     }
     
+    // A reply can only follow the request held by the cork
+    if (p_pttEngine->t_uiWriteSize > 0 && tlsEngineFlush(p_pttEngine) != TLS_OK)
+    {
+        return TLS_ERROR;
+    }
+    
     int received = wolfSSL_read(p_pttEngine->t_SslSession, p_pBuffer, p_ulSize);
     
     if (received < 0) 
@@ -450,6 +836,70 @@ unsigned long tlsEngineReceive(TLS_Engine* p_pttEngine, void* p_pBuffer, unsigne
     return (unsigned long)received;
 }
 
+////////////////////////////////////////////////////////////
+/// tlsEngineSetCork
+////////////////////////////////////////////////////////////
+unsigned long tlsEngineSetCork(TLS_Engine* p_pttEngine, bool p_bCorked)
+{
+    if (!p_pttEngine || !p_pttEngine->t_bInitialised)
+    {
+        return TLS_INVALID_PARAM;
+    }
+
+    p_pttEngine->t_bCorked = p_bCorked;
+    if (!p_bCorked && p_pttEngine->t_uiWriteSize > 0)
+    {
+        return tlsEngineFlush(p_pttEngine);
+    }
+
+    return TLS_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// tlsEngineFlush
+////////////////////////////////////////////////////////////
+unsigned long tlsEngineFlush(TLS_Engine* p_pttEngine)
+{
+    if (!p_pttEngine || !p_pttEngine->t_bInitialised || !p_pttEngine->t_SslSession || 
+        !p_pttEngine->t_bIsConnected) 
+    {
+        return TLS_INVALID_PARAM;
+    }
+
+    unsigned int l_uiSent = 0;
+    while (l_uiSent < p_pttEngine->t_uiWriteSize)
+    {
+        int sent = wolfSSL_write(p_pttEngine->t_SslSession, p_pttEngine->t_ucWriteBuffer + l_uiSent,
+                                 (int)(p_pttEngine->t_uiWriteSize - l_uiSent));
+        if (sent <= 0)
+        {
+            // Keep the unsent part for the next flush
+            memmove(p_pttEngine->t_ucWriteBuffer, p_pttEngine->t_ucWriteBuffer + l_uiSent,
+                    p_pttEngine->t_uiWriteSize - l_uiSent);
+            p_pttEngine->t_uiWriteSize -= l_uiSent;
+            return TLS_ERROR;
+        }
+        l_uiSent += (unsigned int)sent;
+    }
+    p_pttEngine->t_uiWriteSize = 0;
+
+    return TLS_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// tlsEngineHasPendingData
+////////////////////////////////////////////////////////////
+bool tlsEngineHasPendingData(const TLS_Engine* p_pttEngine)
+{
+    if (!p_pttEngine || !p_pttEngine->t_SslSession)
+    {
+        return false;
+    }
+
+    return p_pttEngine->t_uiReadStart < p_pttEngine->t_uiReadEnd ||
+           wolfSSL_pending(p_pttEngine->t_SslSession) > 0;
+}
+
 ////////////////////////////////////////////////////////////
 /// tlsEngineClose
 ////////////////////////////////////////////////////////////
@@ -460,6 +910,18 @@ unsigned long tlsEngineClose(TLS_Engine* p_pttEngine)
         return TLS_INVALID_PARAM;
     }
     
+    // Held writes go out before the close notify
+    if (p_pttEngine->t_uiWriteSize > 0 && p_pttEngine->t_bIsConnected)
+    {
+        tlsEngineFlush(p_pttEngine);
+    }
+
+    // Keep the client session, tickets arrive after the handshake so this is the latest one
+    if (p_pttEngine->t_bIsClient && p_pttEngine->t_bSessionResumption && p_pttEngine->t_bIsConnected)
+    {
+        tlsEngineSessionKeep(p_pttEngine);
+    }
+
     // Perform TLS shutdown
     wolfSSL_shutdown(p_pttEngine->t_SslSession);
     
@@ -491,8 +953,14 @@ unsigned long tlsEngineCleanup(TLS_Engine* p_pttEngine)
         p_pttEngine->t_SslSession = NULL;
     }
     
-    // Free wolfSSL context only if we own it (not shared from accept)
-    if (p_pttEngine->t_CipherCtx) 
+    // Free wolfSSL context only if we own it (not shared from accept or a TLS_Context)
+    if (p_pttEngine->t_ptContext)
+    {
+        tlsContextRelease(p_pttEngine->t_ptContext);
+        p_pttEngine->t_ptContext = NULL;
+        p_pttEngine->t_CipherCtx = NULL;
+    }
+    else if (p_pttEngine->t_CipherCtx) 
     {
         X_LOG_TRACE("Freeing SSL context");
         wolfSSL_CTX_free(p_pttEngine->t_CipherCtx);
@@ -509,6 +977,37 @@ unsigned long tlsEngineCleanup(TLS_Engine* p_pttEngine)
     return TLS_OK;
 }
 
+////////////////////////////////////////////////////////////
+/// tlsEngineIsSessionResumed
+////////////////////////////////////////////////////////////
+bool tlsEngineIsSessionResumed(const TLS_Engine* p_pttEngine)
+{
+    if (!p_pttEngine || !p_pttEngine->t_SslSession || !p_pttEngine->t_bIsConnected)
+    {
+        return false;
+    }
+
+    return wolfSSL_session_reused(p_pttEngine->t_SslSession) == 1;
+}
+
+////////////////////////////////////////////////////////////
+/// tlsEngineFlushSessionCache
+////////////////////////////////////////////////////////////
+void tlsEngineFlushSessionCache(void)
+{
+    pthread_mutex_lock(&s_tSessionMutex);
+    for (int i = 0; i < TLS_SESSION_CACHE_SIZE; i++)
+    {
+        if (s_tSessionCache[i].t_ptSession)
+        {
+            wolfSSL_SESSION_free(s_tSessionCache[i].t_ptSession);
+            s_tSessionCache[i].t_ptSession = NULL;
+        }
+    }
+    s_uiSessionNext = 0;
+    pthread_mutex_unlock(&s_tSessionMutex);
+}
+
 ////////////////////////////////////////////////////////////
 /// tlsEngineGetErrorString
 ////////////////////////////////////////////////////////////
@@ -528,6 +1027,10 @@ const char* tlsEngineGetErrorString(int p_iError)
             return "Connection error";
         case TLS_VERIFY_ERROR:
             return "Verification error";
+        case TLS_WANT_READ:
+            return "Handshake waiting for data";
+        case TLS_WANT_WRITE:
+            return "Handshake waiting for send space";
         default:
             return "Unknown error";
     }
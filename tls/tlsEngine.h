@@ -13,6 +13,8 @@
 #include <wolfssl/ssl.h>
 #include <wolfssl/wolfcrypt/settings.h>
 #include <stdbool.h>
+#include <stdatomic.h>
+#include <netinet/in.h>
 
 // Configuration constants
 #define TLS_OK                  0xF1E92D80
@@ -21,6 +23,16 @@
 #define TLS_CERT_ERROR          0xF1E92D83
 #define TLS_CONNECT_ERROR       0xF1E92D84
 #define TLS_VERIFY_ERROR        0xF1E92D85
+#define TLS_WANT_READ           0xF1E92D86  // Handshake waits for the socket to become readable
+#define TLS_WANT_WRITE          0xF1E92D87  // Handshake waits for the socket to become writable
+
+// Session resumption
+#define TLS_SESSION_CACHE_SIZE       16      // Client sessions kept, one per server address
+#define TLS_SESSION_DEFAULT_LIFETIME 3600    // Server session and ticket lifetime in seconds when 0 is configured
+
+// Record I/O buffering
+#define TLS_RECORD_PLAINTEXT_MAX     16384   // Largest record payload, one corked record at most
+#define TLS_RECORD_MAX_SIZE          (TLS_RECORD_PLAINTEXT_MAX + 256 + 5) // Largest encrypted record with its header
 
 // tls cipher list available for the API
 static const char* s_kptcTlsCipherList [] = 
@@ -50,16 +62,37 @@ typedef enum
     TLS_ECC_X25519    = 3   // Curve25519
 } TLS_ECC_Curve;
 
+// Shared TLS context: one wolfSSL context with its certificates loaded once
+typedef struct tlsContext_t
+{
+    WOLFSSL_CTX* t_CipherCtx;   // wolfSSL context
+    atomic_int a_iRefCount;     // Creator and engines holding the context
+    TLS_Version t_eTlsVersion;  // TLS version
+    TLS_ECC_Curve t_eEccCurve;  // ECC curve type
+    bool t_bIsServer;           // Server or client methods
+    bool t_bSessionResumption;  // Resume sessions
+} TLS_Context;
+
 // TLS Engine context
 typedef struct tlsEngine_t
 {
     WOLFSSL_CTX* t_CipherCtx;   // wolfSSL context
+    TLS_Context* t_ptContext;   // Shared context holding t_CipherCtx (NULL when owned)
     WOLFSSL* t_SslSession;      // wolfSSL session
     int t_iSocketFd;               // Socket file descriptor
     bool t_bInitialised;        // Initialization state
     bool t_bIsConnected;           // Connection state
     TLS_Version t_eTlsVersion;        // TLS version
     TLS_ECC_Curve t_eEccCurve;     // ECC curve type
+    bool t_bSessionResumption;  // Resume sessions (client cache, server cache and tickets)
+    bool t_bIsClient;           // Connected through tlsEngineConnect
+    struct sockaddr_in t_tPeer; // Server address, client session cache key
+    unsigned char t_ucReadAhead[TLS_RECORD_MAX_SIZE]; // Socket bytes read ahead of wolfSSL
+    unsigned int t_uiReadStart; // First byte of t_ucReadAhead not given to wolfSSL
+    unsigned int t_uiReadEnd;   // End of the bytes in t_ucReadAhead
+    unsigned char t_ucWriteBuffer[TLS_RECORD_PLAINTEXT_MAX]; // Plaintext held while corked
+    unsigned int t_uiWriteSize; // Bytes in t_ucWriteBuffer
+    bool t_bCorked;             // Small writes are coalesced until tlsEngineFlush
 } TLS_Engine;
 
 // TLS configuration structure
@@ -74,6 +107,8 @@ typedef struct tlsConfig_t
     const char* cipherList;         // Cipher list (NULL for defaults) TODO: add cipher list ECDHE and ECDSA and RSA support
     bool t_bIsServer;               // True for server, false for client
     bool t_bLoadEcdsaCipher;        // True to load ECDSA cipher and set the ecc key as ECDSA instead of ecdh
+    bool t_bSessionResumption;      // True to resume previous sessions instead of full handshakes
+    unsigned int t_uiSessionLifetimeSec; // Server session and ticket lifetime (0 for TLS_SESSION_DEFAULT_LIFETIME)
 } TLS_Config;
 
 //////////////////////////////////
@@ -89,20 +124,78 @@ typedef struct tlsConfig_t
 //////////////////////////////////
 unsigned long tlsEngineInit(TLS_Engine* p_pttEngine, int p_iSocketFd, const TLS_Config* p_kpttConfig);
 
+//////////////////////////////////
+/// @brief Create a shared TLS context
+/// @param p_pptContext Filled with the context, one reference held by the caller
+/// @param p_kpttConfig TLS configuration
+/// @return int Error code
+//////////////////////////////////
+unsigned long tlsContextCreate(TLS_Context** p_pptContext, const TLS_Config* p_kpttConfig);
+
+//////////////////////////////////
+/// @brief Take a reference on a shared TLS context
+/// @param p_ptContext Shared context
+//////////////////////////////////
+void tlsContextRetain(TLS_Context* p_ptContext);
+
+//////////////////////////////////
+/// @brief Drop a reference, the last one frees the context
+/// @param p_ptContext Shared context (NULL is ignored)
+//////////////////////////////////
+void tlsContextRelease(TLS_Context* p_ptContext);
+
+//////////////////////////////////
+/// @brief Initialize the TLS engine on a shared context
+/// @param p_pttEngine Pointer to TLS_Engine structure to initialize
+/// @param p_iSocketFd Socket file descriptor
+/// @param p_ptContext Shared context, retained until tlsEngineCleanup
+/// @return int Error code
+//////////////////////////////////
+unsigned long tlsEngineInitShared(TLS_Engine* p_pttEngine, int p_iSocketFd, TLS_Context* p_ptContext);
+
 //////////////////////////////////
 /// @brief Perform TLS handshake for client connection
 /// @param p_pttEngine TLS engine
-/// @return int Error code
+/// @return int Error code (TLS_WANT_READ or TLS_WANT_WRITE on a non-blocking socket,
+///         continue with tlsEngineHandshake)
+/// @note with session resumption, the session kept from the last connection
+///       to the same server address is offered first
 //////////////////////////////////
 unsigned long tlsEngineConnect(TLS_Engine* p_pttEngine);
 
 //////////////////////////////////
-/// @brief Accept TLS connection as server
+/// @brief Prepare a client handshake without running it
+/// @param p_pttEngine TLS engine on a connected socket
+/// @return int Error code
+//////////////////////////////////
+unsigned long tlsEngineStartConnect(TLS_Engine* p_pttEngine);
+
+//////////////////////////////////
+/// @brief Prepare a server handshake without running it
 /// @param p_pttEngine TLS engine for new connection
 /// @param p_iSocketFd Socket file descriptor for the accepted connection
 /// @param p_pListenEngine TLS engine with server context
 /// @return int Error code
 //////////////////////////////////
+unsigned long tlsEngineStartAccept(TLS_Engine* p_pttEngine, int p_iSocketFd, const TLS_Engine* p_pListenEngine);
+
+//////////////////////////////////
+/// @brief Advance a prepared handshake
+/// @param p_pttEngine TLS engine
+/// @return int TLS_OK when done, TLS_WANT_READ or TLS_WANT_WRITE when the socket
+///         must become ready first, or error code
+/// @note never blocks on a non-blocking socket, so one thread can drive many handshakes
+//////////////////////////////////
+unsigned long tlsEngineHandshake(TLS_Engine* p_pttEngine);
+
+//////////////////////////////////
+/// @brief Accept TLS connection as server
+/// @param p_pttEngine TLS engine for new connection
+/// @param p_iSocketFd Socket file descriptor for the accepted connection
+/// @param p_pListenEngine TLS engine with server context
+/// @return int Error code (TLS_WANT_READ or TLS_WANT_WRITE on a non-blocking socket,
+///         continue with tlsEngineHandshake)
+//////////////////////////////////
 unsigned long tlsEngineAccept(TLS_Engine* p_pttEngine, int p_iSocketFd, const TLS_Engine* p_pListenEngine);
 
 //////////////////////////////////
@@ -110,7 +203,9 @@ unsigned long tlsEngineAccept(TLS_Engine* p_pttEngine, int p_iSocketFd, const TL
 /// @param p_pttEngine TLS engine
 /// @param p_pBuffer Data buffer
 /// @param p_ulSize Data size
-/// @return int Bytes sent or error code
+/// @return int Bytes sent or error code. When corked, a short count is
+///         returned if the socket stops taking data after part of the
+///         buffer was accepted, TLS_ERROR only when nothing was
 //////////////////////////////////
 unsigned long tlsEngineSend(TLS_Engine* p_pttEngine, const void* p_pBuffer, unsigned long p_ulSize);
 
@@ -120,13 +215,41 @@ unsigned long tlsEngineSend(TLS_Engine* p_pttEngine, const void* p_pBuffer, unsi
 /// @param p_pBuffer Data buffer
 /// @param p_ulSize Buffer size
 /// @return int Bytes received or error code
+/// @note corked data is flushed first, records are read ahead from the
+///       socket so tlsEngineHasPendingData must be checked before waiting
+///       for readability
 //////////////////////////////////
 unsigned long tlsEngineReceive(TLS_Engine* p_pttEngine, void* p_pBuffer, unsigned long p_ulSize);
 
+//////////////////////////////////
+/// @brief Coalesce small writes into full records
+/// @param p_pttEngine TLS engine
+/// @param p_bCorked true to hold writes until a record is full or tlsEngineFlush,
+///                  false to flush and write through again
+/// @return int Error code
+//////////////////////////////////
+unsigned long tlsEngineSetCork(TLS_Engine* p_pttEngine, bool p_bCorked);
+
+//////////////////////////////////
+/// @brief Send the writes held by the cork as one record
+/// @param p_pttEngine TLS engine
+/// @return int Error code
+//////////////////////////////////
+unsigned long tlsEngineFlush(TLS_Engine* p_pttEngine);
+
+//////////////////////////////////
+/// @brief Check for received data not visible on the socket
+/// @param p_pttEngine TLS engine
+/// @return bool True if decrypted or read-ahead bytes are waiting
+//////////////////////////////////
+bool tlsEngineHasPendingData(const TLS_Engine* p_pttEngine);
+
 //////////////////////////////////
 /// @brief Close TLS connection
 /// @param p_pttEngine TLS engine
 /// @return int Error code
+/// @note a client session (with the tickets received meanwhile) is kept
+///       for the next connection to the same server address
 //////////////////////////////////
 unsigned long tlsEngineClose(TLS_Engine* p_pttEngine);
 
@@ -137,6 +260,18 @@ unsigned long tlsEngineClose(TLS_Engine* p_pttEngine);
 //////////////////////////////////
 unsigned long tlsEngineCleanup(TLS_Engine* p_pttEngine);
 
+//////////////////////////////////
+/// @brief Check if the handshake resumed a previous session
+/// @param p_pttEngine TLS engine
+/// @return bool True if resumed, false after a full handshake
+//////////////////////////////////
+bool tlsEngineIsSessionResumed(const TLS_Engine* p_pttEngine);
+
+//////////////////////////////////
+/// @brief Drop every client session kept for resumption
+//////////////////////////////////
+void tlsEngineFlushSessionCache(void);
+
 //////////////////////////////////
 /// @brief Get last TLS error description
 /// @param p_iError Error code
@@ -10,48 +10,120 @@
 ////////////////////////////////////////////////////////////
 
 #include "xNetworkTls.h"
+#include "xNetworkOptions.h"
+#include "xNetworkFrame.h"
+#include "xMemPool.h"
+#include "xTrace.h"
+#include "xMetrics.h"
+#include "xTask.h"
+#include <pthread.h>
+#include <fcntl.h>
 
 
 #ifdef USE_TLS
 
+// Pools of socket and TLS engine structures, created on first use
+static xMemPool_t s_tSocketPool;
+static xMemPool_t s_tEnginePool;
+static pthread_once_t s_tSocketPoolOnce = PTHREAD_ONCE_INIT;
+static int s_iSocketPoolStatus = NETWORK_ERROR;
+
+// Registry handles, bytes and system calls are counted by the TLS engine
+static xMetric_t *s_ptMetricAccepted = NULL;
+static xMetric_t *s_ptMetricConnectNs = NULL;
+
 //////////////////////////////////
-/// Core API Implementation
+/// networkSocketPoolInit
 //////////////////////////////////
+static void networkSocketPoolInit(void)
+{
+    xMetricsRegisterCounter("net_accepted_total", "Connections accepted", &s_ptMetricAccepted);
+    xMetricsRegisterHistogram("net_connect_duration_ns", "Blocking connect duration, TLS handshake included", NULL, 0,
+                              &s_ptMetricConnectNs);
 
-////////////////////////////////////////////////////////////
-/// networkCreateSecureSocket
-////////////////////////////////////////////////////////////
-NetworkSocket *networkCreateSecureSocket(const NetworkTlsConfig *p_pTlsConfig)
+    if (xMemPoolCreate(&s_tSocketPool, sizeof(NetworkSocket), NETWORK_MAX_SOCKETS,
+                       XOS_MEMPOOL_FLAG_THREAD_CACHE) != (int)XOS_MEM_OK)
+    {
+        return;
+    }
+
+    if (xMemPoolCreate(&s_tEnginePool, sizeof(TLS_Engine), NETWORK_MAX_SOCKETS,
+                       XOS_MEMPOOL_FLAG_THREAD_CACHE) != (int)XOS_MEM_OK)
+    {
+        xMemPoolDestroy(&s_tSocketPool);
+        return;
+    }
+
+    s_iSocketPoolStatus = NETWORK_OK;
+}
+
+//////////////////////////////////
+/// networkAllocSocket
+//////////////////////////////////
+static NetworkSocket *networkAllocSocket(void)
 {
-    unsigned long l_ulReturn = 0;
-    if (!p_pTlsConfig) 
+    pthread_once(&s_tSocketPoolOnce, networkSocketPoolInit);
+    if (s_iSocketPoolStatus != (int)NETWORK_OK)
     {
-        X_LOG_TRACE("networkCreateSecureSocket: Invalid TLS configuration");
         return NULL;
     }
-    
+
+    return (NetworkSocket *)xMemPoolAlloc(&s_tSocketPool);
+}
+
+//////////////////////////////////
+/// networkFreeSocket
+//////////////////////////////////
+static void networkFreeSocket(NetworkSocket *p_ptSocket)
+{
+    xMemPoolFree(&s_tSocketPool, p_ptSocket);
+}
+
+//////////////////////////////////
+/// networkAllocEngine
+/// @note only called once a socket was obtained from networkAllocSocket
+//////////////////////////////////
+static TLS_Engine *networkAllocEngine(void)
+{
+    return (TLS_Engine *)xMemPoolAlloc(&s_tEnginePool);
+}
+
+//////////////////////////////////
+/// networkFreeEngine
+//////////////////////////////////
+static void networkFreeEngine(void *p_ptEngine)
+{
+    xMemPoolFree(&s_tEnginePool, p_ptEngine);
+}
+
+//////////////////////////////////
+/// networkBuildTlsConfig
+/// @note checks the certificate files, the engine loads them
+//////////////////////////////////
+static int networkBuildTlsConfig(const NetworkTlsConfig *p_pTlsConfig, TLS_Config *p_ptTlsConfig)
+{
     // First check that certificates are available
     if (!p_pTlsConfig->t_cCertPath || !p_pTlsConfig->t_cKeyPath) 
     {
-        X_LOG_TRACE("networkCreateSecureSocket: Certificate and key paths must be provided");
-        return NULL;
+        X_LOG_TRACE("networkBuildTlsConfig: Certificate and key paths must be provided");
+        return NETWORK_INVALID_PARAM;
     }
     
     // Check that files exist
     FILE* l_pttFile;
     if ((l_pttFile = fopen(p_pTlsConfig->t_cCertPath, "r")) == NULL) 
     {
-        X_LOG_TRACE("networkCreateSecureSocket: Certificate file '%s' does not exist or is not accessible", 
+        X_LOG_TRACE("networkBuildTlsConfig: Certificate file '%s' does not exist or is not accessible", 
                    p_pTlsConfig->t_cCertPath);
-        return NULL;
+        return NETWORK_INVALID_PARAM;
     }
     fclose(l_pttFile);
     
     if ((l_pttFile = fopen(p_pTlsConfig->t_cKeyPath, "r")) == NULL) 
     {
-        X_LOG_TRACE("networkCreateSecureSocket: Key file '%s' does not exist or is not accessible", 
+        X_LOG_TRACE("networkBuildTlsConfig: Key file '%s' does not exist or is not accessible", 
                    p_pTlsConfig->t_cKeyPath);
-        return NULL;
+        return NETWORK_INVALID_PARAM;
     }
     fclose(l_pttFile);
     
@@ -60,121 +132,172 @@ NetworkSocket *networkCreateSecureSocket(const NetworkTlsConfig *p_pTlsConfig)
     {
         if ((l_pttFile = fopen(p_pTlsConfig->t_cCaPath, "r")) == NULL) 
         {
-            X_LOG_TRACE("networkCreateSecureSocket: CA file '%s' does not exist or is not accessible", 
+            X_LOG_TRACE("networkBuildTlsConfig: CA file '%s' does not exist or is not accessible", 
                        p_pTlsConfig->t_cCaPath);
-            return NULL;
+            return NETWORK_INVALID_PARAM;
         }
         fclose(l_pttFile);
     }
 
-    // Allocate a new socket structure
-    NetworkSocket *l_pSocket = (NetworkSocket *)malloc(sizeof(NetworkSocket));
-    if (!l_pSocket) 
-    {
-        X_LOG_TRACE("networkCreateSecureSocket: Memory allocation failed");
-        return NULL;
-    }
-
-    // Create the actual socket (always TCP for TLS)
-    l_pSocket->t_iSocketFd = socket(AF_INET, NETWORK_SOCK_TCP, 0);
-    if (l_pSocket->t_iSocketFd < 0) 
-    {
-        X_LOG_TRACE("networkCreateSecureSocket: Socket creation failed with errno %d", errno);
-        free(l_pSocket);
-        return NULL;
-    }
-
-    // Enable address reuse
-    int l_iOption = 1;
-    setsockopt(l_pSocket->t_iSocketFd, SOL_SOCKET, SO_REUSEADDR, &l_iOption, sizeof(l_iOption));
-
-    // Set socket properties
-    l_pSocket->t_iType = NETWORK_SOCK_TCP;
-    l_pSocket->t_bConnected = false;
-    
-    // Initialize the mutex for thread safety
-    mutexCreate(&l_pSocket->t_Mutex);
-    
-    // Allocate TLS engine
-    l_pSocket->t_pTlsEngine = malloc(sizeof(TLS_Engine));
-    if (!l_pSocket->t_pTlsEngine) 
-    {
-        X_LOG_TRACE("networkCreateSecureSocket: TLS engine allocation failed");
-        close(l_pSocket->t_iSocketFd);
-        free(l_pSocket);
-        return NULL;
-    }
-
     // Create TLS configuration structure
-    TLS_Config l_tTlsConfig;
-    memset(&l_tTlsConfig, 0, sizeof(TLS_Config));
+    memset(p_ptTlsConfig, 0, sizeof(TLS_Config));
     
-    // Set TLS version from config (default to TLS 1.3 if not specified or invalid)
+    // Set TLS version from config, any other value is rejected
     if (p_pTlsConfig->t_eVersion == TLS_VERSION_1_2 || p_pTlsConfig->t_eVersion == TLS_VERSION_1_3) 
     {
-        l_tTlsConfig.t_eTlsVersion = p_pTlsConfig->t_eVersion;
+        p_ptTlsConfig->t_eTlsVersion = p_pTlsConfig->t_eVersion;
     } 
     else 
     {
-        X_LOG_TRACE("networkCreateSecureSocket: Invalid TLS version %d", p_pTlsConfig->t_eVersion);
-        X_ASSERT(false);
+        X_LOG_TRACE("networkBuildTlsConfig: Invalid TLS version %d", p_pTlsConfig->t_eVersion);
+        return NETWORK_INVALID_PARAM;
     }
-    X_LOG_TRACE("networkCreateSecureSocket: Using TLS version %d", l_tTlsConfig.t_eTlsVersion);
+    X_LOG_TRACE("networkBuildTlsConfig: Using TLS version %d", p_ptTlsConfig->t_eTlsVersion);
     
     // Set ECC curve from config (default to SECP256R1 if using P-256 certificates or if invalid)
     if (p_pTlsConfig->t_eCurve >= TLS_ECC_SECP256R1 && p_pTlsConfig->t_eCurve <= TLS_ECC_X25519) 
     {
-        l_tTlsConfig.t_eEccCurve = p_pTlsConfig->t_eCurve;
+        p_ptTlsConfig->t_eEccCurve = p_pTlsConfig->t_eCurve;
     } 
     else 
     {
-        l_tTlsConfig.t_eEccCurve = TLS_ECC_SECP256R1;
+        p_ptTlsConfig->t_eEccCurve = TLS_ECC_SECP256R1;
     }
-    X_LOG_TRACE("networkCreateSecureSocket: Using ECC curve %d", l_tTlsConfig.t_eEccCurve);
+    X_LOG_TRACE("networkBuildTlsConfig: Using ECC curve %d", p_ptTlsConfig->t_eEccCurve);
     
     // Copy certificate paths
-    l_tTlsConfig.t_cCaPath = p_pTlsConfig->t_cCaPath;
-    l_tTlsConfig.t_cCertPath = p_pTlsConfig->t_cCertPath;
-    l_tTlsConfig.t_cKeyPath = p_pTlsConfig->t_cKeyPath;
+    p_ptTlsConfig->t_cCaPath = p_pTlsConfig->t_cCaPath;
+    p_ptTlsConfig->t_cCertPath = p_pTlsConfig->t_cCertPath;
+    p_ptTlsConfig->t_cKeyPath = p_pTlsConfig->t_cKeyPath;
     
     // Set cipher list
-    l_tTlsConfig.cipherList = s_kptcDefaultTlsCipher;
+    p_ptTlsConfig->cipherList = s_kptcDefaultTlsCipher;
 
-    X_LOG_TRACE("networkCreateSecureSocket: Using cipher list: %s", l_tTlsConfig.cipherList);
+    X_LOG_TRACE("networkBuildTlsConfig: Using cipher list: %s", p_ptTlsConfig->cipherList);
     
     // Set ECDSA flag if necessary
-    l_tTlsConfig.t_bLoadEcdsaCipher = false;  // Default to false
+    p_ptTlsConfig->t_bLoadEcdsaCipher = false;  // Default to false
     
     // Set verification mode
-    l_tTlsConfig.t_bVerifyPeer = p_pTlsConfig->t_bVerifyPeer;
-    X_LOG_TRACE("networkCreateSecureSocket: Peer verification %s", 
-               l_tTlsConfig.t_bVerifyPeer ? "enabled" : "disabled");
+    p_ptTlsConfig->t_bVerifyPeer = p_pTlsConfig->t_bVerifyPeer;
+    X_LOG_TRACE("networkBuildTlsConfig: Peer verification %s", 
+               p_ptTlsConfig->t_bVerifyPeer ? "enabled" : "disabled");
+
+    // Session resumption
+    p_ptTlsConfig->t_bSessionResumption = p_pTlsConfig->t_bSessionResumption;
+    p_ptTlsConfig->t_uiSessionLifetimeSec = p_pTlsConfig->t_uiSessionLifetimeSec;
     
     // TODO: supprimer cette partie pour une partie plus fiable base sur la cryptographie 
     if (strstr(p_pTlsConfig->t_cCertPath, "server") != NULL) 
     {
-        l_tTlsConfig.t_bIsServer = true;
+        p_ptTlsConfig->t_bIsServer = true;
         X_LOG_TRACE("Using server mode");
     } 
     else 
     {
-        l_tTlsConfig.t_bIsServer = false;
+        p_ptTlsConfig->t_bIsServer = false;
         X_LOG_TRACE("Using client mode");
     }
+
+    return NETWORK_OK;
+}
+
+//////////////////////////////////
+/// Core API Implementation
+//////////////////////////////////
+
+////////////////////////////////////////////////////////////
+/// networkCreateSecureSocket
+////////////////////////////////////////////////////////////
+NetworkSocket *networkCreateSecureSocket(const NetworkTlsConfig *p_pTlsConfig)
+{
+    unsigned long l_ulReturn = 0;
+    if (!p_pTlsConfig) 
+    {
+        X_LOG_TRACE("networkCreateSecureSocket: Invalid TLS configuration");
+        return NULL;
+    }
     
+    // A shared context has its files loaded already
+    TLS_Config l_tTlsConfig;
+    if (!p_pTlsConfig->t_ptContext && networkBuildTlsConfig(p_pTlsConfig, &l_tTlsConfig) != (int)NETWORK_OK)
+    {
+        return NULL;
+    }
+
+    // Allocate a new socket structure
+    NetworkSocket *l_pSocket = networkAllocSocket();
+    if (!l_pSocket) 
+    {
+        X_LOG_TRACE("networkCreateSecureSocket: Memory allocation failed");
+        return NULL;
+    }
+
+    // Create the actual socket (always TCP for TLS)
+    l_pSocket->t_iSocketFd = socket(AF_INET, NETWORK_SOCK_TCP, 0);
+    if (l_pSocket->t_iSocketFd < 0) 
+    {
+        X_LOG_TRACE("networkCreateSecureSocket: Socket creation failed with errno %d", errno);
+        networkFreeSocket(l_pSocket);
+        return NULL;
+    }
+
+    // Enable address reuse
+    int l_iOption = 1;
+    setsockopt(l_pSocket->t_iSocketFd, SOL_SOCKET, SO_REUSEADDR, &l_iOption, sizeof(l_iOption));
+
+    // Set socket properties
+    l_pSocket->t_iType = NETWORK_SOCK_TCP;
+    l_pSocket->t_bConnected = false;
+    l_pSocket->t_bNonBlocking = false;
+    l_pSocket->t_bConnecting = false;
+    l_pSocket->t_bHandshaking = false;
+    l_pSocket->t_ptFrameBuffer = NULL;
+
+    // Apply the requested tuning before any connection exists
+    if (p_pTlsConfig->t_ptOptions && networkSetOptions(l_pSocket, p_pTlsConfig->t_ptOptions) != (int)NETWORK_OK)
+    {
+        X_LOG_TRACE("networkCreateSecureSocket: Socket options refused");
+        close(l_pSocket->t_iSocketFd);
+        networkFreeSocket(l_pSocket);
+        return NULL;
+    }
+    
+    // Initialize the mutex for thread safety
+    mutexCreate(&l_pSocket->t_Mutex);
+    
+    // Allocate TLS engine
+    l_pSocket->t_pTlsEngine = networkAllocEngine();
+    if (!l_pSocket->t_pTlsEngine) 
+    {
+        X_LOG_TRACE("networkCreateSecureSocket: TLS engine allocation failed");
+        close(l_pSocket->t_iSocketFd);
+        networkFreeSocket(l_pSocket);
+        return NULL;
+    }
+
     // Initialize the TLS engine
     X_LOG_TRACE("networkCreateSecureSocket: Initializing TLS engine for socket %d", l_pSocket->t_iSocketFd);
-    l_ulReturn = tlsEngineInit((TLS_Engine*)l_pSocket->t_pTlsEngine, 
-                                  l_pSocket->t_iSocketFd, 
-                                  &l_tTlsConfig);
+    if (p_pTlsConfig->t_ptContext)
+    {
+        l_ulReturn = tlsEngineInitShared((TLS_Engine*)l_pSocket->t_pTlsEngine,
+                                         l_pSocket->t_iSocketFd,
+                                         p_pTlsConfig->t_ptContext);
+    }
+    else
+    {
+        l_ulReturn = tlsEngineInit((TLS_Engine*)l_pSocket->t_pTlsEngine, 
+                                   l_pSocket->t_iSocketFd, 
+                                   &l_tTlsConfig);
+    }
     
     if (l_ulReturn != TLS_OK) 
     {
         X_LOG_TRACE("networkCreateSecureSocket: TLS engine initialization failed with error code %d (%s)",
                    l_ulReturn, tlsEngineGetErrorString(l_ulReturn));
-        free(l_pSocket->t_pTlsEngine);
+        networkFreeEngine(l_pSocket->t_pTlsEngine);
         close(l_pSocket->t_iSocketFd);
-        free(l_pSocket);
+        networkFreeSocket(l_pSocket);
         return NULL;
     }
     
@@ -182,6 +305,42 @@ NetworkSocket *networkCreateSecureSocket(const NetworkTlsConfig *p_pTlsConfig)
     return l_pSocket;
 }
 
+////////////////////////////////////////////////////////////
+/// networkCreateTlsContext
+////////////////////////////////////////////////////////////
+TLS_Context *networkCreateTlsContext(const NetworkTlsConfig *p_pTlsConfig)
+{
+    if (!p_pTlsConfig || p_pTlsConfig->t_ptContext)
+    {
+        X_LOG_TRACE("networkCreateTlsContext: Invalid TLS configuration");
+        return NULL;
+    }
+
+    TLS_Config l_tTlsConfig;
+    if (networkBuildTlsConfig(p_pTlsConfig, &l_tTlsConfig) != (int)NETWORK_OK)
+    {
+        return NULL;
+    }
+
+    TLS_Context *l_ptContext = NULL;
+    unsigned long l_ulReturn = tlsContextCreate(&l_ptContext, &l_tTlsConfig);
+    if (l_ulReturn != TLS_OK)
+    {
+        X_LOG_TRACE("networkCreateTlsContext: Context creation failed (%s)", tlsEngineGetErrorString(l_ulReturn));
+        return NULL;
+    }
+
+    return l_ptContext;
+}
+
+////////////////////////////////////////////////////////////
+/// networkReleaseTlsContext
+////////////////////////////////////////////////////////////
+void networkReleaseTlsContext(TLS_Context *p_ptContext)
+{
+    tlsContextRelease(p_ptContext);
+}
+
 ////////////////////////////////////////////////////////////
 /// networkMakeAddress
 ////////////////////////////////////////////////////////////
@@ -294,6 +453,7 @@ NetworkSocket *networkAccept(NetworkSocket *p_pSocket, NetworkAddress *p_pClient
         X_LOG_TRACE("networkAccept: accept() failed with error %d", errno);
         return NULL;
     }
+    xMetricsInc(s_ptMetricAccepted);
 
     // Store client address if requested
     if (p_pClientAddress) 
@@ -307,7 +467,7 @@ NetworkSocket *networkAccept(NetworkSocket *p_pSocket, NetworkAddress *p_pClient
                p_pClientAddress ? p_pClientAddress->t_usPort : 0);
 
     // Allocate socket for the new connection
-    NetworkSocket *l_pClientSocket = (NetworkSocket *)malloc(sizeof(NetworkSocket));
+    NetworkSocket *l_pClientSocket = networkAllocSocket();
     if (!l_pClientSocket) 
     {
         X_LOG_TRACE("networkAccept: Failed to allocate memory for client socket");
@@ -319,17 +479,21 @@ NetworkSocket *networkAccept(NetworkSocket *p_pSocket, NetworkAddress *p_pClient
     l_pClientSocket->t_iSocketFd = l_iClientFd;
     l_pClientSocket->t_iType = NETWORK_SOCK_TCP;
     l_pClientSocket->t_bConnected = true;
+    l_pClientSocket->t_bNonBlocking = false;
+    l_pClientSocket->t_bConnecting = false;
+    l_pClientSocket->t_bHandshaking = false;
+    l_pClientSocket->t_ptFrameBuffer = NULL;
     
     // Initialize the mutex for thread safety
     mutexCreate(&l_pClientSocket->t_Mutex);
 
     // Allocate TLS engine for the client socket
-    l_pClientSocket->t_pTlsEngine = malloc(sizeof(TLS_Engine));
+    l_pClientSocket->t_pTlsEngine = networkAllocEngine();
     if (!l_pClientSocket->t_pTlsEngine) 
     {
         X_LOG_TRACE("networkAccept: Failed to allocate memory for TLS engine");
         close(l_iClientFd);
-        free(l_pClientSocket);
+        networkFreeSocket(l_pClientSocket);
         return NULL;
     }
 
@@ -341,6 +505,23 @@ NetworkSocket *networkAccept(NetworkSocket *p_pSocket, NetworkAddress *p_pClient
     X_LOG_TRACE("networkAccept: Server TLS initialized: %d, Connected: %d", 
                serverEngine->t_bInitialised, serverEngine->t_bIsConnected);
     
+    // A non-blocking listener leaves the handshake to networkHandshake
+    if (p_pSocket->t_bNonBlocking)
+    {
+        if (networkSetNonBlocking(l_pClientSocket, true) != (int)NETWORK_OK ||
+            tlsEngineStartAccept((TLS_Engine*)l_pClientSocket->t_pTlsEngine, l_iClientFd,
+                                 (TLS_Engine*)p_pSocket->t_pTlsEngine) != TLS_OK)
+        {
+            X_LOG_TRACE("networkAccept: TLS handshake setup failed");
+            networkFreeEngine(l_pClientSocket->t_pTlsEngine);
+            close(l_iClientFd);
+            networkFreeSocket(l_pClientSocket);
+            return NULL;
+        }
+        l_pClientSocket->t_bHandshaking = true;
+        return l_pClientSocket;
+    }
+
     // Démarrer le handshake TLS
     int l_ulReturn = tlsEngineAccept(
         (TLS_Engine*)l_pClientSocket->t_pTlsEngine,
@@ -351,9 +532,9 @@ NetworkSocket *networkAccept(NetworkSocket *p_pSocket, NetworkAddress *p_pClient
     if (l_ulReturn != TLS_OK) 
     {
         X_LOG_TRACE("networkAccept: TLS handshake failed with error %d", l_ulReturn);
-        free(l_pClientSocket->t_pTlsEngine);
+        networkFreeEngine(l_pClientSocket->t_pTlsEngine);
         close(l_iClientFd);
-        free(l_pClientSocket);
+        networkFreeSocket(l_pClientSocket);
         return NULL;
     }
 
@@ -361,6 +542,53 @@ NetworkSocket *networkAccept(NetworkSocket *p_pSocket, NetworkAddress *p_pClient
     return l_pClientSocket;
 }
 
+////////////////////////////////////////////////////////////
+/// networkPrepareClientEngine
+////////////////////////////////////////////////////////////
+static int networkPrepareClientEngine(NetworkSocket *p_pSocket)
+{
+    // Ensure we're using client mode for the connection
+    TLS_Engine* tlsEngine = (TLS_Engine*)p_pSocket->t_pTlsEngine;
+    if (tlsEngine->t_ptContext && !tlsEngine->t_ptContext->t_bIsServer)
+    {
+        // A shared client context is used as configured
+        return NETWORK_OK;
+    }
+    bool l_bSessionResumption = tlsEngine->t_bSessionResumption;
+    tlsEngineCleanup(tlsEngine); // Release the context before recreating with client configuration
+    
+    // Recreate TLS configuration for client mode
+    TLS_Config clientConfig;
+    memset(&clientConfig, 0, sizeof(TLS_Config));
+    clientConfig.t_eTlsVersion = tlsEngine->t_eTlsVersion;
+    clientConfig.t_eEccCurve = tlsEngine->t_eEccCurve;
+    clientConfig.t_bIsServer = false; // Explicitly set to client mode
+    clientConfig.t_bSessionResumption = l_bSessionResumption;
+    
+    // Use appropriate cipher list
+    X_LOG_TRACE("networkConnect: Using cipher list: %s", clientConfig.cipherList);
+    
+    // Copy certificates from the original TLS engine
+    TLS_Engine* origEngine = (TLS_Engine*)p_pSocket->t_pTlsEngine;
+    clientConfig.t_cCaPath = NULL;  // Not needed for client connection
+    clientConfig.t_cCertPath = NULL;  // Not needed for client connection
+    clientConfig.t_cKeyPath = NULL;  // Not needed for client connection
+    
+    // Désactiver temporairement la vérification des certificats pour résoudre l'erreur ASN
+    clientConfig.t_bVerifyPeer = false;
+    X_LOG_TRACE("networkConnect: Peer verification temporarily disabled during handshake");
+    
+    // Reinitialize TLS engine with client configuration
+    int l_ulReturn = tlsEngineInit(tlsEngine, p_pSocket->t_iSocketFd, &clientConfig);
+    if (l_ulReturn != TLS_OK) 
+    {
+        X_LOG_TRACE("networkConnect: Failed to initialize TLS client mode");
+        return NETWORK_TLS_ERROR;
+    }
+
+    return NETWORK_OK;
+}
+
 ////////////////////////////////////////////////////////////
 /// networkConnect
 ////////////////////////////////////////////////////////////
@@ -390,65 +618,148 @@ int networkConnect(NetworkSocket *p_pSocket, const NetworkAddress *p_pAddress)
     }
 
     X_LOG_TRACE("networkConnect: Connecting to %s:%d", p_pAddress->t_cAddress, p_pAddress->t_usPort);
+    uint64_t l_ulStart = osTaskNowNs();
     if (connect(p_pSocket->t_iSocketFd, (struct sockaddr *)&l_tAddr, sizeof(l_tAddr)) < 0) 
     {
-        X_LOG_TRACE("networkConnect: TCP connection failed with error %d", errno);
+        if (errno != EINPROGRESS || !p_pSocket->t_bNonBlocking)
+        {
+            X_LOG_TRACE("networkConnect: TCP connection failed with error %d", errno);
+            p_pSocket->t_bConnected = false;
+            return NETWORK_ERROR;
+        }
+        p_pSocket->t_bConnecting = true;
+    }
+    else
+    {
+        p_pSocket->t_bConnected = true;
+    }
+
+    if (networkPrepareClientEngine(p_pSocket) != (int)NETWORK_OK)
+    {
         p_pSocket->t_bConnected = false;
-        return NETWORK_ERROR;
+        p_pSocket->t_bConnecting = false;
+        return NETWORK_TLS_ERROR;
     }
 
-    p_pSocket->t_bConnected = true;
+    // Non-blocking: the handshake is driven by networkConnectComplete
+    if (p_pSocket->t_bNonBlocking)
+    {
+        p_pSocket->t_bHandshaking = true;
+        return p_pSocket->t_bConnecting ? NETWORK_IN_PROGRESS : networkHandshake(p_pSocket);
+    }
 
     // Perform TLS handshake
     X_LOG_TRACE("networkConnect: Starting TLS handshake");
-    
-    // Ensure we're using client mode for the connection
-    TLS_Engine* tlsEngine = (TLS_Engine*)p_pSocket->t_pTlsEngine;
-    tlsEngine->t_bInitialised = false; // Reset to recreate with client configuration
-    
-    // Recreate TLS configuration for client mode
-    TLS_Config clientConfig;
-    memset(&clientConfig, 0, sizeof(TLS_Config));
-    clientConfig.t_eTlsVersion = tlsEngine->t_eTlsVersion;
-    clientConfig.t_eEccCurve = tlsEngine->t_eEccCurve;
-    clientConfig.t_bIsServer = false; // Explicitly set to client mode
-    
-    // Use appropriate cipher list
-    X_LOG_TRACE("networkConnect: Using cipher list: %s", clientConfig.cipherList);
-    
-    // Copy certificates from the original TLS engine
-    TLS_Engine* origEngine = (TLS_Engine*)p_pSocket->t_pTlsEngine;
-    clientConfig.t_cCaPath = NULL;  // Not needed for client connection
-    clientConfig.t_cCertPath = NULL;  // Not needed for client connection
-    clientConfig.t_cKeyPath = NULL;  // Not needed for client connection
-    
-    // Désactiver temporairement la vérification des certificats pour résoudre l'erreur ASN
-    clientConfig.t_bVerifyPeer = false;
-    X_LOG_TRACE("networkConnect: Peer verification temporarily disabled during handshake");
-    
-    // Reinitialize TLS engine with client configuration
-    int l_ulReturn = tlsEngineInit(tlsEngine, p_pSocket->t_iSocketFd, &clientConfig);
+    unsigned long l_ulReturn = tlsEngineConnect((TLS_Engine*)p_pSocket->t_pTlsEngine);
     if (l_ulReturn != TLS_OK) 
     {
-        X_LOG_TRACE("networkConnect: Failed to initialize TLS client mode");
+        X_LOG_TRACE("networkConnect: TLS handshake failed with error %lu", l_ulReturn);
         p_pSocket->t_bConnected = false;
         return NETWORK_TLS_ERROR;
     }
-    
-    // Now perform the TLS client handshake
-    l_ulReturn = tlsEngineConnect(tlsEngine);
-    if (l_ulReturn != TLS_OK) 
+
+    xMetricsObserve(s_ptMetricConnectNs, osTaskNowNs() - l_ulStart);
+    X_LOG_TRACE("networkConnect: TLS handshake successful");
+    return NETWORK_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// networkConnectComplete
+//////////////////////////////////
+int networkConnectComplete(NetworkSocket *p_pSocket)
+{
+    if (!p_pSocket || p_pSocket->t_iSocketFd < 0)
+        return NETWORK_INVALID_PARAM;
+
+    if (!p_pSocket->t_bConnecting)
+    {
+        if (p_pSocket->t_bHandshaking)
+            return networkHandshake(p_pSocket);
+        return p_pSocket->t_bConnected ? NETWORK_OK : NETWORK_ERROR;
+    }
+
+    int l_iError = 0;
+    socklen_t l_iLen = sizeof(l_iError);
+    if (getsockopt(p_pSocket->t_iSocketFd, SOL_SOCKET, SO_ERROR, &l_iError, &l_iLen) < 0)
+        l_iError = errno;
+
+    if (l_iError == EINPROGRESS || l_iError == EALREADY)
+        return NETWORK_IN_PROGRESS;
+
+    p_pSocket->t_bConnecting = false;
+    if (l_iError != 0)
+    {
+        p_pSocket->t_bHandshaking = false;
+        return NETWORK_ERROR;
+    }
+
+    p_pSocket->t_bConnected = true;
+    return p_pSocket->t_bHandshaking ? networkHandshake(p_pSocket) : NETWORK_OK;
+}
+
+//////////////////////////////////
+/// networkHandshake
+//////////////////////////////////
+int networkHandshake(NetworkSocket *p_pSocket)
+{
+    if (!p_pSocket || p_pSocket->t_iSocketFd < 0 || !p_pSocket->t_pTlsEngine)
+        return NETWORK_INVALID_PARAM;
+
+    if (!p_pSocket->t_bHandshaking)
+        return p_pSocket->t_bConnected ? NETWORK_OK : NETWORK_ERROR;
+
+    if (p_pSocket->t_bConnecting)
+        return NETWORK_IN_PROGRESS;
+
+    TLS_Engine *l_ptEngine = (TLS_Engine *)p_pSocket->t_pTlsEngine;
+    unsigned long l_ulReturn = TLS_OK;
+
+    mutexLock(&p_pSocket->t_Mutex);
+    // A client session is created once the TCP connection exists, for the session cache key
+    if (!l_ptEngine->t_SslSession)
+        l_ulReturn = tlsEngineStartConnect(l_ptEngine);
+    if (l_ulReturn == TLS_OK)
+        l_ulReturn = tlsEngineHandshake(l_ptEngine);
+    mutexUnlock(&p_pSocket->t_Mutex);
+
+    if (l_ulReturn == TLS_WANT_READ)
+        return NETWORK_WANT_READ;
+    if (l_ulReturn == TLS_WANT_WRITE)
+        return NETWORK_WANT_WRITE;
+
+    p_pSocket->t_bHandshaking = false;
+    if (l_ulReturn != TLS_OK)
     {
-        X_LOG_TRACE("networkConnect: TLS handshake failed with error %d", l_ulReturn);
+        X_LOG_TRACE("networkHandshake: TLS handshake failed on socket %d (%s)",
+                    p_pSocket->t_iSocketFd, tlsEngineGetErrorString((int)l_ulReturn));
         p_pSocket->t_bConnected = false;
         return NETWORK_TLS_ERROR;
     }
 
-    X_LOG_TRACE("networkConnect: TLS handshake successful");
     return NETWORK_OK;
 }
 
-////////////////////////////////////////////////////////////
+//////////////////////////////////
+/// networkSetNonBlocking
+//////////////////////////////////
+int networkSetNonBlocking(NetworkSocket *p_pSocket, bool p_bNonBlocking)
+{
+    if (!p_pSocket || p_pSocket->t_iSocketFd < 0)
+        return NETWORK_INVALID_PARAM;
+
+    int l_iFlags = fcntl(p_pSocket->t_iSocketFd, F_GETFL, 0);
+    if (l_iFlags < 0)
+        return NETWORK_ERROR;
+
+    l_iFlags = p_bNonBlocking ? (l_iFlags | O_NONBLOCK) : (l_iFlags & ~O_NONBLOCK);
+    if (fcntl(p_pSocket->t_iSocketFd, F_SETFL, l_iFlags) < 0)
+        return NETWORK_ERROR;
+
+    p_pSocket->t_bNonBlocking = p_bNonBlocking;
+    return NETWORK_OK;
+}
+
+//////////////////////////////////
 /// networkSend
 ////////////////////////////////////////////////////////////
 int networkSend(NetworkSocket *p_pSocket, const void *p_pBuffer, unsigned long p_ulSize)
@@ -474,7 +785,9 @@ int networkSend(NetworkSocket *p_pSocket, const void *p_pBuffer, unsigned long p
     
     X_LOG_TRACE("networkSend: Using TLS for send on socket %d, %lu bytes", 
                p_pSocket->t_iSocketFd, p_ulSize);
+    X_TRACE_BEGIN("net.send");
     result = tlsEngineSend((TLS_Engine*)p_pSocket->t_pTlsEngine, p_pBuffer, p_ulSize);
+    X_TRACE_END("net.send");
     if (result < 0) 
     {
         X_LOG_TRACE("networkSend: TLS send failed with error code %d", result);
@@ -517,7 +830,9 @@ int networkReceive(NetworkSocket *p_pSocket, void *p_pBuffer, unsigned long p_ul
     
     X_LOG_TRACE("Using TLS for receive on socket %d, buffer size %lu", 
                p_pSocket->t_iSocketFd, p_ulSize);
+    X_TRACE_BEGIN("net.receive");
     result = tlsEngineReceive((TLS_Engine*)p_pSocket->t_pTlsEngine, p_pBuffer, p_ulSize);
+    X_TRACE_END("net.receive");
     if (result < 0) 
     {
         X_LOG_TRACE("TLS receive failed with error code %d", result);
@@ -538,6 +853,36 @@ int networkReceive(NetworkSocket *p_pSocket, void *p_pBuffer, unsigned long p_ul
     return result;
 }
 
+////////////////////////////////////////////////////////////
+/// networkSetCork
+////////////////////////////////////////////////////////////
+int networkSetCork(NetworkSocket *p_pSocket, bool p_bCorked)
+{
+    if (!p_pSocket || !p_pSocket->t_pTlsEngine)
+        return NETWORK_INVALID_PARAM;
+
+    mutexLock(&p_pSocket->t_Mutex);
+    unsigned long l_ulReturn = tlsEngineSetCork((TLS_Engine*)p_pSocket->t_pTlsEngine, p_bCorked);
+    mutexUnlock(&p_pSocket->t_Mutex);
+
+    return (l_ulReturn == TLS_OK) ? NETWORK_OK : NETWORK_TLS_ERROR;
+}
+
+////////////////////////////////////////////////////////////
+/// networkFlush
+////////////////////////////////////////////////////////////
+int networkFlush(NetworkSocket *p_pSocket)
+{
+    if (!p_pSocket || !p_pSocket->t_pTlsEngine)
+        return NETWORK_INVALID_PARAM;
+
+    mutexLock(&p_pSocket->t_Mutex);
+    unsigned long l_ulReturn = tlsEngineFlush((TLS_Engine*)p_pSocket->t_pTlsEngine);
+    mutexUnlock(&p_pSocket->t_Mutex);
+
+    return (l_ulReturn == TLS_OK) ? NETWORK_OK : NETWORK_TLS_ERROR;
+}
+
 ////////////////////////////////////////////////////////////
 /// networkCloseSocket
 ////////////////////////////////////////////////////////////
@@ -561,10 +906,12 @@ int networkCloseSocket(NetworkSocket *p_pSocket)
         tlsEngineCleanup((TLS_Engine*)p_pSocket->t_pTlsEngine);
         
         // Free the TLS engine memory
-        free(p_pSocket->t_pTlsEngine);
+        networkFreeEngine(p_pSocket->t_pTlsEngine);
         p_pSocket->t_pTlsEngine = NULL;
     }
 
+    networkFrameRelease(p_pSocket);
+
     if (p_pSocket->t_iSocketFd >= 0) 
     {
         X_LOG_TRACE("networkCloseSocket: Closing socket %d", p_pSocket->t_iSocketFd);
@@ -578,7 +925,7 @@ int networkCloseSocket(NetworkSocket *p_pSocket)
     mutexDestroy(&p_pSocket->t_Mutex);
     
     // Free the socket structure
-    free(p_pSocket);
+    networkFreeSocket(p_pSocket);
 
     return NETWORK_OK;
 }
@@ -620,6 +967,10 @@ int networkWaitForActivity(NetworkSocket *p_pSocket, int p_iTimeoutMs)
         return NETWORK_INVALID_PARAM;
     }
 
+    // Records already read from the socket would not wake select
+    if (p_pSocket->t_pTlsEngine && tlsEngineHasPendingData((TLS_Engine*)p_pSocket->t_pTlsEngine))
+        return 1;
+
     fd_set l_tReadSet;
     FD_ZERO(&l_tReadSet);
     FD_SET(p_pSocket->t_iSocketFd, &l_tReadSet);
@@ -665,6 +1016,16 @@ const char *networkGetErrorString(int p_iError)
         return "Operation timed out";
     case NETWORK_INVALID_PARAM:
         return "Invalid parameter";
+    case NETWORK_WOULD_BLOCK:
+        return "Operation would block";
+    case NETWORK_IN_PROGRESS:
+        return "Connection in progress";
+    case NETWORK_CLOSED:
+        return "Connection closed by peer";
+    case NETWORK_WANT_READ:
+        return "Handshake waiting for data";
+    case NETWORK_WANT_WRITE:
+        return "Handshake waiting for send space";
     case NETWORK_TLS_ERROR:
         return "TLS security error";
     default:
@@ -694,6 +1055,17 @@ int networkGetSecurityInfo(NetworkSocket *p_pSocket, char *p_pCipherName, unsign
     return tlsEngineGetConnectionInfo((TLS_Engine*)p_pSocket->t_pTlsEngine, p_pCipherName, p_ulSize);
 }
 
+////////////////////////////////////////////////////////////
+/// networkIsSessionResumed
+////////////////////////////////////////////////////////////
+bool networkIsSessionResumed(NetworkSocket *p_pSocket)
+{
+    if (!p_pSocket || !p_pSocket->t_pTlsEngine)
+        return false;
+
+    return tlsEngineIsSessionResumed((TLS_Engine*)p_pSocket->t_pTlsEngine);
+}
+
 ////////////////////////////////////////////////////////////
 /// networkSecureAccept
 ////////////////////////////////////////////////////////////
@@ -716,6 +1088,7 @@ NetworkSocket *networkSecureAccept(NetworkSocket *p_pServerSocket, NetworkAddres
         X_LOG_TRACE("networkSecureAccept: accept() failed with error %d", errno);
         return NULL;
     }
+    xMetricsInc(s_ptMetricAccepted);
 
     // Store client address if requested
     if (p_pClientAddress) 
@@ -729,7 +1102,7 @@ NetworkSocket *networkSecureAccept(NetworkSocket *p_pServerSocket, NetworkAddres
                p_pClientAddress ? p_pClientAddress->t_usPort : 0);
 
     // Allocate socket for the new connection
-    NetworkSocket *l_pClientSocket = (NetworkSocket *)malloc(sizeof(NetworkSocket));
+    NetworkSocket *l_pClientSocket = networkAllocSocket();
     if (!l_pClientSocket) 
     {
         X_LOG_TRACE("networkSecureAccept: Failed to allocate memory for client socket");
@@ -741,17 +1114,21 @@ NetworkSocket *networkSecureAccept(NetworkSocket *p_pServerSocket, NetworkAddres
     l_pClientSocket->t_iSocketFd = l_iClientFd;
     l_pClientSocket->t_iType = NETWORK_SOCK_TCP;
     l_pClientSocket->t_bConnected = true;
+    l_pClientSocket->t_bNonBlocking = false;
+    l_pClientSocket->t_bConnecting = false;
+    l_pClientSocket->t_bHandshaking = false;
+    l_pClientSocket->t_ptFrameBuffer = NULL;
     
     // Initialize the mutex for thread safety
     mutexCreate(&l_pClientSocket->t_Mutex);
 
     // Allocate TLS engine for the client socket
-    l_pClientSocket->t_pTlsEngine = malloc(sizeof(TLS_Engine));
+    l_pClientSocket->t_pTlsEngine = networkAllocEngine();
     if (!l_pClientSocket->t_pTlsEngine) 
     {
         X_LOG_TRACE("networkSecureAccept: Failed to allocate memory for TLS engine");
         close(l_iClientFd);
-        free(l_pClientSocket);
+        networkFreeSocket(l_pClientSocket);
         return NULL;
     }
 
@@ -818,7 +1195,20 @@ int networkSecureConnect(NetworkSocket *p_pSocket, const NetworkAddress *p_pAddr
     
     // Ensure we're using client mode for the connection
     TLS_Engine* tlsEngine = (TLS_Engine*)p_pSocket->t_pTlsEngine;
-    tlsEngine->t_bInitialised = false; // Reset to recreate with client configuration
+    if (tlsEngine->t_ptContext && !tlsEngine->t_ptContext->t_bIsServer)
+    {
+        // A shared client context is used as configured
+        unsigned long l_ulHandshake = tlsEngineConnect(tlsEngine);
+        if (l_ulHandshake != TLS_OK) 
+        {
+            X_LOG_TRACE("TLS handshake failed with error %lu", l_ulHandshake);
+            p_pSocket->t_bConnected = false;
+            return NETWORK_TLS_ERROR;
+        }
+        return NETWORK_OK;
+    }
+    bool l_bSessionResumption = tlsEngine->t_bSessionResumption;
+    tlsEngineCleanup(tlsEngine); // Release the context before recreating with client configuration
     
     // Recreate TLS configuration for client mode
     TLS_Config clientConfig;
@@ -826,6 +1216,7 @@ int networkSecureConnect(NetworkSocket *p_pSocket, const NetworkAddress *p_pAddr
     clientConfig.t_eTlsVersion = tlsEngine->t_eTlsVersion;
     clientConfig.t_eEccCurve = tlsEngine->t_eEccCurve;
     clientConfig.t_bIsServer = false; // Explicitly set to client mode
+    clientConfig.t_bSessionResumption = l_bSessionResumption;
     
     // Use appropriate cipher list
     X_LOG_TRACE("networkSecureConnect: Using cipher list: %s", clientConfig.cipherList);
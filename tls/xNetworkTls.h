@@ -46,6 +46,11 @@
 #define NETWORK_TIMEOUT 0xE8C74D62
 #define NETWORK_INVALID_PARAM 0xE8C74D63
 #define NETWORK_TLS_ERROR 0xE8C74D64
+#define NETWORK_WOULD_BLOCK 0xE8C74D65 // Non-blocking socket not ready, retry when the loop reports it
+#define NETWORK_IN_PROGRESS 0xE8C74D66 // Non-blocking connect started, see networkConnectComplete
+#define NETWORK_CLOSED 0xE8C74D67      // Peer closed the connection (framed messages)
+#define NETWORK_WANT_READ 0xE8C74D68   // TLS handshake waits for readability, see networkHandshake
+#define NETWORK_WANT_WRITE 0xE8C74D69  // TLS handshake waits for writability, see networkHandshake
 
 // Byte order conversion macros
 #define HOST_TO_NET_LONG(p_uiValue) htonl(p_uiValue)
@@ -53,6 +58,9 @@
 #define NET_TO_HOST_LONG(p_uiValue) ntohl(p_uiValue)
 #define NET_TO_HOST_SHORT(p_usValue) ntohs(p_usValue)
 
+// Framed message receive buffer, see xNetworkFrame.h
+struct xos_network_frame_buffer_t;
+
 // Secure Socket type definition
 typedef struct NetworkSocket_t
 {
@@ -60,6 +68,10 @@ typedef struct NetworkSocket_t
     int t_iType;         // Socket type (TCP/UDP)
     bool t_bConnected;   // Connection state
     void *t_pTlsEngine;  // TLS context (always present)
+    bool t_bNonBlocking; // O_NONBLOCK set on the descriptor
+    bool t_bConnecting;  // Non-blocking TCP connect in progress
+    bool t_bHandshaking; // Non-blocking TLS handshake in progress
+    struct xos_network_frame_buffer_t *t_ptFrameBuffer; // Framed receive buffer, allocated on first use
     xOsMutexCtx t_Mutex; // Mutex for thread safety
 } NetworkSocket;
 
@@ -70,6 +82,9 @@ typedef struct
     unsigned short t_usPort;
 } NetworkAddress;
 
+// Socket tuning options, see xNetworkOptions.h
+struct NetworkSocketOptions_t;
+
 // TLS configuration for network sockets (always required)
 typedef struct
 {
@@ -79,6 +94,11 @@ typedef struct
     const char *t_cKeyPath;  // Path to private key
     TLS_Version t_eVersion;  // TLS version (defaults to TLS 1.3)
     TLS_ECC_Curve t_eCurve;  // ECC curve to use
+    const struct NetworkSocketOptions_t *t_ptOptions; // Applied at creation (NULL for kernel defaults)
+    bool t_bSessionResumption;          // Resume previous sessions on reconnect (session cache, TLS 1.3 tickets)
+    unsigned int t_uiSessionLifetimeSec; // Server session lifetime (0 for TLS_SESSION_DEFAULT_LIFETIME)
+    TLS_Context *t_ptContext;           // Shared context from networkCreateTlsContext, the fields above are then
+                                        // ignored (NULL to load the files for this socket only)
 } NetworkTlsConfig;
 
 // Available socket types
@@ -89,6 +109,22 @@ typedef struct
 /// Core API functions - All communications use TLS
 //////////////////////////////////
 
+//////////////////////////////////
+/// @brief Create a TLS context shared by several sockets
+/// @param p_pTlsConfig TLS configuration (t_ptContext must be NULL)
+/// @return TLS_Context* Context or NULL on error
+/// @note certificates and key are read and parsed once here, sockets
+///       created with it in t_ptContext do no file or PEM work
+//////////////////////////////////
+TLS_Context *networkCreateTlsContext(const NetworkTlsConfig *p_pTlsConfig);
+
+//////////////////////////////////
+/// @brief Release the caller reference on a shared TLS context
+/// @param p_ptContext Context from networkCreateTlsContext
+/// @note sockets still using the context keep it alive until they close
+//////////////////////////////////
+void networkReleaseTlsContext(TLS_Context *p_ptContext);
+
 //////////////////////////////////
 /// @brief Create a secure socket with TLS support
 /// @param p_pTlsConfig TLS configuration
@@ -125,6 +161,8 @@ int networkListen(NetworkSocket *p_pSocket, int p_iBacklog);
 /// @param p_pSocket Listening socket
 /// @param p_pClientAddress Address to store client info (can be NULL)
 /// @return NetworkSocket* New socket handle or NULL on error
+/// @note on a non-blocking listener the socket is returned non-blocking with its
+///       handshake pending, to be driven by networkHandshake
 //////////////////////////////////
 NetworkSocket *networkAccept(NetworkSocket *p_pSocket, NetworkAddress *p_pClientAddress);
 
@@ -132,10 +170,35 @@ NetworkSocket *networkAccept(NetworkSocket *p_pSocket, NetworkAddress *p_pClient
 /// @brief Connect to remote secure server
 /// @param p_pSocket Socket handle
 /// @param p_pAddress Remote address
-/// @return int Error code
+/// @return int Error code, on a non-blocking socket NETWORK_IN_PROGRESS, NETWORK_WANT_READ
+///         or NETWORK_WANT_WRITE until networkConnectComplete returns NETWORK_OK
 //////////////////////////////////
 int networkConnect(NetworkSocket *p_pSocket, const NetworkAddress *p_pAddress);
 
+//////////////////////////////////
+/// @brief Advance a non-blocking connect once the socket is ready
+/// @param p_pSocket Socket handle
+/// @return int NETWORK_OK, NETWORK_IN_PROGRESS (TCP), NETWORK_WANT_READ or
+///         NETWORK_WANT_WRITE (TLS handshake), or error code
+//////////////////////////////////
+int networkConnectComplete(NetworkSocket *p_pSocket);
+
+//////////////////////////////////
+/// @brief Advance a non-blocking TLS handshake
+/// @param p_pSocket Socket handle from a non-blocking networkConnect or networkAccept
+/// @return int NETWORK_OK when secured, NETWORK_WANT_READ or NETWORK_WANT_WRITE
+///         to call again once the socket is ready, or error code
+//////////////////////////////////
+int networkHandshake(NetworkSocket *p_pSocket);
+
+//////////////////////////////////
+/// @brief Switch a socket between blocking and non-blocking mode
+/// @param p_pSocket Socket handle
+/// @param p_bNonBlocking true for non-blocking
+/// @return int Error code
+//////////////////////////////////
+int networkSetNonBlocking(NetworkSocket *p_pSocket, bool p_bNonBlocking);
+
 //////////////////////////////////
 /// @brief Send data securely
 /// @param p_pSocket Socket handle
@@ -154,6 +217,23 @@ int networkSend(NetworkSocket *p_pSocket, const void *p_pBuffer, unsigned long p
 //////////////////////////////////
 int networkReceive(NetworkSocket *p_pSocket, void *p_pBuffer, unsigned long p_ulSize);
 
+//////////////////////////////////
+/// @brief Coalesce small sends into full TLS records
+/// @param p_pSocket Socket handle
+/// @param p_bCorked true to hold sends until a record fills or networkFlush,
+///                  false to flush and send through again
+/// @return int Error code
+/// @note a receive flushes first, so request/response exchanges need no explicit flush
+//////////////////////////////////
+int networkSetCork(NetworkSocket *p_pSocket, bool p_bCorked);
+
+//////////////////////////////////
+/// @brief Send the data held by the cork
+/// @param p_pSocket Socket handle
+/// @return int Error code
+//////////////////////////////////
+int networkFlush(NetworkSocket *p_pSocket);
+
 //////////////////////////////////
 /// @brief Close secure socket
 /// @param p_pSocket Socket handle
@@ -175,6 +255,7 @@ int networkSetTimeout(NetworkSocket *p_pSocket, int p_iTimeoutMs, bool p_bSendTi
 /// @param p_pSocket Socket handle
 /// @param p_iTimeoutMs Timeout in milliseconds (-1 for infinite)
 /// @return int 1 if ready, 0 if timeout, negative for error
+/// @note returns 1 at once while received records are buffered by the TLS engine
 //////////////////////////////////
 int networkWaitForActivity(NetworkSocket *p_pSocket, int p_iTimeoutMs);
 
@@ -201,6 +282,13 @@ bool networkIsConnected(NetworkSocket *p_pSocket);
 //////////////////////////////////
 int networkGetSecurityInfo(NetworkSocket *p_pSocket, char *p_pCipherName, unsigned long p_ulSize);
 
+//////////////////////////////////
+/// @brief Check if the TLS handshake resumed a previous session
+/// @param p_pSocket Socket handle
+/// @return bool True if resumed, false after a full handshake
+//////////////////////////////////
+bool networkIsSessionResumed(NetworkSocket *p_pSocket);
+
 #endif // USE_TLS
 
 #endif // NETWORK_TLS_H_
@@ -0,0 +1,359 @@
+////////////////////////////////////////////////////////////
+//  xLogDecode.c
+//  Host decoder for binary xLog files
+//
+// Usage: xLogDecode <file.bin> [-t]
+// Prints every committed record in the text layout of xLogWrite:
+// "timestamp | file:line | message", -t adds the thread id after
+// the location. The file may still be open on the target, decoding
+// stops at the first record not committed yet
+//
+// general discloser: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "xLogBinary.h"
+
+#define DECODE_MSG_SIZE 4096
+
+// Format record kept by id
+typedef struct
+{
+    char* t_pcFile;                 // Base name of the source file
+    char* t_pcFormat;               // Format string
+    uint32_t t_ulLine;              // Line number
+} t_decodeFormat;
+
+static t_decodeFormat* s_ptFormats = NULL;
+static uint32_t s_ulFormatCount = 0;
+
+//
+// Stores a format record
+//
+static int decodeAddFormat(uint32_t p_ulId, const uint8_t* p_pucPayload, uint32_t p_ulSize)
+{
+    t_logBinFormat l_tFormat;
+    if (p_ulSize < sizeof(l_tFormat))
+    {
+        return -1;
+    }
+    memcpy(&l_tFormat, p_pucPayload, sizeof(l_tFormat));
+    if (sizeof(l_tFormat) + l_tFormat.t_usFileLength + l_tFormat.t_usFormatLength > p_ulSize)
+    {
+        return -1;
+    }
+
+    if (p_ulId >= s_ulFormatCount)
+    {
+        uint32_t l_ulCount = (p_ulId + 1) * 2;
+        t_decodeFormat* l_ptFormats = realloc(s_ptFormats, sizeof(t_decodeFormat) * l_ulCount);
+        if (l_ptFormats == NULL)
+        {
+            return -1;
+        }
+        memset(l_ptFormats + s_ulFormatCount, 0, sizeof(t_decodeFormat) * (l_ulCount - s_ulFormatCount));
+        s_ptFormats = l_ptFormats;
+        s_ulFormatCount = l_ulCount;
+    }
+
+    const char* l_pcFile = (const char*)p_pucPayload + sizeof(l_tFormat);
+    const char* l_pcFormat = l_pcFile + l_tFormat.t_usFileLength;
+    t_decodeFormat* l_ptEntry = &s_ptFormats[p_ulId];
+
+    // Same base name extraction as the text logger
+    size_t l_ulStart = 0;
+    for (size_t i = 0; i < l_tFormat.t_usFileLength; i++)
+    {
+        if (l_pcFile[i] == '/' || l_pcFile[i] == '\\')
+        {
+            l_ulStart = i + 1;
+        }
+    }
+
+    free(l_ptEntry->t_pcFile);
+    free(l_ptEntry->t_pcFormat);
+    l_ptEntry->t_pcFile = strndup(l_pcFile + l_ulStart, l_tFormat.t_usFileLength - l_ulStart);
+    l_ptEntry->t_pcFormat = strndup(l_pcFormat, l_tFormat.t_usFormatLength);
+    l_ptEntry->t_ulLine = l_tFormat.t_ulLine;
+    return (l_ptEntry->t_pcFile != NULL && l_ptEntry->t_pcFormat != NULL) ? 0 : -1;
+}
+
+//
+// Reads the next fixed size argument, false when the payload is exhausted
+//
+static bool decodeRead(const uint8_t** p_ppucCur, const uint8_t* p_pucEnd, void* p_ptOut, size_t p_ulSize)
+{
+    if ((size_t)(p_pucEnd - *p_ppucCur) < p_ulSize)
+    {
+        return false;
+    }
+    memcpy(p_ptOut, *p_ppucCur, p_ulSize);
+    *p_ppucCur += p_ulSize;
+    return true;
+}
+
+//
+// Rebuilds the message of a record, one conversion at a time
+//
+static void decodeMessage(const char* p_pcFormat, const uint8_t* p_pucArgs, uint32_t p_ulSize, char* p_pcOut, size_t p_ulOutSize)
+{
+    const uint8_t* l_pucCur = p_pucArgs;
+    const uint8_t* l_pucEnd = p_pucArgs + p_ulSize;
+    const char* l_pcText = p_pcFormat;
+    size_t l_ulLen = 0;
+    t_logBinSpec l_tSpec;
+
+#define DECODE_APPEND(...) \
+    do { \
+        int l_iN = snprintf(p_pcOut + l_ulLen, p_ulOutSize - l_ulLen, __VA_ARGS__); \
+        if (l_iN > 0) l_ulLen += ((size_t)l_iN < p_ulOutSize - l_ulLen) ? (size_t)l_iN : p_ulOutSize - l_ulLen - 1; \
+    } while (0)
+
+    while (xLogBinaryNextSpec(l_pcText, &l_tSpec))
+    {
+        DECODE_APPEND("%.*s", (int)(l_tSpec.t_pcStart - l_pcText), l_pcText);
+        l_pcText = l_tSpec.t_pcEnd;
+
+        if (l_tSpec.t_eKind == XOS_LOG_BIN_VA_NONE)
+        {
+            if (l_tSpec.t_cConversion == '%')
+            {
+                DECODE_APPEND("%%");
+            }
+            else
+            {
+                DECODE_APPEND("%.*s", (int)(l_tSpec.t_pcEnd - l_tSpec.t_pcStart), l_tSpec.t_pcStart);
+            }
+            continue;
+        }
+
+        // Flags, width and precision with '*' resolved, the length modifier is replaced
+        char l_cSpec[64];
+        size_t l_ulSpec = 0;
+        bool l_bMissing = false;
+        for (const char* p = l_tSpec.t_pcStart; p < l_tSpec.t_pcEnd - 1 && l_ulSpec < sizeof(l_cSpec) - 16; p++)
+        {
+            if (*p == '*')
+            {
+                int32_t l_iStar = 0;
+                l_bMissing |= !decodeRead(&l_pucCur, l_pucEnd, &l_iStar, sizeof(l_iStar));
+                l_ulSpec += (size_t)snprintf(l_cSpec + l_ulSpec, sizeof(l_cSpec) - l_ulSpec, "%d", l_iStar);
+            }
+            else if (strchr("hlLqjzt", *p) == NULL)
+            {
+                l_cSpec[l_ulSpec++] = *p;
+            }
+        }
+
+        char l_cConv = l_tSpec.t_cConversion;
+        int32_t l_iValue = 0;
+        uint64_t l_ulValue = 0;
+        double l_dValue = 0.0;
+        uint16_t l_usLength = 0;
+
+        switch (l_tSpec.t_eKind)
+        {
+            case XOS_LOG_BIN_VA_INT:
+                l_bMissing |= !decodeRead(&l_pucCur, l_pucEnd, &l_iValue, sizeof(l_iValue));
+                if (l_bMissing)
+                {
+                    break;
+                }
+                if (l_cConv == 'c' || l_cConv == 'd' || l_cConv == 'i')
+                {
+                    snprintf(l_cSpec + l_ulSpec, sizeof(l_cSpec) - l_ulSpec, "%c", l_cConv);
+                    DECODE_APPEND(l_cSpec, (int)l_iValue);
+                }
+                else
+                {
+                    snprintf(l_cSpec + l_ulSpec, sizeof(l_cSpec) - l_ulSpec, "%c", l_cConv);
+                    DECODE_APPEND(l_cSpec, (unsigned int)l_iValue);
+                }
+                break;
+            case XOS_LOG_BIN_VA_DOUBLE:
+            case XOS_LOG_BIN_VA_LDOUBLE:
+                l_bMissing |= !decodeRead(&l_pucCur, l_pucEnd, &l_dValue, sizeof(l_dValue));
+                if (!l_bMissing)
+                {
+                    snprintf(l_cSpec + l_ulSpec, sizeof(l_cSpec) - l_ulSpec, "%c", l_cConv);
+                    DECODE_APPEND(l_cSpec, l_dValue);
+                }
+                break;
+            case XOS_LOG_BIN_VA_STRING:
+                l_bMissing |= !decodeRead(&l_pucCur, l_pucEnd, &l_usLength, sizeof(l_usLength));
+                if (!l_bMissing && (size_t)(l_pucEnd - l_pucCur) >= l_usLength)
+                {
+                    char* l_pcString = strndup((const char*)l_pucCur, l_usLength);
+                    l_pucCur += l_usLength;
+                    snprintf(l_cSpec + l_ulSpec, sizeof(l_cSpec) - l_ulSpec, "s");
+                    DECODE_APPEND(l_cSpec, (l_pcString != NULL) ? l_pcString : "");
+                    free(l_pcString);
+                }
+                else
+                {
+                    l_bMissing = true;
+                }
+                break;
+            case XOS_LOG_BIN_VA_POINTER:
+                l_bMissing |= !decodeRead(&l_pucCur, l_pucEnd, &l_ulValue, sizeof(l_ulValue));
+                if (!l_bMissing && l_cConv == 'p')
+                {
+                    snprintf(l_cSpec + l_ulSpec, sizeof(l_cSpec) - l_ulSpec, "p");
+                    DECODE_APPEND(l_cSpec, (void*)(uintptr_t)l_ulValue);
+                }
+                break;
+            default:
+                l_bMissing |= !decodeRead(&l_pucCur, l_pucEnd, &l_ulValue, sizeof(l_ulValue));
+                if (!l_bMissing)
+                {
+                    snprintf(l_cSpec + l_ulSpec, sizeof(l_cSpec) - l_ulSpec, "ll%c", l_cConv);
+                    if (l_cConv == 'd' || l_cConv == 'i')
+                    {
+                        DECODE_APPEND(l_cSpec, (long long)l_ulValue);
+                    }
+                    else
+                    {
+                        DECODE_APPEND(l_cSpec, (unsigned long long)l_ulValue);
+                    }
+                }
+                break;
+        }
+
+        // Arguments past XOS_LOG_BIN_MAX_ARGS were not recorded
+        if (l_bMissing)
+        {
+            DECODE_APPEND("%.*s", (int)(l_tSpec.t_pcEnd - l_tSpec.t_pcStart), l_tSpec.t_pcStart);
+        }
+    }
+    DECODE_APPEND("%s", l_pcText);
+
+#undef DECODE_APPEND
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s <file.bin> [-t]\n", argv[0]);
+        return 1;
+    }
+    bool l_bThreadId = (argc > 2 && strcmp(argv[2], "-t") == 0);
+
+    int l_iFd = open(argv[1], O_RDONLY);
+    struct stat l_tStat;
+    if (l_iFd < 0 || fstat(l_iFd, &l_tStat) != 0)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+    if ((size_t)l_tStat.st_size < sizeof(t_logBinHeader))
+    {
+        fprintf(stderr, "%s: file too small\n", argv[1]);
+        return 1;
+    }
+
+    const uint8_t* l_pucBase = mmap(NULL, (size_t)l_tStat.st_size, PROT_READ, MAP_SHARED, l_iFd, 0);
+    if (l_pucBase == MAP_FAILED)
+    {
+        perror("mmap");
+        return 1;
+    }
+
+    t_logBinHeader l_tHeader;
+    memcpy(&l_tHeader, l_pucBase, sizeof(l_tHeader));
+    if (memcmp(l_tHeader.t_cMagic, XOS_LOG_BIN_MAGIC, sizeof(l_tHeader.t_cMagic)) != 0 ||
+        l_tHeader.t_ulVersion != XOS_LOG_BIN_VERSION)
+    {
+        fprintf(stderr, "%s: not a binary xLog file (version %u expected)\n", argv[1], XOS_LOG_BIN_VERSION);
+        return 1;
+    }
+
+    const uint8_t* l_pucEnd = l_pucBase + l_tStat.st_size;
+    const uint8_t* l_pucCur = l_pucBase + ((l_tHeader.t_ulHeaderSize + 7U) & ~7U);
+    char l_cMessage[DECODE_MSG_SIZE];
+    unsigned long l_ulRecords = 0;
+    unsigned long l_ulUnknown = 0;
+
+    while ((size_t)(l_pucEnd - l_pucCur) >= sizeof(t_logBinRecord))
+    {
+        t_logBinRecord l_tRecord;
+        memcpy(&l_tRecord, l_pucCur, sizeof(l_tRecord));
+        if ((l_tRecord.t_ulCommit & 0xFF000000U) != XOS_LOG_BIN_COMMIT_MAGIC ||
+            sizeof(l_tRecord) + (uint64_t)l_tRecord.t_ulPayloadSize > (uint64_t)(l_pucEnd - l_pucCur))
+        {
+            break;
+        }
+
+        const uint8_t* l_pucPayload = l_pucCur + sizeof(l_tRecord);
+        uint32_t l_ulType = l_tRecord.t_ulCommit & 0xFFU;
+        l_pucCur += (sizeof(l_tRecord) + l_tRecord.t_ulPayloadSize + 7U) & ~(size_t)7U;
+
+        if (l_ulType == XOS_LOG_BIN_RECORD_FORMAT)
+        {
+            if (decodeAddFormat(l_tRecord.t_ulFormatId, l_pucPayload, l_tRecord.t_ulPayloadSize) != 0)
+            {
+                fprintf(stderr, "invalid format record %u\n", l_tRecord.t_ulFormatId);
+            }
+            continue;
+        }
+        if (l_ulType != XOS_LOG_BIN_RECORD_MESSAGE)
+        {
+            continue;
+        }
+
+        if (l_tRecord.t_ulFormatId >= s_ulFormatCount || s_ptFormats[l_tRecord.t_ulFormatId].t_pcFormat == NULL)
+        {
+            l_ulUnknown++;
+            continue;
+        }
+        t_decodeFormat* l_ptFormat = &s_ptFormats[l_tRecord.t_ulFormatId];
+
+        // Target local time, whatever the host time zone
+        int64_t l_lWallNs = (int64_t)l_tHeader.t_ulRealtimeBaseNs +
+                            (int64_t)(l_tRecord.t_ulTimestampNs - l_tHeader.t_ulMonotonicBaseNs);
+        time_t l_tSec = (time_t)(l_lWallNs / 1000000000LL) + l_tHeader.t_iUtcOffsetSec;
+        struct tm l_tTm;
+        char l_cTime[32] = "UnknownTime";
+        if (gmtime_r(&l_tSec, &l_tTm) != NULL)
+        {
+            size_t l_ulTimeLen = strftime(l_cTime, sizeof(l_cTime), "%Y-%m-%d %H:%M:%S", &l_tTm);
+            snprintf(l_cTime + l_ulTimeLen, sizeof(l_cTime) - l_ulTimeLen, ".%03lld",
+                     (long long)(l_lWallNs % 1000000000LL) / 1000000LL);
+        }
+
+        decodeMessage(l_ptFormat->t_pcFormat, l_pucPayload, l_tRecord.t_ulPayloadSize, l_cMessage, sizeof(l_cMessage));
+        if (l_bThreadId)
+        {
+            printf("%s | %s:%u | %u | %s\n", l_cTime, l_ptFormat->t_pcFile, l_ptFormat->t_ulLine,
+                   l_tRecord.t_ulThreadId, l_cMessage);
+        }
+        else
+        {
+            printf("%s | %s:%u | %s\n", l_cTime, l_ptFormat->t_pcFile, l_ptFormat->t_ulLine, l_cMessage);
+        }
+        l_ulRecords++;
+    }
+
+    if (l_ulUnknown > 0)
+    {
+        fprintf(stderr, "%lu records with an unknown format id\n", l_ulUnknown);
+    }
+
+    for (uint32_t i = 0; i < s_ulFormatCount; i++)
+    {
+        free(s_ptFormats[i].t_pcFile);
+        free(s_ptFormats[i].t_pcFormat);
+    }
+    free(s_ptFormats);
+    munmap((void*)l_pucBase, (size_t)l_tStat.st_size);
+    close(l_iFd);
+    return 0;
+}
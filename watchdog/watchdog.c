@@ -1,8 +1,9 @@
 ////////////////////////////////////////////////////////////
 //  Watchdog src file
-//  Provides watchdog support using POSIX timer
+//  Provides a multi-client software watchdog
 //
 // Written : 02/05/2025
+// Modified: 14/10/2026 - Multi-client supervisor on the timer service
 ////////////////////////////////////////////////////////////
 
 
@@ -10,296 +11,455 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <string.h>
-#include <time.h>
-#include <signal.h>
 #include <errno.h>
-#include <sys/time.h>
-#include <sys/types.h>
-#include <sys/signal.h>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <linux/watchdog.h>
 
 #include "watchdog.h"
 #include "xLog.h"
 #include "xOsMutex.h"
+#include "xTask.h"
+#include "xMetrics.h"
 
 // Global variables
 static watchdog_t g_watchdog;
-static int g_is_initialized = 0;
+static watchdog_client_t *g_default_client = NULL;
+static int g_owns_supervisor = 0;
 static void (*g_expiry_handler)(void) = NULL;
-
-// Private variables for POSIX timers
-static timer_t g_timer_id;
-static struct sigevent g_sev;
-static struct itimerspec g_its;
-
-////////////////////////////////////////////////////////////
-/// watchdog_thread
-////////////////////////////////////////////////////////////
-void* watchdog_thread(void *arg)
-{
-   watchdog_t *watchdog = (watchdog_t *)arg;
-   int l_iRet = 0;
-   
-   if (!watchdog) {
-       X_LOG_TRACE("Watchdog thread started with NULL context");
-       return NULL;
-   }
-   
-   X_LOG_TRACE("Watchdog thread started");
-   
-   // Main thread loop
-   while (!watchdog->terminate) {
-       // Ping the watchdog to reset the timer
-       l_iRet = watchdog_ping();
-       if (l_iRet != 0) {
-           X_LOG_TRACE("Watchdog ping failed in thread");
-       }
-       
-       // Wait some time before the next ping
-       // Use about 1/3 of the timeout to ensure multiple pings before expiration
-       usleep((watchdog->timeout / 3) * 1000);
-   }
-   
-   X_LOG_TRACE("Watchdog thread terminated normally");
-   return NULL;
-}
+static xMetric_t *g_expirations_metric = NULL;
+static __thread int g_in_handler = 0;
 
 ////////////////////////////////////////////////////////////
-/// timer_handler
+/// watchdog_check
 ////////////////////////////////////////////////////////////
-static void timer_handler(union sigval sv)
+static void watchdog_check(void *arg)
 {
-    watchdog_t *watchdog = (watchdog_t *)sv.sival_ptr;
-    if (!watchdog) {
-        X_LOG_TRACE("Timer handler called with NULL context");
+    watchdog_t *watchdog = (watchdog_t *)arg;
+    watchdog_client_t *expired[WATCHDOG_MAX_CLIENTS];
+    uint32_t expired_generation[WATCHDOG_MAX_CLIENTS];
+    int expired_count = 0;
+    bool healthy = true;
+    uint64_t now = osTaskNowNs();
+
+    // The mutex only keeps registrations out of the scan, pings never take it
+    if ((unsigned int)mutexLock(&watchdog->mutex) != MUTEX_OK)
+    {
+        X_LOG_TRACE("Failed to lock mutex in watchdog check");
         return;
     }
 
-    // Protect access with mutex
-    if ((unsigned int)mutexLock(&watchdog->mutex) != MUTEX_OK)
+    for (int i = 0; i < WATCHDOG_MAX_CLIENTS; i++)
     {
-        X_LOG_TRACE("Failed to lock mutex in timer handler");
-        return;
+        watchdog_client_t *client = &watchdog->clients[i];
+        int state = atomic_load_explicit(&client->state, memory_order_relaxed);
+
+        if (state == WATCHDOG_CLIENT_FREE)
+        {
+            continue;
+        }
+
+        if (atomic_exchange_explicit(&client->beat, 0, memory_order_relaxed) != 0)
+        {
+            client->last_alive_ns = now;
+            if (state == WATCHDOG_CLIENT_EXPIRED)
+            {
+                atomic_store(&client->state, WATCHDOG_CLIENT_ACTIVE);
+                X_LOG_TRACE("Watchdog client %s recovered", client->name);
+            }
+            continue;
+        }
+
+        if (state == WATCHDOG_CLIENT_EXPIRED)
+        {
+            healthy = false;
+        }
+        else if (now - client->last_alive_ns > client->timeout_ns)
+        {
+            // One expiry per silence, the client re-arms by pinging again
+            atomic_store(&client->state, WATCHDOG_CLIENT_EXPIRED);
+            atomic_fetch_add(&client->expirations, 1);
+            xMetricsInc(g_expirations_metric);
+            expired[expired_count] = client;
+            expired_generation[expired_count++] = client->generation;
+            healthy = false;
+        }
     }
 
-    // Check if the watchdog is still initialized
-    if (!g_is_initialized)
+    mutexUnlock(&watchdog->mutex);
+
+    // Handlers may register or unregister clients, so they run unlocked
+    for (int i = 0; i < expired_count; i++)
     {
+        watchdog_client_t *client = expired[i];
+        watchdog_handler_t handler = NULL;
+        void *handler_arg = NULL;
+
+        // The slot may have been released, or released and reused, since the scan
+        if ((unsigned int)mutexLock(&watchdog->mutex) != MUTEX_OK)
+        {
+            X_LOG_TRACE("Failed to lock mutex in watchdog check");
+            break;
+        }
+        if (client->generation == expired_generation[i] &&
+            atomic_load(&client->state) != WATCHDOG_CLIENT_FREE)
+        {
+            X_LOG_TRACE("Watchdog client %s expired", client->name);
+            handler = client->handler;
+            handler_arg = client->arg;
+            if (handler != NULL)
+            {
+                osEventReset(&watchdog->dispatch_done);
+                atomic_store(&watchdog->dispatching, client);
+            }
+        }
         mutexUnlock(&watchdog->mutex);
-        return;
-    }
 
-    // Mark the watchdog as expired
-    watchdog->should_reset = true;
+        if (handler != NULL)
+        {
+            g_in_handler = 1;
+            handler(client, handler_arg);
+            g_in_handler = 0;
+            atomic_store(&watchdog->dispatching, NULL);
+            osEventSet(&watchdog->dispatch_done);
+        }
+    }
 
-    // Call the expiry handler if defined
-    if (g_expiry_handler != NULL)
+    // The hardware watchdog resets the board once any client stays silent
+    if (healthy && watchdog->hw_fd >= 0)
     {
-        g_expiry_handler();
+        if (ioctl(watchdog->hw_fd, WDIOC_KEEPALIVE, 0) != 0)
+        {
+            X_LOG_TRACE("Failed to feed hardware watchdog: %s", strerror(errno));
+        }
     }
-    else
+}
+
+////////////////////////////////////////////////////////////
+/// watchdog_hw_close
+////////////////////////////////////////////////////////////
+static void watchdog_hw_close(watchdog_t *watchdog)
+{
+    if (watchdog->hw_fd < 0)
     {
-        X_LOG_TRACE("WATCHDOG TIMEOUT - System will restart");
-        // In production environment, use an appropriate method to restart
-        // the system rather than abruptly exiting
-        mutexUnlock(&watchdog->mutex);
-        exit(EXIT_FAILURE);
+        return;
     }
 
-    mutexUnlock(&watchdog->mutex);
+    // Magic close, disarms the device unless its driver has nowayout set
+    if (write(watchdog->hw_fd, "V", 1) != 1)
+    {
+        X_LOG_TRACE("Failed to disarm hardware watchdog: %s", strerror(errno));
+    }
+    close(watchdog->hw_fd);
+    watchdog->hw_fd = -1;
 }
 
 ////////////////////////////////////////////////////////////
-/// watchdog_init
+/// watchdog_supervisor_start
 ////////////////////////////////////////////////////////////
-int watchdog_init(int timeout_ms)
+int watchdog_supervisor_start(uint32_t check_ms, const char *hw_device, uint32_t hw_timeout_s)
 {
-    unsigned long l_ulReturn ;
-    // Check if already initialized
-    if (g_is_initialized)
+    if (atomic_load(&g_watchdog.running))
     {
-        X_LOG_TRACE("Watchdog already initialized");
+        X_LOG_TRACE("Watchdog supervisor already running");
         return 0;
     }
 
-    // Timeout configuration
-    uint32_t actual_timeout = timeout_ms > 0 ? timeout_ms : WATCHDOG_DEFAULT_TIMEOUT;
+    if (check_ms == 0)
+    {
+        check_ms = WATCHDOG_DEFAULT_TIMEOUT / 4;
+    }
 
-    // Watchdog structure initialization
     memset(&g_watchdog, 0, sizeof(watchdog_t));
-    g_watchdog.timeout = actual_timeout;
-    g_watchdog.should_reset = false;
-    g_watchdog.is_running = 0;
-    g_watchdog.terminate = 0;
+    g_watchdog.check_ms = check_ms;
+    xMetricsRegisterCounter("watchdog_expirations_total", "Watchdog client expirations", &g_expirations_metric);
+    g_watchdog.hw_fd = -1;
 
-    // Mutex initialization
     if ((unsigned int)mutexCreate(&g_watchdog.mutex) != MUTEX_OK)
     {
         X_LOG_TRACE("Failed to create watchdog mutex");
         return -1;
     }
 
-    // Event configuration for the timer
-    memset(&g_sev, 0, sizeof(struct sigevent));
-    g_sev.sigev_notify = SIGEV_THREAD;           // Uses a thread to handle the event
-    g_sev.sigev_notify_function = timer_handler; // Callback function
-    g_sev.sigev_value.sival_ptr = &g_watchdog;   // Pass the watchdog structure to the callback
-    g_sev.sigev_notify_attributes = NULL;        // Use default attributes
-
-    // Timer creation
-    if (timer_create(CLOCK_MONOTONIC, &g_sev, &g_timer_id) != 0)
+    if ((unsigned int)osEventInit(&g_watchdog.dispatch_done, OS_EVENT_MANUAL_RESET, true) != OS_SEM_SUCCESS)
     {
-        X_LOG_TRACE("Failed to create timer: %s", strerror(errno));
+        X_LOG_TRACE("Failed to create watchdog dispatch event");
         mutexDestroy(&g_watchdog.mutex);
         return -1;
     }
-    
-    // Store the timer ID in the watchdog structure
-    g_watchdog.timer_id = (void*)g_timer_id;
 
-    g_is_initialized = 1;
-    X_LOG_TRACE("POSIX timer watchdog initialized (timeout=%dms)", actual_timeout);
+    if (hw_device != NULL)
+    {
+        g_watchdog.hw_fd = open(hw_device, O_WRONLY | O_CLOEXEC);
+        if (g_watchdog.hw_fd < 0)
+        {
+            X_LOG_TRACE("Failed to open %s: %s", hw_device, strerror(errno));
+            osEventDestroy(&g_watchdog.dispatch_done);
+            mutexDestroy(&g_watchdog.mutex);
+            return -1;
+        }
+
+        int hw_timeout = (int)hw_timeout_s;
+        if (hw_timeout > 0 && ioctl(g_watchdog.hw_fd, WDIOC_SETTIMEOUT, &hw_timeout) != 0)
+        {
+            X_LOG_TRACE("Failed to set hardware watchdog timeout: %s", strerror(errno));
+        }
+    }
 
-    // Create the watchdog thread
-    l_ulReturn = osTaskInit(&g_watchdog.task_ctx);
-    if (l_ulReturn != OS_TASK_SUCCESS) 
+    // The wheel resolution is the check period, so the service wakes once per check
+    if ((unsigned int)xTimerServiceCreate(&g_watchdog.service, check_ms * 1000) != XOS_TIMER_OK)
     {
-        X_LOG_TRACE("Failed to initialize watchdog task: %x", l_ulReturn);
-        timer_delete(g_timer_id);
+        X_LOG_TRACE("Failed to create watchdog timer service");
+        watchdog_hw_close(&g_watchdog);
+        osEventDestroy(&g_watchdog.dispatch_done);
         mutexDestroy(&g_watchdog.mutex);
-        g_is_initialized = 0;  
-        return l_ulReturn;
-    }
-    
-    g_watchdog.task_ctx.t_iPriority = 1;        
-    g_watchdog.task_ctx.t_ulStackSize = PTHREAD_STACK_MIN; 
-    g_watchdog.task_ctx.t_ptTask = watchdog_thread;
-    g_watchdog.task_ctx.t_ptTaskArg = &g_watchdog;
-    
-    l_ulReturn = osTaskCreate(&g_watchdog.task_ctx);
-    if (l_ulReturn != OS_TASK_SUCCESS) 
-    {
-        X_LOG_TRACE("Failed to create watchdog thread: %x", l_ulReturn);
-        timer_delete(g_timer_id);
-        mutexDestroy(&g_watchdog.mutex);
-        g_is_initialized = 0;
         return -1;
     }
-    
-    g_watchdog.is_running = 1;
-    
-    // Activate the watchdog immediately
-    if (watchdog_ping() != 0) 
+
+    xTimerEntryInit(&g_watchdog.tick, &g_watchdog.service, watchdog_check, &g_watchdog);
+    if ((unsigned int)xTimerEntryStart(&g_watchdog.tick, check_ms * 1000ULL, check_ms * 1000ULL) != XOS_TIMER_OK)
     {
-        X_LOG_TRACE("Failed to start watchdog timer");
-        g_watchdog.terminate = 1;
-        osTaskEnd(&g_watchdog.task_ctx);
-        timer_delete(g_timer_id);
+        X_LOG_TRACE("Failed to start watchdog check timer");
+        xTimerServiceDestroy(&g_watchdog.service);
+        watchdog_hw_close(&g_watchdog);
+        osEventDestroy(&g_watchdog.dispatch_done);
         mutexDestroy(&g_watchdog.mutex);
-        g_is_initialized = 0;
         return -1;
     }
 
+    atomic_store(&g_watchdog.running, 1);
+    X_LOG_TRACE("Watchdog supervisor started (check=%ums, hw=%s)", check_ms, hw_device != NULL ? hw_device : "none");
     return 0;
 }
 
 ////////////////////////////////////////////////////////////
-/// watchdog_stop
+/// watchdog_supervisor_stop
 ////////////////////////////////////////////////////////////
-void watchdog_stop(void)
+int watchdog_supervisor_stop(void)
 {
-    // Check if initialized
-    if (!g_is_initialized)
+    // Handlers run on the service thread, destroying the service there would join itself
+    if (g_in_handler)
+    {
+        X_LOG_TRACE("Watchdog supervisor cannot be stopped from an expiry handler");
+        return -1;
+    }
+
+    if (atomic_exchange(&g_watchdog.running, 0) == 0)
+    {
+        return 0;
+    }
+
+    // Joins the service thread, no check runs past this point
+    xTimerEntryStop(&g_watchdog.tick);
+    xTimerServiceDestroy(&g_watchdog.service);
+
+    watchdog_hw_close(&g_watchdog);
+
+    for (int i = 0; i < WATCHDOG_MAX_CLIENTS; i++)
+    {
+        atomic_store(&g_watchdog.clients[i].state, WATCHDOG_CLIENT_FREE);
+    }
+    g_default_client = NULL;
+    g_owns_supervisor = 0;
+
+    osEventDestroy(&g_watchdog.dispatch_done);
+    mutexDestroy(&g_watchdog.mutex);
+
+    X_LOG_TRACE("Watchdog supervisor stopped");
+    return 0;
+}
+
+////////////////////////////////////////////////////////////
+/// watchdog_register
+////////////////////////////////////////////////////////////
+watchdog_client_t *watchdog_register(const char *name, uint32_t timeout_ms, watchdog_handler_t handler, void *arg)
+{
+    watchdog_client_t *client = NULL;
+
+    if (!atomic_load(&g_watchdog.running) || timeout_ms == 0)
+    {
+        X_LOG_TRACE("Watchdog register refused");
+        return NULL;
+    }
+
+    if ((unsigned int)mutexLock(&g_watchdog.mutex) != MUTEX_OK)
+    {
+        X_LOG_TRACE("Failed to lock mutex in watchdog_register");
+        return NULL;
+    }
+
+    for (int i = 0; i < WATCHDOG_MAX_CLIENTS; i++)
+    {
+        if (atomic_load(&g_watchdog.clients[i].state) == WATCHDOG_CLIENT_FREE)
+        {
+            client = &g_watchdog.clients[i];
+            break;
+        }
+    }
+
+    if (client != NULL)
+    {
+        atomic_store(&client->beat, 0);
+        atomic_store(&client->expirations, 0);
+        client->timeout_ns = (uint64_t)timeout_ms * 1000000ULL;
+        client->last_alive_ns = osTaskNowNs();
+        client->handler = handler;
+        client->arg = arg;
+        client->name = name != NULL ? name : "unnamed";
+        atomic_store(&client->state, WATCHDOG_CLIENT_ACTIVE);
+    }
+
+    mutexUnlock(&g_watchdog.mutex);
+
+    if (client == NULL)
+    {
+        X_LOG_TRACE("Watchdog client table full");
+    }
+    return client;
+}
+
+////////////////////////////////////////////////////////////
+/// watchdog_unregister
+////////////////////////////////////////////////////////////
+void watchdog_unregister(watchdog_client_t *client)
+{
+    if (client == NULL || !atomic_load(&g_watchdog.running))
     {
         return;
     }
 
-    // Protect access with mutex
     if ((unsigned int)mutexLock(&g_watchdog.mutex) != MUTEX_OK)
     {
-        X_LOG_TRACE("Failed to lock mutex in watchdog_stop");
+        X_LOG_TRACE("Failed to lock mutex in watchdog_unregister");
         return;
     }
 
-    // Signal the thread to terminate
-    g_watchdog.terminate = 1;
-    
-    // Mark as uninitialized to prevent new entries
-    g_is_initialized = 0;
+    atomic_store(&client->state, WATCHDOG_CLIENT_FREE);
+    client->generation++;
+    if (client == g_default_client)
+    {
+        g_default_client = NULL;
+    }
 
-    // Disarm the timer
-    struct itimerspec its;
-    memset(&its, 0, sizeof(struct itimerspec));
+    mutexUnlock(&g_watchdog.mutex);
 
-    if (timer_settime(g_timer_id, 0, &its, NULL) != 0)
+    // A handler already dispatched may still use the client, except when it is the caller
+    while (!g_in_handler && atomic_load(&g_watchdog.dispatching) == client)
     {
-        X_LOG_TRACE("Failed to stop timer: %s", strerror(errno));
+        osEventWait(&g_watchdog.dispatch_done);
     }
-    
-    // Release the mutex to allow the thread to terminate
-    mutexUnlock(&g_watchdog.mutex);
-    
-    if (g_watchdog.is_running) {
-        // Wait for the thread to terminate properly (with a timeout)
-        int wait_count = 0;
-        while (g_watchdog.is_running && wait_count < 10) {
-            usleep(100000); // 100ms
-            wait_count++;
-        }
-        
-        // If the thread is still running, terminate it
-        if (g_watchdog.is_running) {
-            X_LOG_TRACE("Forcing watchdog thread termination");
-            osTaskEnd(&g_watchdog.task_ctx);
-        }
+}
+
+////////////////////////////////////////////////////////////
+/// watchdog_client_has_expired
+////////////////////////////////////////////////////////////
+bool watchdog_client_has_expired(watchdog_client_t *client)
+{
+    if (client == NULL)
+    {
+        return false;
     }
 
-    // Delete the timer
-    if (timer_delete(g_timer_id) != 0)
+    return atomic_load(&client->state) == WATCHDOG_CLIENT_EXPIRED;
+}
+
+////////////////////////////////////////////////////////////
+/// watchdog_default_handler
+////////////////////////////////////////////////////////////
+static void watchdog_default_handler(watchdog_client_t *client, void *arg)
+{
+    (void)client;
+    (void)arg;
+
+    // Call the expiry handler if defined
+    if (g_expiry_handler != NULL)
+    {
+        g_expiry_handler();
+    }
+    else
     {
-        X_LOG_TRACE("Failed to delete timer: %s", strerror(errno));
+        X_LOG_TRACE("WATCHDOG TIMEOUT - System will restart");
+        // In production environment, use an appropriate method to restart
+        // the system rather than abruptly exiting
+        exit(EXIT_FAILURE);
     }
+}
 
-    // Destroy the mutex
-    mutexDestroy(&g_watchdog.mutex);
+////////////////////////////////////////////////////////////
+/// watchdog_init
+////////////////////////////////////////////////////////////
+int watchdog_init(int timeout_ms)
+{
+    // Check if already initialized
+    if (g_default_client != NULL)
+    {
+        X_LOG_TRACE("Watchdog already initialized");
+        return 0;
+    }
 
-    X_LOG_TRACE("Watchdog stopped");
+    // Timeout configuration
+    uint32_t actual_timeout = timeout_ms > 0 ? (uint32_t)timeout_ms : WATCHDOG_DEFAULT_TIMEOUT;
+
+    // Reuse a supervisor started by the application, else check four times per timeout
+    if (!atomic_load(&g_watchdog.running))
+    {
+        uint32_t check_ms = actual_timeout / 4 > 0 ? actual_timeout / 4 : 1;
+        if (watchdog_supervisor_start(check_ms, NULL, 0) != 0)
+        {
+            return -1;
+        }
+        g_owns_supervisor = 1;
+    }
+
+    g_default_client = watchdog_register(WATCHDOG_DEVICE_NAME, actual_timeout, watchdog_default_handler, NULL);
+    if (g_default_client == NULL)
+    {
+        if (g_owns_supervisor)
+        {
+            watchdog_supervisor_stop();
+        }
+        return -1;
+    }
+
+    X_LOG_TRACE("Watchdog initialized (timeout=%ums)", actual_timeout);
+    return 0;
 }
 
 ////////////////////////////////////////////////////////////
-/// watchdog_ping
+/// watchdog_stop
 ////////////////////////////////////////////////////////////
-int watchdog_ping(void)
+void watchdog_stop(void)
 {
     // Check if initialized
-    if (!g_is_initialized)
+    if (g_default_client == NULL)
     {
-        X_LOG_TRACE("Watchdog not initialized");
-        return -1;
+        return;
     }
 
-    // Protect access with mutex
-    if ((unsigned int)mutexLock(&g_watchdog.mutex) != MUTEX_OK)
+    // An expiry handler cannot stop the supervisor, it only drops the default client
+    if (!g_owns_supervisor || watchdog_supervisor_stop() != 0)
     {
-        X_LOG_TRACE("Failed to lock mutex in watchdog_ping");
-        return -1;
+        watchdog_unregister(g_default_client);
     }
 
-    // Configure timer for single-shot (no repetition)
-    memset(&g_its, 0, sizeof(struct itimerspec));
-    g_its.it_value.tv_sec = g_watchdog.timeout / 1000;
-    g_its.it_value.tv_nsec = (g_watchdog.timeout % 1000) * 1000000;
-    g_its.it_interval.tv_sec = 0;
-    g_its.it_interval.tv_nsec = 0;
+    X_LOG_TRACE("Watchdog stopped");
+}
+
+////////////////////////////////////////////////////////////
+/// watchdog_ping
+////////////////////////////////////////////////////////////
+int watchdog_ping(void)
+{
+    watchdog_client_t *client = g_default_client;
 
-    // Arm/rearm the timer
-    if (timer_settime(g_timer_id, 0, &g_its, NULL) != 0)
+    // Check if initialized
+    if (client == NULL)
     {
-        X_LOG_TRACE("Failed to set timer: %s", strerror(errno));
-        mutexUnlock(&g_watchdog.mutex);
+        X_LOG_TRACE("Watchdog not initialized");
         return -1;
     }
 
-    mutexUnlock(&g_watchdog.mutex);
+    watchdog_client_ping(client);
     return 0;
 }
 
@@ -309,22 +469,13 @@ int watchdog_ping(void)
 bool watchdog_has_expired(void)
 {
     // Check if initialized
-    if (!g_is_initialized)
+    if (g_default_client == NULL)
     {
         X_LOG_TRACE("Watchdog not initialized when checking expiry");
         return false;
     }
 
-    bool has_expired = false;
-
-    // Protect access with mutex if initialized
-    if ((unsigned int)mutexLock(&g_watchdog.mutex) == MUTEX_OK)
-    {
-        has_expired = g_watchdog.should_reset;
-        mutexUnlock(&g_watchdog.mutex);
-    }
-
-    return has_expired;
+    return watchdog_client_has_expired(g_default_client);
 }
 
 ////////////////////////////////////////////////////////////
@@ -332,14 +483,5 @@ bool watchdog_has_expired(void)
 ////////////////////////////////////////////////////////////
 void watchdog_set_expiry_handler(void (*callback)(void))
 {
-    // Protect access with mutex if initialized
-    if (g_is_initialized && (unsigned int)mutexLock(&g_watchdog.mutex) == MUTEX_OK)
-    {
-        g_expiry_handler = callback;
-        mutexUnlock(&g_watchdog.mutex);
-    }
-    else
-    {
-        g_expiry_handler = callback;
-    }
+    g_expiry_handler = callback;
 }
@@ -1,9 +1,16 @@
 ////////////////////////////////////////////////////////////
 //  Watchdog header file
-//  Provides watchdog support using POSIX timer
+//  Provides a multi-client software watchdog
+//
+// Each monitored task owns a heartbeat slot and pings it with a single
+// atomic store. One supervisor, a periodic entry of a timer service,
+// collects the heartbeats on each tick, runs the expiry handler of the
+// clients that stayed silent and optionally feeds /dev/watchdog while
+// every client is healthy
 //
 // general disclosure: copy or share the file is forbidden
 // Written : 02/05/2025
+// Modified: 14/10/2026 - Multi-client supervisor on the timer service
 ////////////////////////////////////////////////////////////
 
 #ifndef WATCHDOG_H
@@ -11,48 +18,135 @@
 
 #include <stdbool.h>
 #include <stdint.h>
-#include <time.h>
-#include <signal.h>
-#include <sys/types.h>
-#include "xTask.h"
+#include <stdatomic.h>
 #include "xOsMutex.h"
+#include "xOsSemaphore.h"
+#include "xTimerService.h"
 
 // Définitions pour le timer
 #define WATCHDOG_DEFAULT_TIMEOUT 100 // 100ms
 #define WATCHDOG_DEVICE_NAME "watchdog"
 
+#define WATCHDOG_MAX_CLIENTS        64
+#define WATCHDOG_HW_DEVICE          "/dev/watchdog"
+
+// Client states
+#define WATCHDOG_CLIENT_FREE        0
+#define WATCHDOG_CLIENT_ACTIVE      1
+#define WATCHDOG_CLIENT_EXPIRED     2
+
+struct watchdog_client;
+
+//////////////////////////////////
+/// @brief Client expiry handler, runs on the supervisor thread
+/// @param client : client that missed its deadline
+/// @param arg : argument given at registration
+//////////////////////////////////
+typedef void (*watchdog_handler_t)(struct watchdog_client *client, void *arg);
+
+////////////////////////////////////////////////////////////
+/// @param watchdog_client_t
+/// @brief Heartbeat slot of one monitored task, one cache line each
+////////////////////////////////////////////////////////////
+typedef struct watchdog_client
+{
+    atomic_int beat;                 // Set by the client, cleared by the supervisor
+    atomic_int state;                // WATCHDOG_CLIENT_*
+    uint64_t timeout_ns;             // Silence tolerated before expiry
+    uint64_t last_alive_ns;          // Last tick a beat was seen (supervisor only)
+    atomic_ulong expirations;        // Expiries so far
+    watchdog_handler_t handler;      // NULL to only log
+    void *arg;
+    const char *name;
+    uint32_t generation;             // Bumped by each unregister, under the mutex
+} __attribute__((aligned(64))) watchdog_client_t;
+
 ////////////////////////////////////////////////////////////
 /// @param watchdog_t
-/// @brief Watchdog structure
+/// @brief Watchdog supervisor
 ////////////////////////////////////////////////////////////
 typedef struct watchdog
 {
-    xOsTaskCtx task_ctx;              // Contexte de tâche pour la gestion du watchdog
-    void *timer_id;                  // Timer POSIX (void* pour éviter les dépendances de types)
-    uint32_t timeout;                // Délai d'expiration en ms
-    xOsMutexCtx mutex;               // Mutex pour protéger l'accès concurrent
-    bool should_reset;               // Indique si un reset du système est nécessaire
-    int is_running;                  // Indique si le thread watchdog est en cours d'exécution
-    volatile sig_atomic_t terminate; // Signal pour arrêter proprement le thread
+    watchdog_client_t clients[WATCHDOG_MAX_CLIENTS];
+    xOsTimerService_t service;       // Timer service running the supervisor
+    xOsTimerEntry_t tick;            // Periodic check of every client
+    uint32_t check_ms;               // Check period
+    xOsMutexCtx mutex;               // Serializes registration
+    _Atomic(watchdog_client_t *) dispatching; // Client whose handler runs, unregister waits for it
+    t_OSEventCtx dispatch_done;      // Manual reset, set when no handler runs
+    int hw_fd;                       // /dev/watchdog descriptor, -1 when not fed
+    atomic_int running;
 } watchdog_t;
 
 //////////////////////////////////
-/// @brief Watchdog thread function
-/// @param arg : Thread argument pointer
-/// @return Pointer for pthread compatibility
+/// @brief Start the supervisor
+/// @param check_ms : check period in milliseconds, bounds the detection delay (0 for WATCHDOG_DEFAULT_TIMEOUT / 4)
+/// @param hw_device : hardware watchdog to feed while all clients are healthy (NULL for none)
+/// @param hw_timeout_s : hardware timeout to program in seconds (0 to keep the device setting)
+/// @return 0 on success, -1 on error
+//////////////////////////////////
+int watchdog_supervisor_start(uint32_t check_ms, const char *hw_device, uint32_t hw_timeout_s);
+
+//////////////////////////////////
+/// @brief Stop the supervisor and release every client
+/// @return 0 on success, -1 when called from an expiry handler
+/// @note the hardware watchdog is closed with the magic 'V', disarming it where supported
+/// @note joins the supervisor thread, so an expiry handler cannot stop the
+///       supervisor: the call is refused and the supervisor keeps running
+//////////////////////////////////
+int watchdog_supervisor_stop(void);
+
+//////////////////////////////////
+/// @brief Register a monitored task
+/// @param name : client name for the logs
+/// @param timeout_ms : silence tolerated before expiry in milliseconds
+/// @param handler : expiry handler (NULL to only log)
+/// @param arg : handler argument
+/// @return client slot, NULL when the supervisor is stopped or full
+//////////////////////////////////
+watchdog_client_t *watchdog_register(const char *name, uint32_t timeout_ms, watchdog_handler_t handler, void *arg);
+
+//////////////////////////////////
+/// @brief Release a client slot
+/// @param client : client slot
+/// @return none
+/// @note waits for the expiry handler of the client if it is running, the
+///       handler is not called after this returns. From the handler itself the
+///       slot is released at once
+//////////////////////////////////
+void watchdog_unregister(watchdog_client_t *client);
+
+//////////////////////////////////
+/// @brief Send a heartbeat
+/// @param client : client slot
+/// @return none
+/// @note one relaxed atomic store, safe from any thread and from RT loops
+//////////////////////////////////
+static inline void watchdog_client_ping(watchdog_client_t *client)
+{
+    atomic_store_explicit(&client->beat, 1, memory_order_relaxed);
+}
+
+//////////////////////////////////
+/// @brief Check whether a client is expired
+/// @param client : client slot
+/// @return true until the client pings again
 //////////////////////////////////
-void *watchdog_thread(void *arg);
+bool watchdog_client_has_expired(watchdog_client_t *client);
 
 //////////////////////////////////
-/// @brief Initialize the software watchdog with POSIX timer
+/// @brief Initialize the software watchdog with one default client
 /// @param timeout_ms : Expiration timeout in milliseconds (0 to use default)
 /// @return 0 on success, -1 on error
+/// @note the default client must be fed with watchdog_ping
 //////////////////////////////////
 int watchdog_init(int timeout_ms);
 
 //////////////////////////////////
 /// @brief Stop the watchdog and release resources
 /// @return none
+/// @note from an expiry handler only the default client is released, a
+///       supervisor started by watchdog_init keeps running
 //////////////////////////////////
 void watchdog_stop(void);
 
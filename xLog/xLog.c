@@ -8,13 +8,21 @@
 ////////////////////////////////////////////////////////////
 
 #include "xLog.h"
+#include "xLogBinary.h"
 #include "xAssert.h"
 #include "xOsHorodateur.h"
 #include "xOsMutex.h"
+#include "xOsSemaphore.h"
+#include "xTask.h"
+#include "xMetrics.h"
 #include <stdio.h>
 #include <stdarg.h>
+#include <stdlib.h>
 #include <string.h>
 #include <stdatomic.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/uio.h>
 
 // Logger state
 typedef enum
@@ -30,6 +38,382 @@ static FILE *s_ptLogFile = NULL;
 
 static atomic_int s_eLogState = ATOMIC_VAR_INIT(XOS_LOG_STATE_UNINITIALIZED);
 
+// Runtime minimum level, nothing passes before xLogInit
+atomic_int g_iLogMinLevel = ATOMIC_VAR_INIT(XOS_LOG_LEVEL_NONE);
+
+// Ring buffer record, its sequence tells who owns it:
+// seq == pos (free for producer), seq == pos + 1 (ready for writer)
+typedef struct
+{
+    atomic_size_t a_ulSeq;                  // Record sequence
+    uint32_t t_ulLength;                    // Formatted line length
+    char t_cData[XOS_LOG_RECORD_SIZE];      // Formatted line
+} t_logRecord;
+
+// Asynchronous backend: bounded MPSC ring drained by a writer task
+typedef struct
+{
+    t_logRecord* t_ptRecords;               // Ring buffer
+    size_t t_ulMask;                        // Capacity - 1
+    _Alignas(64) atomic_size_t a_ulEnqueuePos; // Next position claimed by producers
+    _Alignas(64) atomic_size_t a_ulDequeuePos; // Next position written by the writer
+    atomic_int a_iWriterIdle;               // Writer is (about to be) waiting on the semaphore
+    atomic_ullong a_ulDropped;              // Messages dropped on overflow
+    unsigned long long t_ulDropReported;    // Drops already reported (writer only)
+    t_OSSemCtx t_tWakeSem;                  // Wakes the writer
+    xOsTaskCtx t_tWriter;                   // Writer task
+} t_logAsync;
+
+static t_logAsync s_tLogAsync;
+static atomic_bool s_bLogAsync = ATOMIC_VAR_INIT(false);
+static atomic_bool s_bLogBinary = ATOMIC_VAR_INIT(false);
+
+// Writers between their state check and the end of an async or binary write
+static atomic_int s_iLogInFlight = ATOMIC_VAR_INIT(0);
+
+//
+// Formats a complete log line and returns its length (newline included)
+//
+static int logFormat(char* p_pcBuffer, size_t p_ulSize, const char* p_ptkcFile, uint32_t p_ulLine,
+                     const char* p_ptkcFormat, va_list p_tArgs)
+{
+    const char* l_pcTimestamp = xHorodateurGetString();
+    const char* l_pcFileName = "UnknownFile";
+
+    // Extraction sécurisée du nom de fichier
+    if (p_ptkcFile != NULL)
+    {
+        l_pcFileName = p_ptkcFile;
+        const char* l_pcLastSlash = strrchr(p_ptkcFile, '/');
+        if (l_pcLastSlash == NULL)
+        {
+            l_pcLastSlash = strrchr(p_ptkcFile, '\\');
+        }
+        if (l_pcLastSlash != NULL)
+        {
+            l_pcFileName = l_pcLastSlash + 1;
+        }
+    }
+
+    int l_iLength = snprintf(p_pcBuffer, p_ulSize, "%.31s | %s:%u | ",
+                             (l_pcTimestamp != NULL) ? l_pcTimestamp : "UnknownTime", l_pcFileName, p_ulLine);
+    if (l_iLength < 0 || (size_t)l_iLength >= p_ulSize - 1)
+    {
+        l_iLength = (int)p_ulSize - 2;
+    }
+
+    // The user message is limited to XOS_LOG_MSG_SIZE - 1 characters as in the formatted buffer
+    size_t l_ulRoom = p_ulSize - 1 - (size_t)l_iLength;
+    if (l_ulRoom > XOS_LOG_MSG_SIZE)
+    {
+        l_ulRoom = XOS_LOG_MSG_SIZE;
+    }
+    int l_iMsg = vsnprintf(p_pcBuffer + l_iLength, l_ulRoom, p_ptkcFormat, p_tArgs);
+    if (l_iMsg > 0)
+    {
+        l_iLength += ((size_t)l_iMsg < l_ulRoom) ? l_iMsg : (int)l_ulRoom - 1;
+    }
+
+    p_pcBuffer[l_iLength++] = '\n';
+    p_pcBuffer[l_iLength] = '\0';
+    return l_iLength;
+}
+
+//
+// Writes a whole iovec array, resuming after partial writes
+//
+static void logWriteAll(int p_iFd, struct iovec* p_ptIov, int p_iCount)
+{
+    while (p_iCount > 0)
+    {
+        ssize_t l_lWritten = writev(p_iFd, p_ptIov, p_iCount);
+        if (l_lWritten < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return;
+        }
+
+        while (p_iCount > 0 && (size_t)l_lWritten >= p_ptIov->iov_len)
+        {
+            l_lWritten -= (ssize_t)p_ptIov->iov_len;
+            p_ptIov++;
+            p_iCount--;
+        }
+        if (p_iCount > 0)
+        {
+            p_ptIov->iov_base = (char*)p_ptIov->iov_base + l_lWritten;
+            p_ptIov->iov_len -= (size_t)l_lWritten;
+        }
+    }
+}
+
+//
+// Sends a batch to every enabled sink
+//
+static void logWriteBatch(struct iovec* p_ptIov, int p_iCount)
+{
+    struct iovec l_tCopy[XOS_LOG_ASYNC_BATCH + 1];
+
+    if (s_tLogConfig.t_bLogToConsole)
+    {
+        memcpy(l_tCopy, p_ptIov, sizeof(struct iovec) * (size_t)p_iCount);
+        logWriteAll(STDOUT_FILENO, l_tCopy, p_iCount);
+    }
+
+    if (s_tLogConfig.t_bLogToFile && s_ptLogFile != NULL)
+    {
+        memcpy(l_tCopy, p_ptIov, sizeof(struct iovec) * (size_t)p_iCount);
+        logWriteAll(fileno(s_ptLogFile), l_tCopy, p_iCount);
+    }
+}
+
+//
+// Writes every ready record, returns the number of records written
+//
+static size_t logDrain(void)
+{
+    t_logAsync* l_ptAsync = &s_tLogAsync;
+    struct iovec l_tIov[XOS_LOG_ASYNC_BATCH + 1];
+    char l_cDropMsg[128];
+    size_t l_ulTotal = 0;
+
+    for (;;)
+    {
+        size_t l_ulPos = atomic_load_explicit(&l_ptAsync->a_ulDequeuePos, memory_order_relaxed);
+        int l_iCount = 0;
+
+        // Collect consecutive published records
+        while (l_iCount < XOS_LOG_ASYNC_BATCH)
+        {
+            t_logRecord* l_ptRecord = &l_ptAsync->t_ptRecords[(l_ulPos + (size_t)l_iCount) & l_ptAsync->t_ulMask];
+            if (atomic_load_explicit(&l_ptRecord->a_ulSeq, memory_order_acquire) != l_ulPos + (size_t)l_iCount + 1)
+            {
+                break;
+            }
+            l_tIov[l_iCount].iov_base = l_ptRecord->t_cData;
+            l_tIov[l_iCount].iov_len = l_ptRecord->t_ulLength;
+            l_iCount++;
+        }
+
+        // Report drops once per batch
+        unsigned long long l_ulDropped = atomic_load_explicit(&l_ptAsync->a_ulDropped, memory_order_relaxed);
+        if (s_tLogConfig.t_eOverflowPolicy == XOS_LOG_OVERFLOW_COUNT && l_ulDropped != l_ptAsync->t_ulDropReported)
+        {
+            int l_iLen = snprintf(l_cDropMsg, sizeof(l_cDropMsg), "%.31s | xLog | %llu messages dropped\n",
+                                  xHorodateurGetString(), l_ulDropped - l_ptAsync->t_ulDropReported);
+            l_tIov[l_iCount].iov_base = l_cDropMsg;
+            l_tIov[l_iCount].iov_len = (size_t)l_iLen;
+            l_ptAsync->t_ulDropReported = l_ulDropped;
+            logWriteBatch(l_tIov, l_iCount + 1);
+        }
+        else if (l_iCount > 0)
+        {
+            logWriteBatch(l_tIov, l_iCount);
+        }
+
+        if (l_iCount == 0)
+        {
+            return l_ulTotal;
+        }
+
+        // Give the records back to the producers
+        for (int i = 0; i < l_iCount; i++)
+        {
+            t_logRecord* l_ptRecord = &l_ptAsync->t_ptRecords[(l_ulPos + (size_t)i) & l_ptAsync->t_ulMask];
+            atomic_store_explicit(&l_ptRecord->a_ulSeq, l_ulPos + (size_t)i + l_ptAsync->t_ulMask + 1, memory_order_release);
+        }
+        atomic_store_explicit(&l_ptAsync->a_ulDequeuePos, l_ulPos + (size_t)l_iCount, memory_order_release);
+        l_ulTotal += (size_t)l_iCount;
+    }
+}
+
+//
+// Writer task: drains the ring, sleeps on the semaphore when it is empty
+//
+static void* logWriterTask(void* p_ptArg)
+{
+    t_logAsync* l_ptAsync = (t_logAsync*)p_ptArg;
+
+    while (atomic_load(&l_ptAsync->t_tWriter.a_iStopFlag) != OS_TASK_STOP_REQUEST)
+    {
+        if (logDrain() > 0)
+        {
+            continue;
+        }
+
+        // Announce the sleep then check again, a producer seeing the flag posts the semaphore.
+        // The fence pairs with the one in logWakeWriter: either the drain sees the record or
+        // the producer sees the flag
+        atomic_store(&l_ptAsync->a_iWriterIdle, 1);
+        atomic_thread_fence(memory_order_seq_cst);
+        if (logDrain() == 0)
+        {
+            osSemWaitTimeout(&l_ptAsync->t_tWakeSem, XOS_LOG_ASYNC_IDLE_MS);
+        }
+        atomic_store(&l_ptAsync->a_iWriterIdle, 0);
+    }
+
+    // Producers are gone, write what is left
+    logDrain();
+    return (void*)(intptr_t)OS_TASK_EXIT_SUCCESS;
+}
+
+//
+// Wakes the writer if it announced a sleep
+//
+static inline void logWakeWriter(void)
+{
+    // Orders the record publication before the flag load, see logWriterTask
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&s_tLogAsync.a_iWriterIdle, memory_order_relaxed) &&
+        atomic_exchange(&s_tLogAsync.a_iWriterIdle, 0))
+    {
+        osSemPost(&s_tLogAsync.t_tWakeSem);
+    }
+}
+
+//
+// Queues a message in the ring buffer
+//
+static int logAsyncWrite(const char* p_ptkcFile, uint32_t p_ulLine, const char* p_ptkcFormat, va_list p_tArgs)
+{
+    t_logAsync* l_ptAsync = &s_tLogAsync;
+    t_logRecord* l_ptRecord;
+    size_t l_ulPos = atomic_load_explicit(&l_ptAsync->a_ulEnqueuePos, memory_order_relaxed);
+
+    for (;;)
+    {
+        l_ptRecord = &l_ptAsync->t_ptRecords[l_ulPos & l_ptAsync->t_ulMask];
+        size_t l_ulSeq = atomic_load_explicit(&l_ptRecord->a_ulSeq, memory_order_acquire);
+        intptr_t l_iDiff = (intptr_t)l_ulSeq - (intptr_t)l_ulPos;
+
+        if (l_iDiff == 0)
+        {
+            if (atomic_compare_exchange_weak_explicit(&l_ptAsync->a_ulEnqueuePos, &l_ulPos, l_ulPos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (l_iDiff < 0)
+        {
+            // Ring full
+            if (s_tLogConfig.t_eOverflowPolicy != XOS_LOG_OVERFLOW_BLOCK)
+            {
+                atomic_fetch_add_explicit(&l_ptAsync->a_ulDropped, 1, memory_order_relaxed);
+                logWakeWriter();
+                return XOS_LOG_DROPPED;
+            }
+            logWakeWriter();
+            sched_yield();
+            l_ulPos = atomic_load_explicit(&l_ptAsync->a_ulEnqueuePos, memory_order_relaxed);
+        }
+        else
+        {
+            l_ulPos = atomic_load_explicit(&l_ptAsync->a_ulEnqueuePos, memory_order_relaxed);
+        }
+    }
+
+    l_ptRecord->t_ulLength = (uint32_t)logFormat(l_ptRecord->t_cData, sizeof(l_ptRecord->t_cData),
+                                                 p_ptkcFile, p_ulLine, p_ptkcFormat, p_tArgs);
+    atomic_store_explicit(&l_ptRecord->a_ulSeq, l_ulPos + 1, memory_order_release);
+
+    logWakeWriter();
+    return XOS_LOG_OK;
+}
+
+//
+// Allocates the ring and starts the writer task
+//
+static int logAsyncStart(void)
+{
+    t_logAsync* l_ptAsync = &s_tLogAsync;
+    size_t l_ulCapacity = s_tLogConfig.t_ulAsyncCapacity ? s_tLogConfig.t_ulAsyncCapacity : XOS_LOG_ASYNC_DEFAULT_CAPACITY;
+
+    if ((l_ulCapacity & (l_ulCapacity - 1)) != 0 || l_ulCapacity < 2)
+    {
+        return XOS_LOG_INVALID;
+    }
+
+    memset(l_ptAsync, 0, sizeof(t_logAsync));
+    l_ptAsync->t_ptRecords = malloc(sizeof(t_logRecord) * l_ulCapacity);
+    if (l_ptAsync->t_ptRecords == NULL)
+    {
+        return XOS_LOG_ERROR;
+    }
+    l_ptAsync->t_ulMask = l_ulCapacity - 1;
+    for (size_t i = 0; i < l_ulCapacity; i++)
+    {
+        atomic_init(&l_ptAsync->t_ptRecords[i].a_ulSeq, i);
+    }
+
+    if (osSemInit(&l_ptAsync->t_tWakeSem, 0, NULL) != (int)OS_SEM_SUCCESS)
+    {
+        free(l_ptAsync->t_ptRecords);
+        return XOS_LOG_ERROR;
+    }
+
+    // Lines written through stdio before the switch must come first
+    fflush(stdout);
+
+    osTaskInit(&l_ptAsync->t_tWriter);
+    l_ptAsync->t_tWriter.t_ptTask = logWriterTask;
+    l_ptAsync->t_tWriter.t_ptTaskArg = l_ptAsync;
+#ifdef OS_USE_RT_SCHEDULING
+    l_ptAsync->t_tWriter.t_iPriority = OS_TASK_LOWEST_PRIORITY;
+#endif
+    if (osTaskCreate(&l_ptAsync->t_tWriter) != (int)OS_TASK_SUCCESS)
+    {
+        osSemDestroy(&l_ptAsync->t_tWakeSem);
+        free(l_ptAsync->t_ptRecords);
+        return XOS_LOG_ERROR;
+    }
+
+    atomic_store(&s_bLogAsync, true);
+    return XOS_LOG_OK;
+}
+
+//
+// Waits for the writers that passed the state check before the close
+//
+static void logWaitInFlight(void)
+{
+    // State is already uninitialized: no new producer can enter
+    while (atomic_load(&s_iLogInFlight) != 0)
+    {
+        sched_yield();
+    }
+}
+
+//
+// Drains the ring and stops the writer, producers must be gone
+//
+static void logAsyncStop(void)
+{
+    t_logAsync* l_ptAsync = &s_tLogAsync;
+
+    atomic_store(&l_ptAsync->t_tWriter.a_iStopFlag, OS_TASK_STOP_REQUEST);
+    osSemPost(&l_ptAsync->t_tWakeSem);
+    osTaskWait(&l_ptAsync->t_tWriter, NULL);
+
+    osSemDestroy(&l_ptAsync->t_tWakeSem);
+    free(l_ptAsync->t_ptRecords);
+    l_ptAsync->t_ptRecords = NULL;
+    atomic_store(&s_bLogAsync, false);
+}
+
+////////////////////////////////////////////////////////////
+/// logMetricDropped
+////////////////////////////////////////////////////////////
+static int64_t logMetricDropped(void* p_pvArg)
+{
+    (void)p_pvArg;
+    return (int64_t)xLogGetDroppedCount();
+}
+
 ////////////////////////////////////////////////////////////
 /// xLogInit
 ////////////////////////////////////////////////////////////
@@ -81,19 +465,61 @@ int xLogInit(t_logCtx *p_ptConfig)
             return XOS_LOG_INVALID;
         }
 
-        s_ptLogFile = fopen(s_tLogConfig.t_cLogPath, "w");
-        if (s_ptLogFile == NULL)
+        if (s_tLogConfig.t_bBinary)
         {
+            // Binary records go to the mapped file, the text path only serves the console
+            l_iRet = xLogBinaryOpen(s_tLogConfig.t_cLogPath, s_tLogConfig.t_ulBinaryFileSize);
+            if (l_iRet != (int)XOS_LOG_OK)
+            {
+                mutexUnlock(&s_tLogMutex);
+                mutexDestroy(&s_tLogMutex);
+                return l_iRet;
+            }
+            atomic_store(&s_bLogBinary, true);
+        }
+        else
+        {
+            s_ptLogFile = fopen(s_tLogConfig.t_cLogPath, "w");
+            if (s_ptLogFile == NULL)
+            {
+                mutexUnlock(&s_tLogMutex);
+                mutexDestroy(&s_tLogMutex);
+                return XOS_LOG_ERROR;
+            }
+        }
+    }
+
+    // Start the writer task if requested
+    if (s_tLogConfig.t_bAsync)
+    {
+        l_iRet = logAsyncStart();
+        if (l_iRet != (int)XOS_LOG_OK)
+        {
+            if (s_ptLogFile != NULL)
+            {
+                fclose(s_ptLogFile);
+                s_ptLogFile = NULL;
+            }
+            if (atomic_exchange(&s_bLogBinary, false))
+            {
+                xLogBinaryClose();
+            }
             mutexUnlock(&s_tLogMutex);
             mutexDestroy(&s_tLogMutex);
-            return XOS_LOG_ERROR;
+            return l_iRet;
         }
     }
 
     // Mark as initialized
     atomic_store(&s_eLogState, XOS_LOG_STATE_INITIALIZED);
+    atomic_store(&g_iLogMinLevel, (s_tLogConfig.t_eMinLevel <= XOS_LOG_LEVEL_NONE) ?
+                                  (int)s_tLogConfig.t_eMinLevel : (int)XOS_LOG_LEVEL_TRACE);
     mutexUnlock(&s_tLogMutex);
 
+    // The drop counters already exist, the registry reads them when scraped
+    xMetricsRegisterSampled("log_dropped_total", "Log messages dropped on a full queue", XOS_METRIC_COUNTER,
+                            logMetricDropped, NULL);
+
     return XOS_LOG_OK;
 }
 
@@ -114,51 +540,58 @@ int xLogWrite(const char *p_ptkcFile, uint32_t p_ulLine, const char *p_ptkcForma
         return XOS_LOG_NOT_INIT;
     }
 
-    // Initialiser les buffers avec des valeurs sûres
-    char l_cTimestamp[32] = "UnknownTime";
-    char l_cUserMsg[XOS_LOG_MSG_SIZE] = {0};
-    char l_cFullMsg[XOS_LOG_MSG_SIZE + 128] = {0};
-    const char *l_pcFileName = "UnknownFile";
-    
-    // Récupération sécurisée de l'horodatage
-    const char *l_pcTimestamp = xHorodateurGetString();
-    if (l_pcTimestamp != NULL)
+    // Binary mode: store the raw arguments, no formatting on the target
+    if (atomic_load_explicit(&s_bLogBinary, memory_order_relaxed))
     {
-        strncpy(l_cTimestamp, l_pcTimestamp, sizeof(l_cTimestamp) - 1);
-        l_cTimestamp[sizeof(l_cTimestamp) - 1] = '\0';
-    }
+        atomic_fetch_add(&s_iLogInFlight, 1);
 
-    // Extraction sécurisée du nom de fichier
-    if (p_ptkcFile != NULL)
-    {
-        l_pcFileName = p_ptkcFile;
-        const char *l_pcLastSlash = strrchr(p_ptkcFile, '/');
-        if (l_pcLastSlash != NULL)
+        // Verify we're still initialized once registered as in flight
+        if (atomic_load(&s_eLogState) != XOS_LOG_STATE_INITIALIZED)
         {
-            l_pcFileName = l_pcLastSlash + 1;
+            atomic_fetch_sub(&s_iLogInFlight, 1);
+            return XOS_LOG_NOT_INIT;
         }
-        else
+
+        va_list args;
+        va_start(args, p_ptkcFormat);
+        int l_iRet = xLogBinaryWrite(p_ptkcFile, p_ulLine, p_ptkcFormat, args);
+        va_end(args);
+
+        atomic_fetch_sub(&s_iLogInFlight, 1);
+        if (!s_tLogConfig.t_bLogToConsole)
         {
-            l_pcLastSlash = strrchr(p_ptkcFile, '\\');
-            if (l_pcLastSlash != NULL)
-            {
-                l_pcFileName = l_pcLastSlash + 1;
-            }
+            return l_iRet;
         }
     }
 
-    // Format user message with va_args (outside mutex)
+    // Asynchronous mode: queue the record, the writer task does the I/O
+    if (atomic_load_explicit(&s_bLogAsync, memory_order_relaxed))
+    {
+        atomic_fetch_add(&s_iLogInFlight, 1);
+
+        // Verify we're still initialized once registered as in flight
+        if (atomic_load(&s_eLogState) != XOS_LOG_STATE_INITIALIZED)
+        {
+            atomic_fetch_sub(&s_iLogInFlight, 1);
+            return XOS_LOG_NOT_INIT;
+        }
+
+        va_list args;
+        va_start(args, p_ptkcFormat);
+        int l_iRet = logAsyncWrite(p_ptkcFile, p_ulLine, p_ptkcFormat, args);
+        va_end(args);
+
+        atomic_fetch_sub(&s_iLogInFlight, 1);
+        return l_iRet;
+    }
+
+    // Format complete log message (outside mutex)
+    char l_cFullMsg[XOS_LOG_RECORD_SIZE];
     va_list args;
     va_start(args, p_ptkcFormat);
-    vsnprintf(l_cUserMsg, sizeof(l_cUserMsg) - 1, p_ptkcFormat, args);
-    l_cUserMsg[sizeof(l_cUserMsg) - 1] = '\0'; // Garantie de terminaison
+    logFormat(l_cFullMsg, sizeof(l_cFullMsg), p_ptkcFile, p_ulLine, p_ptkcFormat, args);
     va_end(args);
 
-    // Format complete log message
-    snprintf(l_cFullMsg, sizeof(l_cFullMsg) - 1, "%s | %s:%u | %s\n",
-             l_cTimestamp, l_pcFileName, p_ulLine, l_cUserMsg);
-    l_cFullMsg[sizeof(l_cFullMsg) - 1] = '\0'; // Garantie de terminaison
-
     // Now lock mutex only for the actual I/O operations
     int l_iRet = mutexLock(&s_tLogMutex);
     if (l_iRet != (int)MUTEX_OK)
@@ -191,6 +624,72 @@ int xLogWrite(const char *p_ptkcFile, uint32_t p_ulLine, const char *p_ptkcForma
     return XOS_LOG_OK;
 }
 
+////////////////////////////////////////////////////////////
+/// xLogFlush
+////////////////////////////////////////////////////////////
+int xLogFlush(void)
+{
+    if (atomic_load(&s_eLogState) != XOS_LOG_STATE_INITIALIZED)
+    {
+        return XOS_LOG_NOT_INIT;
+    }
+
+    if (!atomic_load(&s_bLogAsync))
+    {
+        return XOS_LOG_OK;
+    }
+
+    // Wait for the writer to pass every position claimed so far
+    size_t l_ulTarget = atomic_load(&s_tLogAsync.a_ulEnqueuePos);
+    while ((intptr_t)(atomic_load(&s_tLogAsync.a_ulDequeuePos) - l_ulTarget) < 0)
+    {
+        if (atomic_exchange(&s_tLogAsync.a_iWriterIdle, 0))
+        {
+            osSemPost(&s_tLogAsync.t_tWakeSem);
+        }
+        sched_yield();
+    }
+
+    return XOS_LOG_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xLogGetDroppedCount
+////////////////////////////////////////////////////////////
+uint64_t xLogGetDroppedCount(void)
+{
+    return (uint64_t)atomic_load_explicit(&s_tLogAsync.a_ulDropped, memory_order_relaxed) +
+           xLogBinaryGetDroppedCount();
+}
+
+////////////////////////////////////////////////////////////
+/// xLogSetLevel
+////////////////////////////////////////////////////////////
+int xLogSetLevel(t_logLevel p_eLevel)
+{
+    if (p_eLevel < XOS_LOG_LEVEL_TRACE || p_eLevel > XOS_LOG_LEVEL_NONE)
+    {
+        return XOS_LOG_INVALID;
+    }
+
+    if (atomic_load(&s_eLogState) != XOS_LOG_STATE_INITIALIZED)
+    {
+        return XOS_LOG_NOT_INIT;
+    }
+
+    s_tLogConfig.t_eMinLevel = p_eLevel;
+    atomic_store(&g_iLogMinLevel, (int)p_eLevel);
+    return XOS_LOG_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xLogGetLevel
+////////////////////////////////////////////////////////////
+t_logLevel xLogGetLevel(void)
+{
+    return (t_logLevel)atomic_load(&g_iLogMinLevel);
+}
+
 ////////////////////////////////////////////////////////////
 /// xLogClose
 ////////////////////////////////////////////////////////////
@@ -216,6 +715,23 @@ int xLogClose(void)
         return XOS_LOG_NOT_INIT;
     }
 
+    // Mark as uninitialized first (prevents new logging operations)
+    atomic_store(&g_iLogMinLevel, XOS_LOG_LEVEL_NONE);
+    atomic_store(&s_eLogState, XOS_LOG_STATE_UNINITIALIZED);
+
+    // Write every queued message before closing the sinks
+    logWaitInFlight();
+    if (atomic_load(&s_bLogAsync))
+    {
+        logAsyncStop();
+    }
+
+    // Truncate the binary file to its records
+    if (atomic_exchange(&s_bLogBinary, false))
+    {
+        xLogBinaryClose();
+    }
+
     // Close log file if open
     if (s_ptLogFile != NULL)
     {
@@ -223,9 +739,6 @@ int xLogClose(void)
         s_ptLogFile = NULL;
     }
 
-    // Mark as uninitialized first (prevents new logging operations)
-    atomic_store(&s_eLogState, XOS_LOG_STATE_UNINITIALIZED);
-
     // Release mutex and destroy it
     mutexUnlock(&s_tLogMutex);
     mutexDestroy(&s_tLogMutex);
@@ -12,6 +12,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdatomic.h>
 
 // Log error codes
 #define XOS_LOG_OK            0x9E82F70
@@ -19,10 +20,42 @@
 #define XOS_LOG_INVALID       0x9E82F72
 #define XOS_LOG_NOT_INIT      0x9E82F73
 #define XOS_LOG_MUTEX_ERROR   0x9E82F74
+#define XOS_LOG_DROPPED       0x9E82F75
 
 // Log buffer sizes
 #define XOS_LOG_PATH_SIZE    256
 #define XOS_LOG_MSG_SIZE     1024
+#define XOS_LOG_RECORD_SIZE  (XOS_LOG_MSG_SIZE + 128) // Formatted line (timestamp, location, message)
+
+// Asynchronous mode defaults
+#define XOS_LOG_ASYNC_DEFAULT_CAPACITY 1024  // Ring buffer records (power of two)
+#define XOS_LOG_ASYNC_BATCH            64    // Records written by one writev() call
+#define XOS_LOG_ASYNC_IDLE_MS          100   // Writer sleep when the ring is empty
+
+// Log levels, a message is written if its level is >= the minimum level
+typedef enum
+{
+    XOS_LOG_LEVEL_TRACE = 0,
+    XOS_LOG_LEVEL_DEBUG,
+    XOS_LOG_LEVEL_INFO,
+    XOS_LOG_LEVEL_WARN,
+    XOS_LOG_LEVEL_ERROR,
+    XOS_LOG_LEVEL_NONE          // Disables every leveled macro
+} t_logLevel;
+
+// Lowest level compiled in, calls below it are removed by the preprocessor
+// e.g. -DXOS_LOG_COMPILE_LEVEL=2 removes X_LOG_TRACE and X_LOG_DEBUG
+#ifndef XOS_LOG_COMPILE_LEVEL
+#define XOS_LOG_COMPILE_LEVEL 0
+#endif
+
+// Behaviour of the asynchronous mode when the ring buffer is full
+typedef enum
+{
+    XOS_LOG_OVERFLOW_DROP = 0,    // Drop the message silently, xLogWrite returns XOS_LOG_DROPPED
+    XOS_LOG_OVERFLOW_BLOCK,       // Wait for the writer to make room
+    XOS_LOG_OVERFLOW_COUNT        // Drop the message and log the number of drops
+} t_logOverflowPolicy;
 
 // Log configuration structure
 typedef struct
@@ -30,8 +63,18 @@ typedef struct
     bool t_bLogToFile;            // Enable file logging
     bool t_bLogToConsole;         // Enable console logging
     char t_cLogPath[XOS_LOG_PATH_SIZE]; // Log file path
+    bool t_bAsync;                // Queue messages to a writer task instead of writing them
+    uint32_t t_ulAsyncCapacity;   // Ring buffer records (0 = XOS_LOG_ASYNC_DEFAULT_CAPACITY)
+    t_logOverflowPolicy t_eOverflowPolicy; // Ring buffer full behaviour
+    t_logLevel t_eMinLevel;       // Runtime minimum level (0 = TRACE, everything)
+    bool t_bBinary;               // Write binary records to a mapped file instead of text, see xLogBinary.h
+    uint32_t t_ulBinaryFileSize;  // Mapped file size in bytes (0 = XOS_LOG_BIN_DEFAULT_SIZE)
 } t_logCtx;
 
+// Runtime minimum level, XOS_LOG_LEVEL_NONE while the logger is closed
+// Read by the macros before any argument is evaluated
+extern atomic_int g_iLogMinLevel;
+
 //////////////////////////////////
 /// @brief Initialize logging system
 /// @param p_ptConfig : log configuration
@@ -48,14 +91,84 @@ int xLogInit(t_logCtx* p_ptConfig);
 //////////////////////////////////
 int xLogWrite(const char* p_ptkcFile, uint32_t p_ulLine, const char* p_ptkcFormat, ...);
 
+//////////////////////////////////
+/// @brief Wait until every queued message is written
+/// @return success or error code
+/// @note returns immediately in synchronous mode
+//////////////////////////////////
+int xLogFlush(void);
+
+//////////////////////////////////
+/// @brief Get the number of messages dropped because the ring or the binary file was full
+/// @return number of dropped messages
+//////////////////////////////////
+uint64_t xLogGetDroppedCount(void);
+
+//////////////////////////////////
+/// @brief Change the runtime minimum level
+/// @param p_eLevel : new minimum level
+/// @return success or error code
+//////////////////////////////////
+int xLogSetLevel(t_logLevel p_eLevel);
+
+//////////////////////////////////
+/// @brief Get the runtime minimum level
+/// @return minimum level
+//////////////////////////////////
+t_logLevel xLogGetLevel(void);
+
 //////////////////////////////////
 /// @brief Close logging system
 /// @return success or error code
+/// @note in asynchronous mode, every message accepted before the call is written
 //////////////////////////////////
 int xLogClose(void);
 
+// Runtime level check, a relaxed load only
+#define X_LOG_ENABLED(level) \
+    ((int)(level) >= atomic_load_explicit(&g_iLogMinLevel, memory_order_relaxed))
+
+// Leveled write, arguments are only evaluated when the level is enabled
+#define X_LOG_LEVEL(level, prefix, msg, ...) \
+    do { \
+        if (__builtin_expect(X_LOG_ENABLED(level), 0)) \
+        { \
+            xLogWrite(__FILE__, __LINE__, prefix msg, ##__VA_ARGS__); \
+        } \
+    } while (0)
+
 // Log macros
-#define X_LOG_TRACE(msg, ...) xLogWrite(__FILE__, __LINE__, "TRACE | " msg, ##__VA_ARGS__)
+#if XOS_LOG_COMPILE_LEVEL <= 0
+#define X_LOG_TRACE(msg, ...) X_LOG_LEVEL(XOS_LOG_LEVEL_TRACE, "TRACE | ", msg, ##__VA_ARGS__)
+#else
+#define X_LOG_TRACE(msg, ...) do { } while (0)
+#endif
+
+#if XOS_LOG_COMPILE_LEVEL <= 1
+#define X_LOG_DEBUG(msg, ...) X_LOG_LEVEL(XOS_LOG_LEVEL_DEBUG, "DEBUG | ", msg, ##__VA_ARGS__)
+#else
+#define X_LOG_DEBUG(msg, ...) do { } while (0)
+#endif
+
+#if XOS_LOG_COMPILE_LEVEL <= 2
+#define X_LOG_INFO(msg, ...) X_LOG_LEVEL(XOS_LOG_LEVEL_INFO, "INFO | ", msg, ##__VA_ARGS__)
+#else
+#define X_LOG_INFO(msg, ...) do { } while (0)
+#endif
+
+#if XOS_LOG_COMPILE_LEVEL <= 3
+#define X_LOG_WARN(msg, ...) X_LOG_LEVEL(XOS_LOG_LEVEL_WARN, "WARN | ", msg, ##__VA_ARGS__)
+#else
+#define X_LOG_WARN(msg, ...) do { } while (0)
+#endif
+
+#if XOS_LOG_COMPILE_LEVEL <= 4
+#define X_LOG_ERROR(msg, ...) X_LOG_LEVEL(XOS_LOG_LEVEL_ERROR, "ERROR | ", msg, ##__VA_ARGS__)
+#else
+#define X_LOG_ERROR(msg, ...) do { } while (0)
+#endif
+
+// Assertion messages ignore the levels
 #define X_LOG_ASSERT(msg, ...) xLogWrite(__FILE__, __LINE__, "ASSERT | " msg, ##__VA_ARGS__)
 
 #endif // XOS_LOG_H_
@@ -0,0 +1,390 @@
+////////////////////////////////////////////////////////////
+//  binary log source file
+//  implements the memory-mapped binary log writer
+//
+// general discloser: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+
+#include "xLogBinary.h"
+#include "xLog.h"
+#include "xOsHorodateur.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#define XOS_LOG_BIN_ALIGN(size)   (((size) + 7U) & ~(uint64_t)7U)
+#define XOS_LOG_BIN_MAX_PAYLOAD   (2 * XOS_LOG_MSG_SIZE) // Message payload limit
+
+// Call site registered in the format table
+typedef struct
+{
+    atomic_uint a_ulId;                     // Format id, 0 while the slot is free
+    const char* t_ptkcFormat;               // Format string (key)
+    const char* t_ptkcFile;                 // Source file (key)
+    uint32_t t_ulLine;                      // Line number (key)
+    uint8_t t_ucArgCount;                   // Recorded arguments
+    uint8_t t_ucKinds[XOS_LOG_BIN_MAX_ARGS]; // t_logBinVaKind of each argument
+} t_logBinSite;
+
+// Writer state
+static int s_iBinFd = -1;
+static uint8_t* s_pucBinBase = NULL;
+static uint64_t s_ulBinCapacity = 0;
+static atomic_uint_fast64_t s_ulBinOffset = ATOMIC_VAR_INIT(0);
+static atomic_ullong s_ulBinDropped = ATOMIC_VAR_INIT(0);
+static t_logBinSite s_tBinSites[XOS_LOG_BIN_MAX_FORMATS];
+static uint32_t s_ulBinNextId = 1;
+static pthread_mutex_t s_tBinSiteMutex = PTHREAD_MUTEX_INITIALIZER;
+
+static __thread uint32_t s_ulBinThreadId = 0;
+
+//
+// Reserves a record, returns NULL when the file is full
+//
+static t_logBinRecord* binReserve(uint32_t p_ulPayloadSize)
+{
+    uint64_t l_ulSize = XOS_LOG_BIN_ALIGN(sizeof(t_logBinRecord) + p_ulPayloadSize);
+    uint64_t l_ulOffset = atomic_fetch_add_explicit(&s_ulBinOffset, l_ulSize, memory_order_relaxed);
+
+    if (l_ulOffset + l_ulSize > s_ulBinCapacity)
+    {
+        atomic_fetch_add_explicit(&s_ulBinDropped, 1, memory_order_relaxed);
+        return NULL;
+    }
+
+    return (t_logBinRecord*)(s_pucBinBase + l_ulOffset);
+}
+
+//
+// Fills the record header, the commit word is written last by binCommit
+//
+static inline void binFillHeader(t_logBinRecord* p_ptRecord, uint32_t p_ulId, uint32_t p_ulPayloadSize)
+{
+    if (s_ulBinThreadId == 0)
+    {
+        s_ulBinThreadId = (uint32_t)syscall(SYS_gettid);
+    }
+
+    p_ptRecord->t_ulFormatId = p_ulId;
+    p_ptRecord->t_ulTimestampNs = xHorodateurGetNs();
+    p_ptRecord->t_ulThreadId = s_ulBinThreadId;
+    p_ptRecord->t_ulPayloadSize = p_ulPayloadSize;
+}
+
+//
+// Publishes the record to readers of the file
+//
+static inline void binCommit(t_logBinRecord* p_ptRecord, uint32_t p_ulType)
+{
+    __atomic_store_n(&p_ptRecord->t_ulCommit, XOS_LOG_BIN_COMMIT_MAGIC | p_ulType, __ATOMIC_RELEASE);
+}
+
+//
+// Hash of a call site key
+//
+static inline uint32_t binSiteHash(const char* p_ptkcFormat, uint32_t p_ulLine)
+{
+    uint64_t l_ulKey = (uint64_t)(uintptr_t)p_ptkcFormat ^ ((uint64_t)p_ulLine << 32);
+    l_ulKey *= 0x9E3779B97F4A7C15ULL;
+    return (uint32_t)(l_ulKey >> 40) & (XOS_LOG_BIN_MAX_FORMATS - 1);
+}
+
+//
+// Registers a call site and writes its format record, called on the first message
+//
+static t_logBinSite* binSiteCreate(const char* p_ptkcFile, uint32_t p_ulLine, const char* p_ptkcFormat)
+{
+    t_logBinSite* l_ptSite = NULL;
+    uint32_t l_ulSlot = binSiteHash(p_ptkcFormat, p_ulLine);
+
+    pthread_mutex_lock(&s_tBinSiteMutex);
+
+    for (uint32_t i = 0; i < XOS_LOG_BIN_MAX_FORMATS; i++)
+    {
+        t_logBinSite* l_ptCur = &s_tBinSites[(l_ulSlot + i) & (XOS_LOG_BIN_MAX_FORMATS - 1)];
+        if (atomic_load_explicit(&l_ptCur->a_ulId, memory_order_relaxed) == 0)
+        {
+            l_ptSite = l_ptCur;
+            break;
+        }
+        if (l_ptCur->t_ptkcFormat == p_ptkcFormat && l_ptCur->t_ulLine == p_ulLine && l_ptCur->t_ptkcFile == p_ptkcFile)
+        {
+            // Registered by another thread meanwhile
+            pthread_mutex_unlock(&s_tBinSiteMutex);
+            return l_ptCur;
+        }
+    }
+
+    if (l_ptSite == NULL)
+    {
+        pthread_mutex_unlock(&s_tBinSiteMutex);
+        return NULL;
+    }
+
+    // Argument list, in the order they are passed
+    const char* l_pcCur = p_ptkcFormat;
+    t_logBinSpec l_tSpec;
+    uint8_t l_ucCount = 0;
+    while (xLogBinaryNextSpec(l_pcCur, &l_tSpec))
+    {
+        for (uint8_t s = 0; s < l_tSpec.t_ucStars && l_ucCount < XOS_LOG_BIN_MAX_ARGS; s++)
+        {
+            l_ptSite->t_ucKinds[l_ucCount++] = XOS_LOG_BIN_VA_INT;
+        }
+        if (l_tSpec.t_eKind != XOS_LOG_BIN_VA_NONE && l_ucCount < XOS_LOG_BIN_MAX_ARGS)
+        {
+            l_ptSite->t_ucKinds[l_ucCount++] = (uint8_t)l_tSpec.t_eKind;
+        }
+        l_pcCur = l_tSpec.t_pcEnd;
+    }
+    l_ptSite->t_ucArgCount = l_ucCount;
+    l_ptSite->t_ptkcFormat = p_ptkcFormat;
+    l_ptSite->t_ptkcFile = p_ptkcFile;
+    l_ptSite->t_ulLine = p_ulLine;
+
+    // Format record, committed before the id is published so it precedes every message using it
+    const char* l_ptkcFile = (p_ptkcFile != NULL) ? p_ptkcFile : "UnknownFile";
+    size_t l_ulFileLen = strnlen(l_ptkcFile, UINT16_MAX);
+    size_t l_ulFormatLen = strnlen(p_ptkcFormat, UINT16_MAX);
+    uint32_t l_ulPayload = (uint32_t)(sizeof(t_logBinFormat) + l_ulFileLen + l_ulFormatLen);
+
+    t_logBinRecord* l_ptRecord = binReserve(l_ulPayload);
+    if (l_ptRecord == NULL)
+    {
+        pthread_mutex_unlock(&s_tBinSiteMutex);
+        return NULL;
+    }
+
+    uint32_t l_ulId = s_ulBinNextId++;
+    t_logBinFormat l_tFormat = { p_ulLine, (uint16_t)l_ulFileLen, (uint16_t)l_ulFormatLen };
+    uint8_t* l_pucPayload = (uint8_t*)(l_ptRecord + 1);
+    memcpy(l_pucPayload, &l_tFormat, sizeof(l_tFormat));
+    memcpy(l_pucPayload + sizeof(l_tFormat), l_ptkcFile, l_ulFileLen);
+    memcpy(l_pucPayload + sizeof(l_tFormat) + l_ulFileLen, p_ptkcFormat, l_ulFormatLen);
+    binFillHeader(l_ptRecord, l_ulId, l_ulPayload);
+    binCommit(l_ptRecord, XOS_LOG_BIN_RECORD_FORMAT);
+
+    atomic_store_explicit(&l_ptSite->a_ulId, l_ulId, memory_order_release);
+    pthread_mutex_unlock(&s_tBinSiteMutex);
+    return l_ptSite;
+}
+
+//
+// Finds the call site without locking, registers it on a miss
+//
+static inline t_logBinSite* binSiteGet(const char* p_ptkcFile, uint32_t p_ulLine, const char* p_ptkcFormat)
+{
+    uint32_t l_ulSlot = binSiteHash(p_ptkcFormat, p_ulLine);
+
+    for (uint32_t i = 0; i < XOS_LOG_BIN_MAX_FORMATS; i++)
+    {
+        t_logBinSite* l_ptCur = &s_tBinSites[(l_ulSlot + i) & (XOS_LOG_BIN_MAX_FORMATS - 1)];
+        if (atomic_load_explicit(&l_ptCur->a_ulId, memory_order_acquire) == 0)
+        {
+            break;
+        }
+        if (l_ptCur->t_ptkcFormat == p_ptkcFormat && l_ptCur->t_ulLine == p_ulLine && l_ptCur->t_ptkcFile == p_ptkcFile)
+        {
+            return l_ptCur;
+        }
+    }
+
+    return binSiteCreate(p_ptkcFile, p_ulLine, p_ptkcFormat);
+}
+
+////////////////////////////////////////////////////////////
+/// xLogBinaryOpen
+////////////////////////////////////////////////////////////
+int xLogBinaryOpen(const char* p_ptkcPath, uint64_t p_ulSize)
+{
+    if (p_ptkcPath == NULL || p_ptkcPath[0] == '\0')
+    {
+        return XOS_LOG_INVALID;
+    }
+
+    uint64_t l_ulSize = (p_ulSize != 0) ? XOS_LOG_BIN_ALIGN(p_ulSize) : XOS_LOG_BIN_DEFAULT_SIZE;
+    if (l_ulSize < sizeof(t_logBinHeader) + 4096)
+    {
+        return XOS_LOG_INVALID;
+    }
+
+    int l_iFd = open(p_ptkcPath, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (l_iFd < 0)
+    {
+        return XOS_LOG_ERROR;
+    }
+
+    // Reserve the blocks now so a full flash fails here and not on a page fault
+    if (posix_fallocate(l_iFd, 0, (off_t)l_ulSize) != 0 && ftruncate(l_iFd, (off_t)l_ulSize) != 0)
+    {
+        close(l_iFd);
+        return XOS_LOG_ERROR;
+    }
+
+    void* l_ptMap = mmap(NULL, (size_t)l_ulSize, PROT_READ | PROT_WRITE, MAP_SHARED, l_iFd, 0);
+    if (l_ptMap == MAP_FAILED)
+    {
+        close(l_iFd);
+        return XOS_LOG_ERROR;
+    }
+
+    // File header, with both clocks so the decoder can print wall time
+    t_logBinHeader* l_ptHeader = (t_logBinHeader*)l_ptMap;
+    struct tm l_tLocal;
+    time_t l_tNow = time(NULL);
+    memcpy(l_ptHeader->t_cMagic, XOS_LOG_BIN_MAGIC, sizeof(l_ptHeader->t_cMagic));
+    l_ptHeader->t_ulVersion = XOS_LOG_BIN_VERSION;
+    l_ptHeader->t_ulHeaderSize = sizeof(t_logBinHeader);
+    l_ptHeader->t_ulMonotonicBaseNs = xHorodateurGetNs();
+    l_ptHeader->t_ulRealtimeBaseNs = xHorodateurGetRealtimeNs();
+    l_ptHeader->t_iUtcOffsetSec = (localtime_r(&l_tNow, &l_tLocal) != NULL) ? (int32_t)l_tLocal.tm_gmtoff : 0;
+    l_ptHeader->t_ulReserved = 0;
+    l_ptHeader->t_ulCapacity = l_ulSize;
+
+    memset(s_tBinSites, 0, sizeof(s_tBinSites));
+    s_ulBinNextId = 1;
+    s_iBinFd = l_iFd;
+    s_pucBinBase = (uint8_t*)l_ptMap;
+    s_ulBinCapacity = l_ulSize;
+    atomic_store(&s_ulBinDropped, 0);
+    atomic_store(&s_ulBinOffset, XOS_LOG_BIN_ALIGN(sizeof(t_logBinHeader)));
+
+    return XOS_LOG_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xLogBinaryWrite
+////////////////////////////////////////////////////////////
+int xLogBinaryWrite(const char* p_ptkcFile, uint32_t p_ulLine, const char* p_ptkcFormat, va_list p_tArgs)
+{
+    if (s_pucBinBase == NULL)
+    {
+        return XOS_LOG_NOT_INIT;
+    }
+
+    t_logBinSite* l_ptSite = binSiteGet(p_ptkcFile, p_ulLine, p_ptkcFormat);
+    if (l_ptSite == NULL)
+    {
+        return XOS_LOG_DROPPED;
+    }
+
+    // Serialize the arguments, strings are cut to what fits
+    uint8_t l_ucPayload[XOS_LOG_BIN_MAX_PAYLOAD];
+    uint32_t l_ulUsed = 0;
+    for (uint8_t i = 0; i < l_ptSite->t_ucArgCount; i++)
+    {
+        int32_t l_iValue;
+        uint64_t l_ulValue;
+        double l_dValue;
+
+        switch ((t_logBinVaKind)l_ptSite->t_ucKinds[i])
+        {
+            case XOS_LOG_BIN_VA_INT:
+                l_iValue = (int32_t)va_arg(p_tArgs, int);
+                memcpy(l_ucPayload + l_ulUsed, &l_iValue, sizeof(l_iValue));
+                l_ulUsed += sizeof(l_iValue);
+                continue;
+            case XOS_LOG_BIN_VA_LONG:    l_ulValue = (uint64_t)va_arg(p_tArgs, long);           break;
+            case XOS_LOG_BIN_VA_LLONG:   l_ulValue = (uint64_t)va_arg(p_tArgs, long long);      break;
+            case XOS_LOG_BIN_VA_SIZE:    l_ulValue = (uint64_t)va_arg(p_tArgs, size_t);         break;
+            case XOS_LOG_BIN_VA_PTRDIFF: l_ulValue = (uint64_t)va_arg(p_tArgs, ptrdiff_t);      break;
+            case XOS_LOG_BIN_VA_INTMAX:  l_ulValue = (uint64_t)va_arg(p_tArgs, intmax_t);       break;
+            case XOS_LOG_BIN_VA_POINTER: l_ulValue = (uint64_t)(uintptr_t)va_arg(p_tArgs, void*); break;
+            case XOS_LOG_BIN_VA_DOUBLE:
+            case XOS_LOG_BIN_VA_LDOUBLE:
+                l_dValue = (l_ptSite->t_ucKinds[i] == XOS_LOG_BIN_VA_DOUBLE) ?
+                           va_arg(p_tArgs, double) : (double)va_arg(p_tArgs, long double);
+                memcpy(&l_ulValue, &l_dValue, sizeof(l_ulValue));
+                break;
+            case XOS_LOG_BIN_VA_STRING:
+            {
+                const char* l_pcString = va_arg(p_tArgs, const char*);
+                if (l_pcString == NULL)
+                {
+                    l_pcString = "(null)";
+                }
+                // Room left once the following arguments are accounted for at their largest fixed size
+                size_t l_ulReserved = l_ulUsed + sizeof(uint16_t) +
+                                      (size_t)(l_ptSite->t_ucArgCount - i - 1) * sizeof(uint64_t);
+                size_t l_ulMax = (l_ulReserved < sizeof(l_ucPayload)) ? sizeof(l_ucPayload) - l_ulReserved : 0;
+                if (l_ulMax > XOS_LOG_BIN_MAX_STRING)
+                {
+                    l_ulMax = XOS_LOG_BIN_MAX_STRING;
+                }
+                uint16_t l_usLength = (uint16_t)strnlen(l_pcString, l_ulMax);
+                memcpy(l_ucPayload + l_ulUsed, &l_usLength, sizeof(l_usLength));
+                memcpy(l_ucPayload + l_ulUsed + sizeof(l_usLength), l_pcString, l_usLength);
+                l_ulUsed += sizeof(l_usLength) + l_usLength;
+                continue;
+            }
+            default:
+                continue;
+        }
+
+        memcpy(l_ucPayload + l_ulUsed, &l_ulValue, sizeof(l_ulValue));
+        l_ulUsed += sizeof(l_ulValue);
+    }
+
+    t_logBinRecord* l_ptRecord = binReserve(l_ulUsed);
+    if (l_ptRecord == NULL)
+    {
+        return XOS_LOG_DROPPED;
+    }
+
+    memcpy(l_ptRecord + 1, l_ucPayload, l_ulUsed);
+    binFillHeader(l_ptRecord, atomic_load_explicit(&l_ptSite->a_ulId, memory_order_relaxed), l_ulUsed);
+    binCommit(l_ptRecord, XOS_LOG_BIN_RECORD_MESSAGE);
+
+    return XOS_LOG_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xLogBinaryGetDroppedCount
+////////////////////////////////////////////////////////////
+uint64_t xLogBinaryGetDroppedCount(void)
+{
+    return (uint64_t)atomic_load_explicit(&s_ulBinDropped, memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////
+/// xLogBinaryClose
+////////////////////////////////////////////////////////////
+int xLogBinaryClose(void)
+{
+    if (s_pucBinBase == NULL)
+    {
+        return XOS_LOG_NOT_INIT;
+    }
+
+    // Keep only the records, a reservation past the end was dropped
+    uint64_t l_ulUsed = atomic_load(&s_ulBinOffset);
+    if (l_ulUsed > s_ulBinCapacity)
+    {
+        l_ulUsed = s_ulBinCapacity;
+    }
+
+    int l_iRet = XOS_LOG_OK;
+    if (msync(s_pucBinBase, (size_t)s_ulBinCapacity, MS_SYNC) != 0)
+    {
+        l_iRet = XOS_LOG_ERROR;
+    }
+    munmap(s_pucBinBase, (size_t)s_ulBinCapacity);
+    s_pucBinBase = NULL;
+
+    if (ftruncate(s_iBinFd, (off_t)l_ulUsed) != 0)
+    {
+        l_iRet = XOS_LOG_ERROR;
+    }
+    close(s_iBinFd);
+    s_iBinFd = -1;
+    s_ulBinCapacity = 0;
+
+    return l_iRet;
+}
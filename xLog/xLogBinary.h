@@ -0,0 +1,238 @@
+////////////////////////////////////////////////////////////
+//  binary log header file
+//  defines the binary log file layout and writer functions
+//
+// The file starts with a t_logBinHeader followed by 8-byte aligned
+// records. A format record (XOS_LOG_BIN_RECORD_FORMAT) is written the
+// first time a call site logs and gives its id, file, line and format
+// string. Message records (XOS_LOG_BIN_RECORD_MESSAGE) only carry the
+// id, a monotonic timestamp, the thread id and the raw arguments:
+// - int sized arguments (and '*' widths) : 4 bytes
+// - other integers, pointers, doubles    : 8 bytes
+// - strings                               : uint16 length + bytes
+// Records are committed by writing t_ulCommit last, readers stop at
+// the first record whose commit word is 0
+//
+// general discloser: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+#pragma once
+
+#ifndef XOS_LOG_BINARY_H_
+#define XOS_LOG_BINARY_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <stddef.h>
+
+// File layout
+#define XOS_LOG_BIN_MAGIC             "XLOGBIN1"
+#define XOS_LOG_BIN_VERSION           1
+#define XOS_LOG_BIN_DEFAULT_SIZE      (16 * 1024 * 1024) // Mapped file size when 0 is requested
+#define XOS_LOG_BIN_MAX_FORMATS       1024               // Distinct call sites (power of two)
+#define XOS_LOG_BIN_MAX_ARGS          16                 // Arguments recorded per message
+#define XOS_LOG_BIN_MAX_STRING        1024               // Bytes kept from a string argument
+
+// Record types, stored in the low byte of the commit word
+#define XOS_LOG_BIN_COMMIT_MAGIC      0xB1000000U
+#define XOS_LOG_BIN_RECORD_FORMAT     0x01
+#define XOS_LOG_BIN_RECORD_MESSAGE    0x02
+
+// File header
+typedef struct
+{
+    char t_cMagic[8];               // XOS_LOG_BIN_MAGIC
+    uint32_t t_ulVersion;           // XOS_LOG_BIN_VERSION
+    uint32_t t_ulHeaderSize;        // sizeof(t_logBinHeader)
+    uint64_t t_ulMonotonicBaseNs;   // CLOCK_MONOTONIC at open
+    uint64_t t_ulRealtimeBaseNs;    // CLOCK_REALTIME at open
+    int32_t t_iUtcOffsetSec;        // Local time offset of the target at open
+    uint32_t t_ulReserved;
+    uint64_t t_ulCapacity;          // File size in bytes
+} t_logBinHeader;
+
+// Record header, followed by t_ulPayloadSize bytes and padding to 8 bytes
+typedef struct
+{
+    uint32_t t_ulCommit;            // XOS_LOG_BIN_COMMIT_MAGIC | type, 0 while being written
+    uint32_t t_ulFormatId;          // Call site id
+    uint64_t t_ulTimestampNs;       // CLOCK_MONOTONIC
+    uint32_t t_ulThreadId;          // Kernel thread id
+    uint32_t t_ulPayloadSize;       // Payload bytes
+} t_logBinRecord;
+
+// Format record payload, followed by the file name and the format string
+typedef struct
+{
+    uint32_t t_ulLine;              // Line number
+    uint16_t t_usFileLength;        // File name length
+    uint16_t t_usFormatLength;      // Format string length
+} t_logBinFormat;
+
+// C type of a variadic argument
+typedef enum
+{
+    XOS_LOG_BIN_VA_NONE = 0,        // Literal ('%%' or unknown conversion)
+    XOS_LOG_BIN_VA_INT,             // int and smaller, char
+    XOS_LOG_BIN_VA_LONG,            // long
+    XOS_LOG_BIN_VA_LLONG,           // long long
+    XOS_LOG_BIN_VA_SIZE,            // size_t
+    XOS_LOG_BIN_VA_PTRDIFF,         // ptrdiff_t
+    XOS_LOG_BIN_VA_INTMAX,          // intmax_t
+    XOS_LOG_BIN_VA_DOUBLE,          // double
+    XOS_LOG_BIN_VA_LDOUBLE,         // long double (recorded as double)
+    XOS_LOG_BIN_VA_STRING,          // char*
+    XOS_LOG_BIN_VA_POINTER          // void* (and %n, which is not written)
+} t_logBinVaKind;
+
+// One conversion specification of a format string
+typedef struct
+{
+    const char* t_pcStart;          // '%' character
+    const char* t_pcEnd;            // Character after the conversion
+    char t_cConversion;             // Conversion character
+    uint8_t t_ucStars;              // '*' width/precision arguments before the value
+    t_logBinVaKind t_eKind;         // Value argument type
+} t_logBinSpec;
+
+//////////////////////////////////
+/// @brief Find the next conversion specification of a format string
+/// @param p_pcFormat : position in the format string
+/// @param p_ptSpec : filled with the specification found
+/// @return true if a specification was found
+/// @note shared by the writer and the host decoder so both read the
+///       arguments in the same order
+//////////////////////////////////
+static inline bool xLogBinaryNextSpec(const char* p_pcFormat, t_logBinSpec* p_ptSpec)
+{
+    const char* l_pcCur = p_pcFormat;
+    while (*l_pcCur != '\0' && *l_pcCur != '%')
+    {
+        l_pcCur++;
+    }
+    if (*l_pcCur == '\0')
+    {
+        return false;
+    }
+
+    p_ptSpec->t_pcStart = l_pcCur++;
+    p_ptSpec->t_ucStars = 0;
+    p_ptSpec->t_eKind = XOS_LOG_BIN_VA_NONE;
+
+    // Flags, width, precision
+    while (*l_pcCur == '-' || *l_pcCur == '+' || *l_pcCur == ' ' || *l_pcCur == '#' || *l_pcCur == '0' || *l_pcCur == '\'')
+    {
+        l_pcCur++;
+    }
+    if (*l_pcCur == '*')
+    {
+        p_ptSpec->t_ucStars++;
+        l_pcCur++;
+    }
+    while (*l_pcCur >= '0' && *l_pcCur <= '9')
+    {
+        l_pcCur++;
+    }
+    if (*l_pcCur == '.')
+    {
+        l_pcCur++;
+        if (*l_pcCur == '*')
+        {
+            p_ptSpec->t_ucStars++;
+            l_pcCur++;
+        }
+        while (*l_pcCur >= '0' && *l_pcCur <= '9')
+        {
+            l_pcCur++;
+        }
+    }
+
+    // Length modifier
+    t_logBinVaKind l_eInteger = XOS_LOG_BIN_VA_INT;
+    bool l_bLongDouble = false;
+    switch (*l_pcCur)
+    {
+        case 'h':
+            l_pcCur += (l_pcCur[1] == 'h') ? 2 : 1;
+            break;
+        case 'l':
+            if (l_pcCur[1] == 'l')
+            {
+                l_eInteger = XOS_LOG_BIN_VA_LLONG;
+                l_pcCur += 2;
+            }
+            else
+            {
+                l_eInteger = XOS_LOG_BIN_VA_LONG;
+                l_pcCur++;
+            }
+            break;
+        case 'q': l_eInteger = XOS_LOG_BIN_VA_LLONG;   l_pcCur++; break;
+        case 'j': l_eInteger = XOS_LOG_BIN_VA_INTMAX;  l_pcCur++; break;
+        case 'z': l_eInteger = XOS_LOG_BIN_VA_SIZE;    l_pcCur++; break;
+        case 't': l_eInteger = XOS_LOG_BIN_VA_PTRDIFF; l_pcCur++; break;
+        case 'L': l_bLongDouble = true;                l_pcCur++; break;
+        default: break;
+    }
+
+    p_ptSpec->t_cConversion = *l_pcCur;
+    switch (*l_pcCur)
+    {
+        case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+            p_ptSpec->t_eKind = l_eInteger;
+            break;
+        case 'c':
+            p_ptSpec->t_eKind = XOS_LOG_BIN_VA_INT;
+            break;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            p_ptSpec->t_eKind = l_bLongDouble ? XOS_LOG_BIN_VA_LDOUBLE : XOS_LOG_BIN_VA_DOUBLE;
+            break;
+        case 's':
+            p_ptSpec->t_eKind = XOS_LOG_BIN_VA_STRING;
+            break;
+        case 'p': case 'n':
+            p_ptSpec->t_eKind = XOS_LOG_BIN_VA_POINTER;
+            break;
+        default:
+            // '%%' or unsupported conversion, printed as is
+            p_ptSpec->t_ucStars = 0;
+            break;
+    }
+
+    p_ptSpec->t_pcEnd = (*l_pcCur != '\0') ? l_pcCur + 1 : l_pcCur;
+    return true;
+}
+
+//////////////////////////////////
+/// @brief Create and map a binary log file
+/// @param p_ptkcPath : file path
+/// @param p_ulSize : file size in bytes (0 for default)
+/// @return success or error code
+//////////////////////////////////
+int xLogBinaryOpen(const char* p_ptkcPath, uint64_t p_ulSize);
+
+//////////////////////////////////
+/// @brief Append a message record
+/// @param p_ptkcFile : source file
+/// @param p_ulLine : line number
+/// @param p_ptkcFormat : message format
+/// @param p_tArgs : message arguments
+/// @return success, XOS_LOG_DROPPED when the file is full, or error code
+//////////////////////////////////
+int xLogBinaryWrite(const char* p_ptkcFile, uint32_t p_ulLine, const char* p_ptkcFormat, va_list p_tArgs);
+
+//////////////////////////////////
+/// @brief Get the number of records dropped because the file was full
+/// @return number of dropped records
+//////////////////////////////////
+uint64_t xLogBinaryGetDroppedCount(void);
+
+//////////////////////////////////
+/// @brief Unmap the file and truncate it to the written records
+/// @return success or error code
+/// @note writers must be finished
+//////////////////////////////////
+int xLogBinaryClose(void);
+
+#endif // XOS_LOG_BINARY_H_
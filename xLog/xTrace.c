@@ -0,0 +1,445 @@
+////////////////////////////////////////////////////////////
+//  trace source file
+//  implements the per-thread event rings and the Chrome JSON writer
+//
+// general discloser: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+
+#include "xTrace.h"
+#include "xTask.h"
+#include "xOsMutex.h"
+#include "xMemory.h"
+#include "xAssert.h"
+#include "xLog.h"
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+atomic_bool g_bTraceActive = false;
+__thread xTraceBuffer_t* g_ptTraceBuffer = NULL;
+
+static __thread char s_cThreadName[XOS_TRACE_NAME_SIZE];
+static __thread bool s_bRegistering = false;
+
+//////////////////////////////////
+/// @brief trace writer state
+//////////////////////////////////
+typedef struct xos_trace_service_t
+{
+    _Atomic(xTraceBuffer_t*) a_ptBuffers;   // Registered rings, pushed at the head
+    atomic_uint a_ulEvents;                 // Ring size of the next registrations
+    pthread_once_t t_tOnce;
+    pthread_key_t t_tExitKey;               // Marks the ring of an ending thread
+    xOsMutexCtx t_tMutex;                   // Drain, file and thread names
+    FILE* t_ptFile;
+    bool t_bFirstEvent;
+    int t_iPid;
+    uint64_t t_ulBaseTicks;                 // Counter and time at xTraceStart
+    uint64_t t_ulBaseNs;
+    double t_dNsPerTick;
+    uint64_t t_ulDroppedFreed;              // Drops of the rings already freed
+    atomic_bool a_bRunning;
+    xOsTaskCtx t_tTask;
+} xTraceService_t;
+
+static xTraceService_t s_tTrace = {
+    .t_tOnce = PTHREAD_ONCE_INIT,
+    .a_ulEvents = XOS_TRACE_DEFAULT_EVENTS,
+    .t_dNsPerTick = 1.0,
+};
+
+////////////////////////////////////////////////////////////
+/// traceNowNs
+////////////////////////////////////////////////////////////
+static uint64_t traceNowNs(void)
+{
+    struct timespec l_tNow;
+    clock_gettime(CLOCK_MONOTONIC, &l_tNow);
+    return (uint64_t)l_tNow.tv_sec * 1000000000ULL + (uint64_t)l_tNow.tv_nsec;
+}
+
+////////////////////////////////////////////////////////////
+/// traceThreadExit
+////////////////////////////////////////////////////////////
+static void traceThreadExit(void* p_pvBuffer)
+{
+    // The flusher frees the ring once it has written what is left in it
+    g_ptTraceBuffer = NULL;
+    atomic_store_explicit(&((xTraceBuffer_t*)p_pvBuffer)->a_bExited, true, memory_order_release);
+}
+
+////////////////////////////////////////////////////////////
+/// traceInitOnce
+////////////////////////////////////////////////////////////
+static void traceInitOnce(void)
+{
+    pthread_key_create(&s_tTrace.t_tExitKey, traceThreadExit);
+    mutexCreate(&s_tTrace.t_tMutex);
+}
+
+////////////////////////////////////////////////////////////
+/// xTraceRegisterThread
+////////////////////////////////////////////////////////////
+xTraceBuffer_t* xTraceRegisterThread(void)
+{
+    // The allocation below may take a traced lock, whose event comes back here
+    if (s_bRegistering)
+        return NULL;
+    s_bRegistering = true;
+
+    pthread_once(&s_tTrace.t_tOnce, traceInitOnce);
+
+    uint32_t l_ulEvents = atomic_load_explicit(&s_tTrace.a_ulEvents, memory_order_relaxed);
+    xTraceBuffer_t* l_ptBuffer = (xTraceBuffer_t*)X_MALLOC(sizeof(xTraceBuffer_t));
+    xTraceEvent_t* l_ptEvents = (xTraceEvent_t*)X_MALLOC((size_t)l_ulEvents * sizeof(xTraceEvent_t));
+    if (l_ptBuffer == NULL || l_ptEvents == NULL)
+    {
+        if (l_ptBuffer)
+            X_FREE(l_ptBuffer);
+        if (l_ptEvents)
+            X_FREE(l_ptEvents);
+        s_bRegistering = false;
+        return NULL;
+    }
+
+    // Touched now, the first lap of the ring would otherwise fault on the traced path
+    memset(l_ptEvents, 0, (size_t)l_ulEvents * sizeof(xTraceEvent_t));
+    memset(l_ptBuffer, 0, sizeof(*l_ptBuffer));
+    l_ptBuffer->t_ulMask = (uint64_t)l_ulEvents - 1;
+    l_ptBuffer->t_ptEvents = l_ptEvents;
+    l_ptBuffer->t_iTid = (int)syscall(SYS_gettid);
+    if (s_cThreadName[0] != '\0')
+        memcpy(l_ptBuffer->t_cName, s_cThreadName, sizeof(l_ptBuffer->t_cName));
+    else if (pthread_getname_np(pthread_self(), l_ptBuffer->t_cName, sizeof(l_ptBuffer->t_cName)) != 0)
+        snprintf(l_ptBuffer->t_cName, sizeof(l_ptBuffer->t_cName), "thread %d", l_ptBuffer->t_iTid);
+
+    pthread_setspecific(s_tTrace.t_tExitKey, l_ptBuffer);
+
+    // Only the flusher unlinks, and never the head being pushed
+    xTraceBuffer_t* l_ptHead = atomic_load_explicit(&s_tTrace.a_ptBuffers, memory_order_relaxed);
+    do
+    {
+        l_ptBuffer->t_ptNext = l_ptHead;
+    } while (!atomic_compare_exchange_weak_explicit(&s_tTrace.a_ptBuffers, &l_ptHead, l_ptBuffer,
+                                                    memory_order_release, memory_order_relaxed));
+
+    g_ptTraceBuffer = l_ptBuffer;
+    s_bRegistering = false;
+    return l_ptBuffer;
+}
+
+////////////////////////////////////////////////////////////
+/// traceWriteString
+////////////////////////////////////////////////////////////
+static void traceWriteString(FILE* p_ptFile, const char* p_pcText)
+{
+    fputc('"', p_ptFile);
+    for (const char* l_pcCur = p_pcText; *l_pcCur != '\0'; l_pcCur++)
+    {
+        unsigned char l_ucChar = (unsigned char)*l_pcCur;
+        if (l_ucChar == '"' || l_ucChar == '\\')
+        {
+            fputc('\\', p_ptFile);
+            fputc(l_ucChar, p_ptFile);
+        }
+        else if (l_ucChar < 0x20)
+        {
+            fprintf(p_ptFile, "\\u%04x", l_ucChar);
+        }
+        else
+        {
+            fputc(l_ucChar, p_ptFile);
+        }
+    }
+    fputc('"', p_ptFile);
+}
+
+////////////////////////////////////////////////////////////
+/// traceWriteSeparator
+////////////////////////////////////////////////////////////
+static void traceWriteSeparator(xTraceService_t* p_ptTrace)
+{
+    fputs(p_ptTrace->t_bFirstEvent ? "\n" : ",\n", p_ptTrace->t_ptFile);
+    p_ptTrace->t_bFirstEvent = false;
+}
+
+////////////////////////////////////////////////////////////
+/// traceWriteThreadName
+////////////////////////////////////////////////////////////
+static void traceWriteThreadName(xTraceService_t* p_ptTrace, const xTraceBuffer_t* p_ptBuffer)
+{
+    traceWriteSeparator(p_ptTrace);
+    fprintf(p_ptTrace->t_ptFile, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":",
+            p_ptTrace->t_iPid, p_ptBuffer->t_iTid);
+    traceWriteString(p_ptTrace->t_ptFile, p_ptBuffer->t_cName);
+    fputs("}}", p_ptTrace->t_ptFile);
+}
+
+////////////////////////////////////////////////////////////
+/// traceWriteEvent
+////////////////////////////////////////////////////////////
+static void traceWriteEvent(xTraceService_t* p_ptTrace, const xTraceBuffer_t* p_ptBuffer, const xTraceEvent_t* p_ptEvent)
+{
+    static const char s_cPhases[] = { 'B', 'E', 'i', 'C' };
+    if (p_ptEvent->t_ulType > XOS_TRACE_EVENT_COUNTER || p_ptEvent->t_pcName == NULL)
+        return;
+
+    // A counter read just before the base, or behind it on another core, is clamped to the start
+    double l_dUs = 0.0;
+    if (p_ptEvent->t_ulTicks > p_ptTrace->t_ulBaseTicks)
+        l_dUs = (double)(p_ptEvent->t_ulTicks - p_ptTrace->t_ulBaseTicks) * p_ptTrace->t_dNsPerTick / 1000.0;
+
+    traceWriteSeparator(p_ptTrace);
+    fputs("{\"name\":", p_ptTrace->t_ptFile);
+    traceWriteString(p_ptTrace->t_ptFile, p_ptEvent->t_pcName);
+    fprintf(p_ptTrace->t_ptFile, ",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":%d,\"tid\":%d", s_cPhases[p_ptEvent->t_ulType],
+            l_dUs, p_ptTrace->t_iPid, p_ptBuffer->t_iTid);
+    if (p_ptEvent->t_ulType == XOS_TRACE_EVENT_INSTANT)
+        fputs(",\"s\":\"t\"", p_ptTrace->t_ptFile);
+    else if (p_ptEvent->t_ulType == XOS_TRACE_EVENT_COUNTER)
+        fprintf(p_ptTrace->t_ptFile, ",\"args\":{\"value\":%lld}", (long long)p_ptEvent->t_lValue);
+    fputc('}', p_ptTrace->t_ptFile);
+}
+
+////////////////////////////////////////////////////////////
+/// traceUnlink
+////////////////////////////////////////////////////////////
+static void traceUnlink(xTraceService_t* p_ptTrace, xTraceBuffer_t* p_ptBuffer)
+{
+    xTraceBuffer_t* l_ptExpected = p_ptBuffer;
+    if (atomic_compare_exchange_strong(&p_ptTrace->a_ptBuffers, &l_ptExpected, p_ptBuffer->t_ptNext))
+        return;
+
+    // Was the head or pushed behind a newer one, the links after the head only change here
+    for (xTraceBuffer_t* l_ptPrev = atomic_load(&p_ptTrace->a_ptBuffers); l_ptPrev != NULL; l_ptPrev = l_ptPrev->t_ptNext)
+    {
+        if (l_ptPrev->t_ptNext == p_ptBuffer)
+        {
+            l_ptPrev->t_ptNext = p_ptBuffer->t_ptNext;
+            return;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////
+/// traceDrain
+////////////////////////////////////////////////////////////
+static void traceDrain(xTraceService_t* p_ptTrace)
+{
+    // The scale is measured over the whole trace, the longer it runs the more exact it gets
+    uint64_t l_ulTicks = xTraceTicks();
+    uint64_t l_ulNs = traceNowNs();
+    if (l_ulTicks > p_ptTrace->t_ulBaseTicks && l_ulNs > p_ptTrace->t_ulBaseNs)
+        p_ptTrace->t_dNsPerTick = (double)(l_ulNs - p_ptTrace->t_ulBaseNs) / (double)(l_ulTicks - p_ptTrace->t_ulBaseTicks);
+
+    xTraceBuffer_t* l_ptBuffer = atomic_load_explicit(&p_ptTrace->a_ptBuffers, memory_order_acquire);
+    while (l_ptBuffer != NULL)
+    {
+        xTraceBuffer_t* l_ptNext = l_ptBuffer->t_ptNext;
+
+        // Read before the head, an ended thread has written its last event
+        bool l_bExited = atomic_load_explicit(&l_ptBuffer->a_bExited, memory_order_acquire);
+        uint64_t l_ulHead = atomic_load_explicit(&l_ptBuffer->a_ulHead, memory_order_acquire);
+        uint64_t l_ulTail = atomic_load_explicit(&l_ptBuffer->a_ulTail, memory_order_relaxed);
+
+        for (; l_ulTail != l_ulHead; l_ulTail++)
+            traceWriteEvent(p_ptTrace, l_ptBuffer, &l_ptBuffer->t_ptEvents[l_ulTail & l_ptBuffer->t_ulMask]);
+        atomic_store_explicit(&l_ptBuffer->a_ulTail, l_ulTail, memory_order_release);
+
+        if (l_bExited)
+        {
+            traceWriteThreadName(p_ptTrace, l_ptBuffer);
+            p_ptTrace->t_ulDroppedFreed += atomic_load_explicit(&l_ptBuffer->a_ulDropped, memory_order_relaxed);
+            traceUnlink(p_ptTrace, l_ptBuffer);
+            X_FREE(l_ptBuffer->t_ptEvents);
+            X_FREE(l_ptBuffer);
+        }
+        l_ptBuffer = l_ptNext;
+    }
+
+    fflush(p_ptTrace->t_ptFile);
+}
+
+////////////////////////////////////////////////////////////
+/// traceDroppedCount
+////////////////////////////////////////////////////////////
+static uint64_t traceDroppedCount(const xTraceService_t* p_ptTrace)
+{
+    uint64_t l_ulDropped = p_ptTrace->t_ulDroppedFreed;
+    for (xTraceBuffer_t* l_ptBuffer = atomic_load(&p_ptTrace->a_ptBuffers); l_ptBuffer != NULL; l_ptBuffer = l_ptBuffer->t_ptNext)
+        l_ulDropped += atomic_load_explicit(&l_ptBuffer->a_ulDropped, memory_order_relaxed);
+    return l_ulDropped;
+}
+
+////////////////////////////////////////////////////////////
+/// traceWriteThreadNames
+////////////////////////////////////////////////////////////
+static void traceWriteThreadNames(xTraceService_t* p_ptTrace)
+{
+    for (xTraceBuffer_t* l_ptBuffer = atomic_load(&p_ptTrace->a_ptBuffers); l_ptBuffer != NULL; l_ptBuffer = l_ptBuffer->t_ptNext)
+        traceWriteThreadName(p_ptTrace, l_ptBuffer);
+}
+
+////////////////////////////////////////////////////////////
+/// traceCycle
+////////////////////////////////////////////////////////////
+static bool traceCycle(void* p_pvArg)
+{
+    (void)p_pvArg;
+    xTraceFlush();
+    return true;
+}
+
+////////////////////////////////////////////////////////////
+/// xTraceStart
+////////////////////////////////////////////////////////////
+int xTraceStart(const char* p_pcPath, uint32_t p_ulPeriodMs, uint32_t p_ulEvents)
+{
+    xTraceService_t* l_ptTrace = &s_tTrace;
+    X_ASSERT_RETURN(p_pcPath != NULL, XOS_TRACE_INVALID);
+
+    bool l_bExpected = false;
+    if (!atomic_compare_exchange_strong(&l_ptTrace->a_bRunning, &l_bExpected, true))
+        return XOS_TRACE_ALREADY_RUNNING;
+
+    pthread_once(&l_ptTrace->t_tOnce, traceInitOnce);
+
+    uint32_t l_ulEvents = 1;
+    uint32_t l_ulWanted = p_ulEvents ? p_ulEvents : XOS_TRACE_DEFAULT_EVENTS;
+    while (l_ulEvents < l_ulWanted && l_ulEvents < (1U << 30))
+        l_ulEvents <<= 1;
+    atomic_store(&l_ptTrace->a_ulEvents, l_ulEvents);
+
+    mutexLock(&l_ptTrace->t_tMutex);
+    l_ptTrace->t_ptFile = fopen(p_pcPath, "w");
+    if (l_ptTrace->t_ptFile == NULL)
+    {
+        mutexUnlock(&l_ptTrace->t_tMutex);
+        X_LOG_TRACE("xTraceStart: cannot open %s", p_pcPath);
+        atomic_store(&l_ptTrace->a_bRunning, false);
+        return XOS_TRACE_ERROR;
+    }
+    fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", l_ptTrace->t_ptFile);
+    l_ptTrace->t_bFirstEvent = true;
+    l_ptTrace->t_iPid = (int)getpid();
+    l_ptTrace->t_ulDroppedFreed = 0;
+
+    // What the rings hold from a previous trace is discarded, the threads already known are named first
+    for (xTraceBuffer_t* l_ptBuffer = atomic_load(&l_ptTrace->a_ptBuffers); l_ptBuffer != NULL; l_ptBuffer = l_ptBuffer->t_ptNext)
+    {
+        atomic_store(&l_ptBuffer->a_ulTail, atomic_load(&l_ptBuffer->a_ulHead));
+        atomic_store(&l_ptBuffer->a_ulDropped, 0);
+    }
+    l_ptTrace->t_ulBaseTicks = xTraceTicks();
+    l_ptTrace->t_ulBaseNs = traceNowNs();
+    l_ptTrace->t_dNsPerTick = 1.0;
+    mutexUnlock(&l_ptTrace->t_tMutex);
+
+    atomic_store(&g_bTraceActive, true);
+
+    osTaskInit(&l_ptTrace->t_tTask);
+    l_ptTrace->t_tTask.t_pfPeriodic = traceCycle;
+    l_ptTrace->t_tTask.t_ptTaskArg = l_ptTrace;
+    l_ptTrace->t_tTask.t_ulPeriodNs = (uint64_t)(p_ulPeriodMs ? p_ulPeriodMs : XOS_TRACE_DEFAULT_PERIOD_MS) * 1000000ULL;
+    l_ptTrace->t_tTask.t_ulStackSize = XOS_TRACE_STACK_SIZE;
+    l_ptTrace->t_tTask.t_pcName = "trace";
+    if (osTaskCreate(&l_ptTrace->t_tTask) != OS_TASK_SUCCESS)
+    {
+        X_LOG_TRACE("xTraceStart: flush task creation failed");
+        atomic_store(&g_bTraceActive, false);
+        mutexLock(&l_ptTrace->t_tMutex);
+        fclose(l_ptTrace->t_ptFile);
+        l_ptTrace->t_ptFile = NULL;
+        mutexUnlock(&l_ptTrace->t_tMutex);
+        atomic_store(&l_ptTrace->a_bRunning, false);
+        return XOS_TRACE_ERROR;
+    }
+
+    return XOS_TRACE_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xTraceStop
+////////////////////////////////////////////////////////////
+int xTraceStop(void)
+{
+    xTraceService_t* l_ptTrace = &s_tTrace;
+
+    bool l_bExpected = true;
+    if (!atomic_compare_exchange_strong(&l_ptTrace->a_bRunning, &l_bExpected, false))
+        return XOS_TRACE_NOT_RUNNING;
+
+    atomic_store(&g_bTraceActive, false);
+    atomic_store(&l_ptTrace->t_tTask.a_iStopFlag, OS_TASK_STOP_REQUEST);
+    int l_iRet = (osTaskWait(&l_ptTrace->t_tTask, NULL) == OS_TASK_SUCCESS) ? (int)XOS_TRACE_OK : (int)XOS_TRACE_ERROR;
+
+    // An event being recorded when the flag dropped is written by this last drain or the next trace discards it
+    mutexLock(&l_ptTrace->t_tMutex);
+    traceDrain(l_ptTrace);
+    traceWriteThreadNames(l_ptTrace);
+    fprintf(l_ptTrace->t_ptFile, "\n],\"otherData\":{\"droppedEvents\":%llu}}\n",
+            (unsigned long long)traceDroppedCount(l_ptTrace));
+    if (fclose(l_ptTrace->t_ptFile) != 0)
+        l_iRet = XOS_TRACE_ERROR;
+    l_ptTrace->t_ptFile = NULL;
+    mutexUnlock(&l_ptTrace->t_tMutex);
+
+    return l_iRet;
+}
+
+////////////////////////////////////////////////////////////
+/// xTraceFlush
+////////////////////////////////////////////////////////////
+int xTraceFlush(void)
+{
+    xTraceService_t* l_ptTrace = &s_tTrace;
+    if (!atomic_load(&l_ptTrace->a_bRunning))
+        return XOS_TRACE_NOT_RUNNING;
+
+    mutexLock(&l_ptTrace->t_tMutex);
+    if (l_ptTrace->t_ptFile == NULL)
+    {
+        mutexUnlock(&l_ptTrace->t_tMutex);
+        return XOS_TRACE_NOT_RUNNING;
+    }
+    traceDrain(l_ptTrace);
+    mutexUnlock(&l_ptTrace->t_tMutex);
+
+    return XOS_TRACE_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xTraceSetThreadName
+////////////////////////////////////////////////////////////
+int xTraceSetThreadName(const char* p_pcName)
+{
+    X_ASSERT_RETURN(p_pcName != NULL, XOS_TRACE_INVALID);
+
+    snprintf(s_cThreadName, sizeof(s_cThreadName), "%s", p_pcName);
+    xTraceBuffer_t* l_ptBuffer = g_ptTraceBuffer;
+    if (l_ptBuffer != NULL)
+    {
+        // The flusher writes the name when the ring is freed or the trace closes
+        mutexLock(&s_tTrace.t_tMutex);
+        memcpy(l_ptBuffer->t_cName, s_cThreadName, sizeof(l_ptBuffer->t_cName));
+        mutexUnlock(&s_tTrace.t_tMutex);
+    }
+
+    return XOS_TRACE_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xTraceGetDroppedCount
+////////////////////////////////////////////////////////////
+uint64_t xTraceGetDroppedCount(void)
+{
+    // The flusher frees the rings of ended threads under the lock
+    pthread_once(&s_tTrace.t_tOnce, traceInitOnce);
+    mutexLock(&s_tTrace.t_tMutex);
+    uint64_t l_ulDropped = traceDroppedCount(&s_tTrace);
+    mutexUnlock(&s_tTrace.t_tMutex);
+    return l_ulDropped;
+}
@@ -0,0 +1,206 @@
+////////////////////////////////////////////////////////////
+//  trace header file
+//  defines the tracing spans, instants and counters
+//
+// Built with XOS_TRACE (cmake -DUSE_TRACE=ON), the X_TRACE_* macros
+// record events into a ring owned by the calling thread: a raw counter
+// read (TSC on x86-64, virtual counter on AArch64), a few plain stores
+// and one release store, no lock and no system call. A background task
+// started by xTraceStart drains the rings and appends the events to a
+// Chrome JSON trace, opened by chrome://tracing and the Perfetto UI.
+// A full ring drops the event and counts it, the hot path never waits.
+// Without the flag the macros expand to nothing
+//
+// general discloser: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+#pragma once
+
+#ifndef XOS_TRACE_H_
+#define XOS_TRACE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Trace error codes
+#define XOS_TRACE_OK                0xC4D19A10
+#define XOS_TRACE_ERROR             0xC4D19A11
+#define XOS_TRACE_INVALID           0xC4D19A12
+#define XOS_TRACE_ALREADY_RUNNING   0xC4D19A13
+#define XOS_TRACE_NOT_RUNNING       0xC4D19A14
+
+// Configuration constants
+#define XOS_TRACE_DEFAULT_EVENTS    8192                // Ring events per thread when 0 is configured (power of two)
+#define XOS_TRACE_DEFAULT_PERIOD_MS 100                 // Flush period when 0 is configured
+#define XOS_TRACE_NAME_SIZE         16                  // Thread name, as pthread_setname_np
+#define XOS_TRACE_STACK_SIZE        (256 * 1024)
+#define XOS_TRACE_CACHE_LINE        64
+
+// Event types
+#define XOS_TRACE_EVENT_BEGIN       0                   // Span start, "B"
+#define XOS_TRACE_EVENT_END         1                   // Span end, "E"
+#define XOS_TRACE_EVENT_INSTANT     2                   // Point in time, "i"
+#define XOS_TRACE_EVENT_COUNTER     3                   // Counter value, "C"
+
+//////////////////////////////////
+/// @brief one recorded event
+/// @note the name is kept as a pointer, it must outlive the trace (a literal)
+//////////////////////////////////
+typedef struct xos_trace_event_t
+{
+    uint64_t t_ulTicks;                 // Raw counter, see xTraceTicks
+    const char* t_pcName;
+    int64_t t_lValue;                   // Counter value
+    uint32_t t_ulType;                  // XOS_TRACE_EVENT_*
+    uint32_t t_ulReserved;
+} xTraceEvent_t;
+
+//////////////////////////////////
+/// @brief event ring of one thread, the thread produces and the flusher consumes
+//////////////////////////////////
+typedef struct xos_trace_buffer_t
+{
+    atomic_ullong a_ulHead;             // Next event written, thread only
+    uint64_t t_ulTailCache;             // Last tail seen by the thread
+    uint64_t t_ulMask;                  // Ring events - 1
+    xTraceEvent_t* t_ptEvents;
+    atomic_ullong a_ulTail __attribute__((aligned(XOS_TRACE_CACHE_LINE)));  // Next event read, flusher only
+    atomic_ulong a_ulDropped;           // Events lost on a full ring
+    atomic_bool a_bExited;              // The thread ended, the ring is freed once drained
+    int t_iTid;                         // Kernel thread id
+    char t_cName[XOS_TRACE_NAME_SIZE];
+    struct xos_trace_buffer_t* t_ptNext;
+} xTraceBuffer_t;
+
+// Tracing state, read by the macros before anything else
+extern atomic_bool g_bTraceActive;
+
+// Ring of the calling thread, NULL until its first event
+extern __thread xTraceBuffer_t* g_ptTraceBuffer;
+
+//////////////////////////////////
+/// @brief Read the raw timestamp counter
+/// @return counter ticks, converted to time by the flusher
+//////////////////////////////////
+static inline uint64_t xTraceTicks(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t l_ulTicks;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(l_ulTicks));
+    return l_ulTicks;
+#else
+    struct timespec l_tNow;
+    clock_gettime(CLOCK_MONOTONIC, &l_tNow);
+    return (uint64_t)l_tNow.tv_sec * 1000000000ULL + (uint64_t)l_tNow.tv_nsec;
+#endif
+}
+
+//////////////////////////////////
+/// @brief Create the ring of the calling thread
+/// @return ring, NULL when it cannot be allocated
+/// @note slow path of xTraceRecord, run once per thread
+//////////////////////////////////
+xTraceBuffer_t* xTraceRegisterThread(void);
+
+//////////////////////////////////
+/// @brief Record an event
+/// @param p_ulType : XOS_TRACE_EVENT_*
+/// @param p_pcName : event name, a string that outlives the trace
+/// @param p_lValue : counter value (0 for other events)
+/// @return none
+//////////////////////////////////
+static inline void xTraceRecord(uint32_t p_ulType, const char* p_pcName, int64_t p_lValue)
+{
+    xTraceBuffer_t* l_ptBuffer = g_ptTraceBuffer;
+    if (__builtin_expect(l_ptBuffer == NULL, 0))
+    {
+        l_ptBuffer = xTraceRegisterThread();
+        if (l_ptBuffer == NULL)
+            return;
+    }
+
+    uint64_t l_ulHead = atomic_load_explicit(&l_ptBuffer->a_ulHead, memory_order_relaxed);
+    if (l_ulHead - l_ptBuffer->t_ulTailCache > l_ptBuffer->t_ulMask)
+    {
+        l_ptBuffer->t_ulTailCache = atomic_load_explicit(&l_ptBuffer->a_ulTail, memory_order_acquire);
+        if (l_ulHead - l_ptBuffer->t_ulTailCache > l_ptBuffer->t_ulMask)
+        {
+            atomic_fetch_add_explicit(&l_ptBuffer->a_ulDropped, 1, memory_order_relaxed);
+            return;
+        }
+    }
+
+    xTraceEvent_t* l_ptEvent = &l_ptBuffer->t_ptEvents[l_ulHead & l_ptBuffer->t_ulMask];
+    l_ptEvent->t_ulTicks = xTraceTicks();
+    l_ptEvent->t_pcName = p_pcName;
+    l_ptEvent->t_lValue = p_lValue;
+    l_ptEvent->t_ulType = p_ulType;
+    atomic_store_explicit(&l_ptBuffer->a_ulHead, l_ulHead + 1, memory_order_release);
+}
+
+//////////////////////////////////
+/// @brief Start tracing and the flush task
+/// @param p_pcPath : Chrome JSON trace file, replaced
+/// @param p_ulPeriodMs : flush period (0 for XOS_TRACE_DEFAULT_PERIOD_MS)
+/// @param p_ulEvents : ring events per thread, rounded up to a power of two (0 for XOS_TRACE_DEFAULT_EVENTS)
+/// @return : success or error code
+/// @note the ring size applies to threads that record their first event after the call
+//////////////////////////////////
+int xTraceStart(const char* p_pcPath, uint32_t p_ulPeriodMs, uint32_t p_ulEvents);
+
+//////////////////////////////////
+/// @brief Stop tracing, write the last events and close the trace file
+/// @return : success or error code
+//////////////////////////////////
+int xTraceStop(void);
+
+//////////////////////////////////
+/// @brief Write the recorded events to the trace file now
+/// @return : success or error code
+/// @note the flush task calls it every period
+//////////////////////////////////
+int xTraceFlush(void);
+
+//////////////////////////////////
+/// @brief Name the calling thread in the trace
+/// @param p_pcName : thread name, truncated to XOS_TRACE_NAME_SIZE - 1 characters
+/// @return : success or error code
+/// @note osTaskCreate names its tasks with t_pcName
+//////////////////////////////////
+int xTraceSetThreadName(const char* p_pcName);
+
+//////////////////////////////////
+/// @brief Get the number of events dropped on full rings since xTraceStart
+/// @return dropped events
+//////////////////////////////////
+uint64_t xTraceGetDroppedCount(void);
+
+#ifdef XOS_TRACE
+#define X_TRACE_RECORD(type, name, value) \
+    do { \
+        if (__builtin_expect(atomic_load_explicit(&g_bTraceActive, memory_order_relaxed), 0)) \
+        { \
+            xTraceRecord((type), (name), (int64_t)(value)); \
+        } \
+    } while (0)
+#define X_TRACE_BEGIN(name)             X_TRACE_RECORD(XOS_TRACE_EVENT_BEGIN, name, 0)
+#define X_TRACE_END(name)               X_TRACE_RECORD(XOS_TRACE_EVENT_END, name, 0)
+#define X_TRACE_INSTANT(name)           X_TRACE_RECORD(XOS_TRACE_EVENT_INSTANT, name, 0)
+#define X_TRACE_COUNTER(name, value)    X_TRACE_RECORD(XOS_TRACE_EVENT_COUNTER, name, value)
+#define X_TRACE_THREAD_NAME(name)       xTraceSetThreadName(name)
+#else
+#define X_TRACE_BEGIN(name)             ((void)0)
+#define X_TRACE_END(name)               ((void)0)
+#define X_TRACE_INSTANT(name)           ((void)0)
+#define X_TRACE_COUNTER(name, value)    ((void)0)
+#define X_TRACE_THREAD_NAME(name)       ((void)0)
+#endif
+
+#endif // XOS_TRACE_H_
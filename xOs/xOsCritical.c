@@ -15,7 +15,15 @@
 ////////////////////////////////////////////////////////////
 /// osCriticalCreate
 ////////////////////////////////////////////////////////////
-int osCriticalCreate(t_osCriticalCtx* p_pttOSCritical)
+int (osCriticalCreate)(t_osCriticalCtx* p_pttOSCritical)
+{
+    return osCriticalCreateAt(p_pttOSCritical, NULL, NULL, 0);
+}
+
+////////////////////////////////////////////////////////////
+/// osCriticalCreateAt
+////////////////////////////////////////////////////////////
+int osCriticalCreateAt(t_osCriticalCtx* p_pttOSCritical, const char* p_pcName, const char* p_pcFile, int p_iLine)
 {
     X_ASSERT(p_pttOSCritical != NULL);
 
@@ -32,6 +40,10 @@ int osCriticalCreate(t_osCriticalCtx* p_pttOSCritical)
     pthread_mutexattr_destroy(&l_tAttr);
 	atomic_store(&p_pttOSCritical->a_usLockCounter, 0);
 	atomic_store(&p_pttOSCritical->a_bLock, false);
+#ifdef XOS_LOCK_PROFILE
+    p_pttOSCritical->t_ptProfile = lockProfileRegister(p_pcName, p_pcFile, p_iLine);
+    p_pttOSCritical->t_ulAcquiredNs = 0;
+#endif
 
     return OS_CRITICAL_SUCCESS;
 }
@@ -43,9 +55,31 @@ int osCriticalLock(t_osCriticalCtx* p_pttOSCritical)
 {
     X_ASSERT(p_pttOSCritical != NULL);
 
+#ifdef XOS_LOCK_PROFILE
+    // A failed try tells a contended acquisition from a free one
+    bool l_bContended = false;
+    uint64_t l_ulStart = 0;
+    int l_iRet = pthread_mutex_trylock(&p_pttOSCritical->critical);
+    if (l_iRet == EBUSY) {
+        l_bContended = true;
+        l_ulStart = lockProfileNow();
+        l_iRet = pthread_mutex_lock(&p_pttOSCritical->critical);
+    }
+    if (l_iRet != 0) {
+        return OS_CRITICAL_ERROR;
+    }
+    if (p_pttOSCritical->t_ptProfile != NULL) {
+        uint64_t l_ulNow = lockProfileNow();
+        lockProfileAcquired(p_pttOSCritical->t_ptProfile, l_bContended, l_bContended ? l_ulNow - l_ulStart : 0);
+        if (atomic_load(&p_pttOSCritical->a_usLockCounter) == 0) {
+            p_pttOSCritical->t_ulAcquiredNs = l_ulNow;
+        }
+    }
+#else
     if (pthread_mutex_lock(&p_pttOSCritical->critical) != 0) {
         return OS_CRITICAL_ERROR;
     }
+#endif
 
 	//increase the counter and update the critical section status 
     atomic_fetch_add(&p_pttOSCritical->a_usLockCounter, 1);
@@ -65,6 +99,12 @@ int osCriticalUnlock(t_osCriticalCtx* p_pttOSCritical)
 		return OS_CRITICAL_ERROR;
 	}
 
+#ifdef XOS_LOCK_PROFILE
+    // The owner still holds the lock, the outermost unlock closes the hold time
+    if (p_pttOSCritical->t_ptProfile != NULL && atomic_load(&p_pttOSCritical->a_usLockCounter) == 1) {
+        lockProfileReleased(p_pttOSCritical->t_ptProfile, lockProfileNow() - p_pttOSCritical->t_ulAcquiredNs);
+    }
+#endif
     if (pthread_mutex_unlock(&p_pttOSCritical->critical) != 0) {
         return OS_CRITICAL_ERROR;
     }
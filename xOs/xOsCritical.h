@@ -20,6 +20,7 @@
 #include <pthread.h>
 #include <sys/time.h>
 #include <stdatomic.h>
+#include "xOsLockProfile.h"
 #define _POSIX_C_SOURCE 200809L
 
 #define OS_CRITICAL_SUCCESS 0xC6FB2A70
@@ -43,6 +44,10 @@ typedef struct {
     pthread_mutex_t critical; // section critique
     _Atomic unsigned short a_usLockCounter;     // compteur de verrous
     _Atomic bool a_bLock;                       // état du verrou
+#ifdef XOS_LOCK_PROFILE
+    xOsLockSite_t* t_ptProfile;                 // site de création
+    uint64_t t_ulAcquiredNs;                    // instant du verrou le plus externe
+#endif
 } t_osCriticalCtx;
 
 
@@ -55,6 +60,22 @@ typedef struct {
 //////////////////////////////////
 int osCriticalCreate(t_osCriticalCtx* p_pttOSCritical);
 
+//////////////////////////////////
+/// @brief osCriticalCreateAt
+/// @param p_pttOSCritical pointer to the critical section
+/// @param p_pcName lock name
+/// @param p_pcFile creation file
+/// @param p_iLine creation line
+/// @return OS_CRITICAL_SUCCESS if success, OS_CRITICAL_ERROR otherwise
+/// @note create the critical section and bind it to a lock profile site
+/// @note osCriticalCreate expands to this call with XOS_LOCK_PROFILE
+//////////////////////////////////
+int osCriticalCreateAt(t_osCriticalCtx* p_pttOSCritical, const char* p_pcName, const char* p_pcFile, int p_iLine);
+
+#ifdef XOS_LOCK_PROFILE
+#define osCriticalCreate(p_pttOSCritical) osCriticalCreateAt((p_pttOSCritical), #p_pttOSCritical, __FILE__, __LINE__)
+#endif
+
 
 //////////////////////////////////
 /// @brief osCriticalLock
@@ -0,0 +1,47 @@
+////////////////////////////////////////////////////////////
+//  futex source file
+//  implements the futex and deadline helpers of xOsFutex.h
+//
+// general discloser: copy or share the file is forbidden
+// Written : 15/10/2026
+////////////////////////////////////////////////////////////
+
+#include "xOsFutex.h"
+#include <errno.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+////////////////////////////////////////////////////////////
+/// osDeadlineAfter
+////////////////////////////////////////////////////////////
+void osDeadlineAfter(struct timespec* p_ptDeadline, unsigned long p_ulTimeoutMs)
+{
+    clock_gettime(CLOCK_MONOTONIC, p_ptDeadline);
+    p_ptDeadline->tv_sec += (time_t)(p_ulTimeoutMs / 1000);
+    p_ptDeadline->tv_nsec += (long)(p_ulTimeoutMs % 1000) * 1000000L;
+    if (p_ptDeadline->tv_nsec >= 1000000000L)
+    {
+        p_ptDeadline->tv_sec++;
+        p_ptDeadline->tv_nsec -= 1000000000L;
+    }
+}
+
+////////////////////////////////////////////////////////////
+/// osFutexWait
+////////////////////////////////////////////////////////////
+bool osFutexWait(void* p_pvWord, unsigned int p_uiValue, const struct timespec* p_ptDeadline, bool p_bShared)
+{
+    // The bitset variant takes an absolute monotonic deadline
+    int l_iOp = p_bShared ? FUTEX_WAIT_BITSET : FUTEX_WAIT_BITSET_PRIVATE;
+    long l_lRet = syscall(SYS_futex, p_pvWord, l_iOp, (int)p_uiValue, p_ptDeadline, NULL, FUTEX_BITSET_MATCH_ANY);
+    return !(l_lRet != 0 && errno == ETIMEDOUT);
+}
+
+////////////////////////////////////////////////////////////
+/// osFutexWake
+////////////////////////////////////////////////////////////
+void osFutexWake(void* p_pvWord, int p_iCount, bool p_bShared)
+{
+    syscall(SYS_futex, p_pvWord, p_bShared ? FUTEX_WAKE : FUTEX_WAKE_PRIVATE, p_iCount, NULL, NULL, 0);
+}
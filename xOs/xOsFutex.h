@@ -0,0 +1,48 @@
+////////////////////////////////////////////////////////////
+//  futex header file
+//  defines the futex and deadline helpers shared by the xOs waits
+//
+// Internal to the library. Deadlines are absolute on CLOCK_MONOTONIC,
+// the one clock used by the futex waits, pthread_cond_timedwait on a
+// condition created with pthread_condattr_setclock(CLOCK_MONOTONIC)
+// and pthread_mutex_clocklock. Private futexes serve words of one
+// process, shared ones words mapped by several (see xNetworkShm.c)
+//
+// general discloser: copy or share the file is forbidden
+// Written : 15/10/2026
+////////////////////////////////////////////////////////////
+#pragma once
+
+#ifndef XOS_FUTEX_H_
+#define XOS_FUTEX_H_
+
+#include <stdbool.h>
+#include <time.h>
+
+//////////////////////////////////
+/// @brief Compute a monotonic deadline from now
+/// @param p_ptDeadline : filled with the deadline
+/// @param p_ulTimeoutMs : delay from now in milliseconds
+//////////////////////////////////
+void osDeadlineAfter(struct timespec* p_ptDeadline, unsigned long p_ulTimeoutMs);
+
+//////////////////////////////////
+/// @brief Sleep while a futex word holds a value
+/// @param p_pvWord : 32-bit word
+/// @param p_uiValue : value seen by the caller, the call returns at once otherwise
+/// @param p_ptDeadline : absolute monotonic deadline, NULL waits forever
+/// @param p_bShared : true for a word mapped by several processes
+/// @return false once the deadline has passed, true otherwise
+/// @note a true return may be spurious, the caller checks its condition again
+//////////////////////////////////
+bool osFutexWait(void* p_pvWord, unsigned int p_uiValue, const struct timespec* p_ptDeadline, bool p_bShared);
+
+//////////////////////////////////
+/// @brief Wake the threads sleeping on a futex word
+/// @param p_pvWord : 32-bit word
+/// @param p_iCount : threads to wake at most, INT_MAX for all
+/// @param p_bShared : true for a word mapped by several processes
+//////////////////////////////////
+void osFutexWake(void* p_pvWord, int p_iCount, bool p_bShared);
+
+#endif // XOS_FUTEX_H_
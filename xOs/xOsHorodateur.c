@@ -12,6 +12,8 @@
 #include <time.h>
 #include <string.h>
 #include <stdio.h>
+#include <stdbool.h>
+#include <stdatomic.h>
 
 
 #define XOS_HORODATEUR_BUFFER_SIZE 64   // Size of the buffer for the formatted timestamp
@@ -19,47 +21,146 @@
 // Thread-local buffer: each thread has its own buffer
 static __thread char s_cTimeBuffer[XOS_HORODATEUR_BUFFER_SIZE];
 
+// Thread-local cache of the formatted "YYYY-MM-DD HH:MM:" prefix
+static __thread bool s_bCacheValid = false;
+static __thread time_t s_lCacheMinuteStart;     // First second of the cached local minute
+static __thread time_t s_lCacheSecond;          // Second currently in the buffer
+static __thread long s_lCacheMillis;            // Milliseconds currently in the buffer
+static __thread size_t s_ulCachePrefixLength;   // Length of the date/hour/minute prefix
+
+// Clock used by xHorodateurGetString
+static atomic_int s_iStringClock = ATOMIC_VAR_INIT(CLOCK_REALTIME);
+
+//
+// Reads a clock in nanoseconds
+//
+static inline uint64_t horodateurReadNs(clockid_t p_tClock)
+{
+    struct timespec ts;
+    if (clock_gettime(p_tClock, &ts) != 0)
+    {
+        return 0;
+    }
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+//
+// Writes the milliseconds, three digits
+//
+static inline void horodateurPutMillis(char* p_pcOut, long p_lMillis)
+{
+    p_pcOut[0] = (char)('0' + p_lMillis / 100);
+    p_pcOut[1] = (char)('0' + (p_lMillis / 10) % 10);
+    p_pcOut[2] = (char)('0' + p_lMillis % 10);
+}
+
 ////////////////////////////////////////////////////////////
 /// xHorodateurGetString
 ////////////////////////////////////////////////////////////
 const char* xHorodateurGetString(void)
 {
     struct timespec ts;
-    struct tm tm_result;
-
-    // Réinitialiser le buffer thread-local
-    memset(s_cTimeBuffer, 0, XOS_HORODATEUR_BUFFER_SIZE);
 
-    // Obtenir l'heure actuelle avec haute résolution
-    if (clock_gettime(CLOCK_REALTIME, &ts) != 0) 
+    // Obtenir l'heure actuelle (vDSO, pas d'appel système)
+    if (clock_gettime((clockid_t)atomic_load_explicit(&s_iStringClock, memory_order_relaxed), &ts) != 0)
     {
         return NULL;
     }
 
-    // Conversion en heure locale de façon thread-safe
-    if (localtime_r(&ts.tv_sec, &tm_result) == NULL) 
+    long l_lMillis = ts.tv_nsec / 1000000;
+
+    // Same second: only the milliseconds may change
+    if (s_bCacheValid && ts.tv_sec == s_lCacheSecond)
     {
-        return NULL;
+        if (l_lMillis != s_lCacheMillis)
+        {
+            horodateurPutMillis(s_cTimeBuffer + s_ulCachePrefixLength + 3, l_lMillis);
+            s_lCacheMillis = l_lMillis;
+        }
+        return s_cTimeBuffer;
     }
 
-    // Formater la partie "date/heure" (YYYY-MM-DD HH:MM:SS)
-    if (strftime(s_cTimeBuffer, XOS_HORODATEUR_BUFFER_SIZE, "%Y-%m-%d %H:%M:%S", &tm_result) == 0) 
+    // New minute (or clock step): conversion en heure locale, once per minute and thread
+    if (!s_bCacheValid || ts.tv_sec < s_lCacheMinuteStart || ts.tv_sec >= s_lCacheMinuteStart + 60)
     {
-        return NULL;
+        struct tm tm_result;
+        if (localtime_r(&ts.tv_sec, &tm_result) == NULL)
+        {
+            s_bCacheValid = false;
+            return NULL;
+        }
+
+        size_t len = strftime(s_cTimeBuffer, XOS_HORODATEUR_BUFFER_SIZE - 8, "%Y-%m-%d %H:%M:", &tm_result);
+        if (len == 0)
+        {
+            s_bCacheValid = false;
+            return NULL;
+        }
+
+        s_ulCachePrefixLength = len;
+        s_lCacheMinuteStart = ts.tv_sec - tm_result.tm_sec;
     }
 
-    // Calculer la taille actuelle dans le buffer
-    size_t len = strlen(s_cTimeBuffer);
+    // Seconds and milliseconds (SS.mmm)
+    long l_lSeconds = (long)(ts.tv_sec - s_lCacheMinuteStart);
+    char* l_pcOut = s_cTimeBuffer + s_ulCachePrefixLength;
+    l_pcOut[0] = (char)('0' + l_lSeconds / 10);
+    l_pcOut[1] = (char)('0' + l_lSeconds % 10);
+    l_pcOut[2] = '.';
+    horodateurPutMillis(l_pcOut + 3, l_lMillis);
+    l_pcOut[6] = '\0';
 
-    // Concaténer directement les millisecondes dans le buffer
-    // ts.tv_nsec est en nanosecondes, on le convertit en millisecondes
-    int written = snprintf(s_cTimeBuffer + len, XOS_HORODATEUR_BUFFER_SIZE - len, ".%03ld", ts.tv_nsec / 1000000);
-    if (written < 0 || (size_t)written >= XOS_HORODATEUR_BUFFER_SIZE - len) 
+    s_lCacheSecond = ts.tv_sec;
+    s_lCacheMillis = l_lMillis;
+    s_bCacheValid = true;
+
+    return s_cTimeBuffer;
+}
+
+////////////////////////////////////////////////////////////
+/// xHorodateurSetCoarse
+////////////////////////////////////////////////////////////
+int xHorodateurSetCoarse(bool p_bCoarse)
+{
+#ifdef CLOCK_REALTIME_COARSE
+    atomic_store(&s_iStringClock, p_bCoarse ? CLOCK_REALTIME_COARSE : CLOCK_REALTIME);
+    return XOS_HORODATEUR_OK;
+#else
+    if (p_bCoarse)
     {
-        return NULL;
+        return XOS_HORODATEUR_INVALID;
     }
+    atomic_store(&s_iStringClock, CLOCK_REALTIME);
+    return XOS_HORODATEUR_OK;
+#endif
+}
 
-    return s_cTimeBuffer;
+////////////////////////////////////////////////////////////
+/// xHorodateurGetNs
+////////////////////////////////////////////////////////////
+uint64_t xHorodateurGetNs(void)
+{
+    return horodateurReadNs(CLOCK_MONOTONIC);
+}
+
+////////////////////////////////////////////////////////////
+/// xHorodateurGetCoarseNs
+////////////////////////////////////////////////////////////
+uint64_t xHorodateurGetCoarseNs(void)
+{
+#ifdef CLOCK_MONOTONIC_COARSE
+    return horodateurReadNs(CLOCK_MONOTONIC_COARSE);
+#else
+    return horodateurReadNs(CLOCK_MONOTONIC);
+#endif
+}
+
+////////////////////////////////////////////////////////////
+/// xHorodateurGetRealtimeNs
+////////////////////////////////////////////////////////////
+uint64_t xHorodateurGetRealtimeNs(void)
+{
+    return horodateurReadNs(CLOCK_REALTIME);
 }
 
 ////////////////////////////////////////////////////////////
@@ -71,7 +172,7 @@ uint32_t xHorodateurGet(void)
     // Obtenir le temps actuel
     if (clock_gettime(CLOCK_REALTIME, &ts) != 0) 
     {
-        X_ASSERT(0); // Erreur critique
+        X_ASSERT_ALWAYS(0); // Erreur critique
         return 0;
     }
     // Retourner la partie secondes (timestamp Unix)
@@ -12,6 +12,7 @@
 #define XOS_HORODATEUR_H_
 
 #include <stdint.h>
+#include <stdbool.h>
 
 // Horodateur error codes
 #define XOS_HORODATEUR_OK            0xB8E73D90
@@ -21,9 +22,37 @@
 //////////////////////////////////
 /// @brief Get current formatted timestamp
 /// @return Pointer to static timestamp string
+/// @note "YYYY-MM-DD HH:MM:SS.mmm" in a per-thread buffer, the date and
+///       minute are converted once per minute, a time zone change is
+///       seen at the next minute
 //////////////////////////////////
 const char* xHorodateurGetString(void);
 
+//////////////////////////////////
+/// @brief Select the clock of xHorodateurGetString
+/// @param p_bCoarse : true for CLOCK_REALTIME_COARSE (tick resolution, cheaper)
+/// @return success or error code
+//////////////////////////////////
+int xHorodateurSetCoarse(bool p_bCoarse);
+
+//////////////////////////////////
+/// @brief Get the monotonic time in nanoseconds
+/// @return CLOCK_MONOTONIC in ns, 0 on error
+//////////////////////////////////
+uint64_t xHorodateurGetNs(void);
+
+//////////////////////////////////
+/// @brief Get the coarse monotonic time in nanoseconds
+/// @return CLOCK_MONOTONIC_COARSE in ns (tick resolution), 0 on error
+//////////////////////////////////
+uint64_t xHorodateurGetCoarseNs(void);
+
+//////////////////////////////////
+/// @brief Get the wall clock time in nanoseconds
+/// @return CLOCK_REALTIME in ns since the epoch, 0 on error
+//////////////////////////////////
+uint64_t xHorodateurGetRealtimeNs(void);
+
 //////////////////////////////////
 /// @brief Get current timestamp in seconds
 /// @return Current Unix timestamp
@@ -0,0 +1,249 @@
+////////////////////////////////////////////////////////////
+//  lock profile source file
+//  implements the lock contention profile
+//
+// general discloser: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+
+#include "xOs/xOsLockProfile.h"
+#include "xOs/xOsMutex.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+// Site table, a plain pthread mutex so the profile never profiles itself
+static xOsLockSite_t s_tSites[XOS_LOCK_PROFILE_MAX_SITES];
+static pthread_mutex_t s_tSiteMutex = PTHREAD_MUTEX_INITIALIZER;
+
+// Copy of a site taken for the dump
+typedef struct
+{
+    const char* t_pcFile;
+    int t_iLine;
+    const char* t_pcName;
+    uint64_t t_ulLocks;
+    uint64_t t_ulAcquired;
+    uint64_t t_ulContended;
+    uint64_t t_ulWaitNs;
+    uint64_t t_ulWaitMaxNs;
+    uint64_t t_ulHoldNs;
+    uint64_t t_ulHoldMaxNs;
+} xOsLockEntry_t;
+
+////////////////////////////////////////////////////////////
+/// lockProfileHash
+////////////////////////////////////////////////////////////
+static inline size_t lockProfileHash(const char* p_pcFile, int p_iLine)
+{
+    uint64_t l_ulKey = ((uint64_t)(uintptr_t)p_pcFile) ^ ((uint64_t)(uint32_t)p_iLine * 0x9E3779B97F4A7C15ULL);
+    l_ulKey ^= l_ulKey >> 33;
+    l_ulKey *= 0xC4CEB9FE1A85EC53ULL;
+    l_ulKey ^= l_ulKey >> 33;
+    return (size_t)l_ulKey & (XOS_LOCK_PROFILE_MAX_SITES - 1);
+}
+
+////////////////////////////////////////////////////////////
+/// lockProfileMax
+////////////////////////////////////////////////////////////
+static inline void lockProfileMax(_Atomic uint64_t* p_pulMax, uint64_t p_ulValue)
+{
+    uint64_t l_ulCurrent = atomic_load_explicit(p_pulMax, memory_order_relaxed);
+    while (p_ulValue > l_ulCurrent &&
+           !atomic_compare_exchange_weak_explicit(p_pulMax, &l_ulCurrent, p_ulValue,
+                                                  memory_order_relaxed, memory_order_relaxed))
+    {
+    }
+}
+
+////////////////////////////////////////////////////////////
+/// lockProfileRegister
+////////////////////////////////////////////////////////////
+xOsLockSite_t* lockProfileRegister(const char* p_pcName, const char* p_pcFile, int p_iLine)
+{
+    if (p_pcFile == NULL)
+    {
+        return NULL;
+    }
+
+    // Two locks created on one line are told apart by their name
+    const char* l_pcName = (p_pcName != NULL) ? p_pcName : "?";
+    size_t l_ulIndex = lockProfileHash(p_pcFile, p_iLine);
+    xOsLockSite_t* l_ptFound = NULL;
+
+    pthread_mutex_lock(&s_tSiteMutex);
+    for (size_t i = 0; i < XOS_LOCK_PROFILE_MAX_SITES && l_ptFound == NULL; i++)
+    {
+        xOsLockSite_t* l_ptSite = &s_tSites[(l_ulIndex + i) & (XOS_LOCK_PROFILE_MAX_SITES - 1)];
+        if (!atomic_load_explicit(&l_ptSite->a_bReady, memory_order_relaxed))
+        {
+            atomic_store_explicit(&l_ptSite->a_pcFile, p_pcFile, memory_order_relaxed);
+            atomic_store_explicit(&l_ptSite->a_iLine, p_iLine, memory_order_relaxed);
+            atomic_store_explicit(&l_ptSite->a_pcName, l_pcName, memory_order_relaxed);
+            atomic_store_explicit(&l_ptSite->a_bReady, true, memory_order_release);
+            l_ptFound = l_ptSite;
+        }
+        else if (atomic_load_explicit(&l_ptSite->a_pcFile, memory_order_relaxed) == p_pcFile &&
+                 atomic_load_explicit(&l_ptSite->a_iLine, memory_order_relaxed) == p_iLine &&
+                 atomic_load_explicit(&l_ptSite->a_pcName, memory_order_relaxed) == l_pcName)
+        {
+            l_ptFound = l_ptSite;
+        }
+    }
+    pthread_mutex_unlock(&s_tSiteMutex);
+
+    if (l_ptFound != NULL)
+    {
+        atomic_fetch_add_explicit(&l_ptFound->a_ulLocks, 1, memory_order_relaxed);
+    }
+    return l_ptFound;
+}
+
+////////////////////////////////////////////////////////////
+/// lockProfileAcquired
+////////////////////////////////////////////////////////////
+void lockProfileAcquired(xOsLockSite_t* p_ptSite, bool p_bContended, uint64_t p_ulWaitNs)
+{
+    if (p_ptSite == NULL)
+    {
+        return;
+    }
+
+    atomic_fetch_add_explicit(&p_ptSite->a_ulAcquired, 1, memory_order_relaxed);
+    if (p_bContended)
+    {
+        atomic_fetch_add_explicit(&p_ptSite->a_ulContended, 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&p_ptSite->a_ulWaitNs, p_ulWaitNs, memory_order_relaxed);
+        lockProfileMax(&p_ptSite->a_ulWaitMaxNs, p_ulWaitNs);
+    }
+}
+
+////////////////////////////////////////////////////////////
+/// lockProfileReleased
+////////////////////////////////////////////////////////////
+void lockProfileReleased(xOsLockSite_t* p_ptSite, uint64_t p_ulHoldNs)
+{
+    if (p_ptSite == NULL)
+    {
+        return;
+    }
+
+    atomic_fetch_add_explicit(&p_ptSite->a_ulHoldNs, p_ulHoldNs, memory_order_relaxed);
+    lockProfileMax(&p_ptSite->a_ulHoldMaxNs, p_ulHoldNs);
+}
+
+////////////////////////////////////////////////////////////
+/// lockProfileReset
+////////////////////////////////////////////////////////////
+int lockProfileReset(void)
+{
+    for (size_t i = 0; i < XOS_LOCK_PROFILE_MAX_SITES; i++)
+    {
+        xOsLockSite_t* l_ptSite = &s_tSites[i];
+        atomic_store_explicit(&l_ptSite->a_ulAcquired, 0, memory_order_relaxed);
+        atomic_store_explicit(&l_ptSite->a_ulContended, 0, memory_order_relaxed);
+        atomic_store_explicit(&l_ptSite->a_ulWaitNs, 0, memory_order_relaxed);
+        atomic_store_explicit(&l_ptSite->a_ulWaitMaxNs, 0, memory_order_relaxed);
+        atomic_store_explicit(&l_ptSite->a_ulHoldNs, 0, memory_order_relaxed);
+        atomic_store_explicit(&l_ptSite->a_ulHoldMaxNs, 0, memory_order_relaxed);
+    }
+
+    return MUTEX_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// lockProfileCompare
+////////////////////////////////////////////////////////////
+static int lockProfileCompare(const void* p_pvLeft, const void* p_pvRight)
+{
+    const xOsLockEntry_t* l_ptLeft = (const xOsLockEntry_t*)p_pvLeft;
+    const xOsLockEntry_t* l_ptRight = (const xOsLockEntry_t*)p_pvRight;
+
+    if (l_ptLeft->t_ulWaitNs != l_ptRight->t_ulWaitNs)
+    {
+        return (l_ptLeft->t_ulWaitNs < l_ptRight->t_ulWaitNs) ? 1 : -1;
+    }
+    if (l_ptLeft->t_ulContended != l_ptRight->t_ulContended)
+    {
+        return (l_ptLeft->t_ulContended < l_ptRight->t_ulContended) ? 1 : -1;
+    }
+    return (l_ptLeft->t_ulAcquired < l_ptRight->t_ulAcquired) ? 1 : (l_ptLeft->t_ulAcquired > l_ptRight->t_ulAcquired) ? -1 : 0;
+}
+
+////////////////////////////////////////////////////////////
+/// lockProfileDump
+////////////////////////////////////////////////////////////
+int lockProfileDump(const char* p_pcPath, int p_iTopN)
+{
+    xOsLockEntry_t* l_ptEntries = malloc(sizeof(xOsLockEntry_t) * XOS_LOCK_PROFILE_MAX_SITES);
+    if (l_ptEntries == NULL)
+    {
+        return MUTEX_ERROR;
+    }
+
+    size_t l_ulCount = 0;
+    for (size_t i = 0; i < XOS_LOCK_PROFILE_MAX_SITES; i++)
+    {
+        xOsLockSite_t* l_ptSite = &s_tSites[i];
+        if (!atomic_load_explicit(&l_ptSite->a_bReady, memory_order_acquire))
+        {
+            continue;
+        }
+
+        xOsLockEntry_t* l_ptEntry = &l_ptEntries[l_ulCount++];
+        l_ptEntry->t_pcFile = atomic_load_explicit(&l_ptSite->a_pcFile, memory_order_relaxed);
+        l_ptEntry->t_iLine = atomic_load_explicit(&l_ptSite->a_iLine, memory_order_relaxed);
+        l_ptEntry->t_pcName = atomic_load_explicit(&l_ptSite->a_pcName, memory_order_relaxed);
+        l_ptEntry->t_ulLocks = atomic_load_explicit(&l_ptSite->a_ulLocks, memory_order_relaxed);
+        l_ptEntry->t_ulAcquired = atomic_load_explicit(&l_ptSite->a_ulAcquired, memory_order_relaxed);
+        l_ptEntry->t_ulContended = atomic_load_explicit(&l_ptSite->a_ulContended, memory_order_relaxed);
+        l_ptEntry->t_ulWaitNs = atomic_load_explicit(&l_ptSite->a_ulWaitNs, memory_order_relaxed);
+        l_ptEntry->t_ulWaitMaxNs = atomic_load_explicit(&l_ptSite->a_ulWaitMaxNs, memory_order_relaxed);
+        l_ptEntry->t_ulHoldNs = atomic_load_explicit(&l_ptSite->a_ulHoldNs, memory_order_relaxed);
+        l_ptEntry->t_ulHoldMaxNs = atomic_load_explicit(&l_ptSite->a_ulHoldMaxNs, memory_order_relaxed);
+    }
+
+    qsort(l_ptEntries, l_ulCount, sizeof(xOsLockEntry_t), lockProfileCompare);
+    if (p_iTopN > 0 && (size_t)p_iTopN < l_ulCount)
+    {
+        l_ulCount = (size_t)p_iTopN;
+    }
+
+    FILE* l_ptFile = (p_pcPath != NULL) ? fopen(p_pcPath, "w") : stdout;
+    if (l_ptFile == NULL)
+    {
+        free(l_ptEntries);
+        return MUTEX_ERROR;
+    }
+
+#ifndef XOS_LOCK_PROFILE
+    fprintf(l_ptFile, "# lock profile compiled out, build with XOS_LOCK_PROFILE\n");
+#endif
+    fprintf(l_ptFile, "%-32s %-28s %6s %12s %12s %8s %12s %12s %12s %12s\n",
+            "site", "name", "locks", "acquired", "contended", "ratio",
+            "wait_us", "wait_max_us", "hold_us", "hold_max_us");
+    for (size_t i = 0; i < l_ulCount; i++)
+    {
+        xOsLockEntry_t* l_ptEntry = &l_ptEntries[i];
+        char l_cSite[64];
+        snprintf(l_cSite, sizeof(l_cSite), "%s:%d", l_ptEntry->t_pcFile, l_ptEntry->t_iLine);
+        double l_dRatio = (l_ptEntry->t_ulAcquired != 0) ? (double)l_ptEntry->t_ulContended / (double)l_ptEntry->t_ulAcquired : 0.0;
+        fprintf(l_ptFile, "%-32s %-28s %6llu %12llu %12llu %7.2f%% %12.1f %12.1f %12.1f %12.1f\n",
+                l_cSite, l_ptEntry->t_pcName,
+                (unsigned long long)l_ptEntry->t_ulLocks,
+                (unsigned long long)l_ptEntry->t_ulAcquired,
+                (unsigned long long)l_ptEntry->t_ulContended,
+                l_dRatio * 100.0,
+                (double)l_ptEntry->t_ulWaitNs / 1000.0,
+                (double)l_ptEntry->t_ulWaitMaxNs / 1000.0,
+                (double)l_ptEntry->t_ulHoldNs / 1000.0,
+                (double)l_ptEntry->t_ulHoldMaxNs / 1000.0);
+    }
+
+    if (l_ptFile != stdout)
+    {
+        fclose(l_ptFile);
+    }
+    free(l_ptEntries);
+    return MUTEX_OK;
+}
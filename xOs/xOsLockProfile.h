@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////
+//  lock profile header file
+//  defines the lock contention profile of xOsMutexCtx and t_osCriticalCtx
+//
+// Built with XOS_LOCK_PROFILE (cmake -DUSE_LOCK_PROFILE=ON), every lock
+// records its acquisitions, contended acquisitions, wait and hold times
+// in the record of its creation site. Locks created at the same site,
+// e.g. one per socket, share a record. Without the flag the lock paths
+// carry no instrumentation and the dump reports nothing
+//
+// general discloser: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+#pragma once
+
+#ifndef XOS_LOCK_PROFILE_H_
+#define XOS_LOCK_PROFILE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <time.h>
+
+#define XOS_LOCK_PROFILE_MAX_SITES  256             // Power of two
+
+//////////////////////////////////
+/// @brief lock creation site counters, written with relaxed atomics
+//////////////////////////////////
+typedef struct xos_lock_site_t
+{
+    _Atomic(const char*) a_pcFile;      // Source file (NULL = free slot)
+    atomic_int a_iLine;                 // Line number
+    _Atomic(const char*) a_pcName;      // Lock expression at creation
+    atomic_bool a_bReady;               // Key fields are published
+    atomic_ulong a_ulLocks;             // Locks created at this site
+    atomic_ulong a_ulAcquired;          // Acquisitions
+    atomic_ulong a_ulContended;         // Acquisitions that had to wait
+    _Atomic uint64_t a_ulWaitNs;        // Cumulated wait
+    _Atomic uint64_t a_ulWaitMaxNs;     // Longest wait
+    _Atomic uint64_t a_ulHoldNs;        // Cumulated hold, outermost lock to last unlock
+    _Atomic uint64_t a_ulHoldMaxNs;     // Longest hold
+} xOsLockSite_t;
+
+//////////////////////////////////
+/// @brief Get the monotonic time used by the lock profile
+/// @return nanoseconds
+//////////////////////////////////
+static inline uint64_t lockProfileNow(void)
+{
+    struct timespec l_tNow;
+    clock_gettime(CLOCK_MONOTONIC, &l_tNow);
+    return (uint64_t)l_tNow.tv_sec * 1000000000ULL + (uint64_t)l_tNow.tv_nsec;
+}
+
+//////////////////////////////////
+/// @brief Get the record of a creation site, creating it if needed
+/// @param p_pcName : lock name
+/// @param p_pcFile : creation file
+/// @param p_iLine : creation line
+/// @return site record, NULL when the table is full
+//////////////////////////////////
+xOsLockSite_t* lockProfileRegister(const char* p_pcName, const char* p_pcFile, int p_iLine);
+
+//////////////////////////////////
+/// @brief Account an acquisition
+/// @param p_ptSite : site record (may be NULL)
+/// @param p_bContended : the lock was held by another thread
+/// @param p_ulWaitNs : time spent waiting
+/// @return none
+//////////////////////////////////
+void lockProfileAcquired(xOsLockSite_t* p_ptSite, bool p_bContended, uint64_t p_ulWaitNs);
+
+//////////////////////////////////
+/// @brief Account a release of the outermost lock
+/// @param p_ptSite : site record (may be NULL)
+/// @param p_ulHoldNs : time the lock was held
+/// @return none
+//////////////////////////////////
+void lockProfileReleased(xOsLockSite_t* p_ptSite, uint64_t p_ulHoldNs);
+
+//////////////////////////////////
+/// @brief Reset every site counter, the sites stay registered
+/// @return : success or error code
+//////////////////////////////////
+int lockProfileReset(void);
+
+//////////////////////////////////
+/// @brief Write the most contended sites
+/// @param p_pcPath : output file path, NULL for stdout
+/// @param p_iTopN : sites written (0 for all)
+/// @return : success or error code
+/// @note sites are sorted by cumulated wait, then by contended acquisitions
+//////////////////////////////////
+int lockProfileDump(const char* p_pcPath, int p_iTopN);
+
+#endif // XOS_LOCK_PROFILE_H_
@@ -8,13 +8,67 @@
 ////////////////////////////////////////////////////////////
 
 #include "xOs/xOsMutex.h"
+#include "xOs/xOsFutex.h"
 #include "assert/xAssert.h"
+#include "xLog/xTrace.h"
 #include <string.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sched.h>
+
+// Online CPUs, 0 until the first contended lock, spinning is pointless on one
+static atomic_int s_iCpuCount = 0;
+
+#ifdef XOS_LOCK_PROFILE
+////////////////////////////////////////////////////////////
+/// mutexProfileAcquired
+////////////////////////////////////////////////////////////
+static void mutexProfileAcquired(xOsMutexCtx *p_ptMutex, bool p_bContended, uint64_t p_ulStartNs)
+{
+    if (p_ptMutex->t_ptProfile == NULL)
+    {
+        return;
+    }
+
+    uint64_t l_ulNow = lockProfileNow();
+    lockProfileAcquired(p_ptMutex->t_ptProfile, p_bContended, p_bContended ? l_ulNow - p_ulStartNs : 0);
+
+    // Recursive locks are held from the outermost lock to the matching unlock
+    if (p_ptMutex->t_iDepth++ == 0)
+    {
+        p_ptMutex->t_ulAcquiredNs = l_ulNow;
+    }
+}
+
+////////////////////////////////////////////////////////////
+/// mutexProfileReleasing
+////////////////////////////////////////////////////////////
+static void mutexProfileReleasing(xOsMutexCtx *p_ptMutex)
+{
+    if (p_ptMutex->t_ptProfile == NULL || p_ptMutex->t_iDepth == 0)
+    {
+        return;
+    }
+
+    if (--p_ptMutex->t_iDepth == 0)
+    {
+        lockProfileReleased(p_ptMutex->t_ptProfile, lockProfileNow() - p_ptMutex->t_ulAcquiredNs);
+    }
+}
+#endif
 
 ////////////////////////////////////////////////////////////
 /// mutexCreate
 ////////////////////////////////////////////////////////////
-int mutexCreate(xOsMutexCtx *p_ptMutex)
+int (mutexCreate)(xOsMutexCtx *p_ptMutex)
+{
+    return mutexCreateAt(p_ptMutex, NULL, NULL, 0);
+}
+
+////////////////////////////////////////////////////////////
+/// mutexCreateAt
+////////////////////////////////////////////////////////////
+int mutexCreateAt(xOsMutexCtx *p_ptMutex, const char *p_pcName, const char *p_pcFile, int p_iLine)
 {
     X_ASSERT(p_ptMutex != NULL);
 
@@ -36,6 +90,11 @@ int mutexCreate(xOsMutexCtx *p_ptMutex)
 
     p_ptMutex->t_iState = MUTEX_UNLOCKED;
     p_ptMutex->t_ulTimeout = MUTEX_DEFAULT_TIMEOUT;
+#ifdef XOS_LOCK_PROFILE
+    p_ptMutex->t_ptProfile = lockProfileRegister(p_pcName, p_pcFile, p_iLine);
+    p_ptMutex->t_ulAcquiredNs = 0;
+    p_ptMutex->t_iDepth = 0;
+#endif
 
     return MUTEX_OK;
 }
@@ -47,10 +106,41 @@ int mutexLock(xOsMutexCtx *p_ptMutex)
 {
     X_ASSERT(p_ptMutex != NULL);
 
+#ifdef XOS_LOCK_PROFILE
+    // A failed try tells a contended acquisition from a free one
+    bool l_bContended = false;
+    uint64_t l_ulStart = 0;
+    int l_iRet = pthread_mutex_trylock(&p_ptMutex->t_mutex);
+    if (l_iRet == EBUSY)
+    {
+        l_bContended = true;
+        l_ulStart = lockProfileNow();
+        l_iRet = pthread_mutex_lock(&p_ptMutex->t_mutex);
+    }
+    if (l_iRet != 0)
+    {
+        return MUTEX_ERROR;
+    }
+    mutexProfileAcquired(p_ptMutex, l_bContended, l_ulStart);
+#elif defined(XOS_TRACE)
+    // Only a contended acquisition shows in the trace, as the wait it caused
+    int l_iRet = pthread_mutex_trylock(&p_ptMutex->t_mutex);
+    if (l_iRet == EBUSY)
+    {
+        X_TRACE_BEGIN("mutex.wait");
+        l_iRet = pthread_mutex_lock(&p_ptMutex->t_mutex);
+        X_TRACE_END("mutex.wait");
+    }
+    if (l_iRet != 0)
+    {
+        return MUTEX_ERROR;
+    }
+#else
     if (pthread_mutex_lock(&p_ptMutex->t_mutex) != 0)
     {
         return MUTEX_ERROR;
     }
+#endif
 
     p_ptMutex->t_iState = MUTEX_LOCKED;
     return MUTEX_OK;
@@ -73,6 +163,9 @@ int mutexTryLock(xOsMutexCtx *p_ptMutex)
         return MUTEX_ERROR;
     }
 
+#ifdef XOS_LOCK_PROFILE
+    mutexProfileAcquired(p_ptMutex, false, 0);
+#endif
     p_ptMutex->t_iState = MUTEX_LOCKED;
     return MUTEX_OK;
 }
@@ -84,12 +177,21 @@ int mutexLockTimeout(xOsMutexCtx *p_ptMutex, unsigned long p_ulTimeout)
 {
     X_ASSERT(p_ptMutex != NULL);
 
+#ifdef XOS_LOCK_PROFILE
+    if (pthread_mutex_trylock(&p_ptMutex->t_mutex) == 0)
+    {
+        mutexProfileAcquired(p_ptMutex, false, 0);
+        p_ptMutex->t_iState = MUTEX_LOCKED;
+        return MUTEX_OK;
+    }
+    uint64_t l_ulStart = lockProfileNow();
+#endif
+
+    // Monotonic deadline, a wall clock step must not stretch or cut the wait
     struct timespec l_tTimeout;
-    clock_gettime(CLOCK_REALTIME, &l_tTimeout);
-    l_tTimeout.tv_sec += p_ulTimeout / 1000;
-    l_tTimeout.tv_nsec += (p_ulTimeout % 1000) * 1000000;
+    osDeadlineAfter(&l_tTimeout, p_ulTimeout);
 
-    int l_ulReturn = pthread_mutex_timedlock(&p_ptMutex->t_mutex, &l_tTimeout);
+    int l_ulReturn = pthread_mutex_clocklock(&p_ptMutex->t_mutex, CLOCK_MONOTONIC, &l_tTimeout);
     if (l_ulReturn == ETIMEDOUT)
     {
         return MUTEX_TIMEOUT;
@@ -99,6 +201,10 @@ int mutexLockTimeout(xOsMutexCtx *p_ptMutex, unsigned long p_ulTimeout)
         return MUTEX_ERROR;
     }
 
+#ifdef XOS_LOCK_PROFILE
+    mutexProfileAcquired(p_ptMutex, true, l_ulStart);
+#endif
+
     p_ptMutex->t_iState = MUTEX_LOCKED;
     return MUTEX_OK;
 }
@@ -110,6 +216,9 @@ int mutexUnlock(xOsMutexCtx *p_ptMutex)
 {
     X_ASSERT(p_ptMutex != NULL);
 
+#ifdef XOS_LOCK_PROFILE
+    mutexProfileReleasing(p_ptMutex);
+#endif
     if (pthread_mutex_unlock(&p_ptMutex->t_mutex) != 0)
     {
         return MUTEX_ERROR;
@@ -155,3 +264,305 @@ int mutexGetState(xOsMutexCtx *p_ptMutex)
 
     return p_ptMutex->t_iState;
 }
+
+////////////////////////////////////////////////////////////
+/// cpuRelax
+////////////////////////////////////////////////////////////
+static inline void cpuRelax(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+////////////////////////////////////////////////////////////
+/// mutexFastSpinLimit
+////////////////////////////////////////////////////////////
+static int mutexFastSpinLimit(xOsFastMutex *p_ptMutex)
+{
+    int l_iCpus = atomic_load_explicit(&s_iCpuCount, memory_order_relaxed);
+    if (l_iCpus == 0)
+    {
+        l_iCpus = (int)sysconf(_SC_NPROCESSORS_ONLN);
+        if (l_iCpus < 1)
+        {
+            l_iCpus = 1;
+        }
+        atomic_store_explicit(&s_iCpuCount, l_iCpus, memory_order_relaxed);
+    }
+    if (l_iCpus == 1)
+    {
+        return 0;
+    }
+
+    // Same rule as the glibc adaptive mutex: twice the average plus a margin
+    int l_iLimit = atomic_load_explicit(&p_ptMutex->a_iSpin, memory_order_relaxed) * 2 + 10;
+    return l_iLimit < MUTEX_FAST_SPIN_MAX ? l_iLimit : MUTEX_FAST_SPIN_MAX;
+}
+
+////////////////////////////////////////////////////////////
+/// mutexFastLockSlow
+////////////////////////////////////////////////////////////
+static int mutexFastLockSlow(xOsFastMutex *p_ptMutex, const struct timespec *p_ptDeadline)
+{
+    int l_iLimit = mutexFastSpinLimit(p_ptMutex);
+    int l_iCount = 0;
+    int l_iExpected;
+
+    for (; l_iCount < l_iLimit; l_iCount++)
+    {
+        l_iExpected = 0;
+        if (atomic_load_explicit(&p_ptMutex->a_iState, memory_order_relaxed) == 0 &&
+            atomic_compare_exchange_weak_explicit(&p_ptMutex->a_iState, &l_iExpected, 1,
+                                                  memory_order_acquire, memory_order_relaxed))
+        {
+            break;
+        }
+        cpuRelax();
+    }
+
+    int l_iSpin = atomic_load_explicit(&p_ptMutex->a_iSpin, memory_order_relaxed);
+    atomic_store_explicit(&p_ptMutex->a_iSpin, l_iSpin + (l_iCount - l_iSpin) / 8, memory_order_relaxed);
+    if (l_iCount < l_iLimit)
+    {
+        return MUTEX_OK;
+    }
+
+    // Sleep with the state at 2 so the owner knows to wake somebody
+    while (atomic_exchange_explicit(&p_ptMutex->a_iState, 2, memory_order_acquire) != 0)
+    {
+        if (!osFutexWait(&p_ptMutex->a_iState, 2, p_ptDeadline, false))
+        {
+            return MUTEX_TIMEOUT;
+        }
+    }
+
+    return MUTEX_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// mutexFastInit
+////////////////////////////////////////////////////////////
+int mutexFastInit(xOsFastMutex *p_ptMutex)
+{
+    X_ASSERT(p_ptMutex != NULL);
+
+    atomic_init(&p_ptMutex->a_iState, 0);
+    atomic_init(&p_ptMutex->a_iSpin, 0);
+    return MUTEX_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// mutexFastLock
+////////////////////////////////////////////////////////////
+int mutexFastLock(xOsFastMutex *p_ptMutex)
+{
+    X_ASSERT(p_ptMutex != NULL);
+
+    int l_iExpected = 0;
+    if (atomic_compare_exchange_strong_explicit(&p_ptMutex->a_iState, &l_iExpected, 1,
+                                                memory_order_acquire, memory_order_relaxed))
+    {
+        return MUTEX_OK;
+    }
+
+    return mutexFastLockSlow(p_ptMutex, NULL);
+}
+
+////////////////////////////////////////////////////////////
+/// mutexFastTryLock
+////////////////////////////////////////////////////////////
+int mutexFastTryLock(xOsFastMutex *p_ptMutex)
+{
+    X_ASSERT(p_ptMutex != NULL);
+
+    int l_iExpected = 0;
+    if (atomic_compare_exchange_strong_explicit(&p_ptMutex->a_iState, &l_iExpected, 1,
+                                                memory_order_acquire, memory_order_relaxed))
+    {
+        return MUTEX_OK;
+    }
+
+    return MUTEX_TIMEOUT;
+}
+
+////////////////////////////////////////////////////////////
+/// mutexFastLockTimeout
+////////////////////////////////////////////////////////////
+int mutexFastLockTimeout(xOsFastMutex *p_ptMutex, unsigned long p_ulTimeout)
+{
+    X_ASSERT(p_ptMutex != NULL);
+
+    int l_iExpected = 0;
+    if (atomic_compare_exchange_strong_explicit(&p_ptMutex->a_iState, &l_iExpected, 1,
+                                                memory_order_acquire, memory_order_relaxed))
+    {
+        return MUTEX_OK;
+    }
+
+    struct timespec l_tDeadline;
+    osDeadlineAfter(&l_tDeadline, p_ulTimeout);
+
+    return mutexFastLockSlow(p_ptMutex, &l_tDeadline);
+}
+
+////////////////////////////////////////////////////////////
+/// mutexFastUnlock
+////////////////////////////////////////////////////////////
+int mutexFastUnlock(xOsFastMutex *p_ptMutex)
+{
+    X_ASSERT(p_ptMutex != NULL);
+
+    // Only a state of 2 may have sleepers, the uncontended unlock stays in user space
+    int l_iPrevious = atomic_exchange_explicit(&p_ptMutex->a_iState, 0, memory_order_release);
+    if (l_iPrevious == 0)
+    {
+        return MUTEX_ERROR;
+    }
+    if (l_iPrevious == 2)
+    {
+        osFutexWake(&p_ptMutex->a_iState, 1, false);
+    }
+
+    return MUTEX_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// rwLockInit
+////////////////////////////////////////////////////////////
+int rwLockInit(xOsRwLock *p_ptLock)
+{
+    X_ASSERT(p_ptLock != NULL);
+
+    atomic_init(&p_ptLock->a_uiState, 0);
+    atomic_init(&p_ptLock->a_uiWriters, 0);
+    atomic_init(&p_ptLock->a_uiReadersWaiting, 0);
+    atomic_init(&p_ptLock->a_uiReadSeq, 0);
+    atomic_init(&p_ptLock->a_uiWriteSeq, 0);
+    return MUTEX_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// rwLockTryRead
+////////////////////////////////////////////////////////////
+int rwLockTryRead(xOsRwLock *p_ptLock)
+{
+    X_ASSERT(p_ptLock != NULL);
+
+    // Readers stay out while a writer waits, so writers cannot starve
+    unsigned int l_uiState = atomic_load(&p_ptLock->a_uiState);
+    while (atomic_load(&p_ptLock->a_uiWriters) == 0 && (l_uiState & XOS_RWLOCK_WRITER) == 0)
+    {
+        if (atomic_compare_exchange_weak(&p_ptLock->a_uiState, &l_uiState, l_uiState + 1))
+        {
+            return MUTEX_OK;
+        }
+    }
+
+    return MUTEX_TIMEOUT;
+}
+
+////////////////////////////////////////////////////////////
+/// rwLockRead
+////////////////////////////////////////////////////////////
+int rwLockRead(xOsRwLock *p_ptLock)
+{
+    X_ASSERT(p_ptLock != NULL);
+
+    while (rwLockTryRead(p_ptLock) != (int)MUTEX_OK)
+    {
+        // The sequence is read before the condition, a release in between bumps it
+        atomic_fetch_add(&p_ptLock->a_uiReadersWaiting, 1);
+        unsigned int l_uiSeq = atomic_load(&p_ptLock->a_uiReadSeq);
+        if (atomic_load(&p_ptLock->a_uiWriters) != 0 || (atomic_load(&p_ptLock->a_uiState) & XOS_RWLOCK_WRITER) != 0)
+        {
+            osFutexWait(&p_ptLock->a_uiReadSeq, l_uiSeq, NULL, false);
+        }
+        atomic_fetch_sub(&p_ptLock->a_uiReadersWaiting, 1);
+    }
+
+    return MUTEX_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// rwLockReadUnlock
+////////////////////////////////////////////////////////////
+int rwLockReadUnlock(xOsRwLock *p_ptLock)
+{
+    X_ASSERT(p_ptLock != NULL);
+
+    // Checked before the store, an unbalanced unlock leaves the state untouched
+    unsigned int l_uiState = atomic_load(&p_ptLock->a_uiState);
+    do
+    {
+        if (l_uiState == 0 || (l_uiState & XOS_RWLOCK_WRITER) != 0)
+        {
+            return MUTEX_ERROR;
+        }
+    } while (!atomic_compare_exchange_weak(&p_ptLock->a_uiState, &l_uiState, l_uiState - 1));
+
+    // The last reader hands over to a waiting writer
+    if (l_uiState == 1 && atomic_load(&p_ptLock->a_uiWriters) != 0)
+    {
+        atomic_fetch_add(&p_ptLock->a_uiWriteSeq, 1);
+        osFutexWake(&p_ptLock->a_uiWriteSeq, 1, false);
+    }
+
+    return MUTEX_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// rwLockWrite
+////////////////////////////////////////////////////////////
+int rwLockWrite(xOsRwLock *p_ptLock)
+{
+    X_ASSERT(p_ptLock != NULL);
+
+    atomic_fetch_add(&p_ptLock->a_uiWriters, 1);
+    for (;;)
+    {
+        unsigned int l_uiExpected = 0;
+        if (atomic_compare_exchange_strong(&p_ptLock->a_uiState, &l_uiExpected, XOS_RWLOCK_WRITER))
+        {
+            break;
+        }
+
+        unsigned int l_uiSeq = atomic_load(&p_ptLock->a_uiWriteSeq);
+        if (atomic_load(&p_ptLock->a_uiState) != 0)
+        {
+            osFutexWait(&p_ptLock->a_uiWriteSeq, l_uiSeq, NULL, false);
+        }
+    }
+    atomic_fetch_sub(&p_ptLock->a_uiWriters, 1);
+
+    return MUTEX_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// rwLockWriteUnlock
+////////////////////////////////////////////////////////////
+int rwLockWriteUnlock(xOsRwLock *p_ptLock)
+{
+    X_ASSERT(p_ptLock != NULL);
+
+    if (atomic_exchange(&p_ptLock->a_uiState, 0) != XOS_RWLOCK_WRITER)
+    {
+        return MUTEX_ERROR;
+    }
+
+    // Pending writers go first, readers are released once none is left
+    if (atomic_load(&p_ptLock->a_uiWriters) != 0)
+    {
+        atomic_fetch_add(&p_ptLock->a_uiWriteSeq, 1);
+        osFutexWake(&p_ptLock->a_uiWriteSeq, 1, false);
+    }
+    else if (atomic_load(&p_ptLock->a_uiReadersWaiting) != 0)
+    {
+        atomic_fetch_add(&p_ptLock->a_uiReadSeq, 1);
+        osFutexWake(&p_ptLock->a_uiReadSeq, INT_MAX, false);
+    }
+
+    return MUTEX_OK;
+}
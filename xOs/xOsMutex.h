@@ -14,6 +14,8 @@
 #include <pthread.h>
 #include <errno.h>
 #include <time.h>
+#include <stdatomic.h>
+#include "xOsLockProfile.h"
 
 // Mutex error codes
 #define MUTEX_OK 0xF3B59E20
@@ -30,17 +32,31 @@
 // Default timeout value (ms)
 #define MUTEX_DEFAULT_TIMEOUT 1000
 
+// Fast mutex spin bound, the adaptive spin count never exceeds it
+#define MUTEX_FAST_SPIN_MAX 100
+
+// Static initializers, equivalent to mutexFastInit and rwLockInit
+#define XOS_FAST_MUTEX_INITIALIZER { 0, 0 }
+#define XOS_RWLOCK_INITIALIZER { 0, 0, 0, 0, 0 }
+#define XOS_RWLOCK_WRITER 0x80000000U
+
 //////////////////////////////////
 /// @brief mutex structure
 /// @param t_mutex : mutex handle
 /// @param t_iState : mutex state
 /// @param t_ulTimeout : timeout value in milliseconds
+/// @note with XOS_LOCK_PROFILE the lock also carries its profile site
 //////////////////////////////////
 typedef struct xos_mutex_ctx_t
 {
     pthread_mutex_t t_mutex;
     int t_iState;
     unsigned long t_ulTimeout;
+#ifdef XOS_LOCK_PROFILE
+    xOsLockSite_t* t_ptProfile;     // Creation site record
+    uint64_t t_ulAcquiredNs;        // Outermost lock time, owner only
+    int t_iDepth;                   // Recursion depth, owner only
+#endif
 } xOsMutexCtx;
 
 //////////////////////////////////
@@ -50,6 +66,21 @@ typedef struct xos_mutex_ctx_t
 //////////////////////////////////
 int mutexCreate(xOsMutexCtx *p_ptMutex);
 
+//////////////////////////////////
+/// @brief create mutex and bind it to a lock profile site
+/// @param p_ptMutex : mutex structure pointer
+/// @param p_pcName : lock name
+/// @param p_pcFile : creation file
+/// @param p_iLine : creation line
+/// @return : success or error code
+/// @note mutexCreate expands to this call with XOS_LOCK_PROFILE
+//////////////////////////////////
+int mutexCreateAt(xOsMutexCtx *p_ptMutex, const char *p_pcName, const char *p_pcFile, int p_iLine);
+
+#ifdef XOS_LOCK_PROFILE
+#define mutexCreate(p_ptMutex) mutexCreateAt((p_ptMutex), #p_ptMutex, __FILE__, __LINE__)
+#endif
+
 //////////////////////////////////
 /// @brief lock mutex
 /// @param p_ptMutex : mutex structure pointer
@@ -101,4 +132,112 @@ int mutexSetTimeout(xOsMutexCtx *p_ptMutex, unsigned long p_ulTimeout);
 //////////////////////////////////
 int mutexGetState(xOsMutexCtx *p_ptMutex);
 
+//////////////////////////////////
+/// @brief fast mutex structure
+/// @param a_iState : 0 unlocked, 1 locked, 2 locked with sleepers
+/// @param a_iSpin : adaptive spin estimate
+/// @note spins then sleeps on a futex, not recursive, for short critical sections
+//////////////////////////////////
+typedef struct xos_fast_mutex_t
+{
+    atomic_int a_iState;
+    atomic_int a_iSpin;
+} xOsFastMutex;
+
+//////////////////////////////////
+/// @brief reader-writer lock structure
+/// @param a_uiState : reader count, XOS_RWLOCK_WRITER while a writer holds the lock
+/// @param a_uiWriters : writers waiting or holding, readers stay out while non zero
+/// @param a_uiReadersWaiting : readers sleeping on a_uiReadSeq
+/// @param a_uiReadSeq : futex word readers sleep on
+/// @param a_uiWriteSeq : futex word writers sleep on
+/// @note writer preferring, not recursive, for read-mostly data
+//////////////////////////////////
+typedef struct xos_rwlock_t
+{
+    atomic_uint a_uiState;
+    atomic_uint a_uiWriters;
+    atomic_uint a_uiReadersWaiting;
+    atomic_uint a_uiReadSeq;
+    atomic_uint a_uiWriteSeq;
+} xOsRwLock;
+
+//////////////////////////////////
+/// @brief initialize fast mutex
+/// @param p_ptMutex : fast mutex structure pointer
+/// @return : success or error code
+//////////////////////////////////
+int mutexFastInit(xOsFastMutex *p_ptMutex);
+
+//////////////////////////////////
+/// @brief lock fast mutex
+/// @param p_ptMutex : fast mutex structure pointer
+/// @return : success or error code
+//////////////////////////////////
+int mutexFastLock(xOsFastMutex *p_ptMutex);
+
+//////////////////////////////////
+/// @brief try to lock fast mutex
+/// @param p_ptMutex : fast mutex structure pointer
+/// @return : success, MUTEX_TIMEOUT when held
+//////////////////////////////////
+int mutexFastTryLock(xOsFastMutex *p_ptMutex);
+
+//////////////////////////////////
+/// @brief lock fast mutex with timeout
+/// @param p_ptMutex : fast mutex structure pointer
+/// @param p_ulTimeout : timeout value in milliseconds, on the monotonic clock
+/// @return : success or error code
+//////////////////////////////////
+int mutexFastLockTimeout(xOsFastMutex *p_ptMutex, unsigned long p_ulTimeout);
+
+//////////////////////////////////
+/// @brief unlock fast mutex
+/// @param p_ptMutex : fast mutex structure pointer
+/// @return : success or error code
+//////////////////////////////////
+int mutexFastUnlock(xOsFastMutex *p_ptMutex);
+
+//////////////////////////////////
+/// @brief initialize reader-writer lock
+/// @param p_ptLock : lock structure pointer
+/// @return : success or error code
+//////////////////////////////////
+int rwLockInit(xOsRwLock *p_ptLock);
+
+//////////////////////////////////
+/// @brief lock for reading, shared with other readers
+/// @param p_ptLock : lock structure pointer
+/// @return : success or error code
+//////////////////////////////////
+int rwLockRead(xOsRwLock *p_ptLock);
+
+//////////////////////////////////
+/// @brief try to lock for reading
+/// @param p_ptLock : lock structure pointer
+/// @return : success, MUTEX_TIMEOUT when a writer holds or waits
+//////////////////////////////////
+int rwLockTryRead(xOsRwLock *p_ptLock);
+
+//////////////////////////////////
+/// @brief release a read lock
+/// @param p_ptLock : lock structure pointer
+/// @return : success or error code
+//////////////////////////////////
+int rwLockReadUnlock(xOsRwLock *p_ptLock);
+
+//////////////////////////////////
+/// @brief lock for writing, exclusive
+/// @param p_ptLock : lock structure pointer
+/// @return : success or error code
+//////////////////////////////////
+int rwLockWrite(xOsRwLock *p_ptLock);
+
+//////////////////////////////////
+/// @brief release a write lock
+/// @param p_ptLock : lock structure pointer
+/// @return : success or error code
+//////////////////////////////////
+int rwLockWriteUnlock(xOsRwLock *p_ptLock);
+
 #endif // XOS_MUTEX_H_
@@ -0,0 +1,417 @@
+////////////////////////////////////////////////////////////
+//  queue source file
+//  implements bounded lock-free SPSC and MPMC queues
+//
+// general discloser: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+
+#include "xOsQueue.h"
+#include "xOsFutex.h"
+#include "xAssert.h"
+#include "xMemory.h"
+#include <limits.h>
+#include <string.h>
+
+// MPMC cell header, the item follows the sequence number
+typedef struct
+{
+    _Atomic uint64_t a_ulSeq;               // Position the cell is ready for
+} queueCell_t;
+
+////////////////////////////////////////////////////////////
+/// queueSignal
+////////////////////////////////////////////////////////////
+static void queueSignal(atomic_uint* p_puiSeq, atomic_uint* p_puiWaiters, uint32_t p_ulCount)
+{
+    // Pairs with the waiter increment: either it sees the new index or we see it
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(p_puiWaiters, memory_order_relaxed) == 0)
+        return;
+
+    atomic_fetch_add(p_puiSeq, 1);
+    osFutexWake(p_puiSeq, p_ulCount > INT_MAX ? INT_MAX : (int)p_ulCount, false);
+}
+
+////////////////////////////////////////////////////////////
+/// queueCell
+////////////////////////////////////////////////////////////
+static inline uint8_t* queueCell(const xOsQueue_t* p_ptQueue, uint64_t p_ulPosition)
+{
+    return p_ptQueue->t_pucCells + (size_t)(p_ulPosition & p_ptQueue->t_ulMask) * p_ptQueue->t_ulStride;
+}
+
+////////////////////////////////////////////////////////////
+/// queueIsEmpty
+////////////////////////////////////////////////////////////
+static inline bool queueIsEmpty(xOsQueue_t* p_ptQueue)
+{
+    return atomic_load(&p_ptQueue->a_ulTail) == atomic_load(&p_ptQueue->a_ulHead);
+}
+
+////////////////////////////////////////////////////////////
+/// queueIsFull
+////////////////////////////////////////////////////////////
+static inline bool queueIsFull(xOsQueue_t* p_ptQueue)
+{
+    return atomic_load(&p_ptQueue->a_ulTail) - atomic_load(&p_ptQueue->a_ulHead) > p_ptQueue->t_ulMask;
+}
+
+////////////////////////////////////////////////////////////
+/// queueSpscPush
+////////////////////////////////////////////////////////////
+static uint32_t queueSpscPush(xOsQueue_t* p_ptQueue, const uint8_t* p_pucItems, uint32_t p_ulCount)
+{
+    uint64_t l_ulCapacity = (uint64_t)p_ptQueue->t_ulMask + 1;
+    uint64_t l_ulTail = atomic_load_explicit(&p_ptQueue->a_ulTail, memory_order_relaxed);
+
+    // The head is only read again when the cached copy says there is no room
+    uint64_t l_ulFree = l_ulCapacity - (l_ulTail - p_ptQueue->t_ulCachedHead);
+    if (l_ulFree < p_ulCount)
+    {
+        p_ptQueue->t_ulCachedHead = atomic_load_explicit(&p_ptQueue->a_ulHead, memory_order_acquire);
+        l_ulFree = l_ulCapacity - (l_ulTail - p_ptQueue->t_ulCachedHead);
+    }
+
+    uint32_t l_ulCount = (l_ulFree < p_ulCount) ? (uint32_t)l_ulFree : p_ulCount;
+    if (l_ulCount == 0)
+        return 0;
+
+    // At most two copies around the end of the ring
+    uint32_t l_ulIndex = (uint32_t)(l_ulTail & p_ptQueue->t_ulMask);
+    uint32_t l_ulFirst = (l_ulCount < l_ulCapacity - l_ulIndex) ? l_ulCount : (uint32_t)(l_ulCapacity - l_ulIndex);
+    memcpy(queueCell(p_ptQueue, l_ulTail), p_pucItems, (size_t)l_ulFirst * p_ptQueue->t_ulItemSize);
+    if (l_ulFirst < l_ulCount)
+        memcpy(p_ptQueue->t_pucCells, p_pucItems + (size_t)l_ulFirst * p_ptQueue->t_ulItemSize,
+               (size_t)(l_ulCount - l_ulFirst) * p_ptQueue->t_ulItemSize);
+
+    atomic_store_explicit(&p_ptQueue->a_ulTail, l_ulTail + l_ulCount, memory_order_release);
+    return l_ulCount;
+}
+
+////////////////////////////////////////////////////////////
+/// queueSpscPop
+////////////////////////////////////////////////////////////
+static uint32_t queueSpscPop(xOsQueue_t* p_ptQueue, uint8_t* p_pucItems, uint32_t p_ulMax)
+{
+    uint64_t l_ulCapacity = (uint64_t)p_ptQueue->t_ulMask + 1;
+    uint64_t l_ulHead = atomic_load_explicit(&p_ptQueue->a_ulHead, memory_order_relaxed);
+
+    uint64_t l_ulUsed = p_ptQueue->t_ulCachedTail - l_ulHead;
+    if (l_ulUsed < p_ulMax)
+    {
+        p_ptQueue->t_ulCachedTail = atomic_load_explicit(&p_ptQueue->a_ulTail, memory_order_acquire);
+        l_ulUsed = p_ptQueue->t_ulCachedTail - l_ulHead;
+    }
+
+    uint32_t l_ulCount = (l_ulUsed < p_ulMax) ? (uint32_t)l_ulUsed : p_ulMax;
+    if (l_ulCount == 0)
+        return 0;
+
+    uint32_t l_ulIndex = (uint32_t)(l_ulHead & p_ptQueue->t_ulMask);
+    uint32_t l_ulFirst = (l_ulCount < l_ulCapacity - l_ulIndex) ? l_ulCount : (uint32_t)(l_ulCapacity - l_ulIndex);
+    memcpy(p_pucItems, queueCell(p_ptQueue, l_ulHead), (size_t)l_ulFirst * p_ptQueue->t_ulItemSize);
+    if (l_ulFirst < l_ulCount)
+        memcpy(p_pucItems + (size_t)l_ulFirst * p_ptQueue->t_ulItemSize, p_ptQueue->t_pucCells,
+               (size_t)(l_ulCount - l_ulFirst) * p_ptQueue->t_ulItemSize);
+
+    atomic_store_explicit(&p_ptQueue->a_ulHead, l_ulHead + l_ulCount, memory_order_release);
+    return l_ulCount;
+}
+
+////////////////////////////////////////////////////////////
+/// queueMpmcPush
+////////////////////////////////////////////////////////////
+static bool queueMpmcPush(xOsQueue_t* p_ptQueue, const uint8_t* p_pucItem)
+{
+    uint64_t l_ulPosition = atomic_load_explicit(&p_ptQueue->a_ulTail, memory_order_relaxed);
+
+    for (;;)
+    {
+        queueCell_t* l_ptCell = (queueCell_t*)queueCell(p_ptQueue, l_ulPosition);
+        uint64_t l_ulSeq = atomic_load_explicit(&l_ptCell->a_ulSeq, memory_order_acquire);
+        int64_t l_llDiff = (int64_t)(l_ulSeq - l_ulPosition);
+
+        if (l_llDiff == 0)
+        {
+            // The cell is free for this lap, claim the position
+            if (atomic_compare_exchange_weak_explicit(&p_ptQueue->a_ulTail, &l_ulPosition, l_ulPosition + 1,
+                                                      memory_order_relaxed, memory_order_relaxed))
+            {
+                memcpy(l_ptCell + 1, p_pucItem, p_ptQueue->t_ulItemSize);
+                atomic_store_explicit(&l_ptCell->a_ulSeq, l_ulPosition + 1, memory_order_release);
+                return true;
+            }
+        }
+        else if (l_llDiff < 0)
+        {
+            // The consumer of the previous lap has not released the cell
+            return false;
+        }
+        else
+        {
+            l_ulPosition = atomic_load_explicit(&p_ptQueue->a_ulTail, memory_order_relaxed);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////
+/// queueMpmcPop
+////////////////////////////////////////////////////////////
+static bool queueMpmcPop(xOsQueue_t* p_ptQueue, uint8_t* p_pucItem)
+{
+    uint64_t l_ulPosition = atomic_load_explicit(&p_ptQueue->a_ulHead, memory_order_relaxed);
+
+    for (;;)
+    {
+        queueCell_t* l_ptCell = (queueCell_t*)queueCell(p_ptQueue, l_ulPosition);
+        uint64_t l_ulSeq = atomic_load_explicit(&l_ptCell->a_ulSeq, memory_order_acquire);
+        int64_t l_llDiff = (int64_t)(l_ulSeq - (l_ulPosition + 1));
+
+        if (l_llDiff == 0)
+        {
+            if (atomic_compare_exchange_weak_explicit(&p_ptQueue->a_ulHead, &l_ulPosition, l_ulPosition + 1,
+                                                      memory_order_relaxed, memory_order_relaxed))
+            {
+                memcpy(p_pucItem, l_ptCell + 1, p_ptQueue->t_ulItemSize);
+                // Ready for the producer of the next lap
+                atomic_store_explicit(&l_ptCell->a_ulSeq, l_ulPosition + p_ptQueue->t_ulMask + 1, memory_order_release);
+                return true;
+            }
+        }
+        else if (l_llDiff < 0)
+        {
+            return false;
+        }
+        else
+        {
+            l_ulPosition = atomic_load_explicit(&p_ptQueue->a_ulHead, memory_order_relaxed);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////
+/// xOsQueueCreate
+////////////////////////////////////////////////////////////
+int xOsQueueCreate(xOsQueue_t* p_ptQueue, int p_iType, uint32_t p_ulCapacity, uint32_t p_ulItemSize)
+{
+    X_ASSERT_RETURN(p_ptQueue != NULL, XOS_QUEUE_INVALID);
+    X_ASSERT_RETURN(p_iType == XOS_QUEUE_SPSC || p_iType == XOS_QUEUE_MPMC, XOS_QUEUE_INVALID);
+    X_ASSERT_RETURN(p_ulItemSize > 0, XOS_QUEUE_INVALID);
+
+    if (p_ulCapacity == 0 || p_ulCapacity > XOS_QUEUE_MAX_CAPACITY)
+        return XOS_QUEUE_INVALID;
+
+    uint32_t l_ulCapacity = 1;
+    while (l_ulCapacity < p_ulCapacity)
+        l_ulCapacity <<= 1;
+
+    memset(p_ptQueue, 0, sizeof(*p_ptQueue));
+    p_ptQueue->t_iType = p_iType;
+    p_ptQueue->t_ulMask = l_ulCapacity - 1;
+    p_ptQueue->t_ulItemSize = p_ulItemSize;
+
+    // MPMC cells carry their sequence number, kept 8-byte aligned
+    p_ptQueue->t_ulStride = (p_iType == XOS_QUEUE_MPMC)
+                          ? (uint32_t)((sizeof(queueCell_t) + p_ulItemSize + 7U) & ~7U)
+                          : p_ulItemSize;
+
+    p_ptQueue->t_pucCells = (uint8_t*)X_MALLOC((size_t)l_ulCapacity * p_ptQueue->t_ulStride);
+    if (p_ptQueue->t_pucCells == NULL)
+        return XOS_QUEUE_ERROR;
+
+    if (p_iType == XOS_QUEUE_MPMC)
+    {
+        for (uint32_t i = 0; i < l_ulCapacity; i++)
+            atomic_init(&((queueCell_t*)queueCell(p_ptQueue, i))->a_ulSeq, i);
+    }
+
+    atomic_init(&p_ptQueue->a_ulTail, 0);
+    atomic_init(&p_ptQueue->a_ulHead, 0);
+    atomic_init(&p_ptQueue->a_uiNotFullSeq, 0);
+    atomic_init(&p_ptQueue->a_uiNotFullWaiters, 0);
+    atomic_init(&p_ptQueue->a_uiNotEmptySeq, 0);
+    atomic_init(&p_ptQueue->a_uiNotEmptyWaiters, 0);
+
+    return XOS_QUEUE_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xOsQueueDestroy
+////////////////////////////////////////////////////////////
+int xOsQueueDestroy(xOsQueue_t* p_ptQueue)
+{
+    X_ASSERT_RETURN(p_ptQueue != NULL, XOS_QUEUE_INVALID);
+
+    if (p_ptQueue->t_pucCells != NULL)
+        X_FREE(p_ptQueue->t_pucCells);
+    p_ptQueue->t_pucCells = NULL;
+
+    return XOS_QUEUE_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xOsQueuePushBatch
+////////////////////////////////////////////////////////////
+int xOsQueuePushBatch(xOsQueue_t* p_ptQueue, const void* p_pvItems, uint32_t p_ulCount, uint32_t* p_pulPushed)
+{
+    X_ASSERT_RETURN(p_ptQueue != NULL && p_ptQueue->t_pucCells != NULL, XOS_QUEUE_INVALID);
+    X_ASSERT_RETURN(p_pvItems != NULL || p_ulCount == 0, XOS_QUEUE_INVALID);
+
+    const uint8_t* l_pucItems = (const uint8_t*)p_pvItems;
+    uint32_t l_ulPushed = 0;
+
+    if (p_ptQueue->t_iType == XOS_QUEUE_SPSC)
+        l_ulPushed = queueSpscPush(p_ptQueue, l_pucItems, p_ulCount);
+    else
+    {
+        while (l_ulPushed < p_ulCount &&
+               queueMpmcPush(p_ptQueue, l_pucItems + (size_t)l_ulPushed * p_ptQueue->t_ulItemSize))
+            l_ulPushed++;
+    }
+
+    if (p_pulPushed != NULL)
+        *p_pulPushed = l_ulPushed;
+    if (l_ulPushed == 0)
+        return (p_ulCount == 0) ? XOS_QUEUE_OK : XOS_QUEUE_FULL;
+
+    queueSignal(&p_ptQueue->a_uiNotEmptySeq, &p_ptQueue->a_uiNotEmptyWaiters, l_ulPushed);
+    return XOS_QUEUE_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xOsQueuePopBatch
+////////////////////////////////////////////////////////////
+int xOsQueuePopBatch(xOsQueue_t* p_ptQueue, void* p_pvItems, uint32_t p_ulMax, uint32_t* p_pulPopped)
+{
+    X_ASSERT_RETURN(p_ptQueue != NULL && p_ptQueue->t_pucCells != NULL, XOS_QUEUE_INVALID);
+    X_ASSERT_RETURN(p_pvItems != NULL || p_ulMax == 0, XOS_QUEUE_INVALID);
+
+    uint8_t* l_pucItems = (uint8_t*)p_pvItems;
+    uint32_t l_ulPopped = 0;
+
+    if (p_ptQueue->t_iType == XOS_QUEUE_SPSC)
+        l_ulPopped = queueSpscPop(p_ptQueue, l_pucItems, p_ulMax);
+    else
+    {
+        while (l_ulPopped < p_ulMax &&
+               queueMpmcPop(p_ptQueue, l_pucItems + (size_t)l_ulPopped * p_ptQueue->t_ulItemSize))
+            l_ulPopped++;
+    }
+
+    if (p_pulPopped != NULL)
+        *p_pulPopped = l_ulPopped;
+    if (l_ulPopped == 0)
+        return (p_ulMax == 0) ? XOS_QUEUE_OK : XOS_QUEUE_EMPTY;
+
+    queueSignal(&p_ptQueue->a_uiNotFullSeq, &p_ptQueue->a_uiNotFullWaiters, l_ulPopped);
+    return XOS_QUEUE_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xOsQueuePush
+////////////////////////////////////////////////////////////
+int xOsQueuePush(xOsQueue_t* p_ptQueue, const void* p_pvItem)
+{
+    return xOsQueuePushBatch(p_ptQueue, p_pvItem, 1, NULL);
+}
+
+////////////////////////////////////////////////////////////
+/// xOsQueuePop
+////////////////////////////////////////////////////////////
+int xOsQueuePop(xOsQueue_t* p_ptQueue, void* p_pvItem)
+{
+    return xOsQueuePopBatch(p_ptQueue, p_pvItem, 1, NULL);
+}
+
+////////////////////////////////////////////////////////////
+/// xOsQueuePushWait
+////////////////////////////////////////////////////////////
+int xOsQueuePushWait(xOsQueue_t* p_ptQueue, const void* p_pvItem, int p_iTimeoutMs)
+{
+    struct timespec l_tDeadline;
+    if (p_iTimeoutMs > 0)
+        osDeadlineAfter(&l_tDeadline, (unsigned long)p_iTimeoutMs);
+
+    for (;;)
+    {
+        int l_iRet = xOsQueuePush(p_ptQueue, p_pvItem);
+        if (l_iRet != (int)XOS_QUEUE_FULL)
+            return l_iRet;
+        if (p_iTimeoutMs == 0)
+            return XOS_QUEUE_TIMEOUT;
+
+        // Announce the wait, then check again before parking
+        atomic_fetch_add(&p_ptQueue->a_uiNotFullWaiters, 1);
+        unsigned int l_uiSeq = atomic_load(&p_ptQueue->a_uiNotFullSeq);
+        bool l_bInTime = true;
+        if (queueIsFull(p_ptQueue))
+            l_bInTime = osFutexWait(&p_ptQueue->a_uiNotFullSeq, l_uiSeq, (p_iTimeoutMs < 0) ? NULL : &l_tDeadline, false);
+        atomic_fetch_sub(&p_ptQueue->a_uiNotFullWaiters, 1);
+
+        if (!l_bInTime)
+        {
+            l_iRet = xOsQueuePush(p_ptQueue, p_pvItem);
+            return (l_iRet == (int)XOS_QUEUE_FULL) ? (int)XOS_QUEUE_TIMEOUT : l_iRet;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////
+/// xOsQueuePopWait
+////////////////////////////////////////////////////////////
+int xOsQueuePopWait(xOsQueue_t* p_ptQueue, void* p_pvItem, int p_iTimeoutMs)
+{
+    struct timespec l_tDeadline;
+    if (p_iTimeoutMs > 0)
+        osDeadlineAfter(&l_tDeadline, (unsigned long)p_iTimeoutMs);
+
+    for (;;)
+    {
+        int l_iRet = xOsQueuePop(p_ptQueue, p_pvItem);
+        if (l_iRet != (int)XOS_QUEUE_EMPTY)
+            return l_iRet;
+        if (p_iTimeoutMs == 0)
+            return XOS_QUEUE_TIMEOUT;
+
+        atomic_fetch_add(&p_ptQueue->a_uiNotEmptyWaiters, 1);
+        unsigned int l_uiSeq = atomic_load(&p_ptQueue->a_uiNotEmptySeq);
+        bool l_bInTime = true;
+        if (queueIsEmpty(p_ptQueue))
+            l_bInTime = osFutexWait(&p_ptQueue->a_uiNotEmptySeq, l_uiSeq, (p_iTimeoutMs < 0) ? NULL : &l_tDeadline, false);
+        atomic_fetch_sub(&p_ptQueue->a_uiNotEmptyWaiters, 1);
+
+        if (!l_bInTime)
+        {
+            l_iRet = xOsQueuePop(p_ptQueue, p_pvItem);
+            return (l_iRet == (int)XOS_QUEUE_EMPTY) ? (int)XOS_QUEUE_TIMEOUT : l_iRet;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////
+/// xOsQueueCount
+////////////////////////////////////////////////////////////
+uint32_t xOsQueueCount(xOsQueue_t* p_ptQueue)
+{
+    X_ASSERT_RETURN(p_ptQueue != NULL, 0);
+
+    uint64_t l_ulHead = atomic_load(&p_ptQueue->a_ulHead);
+    uint64_t l_ulTail = atomic_load(&p_ptQueue->a_ulTail);
+
+    // An MPMC claim may move the head past a tail read earlier
+    if (l_ulTail < l_ulHead)
+        return 0;
+    uint64_t l_ulCount = l_ulTail - l_ulHead;
+    return (l_ulCount > (uint64_t)p_ptQueue->t_ulMask + 1) ? p_ptQueue->t_ulMask + 1 : (uint32_t)l_ulCount;
+}
+
+////////////////////////////////////////////////////////////
+/// xOsQueueCapacity
+////////////////////////////////////////////////////////////
+uint32_t xOsQueueCapacity(const xOsQueue_t* p_ptQueue)
+{
+    X_ASSERT_RETURN(p_ptQueue != NULL, 0);
+
+    return p_ptQueue->t_ulMask + 1;
+}
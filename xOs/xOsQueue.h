@@ -0,0 +1,154 @@
+////////////////////////////////////////////////////////////
+//  queue header file
+//  defines bounded lock-free queues for messages between tasks
+//
+// A queue is a power-of-two ring of fixed-size items copied in and out.
+// The SPSC flavour serves one producer and one consumer with plain
+// index publication, the MPMC flavour any number of both with a
+// sequence number per cell. The blocking calls only park on a futex
+// when the queue is empty or full, and the other side only makes a
+// syscall when somebody is parked
+//
+// general discloser: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+#pragma once
+
+#ifndef XOS_QUEUE_H_
+#define XOS_QUEUE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+// Queue error codes
+#define XOS_QUEUE_OK            0xE5B37C10
+#define XOS_QUEUE_ERROR         0xE5B37C11
+#define XOS_QUEUE_INVALID       0xE5B37C12
+#define XOS_QUEUE_FULL          0xE5B37C13
+#define XOS_QUEUE_EMPTY         0xE5B37C14
+#define XOS_QUEUE_TIMEOUT       0xE5B37C15
+
+// Queue flavours
+#define XOS_QUEUE_SPSC          0       // One producer, one consumer
+#define XOS_QUEUE_MPMC          1       // Any number of producers and consumers
+
+// Configuration constants
+#define XOS_QUEUE_MAX_CAPACITY  (1U << 24)
+#define XOS_QUEUE_CACHE_LINE    64
+
+//////////////////////////////////
+/// @brief queue state, each side on its own cache lines
+//////////////////////////////////
+typedef struct xos_queue_t
+{
+    // Producer side
+    _Atomic uint64_t a_ulTail;              // Next position written
+    uint64_t t_ulCachedHead;                // SPSC producer copy of a_ulHead
+    atomic_uint a_uiNotFullSeq;             // Futex word producers park on
+    atomic_uint a_uiNotFullWaiters;         // Producers parked or about to park
+    char t_cPadTail[XOS_QUEUE_CACHE_LINE];
+
+    // Consumer side
+    _Atomic uint64_t a_ulHead;              // Next position read
+    uint64_t t_ulCachedTail;                // SPSC consumer copy of a_ulTail
+    atomic_uint a_uiNotEmptySeq;            // Futex word consumers park on
+    atomic_uint a_uiNotEmptyWaiters;        // Consumers parked or about to park
+    char t_cPadHead[XOS_QUEUE_CACHE_LINE];
+
+    // Read-only after creation
+    uint8_t* t_pucCells;                    // Ring storage
+    uint32_t t_ulMask;                      // Capacity - 1
+    uint32_t t_ulItemSize;                  // Bytes per item
+    uint32_t t_ulStride;                    // Bytes per cell
+    int t_iType;                            // XOS_QUEUE_SPSC or XOS_QUEUE_MPMC
+} __attribute__((aligned(XOS_QUEUE_CACHE_LINE))) xOsQueue_t;
+
+//////////////////////////////////
+/// @brief Create a queue
+/// @param p_ptQueue : queue structure pointer
+/// @param p_iType : XOS_QUEUE_SPSC or XOS_QUEUE_MPMC
+/// @param p_ulCapacity : items held, rounded up to a power of two
+/// @param p_ulItemSize : bytes per item
+/// @return : success or error code
+//////////////////////////////////
+int xOsQueueCreate(xOsQueue_t* p_ptQueue, int p_iType, uint32_t p_ulCapacity, uint32_t p_ulItemSize);
+
+//////////////////////////////////
+/// @brief Release a queue
+/// @param p_ptQueue : queue structure pointer
+/// @return : success or error code
+/// @note no thread may use or wait on the queue anymore
+//////////////////////////////////
+int xOsQueueDestroy(xOsQueue_t* p_ptQueue);
+
+//////////////////////////////////
+/// @brief Copy an item into the queue without blocking
+/// @param p_ptQueue : queue structure pointer
+/// @param p_pvItem : item to copy
+/// @return : success, XOS_QUEUE_FULL, or error code
+//////////////////////////////////
+int xOsQueuePush(xOsQueue_t* p_ptQueue, const void* p_pvItem);
+
+//////////////////////////////////
+/// @brief Copy an item out of the queue without blocking
+/// @param p_ptQueue : queue structure pointer
+/// @param p_pvItem : filled with the oldest item
+/// @return : success, XOS_QUEUE_EMPTY, or error code
+//////////////////////////////////
+int xOsQueuePop(xOsQueue_t* p_ptQueue, void* p_pvItem);
+
+//////////////////////////////////
+/// @brief Copy an item into the queue, waiting for room
+/// @param p_ptQueue : queue structure pointer
+/// @param p_pvItem : item to copy
+/// @param p_iTimeoutMs : timeout in milliseconds (-1 for infinite)
+/// @return : success, XOS_QUEUE_TIMEOUT, or error code
+//////////////////////////////////
+int xOsQueuePushWait(xOsQueue_t* p_ptQueue, const void* p_pvItem, int p_iTimeoutMs);
+
+//////////////////////////////////
+/// @brief Copy an item out of the queue, waiting for one
+/// @param p_ptQueue : queue structure pointer
+/// @param p_pvItem : filled with the oldest item
+/// @param p_iTimeoutMs : timeout in milliseconds (-1 for infinite)
+/// @return : success, XOS_QUEUE_TIMEOUT, or error code
+//////////////////////////////////
+int xOsQueuePopWait(xOsQueue_t* p_ptQueue, void* p_pvItem, int p_iTimeoutMs);
+
+//////////////////////////////////
+/// @brief Copy consecutive items into the queue without blocking
+/// @param p_ptQueue : queue structure pointer
+/// @param p_pvItems : items to copy, packed
+/// @param p_ulCount : items available
+/// @param p_pulPushed : filled with the items copied (may be NULL)
+/// @return : success when at least one item was copied, XOS_QUEUE_FULL, or error code
+/// @note SPSC publishes the whole batch with one index store, waiters are woken once
+//////////////////////////////////
+int xOsQueuePushBatch(xOsQueue_t* p_ptQueue, const void* p_pvItems, uint32_t p_ulCount, uint32_t* p_pulPushed);
+
+//////////////////////////////////
+/// @brief Copy up to a count of items out of the queue without blocking
+/// @param p_ptQueue : queue structure pointer
+/// @param p_pvItems : filled with the items, packed
+/// @param p_ulMax : room in p_pvItems, in items
+/// @param p_pulPopped : filled with the items copied (may be NULL)
+/// @return : success when at least one item was copied, XOS_QUEUE_EMPTY, or error code
+//////////////////////////////////
+int xOsQueuePopBatch(xOsQueue_t* p_ptQueue, void* p_pvItems, uint32_t p_ulMax, uint32_t* p_pulPopped);
+
+//////////////////////////////////
+/// @brief Get the number of queued items
+/// @param p_ptQueue : queue structure pointer
+/// @return : items, a snapshot while other threads run
+//////////////////////////////////
+uint32_t xOsQueueCount(xOsQueue_t* p_ptQueue);
+
+//////////////////////////////////
+/// @brief Get the capacity of a queue
+/// @param p_ptQueue : queue structure pointer
+/// @return : items
+//////////////////////////////////
+uint32_t xOsQueueCapacity(const xOsQueue_t* p_ptQueue);
+
+#endif // XOS_QUEUE_H_
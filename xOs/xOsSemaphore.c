@@ -10,7 +10,9 @@
 
 
 #include "xOsSemaphore.h"
-#include <time.h>  // For CLOCK_REALTIME
+#include "xOsFutex.h"
+#include <time.h>  // For CLOCK_MONOTONIC
+#include <limits.h>
 
 ////////////////////////////////////////////////////////////
 /// osSemInit
@@ -99,9 +101,6 @@ int osSemWait(t_OSSemCtx* p_pttOSSem)
         return OS_SEM_ERROR;
     }
     
-    // Update the value (approximate, as there may be concurrent accesses)
-    osSemGetValue(p_pttOSSem, &p_pttOSSem->value);
-    
     return OS_SEM_SUCCESS;
 }
 
@@ -114,26 +113,15 @@ int osSemWaitTimeout(t_OSSemCtx* p_pttOSSem, unsigned long p_ulTimeoutMs)
         return OS_SEM_ERROR;
     }
     
+    // Monotonic deadline, a wall clock step must not stretch or cut the wait
     struct timespec ts;
-    if (clock_gettime(CLOCK_REALTIME, &ts) == -1) {
-        return OS_SEM_ERROR;
-    }
-    
-    // Convert milliseconds to seconds and nanoseconds
-    ts.tv_sec += p_ulTimeoutMs / 1000;
-    ts.tv_nsec += (p_ulTimeoutMs % 1000) * 1000000;
-    
-    // Normalize nanoseconds (ensure they remain < 1 second)
-    if (ts.tv_nsec >= 1000000000) {
-        ts.tv_sec += 1;
-        ts.tv_nsec -= 1000000000;
-    }
+    osDeadlineAfter(&ts, p_ulTimeoutMs);
     
     int ret;
     if (p_pttOSSem->is_named) {
-        ret = sem_timedwait(p_pttOSSem->sem_handle, &ts);
+        ret = sem_clockwait(p_pttOSSem->sem_handle, CLOCK_MONOTONIC, &ts);
     } else {
-        ret = sem_timedwait(&p_pttOSSem->sem, &ts);
+        ret = sem_clockwait(&p_pttOSSem->sem, CLOCK_MONOTONIC, &ts);
     }
     
     if (ret != 0) {
@@ -143,9 +131,6 @@ int osSemWaitTimeout(t_OSSemCtx* p_pttOSSem, unsigned long p_ulTimeoutMs)
         return OS_SEM_ERROR;
     }
     
-    // Update the value (approximate)
-    osSemGetValue(p_pttOSSem, &p_pttOSSem->value);
-    
     return OS_SEM_SUCCESS;
 }
 
@@ -172,9 +157,6 @@ int osSemTryWait(t_OSSemCtx* p_pttOSSem)
         return OS_SEM_ERROR;
     }
     
-    // Update the value (approximate)
-    osSemGetValue(p_pttOSSem, &p_pttOSSem->value);
-    
     return OS_SEM_SUCCESS;
 }
 
@@ -198,9 +180,6 @@ int osSemPost(t_OSSemCtx* p_pttOSSem)
         return OS_SEM_ERROR;
     }
     
-    // Update the value (approximate)
-    osSemGetValue(p_pttOSSem, &p_pttOSSem->value);
-    
     return OS_SEM_SUCCESS;
 }
 
@@ -224,5 +203,257 @@ int osSemGetValue(t_OSSemCtx* p_pttOSSem, int* p_piValue)
         return OS_SEM_ERROR;
     }
     
+    p_pttOSSem->value = *p_piValue;
+    return OS_SEM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////
+/// osFastSemInit
+////////////////////////////////////////////////////////////
+int osFastSemInit(t_OSFastSemCtx* p_pttOSSem, int p_iInitValue)
+{
+    if (p_pttOSSem == NULL || p_iInitValue < 0) {
+        return OS_SEM_ERROR;
+    }
+
+    atomic_init(&p_pttOSSem->a_iValue, p_iInitValue);
+    atomic_init(&p_pttOSSem->a_iWaiters, 0);
+    p_pttOSSem->initialized = 1;
+    return OS_SEM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////
+/// osFastSemDestroy
+////////////////////////////////////////////////////////////
+int osFastSemDestroy(t_OSFastSemCtx* p_pttOSSem)
+{
+    if (p_pttOSSem == NULL || !p_pttOSSem->initialized) {
+        return OS_SEM_ERROR;
+    }
+
+    p_pttOSSem->initialized = 0;
+    return OS_SEM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////
+/// osFastSemTryWait
+////////////////////////////////////////////////////////////
+int osFastSemTryWait(t_OSFastSemCtx* p_pttOSSem)
+{
+    if (p_pttOSSem == NULL || !p_pttOSSem->initialized) {
+        return OS_SEM_ERROR;
+    }
+
+    int l_iValue = atomic_load_explicit(&p_pttOSSem->a_iValue, memory_order_relaxed);
+    while (l_iValue > 0) {
+        if (atomic_compare_exchange_weak_explicit(&p_pttOSSem->a_iValue, &l_iValue, l_iValue - 1,
+                                                  memory_order_acquire, memory_order_relaxed)) {
+            return OS_SEM_SUCCESS;
+        }
+    }
+
+    return OS_SEM_NOT_AVAILABLE;
+}
+
+////////////////////////////////////////////////////////////
+/// osFastSemWaitDeadline
+////////////////////////////////////////////////////////////
+static int osFastSemWaitDeadline(t_OSFastSemCtx* p_pttOSSem, const struct timespec* p_ptDeadline)
+{
+    for (;;) {
+        int l_iRet = osFastSemTryWait(p_pttOSSem);
+        if (l_iRet != (int)OS_SEM_NOT_AVAILABLE) {
+            return l_iRet;
+        }
+
+        // Register before sleeping on 0, a post in between changes the word
+        atomic_fetch_add(&p_pttOSSem->a_iWaiters, 1);
+        bool l_bInTime = osFutexWait(&p_pttOSSem->a_iValue, 0, p_ptDeadline, false);
+        atomic_fetch_sub(&p_pttOSSem->a_iWaiters, 1);
+
+        if (!l_bInTime) {
+            return (osFastSemTryWait(p_pttOSSem) == (int)OS_SEM_SUCCESS) ? (int)OS_SEM_SUCCESS : (int)OS_SEM_TIMEOUT;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////
+/// osFastSemWait
+////////////////////////////////////////////////////////////
+int osFastSemWait(t_OSFastSemCtx* p_pttOSSem)
+{
+    return osFastSemWaitDeadline(p_pttOSSem, NULL);
+}
+
+////////////////////////////////////////////////////////////
+/// osFastSemWaitTimeout
+////////////////////////////////////////////////////////////
+int osFastSemWaitTimeout(t_OSFastSemCtx* p_pttOSSem, unsigned long p_ulTimeoutMs)
+{
+    struct timespec l_tDeadline;
+    osDeadlineAfter(&l_tDeadline, p_ulTimeoutMs);
+    return osFastSemWaitDeadline(p_pttOSSem, &l_tDeadline);
+}
+
+////////////////////////////////////////////////////////////
+/// osFastSemPost
+////////////////////////////////////////////////////////////
+int osFastSemPost(t_OSFastSemCtx* p_pttOSSem)
+{
+    if (p_pttOSSem == NULL || !p_pttOSSem->initialized) {
+        return OS_SEM_ERROR;
+    }
+
+    if (atomic_fetch_add_explicit(&p_pttOSSem->a_iValue, 1, memory_order_seq_cst) == INT_MAX) {
+        atomic_fetch_sub(&p_pttOSSem->a_iValue, 1);
+        return OS_SEM_ERROR;
+    }
+
+    // Pairs with the waiter registration, the kernel is only entered with a sleeper
+    if (atomic_load_explicit(&p_pttOSSem->a_iWaiters, memory_order_seq_cst) > 0) {
+        osFutexWake(&p_pttOSSem->a_iValue, 1, false);
+    }
+
     return OS_SEM_SUCCESS;
 }
+
+////////////////////////////////////////////////////////////
+/// osFastSemGetValue
+////////////////////////////////////////////////////////////
+int osFastSemGetValue(t_OSFastSemCtx* p_pttOSSem, int* p_piValue)
+{
+    if (p_pttOSSem == NULL || !p_pttOSSem->initialized || p_piValue == NULL) {
+        return OS_SEM_ERROR;
+    }
+
+    *p_piValue = atomic_load_explicit(&p_pttOSSem->a_iValue, memory_order_relaxed);
+    return OS_SEM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////
+/// osEventInit
+////////////////////////////////////////////////////////////
+int osEventInit(t_OSEventCtx* p_pttOSEvent, int p_iManualReset, bool p_bSignaled)
+{
+    if (p_pttOSEvent == NULL || (p_iManualReset != OS_EVENT_AUTO_RESET && p_iManualReset != OS_EVENT_MANUAL_RESET)) {
+        return OS_SEM_ERROR;
+    }
+
+    atomic_init(&p_pttOSEvent->a_uiState, p_bSignaled ? 1U : 0U);
+    atomic_init(&p_pttOSEvent->a_iWaiters, 0);
+    p_pttOSEvent->manual_reset = p_iManualReset;
+    p_pttOSEvent->initialized = 1;
+    return OS_SEM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////
+/// osEventDestroy
+////////////////////////////////////////////////////////////
+int osEventDestroy(t_OSEventCtx* p_pttOSEvent)
+{
+    if (p_pttOSEvent == NULL || !p_pttOSEvent->initialized) {
+        return OS_SEM_ERROR;
+    }
+
+    p_pttOSEvent->initialized = 0;
+    return OS_SEM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////
+/// osEventSet
+////////////////////////////////////////////////////////////
+int osEventSet(t_OSEventCtx* p_pttOSEvent)
+{
+    if (p_pttOSEvent == NULL || !p_pttOSEvent->initialized) {
+        return OS_SEM_ERROR;
+    }
+
+    atomic_store_explicit(&p_pttOSEvent->a_uiState, 1U, memory_order_seq_cst);
+    if (atomic_load_explicit(&p_pttOSEvent->a_iWaiters, memory_order_seq_cst) > 0) {
+        osFutexWake(&p_pttOSEvent->a_uiState, (p_pttOSEvent->manual_reset == OS_EVENT_MANUAL_RESET) ? INT_MAX : 1, false);
+    }
+
+    return OS_SEM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////
+/// osEventReset
+////////////////////////////////////////////////////////////
+int osEventReset(t_OSEventCtx* p_pttOSEvent)
+{
+    if (p_pttOSEvent == NULL || !p_pttOSEvent->initialized) {
+        return OS_SEM_ERROR;
+    }
+
+    atomic_store_explicit(&p_pttOSEvent->a_uiState, 0U, memory_order_release);
+    return OS_SEM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////
+/// osEventConsume
+////////////////////////////////////////////////////////////
+static bool osEventConsume(t_OSEventCtx* p_pttOSEvent)
+{
+    if (p_pttOSEvent->manual_reset == OS_EVENT_MANUAL_RESET) {
+        return atomic_load_explicit(&p_pttOSEvent->a_uiState, memory_order_acquire) != 0;
+    }
+
+    // Auto-reset: the waiter that clears the state owns the signal
+    unsigned int l_uiExpected = 1U;
+    return atomic_compare_exchange_strong_explicit(&p_pttOSEvent->a_uiState, &l_uiExpected, 0U,
+                                                   memory_order_acquire, memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////
+/// osEventWaitDeadline
+////////////////////////////////////////////////////////////
+static int osEventWaitDeadline(t_OSEventCtx* p_pttOSEvent, const struct timespec* p_ptDeadline)
+{
+    if (p_pttOSEvent == NULL || !p_pttOSEvent->initialized) {
+        return OS_SEM_ERROR;
+    }
+
+    for (;;) {
+        if (osEventConsume(p_pttOSEvent)) {
+            return OS_SEM_SUCCESS;
+        }
+
+        atomic_fetch_add(&p_pttOSEvent->a_iWaiters, 1);
+        bool l_bInTime = osFutexWait(&p_pttOSEvent->a_uiState, 0, p_ptDeadline, false);
+        atomic_fetch_sub(&p_pttOSEvent->a_iWaiters, 1);
+
+        if (!l_bInTime) {
+            return osEventConsume(p_pttOSEvent) ? (int)OS_SEM_SUCCESS : (int)OS_SEM_TIMEOUT;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////
+/// osEventWait
+////////////////////////////////////////////////////////////
+int osEventWait(t_OSEventCtx* p_pttOSEvent)
+{
+    return osEventWaitDeadline(p_pttOSEvent, NULL);
+}
+
+////////////////////////////////////////////////////////////
+/// osEventWaitTimeout
+////////////////////////////////////////////////////////////
+int osEventWaitTimeout(t_OSEventCtx* p_pttOSEvent, unsigned long p_ulTimeoutMs)
+{
+    struct timespec l_tDeadline;
+    osDeadlineAfter(&l_tDeadline, p_ulTimeoutMs);
+    return osEventWaitDeadline(p_pttOSEvent, &l_tDeadline);
+}
+
+////////////////////////////////////////////////////////////
+/// osEventIsSet
+////////////////////////////////////////////////////////////
+bool osEventIsSet(t_OSEventCtx* p_pttOSEvent)
+{
+    if (p_pttOSEvent == NULL || !p_pttOSEvent->initialized) {
+        return false;
+    }
+
+    return atomic_load_explicit(&p_pttOSEvent->a_uiState, memory_order_acquire) != 0;
+}
@@ -19,6 +19,8 @@
 #include <sys/stat.h>
 #include <time.h>
 #include <errno.h>
+#include <stdbool.h>
+#include <stdatomic.h>
 #include "xAssert.h"
 
 // Codes de retour
@@ -31,6 +33,10 @@
 #define OS_SEM_UNLOCKED      0
 #define OS_SEM_LOCKED        1
 
+// Types d'événement
+#define OS_EVENT_AUTO_RESET   0 // Un réveil par signal, l'événement se réarme seul
+#define OS_EVENT_MANUAL_RESET 1 // Reste signalé jusqu'à osEventReset
+
 //////////////////////////////////
 // Structure de gestion du sémaphore
 //////////////////////////////////
@@ -38,7 +44,7 @@ typedef struct {
     sem_t       sem;        // Sémaphore POSIX (pour sémaphores anonymes)
     sem_t*      sem_handle; // Pointeur vers le sémaphore (pour sémaphores nommés)
     const char* name;       // Nom du sémaphore (NULL pour les sémaphores anonymes)
-    int         value;      // Valeur actuelle du sémaphore
+    int         value;      // Valeur lue au dernier osSemGetValue
     int         initialized; // Flag indiquant si le sémaphore est initialisé
     int         is_named;   // Flag indiquant s'il s'agit d'un sémaphore nommé
 } t_OSSemCtx;
@@ -72,6 +78,7 @@ int osSemWait(t_OSSemCtx* p_pttOSSem);
 /// @param p_pttOSSem : pointer to the semaphore structure context
 /// @param p_ulTimeoutMs : timeout in milliseconds
 /// @return OS_SEM_SUCCESS if success, OS_SEM_TIMEOUT if timeout, OS_SEM_ERROR otherwise
+/// @note the timeout runs on the monotonic clock
 //////////////////////////////////
 int osSemWaitTimeout(t_OSSemCtx* p_pttOSSem, unsigned long p_ulTimeoutMs);
 
@@ -95,7 +102,134 @@ int osSemPost(t_OSSemCtx* p_pttOSSem);
 /// @param p_pttOSSem : pointer to the semaphore structure context
 /// @param p_piValue : pointer to store the value of the semaphore
 /// @return OS_SEM_SUCCESS if success, OS_SEM_ERROR otherwise
+/// @note also refreshes the value field, which wait and post no longer update
 //////////////////////////////////
 int osSemGetValue(t_OSSemCtx* p_pttOSSem, int* p_piValue);
 
+//////////////////////////////////
+// Sémaphore léger : compteur en espace utilisateur, futex seulement si attente
+//////////////////////////////////
+typedef struct {
+    atomic_int  a_iValue;   // Valeur courante, mot futex des attentes
+    atomic_int  a_iWaiters; // Threads en attente ou sur le point d'attendre
+    int         initialized; // Flag indiquant si le sémaphore est initialisé
+} t_OSFastSemCtx;
+
+//////////////////////////////////
+// Événement : signalé (1) ou non (0), réarmement automatique ou manuel
+//////////////////////////////////
+typedef struct {
+    atomic_uint a_uiState;   // 1 si signalé, mot futex des attentes
+    atomic_int  a_iWaiters;  // Threads en attente ou sur le point d'attendre
+    int         manual_reset; // OS_EVENT_AUTO_RESET ou OS_EVENT_MANUAL_RESET
+    int         initialized; // Flag indiquant si l'événement est initialisé
+} t_OSEventCtx;
+
+//////////////////////////////////
+/// @brief Initialize a lightweight semaphore
+/// @param p_pttOSSem : pointer to the semaphore structure context
+/// @param p_iInitValue : initial value of the semaphore (>=0)
+/// @return OS_SEM_SUCCESS if success, OS_SEM_ERROR otherwise
+/// @note process private, wait and post without contention never enter the kernel
+//////////////////////////////////
+int osFastSemInit(t_OSFastSemCtx* p_pttOSSem, int p_iInitValue);
+
+//////////////////////////////////
+/// @brief Destroy a lightweight semaphore
+/// @param p_pttOSSem : pointer to the semaphore structure context
+/// @return OS_SEM_SUCCESS if success, OS_SEM_ERROR otherwise
+//////////////////////////////////
+int osFastSemDestroy(t_OSFastSemCtx* p_pttOSSem);
+
+//////////////////////////////////
+/// @brief Wait for a lightweight semaphore (P operation / decrement)
+/// @param p_pttOSSem : pointer to the semaphore structure context
+/// @return OS_SEM_SUCCESS if success, OS_SEM_ERROR otherwise
+//////////////////////////////////
+int osFastSemWait(t_OSFastSemCtx* p_pttOSSem);
+
+//////////////////////////////////
+/// @brief Wait for a lightweight semaphore with timeout
+/// @param p_pttOSSem : pointer to the semaphore structure context
+/// @param p_ulTimeoutMs : timeout in milliseconds, on the monotonic clock
+/// @return OS_SEM_SUCCESS if success, OS_SEM_TIMEOUT if timeout, OS_SEM_ERROR otherwise
+//////////////////////////////////
+int osFastSemWaitTimeout(t_OSFastSemCtx* p_pttOSSem, unsigned long p_ulTimeoutMs);
+
+//////////////////////////////////
+/// @brief Try to wait for a lightweight semaphore
+/// @param p_pttOSSem : pointer to the semaphore structure context
+/// @return OS_SEM_SUCCESS if success, OS_SEM_NOT_AVAILABLE if semaphore not available, OS_SEM_ERROR otherwise
+//////////////////////////////////
+int osFastSemTryWait(t_OSFastSemCtx* p_pttOSSem);
+
+//////////////////////////////////
+/// @brief Post a lightweight semaphore (V operation / increment)
+/// @param p_pttOSSem : pointer to the semaphore structure context
+/// @return OS_SEM_SUCCESS if success, OS_SEM_ERROR otherwise
+//////////////////////////////////
+int osFastSemPost(t_OSFastSemCtx* p_pttOSSem);
+
+//////////////////////////////////
+/// @brief Get the value of a lightweight semaphore
+/// @param p_pttOSSem : pointer to the semaphore structure context
+/// @param p_piValue : pointer to store the value of the semaphore
+/// @return OS_SEM_SUCCESS if success, OS_SEM_ERROR otherwise
+//////////////////////////////////
+int osFastSemGetValue(t_OSFastSemCtx* p_pttOSSem, int* p_piValue);
+
+//////////////////////////////////
+/// @brief Initialize an event
+/// @param p_pttOSEvent : pointer to the event structure context
+/// @param p_iManualReset : OS_EVENT_AUTO_RESET or OS_EVENT_MANUAL_RESET
+/// @param p_bSignaled : initial state
+/// @return OS_SEM_SUCCESS if success, OS_SEM_ERROR otherwise
+//////////////////////////////////
+int osEventInit(t_OSEventCtx* p_pttOSEvent, int p_iManualReset, bool p_bSignaled);
+
+//////////////////////////////////
+/// @brief Destroy an event
+/// @param p_pttOSEvent : pointer to the event structure context
+/// @return OS_SEM_SUCCESS if success, OS_SEM_ERROR otherwise
+//////////////////////////////////
+int osEventDestroy(t_OSEventCtx* p_pttOSEvent);
+
+//////////////////////////////////
+/// @brief Signal an event
+/// @param p_pttOSEvent : pointer to the event structure context
+/// @return OS_SEM_SUCCESS if success, OS_SEM_ERROR otherwise
+/// @note auto-reset releases one waiter, manual-reset releases all of them
+//////////////////////////////////
+int osEventSet(t_OSEventCtx* p_pttOSEvent);
+
+//////////////////////////////////
+/// @brief Clear an event
+/// @param p_pttOSEvent : pointer to the event structure context
+/// @return OS_SEM_SUCCESS if success, OS_SEM_ERROR otherwise
+//////////////////////////////////
+int osEventReset(t_OSEventCtx* p_pttOSEvent);
+
+//////////////////////////////////
+/// @brief Wait for an event
+/// @param p_pttOSEvent : pointer to the event structure context
+/// @return OS_SEM_SUCCESS if success, OS_SEM_ERROR otherwise
+/// @note an auto-reset event is cleared by the waiter it releases
+//////////////////////////////////
+int osEventWait(t_OSEventCtx* p_pttOSEvent);
+
+//////////////////////////////////
+/// @brief Wait for an event with timeout
+/// @param p_pttOSEvent : pointer to the event structure context
+/// @param p_ulTimeoutMs : timeout in milliseconds, on the monotonic clock
+/// @return OS_SEM_SUCCESS if success, OS_SEM_TIMEOUT if timeout, OS_SEM_ERROR otherwise
+//////////////////////////////////
+int osEventWaitTimeout(t_OSEventCtx* p_pttOSEvent, unsigned long p_ulTimeoutMs);
+
+//////////////////////////////////
+/// @brief Check whether an event is signaled, without clearing it
+/// @param p_pttOSEvent : pointer to the event structure context
+/// @return true if signaled
+//////////////////////////////////
+bool osEventIsSet(t_OSEventCtx* p_pttOSEvent);
+
 #endif // OS_SEMAPHORE_H_
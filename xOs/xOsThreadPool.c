@@ -0,0 +1,719 @@
+////////////////////////////////////////////////////////////
+//  thread pool source file
+//  implements the work-stealing thread pool of xOsThreadPool.h
+//
+// The worker deques follow Chase-Lev (Le et al., "Correct and efficient
+// work-stealing for weak memory models"): the owner pushes and takes at
+// the bottom without a lock, thieves take the top with one CAS. Idle
+// workers sleep on a condition variable guarded by the pending count
+//
+// general discloser: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+
+#include "xOsThreadPool.h"
+#include "xOsFutex.h"
+#include "xAssert.h"
+#include "xLog.h"
+#include "xMemory.h"
+#include <errno.h>
+#include <sched.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// Job as copied in and out of a slot
+typedef struct
+{
+    xOsPoolJobFn t_pfJob;
+    void* t_pvArg;
+    xOsWaitGroup_t* t_ptGroup;
+    xOsFuture_t* t_ptFuture;
+} poolJob_t;
+
+// Worker running on the current thread, NULL outside any pool
+static __thread xOsPoolWorker_t* s_ptCurrentWorker = NULL;
+
+////////////////////////////////////////////////////////////
+/// poolCondInit
+////////////////////////////////////////////////////////////
+static int poolCondInit(pthread_cond_t* p_ptCond)
+{
+    pthread_condattr_t l_tAttr;
+    if (pthread_condattr_init(&l_tAttr) != 0)
+        return -1;
+    pthread_condattr_setclock(&l_tAttr, CLOCK_MONOTONIC);
+    int l_iResult = pthread_cond_init(p_ptCond, &l_tAttr);
+    pthread_condattr_destroy(&l_tAttr);
+    return l_iResult;
+}
+
+////////////////////////////////////////////////////////////
+/// poolSlotStore
+////////////////////////////////////////////////////////////
+static inline void poolSlotStore(xOsPoolSlot_t* p_ptSlot, const poolJob_t* p_ptJob)
+{
+    atomic_store_explicit(&p_ptSlot->a_pfJob, p_ptJob->t_pfJob, memory_order_relaxed);
+    atomic_store_explicit(&p_ptSlot->a_pvArg, p_ptJob->t_pvArg, memory_order_relaxed);
+    atomic_store_explicit(&p_ptSlot->a_ptGroup, p_ptJob->t_ptGroup, memory_order_relaxed);
+    atomic_store_explicit(&p_ptSlot->a_ptFuture, p_ptJob->t_ptFuture, memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////
+/// poolSlotLoad
+////////////////////////////////////////////////////////////
+static inline void poolSlotLoad(xOsPoolSlot_t* p_ptSlot, poolJob_t* p_ptJob)
+{
+    p_ptJob->t_pfJob = atomic_load_explicit(&p_ptSlot->a_pfJob, memory_order_relaxed);
+    p_ptJob->t_pvArg = atomic_load_explicit(&p_ptSlot->a_pvArg, memory_order_relaxed);
+    p_ptJob->t_ptGroup = atomic_load_explicit(&p_ptSlot->a_ptGroup, memory_order_relaxed);
+    p_ptJob->t_ptFuture = atomic_load_explicit(&p_ptSlot->a_ptFuture, memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////
+/// poolDequePush
+////////////////////////////////////////////////////////////
+static bool poolDequePush(xOsPoolWorker_t* p_ptWorker, uint32_t p_ulMask, const poolJob_t* p_ptJob)
+{
+    long long l_llBottom = atomic_load_explicit(&p_ptWorker->a_llBottom, memory_order_relaxed);
+    long long l_llTop = atomic_load_explicit(&p_ptWorker->a_llTop, memory_order_acquire);
+    if (l_llBottom - l_llTop > (long long)p_ulMask)
+        return false;
+
+    poolSlotStore(&p_ptWorker->t_ptSlots[l_llBottom & p_ulMask], p_ptJob);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&p_ptWorker->a_llBottom, l_llBottom + 1, memory_order_relaxed);
+    return true;
+}
+
+////////////////////////////////////////////////////////////
+/// poolDequeTake
+////////////////////////////////////////////////////////////
+static bool poolDequeTake(xOsPoolWorker_t* p_ptWorker, uint32_t p_ulMask, poolJob_t* p_ptJob)
+{
+    long long l_llBottom = atomic_load_explicit(&p_ptWorker->a_llBottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&p_ptWorker->a_llBottom, l_llBottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    long long l_llTop = atomic_load_explicit(&p_ptWorker->a_llTop, memory_order_relaxed);
+
+    if (l_llTop > l_llBottom)
+    {
+        atomic_store_explicit(&p_ptWorker->a_llBottom, l_llBottom + 1, memory_order_relaxed);
+        return false;
+    }
+
+    poolSlotLoad(&p_ptWorker->t_ptSlots[l_llBottom & p_ulMask], p_ptJob);
+    if (l_llTop < l_llBottom)
+        return true;
+
+    // Last job, race the thieves for it
+    bool l_bTaken = atomic_compare_exchange_strong_explicit(&p_ptWorker->a_llTop, &l_llTop, l_llTop + 1,
+                                                            memory_order_seq_cst, memory_order_relaxed);
+    atomic_store_explicit(&p_ptWorker->a_llBottom, l_llBottom + 1, memory_order_relaxed);
+    return l_bTaken;
+}
+
+////////////////////////////////////////////////////////////
+/// poolDequeSteal
+////////////////////////////////////////////////////////////
+static bool poolDequeSteal(xOsPoolWorker_t* p_ptWorker, uint32_t p_ulMask, poolJob_t* p_ptJob)
+{
+    long long l_llTop = atomic_load_explicit(&p_ptWorker->a_llTop, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    long long l_llBottom = atomic_load_explicit(&p_ptWorker->a_llBottom, memory_order_acquire);
+    if (l_llTop >= l_llBottom)
+        return false;
+
+    // The slot may be rewritten once top moves, the CAS discards such a read
+    poolSlotLoad(&p_ptWorker->t_ptSlots[l_llTop & p_ulMask], p_ptJob);
+    return atomic_compare_exchange_strong_explicit(&p_ptWorker->a_llTop, &l_llTop, l_llTop + 1,
+                                                   memory_order_seq_cst, memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////
+/// poolInjectPush
+////////////////////////////////////////////////////////////
+static bool poolInjectPush(xOsThreadPool_t* p_ptPool, const poolJob_t* p_ptJob)
+{
+    bool l_bPushed = false;
+    pthread_mutex_lock(&p_ptPool->t_tInjectMutex);
+    uint32_t l_ulCount = atomic_load_explicit(&p_ptPool->a_ulInjectCount, memory_order_relaxed);
+    if (l_ulCount <= p_ptPool->t_ulInjectMask)
+    {
+        uint32_t l_ulTail = (p_ptPool->t_ulInjectHead + l_ulCount) & p_ptPool->t_ulInjectMask;
+        poolSlotStore(&p_ptPool->t_ptInject[l_ulTail], p_ptJob);
+        atomic_store_explicit(&p_ptPool->a_ulInjectCount, l_ulCount + 1, memory_order_relaxed);
+        l_bPushed = true;
+    }
+    pthread_mutex_unlock(&p_ptPool->t_tInjectMutex);
+    return l_bPushed;
+}
+
+////////////////////////////////////////////////////////////
+/// poolInjectPop
+////////////////////////////////////////////////////////////
+static bool poolInjectPop(xOsThreadPool_t* p_ptPool, poolJob_t* p_ptJob)
+{
+    if (atomic_load_explicit(&p_ptPool->a_ulInjectCount, memory_order_relaxed) == 0)
+        return false;
+
+    bool l_bPopped = false;
+    pthread_mutex_lock(&p_ptPool->t_tInjectMutex);
+    uint32_t l_ulCount = atomic_load_explicit(&p_ptPool->a_ulInjectCount, memory_order_relaxed);
+    if (l_ulCount > 0)
+    {
+        poolSlotLoad(&p_ptPool->t_ptInject[p_ptPool->t_ulInjectHead], p_ptJob);
+        p_ptPool->t_ulInjectHead = (p_ptPool->t_ulInjectHead + 1) & p_ptPool->t_ulInjectMask;
+        atomic_store_explicit(&p_ptPool->a_ulInjectCount, l_ulCount - 1, memory_order_relaxed);
+        l_bPopped = true;
+    }
+    pthread_mutex_unlock(&p_ptPool->t_tInjectMutex);
+    return l_bPopped;
+}
+
+////////////////////////////////////////////////////////////
+/// poolFind
+////////////////////////////////////////////////////////////
+static bool poolFind(xOsThreadPool_t* p_ptPool, xOsPoolWorker_t* p_ptSelf, poolJob_t* p_ptJob)
+{
+    bool l_bFound = false;
+    if (p_ptSelf != NULL && poolDequeTake(p_ptSelf, p_ptPool->t_ulMask, p_ptJob))
+        l_bFound = true;
+    else if (poolInjectPop(p_ptPool, p_ptJob))
+        l_bFound = true;
+    else
+    {
+        // Start from a random victim so thieves spread over the deques
+        uint32_t l_ulStart = 0;
+        if (p_ptSelf != NULL)
+        {
+            p_ptSelf->t_ulSeed ^= p_ptSelf->t_ulSeed << 13;
+            p_ptSelf->t_ulSeed ^= p_ptSelf->t_ulSeed >> 17;
+            p_ptSelf->t_ulSeed ^= p_ptSelf->t_ulSeed << 5;
+            l_ulStart = p_ptSelf->t_ulSeed;
+        }
+
+        for (int i = 0; i < p_ptPool->t_iWorkerCount && !l_bFound; i++)
+        {
+            xOsPoolWorker_t* l_ptVictim = &p_ptPool->t_ptWorkers[(l_ulStart + (uint32_t)i) % (uint32_t)p_ptPool->t_iWorkerCount];
+            if (l_ptVictim != p_ptSelf && poolDequeSteal(l_ptVictim, p_ptPool->t_ulMask, p_ptJob))
+            {
+                l_bFound = true;
+                if (p_ptSelf != NULL)
+                    atomic_fetch_add_explicit(&p_ptSelf->a_ulStolen, 1, memory_order_relaxed);
+            }
+        }
+    }
+
+    if (l_bFound)
+        atomic_fetch_sub(&p_ptPool->a_iPending, 1);
+    return l_bFound;
+}
+
+////////////////////////////////////////////////////////////
+/// poolRun
+////////////////////////////////////////////////////////////
+static void poolRun(xOsPoolWorker_t* p_ptSelf, const poolJob_t* p_ptJob)
+{
+    void* l_pvResult = p_ptJob->t_pfJob(p_ptJob->t_pvArg);
+
+    // Counted before the waiters are released, the stats include every job they waited for
+    if (p_ptSelf != NULL)
+        atomic_fetch_add_explicit(&p_ptSelf->a_ulExecuted, 1, memory_order_relaxed);
+
+    if (p_ptJob->t_ptFuture != NULL)
+    {
+        xOsFuture_t* l_ptFuture = p_ptJob->t_ptFuture;
+        pthread_mutex_lock(&l_ptFuture->t_tMutex);
+        l_ptFuture->t_pvResult = l_pvResult;
+        atomic_store_explicit(&l_ptFuture->a_bReady, true, memory_order_release);
+        pthread_cond_broadcast(&l_ptFuture->t_tReady);
+        pthread_mutex_unlock(&l_ptFuture->t_tMutex);
+    }
+    if (p_ptJob->t_ptGroup != NULL)
+        xOsWaitGroupDone(p_ptJob->t_ptGroup);
+}
+
+////////////////////////////////////////////////////////////
+/// poolWorkerTask
+////////////////////////////////////////////////////////////
+static void* poolWorkerTask(void* p_pvArg)
+{
+    xOsPoolWorker_t* l_ptWorker = (xOsPoolWorker_t*)p_pvArg;
+    xOsThreadPool_t* l_ptPool = l_ptWorker->t_ptPool;
+    s_ptCurrentWorker = l_ptWorker;
+
+    int l_iSpins = 0;
+    for (;;)
+    {
+        poolJob_t l_tJob;
+        if (poolFind(l_ptPool, l_ptWorker, &l_tJob))
+        {
+            poolRun(l_ptWorker, &l_tJob);
+            l_iSpins = 0;
+            continue;
+        }
+
+        if (atomic_load(&l_ptPool->a_bStop) && atomic_load(&l_ptPool->a_iPending) == 0)
+            break;
+
+        // A job may be on its way, retry a little before sleeping
+        if (++l_iSpins < XOS_POOL_SPIN_COUNT)
+        {
+            sched_yield();
+            continue;
+        }
+        l_iSpins = 0;
+
+        // Sleepers is raised before pending is checked, a submitter that saw
+        // no sleeper incremented pending before this check
+        pthread_mutex_lock(&l_ptPool->t_tSleepMutex);
+        atomic_fetch_add(&l_ptPool->a_iSleepers, 1);
+        while (atomic_load(&l_ptPool->a_iPending) == 0 && !atomic_load(&l_ptPool->a_bStop))
+        {
+            pthread_cond_wait(&l_ptPool->t_tWake, &l_ptPool->t_tSleepMutex);
+        }
+        atomic_fetch_sub(&l_ptPool->a_iSleepers, 1);
+        pthread_mutex_unlock(&l_ptPool->t_tSleepMutex);
+    }
+
+    s_ptCurrentWorker = NULL;
+    return NULL;
+}
+
+////////////////////////////////////////////////////////////
+/// poolEnqueue
+////////////////////////////////////////////////////////////
+static int poolEnqueue(xOsThreadPool_t* p_ptPool, const poolJob_t* p_ptJob)
+{
+    if (atomic_load(&p_ptPool->a_bStop))
+        return XOS_POOL_INVALID;
+
+    // Counted first, so no worker goes to sleep with this job queued
+    atomic_fetch_add(&p_ptPool->a_iPending, 1);
+
+    xOsPoolWorker_t* l_ptSelf = s_ptCurrentWorker;
+    bool l_bQueued = false;
+    if (l_ptSelf != NULL && l_ptSelf->t_ptPool == p_ptPool)
+        l_bQueued = poolDequePush(l_ptSelf, p_ptPool->t_ulMask, p_ptJob);
+    if (!l_bQueued)
+        l_bQueued = poolInjectPush(p_ptPool, p_ptJob);
+    if (!l_bQueued)
+    {
+        atomic_fetch_sub(&p_ptPool->a_iPending, 1);
+        return XOS_POOL_FULL;
+    }
+
+    if (atomic_load(&p_ptPool->a_iSleepers) > 0)
+    {
+        pthread_mutex_lock(&p_ptPool->t_tSleepMutex);
+        pthread_cond_signal(&p_ptPool->t_tWake);
+        pthread_mutex_unlock(&p_ptPool->t_tSleepMutex);
+    }
+
+    return XOS_POOL_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// poolRoundUp
+////////////////////////////////////////////////////////////
+static uint32_t poolRoundUp(uint32_t p_ulValue)
+{
+    uint32_t l_ulResult = 1;
+    while (l_ulResult < p_ulValue)
+    {
+        l_ulResult <<= 1;
+    }
+    return l_ulResult;
+}
+
+////////////////////////////////////////////////////////////
+/// poolRelease
+////////////////////////////////////////////////////////////
+static void poolRelease(xOsThreadPool_t* p_ptPool, int p_iSlotted)
+{
+    for (int i = 0; i < p_iSlotted; i++)
+    {
+        X_FREE(p_ptPool->t_ptWorkers[i].t_ptSlots);
+    }
+    if (p_ptPool->t_ptInject != NULL)
+        X_FREE(p_ptPool->t_ptInject);
+    if (p_ptPool->t_ptWorkers != NULL)
+        X_FREE(p_ptPool->t_ptWorkers);
+    pthread_cond_destroy(&p_ptPool->t_tWake);
+    pthread_mutex_destroy(&p_ptPool->t_tSleepMutex);
+    pthread_mutex_destroy(&p_ptPool->t_tInjectMutex);
+    p_ptPool->t_ptWorkers = NULL;
+    p_ptPool->t_ptInject = NULL;
+}
+
+////////////////////////////////////////////////////////////
+/// poolStop
+////////////////////////////////////////////////////////////
+static void poolStop(xOsThreadPool_t* p_ptPool, int p_iStarted)
+{
+    // Workers leave once stop is set and nothing is pending
+    pthread_mutex_lock(&p_ptPool->t_tSleepMutex);
+    atomic_store(&p_ptPool->a_bStop, true);
+    pthread_cond_broadcast(&p_ptPool->t_tWake);
+    pthread_mutex_unlock(&p_ptPool->t_tSleepMutex);
+
+    for (int i = 0; i < p_iStarted; i++)
+    {
+        osTaskWait(&p_ptPool->t_ptWorkers[i].t_tTask, NULL);
+    }
+}
+
+////////////////////////////////////////////////////////////
+/// xOsThreadPoolCreate
+////////////////////////////////////////////////////////////
+int xOsThreadPoolCreate(xOsThreadPool_t* p_ptPool, const xOsThreadPoolConfig_t* p_ptConfig)
+{
+    X_ASSERT_RETURN(p_ptPool != NULL, XOS_POOL_INVALID);
+
+    xOsThreadPoolConfig_t l_tConfig;
+    if (p_ptConfig != NULL)
+        l_tConfig = *p_ptConfig;
+    else
+    {
+        memset(&l_tConfig, 0, sizeof(l_tConfig));
+        l_tConfig.t_iPriority = OS_TASK_DEFAULT_PRIORITY;
+    }
+
+    if (l_tConfig.t_iWorkers <= 0)
+    {
+        long l_lCpus = sysconf(_SC_NPROCESSORS_ONLN);
+        l_tConfig.t_iWorkers = (l_lCpus > 0) ? (int)l_lCpus : 1;
+    }
+    if (l_tConfig.t_iWorkers > XOS_POOL_MAX_WORKERS)
+        return XOS_POOL_INVALID;
+
+    uint32_t l_ulCapacity = poolRoundUp(l_tConfig.t_ulCapacity ? l_tConfig.t_ulCapacity : XOS_POOL_DEFAULT_CAPACITY);
+    uint32_t l_ulInjectCapacity = poolRoundUp(l_ulCapacity * (uint32_t)l_tConfig.t_iWorkers);
+
+    memset(p_ptPool, 0, sizeof(*p_ptPool));
+    p_ptPool->t_iWorkerCount = l_tConfig.t_iWorkers;
+    p_ptPool->t_ulMask = l_ulCapacity - 1;
+    p_ptPool->t_ulInjectMask = l_ulInjectCapacity - 1;
+    atomic_init(&p_ptPool->a_ulInjectCount, 0);
+    atomic_init(&p_ptPool->a_iPending, 0);
+    atomic_init(&p_ptPool->a_iSleepers, 0);
+    atomic_init(&p_ptPool->a_bStop, false);
+
+    if (pthread_mutex_init(&p_ptPool->t_tInjectMutex, NULL) != 0)
+        return XOS_POOL_ERROR;
+    if (pthread_mutex_init(&p_ptPool->t_tSleepMutex, NULL) != 0)
+    {
+        pthread_mutex_destroy(&p_ptPool->t_tInjectMutex);
+        return XOS_POOL_ERROR;
+    }
+    if (pthread_cond_init(&p_ptPool->t_tWake, NULL) != 0)
+    {
+        pthread_mutex_destroy(&p_ptPool->t_tSleepMutex);
+        pthread_mutex_destroy(&p_ptPool->t_tInjectMutex);
+        return XOS_POOL_ERROR;
+    }
+
+    p_ptPool->t_ptWorkers = (xOsPoolWorker_t*)X_MALLOC(sizeof(xOsPoolWorker_t) * (size_t)l_tConfig.t_iWorkers);
+    p_ptPool->t_ptInject = (xOsPoolSlot_t*)X_MALLOC(sizeof(xOsPoolSlot_t) * l_ulInjectCapacity);
+    if (p_ptPool->t_ptWorkers == NULL || p_ptPool->t_ptInject == NULL)
+    {
+        poolRelease(p_ptPool, 0);
+        return XOS_POOL_ERROR;
+    }
+    memset(p_ptPool->t_ptWorkers, 0, sizeof(xOsPoolWorker_t) * (size_t)l_tConfig.t_iWorkers);
+
+    for (int i = 0; i < l_tConfig.t_iWorkers; i++)
+    {
+        xOsPoolWorker_t* l_ptWorker = &p_ptPool->t_ptWorkers[i];
+        l_ptWorker->t_ptSlots = (xOsPoolSlot_t*)X_MALLOC(sizeof(xOsPoolSlot_t) * l_ulCapacity);
+        if (l_ptWorker->t_ptSlots == NULL)
+        {
+            poolRelease(p_ptPool, i);
+            return XOS_POOL_ERROR;
+        }
+        atomic_init(&l_ptWorker->a_llTop, 0);
+        atomic_init(&l_ptWorker->a_llBottom, 0);
+        atomic_init(&l_ptWorker->a_ulExecuted, 0);
+        atomic_init(&l_ptWorker->a_ulStolen, 0);
+        l_ptWorker->t_ulSeed = 2654435761U * (uint32_t)(i + 1);
+        l_ptWorker->t_ptPool = p_ptPool;
+    }
+
+    // Workers are plain tasks, priority and policy come from the configuration
+    for (int i = 0; i < l_tConfig.t_iWorkers; i++)
+    {
+        xOsTaskCtx* l_ptTask = &p_ptPool->t_ptWorkers[i].t_tTask;
+        osTaskInit(l_ptTask);
+        l_ptTask->t_ptTask = poolWorkerTask;
+        l_ptTask->t_ptTaskArg = &p_ptPool->t_ptWorkers[i];
+        l_ptTask->t_ulStackSize = l_tConfig.t_ulStackSize ? l_tConfig.t_ulStackSize : XOS_POOL_DEFAULT_STACK_SIZE;
+        l_ptTask->t_iPriority = l_tConfig.t_iPriority;
+#ifdef OS_USE_RT_SCHEDULING
+        l_ptTask->t_policy = l_tConfig.t_ePolicy;
+#endif
+
+        if (osTaskCreate(l_ptTask) != OS_TASK_SUCCESS)
+        {
+            X_LOG_TRACE("xOsThreadPoolCreate: Worker %d failed to start", i);
+            poolStop(p_ptPool, i);
+            poolRelease(p_ptPool, l_tConfig.t_iWorkers);
+            return XOS_POOL_ERROR;
+        }
+    }
+
+    return XOS_POOL_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xOsThreadPoolSubmit
+////////////////////////////////////////////////////////////
+int xOsThreadPoolSubmit(xOsThreadPool_t* p_ptPool, xOsPoolJobFn p_pfJob, void* p_pvArg, xOsWaitGroup_t* p_ptGroup)
+{
+    X_ASSERT_RETURN(p_ptPool != NULL && p_ptPool->t_ptWorkers != NULL && p_pfJob != NULL, XOS_POOL_INVALID);
+
+    poolJob_t l_tJob = { p_pfJob, p_pvArg, p_ptGroup, NULL };
+    if (p_ptGroup != NULL)
+        xOsWaitGroupAdd(p_ptGroup, 1);
+
+    int l_iResult = poolEnqueue(p_ptPool, &l_tJob);
+    if (l_iResult != (int)XOS_POOL_OK && p_ptGroup != NULL)
+        xOsWaitGroupDone(p_ptGroup);
+    return l_iResult;
+}
+
+////////////////////////////////////////////////////////////
+/// xOsThreadPoolSubmitFuture
+////////////////////////////////////////////////////////////
+int xOsThreadPoolSubmitFuture(xOsThreadPool_t* p_ptPool, xOsPoolJobFn p_pfJob, void* p_pvArg, xOsFuture_t* p_ptFuture)
+{
+    X_ASSERT_RETURN(p_ptPool != NULL && p_ptPool->t_ptWorkers != NULL && p_pfJob != NULL && p_ptFuture != NULL,
+                    XOS_POOL_INVALID);
+
+    atomic_init(&p_ptFuture->a_bReady, false);
+    p_ptFuture->t_pvResult = NULL;
+    if (pthread_mutex_init(&p_ptFuture->t_tMutex, NULL) != 0)
+        return XOS_POOL_ERROR;
+    if (poolCondInit(&p_ptFuture->t_tReady) != 0)
+    {
+        pthread_mutex_destroy(&p_ptFuture->t_tMutex);
+        return XOS_POOL_ERROR;
+    }
+
+    poolJob_t l_tJob = { p_pfJob, p_pvArg, NULL, p_ptFuture };
+    int l_iResult = poolEnqueue(p_ptPool, &l_tJob);
+    if (l_iResult != (int)XOS_POOL_OK)
+        xOsFutureDestroy(p_ptFuture);
+    return l_iResult;
+}
+
+////////////////////////////////////////////////////////////
+/// xOsThreadPoolWait
+////////////////////////////////////////////////////////////
+int xOsThreadPoolWait(xOsThreadPool_t* p_ptPool, xOsWaitGroup_t* p_ptGroup)
+{
+    X_ASSERT_RETURN(p_ptPool != NULL && p_ptGroup != NULL, XOS_POOL_INVALID);
+
+    xOsPoolWorker_t* l_ptSelf = s_ptCurrentWorker;
+    if (l_ptSelf != NULL && l_ptSelf->t_ptPool != p_ptPool)
+        l_ptSelf = NULL;
+
+    while (atomic_load(&p_ptGroup->a_iCount) > 0)
+    {
+        poolJob_t l_tJob;
+        if (poolFind(p_ptPool, l_ptSelf, &l_tJob))
+        {
+            poolRun(l_ptSelf, &l_tJob);
+            continue;
+        }
+
+        // Nothing to help with, the remaining jobs run elsewhere
+        if (xOsWaitGroupWait(p_ptGroup, 1) == (int)XOS_POOL_OK)
+            break;
+    }
+
+    return xOsWaitGroupWait(p_ptGroup, -1);
+}
+
+////////////////////////////////////////////////////////////
+/// xOsThreadPoolDestroy
+////////////////////////////////////////////////////////////
+int xOsThreadPoolDestroy(xOsThreadPool_t* p_ptPool)
+{
+    X_ASSERT_RETURN(p_ptPool != NULL && p_ptPool->t_ptWorkers != NULL, XOS_POOL_INVALID);
+
+    poolStop(p_ptPool, p_ptPool->t_iWorkerCount);
+    poolRelease(p_ptPool, p_ptPool->t_iWorkerCount);
+    p_ptPool->t_iWorkerCount = 0;
+    return XOS_POOL_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xOsThreadPoolGetStats
+////////////////////////////////////////////////////////////
+int xOsThreadPoolGetStats(const xOsThreadPool_t* p_ptPool, uint64_t* p_pulExecuted, uint64_t* p_pulStolen)
+{
+    X_ASSERT_RETURN(p_ptPool != NULL && p_ptPool->t_ptWorkers != NULL, XOS_POOL_INVALID);
+
+    uint64_t l_ulExecuted = 0;
+    uint64_t l_ulStolen = 0;
+    for (int i = 0; i < p_ptPool->t_iWorkerCount; i++)
+    {
+        l_ulExecuted += atomic_load_explicit(&p_ptPool->t_ptWorkers[i].a_ulExecuted, memory_order_relaxed);
+        l_ulStolen += atomic_load_explicit(&p_ptPool->t_ptWorkers[i].a_ulStolen, memory_order_relaxed);
+    }
+
+    if (p_pulExecuted != NULL)
+        *p_pulExecuted = l_ulExecuted;
+    if (p_pulStolen != NULL)
+        *p_pulStolen = l_ulStolen;
+    return XOS_POOL_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xOsWaitGroupInit
+////////////////////////////////////////////////////////////
+int xOsWaitGroupInit(xOsWaitGroup_t* p_ptGroup)
+{
+    X_ASSERT_RETURN(p_ptGroup != NULL, XOS_POOL_INVALID);
+
+    atomic_init(&p_ptGroup->a_iCount, 0);
+    if (pthread_mutex_init(&p_ptGroup->t_tMutex, NULL) != 0)
+        return XOS_POOL_ERROR;
+    if (poolCondInit(&p_ptGroup->t_tDone) != 0)
+    {
+        pthread_mutex_destroy(&p_ptGroup->t_tMutex);
+        return XOS_POOL_ERROR;
+    }
+    return XOS_POOL_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xOsWaitGroupAdd
+////////////////////////////////////////////////////////////
+int xOsWaitGroupAdd(xOsWaitGroup_t* p_ptGroup, int p_iCount)
+{
+    X_ASSERT_RETURN(p_ptGroup != NULL && p_iCount >= 0, XOS_POOL_INVALID);
+
+    atomic_fetch_add(&p_ptGroup->a_iCount, p_iCount);
+    return XOS_POOL_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xOsWaitGroupDone
+////////////////////////////////////////////////////////////
+int xOsWaitGroupDone(xOsWaitGroup_t* p_ptGroup)
+{
+    X_ASSERT_RETURN(p_ptGroup != NULL, XOS_POOL_INVALID);
+
+    // Lock-free unless this is the last unit, which reaches zero under the
+    // mutex so a waiter never destroys the group while it is signalled
+    int l_iCount = atomic_load(&p_ptGroup->a_iCount);
+    while (l_iCount > 1)
+    {
+        if (atomic_compare_exchange_weak(&p_ptGroup->a_iCount, &l_iCount, l_iCount - 1))
+            return XOS_POOL_OK;
+    }
+
+    X_ASSERT_RETURN(l_iCount == 1, XOS_POOL_INVALID);
+    pthread_mutex_lock(&p_ptGroup->t_tMutex);
+    if (atomic_fetch_sub(&p_ptGroup->a_iCount, 1) == 1)
+        pthread_cond_broadcast(&p_ptGroup->t_tDone);
+    pthread_mutex_unlock(&p_ptGroup->t_tMutex);
+    return XOS_POOL_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xOsWaitGroupWait
+////////////////////////////////////////////////////////////
+int xOsWaitGroupWait(xOsWaitGroup_t* p_ptGroup, int p_iTimeoutMs)
+{
+    X_ASSERT_RETURN(p_ptGroup != NULL, XOS_POOL_INVALID);
+
+    struct timespec l_tDeadline;
+    if (p_iTimeoutMs >= 0)
+        osDeadlineAfter(&l_tDeadline, (unsigned long)p_iTimeoutMs);
+
+    int l_iResult = XOS_POOL_OK;
+    pthread_mutex_lock(&p_ptGroup->t_tMutex);
+    while (atomic_load(&p_ptGroup->a_iCount) > 0)
+    {
+        if (p_iTimeoutMs < 0)
+            pthread_cond_wait(&p_ptGroup->t_tDone, &p_ptGroup->t_tMutex);
+        else if (pthread_cond_timedwait(&p_ptGroup->t_tDone, &p_ptGroup->t_tMutex, &l_tDeadline) == ETIMEDOUT)
+        {
+            l_iResult = (atomic_load(&p_ptGroup->a_iCount) > 0) ? (int)XOS_POOL_TIMEOUT : (int)XOS_POOL_OK;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&p_ptGroup->t_tMutex);
+    return l_iResult;
+}
+
+////////////////////////////////////////////////////////////
+/// xOsWaitGroupDestroy
+////////////////////////////////////////////////////////////
+int xOsWaitGroupDestroy(xOsWaitGroup_t* p_ptGroup)
+{
+    X_ASSERT_RETURN(p_ptGroup != NULL, XOS_POOL_INVALID);
+
+    pthread_cond_destroy(&p_ptGroup->t_tDone);
+    pthread_mutex_destroy(&p_ptGroup->t_tMutex);
+    return XOS_POOL_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xOsFutureGet
+////////////////////////////////////////////////////////////
+int xOsFutureGet(xOsFuture_t* p_ptFuture, void** p_ppvResult, int p_iTimeoutMs)
+{
+    X_ASSERT_RETURN(p_ptFuture != NULL, XOS_POOL_INVALID);
+
+    struct timespec l_tDeadline;
+    if (p_iTimeoutMs >= 0)
+        osDeadlineAfter(&l_tDeadline, (unsigned long)p_iTimeoutMs);
+
+    // Always through the mutex, the completing worker may still hold it
+    int l_iResult = XOS_POOL_OK;
+    pthread_mutex_lock(&p_ptFuture->t_tMutex);
+    while (!atomic_load_explicit(&p_ptFuture->a_bReady, memory_order_acquire))
+    {
+        if (p_iTimeoutMs < 0)
+            pthread_cond_wait(&p_ptFuture->t_tReady, &p_ptFuture->t_tMutex);
+        else if (pthread_cond_timedwait(&p_ptFuture->t_tReady, &p_ptFuture->t_tMutex, &l_tDeadline) == ETIMEDOUT)
+        {
+            if (!atomic_load_explicit(&p_ptFuture->a_bReady, memory_order_acquire))
+                l_iResult = XOS_POOL_TIMEOUT;
+            break;
+        }
+    }
+    if (l_iResult == (int)XOS_POOL_OK && p_ppvResult != NULL)
+        *p_ppvResult = p_ptFuture->t_pvResult;
+    pthread_mutex_unlock(&p_ptFuture->t_tMutex);
+    return l_iResult;
+}
+
+////////////////////////////////////////////////////////////
+/// xOsFutureIsReady
+////////////////////////////////////////////////////////////
+bool xOsFutureIsReady(xOsFuture_t* p_ptFuture)
+{
+    return p_ptFuture != NULL && atomic_load_explicit(&p_ptFuture->a_bReady, memory_order_acquire);
+}
+
+////////////////////////////////////////////////////////////
+/// xOsFutureDestroy
+////////////////////////////////////////////////////////////
+int xOsFutureDestroy(xOsFuture_t* p_ptFuture)
+{
+    X_ASSERT_RETURN(p_ptFuture != NULL, XOS_POOL_INVALID);
+
+    // The worker publishes a_bReady before it broadcasts and unlocks, wait
+    // for it to release the mutex before tearing anything down
+    pthread_mutex_lock(&p_ptFuture->t_tMutex);
+    pthread_mutex_unlock(&p_ptFuture->t_tMutex);
+
+    pthread_cond_destroy(&p_ptFuture->t_tReady);
+    pthread_mutex_destroy(&p_ptFuture->t_tMutex);
+    return XOS_POOL_OK;
+}
@@ -0,0 +1,235 @@
+////////////////////////////////////////////////////////////
+//  thread pool header file
+//  defines a fixed pool of xOsTaskCtx workers that run short jobs
+//
+// Each worker owns a work-stealing deque: jobs submitted from a worker
+// go to its own deque, jobs from other threads to a shared injection
+// queue, and an idle worker steals from the others before sleeping
+//
+// general discloser: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+#pragma once
+
+#ifndef XOS_THREAD_POOL_H_
+#define XOS_THREAD_POOL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "xTask.h"
+
+// Thread pool error codes
+#define XOS_POOL_OK             0xC3A85E10
+#define XOS_POOL_ERROR          0xC3A85E11
+#define XOS_POOL_INVALID        0xC3A85E12
+#define XOS_POOL_FULL           0xC3A85E13
+#define XOS_POOL_TIMEOUT        0xC3A85E14
+
+// Configuration constants
+#define XOS_POOL_MAX_WORKERS        64
+#define XOS_POOL_DEFAULT_CAPACITY   1024            // Jobs per deque when 0 is configured, rounded to a power of two
+#define XOS_POOL_DEFAULT_STACK_SIZE (256 * 1024)
+#define XOS_POOL_SPIN_COUNT         64              // Empty scans before a worker sleeps
+
+// Job function, same shape as an xOsTaskCtx entry point
+typedef void* (*xOsPoolJobFn)(void* p_pvArg);
+
+//////////////////////////////////
+/// @brief wait group, counts the jobs still running
+//////////////////////////////////
+typedef struct xos_wait_group_t
+{
+    atomic_int a_iCount;                // Jobs not done yet
+    pthread_mutex_t t_tMutex;
+    pthread_cond_t t_tDone;             // Broadcast when the count reaches 0
+} xOsWaitGroup_t;
+
+//////////////////////////////////
+/// @brief future, result of one job
+//////////////////////////////////
+typedef struct xos_future_t
+{
+    atomic_bool a_bReady;               // Result available
+    void* t_pvResult;                   // Job return value
+    pthread_mutex_t t_tMutex;
+    pthread_cond_t t_tReady;
+} xOsFuture_t;
+
+// Queued job, fields are atomic so a thief may read a slot being reused
+typedef struct
+{
+    _Atomic(xOsPoolJobFn) a_pfJob;
+    _Atomic(void*) a_pvArg;
+    _Atomic(xOsWaitGroup_t*) a_ptGroup;
+    _Atomic(xOsFuture_t*) a_ptFuture;
+} xOsPoolSlot_t;
+
+// Per worker state, padding keeps the deque ends and the neighbours on distinct cache lines
+typedef struct xos_pool_worker_t
+{
+    atomic_llong a_llTop;               // Thieves take here
+    char t_cPadTop[64];
+    atomic_llong a_llBottom;            // Owner pushes and takes here
+    char t_cPadBottom[64];
+    xOsPoolSlot_t* t_ptSlots;
+    uint32_t t_ulSeed;                  // Victim selection
+    struct xos_thread_pool_t* t_ptPool;
+    xOsTaskCtx t_tTask;
+    atomic_ulong a_ulExecuted;          // Jobs run
+    atomic_ulong a_ulStolen;            // Jobs taken from another worker
+    char t_cPadEnd[64];
+} xOsPoolWorker_t;
+
+//////////////////////////////////
+/// @brief thread pool configuration
+//////////////////////////////////
+typedef struct
+{
+    int t_iWorkers;                     // Worker threads (0 for one per online CPU)
+    uint32_t t_ulCapacity;              // Jobs per deque (0 for XOS_POOL_DEFAULT_CAPACITY)
+    size_t t_ulStackSize;               // Worker stack (0 for XOS_POOL_DEFAULT_STACK_SIZE)
+    int t_iPriority;                    // Worker priority, as xOsTaskCtx.t_iPriority
+    t_SchedPolicy t_ePolicy;            // Worker policy, applied with OS_USE_RT_SCHEDULING
+} xOsThreadPoolConfig_t;
+
+//////////////////////////////////
+/// @brief thread pool state
+//////////////////////////////////
+typedef struct xos_thread_pool_t
+{
+    int t_iWorkerCount;
+    uint32_t t_ulMask;                  // Deque capacity - 1
+    xOsPoolWorker_t* t_ptWorkers;
+    pthread_mutex_t t_tInjectMutex;     // Protects the injection ring
+    xOsPoolSlot_t* t_ptInject;          // Jobs from threads outside the pool
+    uint32_t t_ulInjectHead;
+    atomic_uint a_ulInjectCount;        // Read without the mutex to skip an empty ring
+    uint32_t t_ulInjectMask;
+    atomic_int a_iPending;              // Jobs queued in any deque or the ring
+    atomic_int a_iSleepers;             // Workers waiting on t_tWake
+    atomic_bool a_bStop;
+    pthread_mutex_t t_tSleepMutex;
+    pthread_cond_t t_tWake;
+} xOsThreadPool_t;
+
+//////////////////////////////////
+/// @brief Create a thread pool and start its workers
+/// @param p_ptPool : pool structure pointer
+/// @param p_ptConfig : configuration (NULL for defaults)
+/// @return : success or error code
+//////////////////////////////////
+int xOsThreadPoolCreate(xOsThreadPool_t* p_ptPool, const xOsThreadPoolConfig_t* p_ptConfig);
+
+//////////////////////////////////
+/// @brief Queue a job
+/// @param p_ptPool : pool structure pointer
+/// @param p_pfJob : job function
+/// @param p_pvArg : job argument
+/// @param p_ptGroup : wait group counting the job (may be NULL)
+/// @return : success, XOS_POOL_FULL when the queue is full, or error code
+/// @note the job is added to p_ptGroup before this call returns
+//////////////////////////////////
+int xOsThreadPoolSubmit(xOsThreadPool_t* p_ptPool, xOsPoolJobFn p_pfJob, void* p_pvArg, xOsWaitGroup_t* p_ptGroup);
+
+//////////////////////////////////
+/// @brief Queue a job whose return value is collected by a future
+/// @param p_ptPool : pool structure pointer
+/// @param p_pfJob : job function
+/// @param p_pvArg : job argument
+/// @param p_ptFuture : future, initialized by this call
+/// @return : success, XOS_POOL_FULL when the queue is full, or error code
+/// @note release the future with xOsFutureDestroy once the result is read
+//////////////////////////////////
+int xOsThreadPoolSubmitFuture(xOsThreadPool_t* p_ptPool, xOsPoolJobFn p_pfJob, void* p_pvArg, xOsFuture_t* p_ptFuture);
+
+//////////////////////////////////
+/// @brief Wait for a wait group, running queued jobs meanwhile
+/// @param p_ptPool : pool structure pointer
+/// @param p_ptGroup : wait group
+/// @return : success or error code
+/// @note safe from a job: the calling worker keeps the pool busy instead of blocking
+//////////////////////////////////
+int xOsThreadPoolWait(xOsThreadPool_t* p_ptPool, xOsWaitGroup_t* p_ptGroup);
+
+//////////////////////////////////
+/// @brief Run the queued jobs, stop the workers and release the pool
+/// @param p_ptPool : pool structure pointer
+/// @return : success or error code
+//////////////////////////////////
+int xOsThreadPoolDestroy(xOsThreadPool_t* p_ptPool);
+
+//////////////////////////////////
+/// @brief Get the pool counters
+/// @param p_ptPool : pool structure pointer
+/// @param p_pulExecuted : jobs run (may be NULL)
+/// @param p_pulStolen : jobs run by a worker other than the one they were queued on (may be NULL)
+/// @return : success or error code
+//////////////////////////////////
+int xOsThreadPoolGetStats(const xOsThreadPool_t* p_ptPool, uint64_t* p_pulExecuted, uint64_t* p_pulStolen);
+
+//////////////////////////////////
+/// @brief Initialize a wait group
+/// @param p_ptGroup : wait group
+/// @return : success or error code
+//////////////////////////////////
+int xOsWaitGroupInit(xOsWaitGroup_t* p_ptGroup);
+
+//////////////////////////////////
+/// @brief Add work to a wait group
+/// @param p_ptGroup : wait group
+/// @param p_iCount : units of work added
+/// @return : success or error code
+//////////////////////////////////
+int xOsWaitGroupAdd(xOsWaitGroup_t* p_ptGroup, int p_iCount);
+
+//////////////////////////////////
+/// @brief Mark one unit of work done
+/// @param p_ptGroup : wait group
+/// @return : success or error code
+//////////////////////////////////
+int xOsWaitGroupDone(xOsWaitGroup_t* p_ptGroup);
+
+//////////////////////////////////
+/// @brief Block until a wait group count reaches zero
+/// @param p_ptGroup : wait group
+/// @param p_iTimeoutMs : timeout in milliseconds (-1 for infinite)
+/// @return : success, XOS_POOL_TIMEOUT, or error code
+/// @note from a job, use xOsThreadPoolWait to avoid starving the pool
+//////////////////////////////////
+int xOsWaitGroupWait(xOsWaitGroup_t* p_ptGroup, int p_iTimeoutMs);
+
+//////////////////////////////////
+/// @brief Destroy a wait group
+/// @param p_ptGroup : wait group
+/// @return : success or error code
+//////////////////////////////////
+int xOsWaitGroupDestroy(xOsWaitGroup_t* p_ptGroup);
+
+//////////////////////////////////
+/// @brief Wait for the result of a future
+/// @param p_ptFuture : future
+/// @param p_ppvResult : filled with the job return value (may be NULL)
+/// @param p_iTimeoutMs : timeout in milliseconds (-1 for infinite)
+/// @return : success, XOS_POOL_TIMEOUT, or error code
+//////////////////////////////////
+int xOsFutureGet(xOsFuture_t* p_ptFuture, void** p_ppvResult, int p_iTimeoutMs);
+
+//////////////////////////////////
+/// @brief Check whether a future holds its result
+/// @param p_ptFuture : future
+/// @return : true when xOsFutureGet would not block
+//////////////////////////////////
+bool xOsFutureIsReady(xOsFuture_t* p_ptFuture);
+
+//////////////////////////////////
+/// @brief Destroy a future
+/// @param p_ptFuture : future
+/// @return : success or error code
+/// @note the job must have completed (xOsFutureGet or xOsFutureIsReady),
+///       the worker may still be signalling, this call waits for it
+//////////////////////////////////
+int xOsFutureDestroy(xOsFuture_t* p_ptFuture);
+
+#endif // XOS_THREAD_POOL_H_
@@ -9,9 +9,238 @@
 
 #include "xTask.h"
 #include "xLog.h"
+#include "xTrace.h"
 #include <errno.h>
 #include <signal.h>  
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
 #include <time.h>
+#include <unistd.h>
+
+// Byte painted over the stack of OS_TASK_FLAG_STACK_WATERMARK tasks
+#define OS_TASK_STACK_PATTERN 0xA5
+
+////////////////////////////////////////////////////////////
+/// osTaskPrefault
+////////////////////////////////////////////////////////////
+static __attribute__((noinline)) void osTaskPrefault(size_t p_ulSize)
+{
+    // Writing one byte per page maps the stack now instead of on first use
+    volatile uint8_t l_ucStack[p_ulSize];
+    long l_lPage = sysconf(_SC_PAGESIZE);
+    size_t l_ulStep = (l_lPage > 0) ? (size_t)l_lPage : 4096;
+    for (size_t i = 0; i < p_ulSize; i += l_ulStep)
+    {
+        l_ucStack[i] = 0;
+    }
+}
+
+////////////////////////////////////////////////////////////
+/// osTaskPaintStack
+////////////////////////////////////////////////////////////
+static __attribute__((noinline)) void osTaskPaintStack(xOsTaskCtx* p_pttOSTask)
+{
+    pthread_attr_t l_tAttr;
+    void* l_pvStack;
+    size_t l_ulSize;
+    if (pthread_getattr_np(pthread_self(), &l_tAttr) != 0)
+    {
+        return;
+    }
+    int l_iResult = pthread_attr_getstack(&l_tAttr, &l_pvStack, &l_ulSize);
+    pthread_attr_destroy(&l_tAttr);
+    if (l_iResult != 0)
+    {
+        return;
+    }
+
+    // The stack grows down: paint from a page above its base to below this frame
+    long l_lPage = sysconf(_SC_PAGESIZE);
+    uint8_t* l_pucLow = (uint8_t*)l_pvStack + ((l_lPage > 0) ? (size_t)l_lPage : 4096);
+    uint8_t* l_pucFrame = (uint8_t*)__builtin_frame_address(0) - OS_TASK_PREFAULT_RESERVE;
+    if (l_pucFrame <= l_pucLow)
+    {
+        return;
+    }
+    memset(l_pucLow, OS_TASK_STACK_PATTERN, (size_t)(l_pucFrame - l_pucLow));
+    p_pttOSTask->t_pucStackLow = l_pucLow;
+    p_pttOSTask->t_pucStackHigh = (uint8_t*)l_pvStack + l_ulSize;
+}
+
+////////////////////////////////////////////////////////////
+/// osTaskStackHighWater
+////////////////////////////////////////////////////////////
+static size_t osTaskStackHighWater(const xOsTaskCtx* p_pttOSTask)
+{
+    // The deepest byte no longer holding the paint marks the peak use
+    const uint8_t* l_pucCursor = p_pttOSTask->t_pucStackLow;
+    if (l_pucCursor == NULL)
+    {
+        return 0;
+    }
+    while (l_pucCursor < p_pttOSTask->t_pucStackHigh && *l_pucCursor == OS_TASK_STACK_PATTERN)
+    {
+        l_pucCursor++;
+    }
+    return (size_t)(p_pttOSTask->t_pucStackHigh - l_pucCursor);
+}
+
+////////////////////////////////////////////////////////////
+/// osTaskCaptureExit
+////////////////////////////////////////////////////////////
+static void osTaskCaptureExit(void* p_pvArg)
+{
+    xOsTaskCtx* l_ptTask = (xOsTaskCtx*)p_pvArg;
+    struct timespec l_tCpu;
+    struct rusage l_tUsage;
+
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &l_tCpu) == 0)
+    {
+        l_ptTask->t_ulExitCpuNs = (uint64_t)l_tCpu.tv_sec * 1000000000ULL + (uint64_t)l_tCpu.tv_nsec;
+    }
+    if (getrusage(RUSAGE_THREAD, &l_tUsage) == 0)
+    {
+        l_ptTask->t_ulExitVoluntary = (uint64_t)l_tUsage.ru_nvcsw;
+        l_ptTask->t_ulExitInvoluntary = (uint64_t)l_tUsage.ru_nivcsw;
+    }
+    // Read now, the C library releases the stack pages of an exiting thread
+    l_ptTask->t_ulExitStackHighWater = osTaskStackHighWater(l_ptTask);
+    atomic_store_explicit(&l_ptTask->a_bExited, true, memory_order_release);
+}
+
+#ifdef OS_USE_RT_SCHEDULING
+// sched_setattr(2) argument, not exported by every C library
+typedef struct
+{
+    uint32_t t_ulSize;
+    uint32_t t_ulPolicy;
+    uint64_t t_ulFlags;
+    int32_t t_iNice;
+    uint32_t t_ulPriority;
+    uint64_t t_ulRuntime;
+    uint64_t t_ulDeadline;
+    uint64_t t_ulPeriod;
+} osTaskSchedAttr_t;
+
+#ifndef SCHED_DEADLINE
+#define SCHED_DEADLINE 6
+#endif
+
+////////////////////////////////////////////////////////////
+/// osTaskEnterDeadline
+////////////////////////////////////////////////////////////
+static int osTaskEnterDeadline(xOsTaskCtx* p_pttOSTask)
+{
+    osTaskSchedAttr_t l_tAttr;
+    memset(&l_tAttr, 0, sizeof(l_tAttr));
+    l_tAttr.t_ulSize = sizeof(l_tAttr);
+    l_tAttr.t_ulPolicy = SCHED_DEADLINE;
+    l_tAttr.t_ulRuntime = p_pttOSTask->t_ulRuntimeNs ? p_pttOSTask->t_ulRuntimeNs : p_pttOSTask->t_ulPeriodNs / 2;
+    l_tAttr.t_ulDeadline = p_pttOSTask->t_ulPeriodNs;
+    l_tAttr.t_ulPeriod = p_pttOSTask->t_ulPeriodNs;
+
+    if (syscall(SYS_sched_setattr, 0, &l_tAttr, 0) != 0)
+    {
+        X_LOG_TRACE("osTaskEnterDeadline: sched_setattr failed, errno %d", errno);
+        return OS_TASK_ERROR_POLICY;
+    }
+    return OS_TASK_SUCCESS;
+}
+#endif
+
+////////////////////////////////////////////////////////////
+/// osTaskPeriodicRun
+////////////////////////////////////////////////////////////
+static void* osTaskPeriodicRun(xOsTaskCtx* p_pttOSTask)
+{
+    bool l_bDeadline = false;
+#ifdef OS_USE_RT_SCHEDULING
+    if (p_pttOSTask->t_policy == OS_SCHED_DEADLINE)
+    {
+        l_bDeadline = (osTaskEnterDeadline(p_pttOSTask) == OS_TASK_SUCCESS);
+    }
+#endif
+
+    // Releases are absolute: a late wakeup shortens the next sleep instead of shifting every period
+    uint64_t l_ulPeriod = p_pttOSTask->t_ulPeriodNs;
+    uint64_t l_ulRelease = osTaskNowNs() + l_ulPeriod;
+    while (atomic_load(&p_pttOSTask->a_iStopFlag) != OS_TASK_STOP_REQUEST)
+    {
+        if (l_bDeadline)
+        {
+            // Under SCHED_DEADLINE a yield ends the job until the next period
+            sched_yield();
+            osTaskRecordWakeup(p_pttOSTask, l_ulRelease);
+        }
+        else if (osTaskSleepUntil(p_pttOSTask, l_ulRelease) != OS_TASK_SUCCESS)
+        {
+            break;
+        }
+
+        bool l_bContinue = p_pttOSTask->t_pfPeriodic(p_pttOSTask->t_ptTaskArg);
+        atomic_fetch_add_explicit(&p_pttOSTask->a_ulPeriods, 1, memory_order_relaxed);
+        if (!l_bContinue)
+        {
+            break;
+        }
+
+        l_ulRelease += l_ulPeriod;
+        uint64_t l_ulNow = osTaskNowNs();
+        if (l_ulNow >= l_ulRelease)
+        {
+            atomic_fetch_add_explicit(&p_pttOSTask->a_ulOverruns, 1, memory_order_relaxed);
+
+            // Without catch-up the releases already gone are dropped, as a deadline task would
+            if (!(p_pttOSTask->t_iFlags & OS_TASK_FLAG_CATCH_UP) || l_bDeadline)
+            {
+                uint64_t l_ulMissed = (l_ulNow - l_ulRelease) / l_ulPeriod + 1;
+                atomic_fetch_add_explicit(&p_pttOSTask->a_ulSkipped, l_ulMissed, memory_order_relaxed);
+                l_ulRelease += l_ulMissed * l_ulPeriod;
+            }
+        }
+    }
+
+    return (void*)(intptr_t)OS_TASK_EXIT_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////
+/// osTaskStart
+////////////////////////////////////////////////////////////
+static void* osTaskStart(void* p_pvArg)
+{
+    xOsTaskCtx* l_ptTask = (xOsTaskCtx*)p_pvArg;
+    atomic_store(&l_ptTask->a_iTid, (int)syscall(SYS_gettid));
+    if (l_ptTask->t_pcName != NULL)
+    {
+        X_TRACE_THREAD_NAME(l_ptTask->t_pcName);
+    }
+
+    if (l_ptTask->t_iFlags & OS_TASK_FLAG_STACK_WATERMARK)
+    {
+        osTaskPaintStack(l_ptTask);
+    }
+    else if ((l_ptTask->t_iFlags & OS_TASK_FLAG_PREFAULT_STACK) &&
+             l_ptTask->t_ulStackSize > 2 * OS_TASK_PREFAULT_RESERVE)
+    {
+        osTaskPrefault(l_ptTask->t_ulStackSize - OS_TASK_PREFAULT_RESERVE);
+    }
+
+    // Final usage is captured on return and on cancellation alike
+    void* l_pvResult;
+    pthread_cleanup_push(osTaskCaptureExit, l_ptTask);
+    if (l_ptTask->t_pfPeriodic != NULL)
+    {
+        l_pvResult = osTaskPeriodicRun(l_ptTask);
+    }
+    else
+    {
+        l_pvResult = l_ptTask->t_ptTask(l_ptTask->t_ptTaskArg);
+    }
+    pthread_cleanup_pop(1);
+    return l_pvResult;
+}
 
 ////////////////////////////////////////////////////////////
 /// osTaskInit
@@ -26,7 +255,7 @@ int osTaskInit(xOsTaskCtx* p_pttOSTask)
     memset(p_pttOSTask, 0, sizeof(xOsTaskCtx));
     p_pttOSTask->t_ulStackSize = OS_TASK_DEFAULT_STACK_SIZE;
 #ifdef OS_USE_RT_SCHEDULING
-    p_pttOSTask->policy = OS_DEFAULT_SCHED_POLICY;
+    p_pttOSTask->t_policy = OS_DEFAULT_SCHED_POLICY;
 #endif
     p_pttOSTask->t_iState = OS_TASK_STATUS_READY;
     p_pttOSTask->t_iExitCode = OS_TASK_EXIT_SUCCESS;
@@ -45,7 +274,14 @@ int osTaskCreate(xOsTaskCtx* p_pttOSTask)
         return OS_TASK_ERROR_NULL_POINTER;
     }
     
-    if (p_pttOSTask->t_ptTask == NULL)
+    if (p_pttOSTask->t_pfPeriodic != NULL)
+    {
+        if (p_pttOSTask->t_ulPeriodNs == 0)
+        {
+            return OS_TASK_ERROR_INVALID_PARAM;
+        }
+    }
+    else if (p_pttOSTask->t_ptTask == NULL)
     {
         return OS_TASK_ERROR_INVALID_PARAM;
     }
@@ -57,7 +293,15 @@ int osTaskCreate(xOsTaskCtx* p_pttOSTask)
 
     // Check t_iPriority values
 #ifdef OS_USE_RT_SCHEDULING
-    if (p_pttOSTask->t_iPriority < OS_TASK_LOWEST_PRIORITY || 
+    if (p_pttOSTask->t_policy == OS_SCHED_DEADLINE)
+    {
+        // The deadline class has no priority, the budget is set once the task runs
+        if (p_pttOSTask->t_pfPeriodic == NULL)
+        {
+            return OS_TASK_ERROR_POLICY;
+        }
+    }
+    else if (p_pttOSTask->t_iPriority < OS_TASK_LOWEST_PRIORITY || 
         p_pttOSTask->t_iPriority > OS_TASK_HIGHEST_PRIORITY) 
     {
         return OS_TASK_ERROR_PRIORITY;
@@ -87,11 +331,12 @@ int osTaskCreate(xOsTaskCtx* p_pttOSTask)
 #ifdef OS_USE_RT_SCHEDULING
     // For systems supporting real-time
     int policy;
-    switch (p_pttOSTask->policy) {
+    switch (p_pttOSTask->t_policy) {
         case OS_SCHED_FIFO:  policy = SCHED_FIFO; break;
         case OS_SCHED_RR:    policy = SCHED_RR; break;
         case OS_SCHED_BATCH: policy = SCHED_BATCH; break;
         case OS_SCHED_IDLE:  policy = SCHED_IDLE; break;
+        case OS_SCHED_DEADLINE: policy = SCHED_OTHER; break;
         default:             policy = SCHED_OTHER; break;
     }
     
@@ -101,8 +346,8 @@ int osTaskCreate(xOsTaskCtx* p_pttOSTask)
         return OS_TASK_ERROR_POLICY;
     }
     
-    p_pttOSTask->sched_param.sched_priority = p_pttOSTask->t_iPriority;
-    if (pthread_attr_setschedparam(&l_tAttr, &p_pttOSTask->sched_param) != 0) 
+    p_pttOSTask->t_sched_param.sched_priority = (p_pttOSTask->t_policy == OS_SCHED_DEADLINE) ? 0 : p_pttOSTask->t_iPriority;
+    if (pthread_attr_setschedparam(&l_tAttr, &p_pttOSTask->t_sched_param) != 0) 
     {
         pthread_attr_destroy(&l_tAttr);
         return OS_TASK_ERROR_PRIORITY;
@@ -116,9 +361,19 @@ int osTaskCreate(xOsTaskCtx* p_pttOSTask)
     }
 #endif
 
-    // Create the thread
-    int ret = pthread_create(&p_pttOSTask->t_tHandle, &l_tAttr,
-        p_pttOSTask->t_ptTask, p_pttOSTask->t_ptTaskArg);
+    // Bind the thread to its CPUs from its first instruction
+    if (CPU_COUNT(&p_pttOSTask->t_tCpuSet) > 0 &&
+        pthread_attr_setaffinity_np(&l_tAttr, sizeof(cpu_set_t), &p_pttOSTask->t_tCpuSet) != 0)
+    {
+        pthread_attr_destroy(&l_tAttr);
+        return OS_TASK_ERROR_AFFINITY;
+    }
+
+    // Create the thread, osTaskStart records what the statistics need then calls the task
+    atomic_store(&p_pttOSTask->a_iTid, 0);
+    atomic_store(&p_pttOSTask->a_bExited, false);
+    p_pttOSTask->t_pucStackLow = NULL;
+    int ret = pthread_create(&p_pttOSTask->t_tHandle, &l_tAttr, osTaskStart, p_pttOSTask);
     pthread_attr_destroy(&l_tAttr);
 
     if (ret != 0) 
@@ -334,6 +589,474 @@ int osTaskStop(xOsTaskCtx* p_pttOSTask, int timeout_seconds)
     }
 }
 
+////////////////////////////////////////////////////////////
+/// osTaskSetAffinity
+////////////////////////////////////////////////////////////
+int osTaskSetAffinity(xOsTaskCtx* p_pttOSTask, const cpu_set_t* p_ptCpuSet)
+{
+    if (p_pttOSTask == NULL)
+    {
+        return OS_TASK_ERROR_NULL_POINTER;
+    }
+
+    if (p_ptCpuSet != NULL)
+    {
+        p_pttOSTask->t_tCpuSet = *p_ptCpuSet;
+    }
+    else
+    {
+        CPU_ZERO(&p_pttOSTask->t_tCpuSet);
+    }
+
+    if (p_pttOSTask->t_iState != OS_TASK_STATUS_RUNNING)
+    {
+        return OS_TASK_SUCCESS;
+    }
+
+    // Running task: an empty set gives back every CPU of the process
+    cpu_set_t l_tSet = p_pttOSTask->t_tCpuSet;
+    if (CPU_COUNT(&l_tSet) == 0 && sched_getaffinity(0, sizeof(l_tSet), &l_tSet) != 0)
+    {
+        return OS_TASK_ERROR_AFFINITY;
+    }
+    if (pthread_setaffinity_np(p_pttOSTask->t_tHandle, sizeof(l_tSet), &l_tSet) != 0)
+    {
+        return OS_TASK_ERROR_AFFINITY;
+    }
+
+    return OS_TASK_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////
+/// osTaskPinToCpu
+////////////////////////////////////////////////////////////
+int osTaskPinToCpu(xOsTaskCtx* p_pttOSTask, int p_iCpu)
+{
+    if (p_iCpu < 0 || p_iCpu >= CPU_SETSIZE)
+    {
+        return OS_TASK_ERROR_INVALID_PARAM;
+    }
+
+    cpu_set_t l_tSet;
+    CPU_ZERO(&l_tSet);
+    CPU_SET(p_iCpu, &l_tSet);
+    return osTaskSetAffinity(p_pttOSTask, &l_tSet);
+}
+
+////////////////////////////////////////////////////////////
+/// osTaskPinGroup
+////////////////////////////////////////////////////////////
+int osTaskPinGroup(xOsTaskCtx** p_pptTasks, int p_iCount, const cpu_set_t* p_ptCpuSet, bool p_bSpread)
+{
+    if (p_pptTasks == NULL)
+    {
+        return OS_TASK_ERROR_NULL_POINTER;
+    }
+    if (p_iCount <= 0)
+    {
+        return OS_TASK_ERROR_INVALID_PARAM;
+    }
+
+    cpu_set_t l_tCores;
+    if (p_ptCpuSet != NULL)
+    {
+        l_tCores = *p_ptCpuSet;
+    }
+    else
+    {
+        xOsCpuTopology_t l_tTopology;
+        int l_iResult = osTaskGetTopology(&l_tTopology);
+        if (l_iResult != OS_TASK_SUCCESS)
+        {
+            return l_iResult;
+        }
+        l_tCores = l_tTopology.t_tIsolated;
+    }
+
+    // Only the cores this process may use, the kernel would reject the others
+    cpu_set_t l_tAllowed;
+    if (sched_getaffinity(0, sizeof(l_tAllowed), &l_tAllowed) == 0)
+    {
+        CPU_AND(&l_tCores, &l_tCores, &l_tAllowed);
+    }
+
+    int l_iCores[CPU_SETSIZE];
+    int l_iCoreCount = 0;
+    for (int i = 0; i < CPU_SETSIZE; i++)
+    {
+        if (CPU_ISSET(i, &l_tCores))
+        {
+            l_iCores[l_iCoreCount++] = i;
+        }
+    }
+    if (l_iCoreCount == 0)
+    {
+        X_LOG_TRACE("osTaskPinGroup: No usable core in the set");
+        return OS_TASK_ERROR_AFFINITY;
+    }
+
+    for (int i = 0; i < p_iCount; i++)
+    {
+        if (p_pptTasks[i] == NULL)
+        {
+            return OS_TASK_ERROR_NULL_POINTER;
+        }
+
+        int l_iResult = p_bSpread ? osTaskPinToCpu(p_pptTasks[i], l_iCores[i % l_iCoreCount])
+                                  : osTaskSetAffinity(p_pptTasks[i], &l_tCores);
+        if (l_iResult != OS_TASK_SUCCESS)
+        {
+            return l_iResult;
+        }
+    }
+
+    return OS_TASK_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////
+/// osTaskParseCpuList
+////////////////////////////////////////////////////////////
+int osTaskParseCpuList(const char* p_pcList, cpu_set_t* p_ptCpuSet)
+{
+    if (p_pcList == NULL || p_ptCpuSet == NULL)
+    {
+        return OS_TASK_ERROR_NULL_POINTER;
+    }
+
+    CPU_ZERO(p_ptCpuSet);
+    const char* l_pcCursor = p_pcList;
+    while (*l_pcCursor != '\0' && *l_pcCursor != '\n')
+    {
+        char* l_pcEnd;
+        long l_lFirst = strtol(l_pcCursor, &l_pcEnd, 10);
+        if (l_pcEnd == l_pcCursor)
+        {
+            return OS_TASK_ERROR_INVALID_PARAM;
+        }
+
+        long l_lLast = l_lFirst;
+        if (*l_pcEnd == '-')
+        {
+            l_pcCursor = l_pcEnd + 1;
+            l_lLast = strtol(l_pcCursor, &l_pcEnd, 10);
+            if (l_pcEnd == l_pcCursor)
+            {
+                return OS_TASK_ERROR_INVALID_PARAM;
+            }
+        }
+        if (l_lFirst < 0 || l_lLast < l_lFirst || l_lLast >= CPU_SETSIZE)
+        {
+            return OS_TASK_ERROR_INVALID_PARAM;
+        }
+
+        for (long i = l_lFirst; i <= l_lLast; i++)
+        {
+            CPU_SET((int)i, p_ptCpuSet);
+        }
+
+        l_pcCursor = l_pcEnd;
+        if (*l_pcCursor == ',')
+        {
+            l_pcCursor++;
+        }
+        else if (*l_pcCursor != '\0' && *l_pcCursor != '\n')
+        {
+            return OS_TASK_ERROR_INVALID_PARAM;
+        }
+    }
+
+    return OS_TASK_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////
+/// osTaskReadSysfs
+////////////////////////////////////////////////////////////
+static int osTaskReadSysfs(const char* p_pcPath, char* p_pcBuffer, size_t p_ulSize)
+{
+    FILE* l_ptFile = fopen(p_pcPath, "r");
+    if (l_ptFile == NULL)
+    {
+        return -1;
+    }
+
+    size_t l_ulRead = fread(p_pcBuffer, 1, p_ulSize - 1, l_ptFile);
+    fclose(l_ptFile);
+    p_pcBuffer[l_ulRead] = '\0';
+    return 0;
+}
+
+////////////////////////////////////////////////////////////
+/// osTaskGetTopology
+////////////////////////////////////////////////////////////
+int osTaskGetTopology(xOsCpuTopology_t* p_ptTopology)
+{
+    if (p_ptTopology == NULL)
+    {
+        return OS_TASK_ERROR_NULL_POINTER;
+    }
+
+    memset(p_ptTopology, 0, sizeof(*p_ptTopology));
+    long l_lConfigured = sysconf(_SC_NPROCESSORS_CONF);
+    long l_lOnline = sysconf(_SC_NPROCESSORS_ONLN);
+    p_ptTopology->t_iConfiguredCpus = (l_lConfigured > 0) ? (int)l_lConfigured : 1;
+    p_ptTopology->t_iOnlineCpus = (l_lOnline > 0) ? (int)l_lOnline : 1;
+
+    if (sched_getaffinity(0, sizeof(p_ptTopology->t_tAllowed), &p_ptTopology->t_tAllowed) != 0)
+    {
+        return OS_TASK_ERROR_AFFINITY;
+    }
+
+    char l_cBuffer[512];
+    if (osTaskReadSysfs("/sys/devices/system/cpu/online", l_cBuffer, sizeof(l_cBuffer)) != 0 ||
+        osTaskParseCpuList(l_cBuffer, &p_ptTopology->t_tOnline) != OS_TASK_SUCCESS)
+    {
+        // No sysfs: the CPUs below the online count are assumed online
+        CPU_ZERO(&p_ptTopology->t_tOnline);
+        for (int i = 0; i < p_ptTopology->t_iOnlineCpus && i < CPU_SETSIZE; i++)
+        {
+            CPU_SET(i, &p_ptTopology->t_tOnline);
+        }
+    }
+    if (osTaskReadSysfs("/sys/devices/system/cpu/isolated", l_cBuffer, sizeof(l_cBuffer)) != 0 ||
+        osTaskParseCpuList(l_cBuffer, &p_ptTopology->t_tIsolated) != OS_TASK_SUCCESS)
+    {
+        CPU_ZERO(&p_ptTopology->t_tIsolated);
+    }
+
+    for (int i = 0; i < OS_TASK_MAX_CPUS; i++)
+    {
+        p_ptTopology->t_iPackage[i] = -1;
+        p_ptTopology->t_iCore[i] = -1;
+        if (!CPU_ISSET(i, &p_ptTopology->t_tOnline))
+        {
+            continue;
+        }
+
+        char l_cPath[128];
+        snprintf(l_cPath, sizeof(l_cPath), "/sys/devices/system/cpu/cpu%d/topology/physical_package_id", i);
+        if (osTaskReadSysfs(l_cPath, l_cBuffer, sizeof(l_cBuffer)) == 0)
+        {
+            p_ptTopology->t_iPackage[i] = atoi(l_cBuffer);
+        }
+        snprintf(l_cPath, sizeof(l_cPath), "/sys/devices/system/cpu/cpu%d/topology/core_id", i);
+        if (osTaskReadSysfs(l_cPath, l_cBuffer, sizeof(l_cBuffer)) == 0)
+        {
+            p_ptTopology->t_iCore[i] = atoi(l_cBuffer);
+        }
+    }
+
+    return OS_TASK_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////
+/// osTaskLockMemory
+////////////////////////////////////////////////////////////
+int osTaskLockMemory(void)
+{
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+    {
+        X_LOG_TRACE("osTaskLockMemory: mlockall failed, errno %d", errno);
+        return OS_TASK_ERROR_MEMORY_LOCK;
+    }
+
+    return OS_TASK_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////
+/// osTaskReadSwitches
+////////////////////////////////////////////////////////////
+static void osTaskReadSwitches(int p_iTid, uint64_t* p_pulVoluntary, uint64_t* p_pulInvoluntary)
+{
+    char l_cPath[64];
+    char l_cLine[128];
+    snprintf(l_cPath, sizeof(l_cPath), "/proc/self/task/%d/status", p_iTid);
+    FILE* l_ptFile = fopen(l_cPath, "r");
+    if (l_ptFile == NULL)
+    {
+        return;
+    }
+
+    unsigned long long l_ullValue;
+    while (fgets(l_cLine, sizeof(l_cLine), l_ptFile) != NULL)
+    {
+        if (sscanf(l_cLine, "voluntary_ctxt_switches: %llu", &l_ullValue) == 1)
+        {
+            *p_pulVoluntary = l_ullValue;
+        }
+        else if (sscanf(l_cLine, "nonvoluntary_ctxt_switches: %llu", &l_ullValue) == 1)
+        {
+            *p_pulInvoluntary = l_ullValue;
+        }
+    }
+    fclose(l_ptFile);
+}
+
+////////////////////////////////////////////////////////////
+/// osTaskGetStats
+////////////////////////////////////////////////////////////
+int osTaskGetStats(xOsTaskCtx* p_pttOSTask, xOsTaskStats_t* p_ptStats)
+{
+    if (p_pttOSTask == NULL || p_ptStats == NULL)
+    {
+        return OS_TASK_ERROR_NULL_POINTER;
+    }
+    if (p_pttOSTask->t_iState != OS_TASK_STATUS_RUNNING)
+    {
+        return OS_TASK_ERROR_NOT_RUNNING;
+    }
+
+    memset(p_ptStats, 0, sizeof(*p_ptStats));
+    p_ptStats->t_ulStackSize = p_pttOSTask->t_ulStackSize;
+
+    if (atomic_load_explicit(&p_pttOSTask->a_bExited, memory_order_acquire))
+    {
+        p_ptStats->t_ulCpuTimeNs = p_pttOSTask->t_ulExitCpuNs;
+        p_ptStats->t_ulVoluntarySwitches = p_pttOSTask->t_ulExitVoluntary;
+        p_ptStats->t_ulInvoluntarySwitches = p_pttOSTask->t_ulExitInvoluntary;
+        p_ptStats->t_ulStackHighWater = p_pttOSTask->t_ulExitStackHighWater;
+    }
+    else
+    {
+        clockid_t l_tClock;
+        struct timespec l_tCpu;
+        if (pthread_getcpuclockid(p_pttOSTask->t_tHandle, &l_tClock) == 0 &&
+            clock_gettime(l_tClock, &l_tCpu) == 0)
+        {
+            p_ptStats->t_ulCpuTimeNs = (uint64_t)l_tCpu.tv_sec * 1000000000ULL + (uint64_t)l_tCpu.tv_nsec;
+        }
+
+        int l_iTid = atomic_load(&p_pttOSTask->a_iTid);
+        if (l_iTid > 0)
+        {
+            osTaskReadSwitches(l_iTid, &p_ptStats->t_ulVoluntarySwitches, &p_ptStats->t_ulInvoluntarySwitches);
+        }
+        p_ptStats->t_ulStackHighWater = osTaskStackHighWater(p_pttOSTask);
+    }
+
+    uint64_t l_ulWakeups = atomic_load_explicit(&p_pttOSTask->a_ulWakeups, memory_order_relaxed);
+    p_ptStats->t_ulWakeups = l_ulWakeups;
+    p_ptStats->t_ulLatencyMaxNs = atomic_load_explicit(&p_pttOSTask->a_ulLatencyMaxNs, memory_order_relaxed);
+    if (l_ulWakeups > 0)
+    {
+        p_ptStats->t_ulLatencyAvgNs = atomic_load_explicit(&p_pttOSTask->a_ulLatencySumNs, memory_order_relaxed) / l_ulWakeups;
+    }
+    for (int i = 0; i < OS_TASK_LATENCY_BUCKETS; i++)
+    {
+        p_ptStats->t_ulLatencyHist[i] = atomic_load_explicit(&p_pttOSTask->a_ulLatencyHist[i], memory_order_relaxed);
+    }
+    p_ptStats->t_ulPeriods = atomic_load_explicit(&p_pttOSTask->a_ulPeriods, memory_order_relaxed);
+    p_ptStats->t_ulOverruns = atomic_load_explicit(&p_pttOSTask->a_ulOverruns, memory_order_relaxed);
+    p_ptStats->t_ulSkipped = atomic_load_explicit(&p_pttOSTask->a_ulSkipped, memory_order_relaxed);
+
+    return OS_TASK_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////
+/// osTaskNowNs
+////////////////////////////////////////////////////////////
+uint64_t osTaskNowNs(void)
+{
+    struct timespec l_tNow;
+    clock_gettime(CLOCK_MONOTONIC, &l_tNow);
+    return (uint64_t)l_tNow.tv_sec * 1000000000ULL + (uint64_t)l_tNow.tv_nsec;
+}
+
+////////////////////////////////////////////////////////////
+/// osTaskRecordWakeup
+////////////////////////////////////////////////////////////
+int osTaskRecordWakeup(xOsTaskCtx* p_pttOSTask, uint64_t p_ulDeadlineNs)
+{
+    if (p_pttOSTask == NULL)
+    {
+        return OS_TASK_ERROR_NULL_POINTER;
+    }
+
+    uint64_t l_ulNow = osTaskNowNs();
+    uint64_t l_ulLatency = (l_ulNow > p_ulDeadlineNs) ? l_ulNow - p_ulDeadlineNs : 0;
+
+    // Bucket of the highest set bit of the latency in microseconds
+    uint64_t l_ulMicros = l_ulLatency / 1000;
+    int l_iBucket = (l_ulMicros == 0) ? 0 : 64 - __builtin_clzll(l_ulMicros);
+    if (l_iBucket >= OS_TASK_LATENCY_BUCKETS)
+    {
+        l_iBucket = OS_TASK_LATENCY_BUCKETS - 1;
+    }
+
+    // Only the task itself records, relaxed updates are enough for the readers
+    atomic_fetch_add_explicit(&p_pttOSTask->a_ulLatencyHist[l_iBucket], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&p_pttOSTask->a_ulLatencySumNs, l_ulLatency, memory_order_relaxed);
+    if (l_ulLatency > atomic_load_explicit(&p_pttOSTask->a_ulLatencyMaxNs, memory_order_relaxed))
+    {
+        atomic_store_explicit(&p_pttOSTask->a_ulLatencyMaxNs, l_ulLatency, memory_order_relaxed);
+    }
+    atomic_fetch_add_explicit(&p_pttOSTask->a_ulWakeups, 1, memory_order_relaxed);
+
+    return OS_TASK_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////
+/// osTaskSleepUntil
+////////////////////////////////////////////////////////////
+int osTaskSleepUntil(xOsTaskCtx* p_pttOSTask, uint64_t p_ulDeadlineNs)
+{
+    if (p_pttOSTask == NULL)
+    {
+        return OS_TASK_ERROR_NULL_POINTER;
+    }
+
+    struct timespec l_tDeadline;
+    l_tDeadline.tv_sec = (time_t)(p_ulDeadlineNs / 1000000000ULL);
+    l_tDeadline.tv_nsec = (long)(p_ulDeadlineNs % 1000000000ULL);
+
+    int l_iResult;
+    do
+    {
+        l_iResult = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &l_tDeadline, NULL);
+    } while (l_iResult == EINTR);
+
+    if (l_iResult != 0)
+    {
+        return OS_TASK_ERROR_INVALID_PARAM;
+    }
+
+    return osTaskRecordWakeup(p_pttOSTask, p_ulDeadlineNs);
+}
+
+////////////////////////////////////////////////////////////
+/// osTaskLogStats
+////////////////////////////////////////////////////////////
+int osTaskLogStats(xOsTaskCtx** p_pptTasks, int p_iCount)
+{
+    if (p_pptTasks == NULL)
+    {
+        return OS_TASK_ERROR_NULL_POINTER;
+    }
+
+    for (int i = 0; i < p_iCount; i++)
+    {
+        xOsTaskStats_t l_tStats;
+        if (p_pptTasks[i] == NULL || osTaskGetStats(p_pptTasks[i], &l_tStats) != OS_TASK_SUCCESS)
+        {
+            continue;
+        }
+
+        const char* l_pcName = (p_pptTasks[i]->t_pcName != NULL) ? p_pptTasks[i]->t_pcName : "task";
+        X_LOG_INFO("%s[%d]: cpu %llu us, switches %llu/%llu, stack %zu/%zu, wakeups %llu, latency avg %llu us max %llu us, overruns %llu skipped %llu",
+                   l_pcName, atomic_load(&p_pptTasks[i]->a_iTid),
+                   (unsigned long long)(l_tStats.t_ulCpuTimeNs / 1000),
+                   (unsigned long long)l_tStats.t_ulVoluntarySwitches,
+                   (unsigned long long)l_tStats.t_ulInvoluntarySwitches,
+                   l_tStats.t_ulStackHighWater, l_tStats.t_ulStackSize,
+                   (unsigned long long)l_tStats.t_ulWakeups,
+                   (unsigned long long)(l_tStats.t_ulLatencyAvgNs / 1000),
+                   (unsigned long long)(l_tStats.t_ulLatencyMaxNs / 1000),
+                   (unsigned long long)l_tStats.t_ulOverruns,
+                   (unsigned long long)l_tStats.t_ulSkipped);
+    }
+
+    return OS_TASK_SUCCESS;
+}
+
 ////////////////////////////////////////////////////////////
 /// osTaskGetErrorString
 ////////////////////////////////////////////////////////////
@@ -354,6 +1077,8 @@ const char* osTaskGetErrorString(int p_iErrorCode)
         case OS_TASK_ERROR_PRIORITY:          return "Invalid task priority";
         case OS_TASK_ERROR_STACK_SIZE:        return "Invalid stack size";
         case OS_TASK_ERROR_POLICY:            return "Invalid scheduling policy";
+        case OS_TASK_ERROR_AFFINITY:          return "Invalid CPU affinity";
+        case OS_TASK_ERROR_MEMORY_LOCK:       return "Memory locking failed";
         default:                              return "Unknown error code";
     }
 }
@@ -12,6 +12,7 @@
 
 #include <pthread.h>
 #include <sched.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
@@ -35,6 +36,8 @@
 #define OS_TASK_ERROR_PRIORITY          0x2F41A5B
 #define OS_TASK_ERROR_STACK_SIZE        0x2F41A5C
 #define OS_TASK_ERROR_POLICY            0x2F41A5D
+#define OS_TASK_ERROR_AFFINITY          0x2F41A5E
+#define OS_TASK_ERROR_MEMORY_LOCK       0x2F41A5F
 
 // Task states
 #define OS_TASK_STATUS_READY       0UL
@@ -58,7 +61,8 @@ typedef enum
     OS_SCHED_FIFO,        // SCHED_FIFO - Real-time FIFO
     OS_SCHED_RR,          // SCHED_RR - Real-time Round Robin
     OS_SCHED_BATCH,       // SCHED_BATCH - Batch processing
-    OS_SCHED_IDLE         // SCHED_IDLE - Very low priority
+    OS_SCHED_IDLE,        // SCHED_IDLE - Very low priority
+    OS_SCHED_DEADLINE     // SCHED_DEADLINE - Earliest deadline first, periodic tasks only
 } t_SchedPolicy;
 
 #ifdef OS_USE_RT_SCHEDULING
@@ -78,6 +82,21 @@ typedef enum
 // Default stack size: 8 MB
 #define OS_TASK_DEFAULT_STACK_SIZE PTHREAD_STACK_MIN
 
+// Task creation flags (t_iFlags)
+#define OS_TASK_FLAG_PREFAULT_STACK 0x1     // Touch the whole stack before the task function runs
+#define OS_TASK_FLAG_STACK_WATERMARK 0x2    // Paint the stack to measure its high-water mark (prefaults it too)
+#define OS_TASK_FLAG_CATCH_UP       0x4     // Periodic task: run missed periods back to back instead of skipping them
+
+// Stack left untouched by the prefault, for the frames of the task start itself
+#define OS_TASK_PREFAULT_RESERVE    (8 * 1024)
+
+// CPUs described by osTaskGetTopology
+#define OS_TASK_MAX_CPUS            256
+
+// Wakeup latency histogram: bucket 0 counts latencies below 1 us, bucket i
+// those in [2^(i-1), 2^i) us, the last bucket everything above
+#define OS_TASK_LATENCY_BUCKETS     24
+
 //////////////////////////////////
 // Task management structure
 //////////////////////////////////
@@ -92,12 +111,67 @@ typedef struct xos_task_ctx_t
     int t_iExitCode;                    // Task exit code
     pthread_t t_tHandle;                // pthread thread handle
     atomic_int a_iStopFlag;             // Stop request flag for graceful shutdown
+    cpu_set_t t_tCpuSet;                // CPUs the task may run on (empty for no restriction)
+    int t_iFlags;                       // OS_TASK_FLAG_* creation flags
+    const char* t_pcName;               // Name in the statistics dump (may be NULL)
+    bool (*t_pfPeriodic)(void*);        // Periodic callback run every t_ulPeriodNs with t_ptTaskArg, false to stop
+    uint64_t t_ulPeriodNs;              // Period of a periodic task (0 for a plain task)
+    uint64_t t_ulRuntimeNs;             // SCHED_DEADLINE budget per period (0 for half the period)
+    // Runtime statistics (internal attributes, do not modify)
+    atomic_int a_iTid;                  // Kernel thread id, 0 until the task starts
+    atomic_bool a_bExited;              // The t_ulExit* usage below is final
+    uint8_t* t_pucStackLow;             // Lowest painted stack byte (NULL without OS_TASK_FLAG_STACK_WATERMARK)
+    uint8_t* t_pucStackHigh;            // Stack top
+    uint64_t t_ulExitCpuNs;             // CPU time when the task returned
+    uint64_t t_ulExitVoluntary;         // Voluntary context switches when the task returned
+    uint64_t t_ulExitInvoluntary;       // Involuntary context switches when the task returned
+    size_t t_ulExitStackHighWater;      // Stack high-water mark when the task returned
+    atomic_ulong a_ulWakeups;           // Wakeups recorded by osTaskSleepUntil / osTaskRecordWakeup
+    _Atomic uint64_t a_ulLatencySumNs;
+    _Atomic uint64_t a_ulLatencyMaxNs;
+    atomic_ulong a_ulLatencyHist[OS_TASK_LATENCY_BUCKETS];
+    atomic_ulong a_ulPeriods;           // Periodic callbacks run
+    atomic_ulong a_ulOverruns;          // Periodic callbacks that ended after the next release
+    atomic_ulong a_ulSkipped;           // Periods dropped after an overrun
 #ifdef OS_USE_RT_SCHEDULING
     struct sched_param t_sched_param;   // Scheduling parameters
     t_SchedPolicy t_policy;             // Scheduling policy
 #endif
 } xOsTaskCtx;
 
+//////////////////////////////////
+// Task runtime statistics
+//////////////////////////////////
+typedef struct xos_task_stats_t
+{
+    uint64_t t_ulCpuTimeNs;             // CPU time consumed by the task
+    uint64_t t_ulVoluntarySwitches;     // Context switches on blocking
+    uint64_t t_ulInvoluntarySwitches;   // Context switches on preemption
+    size_t t_ulStackSize;               // Configured stack size
+    size_t t_ulStackHighWater;          // Peak stack use in bytes (0 without OS_TASK_FLAG_STACK_WATERMARK)
+    uint64_t t_ulWakeups;               // Recorded periodic wakeups
+    uint64_t t_ulLatencyAvgNs;          // Mean lateness of the wakeups
+    uint64_t t_ulLatencyMaxNs;          // Worst lateness of the wakeups
+    uint64_t t_ulLatencyHist[OS_TASK_LATENCY_BUCKETS];
+    uint64_t t_ulPeriods;               // Periodic callbacks run
+    uint64_t t_ulOverruns;              // Periodic callbacks that ended after the next release
+    uint64_t t_ulSkipped;               // Periods dropped (without OS_TASK_FLAG_CATCH_UP)
+} xOsTaskStats_t;
+
+//////////////////////////////////
+// CPU topology
+//////////////////////////////////
+typedef struct xos_cpu_topology_t
+{
+    int t_iConfiguredCpus;              // CPUs known to the kernel
+    int t_iOnlineCpus;                  // CPUs currently online
+    cpu_set_t t_tOnline;                // Online CPUs
+    cpu_set_t t_tAllowed;               // CPUs this process may run on
+    cpu_set_t t_tIsolated;              // CPUs removed from the scheduler (isolcpus=)
+    int t_iPackage[OS_TASK_MAX_CPUS];   // Physical package of each CPU (-1 if unknown)
+    int t_iCore[OS_TASK_MAX_CPUS];      // Core of each CPU within its package (-1 if unknown)
+} xOsCpuTopology_t;
+
 //////////////////////////////////
 /// @brief Initialise a task context with default values
 /// @param p_pttOSTask : pointer to the task structure context
@@ -112,6 +186,10 @@ int osTaskInit(xOsTaskCtx* p_pttOSTask);
 /// 
 /// @note create a task with the given parameters
 /// @note the task is created with the default stack size
+/// @note with t_pfPeriodic and t_ulPeriodNs set, t_ptTask is not used: the task runs the callback
+///       at each absolute CLOCK_MONOTONIC release until it returns false or osTaskStop is called
+/// @note OS_SCHED_DEADLINE (OS_USE_RT_SCHEDULING) gives the periodic task a t_ulRuntimeNs budget
+///       per period, it falls back to clock_nanosleep if the kernel refuses it
 /// @pre configuration of the context structure
 //////////////////////////////////
 int osTaskCreate(xOsTaskCtx* p_pttOSTask);
@@ -149,6 +227,106 @@ int osTaskGetStatus(xOsTaskCtx* p_pttOSTask);
 //////////////////////////////////
 int osTaskWait(xOsTaskCtx* p_pttOSTask, void** p_pvExitValue);
 
+//////////////////////////////////
+/// @brief Restrict a task to a set of CPUs
+/// @param p_pttOSTask : pointer to the task structure context
+/// @param p_ptCpuSet : allowed CPUs (NULL or empty to remove the restriction)
+/// @return OS_TASK_SUCCESS if success, error code otherwise
+///
+/// @note before osTaskCreate the set is applied at creation, afterwards it is applied to the running thread
+//////////////////////////////////
+int osTaskSetAffinity(xOsTaskCtx* p_pttOSTask, const cpu_set_t* p_ptCpuSet);
+
+//////////////////////////////////
+/// @brief Restrict a task to one CPU
+/// @param p_pttOSTask : pointer to the task structure context
+/// @param p_iCpu : CPU index
+/// @return OS_TASK_SUCCESS if success, error code otherwise
+//////////////////////////////////
+int osTaskPinToCpu(xOsTaskCtx* p_pttOSTask, int p_iCpu);
+
+//////////////////////////////////
+/// @brief Pin a group of tasks onto a set of cores
+/// @param p_pptTasks : task contexts
+/// @param p_iCount : number of tasks
+/// @param p_ptCpuSet : cores to use (NULL for the isolated cores of the system)
+/// @param p_bSpread : true to give each task its own core round-robin, false to share the whole set
+/// @return OS_TASK_SUCCESS if success, error code otherwise
+///
+/// @note fails with OS_TASK_ERROR_AFFINITY when the set holds no CPU this process may use
+//////////////////////////////////
+int osTaskPinGroup(xOsTaskCtx** p_pptTasks, int p_iCount, const cpu_set_t* p_ptCpuSet, bool p_bSpread);
+
+//////////////////////////////////
+/// @brief Read the CPU topology of the system
+/// @param p_ptTopology : filled with the topology
+/// @return OS_TASK_SUCCESS if success, error code otherwise
+///
+/// @note package, core and isolated CPUs come from sysfs and stay unknown or empty without it
+//////////////////////////////////
+int osTaskGetTopology(xOsCpuTopology_t* p_ptTopology);
+
+//////////////////////////////////
+/// @brief Parse a kernel CPU list such as "0-3,6"
+/// @param p_pcList : CPU list
+/// @param p_ptCpuSet : filled with the CPUs of the list
+/// @return OS_TASK_SUCCESS if success, error code otherwise
+//////////////////////////////////
+int osTaskParseCpuList(const char* p_pcList, cpu_set_t* p_ptCpuSet);
+
+//////////////////////////////////
+/// @brief Lock the process memory in RAM
+/// @return OS_TASK_SUCCESS if success, error code otherwise
+///
+/// @note mlockall(MCL_CURRENT | MCL_FUTURE): call once before starting RT tasks, needs CAP_IPC_LOCK or a large enough RLIMIT_MEMLOCK
+//////////////////////////////////
+int osTaskLockMemory(void);
+
+//////////////////////////////////
+/// @brief Get the runtime statistics of a task
+/// @param p_pttOSTask : pointer to the task structure context
+/// @param p_ptStats : filled with the statistics
+/// @return OS_TASK_SUCCESS if success, error code otherwise
+///
+/// @note valid while the task runs and after it returned, until osTaskWait joins it
+/// @note context switches of a running task come from /proc and read 0 without it
+//////////////////////////////////
+int osTaskGetStats(xOsTaskCtx* p_pttOSTask, xOsTaskStats_t* p_ptStats);
+
+//////////////////////////////////
+/// @brief Get the monotonic clock in nanoseconds
+/// @return CLOCK_MONOTONIC time in nanoseconds
+//////////////////////////////////
+uint64_t osTaskNowNs(void);
+
+//////////////////////////////////
+/// @brief Sleep until an absolute deadline and record the wakeup latency
+/// @param p_pttOSTask : pointer to the context of the calling task
+/// @param p_ulDeadlineNs : CLOCK_MONOTONIC deadline in nanoseconds
+/// @return OS_TASK_SUCCESS if success, error code otherwise
+//////////////////////////////////
+int osTaskSleepUntil(xOsTaskCtx* p_pttOSTask, uint64_t p_ulDeadlineNs);
+
+//////////////////////////////////
+/// @brief Record the latency of a wakeup expected at a deadline
+/// @param p_pttOSTask : pointer to the context of the calling task
+/// @param p_ulDeadlineNs : CLOCK_MONOTONIC time the task should have woken at
+/// @return OS_TASK_SUCCESS if success, error code otherwise
+///
+/// @note for periodic tasks woken by something else than osTaskSleepUntil
+//////////////////////////////////
+int osTaskRecordWakeup(xOsTaskCtx* p_pttOSTask, uint64_t p_ulDeadlineNs);
+
+//////////////////////////////////
+/// @brief Write the statistics of a set of tasks to xLog
+/// @param p_pptTasks : task contexts
+/// @param p_iCount : number of tasks
+/// @return OS_TASK_SUCCESS if success, error code otherwise
+///
+/// @note one INFO line per task, call it from a periodic timer or supervisor loop
+//////////////////////////////////
+int osTaskLogStats(xOsTaskCtx** p_pptTasks, int p_iCount);
+
 //////////////////////////////////
 /// @brief Get task exit code
 /// @param p_pttOSTask : pointer to the task structure context
@@ -0,0 +1,294 @@
+////////////////////////////////////////////////////////////
+//  motors source file
+//  implements the mrpiz motor command pipeline
+//
+// general discloser: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+
+#include "xMotors.h"
+#include "xAssert.h"
+#include "xLog.h"
+#include "xTrace.h"
+#include <string.h>
+
+// Pending command word: command in bits 0-7, immediate flag in bit 8,
+// post time in microseconds since t_ulOriginNs plus one above, so a
+// posted command is never 0
+#define MOTORS_PACK_CMD_MASK    0xFFULL
+#define MOTORS_PACK_IMMEDIATE   0x100ULL
+#define MOTORS_PACK_TIME_SHIFT  9
+
+static xMotorsService_t s_tMotors;
+
+////////////////////////////////////////////////////////////
+/// motorsPack
+////////////////////////////////////////////////////////////
+static uint64_t motorsPack(const xMotorsService_t* p_ptService, int p_iCmd, bool p_bImmediate)
+{
+    uint64_t l_ulUs = (osTaskNowNs() - p_ptService->t_ulOriginNs) / 1000ULL + 1ULL;
+    return (l_ulUs << MOTORS_PACK_TIME_SHIFT) | (p_bImmediate ? MOTORS_PACK_IMMEDIATE : 0ULL) |
+           ((uint64_t)(uint8_t)(int8_t)p_iCmd & MOTORS_PACK_CMD_MASK);
+}
+
+////////////////////////////////////////////////////////////
+/// motorsPost
+////////////////////////////////////////////////////////////
+static void motorsPost(xMotorsService_t* p_ptService, mrpiz_motor_id p_eId, uint64_t p_ulWord)
+{
+    for (int i = 0; i < XMOTORS_COUNT; i++)
+    {
+        if (p_eId != MRPIZ_MOTOR_BOTH && (int)p_eId != i)
+            continue;
+
+        xMotorsMotor_t* l_ptMotor = &p_ptService->t_tMotors[i];
+        if (atomic_exchange_explicit(&l_ptMotor->a_ulPending, p_ulWord, memory_order_release) != 0)
+            atomic_fetch_add_explicit(&l_ptMotor->a_ulCoalesced, 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&l_ptMotor->a_ulSubmitted, 1, memory_order_relaxed);
+    }
+}
+
+////////////////////////////////////////////////////////////
+/// motorsWrite
+////////////////////////////////////////////////////////////
+static void motorsWrite(xMotorsService_t* p_ptService, mrpiz_motor_id p_eId, int p_iCmd)
+{
+    X_TRACE_BEGIN("motors.write");
+    int l_iRet = mrpiz_motor_set(p_eId, p_iCmd);
+    X_TRACE_END("motors.write");
+    uint64_t l_ulNow = osTaskNowNs();
+
+    for (int i = 0; i < XMOTORS_COUNT; i++)
+    {
+        if (p_eId != MRPIZ_MOTOR_BOTH && (int)p_eId != i)
+            continue;
+
+        // A failed write leaves the output unchanged, the next period tries again
+        xMotorsMotor_t* l_ptMotor = &p_ptService->t_tMotors[i];
+        atomic_fetch_add_explicit(&l_ptMotor->a_ulWrites, 1, memory_order_relaxed);
+        if (l_iRet < 0)
+        {
+            atomic_fetch_add_explicit(&l_ptMotor->a_ulWriteErrors, 1, memory_order_relaxed);
+        }
+        else
+        {
+            atomic_store_explicit(&l_ptMotor->a_iOutput, p_iCmd, memory_order_relaxed);
+            l_ptMotor->t_ulLastWriteNs = l_ulNow;
+            X_TRACE_COUNTER((i == (int)MRPIZ_MOTOR_LEFT) ? "motors.left" : "motors.right", p_iCmd);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////
+/// motorsAccountLatency
+////////////////////////////////////////////////////////////
+static void motorsAccountLatency(xMotorsMotor_t* p_ptMotor, uint64_t p_ulLatencyNs)
+{
+    atomic_fetch_add_explicit(&p_ptMotor->a_ulLatencyCount, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&p_ptMotor->a_ulLatencySumNs, p_ulLatencyNs, memory_order_relaxed);
+
+    // Only the task writes the maximum
+    if (p_ulLatencyNs > atomic_load_explicit(&p_ptMotor->a_ulLatencyMaxNs, memory_order_relaxed))
+        atomic_store_explicit(&p_ptMotor->a_ulLatencyMaxNs, p_ulLatencyNs, memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////
+/// motorsCycle
+////////////////////////////////////////////////////////////
+static bool motorsCycle(void* p_pvArg)
+{
+    xMotorsService_t* l_ptService = (xMotorsService_t*)p_pvArg;
+    uint64_t l_ulNow = osTaskNowNs();
+    uint64_t l_ulPostNs[XMOTORS_COUNT];
+    bool l_bTaken[XMOTORS_COUNT];
+    bool l_bWrite[XMOTORS_COUNT];
+    int l_iNext[XMOTORS_COUNT];
+
+    for (int i = 0; i < XMOTORS_COUNT; i++)
+    {
+        xMotorsMotor_t* l_ptMotor = &l_ptService->t_tMotors[i];
+        uint64_t l_ulWord = atomic_exchange_explicit(&l_ptMotor->a_ulPending, 0, memory_order_acquire);
+        int l_iTarget = atomic_load_explicit(&l_ptMotor->a_iTarget, memory_order_relaxed);
+        int l_iOutput = atomic_load_explicit(&l_ptMotor->a_iOutput, memory_order_relaxed);
+        bool l_bImmediate = false;
+
+        l_bTaken[i] = (l_ulWord != 0);
+        if (l_bTaken[i])
+        {
+            l_iTarget = (int)(int8_t)(uint8_t)(l_ulWord & MOTORS_PACK_CMD_MASK);
+            l_bImmediate = (l_ulWord & MOTORS_PACK_IMMEDIATE) != 0;
+            l_ulPostNs[i] = l_ptService->t_ulOriginNs + ((l_ulWord >> MOTORS_PACK_TIME_SHIFT) - 1ULL) * 1000ULL;
+            atomic_store_explicit(&l_ptMotor->a_iTarget, l_iTarget, memory_order_relaxed);
+        }
+
+        l_iNext[i] = l_iTarget;
+        if (!l_bImmediate && l_ptMotor->t_iStep > 0)
+        {
+            if (l_iTarget > l_iOutput + l_ptMotor->t_iStep)
+                l_iNext[i] = l_iOutput + l_ptMotor->t_iStep;
+            else if (l_iTarget < l_iOutput - l_ptMotor->t_iStep)
+                l_iNext[i] = l_iOutput - l_ptMotor->t_iStep;
+
+            if (l_iNext[i] != l_iTarget)
+                atomic_fetch_add_explicit(&l_ptMotor->a_ulRamped, 1, memory_order_relaxed);
+        }
+
+        l_bWrite[i] = (l_iNext[i] != l_iOutput);
+        if (l_bWrite[i] && !l_bImmediate && l_ulNow - l_ptMotor->t_ulLastWriteNs < l_ptMotor->t_ulMinIntervalNs)
+        {
+            l_bWrite[i] = false;
+            atomic_fetch_add_explicit(&l_ptMotor->a_ulDeferred, 1, memory_order_relaxed);
+        }
+    }
+
+    // One bus transaction when both motors move to the same command
+    if (l_bWrite[MRPIZ_MOTOR_LEFT] && l_bWrite[MRPIZ_MOTOR_RIGHT] && l_iNext[MRPIZ_MOTOR_LEFT] == l_iNext[MRPIZ_MOTOR_RIGHT])
+    {
+        motorsWrite(l_ptService, MRPIZ_MOTOR_BOTH, l_iNext[MRPIZ_MOTOR_LEFT]);
+    }
+    else
+    {
+        for (int i = 0; i < XMOTORS_COUNT; i++)
+        {
+            if (l_bWrite[i])
+                motorsWrite(l_ptService, (mrpiz_motor_id)i, l_iNext[i]);
+        }
+    }
+
+    uint64_t l_ulEnd = osTaskNowNs();
+    for (int i = 0; i < XMOTORS_COUNT; i++)
+    {
+        if (l_bTaken[i])
+            motorsAccountLatency(&l_ptService->t_tMotors[i], l_ulEnd > l_ulPostNs[i] ? l_ulEnd - l_ulPostNs[i] : 0);
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////
+/// xMotorsStart
+////////////////////////////////////////////////////////////
+int xMotorsStart(uint32_t p_ulPeriodUs, const xMotorsLimits_t* p_ptLimits, int p_iPriority)
+{
+    xMotorsService_t* l_ptService = &s_tMotors;
+
+    bool l_bExpected = false;
+    if (!atomic_compare_exchange_strong(&l_ptService->a_bRunning, &l_bExpected, true))
+        return XMOTORS_ALREADY_RUNNING;
+
+    uint64_t l_ulPeriodNs = (uint64_t)(p_ulPeriodUs ? p_ulPeriodUs : XMOTORS_DEFAULT_PERIOD_US) * 1000ULL;
+    l_ptService->t_ulOriginNs = osTaskNowNs();
+
+    for (int i = 0; i < XMOTORS_COUNT; i++)
+    {
+        xMotorsMotor_t* l_ptMotor = &l_ptService->t_tMotors[i];
+        memset(l_ptMotor, 0, sizeof(*l_ptMotor));
+
+        if (p_ptLimits != NULL)
+        {
+            // A slew rate slower than one percent per period still moves one percent
+            uint64_t l_ulStep = (uint64_t)p_ptLimits[i].t_ulSlewPctPerS * l_ulPeriodNs / 1000000000ULL;
+            if (p_ptLimits[i].t_ulSlewPctPerS != 0)
+                l_ptMotor->t_iStep = (l_ulStep == 0) ? 1 : (l_ulStep > 2 * XMOTORS_CMD_MAX) ? 0 : (int)l_ulStep;
+            l_ptMotor->t_ulMinIntervalNs = (uint64_t)p_ptLimits[i].t_ulMinIntervalUs * 1000ULL;
+        }
+    }
+
+    osTaskInit(&l_ptService->t_tTask);
+    l_ptService->t_tTask.t_pfPeriodic = motorsCycle;
+    l_ptService->t_tTask.t_ptTaskArg = l_ptService;
+    l_ptService->t_tTask.t_ulPeriodNs = l_ulPeriodNs;
+    l_ptService->t_tTask.t_ulStackSize = XMOTORS_STACK_SIZE;
+    l_ptService->t_tTask.t_iPriority = p_iPriority;
+    l_ptService->t_tTask.t_pcName = "motors";
+    if (osTaskCreate(&l_ptService->t_tTask) != OS_TASK_SUCCESS)
+    {
+        X_LOG_TRACE("xMotorsStart: actuation task creation failed");
+        atomic_store(&l_ptService->a_bRunning, false);
+        return XMOTORS_ERROR;
+    }
+
+    return XMOTORS_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xMotorsStop
+////////////////////////////////////////////////////////////
+int xMotorsStop(void)
+{
+    xMotorsService_t* l_ptService = &s_tMotors;
+
+    bool l_bExpected = true;
+    if (!atomic_compare_exchange_strong(&l_ptService->a_bRunning, &l_bExpected, false))
+        return XMOTORS_NOT_RUNNING;
+
+    atomic_store(&l_ptService->t_tTask.a_iStopFlag, OS_TASK_STOP_REQUEST);
+    if (osTaskWait(&l_ptService->t_tTask, NULL) != OS_TASK_SUCCESS)
+        return XMOTORS_ERROR;
+
+    // The task is gone, the motors are not left running on the last output
+    if (mrpiz_motor_set(MRPIZ_MOTOR_BOTH, 0) < 0)
+        return XMOTORS_ERROR;
+
+    return XMOTORS_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xMotorsSet
+////////////////////////////////////////////////////////////
+int xMotorsSet(mrpiz_motor_id p_eId, int p_iCmd)
+{
+    X_ASSERT_RETURN((int)p_eId >= (int)MRPIZ_MOTOR_LEFT && (int)p_eId <= (int)MRPIZ_MOTOR_BOTH, XMOTORS_INVALID);
+    X_ASSERT_RETURN(p_iCmd >= -XMOTORS_CMD_MAX && p_iCmd <= XMOTORS_CMD_MAX, XMOTORS_INVALID);
+
+    if (!atomic_load_explicit(&s_tMotors.a_bRunning, memory_order_acquire))
+        return XMOTORS_NOT_RUNNING;
+
+    motorsPost(&s_tMotors, p_eId, motorsPack(&s_tMotors, p_iCmd, false));
+    return XMOTORS_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xMotorsHalt
+////////////////////////////////////////////////////////////
+int xMotorsHalt(void)
+{
+    if (!atomic_load_explicit(&s_tMotors.a_bRunning, memory_order_acquire))
+        return XMOTORS_NOT_RUNNING;
+
+    motorsPost(&s_tMotors, MRPIZ_MOTOR_BOTH, motorsPack(&s_tMotors, 0, true));
+    return XMOTORS_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xMotorsGetStats
+////////////////////////////////////////////////////////////
+int xMotorsGetStats(mrpiz_motor_id p_eId, xMotorsStats_t* p_ptStats)
+{
+    X_ASSERT_RETURN((int)p_eId >= (int)MRPIZ_MOTOR_LEFT && (int)p_eId < XMOTORS_COUNT, XMOTORS_INVALID);
+    X_ASSERT_RETURN(p_ptStats != NULL, XMOTORS_INVALID);
+
+    xMotorsMotor_t* l_ptMotor = &s_tMotors.t_tMotors[p_eId];
+    p_ptStats->t_ulSubmitted = atomic_load_explicit(&l_ptMotor->a_ulSubmitted, memory_order_relaxed);
+    p_ptStats->t_ulCoalesced = atomic_load_explicit(&l_ptMotor->a_ulCoalesced, memory_order_relaxed);
+    p_ptStats->t_ulWrites = atomic_load_explicit(&l_ptMotor->a_ulWrites, memory_order_relaxed);
+    p_ptStats->t_ulWriteErrors = atomic_load_explicit(&l_ptMotor->a_ulWriteErrors, memory_order_relaxed);
+    p_ptStats->t_ulRamped = atomic_load_explicit(&l_ptMotor->a_ulRamped, memory_order_relaxed);
+    p_ptStats->t_ulDeferred = atomic_load_explicit(&l_ptMotor->a_ulDeferred, memory_order_relaxed);
+    p_ptStats->t_ulLatencyCount = atomic_load_explicit(&l_ptMotor->a_ulLatencyCount, memory_order_relaxed);
+    uint64_t l_ulSum = atomic_load_explicit(&l_ptMotor->a_ulLatencySumNs, memory_order_relaxed);
+    p_ptStats->t_ulLatencyAvgNs = p_ptStats->t_ulLatencyCount ? l_ulSum / p_ptStats->t_ulLatencyCount : 0;
+    p_ptStats->t_ulLatencyMaxNs = atomic_load_explicit(&l_ptMotor->a_ulLatencyMaxNs, memory_order_relaxed);
+    p_ptStats->t_iTarget = atomic_load_explicit(&l_ptMotor->a_iTarget, memory_order_relaxed);
+    p_ptStats->t_iOutput = atomic_load_explicit(&l_ptMotor->a_iOutput, memory_order_relaxed);
+
+    return XMOTORS_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xMotorsGetTask
+////////////////////////////////////////////////////////////
+xOsTaskCtx* xMotorsGetTask(void)
+{
+    return atomic_load(&s_tMotors.a_bRunning) ? &s_tMotors.t_tTask : NULL;
+}
@@ -0,0 +1,148 @@
+////////////////////////////////////////////////////////////
+//  motors header file
+//  defines the mrpiz motor command pipeline
+//
+// Callers post a target command per motor with one atomic exchange,
+// a newer command replaces the pending one (last write wins). A high
+// priority periodic task takes the pending targets once per actuation
+// period, moves each output towards its target within the slew rate of
+// the motor, holds a write back until the minimum interval of the motor
+// has passed and only writes the outputs that changed, in a single
+// MRPIZ_MOTOR_BOTH call when both motors get the same command
+//
+// general discloser: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+#pragma once
+
+#ifndef XMOTORS_H_
+#define XMOTORS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "mrpiz.h"
+#include "xTask.h"
+
+// Motors error codes
+#define XMOTORS_OK                  0xB2E64F20
+#define XMOTORS_ERROR               0xB2E64F21
+#define XMOTORS_INVALID             0xB2E64F22
+#define XMOTORS_ALREADY_RUNNING     0xB2E64F23
+#define XMOTORS_NOT_RUNNING         0xB2E64F24
+
+// Configuration constants
+#define XMOTORS_COUNT               2           // MRPIZ_MOTOR_LEFT and MRPIZ_MOTOR_RIGHT
+#define XMOTORS_CMD_MAX             100         // Commands are percentages in [-100, 100]
+#define XMOTORS_DEFAULT_PERIOD_US   5000        // Actuation period when 0 is configured
+#define XMOTORS_DEFAULT_PRIORITY    OS_TASK_HIGHEST_PRIORITY
+#define XMOTORS_STACK_SIZE          (64 * 1024)
+#define XMOTORS_CACHE_LINE          64
+
+//////////////////////////////////
+/// @brief limits of one motor
+//////////////////////////////////
+typedef struct xmotors_limits_t
+{
+    uint32_t t_ulSlewPctPerS;                   // Largest output change per second (0 for a step)
+    uint32_t t_ulMinIntervalUs;                 // Shortest time between two writes (0 for every period)
+} xMotorsLimits_t;
+
+//////////////////////////////////
+/// @brief counters of one motor
+//////////////////////////////////
+typedef struct xmotors_stats_t
+{
+    uint64_t t_ulSubmitted;                     // Commands posted
+    uint64_t t_ulCoalesced;                     // Commands replaced before an actuation took them
+    uint64_t t_ulWrites;                        // mrpiz_motor_set calls carrying this motor
+    uint64_t t_ulWriteErrors;                   // Failed writes, retried on the next period
+    uint64_t t_ulRamped;                        // Periods the slew rate limited the output
+    uint64_t t_ulDeferred;                      // Periods a write waited for the minimum interval
+    uint64_t t_ulLatencyCount;                  // Commands taken by an actuation
+    uint64_t t_ulLatencyAvgNs;                  // Mean time from post to the end of its actuation
+    uint64_t t_ulLatencyMaxNs;                  // Worst time from post to the end of its actuation
+    int t_iTarget;                              // Last target taken
+    int t_iOutput;                              // Last command written
+} xMotorsStats_t;
+
+//////////////////////////////////
+/// @brief state of one motor, on its own cache lines
+//////////////////////////////////
+typedef struct xmotors_motor_t
+{
+    atomic_ullong a_ulPending;                  // Packed pending command, 0 when none
+    atomic_int a_iTarget;
+    atomic_int a_iOutput;
+    uint64_t t_ulLastWriteNs;                   // Task only
+    int t_iStep;                                // Output change per period, 0 for a step
+    uint64_t t_ulMinIntervalNs;
+    atomic_ulong a_ulSubmitted;
+    atomic_ulong a_ulCoalesced;
+    atomic_ulong a_ulWrites;
+    atomic_ulong a_ulWriteErrors;
+    atomic_ulong a_ulRamped;
+    atomic_ulong a_ulDeferred;
+    atomic_ulong a_ulLatencyCount;
+    _Atomic uint64_t a_ulLatencySumNs;
+    _Atomic uint64_t a_ulLatencyMaxNs;
+} __attribute__((aligned(XMOTORS_CACHE_LINE))) xMotorsMotor_t;
+
+//////////////////////////////////
+/// @brief command pipeline
+//////////////////////////////////
+typedef struct xmotors_service_t
+{
+    xMotorsMotor_t t_tMotors[XMOTORS_COUNT];
+    uint64_t t_ulOriginNs;                      // Time base of the packed commands
+    atomic_bool a_bRunning;
+    xOsTaskCtx t_tTask;
+} xMotorsService_t;
+
+//////////////////////////////////
+/// @brief Start the actuation task
+/// @param p_ulPeriodUs : actuation period in microseconds (0 for XMOTORS_DEFAULT_PERIOD_US)
+/// @param p_ptLimits : limits indexed by mrpiz_motor_id, XMOTORS_COUNT entries (NULL for none)
+/// @param p_iPriority : task priority (XMOTORS_DEFAULT_PRIORITY for the default)
+/// @return : success or error code
+/// @pre mrpiz_init was called
+//////////////////////////////////
+int xMotorsStart(uint32_t p_ulPeriodUs, const xMotorsLimits_t* p_ptLimits, int p_iPriority);
+
+//////////////////////////////////
+/// @brief Stop the actuation task and both motors
+/// @return : success or error code
+//////////////////////////////////
+int xMotorsStop(void);
+
+//////////////////////////////////
+/// @brief Post a target command
+/// @param p_eId : motor, MRPIZ_MOTOR_BOTH for both
+/// @param p_iCmd : command in percent, in [-100, 100]
+/// @return : success or error code
+/// @note lock-free, the command is applied on the next actuation period
+//////////////////////////////////
+int xMotorsSet(mrpiz_motor_id p_eId, int p_iCmd);
+
+//////////////////////////////////
+/// @brief Stop both motors on the next actuation period, without ramp or interval
+/// @return : success or error code
+/// @note a command posted before that period replaces the halt
+//////////////////////////////////
+int xMotorsHalt(void);
+
+//////////////////////////////////
+/// @brief Get the counters of a motor
+/// @param p_eId : MRPIZ_MOTOR_LEFT or MRPIZ_MOTOR_RIGHT
+/// @param p_ptStats : filled with the counters
+/// @return : success or error code
+//////////////////////////////////
+int xMotorsGetStats(mrpiz_motor_id p_eId, xMotorsStats_t* p_ptStats);
+
+//////////////////////////////////
+/// @brief Get the actuation task, for osTaskGetStats
+/// @return : task context, NULL when the pipeline is not running
+//////////////////////////////////
+xOsTaskCtx* xMotorsGetTask(void);
+
+#endif // XMOTORS_H_
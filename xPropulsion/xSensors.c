@@ -0,0 +1,203 @@
+////////////////////////////////////////////////////////////
+//  sensors source file
+//  implements the mrpiz sensor acquisition service
+//
+// general discloser: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+
+#include "xSensors.h"
+#include "xAssert.h"
+#include "xLog.h"
+#include "xTrace.h"
+#include <errno.h>
+#include <string.h>
+
+static xSensorsService_t s_tSensors = { .a_iLatest = -1 };
+
+////////////////////////////////////////////////////////////
+/// sensorsPublish
+////////////////////////////////////////////////////////////
+static void sensorsPublish(xSensorsService_t* p_ptService)
+{
+    // Only the task writes, always into the buffer readers are not sent to
+    int l_iSpare = (atomic_load_explicit(&p_ptService->a_iLatest, memory_order_relaxed) == 0) ? 1 : 0;
+    xSensorsBuffer_t* l_ptBuffer = &p_ptService->t_tBuffers[l_iSpare];
+
+    unsigned int l_uiSeq = atomic_load_explicit(&l_ptBuffer->a_uiSeq, memory_order_relaxed);
+    atomic_store_explicit(&l_ptBuffer->a_uiSeq, l_uiSeq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    l_ptBuffer->t_tSnapshot = p_ptService->t_tWork;
+    atomic_store_explicit(&l_ptBuffer->a_uiSeq, l_uiSeq + 2, memory_order_release);
+
+    atomic_store_explicit(&p_ptService->a_iLatest, l_iSpare, memory_order_release);
+    atomic_store_explicit(&p_ptService->a_ulCycle, p_ptService->t_tWork.t_ulCycle, memory_order_release);
+}
+
+////////////////////////////////////////////////////////////
+/// sensorsAcquire
+////////////////////////////////////////////////////////////
+static void sensorsAcquire(xSensorsService_t* p_ptService)
+{
+    xSensorsSnapshot_t* l_ptWork = &p_ptService->t_tWork;
+    uint64_t l_ulStart = osTaskNowNs();
+    X_TRACE_BEGIN("sensors.acquire");
+
+    l_ptWork->t_ulCycle++;
+    l_ptWork->t_ulTimestampNs = l_ulStart;
+    l_ptWork->t_ulErrors = 0;
+
+    for (int i = 0; i < XSENSORS_PROXY_COUNT; i++)
+    {
+        int l_iValue = mrpiz_proxy_sensor_get((mrpiz_proxy_sensor_id)((int)MRPIZ_PROXY_SENSOR_FRONT_LEFT + i));
+        if (l_iValue < 0)
+            l_ptWork->t_ulErrors |= XSENSORS_ERR_PROXY(i);
+        else
+            l_ptWork->t_iProxy[i] = l_iValue;
+    }
+
+    // Any int is a valid encoder value, a failed read only shows in errno
+    for (int i = 0; i < XSENSORS_MOTOR_COUNT; i++)
+    {
+        errno = 0;
+        int l_iValue = mrpiz_motor_encoder_get((mrpiz_motor_id)i);
+        if (errno != 0)
+        {
+            l_ptWork->t_ulErrors |= XSENSORS_ERR_ENCODER(i);
+        }
+        else
+        {
+            l_ptWork->t_iEncoder[i] = l_iValue;
+            l_ptWork->t_ulEncoderNs[i] = osTaskNowNs();
+        }
+    }
+
+    // The charge moves over minutes, it is read on one cycle out of t_ulBatteryDivider
+    if ((l_ptWork->t_ulCycle - 1) % p_ptService->t_ulBatteryDivider == 0)
+    {
+        int l_iValue = mrpiz_battery_level();
+        if (l_iValue < 0)
+        {
+            l_ptWork->t_ulErrors |= XSENSORS_ERR_BATTERY;
+        }
+        else
+        {
+            l_ptWork->t_iBatteryLevel = l_iValue;
+            l_ptWork->t_ulBatteryNs = osTaskNowNs();
+        }
+    }
+
+    l_ptWork->t_ulDurationNs = osTaskNowNs() - l_ulStart;
+    sensorsPublish(p_ptService);
+    X_TRACE_END("sensors.acquire");
+}
+
+////////////////////////////////////////////////////////////
+/// sensorsCycle
+////////////////////////////////////////////////////////////
+static bool sensorsCycle(void* p_pvArg)
+{
+    sensorsAcquire((xSensorsService_t*)p_pvArg);
+    return true;
+}
+
+////////////////////////////////////////////////////////////
+/// xSensorsStart
+////////////////////////////////////////////////////////////
+int xSensorsStart(uint32_t p_ulPeriodMs, uint32_t p_ulBatteryDivider, int p_iPriority)
+{
+    xSensorsService_t* l_ptService = &s_tSensors;
+
+    bool l_bExpected = false;
+    if (!atomic_compare_exchange_strong(&l_ptService->a_bRunning, &l_bExpected, true))
+        return XSENSORS_ALREADY_RUNNING;
+
+    memset(&l_ptService->t_tWork, 0, sizeof(l_ptService->t_tWork));
+    for (int i = 0; i < XSENSORS_PROXY_COUNT; i++)
+        l_ptService->t_tWork.t_iProxy[i] = -1;
+    l_ptService->t_tWork.t_iBatteryLevel = -1;
+    l_ptService->t_ulBatteryDivider = p_ulBatteryDivider ? p_ulBatteryDivider : XSENSORS_DEFAULT_BATTERY_DIV;
+
+    // Numbering restarts, so no snapshot of a previous run is handed out
+    atomic_store(&l_ptService->a_iLatest, -1);
+    atomic_store(&l_ptService->a_ulCycle, 0);
+
+    // A first cycle on the caller thread, consumers have data as soon as this returns
+    sensorsAcquire(l_ptService);
+
+    osTaskInit(&l_ptService->t_tTask);
+    l_ptService->t_tTask.t_pfPeriodic = sensorsCycle;
+    l_ptService->t_tTask.t_ptTaskArg = l_ptService;
+    l_ptService->t_tTask.t_ulPeriodNs = (uint64_t)(p_ulPeriodMs ? p_ulPeriodMs : XSENSORS_DEFAULT_PERIOD_MS) * 1000000ULL;
+    l_ptService->t_tTask.t_ulStackSize = XSENSORS_STACK_SIZE;
+    l_ptService->t_tTask.t_iPriority = p_iPriority;
+    l_ptService->t_tTask.t_pcName = "sensors";
+    if (osTaskCreate(&l_ptService->t_tTask) != OS_TASK_SUCCESS)
+    {
+        X_LOG_TRACE("xSensorsStart: acquisition task creation failed");
+        atomic_store(&l_ptService->a_bRunning, false);
+        return XSENSORS_ERROR;
+    }
+
+    return XSENSORS_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xSensorsStop
+////////////////////////////////////////////////////////////
+int xSensorsStop(void)
+{
+    xSensorsService_t* l_ptService = &s_tSensors;
+
+    bool l_bExpected = true;
+    if (!atomic_compare_exchange_strong(&l_ptService->a_bRunning, &l_bExpected, false))
+        return XSENSORS_NOT_RUNNING;
+
+    atomic_store(&l_ptService->t_tTask.a_iStopFlag, OS_TASK_STOP_REQUEST);
+    if (osTaskWait(&l_ptService->t_tTask, NULL) != OS_TASK_SUCCESS)
+        return XSENSORS_ERROR;
+
+    return XSENSORS_OK;
+}
+
+////////////////////////////////////////////////////////////
+/// xSensorsGetSnapshot
+////////////////////////////////////////////////////////////
+int xSensorsGetSnapshot(xSensorsSnapshot_t* p_ptSnapshot)
+{
+    X_ASSERT_RETURN(p_ptSnapshot != NULL, XSENSORS_INVALID);
+
+    for (;;)
+    {
+        int l_iLatest = atomic_load_explicit(&s_tSensors.a_iLatest, memory_order_acquire);
+        if (l_iLatest < 0)
+            return XSENSORS_NO_DATA;
+
+        // An odd or moved sequence means the task came back to this buffer during the copy
+        xSensorsBuffer_t* l_ptBuffer = &s_tSensors.t_tBuffers[l_iLatest];
+        unsigned int l_uiSeq = atomic_load_explicit(&l_ptBuffer->a_uiSeq, memory_order_acquire);
+        if (l_uiSeq & 1U)
+            continue;
+
+        *p_ptSnapshot = l_ptBuffer->t_tSnapshot;
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&l_ptBuffer->a_uiSeq, memory_order_relaxed) == l_uiSeq)
+            return XSENSORS_OK;
+    }
+}
+
+////////////////////////////////////////////////////////////
+/// xSensorsGetCycle
+////////////////////////////////////////////////////////////
+uint64_t xSensorsGetCycle(void)
+{
+    return atomic_load_explicit(&s_tSensors.a_ulCycle, memory_order_acquire);
+}
+
+////////////////////////////////////////////////////////////
+/// xSensorsGetTask
+////////////////////////////////////////////////////////////
+xOsTaskCtx* xSensorsGetTask(void)
+{
+    return atomic_load(&s_tSensors.a_bRunning) ? &s_tSensors.t_tTask : NULL;
+}
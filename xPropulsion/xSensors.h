@@ -0,0 +1,128 @@
+////////////////////////////////////////////////////////////
+//  sensors header file
+//  defines the mrpiz sensor acquisition service
+//
+// One periodic task reads every proximity sensor, both motor encoders
+// and the battery once per cycle, so the board or the intox link sees
+// one burst of requests per period whatever the number of consumers.
+// Each cycle is written into the spare of two snapshot buffers and then
+// published. Readers copy the latest snapshot in O(1) under a sequence
+// check: they never take a lock, never wait for each other and only
+// retry when the task reuses the buffer during their copy
+//
+// general discloser: copy or share the file is forbidden
+// Written : 14/10/2026
+////////////////////////////////////////////////////////////
+#pragma once
+
+#ifndef XSENSORS_H_
+#define XSENSORS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "mrpiz.h"
+#include "xTask.h"
+
+// Sensors error codes
+#define XSENSORS_OK                 0xB2E64F10
+#define XSENSORS_ERROR              0xB2E64F11
+#define XSENSORS_INVALID            0xB2E64F12
+#define XSENSORS_ALREADY_RUNNING    0xB2E64F13
+#define XSENSORS_NOT_RUNNING        0xB2E64F14
+#define XSENSORS_NO_DATA            0xB2E64F15
+
+// Configuration constants
+#define XSENSORS_PROXY_COUNT        5       // MRPIZ_PROXY_SENSOR_FRONT_LEFT .. FRONT_RIGHT
+#define XSENSORS_MOTOR_COUNT        2       // MRPIZ_MOTOR_LEFT and MRPIZ_MOTOR_RIGHT
+#define XSENSORS_DEFAULT_PERIOD_MS  10      // Period when 0 is configured
+#define XSENSORS_DEFAULT_BATTERY_DIV 100    // Cycles between battery reads when 0 is configured
+#define XSENSORS_STACK_SIZE         (64 * 1024)
+#define XSENSORS_CACHE_LINE         64
+
+// Read failures of the last cycle (t_ulErrors), the previous value is kept
+#define XSENSORS_ERR_PROXY(i)       (1U << (i))
+#define XSENSORS_ERR_ENCODER(i)     (1U << (XSENSORS_PROXY_COUNT + (i)))
+#define XSENSORS_ERR_BATTERY        (1U << (XSENSORS_PROXY_COUNT + XSENSORS_MOTOR_COUNT))
+
+// Index of a mrpiz_proxy_sensor_id in t_iProxy
+#define XSENSORS_PROXY_INDEX(id)    ((int)(id) - (int)MRPIZ_PROXY_SENSOR_FRONT_LEFT)
+
+//////////////////////////////////
+/// @brief values read in one acquisition cycle
+//////////////////////////////////
+typedef struct xsensors_snapshot_t
+{
+    uint64_t t_ulCycle;                         // Cycle number, starts at 1
+    uint64_t t_ulTimestampNs;                   // CLOCK_MONOTONIC at the start of the cycle
+    uint64_t t_ulDurationNs;                    // Time spent reading the sensors
+    int t_iProxy[XSENSORS_PROXY_COUNT];         // Proximity in [0, 255] by XSENSORS_PROXY_INDEX (-1 before the first read)
+    int t_iEncoder[XSENSORS_MOTOR_COUNT];       // Encoder steps, by mrpiz_motor_id
+    uint64_t t_ulEncoderNs[XSENSORS_MOTOR_COUNT];   // CLOCK_MONOTONIC of each encoder read
+    int t_iBatteryLevel;                        // Charge in percent (-1 before the first read)
+    uint64_t t_ulBatteryNs;                     // CLOCK_MONOTONIC of the battery read
+    uint32_t t_ulErrors;                        // XSENSORS_ERR_* of this cycle
+} xSensorsSnapshot_t;
+
+//////////////////////////////////
+/// @brief snapshot buffer, the sequence is odd while it is written
+//////////////////////////////////
+typedef struct xsensors_buffer_t
+{
+    atomic_uint a_uiSeq;
+    xSensorsSnapshot_t t_tSnapshot;
+} __attribute__((aligned(XSENSORS_CACHE_LINE))) xSensorsBuffer_t;
+
+//////////////////////////////////
+/// @brief acquisition service
+//////////////////////////////////
+typedef struct xsensors_service_t
+{
+    xSensorsBuffer_t t_tBuffers[2];             // Published and spare snapshots
+    atomic_int a_iLatest;                       // Published buffer, -1 before the first cycle
+    atomic_ulong a_ulCycle;                     // Cycle of the published buffer
+    xSensorsSnapshot_t t_tWork;                 // Values carried between cycles (task only)
+    uint32_t t_ulBatteryDivider;                // Cycles between battery reads
+    atomic_bool a_bRunning;
+    xOsTaskCtx t_tTask;
+} xSensorsService_t;
+
+//////////////////////////////////
+/// @brief Start the acquisition task
+/// @param p_ulPeriodMs : acquisition period in milliseconds (0 for XSENSORS_DEFAULT_PERIOD_MS)
+/// @param p_ulBatteryDivider : cycles between battery reads (0 for XSENSORS_DEFAULT_BATTERY_DIV)
+/// @param p_iPriority : task priority (OS_TASK_DEFAULT_PRIORITY for the default)
+/// @return : success or error code
+/// @pre mrpiz_init was called
+//////////////////////////////////
+int xSensorsStart(uint32_t p_ulPeriodMs, uint32_t p_ulBatteryDivider, int p_iPriority);
+
+//////////////////////////////////
+/// @brief Stop the acquisition task
+/// @return : success or error code
+/// @note the last snapshot stays readable
+//////////////////////////////////
+int xSensorsStop(void);
+
+//////////////////////////////////
+/// @brief Copy the latest snapshot
+/// @param p_ptSnapshot : filled with the latest snapshot
+/// @return : success, XSENSORS_NO_DATA before the first cycle, or error code
+/// @note lock-free, callable from any task at any rate
+//////////////////////////////////
+int xSensorsGetSnapshot(xSensorsSnapshot_t* p_ptSnapshot);
+
+//////////////////////////////////
+/// @brief Get the number of the latest published cycle
+/// @return : cycle number, 0 before the first cycle
+/// @note cheaper than a snapshot copy to poll for a new cycle
+//////////////////////////////////
+uint64_t xSensorsGetCycle(void);
+
+//////////////////////////////////
+/// @brief Get the acquisition task, for osTaskGetStats
+/// @return : task context, NULL when the service is not running
+//////////////////////////////////
+xOsTaskCtx* xSensorsGetTask(void);
+
+#endif // XSENSORS_H_